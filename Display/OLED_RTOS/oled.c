@@ -76,9 +76,76 @@
  */
 static uint8_t oled_display_buf[OLED_MAX_PAGE][OLED_MAX_COLUMN];
 
+/**
+ * 每一页被修改过的列范围 [oled_dirty_min, oled_dirty_max]
+ * 所有写显存的函数都会更新该范围, oled_update 只发送这些列
+ * oled_dirty_min > oled_dirty_max 表示该页没有修改
+ */
+static uint8_t oled_dirty_min[OLED_MAX_PAGE];
+static uint8_t oled_dirty_max[OLED_MAX_PAGE];
+
+#if OLED_USE_SHADOW_BUF
+/* 屏幕上当前显示的内容, 用于剔除没有变化的数据 */
+static uint8_t oled_shadow_buf[OLED_MAX_PAGE][OLED_MAX_COLUMN];
+#endif /* OLED_USE_SHADOW_BUF */
+
+/* 总线传输统计 */
+static oled_stats_t oled_stats;
+
 /* OLED 是否打开 */
 static uint8_t oled_is_open;
 
+/**
+ * @brief 标记一页中被修改的列
+ *
+ * @param page 页, 范围: 0 ~ OLED_MAX_PAGE - 1
+ * @param x0 起始列, 范围: 0 ~ OLED_MAX_COLUMN - 1
+ * @param x1 结束列 (包含), 范围: x0 ~ OLED_MAX_COLUMN - 1
+ */
+static inline void oled_mark_dirty(int16_t page, int16_t x0, int16_t x1) {
+    if (x0 < oled_dirty_min[page]) {
+        oled_dirty_min[page] = (uint8_t)x0;
+    }
+    if (x1 > oled_dirty_max[page]) {
+        oled_dirty_max[page] = (uint8_t)x1;
+    }
+}
+
+/**
+ * @brief 标记被修改的区域, 超出屏幕的部分忽略
+ *
+ * @param x 区域左上角的横坐标
+ * @param y 区域左上角的纵坐标
+ * @param width 区域的宽度
+ * @param height 区域的高度
+ */
+static void oled_mark_dirty_area(int16_t x, int16_t y, int16_t width,
+                                 int16_t height) {
+    int16_t x1 = x + width - 1;
+    int16_t y1 = y + height - 1;
+    int16_t page;
+
+    if (x < 0) {
+        x = 0;
+    }
+    if (y < 0) {
+        y = 0;
+    }
+    if (x1 >= OLED_MAX_COLUMN) {
+        x1 = OLED_MAX_COLUMN - 1;
+    }
+    if (y1 >= OLED_MAX_LINE) {
+        y1 = OLED_MAX_LINE - 1;
+    }
+    if (x > x1 || y > y1) {
+        return;
+    }
+
+    for (page = y >> 3; page <= (y1 >> 3); page++) {
+        oled_mark_dirty(page, x, x1);
+    }
+}
+
 #include "FreeRTOS.h"
 #include "semphr.h"
 
@@ -93,12 +160,21 @@ static SemaphoreHandle_t show_semp;
  * @param data 写入的命令
  */
 static void oled_write_command(uint8_t data) {
+    oled_stats.cmd_bytes++;
+    oled_stats.transfers++;
+
 #if (defined(OLED_USE_I2C))
+    /* DMA 在函数返回后才读取数据, 不能使用栈上的变量 */
+    static uint8_t cmd_buf;
+
+    oled_stats.wire_bytes += 3;
     if (xSemaphoreTake(i2c_semp, portMAX_DELAY) == pdTRUE) {
+        cmd_buf = data;
         HAL_I2C_Mem_Write_DMA(&i2c1_handle, OLED_ADDRESS, 0x00,
-                              I2C_MEMADD_SIZE_8BIT, &data, 1);
+                              I2C_MEMADD_SIZE_8BIT, &cmd_buf, 1);
     }
 #elif (defined(OLED_USE_SPI))
+    oled_stats.wire_bytes += 1;
     OLED_CS_GPIO_WRITE(GPIO_PIN_RESET);
     OLED_DC_GPIO_WRITE(GPIO_PIN_RESET);
     HAL_SPI_Transmit(&spi1_handle, &data, 1, 100);
@@ -113,12 +189,17 @@ static void oled_write_command(uint8_t data) {
  * @param count 数据长度
  */
 static void oled_write_data(uint8_t *data, uint8_t count) {
+    oled_stats.data_bytes += count;
+    oled_stats.transfers++;
+
 #if (defined(OLED_USE_I2C))
+    oled_stats.wire_bytes += count + 2;
     if (xSemaphoreTake(i2c_semp, portMAX_DELAY) == pdTRUE) {
         HAL_I2C_Mem_Write_DMA(&i2c1_handle, OLED_ADDRESS, 0x40,
                               I2C_MEMADD_SIZE_8BIT, data, count);
     }
 #elif (defined(OLED_USE_SPI))
+    oled_stats.wire_bytes += count;
     OLED_CS_GPIO_WRITE(GPIO_PIN_RESET);
     OLED_DC_GPIO_WRITE(GPIO_PIN_SET);
     HAL_SPI_Transmit(&spi1_handle, data, count, 100);
@@ -265,6 +346,11 @@ void oled_init(void) {
 
     oled_is_open = 1;
 
+#if OLED_USE_SHADOW_BUF
+    /* 屏幕上的内容未知, 让第一次更新发送全部数据 */
+    memset(oled_shadow_buf, 0xFF, sizeof(oled_shadow_buf));
+#endif /* OLED_USE_SHADOW_BUF */
+
     oled_clear();
     oled_update();
 }
@@ -338,6 +424,20 @@ uint8_t oled_pnpoly(uint8_t nvert, int16_t *vertx, int16_t *verty,
     return c;
 }
 
+/**
+ * @brief 计算指定点相对原点的角度
+ *
+ * @param x 指定点的 x 坐标
+ * @param y 指定点的 y 坐标
+ * @return 角度, 范围: -180 ~ 180
+ * @note x 固定时, 在 y < 0, y = 0, y > 0 三段内角度随 y 单调变化:
+ *       x >= 0 时不减, x < 0 时不增
+ */
+static inline int16_t oled_point_angle(int16_t x, int16_t y) {
+    /* 计算指定点的弧度, 并转换为角度表示 */
+    return (int16_t)(atan2(y, x) / 3.14 * 180.0);
+}
+
 /**
  * @brief 判断指定点是否在指定角度内部
  *
@@ -353,8 +453,7 @@ uint8_t oled_is_in_angle(int16_t x, int16_t y, int16_t start_angle,
                          int16_t end_angle) {
     int16_t point_angle;
 
-    /* 计算指定点的弧度, 并转换为角度表示 */
-    point_angle = (int16_t)(atan2(y, x) / 3.14 * 180.0);
+    point_angle = oled_point_angle(x, y);
     if (start_angle < end_angle) {
         /* 起始角度小于终止角度的情况 */
         /* 如果指定角度在起始终止角度之间, 则判定指定点在指定角度 */
@@ -371,6 +470,53 @@ uint8_t oled_is_in_angle(int16_t x, int16_t y, int16_t start_angle,
     return 0; /* 不满足以上条件, 则判断判定指定点不在指定角度 */
 }
 
+/**
+ * @brief 发送一页中指定列范围的显存
+ *
+ * @param page 页
+ * @param x0 起始列
+ * @param x1 结束列 (包含)
+ * @note 使用 OLED_USE_SHADOW_BUF 时只发送与屏幕内容不同的部分,
+ *       间隔小于 OLED_FLUSH_MERGE_GAP 的改动合并为一次发送.
+ */
+static void oled_flush_span(uint8_t page, uint8_t x0, uint8_t x1) {
+#if OLED_USE_SHADOW_BUF
+    uint8_t *buf = oled_display_buf[page];
+    uint8_t *shadow = oled_shadow_buf[page];
+    int16_t start, end, next;
+
+    start = x0;
+    while (start <= x1) {
+        /* 找到下一段改动的起点 */
+        while (start <= x1 && buf[start] == shadow[start]) {
+            start++;
+        }
+        if (start > x1) {
+            break;
+        }
+
+        /* 向后延伸, 直到连续 OLED_FLUSH_MERGE_GAP 个字节没有变化 */
+        end = start;
+        next = start + 1;
+        while (next <= x1 && next - end <= OLED_FLUSH_MERGE_GAP) {
+            if (buf[next] != shadow[next]) {
+                end = next;
+            }
+            next++;
+        }
+
+        oled_set_cursor(page, (uint8_t)start);
+        oled_write_data(&buf[start], (uint8_t)(end - start + 1));
+        memcpy(&shadow[start], &buf[start], end - start + 1);
+
+        start = end + 1;
+    }
+#else  /* OLED_USE_SHADOW_BUF */
+    oled_set_cursor(page, x0);
+    oled_write_data(&oled_display_buf[page][x0], x1 - x0 + 1);
+#endif /* OLED_USE_SHADOW_BUF */
+}
+
 /**
  * @brief 将 OLED 显存数组更新到 OLED 屏幕
  *
@@ -378,6 +524,7 @@ uint8_t oled_is_in_angle(int16_t x, int16_t y, int16_t start_angle,
  *          随后调用 oled_update 函数或 oled_update_area 函数
  *          才会将显存数组的数据发送到 OLED 硬件, 进行显示
  *          故调用显示函数后, 要想真正地呈现在屏幕上, 还需调用更新函数
+ *          只发送上次更新之后修改过的列
  */
 void oled_update(void) {
     uint8_t j;
@@ -388,10 +535,15 @@ void oled_update(void) {
 
     /* 遍历每一页 */
     for (j = 0; j < OLED_MAX_PAGE; j++) {
-        /* 设置光标位置为每一页的第一列 */
-        oled_set_cursor(j, 0);
-        /* 连续写入 128 个数据, 将显存数组的数据写入到 OLED 硬件 */
-        oled_write_data(oled_display_buf[j], OLED_MAX_COLUMN);
+        if (oled_dirty_min[j] > oled_dirty_max[j]) {
+            /* 该页没有修改 */
+            continue;
+        }
+
+        oled_flush_span(j, oled_dirty_min[j], oled_dirty_max[j]);
+
+        oled_dirty_min[j] = OLED_MAX_COLUMN;
+        oled_dirty_max[j] = 0;
     }
 }
 
@@ -404,7 +556,7 @@ void oled_update(void) {
  *          屏幕区域: 0 ~ OLED_MAX_LINE - 1
  * @param width 指定区域的宽度, 范围: 0 ~ OLED_MAX_COLUMN
  * @param height 指定区域的高度, 范围: 0 ~ OLED_MAX_LINE
- * @note    此函数会至少更新参数指定的区域
+ * @note    此函数会至少更新参数指定的区域中修改过的部分
  *          如果更新区域 y 轴只包含部分页, 则同一页的剩余部分会跟随一起更新
  *          所有的显示函数, 都只是对 OLED 显存数组进行读写
  *          随后调用 oled_update 函数或 oled_update_area 函数
@@ -414,6 +566,7 @@ void oled_update(void) {
 void oled_update_area(int16_t x, int16_t y, uint8_t width, uint8_t height) {
     int16_t j;
     int16_t page, page1;
+    int16_t x0, x1;
 
     if (oled_is_open == 0) {
         return;
@@ -430,16 +583,54 @@ void oled_update_area(int16_t x, int16_t y, uint8_t width, uint8_t height) {
 
     /* 遍历指定区域涉及的相关页 */
     for (j = page; j < page1; j++) {
-        if (x >= 0 && x < OLED_MAX_COLUMN && j >= 0 && j < OLED_MAX_PAGE) {
-            /* 超出屏幕的内容不显示 *
-             * 设置光标位置为相关页的指定列 */
-            oled_set_cursor(j, x);
-            /* 连续写入 width 个数据, 将显存数组的数据写入到 OLED 硬件 */
-            oled_write_data(&oled_display_buf[j][x], width);
+        if (j < 0 || j >= OLED_MAX_PAGE) {
+            /* 超出屏幕的内容不显示 */
+            continue;
+        }
+
+        /* 只发送指定列与修改过的列的交集 */
+        x0 = (x > oled_dirty_min[j]) ? x : oled_dirty_min[j];
+        x1 = x + width - 1;
+        if (x1 > oled_dirty_max[j]) {
+            x1 = oled_dirty_max[j];
+        }
+        if (x0 > x1) {
+            continue;
         }
+
+        oled_flush_span(j, (uint8_t)x0, (uint8_t)x1);
+
+        /* 已发送的部分在修改范围的一端时缩小范围, 在中间时保持不变 */
+        if (x0 <= oled_dirty_min[j] && x1 >= oled_dirty_max[j]) {
+            oled_dirty_min[j] = OLED_MAX_COLUMN;
+            oled_dirty_max[j] = 0;
+        } else if (x0 <= oled_dirty_min[j]) {
+            oled_dirty_min[j] = (uint8_t)(x1 + 1);
+        } else if (x1 >= oled_dirty_max[j]) {
+            oled_dirty_max[j] = (uint8_t)(x0 - 1);
+        }
+    }
+}
+
+/**
+ * @brief 获取总线传输统计
+ *
+ * @param[out] stats 统计信息
+ */
+void oled_get_stats(oled_stats_t *stats) {
+    if (stats != NULL) {
+        *stats = oled_stats;
     }
 }
 
+/**
+ * @brief 清零总线传输统计
+ *
+ */
+void oled_reset_stats(void) {
+    memset(&oled_stats, 0, sizeof(oled_stats));
+}
+
 /**
  * @brief 将 OLED 显存数组全部清零
  *
@@ -451,6 +642,7 @@ void oled_clear(void) {
         for (i = 0; i < OLED_MAX_COLUMN; i++) {
             oled_display_buf[j][i] = 0x00;
         }
+        oled_mark_dirty(j, 0, OLED_MAX_COLUMN - 1);
     }
 }
 
@@ -468,6 +660,7 @@ void oled_clear(void) {
 void oled_clear_area(int16_t x, int16_t y, uint8_t width, uint8_t height) {
     int16_t i, j;
 
+    oled_mark_dirty_area(x, y, width, height);
     for (j = y; j < y + height; j++) {
         for (i = x; i < x + width; i++) {
             if (i >= 0 && i < OLED_MAX_COLUMN && j >= 0 && j < OLED_MAX_LINE) {
@@ -490,6 +683,7 @@ void oled_reserve(void) {
         for (i = 0; i < OLED_MAX_COLUMN; i++) {
             oled_display_buf[j][i] ^= 0xFF; /* 将显存数组数据全部取反 */
         }
+        oled_mark_dirty(j, 0, OLED_MAX_COLUMN - 1);
     }
 }
 
@@ -507,6 +701,7 @@ void oled_reserve(void) {
 void oled_reserve_area(int16_t x, int16_t y, uint8_t width, uint8_t height) {
     int16_t i, j;
 
+    oled_mark_dirty_area(x, y, width, height);
     for (j = y; j < y + height; j++) {
         for (i = x; i < x + width; i++) {
             if (i >= 0 && i < OLED_MAX_COLUMN && j >= 0 && j < OLED_MAX_LINE) {
@@ -885,6 +1080,8 @@ void oled_show_image(int16_t x, int16_t y, uint8_t width, uint8_t height,
 
     /* 将图像所在区域清空 */
     oled_clear_area(x, y, width, height);
+    /* 图像按整页写入, 可能超出 height 写到下一页 */
+    oled_mark_dirty_area(x, y, width, ((height - 1) / 8 + 2) * 8);
 
     /* 遍历指定图像涉及的相关页 *
      * (height - 1) / 8 + 1 的目的是 height / 8 并向上取整 */
@@ -893,13 +1090,9 @@ void oled_show_image(int16_t x, int16_t y, uint8_t width, uint8_t height,
         for (i = 0; i < width; i++) {
             if (x + i >= 0 && x + i < OLED_MAX_COLUMN) {
                 /* 超出屏幕的内容不显示 *
-                 * 负数坐标在计算页地址和移位时需要加一个偏移 */
+                 * 算术右移向下取整, 负数坐标不需要再加偏移 */
                 page = y >> 3;
                 shift = y & 0x7;
-                if (y < 0) {
-                    page -= 1;
-                    shift += 8;
-                }
 
                 if (page + j >= 0 && page + j < OLED_MAX_PAGE) {
                     /* 超出屏幕的内容不显示
@@ -948,6 +1141,316 @@ void oled_printf(int16_t x, int16_t y, uint8_t font_size, char *format, ...) {
     xSemaphoreGive(show_semp);
 }
 
+/**
+ * @brief 填充一行中连续的点
+ *
+ * @param x0 起始横坐标
+ * @param x1 结束横坐标 (包含), 小于 x0 时不画
+ * @param y 纵坐标
+ * @note 超出屏幕的部分忽略, 每列只改一个 Bit
+ */
+static void oled_fill_hspan(int16_t x0, int16_t x1, int16_t y) {
+    uint8_t *buf;
+    uint8_t bit;
+    int16_t x;
+
+    if (y < 0 || y >= OLED_MAX_LINE) {
+        return;
+    }
+    if (x0 < 0) {
+        x0 = 0;
+    }
+    if (x1 >= OLED_MAX_COLUMN) {
+        x1 = OLED_MAX_COLUMN - 1;
+    }
+    if (x0 > x1) {
+        return;
+    }
+
+    buf = oled_display_buf[y >> 3];
+    bit = 0x01 << (y & 0x7);
+    for (x = x0; x <= x1; x++) {
+        buf[x] |= bit;
+    }
+    oled_mark_dirty(y >> 3, x0, x1);
+}
+
+/**
+ * @brief 填充一列中连续的点
+ *
+ * @param x 横坐标
+ * @param y0 起始纵坐标
+ * @param y1 结束纵坐标 (包含), 小于 y0 时不画
+ * @note 超出屏幕的部分忽略, 每页只写一个字节
+ */
+static void oled_fill_vspan(int16_t x, int16_t y0, int16_t y1) {
+    int16_t page, last;
+    uint8_t mask;
+
+    if (x < 0 || x >= OLED_MAX_COLUMN) {
+        return;
+    }
+    if (y0 < 0) {
+        y0 = 0;
+    }
+    if (y1 >= OLED_MAX_LINE) {
+        y1 = OLED_MAX_LINE - 1;
+    }
+    if (y0 > y1) {
+        return;
+    }
+
+    last = y1 >> 3;
+    mask = 0xFF << (y0 & 0x7);
+    for (page = y0 >> 3; page <= last; page++) {
+        if (page == last) {
+            mask &= 0xFF >> (7 - (y1 & 0x7));
+        }
+        oled_display_buf[page][x] |= mask;
+        oled_mark_dirty(page, x, x);
+        mask = 0xFF;
+    }
+}
+
+/**
+ * @brief 填充矩形区域
+ *
+ * @param x0 左边界横坐标
+ * @param y0 上边界纵坐标
+ * @param x1 右边界横坐标 (包含)
+ * @param y1 下边界纵坐标 (包含)
+ * @note 超出屏幕的部分忽略, 每页按整字节掩码写入
+ */
+static void oled_fill_rect(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
+    int16_t page, last, x;
+    uint8_t mask;
+
+    if (x0 < 0) {
+        x0 = 0;
+    }
+    if (y0 < 0) {
+        y0 = 0;
+    }
+    if (x1 >= OLED_MAX_COLUMN) {
+        x1 = OLED_MAX_COLUMN - 1;
+    }
+    if (y1 >= OLED_MAX_LINE) {
+        y1 = OLED_MAX_LINE - 1;
+    }
+    if (x0 > x1 || y0 > y1) {
+        return;
+    }
+
+    last = y1 >> 3;
+    mask = 0xFF << (y0 & 0x7);
+    for (page = y0 >> 3; page <= last; page++) {
+        if (page == last) {
+            mask &= 0xFF >> (7 - (y1 & 0x7));
+        }
+        for (x = x0; x <= x1; x++) {
+            oled_display_buf[page][x] |= mask;
+        }
+        oled_mark_dirty(page, x0, x1);
+        mask = 0xFF;
+    }
+}
+
+/**
+ * @brief 扫描线填充多边形
+ *
+ * @param nvert 多边形的顶点数, 范围: 1 ~ OLED_POLYGON_MAX_VERTEX
+ * @param vertx 包含多边形顶点的 x 坐标的数组
+ * @param verty 包含多边形顶点的 y 坐标的数组
+ * @note 每一行求出各条边的交点并排序, 交点两两之间的部分在多边形内部.
+ *       交点的计算和取舍与 oled_pnpoly 完全相同, 填充结果与逐点判断一致
+ */
+static void oled_fill_polygon(uint8_t nvert, const int16_t *vertx,
+                              const int16_t *verty) {
+    int16_t nodex[OLED_POLYGON_MAX_VERTEX];
+    int16_t miny = verty[0], maxy = verty[0];
+    int16_t y, node;
+    uint8_t i, j, k, nodes;
+
+    for (i = 1; i < nvert; i++) {
+        if (verty[i] < miny) {
+            miny = verty[i];
+        }
+        if (verty[i] > maxy) {
+            maxy = verty[i];
+        }
+    }
+
+    /* 只扫描屏幕内的行 */
+    if (miny < 0) {
+        miny = 0;
+    }
+    if (maxy >= OLED_MAX_LINE) {
+        maxy = OLED_MAX_LINE - 1;
+    }
+
+    for (y = miny; y <= maxy; y++) {
+        /* 求出与该行相交的边的交点, 插入排序 */
+        nodes = 0;
+        for (i = 0, j = nvert - 1; i < nvert; j = i++) {
+            if ((verty[i] > y) != (verty[j] > y)) {
+                node = (vertx[j] - vertx[i]) * (y - verty[i]) /
+                           (verty[j] - verty[i]) +
+                       vertx[i];
+                for (k = nodes++; k > 0 && nodex[k - 1] > node; k--) {
+                    nodex[k] = nodex[k - 1];
+                }
+                nodex[k] = node;
+            }
+        }
+
+        /* 满足 x < 交点的边数为奇数的点在内部,
+         * 即 [nodex[0], nodex[1]), [nodex[2], nodex[3]) ... */
+        for (k = 0; k + 1 < nodes; k += 2) {
+            oled_fill_hspan(nodex[k], nodex[k + 1] - 1, y);
+        }
+    }
+}
+
+/**
+ * @brief 二分查找角度的边界
+ *
+ * @param cx 列相对圆心的横向偏移
+ * @param lo 起始纵向偏移, 区间内角度单调
+ * @param hi 结束纵向偏移 (包含)
+ * @param angle 要查找的角度
+ * @param rising 区间内角度是否不减
+ * @return rising 为 1 时, 返回第一个角度 >= angle 的位置;
+ *         rising 为 0 时, 返回第一个角度 < angle 的位置;
+ *         都不满足时返回 hi + 1
+ */
+static int16_t oled_angle_bound(int16_t cx, int16_t lo, int16_t hi,
+                                int32_t angle, uint8_t rising) {
+    int16_t mid;
+
+    while (lo <= hi) {
+        mid = lo + (hi - lo) / 2;
+        if ((oled_point_angle(cx, mid) >= angle) == rising) {
+            hi = mid - 1;
+        } else {
+            lo = mid + 1;
+        }
+    }
+
+    return lo;
+}
+
+/**
+ * @brief 填充扇形中角度单调的一段列
+ *
+ * @param x 列的横坐标
+ * @param y 圆心纵坐标
+ * @param cx 列相对圆心的横向偏移
+ * @param lo 起始纵向偏移
+ * @param hi 结束纵向偏移 (包含), 小于 lo 时不画
+ * @param start_angle 起始角度
+ * @param end_angle 终止角度
+ * @note 两端都在角度内或都不在时直接处理, 否则二分查找边界,
+ *       结果与逐点调用 oled_is_in_angle 一致
+ */
+static void oled_fill_arc_segment(int16_t x, int16_t y, int16_t cx, int16_t lo,
+                                  int16_t hi, int16_t start_angle,
+                                  int16_t end_angle) {
+    int16_t amin, amax, bs, be;
+    uint8_t rising = (cx >= 0);
+
+    if (lo > hi) {
+        return;
+    }
+
+    amin = oled_point_angle(cx, lo);
+    amax = oled_point_angle(cx, hi);
+    if (amin > amax) {
+        bs = amin;
+        amin = amax;
+        amax = bs;
+    }
+
+    if (start_angle < end_angle) {
+        if (amin >= start_angle && amax <= end_angle) {
+            oled_fill_vspan(x, y + lo, y + hi);
+            return;
+        }
+        if (amax < start_angle || amin > end_angle) {
+            return;
+        }
+    } else {
+        if (amin >= start_angle || amax <= end_angle) {
+            oled_fill_vspan(x, y + lo, y + hi);
+            return;
+        }
+        if (amin > end_angle && amax < start_angle) {
+            return;
+        }
+    }
+
+    /* 角度 >= start_angle 与角度 <= end_angle 的部分各是一段连续区间 */
+    bs = oled_angle_bound(cx, lo, hi, start_angle, rising);
+    be = oled_angle_bound(cx, lo, hi, (int32_t)end_angle + 1, rising);
+
+    if (rising) {
+        /* [bs, hi] 角度 >= start_angle, [lo, be) 角度 <= end_angle */
+        if (start_angle < end_angle) {
+            oled_fill_vspan(x, y + bs, y + be - 1);
+        } else {
+            oled_fill_vspan(x, y + bs, y + hi);
+            oled_fill_vspan(x, y + lo, y + be - 1);
+        }
+    } else {
+        /* [lo, bs) 角度 >= start_angle, [be, hi] 角度 <= end_angle */
+        if (start_angle < end_angle) {
+            oled_fill_vspan(x, y + be, y + bs - 1);
+        } else {
+            oled_fill_vspan(x, y + lo, y + bs - 1);
+            oled_fill_vspan(x, y + be, y + hi);
+        }
+    }
+}
+
+/**
+ * @brief 填充扇形中的一列
+ *
+ * @param x 圆心横坐标
+ * @param y 圆心纵坐标
+ * @param cx 列相对圆心的横向偏移
+ * @param j0 起始纵向偏移
+ * @param j1 结束纵向偏移 (包含)
+ * @param start_angle 起始角度
+ * @param end_angle 终止角度
+ */
+static void oled_fill_arc_vspan(int16_t x, int16_t y, int16_t cx, int16_t j0,
+                                int16_t j1, int16_t start_angle,
+                                int16_t end_angle) {
+    x += cx;
+    if (x < 0 || x >= OLED_MAX_COLUMN) {
+        return;
+    }
+
+    /* 只计算屏幕内的点 */
+    if (j0 < -y) {
+        j0 = -y;
+    }
+    if (j1 > OLED_MAX_LINE - 1 - y) {
+        j1 = OLED_MAX_LINE - 1 - y;
+    }
+    if (j0 > j1) {
+        return;
+    }
+
+    /* 按 j < 0, j = 0, j > 0 分成三段, 每段内角度单调 */
+    oled_fill_arc_segment(x, y, cx, j0, j1 < -1 ? j1 : -1, start_angle,
+                          end_angle);
+    if (j0 <= 0 && j1 >= 0) {
+        oled_fill_arc_segment(x, y, cx, 0, 0, start_angle, end_angle);
+    }
+    oled_fill_arc_segment(x, y, cx, j0 > 1 ? j0 : 1, j1, start_angle,
+                          end_angle);
+}
+
 /**
  * @brief OLED 在指定位置画一个点
  *
@@ -962,6 +1465,7 @@ void oled_draw_point(int16_t x, int16_t y) {
         /* 超出屏幕的内容不显示
          * 将显存数组指定位置的一个 Bit 数据置 1 */
         oled_display_buf[y >> 3][x] |= 0x01 << (y & 0x7);
+        oled_mark_dirty(y >> 3, x, x);
     }
 }
 
@@ -986,6 +1490,34 @@ uint8_t oled_get_point(int16_t x, int16_t y) {
     return 0;
 }
 
+/**
+ * @brief OLED 画横线
+ *
+ * @param x 指定横线左端点的横坐标, 范围: -32768 ~ 32767,
+ *          屏幕区域: 0 ~ OLED_MAX_COLUMN - 1
+ * @param y 指定横线的纵坐标, 范围: -32768 ~ 32767,
+ *          屏幕区域: 0 ~ OLED_MAX_LINE - 1
+ * @param width 指定横线的长度, 范围: 0 ~ 255
+ * @note 调用此函数后, 要想真正地呈现在屏幕上, 还需调用更新函数
+ */
+void oled_draw_hline(int16_t x, int16_t y, uint8_t width) {
+    oled_fill_hspan(x, x + width - 1, y);
+}
+
+/**
+ * @brief OLED 画竖线
+ *
+ * @param x 指定竖线的横坐标, 范围: -32768 ~ 32767,
+ *          屏幕区域: 0 ~ OLED_MAX_COLUMN - 1
+ * @param y 指定竖线上端点的纵坐标, 范围: -32768 ~ 32767,
+ *          屏幕区域: 0 ~ OLED_MAX_LINE - 1
+ * @param height 指定竖线的长度, 范围: 0 ~ 255
+ * @note 调用此函数后, 要想真正地呈现在屏幕上, 还需调用更新函数
+ */
+void oled_draw_vline(int16_t x, int16_t y, uint8_t height) {
+    oled_fill_vspan(x, y, y + height - 1);
+}
+
 /**
  * @brief OLED 画线
  *
@@ -1013,10 +1545,8 @@ void oled_draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
             x1 = temp;
         }
 
-        /* 遍历 X 坐标 */
-        for (x = x0; x <= x1; x++) {
-            oled_draw_point(x, y0); /* 依次画点 */
-        }
+        /* 整段写入显存 */
+        oled_fill_hspan(x0, x1, y0);
     } else if (x0 == x1) {
         /* 竖线单独处理 */
 
@@ -1027,10 +1557,8 @@ void oled_draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
             y1 = temp;
         }
 
-        /* 遍历 y 坐标 */
-        for (y = y0; y <= y1; y++) {
-            oled_draw_point(x0, y); /* 依次画点 */
-        }
+        /* 按页整字节写入显存 */
+        oled_fill_vspan(x0, y0, y1);
     } else {
         /* 使用 Bresenham 算法画直线, 可以避免耗时的浮点运算, 效率更高
          * 参考文档:https://www.cs.montana.edu/courses/spring2009/425/dslectures/Bresenham.pdf
@@ -1136,31 +1664,18 @@ void oled_draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1) {
  */
 void oled_draw_rectangle(int16_t x, int16_t y, uint8_t width, uint8_t height,
                          uint8_t is_filled) {
-    int16_t i, j;
     if (!is_filled) {
         /* 指定矩形不填充 */
 
-        /* 遍历上下 X 坐标, 画矩形上下两条线 */
-        for (i = x; i < x + width; i++) {
-            oled_draw_point(i, y);
-            oled_draw_point(i, y + height - 1);
-        }
-        /* 遍历左右 y 坐标, 画矩形左右两条线 */
-        for (i = y; i < y + height; i++) {
-            oled_draw_point(x, i);
-            oled_draw_point(x + width - 1, i);
-        }
+        /* 画矩形上下两条线 */
+        oled_fill_hspan(x, x + width - 1, y);
+        oled_fill_hspan(x, x + width - 1, y + height - 1);
+        /* 画矩形左右两条线 */
+        oled_fill_vspan(x, y, y + height - 1);
+        oled_fill_vspan(x + width - 1, y, y + height - 1);
     } else {
-        /* 指定矩形填充 */
-
-        /* 遍历 X 坐标 */
-        for (i = x; i < x + width; i++) {
-            /* 遍历 y 坐标 */
-            for (j = y; j < y + height; j++) {
-                /* 在指定区域画点, 填充满矩形 */
-                oled_draw_point(i, j);
-            }
-        }
+        /* 指定矩形填充, 按页整字节写入 */
+        oled_fill_rect(x, y, x + width - 1, y + height - 1);
     }
 }
 
@@ -1186,8 +1701,6 @@ void oled_draw_rectangle(int16_t x, int16_t y, uint8_t width, uint8_t height,
  */
 void oled_draw_tritangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                          int16_t x2, int16_t y2, uint8_t is_filled) {
-    int16_t minx = x0, miny = y0, maxx = x0, maxy = y0;
-    int16_t i, j;
     int16_t vx[] = {x0, x1, x2};
     int16_t vy[] = {y0, y1, y2};
 
@@ -1199,50 +1712,39 @@ void oled_draw_tritangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
         oled_draw_line(x0, y0, x2, y2);
         oled_draw_line(x1, y1, x2, y2);
     } else {
-        /* 指定三角形填充 */
-
-        /* 找到三个点最小的 x, y 坐标 */
-        if (x1 < minx) {
-            minx = x1;
-        }
-        if (x2 < minx) {
-            minx = x2;
-        }
-        if (y1 < miny) {
-            miny = y1;
-        }
-        if (y2 < miny) {
-            miny = y2;
-        }
-
-        /* 找到三个点最大的 x, y 坐标 */
-        if (x1 > maxx) {
-            maxx = x1;
-        }
-        if (x2 > maxx) {
-            maxx = x2;
-        }
-        if (y1 > maxy) {
-            maxy = y1;
-        }
-        if (y2 > maxy) {
-            maxy = y2;
-        }
+        /* 指定三角形填充, 逐行扫描, 结果与逐点调用 oled_pnpoly 一致 */
+        oled_fill_polygon(3, vx, vy);
+    }
+}
 
-        /* 最小最大坐标之间的矩形为可能需要填充的区域 遍历此区域中所有的点 */
+/**
+ * @brief OLED 多边形
+ *
+ * @param nvert 多边形的顶点数, 范围: 1 ~ OLED_POLYGON_MAX_VERTEX
+ * @param vertx 包含多边形顶点的 x 坐标的数组, 范围: -32768 ~ 32767,
+ *              屏幕区域: 0 ~ OLED_MAX_COLUMN - 1
+ * @param verty 包含多边形顶点的 y 坐标的数组, 范围: -32768 ~ 32767,
+ *              屏幕区域: 0 ~ OLED_MAX_LINE - 1
+ * @param is_filled 指定多边形是否填充, 填充规则与 oled_pnpoly 相同 (奇偶规则)
+ *  @arg OLED_UNFILLED 不填充
+ *  @arg OLED_FILLED 填充
+ * @note 调用此函数后, 要想真正地呈现在屏幕上, 还需调用更新函数
+ */
+void oled_draw_polygon(uint8_t nvert, const int16_t *vertx,
+                       const int16_t *verty, uint8_t is_filled) {
+    uint8_t i, j;
 
-        /* 遍历 x 坐标 */
-        for (i = minx; i <= maxx; i++) {
-            /* 遍历 y 坐标 */
-            for (j = miny; j <= maxy; j++) {
-                /* 调用 oled_pnpoly, 判断指定点是否在指定三角形之中 */
+    if (nvert == 0 || nvert > OLED_POLYGON_MAX_VERTEX) {
+        return;
+    }
 
-                /* 如果在, 则画点, 如果不在, 则不做处理 */
-                if (oled_pnpoly(3, vx, vy, i, j)) {
-                    oled_draw_point(i, j);
-                }
-            }
+    if (!is_filled) {
+        /* 指定多边形不填充, 依次连接相邻顶点 */
+        for (i = 0, j = nvert - 1; i < nvert; j = i++) {
+            oled_draw_line(vertx[j], verty[j], vertx[i], verty[i]);
         }
+    } else {
+        oled_fill_polygon(nvert, vertx, verty);
     }
 }
 
@@ -1264,7 +1766,7 @@ void oled_draw_circle(int16_t x, int16_t y, uint8_t radius, uint8_t is_filled) {
     /* 使用 Bresenham 算法画圆, 可以避免耗时的浮点运算, 效率更高
      * 参考文档:https://www.cs.montana.edu/courses/spring2009/425/dslectures/Bresenham.pdf
      * 参考教程:https://www.bilibili.com/video/BV1VM4y1u7wJ */
-    int16_t px, py, d, j;
+    int16_t px, py, d;
 
     d = 1 - radius;
     px = 0;
@@ -1277,11 +1779,8 @@ void oled_draw_circle(int16_t x, int16_t y, uint8_t radius, uint8_t is_filled) {
     oled_draw_point(x - py, y - px);
 
     if (is_filled) {
-        /* 遍历起始点 Y 坐标 */
-        for (j = -py; j < py; j++) {
-            /* 在指定区域画点, 填充部分圆 */
-            oled_draw_point(x, y + j);
-        }
+        /* 填充起始点所在的列 */
+        oled_fill_vspan(x, y - py, y + py - 1);
     }
 
     while (px < py) {
@@ -1306,19 +1805,13 @@ void oled_draw_circle(int16_t x, int16_t y, uint8_t radius, uint8_t is_filled) {
         oled_draw_point(x - py, y + px);
 
         if (is_filled) {
-            /* 遍历中间部分 */
-            for (j = -py; j < py; j++) {
-                /* 在指定区域画点, 填充部分圆 */
-                oled_draw_point(x + px, y + j);
-                oled_draw_point(x - px, y + j);
-            }
+            /* 填充中间部分的两列 */
+            oled_fill_vspan(x + px, y - py, y + py - 1);
+            oled_fill_vspan(x - px, y - py, y + py - 1);
 
-            /* 遍历两侧部分 */
-            for (j = -px; j < px; j++) {
-                /* 在指定区域画点, 填充部分圆 */
-                oled_draw_point(x - py, y + j);
-                oled_draw_point(x + py, y + j);
-            }
+            /* 填充两侧部分的两列 */
+            oled_fill_vspan(x - py, y - px, y + px - 1);
+            oled_fill_vspan(x + py, y - px, y + px - 1);
         }
     }
 }
@@ -1343,7 +1836,7 @@ void oled_draw_ellipse(int16_t x, int16_t y, uint8_t a, uint8_t b,
     /* 使用 Bresenham 算法画椭圆, 可以避免部分耗时的浮点运算, 效率更高
      * 参考链接:https://blog.csdn.net/myf_666/article/details/128167392 */
 
-    int16_t px, py, j;
+    int16_t px, py;
     float d1, d2;
 
     px = 0;
@@ -1351,12 +1844,8 @@ void oled_draw_ellipse(int16_t x, int16_t y, uint8_t a, uint8_t b,
     d1 = b * b + a * a * (-b + 0.5);
 
     if (is_filled) {
-        /* 遍历起始点 y 坐标 */
-        for (j = -py; j < py; j++) {
-            /* 在指定区域画点, 填充部分椭圆 */
-            oled_draw_point(x, y + j);
-            oled_draw_point(x, y + j);
-        }
+        /* 填充起始点所在的列 */
+        oled_fill_vspan(x, y - py, y + py - 1);
     }
 
     /* 画椭圆弧的起始点 */
@@ -1378,12 +1867,9 @@ void oled_draw_ellipse(int16_t x, int16_t y, uint8_t a, uint8_t b,
         px++;
 
         if (is_filled) {
-            /* 遍历中间部分 */
-            for (j = -py; j < py; j++) {
-                /* 在指定区域画点, 填充部分椭圆 */
-                oled_draw_point(x + px, y + j);
-                oled_draw_point(x - px, y + j);
-            }
+            /* 填充中间部分的两列 */
+            oled_fill_vspan(x + px, y - py, y + py - 1);
+            oled_fill_vspan(x - px, y - py, y + py - 1);
         }
 
         /* 画椭圆中间部分圆弧 */
@@ -1410,12 +1896,9 @@ void oled_draw_ellipse(int16_t x, int16_t y, uint8_t a, uint8_t b,
         py--;
 
         if (is_filled) {
-            /* 遍历两侧部分 */
-            for (j = -py; j < py; j++) {
-                /* 在指定区域画点, 填充部分椭圆 */
-                oled_draw_point(x + px, y + j);
-                oled_draw_point(x - px, y + j);
-            }
+            /* 填充两侧部分的两列 */
+            oled_fill_vspan(x + px, y - py, y + py - 1);
+            oled_fill_vspan(x - px, y - py, y + py - 1);
         }
 
         /* 画椭圆两侧部分圆弧 */
@@ -1444,7 +1927,7 @@ void oled_draw_ellipse(int16_t x, int16_t y, uint8_t a, uint8_t b,
  */
 void oled_draw_arc(int16_t x, int16_t y, uint8_t radius, int16_t start_angle,
                    int16_t end_angle, uint8_t is_filled) {
-    int16_t px, py, d, j;
+    int16_t px, py, d;
 
     /* 此函数借用 Bresenham 算法画圆的方法 */
 
@@ -1468,14 +1951,8 @@ void oled_draw_arc(int16_t x, int16_t y, uint8_t radius, int16_t start_angle,
     }
 
     if (is_filled) {
-        /* 遍历起始点 Y 坐标 */
-        for (j = -py; j < py; j++) {
-            /* 在填充圆的每个点时, 判断指定点是否在指定角度内,
-             * 在, 则画点, 不在, 则不做处理 */
-            if (oled_is_in_angle(0, j, start_angle, end_angle)) {
-                oled_draw_point(x, y + j);
-            }
-        }
+        /* 填充起始点所在的列中在指定角度内的部分 */
+        oled_fill_arc_vspan(x, y, 0, -py, py - 1, start_angle, end_angle);
     }
 
     while (px < py) {
@@ -1518,29 +1995,15 @@ void oled_draw_arc(int16_t x, int16_t y, uint8_t radius, int16_t start_angle,
         }
 
         if (is_filled) {
-            /* 遍历中间部分 */
-            for (j = -py; j < py; j++) {
-                /* 在填充圆的每个点时, 判断指定点是否在指定角度内,
-                 * 在, 则画点, 不在, 则不做处理 */
-                if (oled_is_in_angle(px, j, start_angle, end_angle)) {
-                    oled_draw_point(x + px, y + j);
-                }
-                if (oled_is_in_angle(-px, j, start_angle, end_angle)) {
-                    oled_draw_point(x - px, y + j);
-                }
-            }
-
-            /* 遍历两侧部分 */
-            for (j = -px; j < px; j++) {
-                /* 在填充圆的每个点时, 判断指定点是否在指定角度内,
-                 * 在, 则画点, 不在, 则不做处理 */
-                if (oled_is_in_angle(-py, j, start_angle, end_angle)) {
-                    oled_draw_point(x - py, y + j);
-                }
-                if (oled_is_in_angle(py, j, start_angle, end_angle)) {
-                    oled_draw_point(x + py, y + j);
-                }
-            }
+            /* 填充中间部分两列中在指定角度内的部分 */
+            oled_fill_arc_vspan(x, y, px, -py, py - 1, start_angle, end_angle);
+            oled_fill_arc_vspan(x, y, -px, -py, py - 1, start_angle,
+                                end_angle);
+
+            /* 填充两侧部分两列中在指定角度内的部分 */
+            oled_fill_arc_vspan(x, y, -py, -px, px - 1, start_angle,
+                                end_angle);
+            oled_fill_arc_vspan(x, y, py, -px, px - 1, start_angle, end_angle);
         }
     }
 }
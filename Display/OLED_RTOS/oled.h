@@ -26,7 +26,9 @@ extern "C" {
 /* 定义 OLED 尺寸, 0.91/0.96/1.30 */
 #define OLED_0_96
 /* 定义通讯方式, I2C 或者 SPI */
+#if !defined(OLED_USE_I2C) && !defined(OLED_USE_SPI)
 #define OLED_USE_SPI
+#endif /* OLED_INTERFACE */
 
 #if (defined(OLED_USE_SPI))
 /* 片选引脚 */
@@ -68,6 +70,26 @@ extern "C" {
 #define OLED_UNFILLED   0
 #define OLED_FILLED     1
 
+/* 是否保存屏幕上已显示的内容, 更新时只发送与之不同的数据, 需要额外一份显存 */
+#ifndef OLED_USE_SHADOW_BUF
+#define OLED_USE_SHADOW_BUF  1
+#endif /* OLED_USE_SHADOW_BUF */
+/* 同一页两段改动之间的间隔小于该值时合并发送, 避免重复设置光标 */
+#define OLED_FLUSH_MERGE_GAP 8
+
+/* 多边形最多顶点数 */
+#define OLED_POLYGON_MAX_VERTEX 16
+
+/**
+ * @brief 总线传输统计
+ */
+typedef struct {
+    uint32_t cmd_bytes;  /*!< 发送的命令字节数 */
+    uint32_t data_bytes; /*!< 发送的显存字节数 */
+    uint32_t wire_bytes; /*!< 总线上的总字节数 (含 I2C 地址和控制字节) */
+    uint32_t transfers;  /*!< 传输次数 */
+} oled_stats_t;
+
 /* 公开图片数据 */
 extern const uint8_t gc_image[];
 
@@ -77,6 +99,8 @@ void oled_off(void);
 
 void oled_update(void);
 void oled_update_area(int16_t x, int16_t y, uint8_t width, uint8_t height);
+void oled_get_stats(oled_stats_t *stats);
+void oled_reset_stats(void);
 
 void oled_clear(void);
 void oled_clear_area(int16_t x, int16_t y, uint8_t width, uint8_t height);
@@ -101,11 +125,15 @@ void oled_printf(int16_t x, int16_t y, uint8_t font_size, char *format, ...);
 
 void oled_draw_point(int16_t x, int16_t y);
 uint8_t oled_get_point(int16_t x, int16_t y);
+void oled_draw_hline(int16_t x, int16_t y, uint8_t width);
+void oled_draw_vline(int16_t x, int16_t y, uint8_t height);
 void oled_draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
 void oled_draw_rectangle(int16_t x, int16_t y, uint8_t width, uint8_t height,
                          uint8_t is_filled);
 void oled_draw_tritangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
                          int16_t x2, int16_t y2, uint8_t is_filled);
+void oled_draw_polygon(uint8_t nvert, const int16_t *vertx,
+                       const int16_t *verty, uint8_t is_filled);
 void oled_draw_circle(int16_t x, int16_t y, uint8_t radius, uint8_t is_filled);
 void oled_draw_ellipse(int16_t x, int16_t y, uint8_t a, uint8_t b,
                        uint8_t is_filled);
@@ -0,0 +1,324 @@
+/**
+ * @file    oled_fill_test.c
+ * @brief   按段填充的主机测试: 与改动之前逐点绘制的图形逐像素比较
+ *
+ * 参照实现 oled_ref.c 是改动之前的 oled.c, 全局符号由 oled_ref.h 改名.
+ * 在 `Display/OLED_RTOS` 下编译运行, 比较结果用带检查的编译, 耗时用 -O2:
+ *
+ *   gcc -std=gnu11 -g -O1 -fsanitize=address,undefined -Itest/stub -Itest \
+ *       -I. test/oled_fill_test.c test/oled_ref.c test/oled_mock.c oled.c \
+ *       -lm -o oled_fill_test && ./oled_fill_test
+ *   gcc -std=gnu11 -O2 -Itest/stub -Itest -I. test/oled_fill_test.c \
+ *       test/oled_ref.c test/oled_mock.c oled.c -lm -o oled_fill_test && \
+ *       ./oled_fill_test
+ *
+ * 检查项:
+ *  - 随机的矩形, 三角形, 圆, 椭圆, 圆弧 (填充与不填充) 和直线, 坐标包括屏幕
+ *    外, 每次绘制后两边的显存逐像素相同
+ *  - 水平线和竖直线与 `oled_draw_line` 画出的相同
+ *  - 多边形填充与逐点调用 `oled_pnpoly` 的结果相同, 包括自相交的多边形
+ *  - 大量随机圆弧 (起止角度任意) 填充结果相同
+ *  - 绘制后 `oled_update` 发送到屏幕的内容与显存相同
+ *
+ * 最后给出各图形每次绘制的耗时.
+ */
+
+#include "oled.h"
+#include "oled_mock.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+#define TEST_SHAPES  10000
+#define TEST_ARCS    20000
+#define BENCH_CALLS  2000
+
+/* 参照实现, 见 oled_ref.h */
+void ref_oled_clear(void);
+void ref_oled_draw_point(int16_t x, int16_t y);
+uint8_t ref_oled_get_point(int16_t x, int16_t y);
+void ref_oled_draw_line(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+void ref_oled_draw_rectangle(int16_t x, int16_t y, uint8_t width,
+                             uint8_t height, uint8_t is_filled);
+void ref_oled_draw_tritangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+                             int16_t x2, int16_t y2, uint8_t is_filled);
+void ref_oled_draw_circle(int16_t x, int16_t y, uint8_t radius,
+                          uint8_t is_filled);
+void ref_oled_draw_ellipse(int16_t x, int16_t y, uint8_t a, uint8_t b,
+                           uint8_t is_filled);
+void ref_oled_draw_arc(int16_t x, int16_t y, uint8_t radius,
+                       int16_t start_angle, int16_t end_angle,
+                       uint8_t is_filled);
+uint8_t ref_oled_pnpoly(uint8_t nvert, int16_t *vertx, int16_t *verty,
+                        int16_t testx, int16_t testy);
+
+static uint32_t test_rand_state = 1;
+
+static uint32_t test_rand(void) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return test_rand_state >> 8;
+}
+
+static int16_t test_rand_range(int16_t lo, int16_t hi) {
+    return (int16_t)(lo + (int16_t)(test_rand() % (uint32_t)(hi - lo + 1)));
+}
+
+static void test_clear(void) {
+    oled_clear();
+    ref_oled_clear();
+}
+
+static void test_compare(const char *what) {
+    for (int16_t y = 0; y < OLED_MAX_LINE; ++y) {
+        for (int16_t x = 0; x < OLED_MAX_COLUMN; ++x) {
+            if (oled_get_point(x, y) != ref_oled_get_point(x, y)) {
+                printf("%s: pixel (%d, %d) differs\n", what, x, y);
+                exit(1);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 多边形的参照: 包围盒内逐点调用 oled_pnpoly
+ */
+static void test_ref_polygon(uint8_t nvert, int16_t *vx, int16_t *vy) {
+    int16_t minx = vx[0], maxx = vx[0], miny = vy[0], maxy = vy[0];
+
+    for (uint8_t i = 1; i < nvert; ++i) {
+        minx = (vx[i] < minx) ? vx[i] : minx;
+        maxx = (vx[i] > maxx) ? vx[i] : maxx;
+        miny = (vy[i] < miny) ? vy[i] : miny;
+        maxy = (vy[i] > maxy) ? vy[i] : maxy;
+    }
+
+    for (int16_t x = minx; x <= maxx; ++x) {
+        for (int16_t y = miny; y <= maxy; ++y) {
+            if (ref_oled_pnpoly(nvert, vx, vy, x, y)) {
+                ref_oled_draw_point(x, y);
+            }
+        }
+    }
+}
+
+static void test_random_shapes(void) {
+    static const char *const names[] = {"rectangle", "triangle", "circle",
+                                        "ellipse",   "arc",      "line",
+                                        "hline",     "vline",    "polygon"};
+    uint32_t counts[9] = {0};
+
+    for (uint32_t n = 0; n < TEST_SHAPES; ++n) {
+        int16_t x = test_rand_range(-40, OLED_MAX_COLUMN + 40);
+        int16_t y = test_rand_range(-40, OLED_MAX_LINE + 40);
+        int16_t x1 = test_rand_range(-40, OLED_MAX_COLUMN + 40);
+        int16_t y1 = test_rand_range(-40, OLED_MAX_LINE + 40);
+        int16_t x2 = test_rand_range(-40, OLED_MAX_COLUMN + 40);
+        int16_t y2 = test_rand_range(-40, OLED_MAX_LINE + 40);
+        uint8_t filled = test_rand() % 2;
+        uint32_t shape = test_rand() % 9;
+
+        if (test_rand() % 8 == 0) {
+            test_clear();
+        }
+
+        switch (shape) {
+            case 0: {
+                uint8_t w = (uint8_t)test_rand_range(0, 200);
+                uint8_t h = (uint8_t)test_rand_range(0, 100);
+                oled_draw_rectangle(x, y, w, h, filled);
+                ref_oled_draw_rectangle(x, y, w, h, filled);
+            } break;
+
+            case 1: {
+                oled_draw_tritangle(x, y, x1, y1, x2, y2, filled);
+                ref_oled_draw_tritangle(x, y, x1, y1, x2, y2, filled);
+            } break;
+
+            case 2: {
+                uint8_t r = (uint8_t)test_rand_range(0, 70);
+                oled_draw_circle(x, y, r, filled);
+                ref_oled_draw_circle(x, y, r, filled);
+            } break;
+
+            case 3: {
+                uint8_t a = (uint8_t)test_rand_range(0, 80);
+                uint8_t b = (uint8_t)test_rand_range(0, 50);
+                oled_draw_ellipse(x, y, a, b, filled);
+                ref_oled_draw_ellipse(x, y, a, b, filled);
+            } break;
+
+            case 4: {
+                uint8_t r = (uint8_t)test_rand_range(0, 60);
+                int16_t start = test_rand_range(-180, 180);
+                int16_t end = test_rand_range(-180, 180);
+                oled_draw_arc(x, y, r, start, end, filled);
+                ref_oled_draw_arc(x, y, r, start, end, filled);
+            } break;
+
+            case 5: {
+                oled_draw_line(x, y, x1, y1);
+                ref_oled_draw_line(x, y, x1, y1);
+            } break;
+
+            case 6: {
+                uint8_t w = (uint8_t)test_rand_range(1, 200);
+                oled_draw_hline(x, y, w);
+                ref_oled_draw_line(x, y, x + w - 1, y);
+            } break;
+
+            case 7: {
+                uint8_t h = (uint8_t)test_rand_range(1, 100);
+                oled_draw_vline(x, y, h);
+                ref_oled_draw_line(x, y, x, y + h - 1);
+            } break;
+
+            default: {
+                int16_t vx[OLED_POLYGON_MAX_VERTEX];
+                int16_t vy[OLED_POLYGON_MAX_VERTEX];
+                uint8_t nvert = (uint8_t)test_rand_range(
+                    3, OLED_POLYGON_MAX_VERTEX);
+
+                for (uint8_t i = 0; i < nvert; ++i) {
+                    vx[i] = test_rand_range(-40, OLED_MAX_COLUMN + 40);
+                    vy[i] = test_rand_range(-40, OLED_MAX_LINE + 40);
+                }
+                oled_draw_polygon(nvert, vx, vy, filled);
+                if (filled) {
+                    test_ref_polygon(nvert, vx, vy);
+                } else {
+                    for (uint8_t i = 0, j = nvert - 1; i < nvert; j = i++) {
+                        ref_oled_draw_line(vx[j], vy[j], vx[i], vy[i]);
+                    }
+                }
+            } break;
+        }
+
+        test_compare(names[shape]);
+        counts[shape]++;
+
+        /* 发送到屏幕的内容与显存相同 */
+        if (n % 64 == 0) {
+            oled_update();
+            mock_i2c_complete();
+            for (int16_t py = 0; py < OLED_MAX_LINE; ++py) {
+                for (int16_t px = 0; px < OLED_MAX_COLUMN; ++px) {
+                    CHECK(oled_get_point(px, py) ==
+                          ((mock_panel[py / 8][px] >> (py % 8)) & 0x01));
+                }
+            }
+        }
+    }
+
+    printf("random shapes:");
+    for (uint32_t i = 0; i < 9; ++i) {
+        printf(" %u %s%s", counts[i], names[i], (i < 8) ? "," : "");
+    }
+    printf(", identical\n");
+}
+
+/**
+ * @brief 填充圆弧, 在屏幕内, 起止角度任意
+ */
+static void test_random_arcs(void) {
+    for (uint32_t n = 0; n < TEST_ARCS; ++n) {
+        int16_t x = test_rand_range(20, OLED_MAX_COLUMN - 20);
+        int16_t y = test_rand_range(20, OLED_MAX_LINE - 20);
+        uint8_t r = (uint8_t)test_rand_range(0, 31);
+        int16_t start = test_rand_range(-180, 180);
+        int16_t end = test_rand_range(-180, 180);
+
+        test_clear();
+        oled_draw_arc(x, y, r, start, end, OLED_FILLED);
+        ref_oled_draw_arc(x, y, r, start, end, OLED_FILLED);
+        test_compare("filled arc");
+    }
+
+    printf("random filled arcs: %u identical\n", TEST_ARCS);
+}
+
+/*****************************************************************************
+ * 耗时
+ */
+
+static double test_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief 每次调用的耗时 (ns), 5 轮取最小值
+ */
+#define TEST_BENCH(result, call)                                               \
+    do {                                                                       \
+        result = 1e30;                                                         \
+        for (int round = 0; round < 5; ++round) {                              \
+            double start = test_now();                                         \
+            for (uint32_t i = 0; i < BENCH_CALLS; ++i) {                       \
+                call;                                                          \
+            }                                                                  \
+            double t = (test_now() - start) / BENCH_CALLS;                     \
+            result = (t < result) ? t : result;                                \
+        }                                                                      \
+    } while (0)
+
+static void test_bench(void) {
+    int16_t vx[] = {64, 100, 110, 64, 18, 28};
+    int16_t vy[] = {4, 14, 44, 60, 44, 14};
+    double new_ns, ref_ns;
+
+    TEST_BENCH(new_ns, oled_draw_rectangle(30, 10, 60, 40, OLED_FILLED));
+    TEST_BENCH(ref_ns, ref_oled_draw_rectangle(30, 10, 60, 40, OLED_FILLED));
+    printf("bench 60x40 rectangle: %8.2f us -> %6.2f us\n", ref_ns / 1e3,
+           new_ns / 1e3);
+
+    TEST_BENCH(new_ns,
+               oled_draw_tritangle(10, 5, 110, 30, 40, 60, OLED_FILLED));
+    TEST_BENCH(ref_ns,
+               ref_oled_draw_tritangle(10, 5, 110, 30, 40, 60, OLED_FILLED));
+    printf("bench triangle:        %8.2f us -> %6.2f us\n", ref_ns / 1e3,
+           new_ns / 1e3);
+
+    TEST_BENCH(new_ns, oled_draw_circle(64, 32, 24, OLED_FILLED));
+    TEST_BENCH(ref_ns, ref_oled_draw_circle(64, 32, 24, OLED_FILLED));
+    printf("bench r24 circle:      %8.2f us -> %6.2f us\n", ref_ns / 1e3,
+           new_ns / 1e3);
+
+    TEST_BENCH(new_ns, oled_draw_ellipse(64, 32, 40, 20, OLED_FILLED));
+    TEST_BENCH(ref_ns, ref_oled_draw_ellipse(64, 32, 40, 20, OLED_FILLED));
+    printf("bench 40x20 ellipse:   %8.2f us -> %6.2f us\n", ref_ns / 1e3,
+           new_ns / 1e3);
+
+    TEST_BENCH(new_ns, oled_draw_arc(64, 32, 24, -30, 120, OLED_FILLED));
+    TEST_BENCH(ref_ns, ref_oled_draw_arc(64, 32, 24, -30, 120, OLED_FILLED));
+    printf("bench r24 sector:      %8.2f us -> %6.2f us\n", ref_ns / 1e3,
+           new_ns / 1e3);
+
+    TEST_BENCH(new_ns, oled_draw_polygon(6, vx, vy, OLED_FILLED));
+    TEST_BENCH(ref_ns, test_ref_polygon(6, vx, vy));
+    printf("bench 6-gon (pnpoly per pixel): %8.2f us -> %6.2f us\n",
+           ref_ns / 1e3, new_ns / 1e3);
+}
+
+int main(void) {
+    mock_panel_reset(0x00);
+    oled_init();
+    test_clear();
+
+    test_random_shapes();
+    test_random_arcs();
+    test_bench();
+
+    printf("all passed\n");
+    return 0;
+}
@@ -0,0 +1,318 @@
+/**
+ * @file    oled_flush_test.c
+ * @brief   按修改范围更新的主机测试, 屏幕由 oled_mock.c 模拟
+ *
+ * 在 `Display/OLED_RTOS` 下编译运行, SPI 与 I2C, 打开与关闭影子显存各一次:
+ *
+ *   for i in SPI I2C; do for s in 0 1; do \
+ *       gcc -std=gnu11 -g -O1 -fsanitize=address,undefined -Itest/stub \
+ *           -Itest -I. -DOLED_USE_$i -DOLED_USE_SHADOW_BUF=$s \
+ *           test/oled_flush_test.c test/oled_mock.c oled.c -lm \
+ *           -o oled_flush_test && \
+ *       ASAN_OPTIONS=detect_stack_use_after_return=1 ./oled_flush_test; \
+ *   done; done
+ *
+ * 检查项:
+ *  - 初始化后屏幕内容 (上电时为随机值) 与显存相同
+ *  - 随机绘制点, 线, 矩形, 圆, 字符串, 图像, 清除和取反区域后:
+ *    `oled_update` 后整个屏幕与显存逐像素相同;
+ *    `oled_update_area` 后区域内的像素相同, 之后再 `oled_update` 整个屏幕相同
+ *  - 没有越界写入和时序错误, I2C 的 DMA 在函数返回后读取的数据正确
+ *    (传给 DMA 的缓冲区在栈上时 AddressSanitizer 报错)
+ *  - `oled_get_stats` 与屏幕模型统计的命令, 显存, 总线字节数和传输次数相同
+ *  - 纵坐标为负数的图像只显示屏幕内的部分, 位置正确
+ *
+ * 最后给出仪表界面每帧的总线字节数和传输时间 (SPI 8 MHz, I2C 400 kHz),
+ * 与每帧全屏发送比较.
+ */
+
+#include "oled.h"
+#include "oled_mock.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+#define TEST_ROUNDS 3000
+#define BENCH_FRAMES 1000
+
+#if defined(OLED_USE_I2C)
+#define TEST_INTERFACE   "I2C"
+/* 每字节的传输时间 (ns), 400 kHz, 含应答 */
+#define TEST_BYTE_NS     22500U
+/* 每次传输多出的器件地址和控制字节 */
+#define TEST_TRANSFER_OVERHEAD 2U
+#else /* OLED_INTERFACE */
+#define TEST_INTERFACE   "SPI"
+/* 8 MHz */
+#define TEST_BYTE_NS     1000U
+#define TEST_TRANSFER_OVERHEAD 0U
+#endif /* OLED_INTERFACE */
+
+static uint32_t test_rand_state = 1;
+
+static uint32_t test_rand(void) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return test_rand_state >> 8;
+}
+
+static int16_t test_rand_range(int16_t lo, int16_t hi) {
+    return (int16_t)(lo + (int16_t)(test_rand() % (uint32_t)(hi - lo + 1)));
+}
+
+/**
+ * @brief 屏幕在指定区域内与显存逐像素比较
+ */
+static void test_compare(int16_t x0, int16_t x1, int16_t page0,
+                         int16_t page1) {
+    mock_i2c_complete();
+
+    for (int16_t page = page0; page <= page1; ++page) {
+        for (int16_t x = x0; x <= x1; ++x) {
+            for (int16_t bit = 0; bit < 8; ++bit) {
+                uint8_t panel = (mock_panel[page][x] >> bit) & 0x01;
+                CHECK(oled_get_point(x, page * 8 + bit) == panel);
+            }
+        }
+    }
+    CHECK(mock_stats.errors == 0);
+}
+
+static void test_compare_all(void) {
+    test_compare(0, OLED_MAX_COLUMN - 1, 0, OLED_MAX_PAGE - 1);
+}
+
+static void test_check_stats(void) {
+    oled_stats_t stats;
+
+    mock_i2c_complete();
+    oled_get_stats(&stats);
+    CHECK(stats.cmd_bytes == mock_stats.cmd_bytes);
+    CHECK(stats.data_bytes == mock_stats.data_bytes);
+    CHECK(stats.wire_bytes == mock_stats.wire_bytes);
+    CHECK(stats.transfers == mock_stats.transfers);
+}
+
+/**
+ * @brief 随机绘制一个图形
+ */
+static void test_draw_random(void) {
+    char str[16];
+    int16_t x = test_rand_range(-20, OLED_MAX_COLUMN + 20);
+    int16_t y = test_rand_range(-20, OLED_MAX_LINE + 20);
+    int16_t x1 = test_rand_range(-20, OLED_MAX_COLUMN + 20);
+    int16_t y1 = test_rand_range(-20, OLED_MAX_LINE + 20);
+    uint8_t w = (uint8_t)test_rand_range(1, 60);
+    uint8_t h = (uint8_t)test_rand_range(1, 40);
+
+    switch (test_rand() % 20) {
+        case 0:
+        case 1:
+        case 2:
+            oled_draw_point(x, y);
+            break;
+
+        case 3:
+        case 4:
+            oled_draw_line(x, y, x1, y1);
+            break;
+
+        case 5:
+        case 6:
+            oled_draw_rectangle(x, y, w, h, test_rand() % 2);
+            break;
+
+        case 7:
+            oled_draw_circle(x, y, (uint8_t)test_rand_range(0, 30),
+                             test_rand() % 2);
+            break;
+
+        case 8:
+        case 9:
+        case 10:
+            snprintf(str, sizeof(str), "v=%d", (int)(test_rand() % 10000));
+            oled_show_string(x, y, str,
+                             (test_rand() % 2) ? OLED_6X8 : OLED_8X16);
+            break;
+
+        case 11:
+        case 12:
+        case 13:
+            oled_clear_area(x, y, w, h);
+            break;
+
+        case 14:
+        case 15:
+            oled_reserve_area(x, y, w, h);
+            break;
+
+        case 16:
+        case 17:
+            oled_show_image(x, y, 16, 16, gc_image);
+            break;
+
+        case 18:
+            oled_reserve();
+            break;
+
+        default:
+            oled_clear();
+            break;
+    }
+}
+
+static void test_random(void) {
+    uint32_t full = 0, area = 0;
+
+    mock_panel_reset(0x5A);
+    oled_init();
+    test_compare_all();
+
+    for (uint32_t round = 0; round < TEST_ROUNDS; ++round) {
+        for (uint32_t n = 1 + test_rand() % 4; n > 0; --n) {
+            test_draw_random();
+        }
+
+        if (test_rand() % 5 < 3) {
+            oled_update();
+            test_compare_all();
+            full++;
+        } else {
+            int16_t x = test_rand_range(-10, OLED_MAX_COLUMN - 1);
+            int16_t y = test_rand_range(0, OLED_MAX_LINE - 1);
+            uint8_t w = (uint8_t)test_rand_range(1, OLED_MAX_COLUMN);
+            uint8_t h = (uint8_t)test_rand_range(1, OLED_MAX_LINE);
+            int16_t x0 = (x < 0) ? 0 : x;
+            int16_t x1 = x + w - 1;
+            int16_t page1 = (y + h - 1) / 8;
+
+            x1 = (x1 >= OLED_MAX_COLUMN) ? OLED_MAX_COLUMN - 1 : x1;
+            page1 = (page1 >= OLED_MAX_PAGE) ? OLED_MAX_PAGE - 1 : page1;
+
+            oled_update_area(x, y, w, h);
+            if (x0 <= x1) {
+                test_compare(x0, x1, y / 8, page1);
+            }
+            area++;
+
+            if (test_rand() % 2) {
+                oled_update();
+                test_compare_all();
+            }
+        }
+        test_check_stats();
+    }
+
+    printf("random: %u updates, %u area updates, panel matches buffer\n",
+           full, area);
+}
+
+/**
+ * @brief 纵坐标为负数时图像向上移出屏幕
+ */
+static void test_image_negative_y(void) {
+    for (int16_t y = -15; y <= 0; ++y) {
+        oled_clear();
+        oled_show_image(10, y, 16, 16, gc_image);
+
+        for (int16_t row = 0; row < OLED_MAX_LINE; ++row) {
+            for (int16_t i = 0; i < 16; ++i) {
+                int16_t src = row - y;
+                uint8_t expect = 0;
+
+                if (src < 16) {
+                    expect = (gc_image[(src / 8) * 16 + i] >> (src % 8)) & 0x01;
+                }
+                CHECK(oled_get_point(10 + i, row) == expect);
+            }
+        }
+        oled_update();
+        test_compare_all();
+    }
+
+    printf("image: negative y clipped at the top\n");
+}
+
+/*****************************************************************************
+ * 仪表界面
+ */
+
+/**
+ * @brief 绘制一帧
+ *
+ * @param frame 帧序号, 每帧只有速度变化, 每 10 帧温度变化
+ * @param redraw 是否清屏后重画全部内容
+ */
+static void test_draw_hud(uint32_t frame, bool redraw) {
+    if (redraw) {
+        oled_clear();
+        oled_show_string(0, 0, "SPEED", OLED_8X16);
+        oled_show_string(0, 16, "TEMP", OLED_8X16);
+        oled_show_string(0, 32, "MODE  AUTO", OLED_8X16);
+        oled_draw_rectangle(0, 50, 128, 14, OLED_UNFILLED);
+    } else {
+        oled_clear_area(64, 0, 40, 32);
+    }
+
+    oled_printf(64, 0, OLED_8X16, "%4u", (unsigned)(frame * 7 % 3000));
+    oled_printf(64, 16, OLED_8X16, "%3u", (unsigned)(40 + frame / 10 % 20));
+}
+
+static void test_bench(void) {
+    static const char *const names[] = {"redraw all", "redraw fields"};
+    /* 每页设置 3 个命令, 再发送 128 字节 */
+    uint32_t full_bytes =
+        OLED_MAX_PAGE * (3 * (1 + TEST_TRANSFER_OVERHEAD) + OLED_MAX_COLUMN +
+                         TEST_TRANSFER_OVERHEAD);
+
+    printf("bench %s, shadow %d: full frame %u bytes, %.2f ms\n",
+           TEST_INTERFACE, OLED_USE_SHADOW_BUF, full_bytes,
+           full_bytes * TEST_BYTE_NS / 1e6);
+
+    for (uint32_t mode = 0; mode < 2; ++mode) {
+        oled_stats_t stats;
+
+        mock_panel_reset(0x00);
+        oled_init();
+        test_draw_hud(0, true);
+        oled_update();
+        mock_i2c_complete();
+        oled_reset_stats();
+        mock_stats.wire_bytes = 0;
+
+        for (uint32_t frame = 1; frame <= BENCH_FRAMES; ++frame) {
+            test_draw_hud(frame, mode == 0);
+            oled_update();
+        }
+        test_compare_all();
+        oled_get_stats(&stats);
+
+        printf("bench %s, shadow %d, %-13s: %5.1f bytes/frame, "
+               "%4.1f transfers/frame, %.3f ms/frame\n",
+               TEST_INTERFACE, OLED_USE_SHADOW_BUF, names[mode],
+               (double)stats.wire_bytes / BENCH_FRAMES,
+               (double)stats.transfers / BENCH_FRAMES,
+               (double)stats.wire_bytes * TEST_BYTE_NS / BENCH_FRAMES / 1e6);
+    }
+}
+
+int main(void) {
+    printf("interface: %s, shadow buffer: %d\n", TEST_INTERFACE,
+           OLED_USE_SHADOW_BUF);
+
+    test_random();
+    test_image_negative_y();
+    test_bench();
+
+    printf("all passed\n");
+    return 0;
+}
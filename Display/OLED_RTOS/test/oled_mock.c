@@ -0,0 +1,235 @@
+/**
+ * @file    oled_mock.c
+ * @brief   主机测试用的 SSD1306 屏幕模型
+ */
+
+#include "oled_mock.h"
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+uint8_t mock_panel[OLED_MAX_PAGE][OLED_MAX_COLUMN];
+mock_stats_t mock_stats;
+
+GPIO_TypeDef stub_gpiob;
+uint32_t stub_i2c1;
+SPI_HandleTypeDef spi1_handle;
+I2C_HandleTypeDef i2c1_handle = {.Instance = I2C1};
+
+/* 当前页与列 */
+static uint8_t mock_page;
+static uint8_t mock_column;
+/* 还需跳过的命令参数 */
+static uint8_t mock_param;
+
+static GPIO_PinState mock_cs = GPIO_PIN_SET;
+static GPIO_PinState mock_dc = GPIO_PIN_SET;
+
+/* 进行中的 I2C DMA 传输 */
+static bool mock_i2c_pending;
+static uint16_t mock_i2c_control;
+static uint8_t *mock_i2c_data;
+static uint16_t mock_i2c_size;
+
+/**
+ * @brief 清空统计, 屏幕显存填充为 fill
+ */
+void mock_panel_reset(uint8_t fill) {
+    memset(mock_panel, fill, sizeof(mock_panel));
+    memset(&mock_stats, 0, sizeof(mock_stats));
+    mock_page = 0;
+    mock_column = 0;
+    mock_param = 0;
+}
+
+static void mock_command(uint8_t cmd) {
+    mock_stats.cmd_bytes++;
+
+    if (mock_param > 0) {
+        mock_param--;
+        return;
+    }
+
+    if (cmd >= 0xB0 && cmd <= 0xB7) {
+        mock_page = cmd & 0x07;
+    } else if (cmd <= 0x0F) {
+        mock_column = (uint8_t)((mock_column & 0xF0) | cmd);
+    } else if (cmd <= 0x1F) {
+        mock_column = (uint8_t)((mock_column & 0x0F) | ((cmd & 0x0F) << 4));
+    } else {
+        switch (cmd) {
+            case 0x81:
+            case 0x8D:
+            case 0xA8:
+            case 0xD3:
+            case 0xD5:
+            case 0xD9:
+            case 0xDA:
+            case 0xDB:
+                mock_param = 1;
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+static void mock_data(uint8_t data) {
+    mock_stats.data_bytes++;
+
+    if (mock_page >= OLED_MAX_PAGE || mock_column >= OLED_MAX_COLUMN) {
+        mock_stats.errors++;
+        return;
+    }
+    mock_panel[mock_page][mock_column++] = data;
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init) {
+    (void)GPIOx;
+    (void)GPIO_Init;
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin,
+                       GPIO_PinState PinState) {
+    if (GPIOx != GPIOB) {
+        return;
+    }
+
+    if (GPIO_Pin == GPIO_PIN_12) {
+        mock_cs = PinState;
+    } else if (GPIO_Pin == GPIO_PIN_13) {
+        mock_dc = PinState;
+    }
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData,
+                                   uint16_t Size, uint32_t Timeout) {
+    (void)Timeout;
+
+    if (hspi != &spi1_handle || mock_cs != GPIO_PIN_RESET) {
+        mock_stats.errors++;
+        return HAL_ERROR;
+    }
+
+    mock_stats.transfers++;
+    mock_stats.wire_bytes += Size;
+    for (uint16_t i = 0; i < Size; ++i) {
+        if (mock_dc == GPIO_PIN_RESET) {
+            mock_command(pData[i]);
+        } else {
+            mock_data(pData[i]);
+        }
+    }
+
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c,
+                                        uint16_t DevAddress,
+                                        uint16_t MemAddress,
+                                        uint16_t MemAddSize, uint8_t *pData,
+                                        uint16_t Size) {
+    if (hi2c != &i2c1_handle || DevAddress != OLED_ADDRESS ||
+        MemAddSize != I2C_MEMADD_SIZE_8BIT || mock_i2c_pending) {
+        mock_stats.errors++;
+        return HAL_BUSY;
+    }
+
+    mock_i2c_pending = true;
+    mock_i2c_control = MemAddress;
+    mock_i2c_data = pData;
+    mock_i2c_size = Size;
+    return HAL_OK;
+}
+
+/**
+ * @brief 完成进行中的 I2C 传输, 读取数据并调用发送完成回调
+ */
+void mock_i2c_complete(void) {
+    if (!mock_i2c_pending) {
+        return;
+    }
+
+    mock_i2c_pending = false;
+    mock_stats.transfers++;
+    /* 器件地址和控制字节 */
+    mock_stats.wire_bytes += mock_i2c_size + 2U;
+    for (uint16_t i = 0; i < mock_i2c_size; ++i) {
+        if (mock_i2c_control == 0x00) {
+            mock_command(mock_i2c_data[i]);
+        } else if (mock_i2c_control == 0x40) {
+            mock_data(mock_i2c_data[i]);
+        } else {
+            mock_stats.errors++;
+        }
+    }
+
+    HAL_I2C_MemTxCpltCallback(&i2c1_handle);
+}
+
+/*****************************************************************************
+ * 信号量
+ */
+
+struct stub_semaphore {
+    uint32_t count;
+};
+
+static struct stub_semaphore mock_semaphores[4];
+static uint32_t mock_semaphore_num;
+
+static SemaphoreHandle_t mock_semaphore_create(uint32_t count) {
+    SemaphoreHandle_t semaphore;
+
+    if (mock_semaphore_num >=
+        sizeof(mock_semaphores) / sizeof(mock_semaphores[0])) {
+        mock_semaphore_num = 0;
+    }
+    semaphore = &mock_semaphores[mock_semaphore_num++];
+    semaphore->count = count;
+    return semaphore;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void) {
+    return mock_semaphore_create(0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void) {
+    return mock_semaphore_create(1);
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks) {
+    (void)ticks;
+
+    if (semaphore->count == 0) {
+        /* 等待期间发送完成中断到来 */
+        mock_i2c_complete();
+    }
+    if (semaphore->count == 0) {
+        printf("oled_mock: deadlock on semaphore %p\n", (void *)semaphore);
+        exit(1);
+    }
+
+    semaphore->count--;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+    if (semaphore->count > 0) {
+        return pdFALSE;
+    }
+    semaphore->count = 1;
+    return pdTRUE;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore,
+                                 BaseType_t *higher_priority_task_woken) {
+    (void)higher_priority_task_woken;
+    return xSemaphoreGive(semaphore);
+}
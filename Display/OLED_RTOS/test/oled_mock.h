@@ -0,0 +1,43 @@
+/**
+ * @file    oled_mock.h
+ * @brief   主机测试用的 SSD1306 屏幕模型
+ *
+ *****************************************************************************
+ * 代替板级的 GPIO, SPI 和 I2C, 与 oled.c 一起编译. 按页寻址模式解析命令:
+ *  - 0xB0 ~ 0xB7 设置页, 0x00 ~ 0x0F 与 0x10 ~ 0x1F 设置列的低 4 位和高 4 位;
+ *  - 带一个参数的初始化命令跳过参数;
+ *  - 数据写入当前页的当前列, 列地址加 1, 超出最后一列记入 `errors`.
+ *
+ * SPI: CS 为低时传输, DC 为低是命令, 为高是数据; CS 为高时传输记入 `errors`.
+ * I2C: `HAL_I2C_Mem_Write_DMA` 只记下缓冲区, 到 `mock_i2c_complete` 时才读取
+ * 数据并调用发送完成回调, 与 DMA 在函数返回后读取数据相同. 上一次传输未完成
+ * 时再发起传输记入 `errors`.
+ *
+ * 传输统计的口径与 `oled_stats_t` 相同, I2C 每次传输多计器件地址和控制字节.
+ *****************************************************************************
+ */
+
+#ifndef __OLED_MOCK_H
+#define __OLED_MOCK_H
+
+#include "oled.h"
+
+/**
+ * @brief 总线传输统计
+ */
+typedef struct {
+    uint32_t cmd_bytes;  /*!< 命令字节数 */
+    uint32_t data_bytes; /*!< 显存字节数 */
+    uint32_t wire_bytes; /*!< 总线上的总字节数 */
+    uint32_t transfers;  /*!< 传输次数 */
+    uint32_t errors;     /*!< 时序或地址错误 */
+} mock_stats_t;
+
+/* 屏幕显存 */
+extern uint8_t mock_panel[OLED_MAX_PAGE][OLED_MAX_COLUMN];
+extern mock_stats_t mock_stats;
+
+void mock_panel_reset(uint8_t fill);
+void mock_i2c_complete(void);
+
+#endif /* __OLED_MOCK_H */
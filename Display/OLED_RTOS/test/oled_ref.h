@@ -0,0 +1,55 @@
+/**
+ * @file    oled_ref.h
+ * @brief   把 oled_ref.c 的全局符号改名为 ref_ 开头, 与 oled.c 一起链接
+ */
+
+#ifndef __OLED_REF_H
+#define __OLED_REF_H
+
+#define HAL_I2C_MemTxCpltCallback ref_HAL_I2C_MemTxCpltCallback
+#define OLED_F8x16                ref_OLED_F8x16
+#define OLED_F6x8                 ref_OLED_F6x8
+#define OLED_CF16x16              ref_OLED_CF16x16
+#define gc_image                  ref_gc_image
+
+#define oled_init                 ref_oled_init
+#define oled_on                   ref_oled_on
+#define oled_off                  ref_oled_off
+#define oled_set_cursor           ref_oled_set_cursor
+#define oled_pnpoly               ref_oled_pnpoly
+#define oled_is_in_angle          ref_oled_is_in_angle
+#define oled_update               ref_oled_update
+#define oled_update_area          ref_oled_update_area
+#define oled_get_stats            ref_oled_get_stats
+#define oled_reset_stats          ref_oled_reset_stats
+#define oled_clear                ref_oled_clear
+#define oled_clear_area           ref_oled_clear_area
+#define oled_reserve              ref_oled_reserve
+#define oled_reserve_area         ref_oled_reserve_area
+#define oled_show_char            ref_oled_show_char
+#define oled_show_string          ref_oled_show_string
+#define oled_show_number          ref_oled_show_number
+#define oled_show_signed_number   ref_oled_show_signed_number
+#define oled_show_hex             ref_oled_show_hex
+#define oled_show_bin             ref_oled_show_bin
+#define oled_show_float           ref_oled_show_float
+#define oled_show_image           ref_oled_show_image
+#define oled_printf               ref_oled_printf
+#define oled_draw_point           ref_oled_draw_point
+#define oled_get_point            ref_oled_get_point
+#define oled_draw_hline           ref_oled_draw_hline
+#define oled_draw_vline           ref_oled_draw_vline
+#define oled_draw_line            ref_oled_draw_line
+#define oled_draw_rectangle       ref_oled_draw_rectangle
+#define oled_draw_tritangle       ref_oled_draw_tritangle
+#define oled_draw_polygon         ref_oled_draw_polygon
+#define oled_draw_circle          ref_oled_draw_circle
+#define oled_draw_ellipse         ref_oled_draw_ellipse
+#define oled_draw_arc             ref_oled_draw_arc
+
+#include "oled.h"
+
+uint8_t oled_pnpoly(uint8_t nvert, int16_t *vertx, int16_t *verty,
+                    int16_t testx, int16_t testy);
+
+#endif /* __OLED_REF_H */
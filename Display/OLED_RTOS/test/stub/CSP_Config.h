@@ -0,0 +1,91 @@
+/**
+ * @file    CSP_Config.h
+ * @brief   主机测试用的板级支持替身, 只包含 oled.c 用到的部分.
+ *          GPIO, SPI 和 I2C 由 `test/oled_mock.c` 中的屏幕模型实现.
+ */
+
+#ifndef __CSP_CONFIG_H
+#define __CSP_CONFIG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+/*****************************************************************************
+ * GPIO
+ */
+
+typedef struct {
+    uint32_t id;
+} GPIO_TypeDef;
+
+typedef struct {
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Pull;
+    uint32_t Speed;
+} GPIO_InitTypeDef;
+
+typedef enum {
+    GPIO_PIN_RESET = 0,
+    GPIO_PIN_SET
+} GPIO_PinState;
+
+extern GPIO_TypeDef stub_gpiob;
+#define GPIOB                 (&stub_gpiob)
+
+#define GPIO_PIN_12           ((uint16_t)0x1000)
+#define GPIO_PIN_13           ((uint16_t)0x2000)
+#define GPIO_PIN_14           ((uint16_t)0x4000)
+
+#define GPIO_MODE_OUTPUT_PP   0x00000001U
+#define GPIO_PULLUP           0x00000001U
+#define GPIO_SPEED_FREQ_HIGH  0x00000002U
+
+#define __HAL_RCC_GPIOA_CLK_ENABLE()                                           \
+    do {                                                                       \
+    } while (0)
+#define __HAL_RCC_GPIOB_CLK_ENABLE()                                           \
+    do {                                                                       \
+    } while (0)
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin,
+                       GPIO_PinState PinState);
+
+/*****************************************************************************
+ * SPI 与 I2C
+ */
+
+typedef struct {
+    void *Instance;
+} SPI_HandleTypeDef;
+
+typedef struct {
+    void *Instance;
+} I2C_HandleTypeDef;
+
+extern uint32_t stub_i2c1;
+#define I2C1                  ((void *)&stub_i2c1)
+
+#define I2C_MEMADD_SIZE_8BIT  0x00000001U
+
+extern SPI_HandleTypeDef spi1_handle;
+extern I2C_HandleTypeDef i2c1_handle;
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData,
+                                   uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c,
+                                        uint16_t DevAddress,
+                                        uint16_t MemAddress,
+                                        uint16_t MemAddSize, uint8_t *pData,
+                                        uint16_t Size);
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c);
+
+#endif /* __CSP_CONFIG_H */
@@ -0,0 +1,18 @@
+/**
+ * @file    FreeRTOS.h
+ * @brief   主机测试用的 FreeRTOS 替身, 只包含 oled.c 用到的部分
+ */
+
+#ifndef INC_FREERTOS_H
+#define INC_FREERTOS_H
+
+#include <stdint.h>
+
+typedef long BaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE       ((BaseType_t)0)
+#define pdTRUE        ((BaseType_t)1)
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+
+#endif /* INC_FREERTOS_H */
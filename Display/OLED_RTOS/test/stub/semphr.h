@@ -0,0 +1,22 @@
+/**
+ * @file    semphr.h
+ * @brief   主机测试用的信号量替身, 由 `test/oled_mock.c` 实现.
+ *          没有其他任务, 信号量为 0 时获取会先完成进行中的 DMA 传输
+ *          (模拟发送完成中断), 仍为 0 则视为死锁.
+ */
+
+#ifndef SEMAPHORE_H
+#define SEMAPHORE_H
+
+#include "FreeRTOS.h"
+
+typedef struct stub_semaphore *SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticks);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t semaphore,
+                                 BaseType_t *higher_priority_task_woken);
+
+#endif /* SEMAPHORE_H */
@@ -14,8 +14,76 @@
 #include "../core/core_delay.h"
 #include "stm32g4xx_ll_gpio.h"
 
+#include <string.h>
+
 lcd_dev_t lcd_dev;
 
+/* 字节交换后的 RGB565 颜色, 按 uint16_t 存放时内存中为高字节在前 */
+#define ST77xx_SWAP(c) ((uint16_t)(((c) >> 8) | ((c) << 8)))
+
+/* 绘制命令类型 */
+typedef enum {
+    ST77xx_CMD_RECT,
+    ST77xx_CMD_LINE,
+    ST77xx_CMD_STRING,
+    ST77xx_CMD_IMAGE,
+} st77xx_cmd_type_t;
+
+/* 绘制命令, 坐标均为屏幕坐标 */
+typedef struct {
+    st77xx_cmd_type_t type;
+    uint16_t x0, y0; /* 矩形左上角 / 直线起点 / 字符串起点 */
+    uint16_t x1, y1; /* 矩形及图片宽高 / 直线终点 */
+    uint16_t color;
+    uint16_t bgColor;
+    const char *str;
+    const FontDef *font;
+    const uint8_t *image;
+} st77xx_cmd_t;
+
+/* 渲染区域, 整个区域只设置一次窗口 */
+typedef struct {
+    uint16_t x, y, width, height;
+    uint16_t bgColor;
+    const st77xx_cmd_t *cmds;
+    uint8_t count;
+} st77xx_region_t;
+
+/* 两个行缓冲区, 一个通过 DMA 发送时填充另一个 */
+static uint16_t st77xx_render_buf[2][ST77xx_RENDER_BUF_PIXELS];
+
+/* ST77xx_RenderBegin 与 ST77xx_RenderEnd 之间记录的命令 */
+static st77xx_cmd_t st77xx_render_cmds[ST77xx_RENDER_MAX_CMDS];
+static st77xx_region_t st77xx_render_region;
+
+#if ST77xx_USE_FRAMEBUFFER
+#define ST77xx_FB_TILES_X (ST77xx_FB_WIDTH / ST77xx_FB_TILE)
+#define ST77xx_FB_TILES_Y (ST77xx_FB_HEIGHT / ST77xx_FB_TILE)
+
+/* 帧缓冲区, 行优先, 颜色已交换字节 */
+static uint16_t st77xx_fb[ST77xx_FB_HEIGHT][ST77xx_FB_WIDTH];
+/* 改动过的块, 每一行块一个字, 第 n 位对应第 n 列块 */
+static uint32_t st77xx_fb_dirty[ST77xx_FB_TILES_Y];
+/* 每一行块中改动过的像素行 [y0, y1], 相对块的上边界 */
+static uint8_t st77xx_fb_dirty_y0[ST77xx_FB_TILES_Y];
+static uint8_t st77xx_fb_dirty_y1[ST77xx_FB_TILES_Y];
+/* 帧缓冲区覆盖的区域 */
+static const st77xx_region_t st77xx_fb_region = {
+    ST77xx_FB_X, ST77xx_FB_Y, ST77xx_FB_WIDTH, ST77xx_FB_HEIGHT, 0, NULL, 0};
+#endif /* ST77xx_USE_FRAMEBUFFER */
+
+/**
+ * @brief 等待上一次像素数据发送完成
+ * 
+ */
+void ST77xx_WaitIdle(void) {
+#if ST77xx_USE_DMA
+    /* 只等待 DMA 发送, 阻塞发送返回时已经完成 */
+    while (HAL_SPI_GetState(&ST77xx_SPI_INSTANCE) == HAL_SPI_STATE_BUSY_TX) {
+    }
+#endif /* ST77xx_USE_DMA */
+}
+
 void ST77xx_Reset(void) {
 
     LL_GPIO_ResetOutputPin(ST77xx_RST_GPIO_Port, ST77xx_RST_Pin);
@@ -25,21 +93,55 @@ void ST77xx_Reset(void) {
 }
 
 void ST77xx_WriteCommand(uint8_t cmd) {
+    ST77xx_WaitIdle();
     LL_GPIO_ResetOutputPin(ST77xx_DC_GPIO_Port, ST77xx_DC_Pin);
     HAL_SPI_Transmit(&ST77xx_SPI_INSTANCE, &cmd, 1, HAL_MAX_DELAY);
 }
 
 void ST77xx_WriteByte(uint8_t data) {
+    ST77xx_WaitIdle();
     LL_GPIO_SetOutputPin(ST77xx_DC_GPIO_Port, ST77xx_DC_Pin);
     HAL_SPI_Transmit(&ST77xx_SPI_INSTANCE, &data, 1, HAL_MAX_DELAY);
 }
 
 void ST77xx_WriteData(uint8_t *data, size_t data_size) {
-
+    ST77xx_WaitIdle();
     LL_GPIO_SetOutputPin(ST77xx_DC_GPIO_Port, ST77xx_DC_Pin);
     HAL_SPI_Transmit(&ST77xx_SPI_INSTANCE, data, data_size, HAL_MAX_DELAY);
 }
 
+/**
+ * @brief 发送像素数据, 使用 DMA 时启动传输后立即返回
+ * 
+ * @param data 像素数据, 发送完成前不能修改
+ * @param data_size 字节数, 超过一次传输的上限时分段发送
+ * @note SPI 没有配置 TX DMA 或 DMA 启动失败时改为阻塞发送
+ */
+static void ST77xx_WritePixels(const uint8_t *data, uint32_t data_size) {
+    uint16_t chunk;
+
+    while (data_size > 0) {
+        chunk = data_size > 0xFFFE ? 0xFFFE : (uint16_t)data_size;
+
+        ST77xx_WaitIdle();
+        LL_GPIO_SetOutputPin(ST77xx_DC_GPIO_Port, ST77xx_DC_Pin);
+#if ST77xx_USE_DMA
+        if (ST77xx_SPI_INSTANCE.hdmatx == NULL ||
+            HAL_SPI_Transmit_DMA(&ST77xx_SPI_INSTANCE, (uint8_t *)data,
+                                 chunk) != HAL_OK) {
+            HAL_SPI_Transmit(&ST77xx_SPI_INSTANCE, (uint8_t *)data, chunk,
+                             HAL_MAX_DELAY);
+        }
+#else
+        HAL_SPI_Transmit(&ST77xx_SPI_INSTANCE, (uint8_t *)data, chunk,
+                         HAL_MAX_DELAY);
+#endif /* ST77xx_USE_DMA */
+
+        data += chunk;
+        data_size -= chunk;
+    }
+}
+
 /* 设置ST7735显示方向 */
 void ST77xx_SetRotation(uint8_t rotation) {
     uint8_t madctl = 0;
@@ -254,6 +356,7 @@ void ST77xx_Init(uint8_t dir, ic_type_t st77xx) {
         delay_ms(10);
         ST77xx_FillScreen(ST77xx_WHITE);
     }
+    ST77xx_Flush();
 }
 
 /**
@@ -284,6 +387,663 @@ void ST77xx_SetAddressWindow(uint16_t x0, uint16_t y0, uint16_t x1,
     ST77xx_WriteData(data, sizeof(data));
 }
 
+/**
+ * @brief 在行缓冲区中画点
+ * 
+ * @param buf 行缓冲区, 对应区域中 [y0, y0 + lines) 行
+ * @param region 渲染区域
+ * @param y0 缓冲区第一行的屏幕纵坐标
+ * @param lines 缓冲区行数
+ * @param x 屏幕横坐标
+ * @param y 屏幕纵坐标
+ * @param color 交换字节后的颜色
+ */
+static inline void ST77xx_BufPoint(uint16_t *buf, const st77xx_region_t *region,
+                                   uint16_t y0, uint16_t lines, int x, int y,
+                                   uint16_t color) {
+    if (x >= region->x && x < region->x + region->width && y >= y0 &&
+        y < y0 + lines) {
+        buf[(y - y0) * region->width + (x - region->x)] = color;
+    }
+}
+
+/**
+ * @brief 把直线光栅化到行缓冲区, 与 ST77xx_DrawLine 画出的点相同
+ * 
+ */
+static void ST77xx_RasterLine(uint16_t *buf, const st77xx_region_t *region,
+                              uint16_t y0, uint16_t lines,
+                              const st77xx_cmd_t *cmd) {
+    uint16_t color = ST77xx_SWAP(cmd->color);
+    int xerr = 0, yerr = 0, delta_x, delta_y, distance;
+    int incx, incy, uRow, uCol, t;
+
+    /* 直线与缓冲区的行没有交集 */
+    if ((cmd->y0 < y0 && cmd->y1 < y0) ||
+        (cmd->y0 >= y0 + lines && cmd->y1 >= y0 + lines)) {
+        return;
+    }
+
+    delta_x = cmd->x1 - cmd->x0;
+    delta_y = cmd->y1 - cmd->y0;
+    uRow = cmd->x0;
+    uCol = cmd->y0;
+    incx = delta_x > 0 ? 1 : (delta_x == 0 ? 0 : -1);
+    incy = delta_y > 0 ? 1 : (delta_y == 0 ? 0 : -1);
+    delta_x = delta_x < 0 ? -delta_x : delta_x;
+    delta_y = delta_y < 0 ? -delta_y : delta_y;
+    distance = delta_x > delta_y ? delta_x : delta_y;
+
+    for (t = 0; t < distance + 1; t++) {
+        ST77xx_BufPoint(buf, region, y0, lines, uRow, uCol, color);
+        xerr += delta_x;
+        yerr += delta_y;
+        if (xerr > distance) {
+            xerr -= distance;
+            uRow += incx;
+        }
+        if (yerr > distance) {
+            yerr -= distance;
+            uCol += incy;
+        }
+    }
+}
+
+/**
+ * @brief 把字符串光栅化到行缓冲区, 换行方式与 ST77xx_DrawString 相同
+ * 
+ */
+static void ST77xx_RasterString(uint16_t *buf, const st77xx_region_t *region,
+                                uint16_t y0, uint16_t lines,
+                                const st77xx_cmd_t *cmd) {
+    const FontDef *font = cmd->font;
+    const char *str = cmd->str;
+    uint16_t color = ST77xx_SWAP(cmd->color);
+    uint16_t bgColor = ST77xx_SWAP(cmd->bgColor);
+    uint32_t mask = font->width > 16 ? 0x80000000 : 0x8000;
+    uint32_t b;
+    int x = cmd->x0, y = cmd->y0;
+    int i, j, i0, i1, j0, j1;
+
+    while (*str) {
+        if (x + font->width > lcd_dev.width) {
+            x = 0;
+            y += font->height;
+        }
+
+        if (y + font->height > lcd_dev.height || y >= y0 + lines) {
+            break;
+        }
+
+        /* 字符与缓冲区及区域的交集 */
+        i0 = y < y0 ? y0 - y : 0;
+        i1 = y + font->height > y0 + lines ? y0 + lines - y : font->height;
+        j0 = x < region->x ? region->x - x : 0;
+        j1 = x + font->width > region->x + region->width
+                 ? region->x + region->width - x
+                 : font->width;
+
+        for (i = i0; i < i1; i++) {
+            b = font->data[(font == &Font_Custom ? (*str - 46) : (*str - 32)) *
+                               font->height +
+                           i];
+            for (j = j0; j < j1; j++) {
+                buf[(y + i - y0) * region->width + (x + j - region->x)] =
+                    ((b << j) & mask) ? color : bgColor;
+            }
+        }
+
+        x += font->width;
+        str++;
+    }
+}
+
+/**
+ * @brief 把一条绘制命令光栅化到区域中的 [y0, y0 + lines) 行
+ * 
+ */
+static void ST77xx_RasterCmd(uint16_t *buf, const st77xx_region_t *region,
+                             uint16_t y0, uint16_t lines,
+                             const st77xx_cmd_t *cmd) {
+    uint16_t color;
+    int x, y, xs, xe, ys, ye;
+
+    /* 矩形及图片与缓冲区的交集 */
+    xs = cmd->x0 > region->x ? cmd->x0 : region->x;
+    xe = cmd->x0 + cmd->x1 < region->x + region->width
+             ? cmd->x0 + cmd->x1
+             : region->x + region->width;
+    ys = cmd->y0 > y0 ? cmd->y0 : y0;
+    ye = cmd->y0 + cmd->y1 < y0 + lines ? cmd->y0 + cmd->y1 : y0 + lines;
+
+    switch (cmd->type) {
+        case ST77xx_CMD_RECT:
+            color = ST77xx_SWAP(cmd->color);
+            for (y = ys; y < ye; y++) {
+                for (x = xs; x < xe; x++) {
+                    buf[(y - y0) * region->width + (x - region->x)] = color;
+                }
+            }
+            break;
+        case ST77xx_CMD_LINE:
+            ST77xx_RasterLine(buf, region, y0, lines, cmd);
+            break;
+        case ST77xx_CMD_STRING:
+            ST77xx_RasterString(buf, region, y0, lines, cmd);
+            break;
+        case ST77xx_CMD_IMAGE:
+            /* 图片数据为高字节在前, 与缓冲区的存放方式相同 */
+            for (y = ys; y < ye && xs < xe; y++) {
+                memcpy(&buf[(y - y0) * region->width + (xs - region->x)],
+                       cmd->image + ((uint32_t)(y - cmd->y0) * cmd->x1 +
+                                     (xs - cmd->x0)) *
+                                        sizeof(uint16_t),
+                       (xe - xs) * sizeof(uint16_t));
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * @brief 把区域中的 [y0, y0 + lines) 行光栅化到行缓冲区
+ * 
+ */
+static void ST77xx_RasterBand(uint16_t *buf, const st77xx_region_t *region,
+                              uint16_t y0, uint16_t lines) {
+    uint32_t i, n = (uint32_t)region->width * lines;
+    uint16_t color = ST77xx_SWAP(region->bgColor);
+    uint8_t k;
+
+    for (i = 0; i < n; i++) {
+        buf[i] = color;
+    }
+
+    /* 按记录顺序绘制, 后面的命令覆盖前面的 */
+    for (k = 0; k < region->count; k++) {
+        ST77xx_RasterCmd(buf, region, y0, lines, &region->cmds[k]);
+    }
+}
+
+/**
+ * @brief 渲染一个区域: 设置一次窗口, 按行缓冲区大小分段光栅化并发送
+ * 
+ * @param region 渲染区域
+ * @note 使用 DMA 时, 一个缓冲区发送的同时光栅化另一个缓冲区
+ */
+static void ST77xx_RenderRegion(const st77xx_region_t *region) {
+    uint16_t lines, n, y;
+    uint8_t k = 0;
+
+    if (region->width == 0 || region->height == 0 ||
+        region->width > ST77xx_RENDER_BUF_PIXELS) {
+        return;
+    }
+
+    lines = ST77xx_RENDER_BUF_PIXELS / region->width;
+
+    ST77xx_SetAddressWindow(region->x, region->y,
+                            region->x + region->width - 1,
+                            region->y + region->height - 1);
+    ST77xx_WriteCommand(ST7735_RAMWR);
+
+    for (y = region->y; y < region->y + region->height; y += n) {
+        n = region->y + region->height - y;
+        if (n > lines) {
+            n = lines;
+        }
+
+        /* 光栅化 k 时, 另一个缓冲区可能还在发送, k 本身已经发送完成 */
+        ST77xx_RasterBand(st77xx_render_buf[k], region, y, n);
+        ST77xx_WritePixels((const uint8_t *)st77xx_render_buf[k],
+                           (uint32_t)region->width * n * sizeof(uint16_t));
+        k ^= 1;
+    }
+}
+
+/**
+ * @brief 用同一颜色填充行缓冲区
+ * 
+ * @param color 颜色
+ * @param count 像素数, 不超过 ST77xx_RENDER_BUF_PIXELS
+ * @return 行缓冲区
+ */
+static uint16_t *ST77xx_FillBuffer(uint16_t color, uint32_t count) {
+    uint16_t *buf = st77xx_render_buf[0];
+    uint32_t i;
+
+    /* 上一次发送可能还在读缓冲区 */
+    ST77xx_WaitIdle();
+    color = ST77xx_SWAP(color);
+    for (i = 0; i < count; i++) {
+        buf[i] = color;
+    }
+
+    return buf;
+}
+
+/**
+ * @brief 开始记录一个渲染区域
+ * 
+ * @param x 区域左上角横坐标
+ * @param y 区域左上角纵坐标
+ * @param width 区域宽度, 不超过 ST77xx_RENDER_BUF_PIXELS
+ * @param height 区域高度
+ * @param bgColor 区域背景颜色
+ * @note 之后调用 ST77xx_RenderXxx 记录绘制命令, 调用 ST77xx_RenderEnd
+ *       时才光栅化并发送, 区域外的部分被裁掉
+ */
+void ST77xx_RenderBegin(uint16_t x, uint16_t y, uint16_t width,
+                        uint16_t height, uint16_t bgColor) {
+    st77xx_render_region.x = x;
+    st77xx_render_region.y = y;
+    st77xx_render_region.width = width;
+    st77xx_render_region.height = height;
+    st77xx_render_region.bgColor = bgColor;
+    st77xx_render_region.cmds = st77xx_render_cmds;
+    st77xx_render_region.count = 0;
+}
+
+/**
+ * @brief 取一条空闲的绘制命令
+ * 
+ * @param type 命令类型
+ * @return 绘制命令, 超过 ST77xx_RENDER_MAX_CMDS 时返回 NULL
+ */
+static st77xx_cmd_t *ST77xx_RenderNext(st77xx_cmd_type_t type) {
+    st77xx_cmd_t *cmd;
+
+    if (st77xx_render_region.count >= ST77xx_RENDER_MAX_CMDS) {
+        return NULL;
+    }
+
+    cmd = &st77xx_render_cmds[st77xx_render_region.count++];
+    cmd->type = type;
+    return cmd;
+}
+
+/**
+ * @brief 在渲染区域中画实心矩形
+ * 
+ */
+void ST77xx_RenderRectangle(uint16_t x, uint16_t y, uint16_t width,
+                            uint16_t height, uint16_t color) {
+    st77xx_cmd_t *cmd = ST77xx_RenderNext(ST77xx_CMD_RECT);
+
+    if (cmd != NULL) {
+        cmd->x0 = x;
+        cmd->y0 = y;
+        cmd->x1 = width;
+        cmd->y1 = height;
+        cmd->color = color;
+    }
+}
+
+/**
+ * @brief 在渲染区域中画线
+ * 
+ */
+void ST77xx_RenderLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
+                       uint16_t color) {
+    st77xx_cmd_t *cmd = ST77xx_RenderNext(ST77xx_CMD_LINE);
+
+    if (cmd != NULL) {
+        cmd->x0 = x0;
+        cmd->y0 = y0;
+        cmd->x1 = x1;
+        cmd->y1 = y1;
+        cmd->color = color;
+    }
+}
+
+/**
+ * @brief 在渲染区域中显示字符串
+ * 
+ * @note 字符串在 ST77xx_RenderEnd 返回前不能修改
+ */
+void ST77xx_RenderString(uint16_t x, uint16_t y, const char *str,
+                         uint16_t color, uint16_t bgColor,
+                         const FontDef *font) {
+    st77xx_cmd_t *cmd = ST77xx_RenderNext(ST77xx_CMD_STRING);
+
+    if (cmd != NULL) {
+        cmd->x0 = x;
+        cmd->y0 = y;
+        cmd->str = str;
+        cmd->color = color;
+        cmd->bgColor = bgColor;
+        cmd->font = font;
+    }
+}
+
+#if ST77xx_USE_FRAMEBUFFER
+static uint8_t ST77xx_FBRender(const st77xx_region_t *region);
+#endif /* ST77xx_USE_FRAMEBUFFER */
+
+/**
+ * @brief 光栅化并发送渲染区域
+ * 
+ * @note 使用 DMA 时最后一段数据发送完成前就会返回,
+ *       下一次访问屏幕时会自动等待.
+ *       使用帧缓冲区时, 完全在帧缓冲区内的区域只画到帧缓冲区,
+ *       调用 ST77xx_Flush 时发送
+ */
+void ST77xx_RenderEnd(void) {
+#if ST77xx_USE_FRAMEBUFFER
+    if (ST77xx_FBRender(&st77xx_render_region)) {
+        st77xx_render_region.count = 0;
+        return;
+    }
+#endif /* ST77xx_USE_FRAMEBUFFER */
+
+    ST77xx_RenderRegion(&st77xx_render_region);
+    st77xx_render_region.count = 0;
+}
+
+#if ST77xx_USE_FRAMEBUFFER
+
+/**
+ * @brief 计算绘制命令覆盖的范围
+ * 
+ * @param cmd 绘制命令
+ * @param[out] x0 左边界
+ * @param[out] y0 上边界
+ * @param[out] x1 右边界 (包含)
+ * @param[out] y1 下边界 (包含)
+ * @return 是否有需要绘制的点
+ */
+static uint8_t ST77xx_CmdBounds(const st77xx_cmd_t *cmd, int *x0, int *y0,
+                                int *x1, int *y1) {
+    const FontDef *font = cmd->font;
+    const char *str = cmd->str;
+    int x, y;
+
+    switch (cmd->type) {
+        case ST77xx_CMD_LINE:
+            *x0 = cmd->x0 < cmd->x1 ? cmd->x0 : cmd->x1;
+            *x1 = cmd->x0 < cmd->x1 ? cmd->x1 : cmd->x0;
+            *y0 = cmd->y0 < cmd->y1 ? cmd->y0 : cmd->y1;
+            *y1 = cmd->y0 < cmd->y1 ? cmd->y1 : cmd->y0;
+            return 1;
+        case ST77xx_CMD_STRING:
+            /* 换行方式与 ST77xx_RasterString 相同 */
+            x = cmd->x0;
+            y = cmd->y0;
+            *x0 = *y0 = 0xFFFF;
+            *x1 = *y1 = -1;
+            while (*str) {
+                if (x + font->width > lcd_dev.width) {
+                    x = 0;
+                    y += font->height;
+                }
+                if (y + font->height > lcd_dev.height) {
+                    break;
+                }
+                *x0 = x < *x0 ? x : *x0;
+                *y0 = y < *y0 ? y : *y0;
+                *x1 = x + font->width - 1 > *x1 ? x + font->width - 1 : *x1;
+                *y1 = y + font->height - 1;
+                x += font->width;
+                str++;
+            }
+            return *x1 >= 0;
+        default:
+            *x0 = cmd->x0;
+            *y0 = cmd->y0;
+            *x1 = cmd->x0 + cmd->x1 - 1;
+            *y1 = cmd->y0 + cmd->y1 - 1;
+            return cmd->x1 > 0 && cmd->y1 > 0;
+    }
+}
+
+/**
+ * @brief 标记帧缓冲区中改动的块
+ * 
+ * @param x0 左边界, 相对帧缓冲区
+ * @param y0 上边界, 相对帧缓冲区
+ * @param x1 右边界 (包含)
+ * @param y1 下边界 (包含)
+ */
+static void ST77xx_FBMarkDirty(int x0, int y0, int x1, int y1) {
+    uint32_t mask;
+    uint8_t lo, hi;
+    int ty;
+
+    mask = (0xFFFFFFFFU >> (31 - x1 / ST77xx_FB_TILE)) &
+           (0xFFFFFFFFU << (x0 / ST77xx_FB_TILE));
+    for (ty = y0 / ST77xx_FB_TILE; ty <= y1 / ST77xx_FB_TILE; ty++) {
+        lo = ty == y0 / ST77xx_FB_TILE ? y0 % ST77xx_FB_TILE : 0;
+        hi = ty == y1 / ST77xx_FB_TILE ? y1 % ST77xx_FB_TILE
+                                       : ST77xx_FB_TILE - 1;
+        if (st77xx_fb_dirty[ty] == 0) {
+            st77xx_fb_dirty_y0[ty] = lo;
+            st77xx_fb_dirty_y1[ty] = hi;
+        } else {
+            st77xx_fb_dirty_y0[ty] = lo < st77xx_fb_dirty_y0[ty]
+                                         ? lo
+                                         : st77xx_fb_dirty_y0[ty];
+            st77xx_fb_dirty_y1[ty] = hi > st77xx_fb_dirty_y1[ty]
+                                         ? hi
+                                         : st77xx_fb_dirty_y1[ty];
+        }
+        st77xx_fb_dirty[ty] |= mask;
+    }
+}
+
+/**
+ * @brief 把绘制命令画到帧缓冲区, 并标记改动的块
+ * 
+ * @param cmd 绘制命令
+ * @return 命令是否完全在帧缓冲区内, 为 0 时调用者还要直接画到屏幕上,
+ *         重叠部分与 ST77xx_FBRender 相同, 只更新帧缓冲区不标记改动
+ */
+static uint8_t ST77xx_FBDraw(const st77xx_cmd_t *cmd) {
+    int x0, y0, x1, y1;
+    uint8_t inside;
+
+    if (!ST77xx_CmdBounds(cmd, &x0, &y0, &x1, &y1)) {
+        return 1;
+    }
+
+    inside = x0 >= ST77xx_FB_X && y0 >= ST77xx_FB_Y &&
+             x1 < ST77xx_FB_X + ST77xx_FB_WIDTH &&
+             y1 < ST77xx_FB_Y + ST77xx_FB_HEIGHT;
+
+    /* 转换为帧缓冲区中的坐标并裁剪 */
+    x0 = x0 > ST77xx_FB_X ? x0 - ST77xx_FB_X : 0;
+    y0 = y0 > ST77xx_FB_Y ? y0 - ST77xx_FB_Y : 0;
+    x1 = x1 - ST77xx_FB_X < ST77xx_FB_WIDTH - 1 ? x1 - ST77xx_FB_X
+                                                 : ST77xx_FB_WIDTH - 1;
+    y1 = y1 - ST77xx_FB_Y < ST77xx_FB_HEIGHT - 1 ? y1 - ST77xx_FB_Y
+                                                  : ST77xx_FB_HEIGHT - 1;
+    if (x0 > x1 || y0 > y1) {
+        return inside;
+    }
+
+    /* 帧缓冲区可能正在通过 DMA 发送 */
+    ST77xx_WaitIdle();
+    ST77xx_RasterCmd(&st77xx_fb[0][0], &st77xx_fb_region, ST77xx_FB_Y,
+                     ST77xx_FB_HEIGHT, cmd);
+    if (inside) {
+        ST77xx_FBMarkDirty(x0, y0, x1, y1);
+    }
+
+    return inside;
+}
+
+/**
+ * @brief 把渲染区域与帧缓冲区重叠的部分画到帧缓冲区
+ * 
+ * @param region 渲染区域
+ * @return 区域是否完全在帧缓冲区内
+ * @retval - 1: 已画到帧缓冲区并标记改动的块, 由 ST77xx_Flush 发送
+ * @retval - 0: 调用者还要把整个区域直接发送到屏幕, 重叠部分不标记改动,
+ *              之后发送这些块时内容与屏幕相同
+ */
+static uint8_t ST77xx_FBRender(const st77xx_region_t *region) {
+    int x0, y0, x1, y1;
+    uint16_t lines, n, y, i;
+    uint8_t inside;
+
+    if (region->width == 0 || region->height == 0 ||
+        region->width > ST77xx_RENDER_BUF_PIXELS) {
+        return 1;
+    }
+
+    /* 重叠部分, 屏幕坐标 */
+    x0 = region->x > ST77xx_FB_X ? region->x : ST77xx_FB_X;
+    y0 = region->y > ST77xx_FB_Y ? region->y : ST77xx_FB_Y;
+    x1 = region->x + region->width < ST77xx_FB_X + ST77xx_FB_WIDTH
+             ? region->x + region->width - 1
+             : ST77xx_FB_X + ST77xx_FB_WIDTH - 1;
+    y1 = region->y + region->height < ST77xx_FB_Y + ST77xx_FB_HEIGHT
+             ? region->y + region->height - 1
+             : ST77xx_FB_Y + ST77xx_FB_HEIGHT - 1;
+    if (x0 > x1 || y0 > y1) {
+        return 0;
+    }
+
+    /* 重叠部分就是整个区域时区域完全在帧缓冲区内 */
+    inside = x0 == region->x && y0 == region->y &&
+             x1 == region->x + region->width - 1 &&
+             y1 == region->y + region->height - 1;
+
+    /* 帧缓冲区和行缓冲区可能正在通过 DMA 发送 */
+    ST77xx_WaitIdle();
+
+    /* 按区域光栅化到行缓冲区, 再把重叠的列拷贝到帧缓冲区 */
+    lines = ST77xx_RENDER_BUF_PIXELS / region->width;
+    for (y = y0; y <= y1; y += n) {
+        n = y1 + 1 - y < lines ? y1 + 1 - y : lines;
+        ST77xx_RasterBand(st77xx_render_buf[0], region, y, n);
+        for (i = 0; i < n; i++) {
+            memcpy(&st77xx_fb[y + i - ST77xx_FB_Y][x0 - ST77xx_FB_X],
+                   &st77xx_render_buf[0][i * region->width + x0 - region->x],
+                   (x1 - x0 + 1) * sizeof(uint16_t));
+        }
+    }
+
+    if (inside) {
+        ST77xx_FBMarkDirty(x0 - ST77xx_FB_X, y0 - ST77xx_FB_Y,
+                           x1 - ST77xx_FB_X, y1 - ST77xx_FB_Y);
+    }
+
+    return inside;
+}
+
+/**
+ * @brief 发送帧缓冲区中的一个窗口
+ * 
+ * @param tx0 起始列块
+ * @param tx1 结束列块 (包含)
+ * @param y 起始行, 相对帧缓冲区
+ * @param height 行数
+ */
+static void ST77xx_FBSend(int tx0, int tx1, uint16_t y, uint16_t height) {
+    uint16_t x = tx0 * ST77xx_FB_TILE;
+    uint16_t width = (tx1 - tx0 + 1) * ST77xx_FB_TILE;
+    uint16_t lines = ST77xx_RENDER_BUF_PIXELS / width;
+    uint16_t n, i, row;
+    uint8_t k = 0;
+
+    ST77xx_SetAddressWindow(ST77xx_FB_X + x, ST77xx_FB_Y + y,
+                            ST77xx_FB_X + x + width - 1,
+                            ST77xx_FB_Y + y + height - 1);
+    ST77xx_WriteCommand(ST7735_RAMWR);
+
+    if (width == ST77xx_FB_WIDTH) {
+        /* 整行宽度的窗口在帧缓冲区中是连续的, 直接发送 */
+        ST77xx_WritePixels((const uint8_t *)&st77xx_fb[y][0],
+                           (uint32_t)width * height * sizeof(uint16_t));
+        return;
+    }
+
+    /* 否则逐段拷贝到行缓冲区, 一个发送时拷贝另一个 */
+    for (row = y; row < y + height; row += n) {
+        n = y + height - row < lines ? y + height - row : lines;
+        for (i = 0; i < n; i++) {
+            memcpy(&st77xx_render_buf[k][i * width], &st77xx_fb[row + i][x],
+                   width * sizeof(uint16_t));
+        }
+        ST77xx_WritePixels((const uint8_t *)st77xx_render_buf[k],
+                           (uint32_t)width * n * sizeof(uint16_t));
+        k ^= 1;
+    }
+}
+
+#endif /* ST77xx_USE_FRAMEBUFFER */
+
+/**
+ * @brief 发送帧缓冲区中改动过的块
+ * 
+ * @note 同一行中相邻的改动块合并, 上下相邻且范围相同的再合并,
+ *       每个合并后的矩形只设置一次窗口, 纵向只发送改动过的像素行.
+ *       不使用帧缓冲区时只等待发送完成
+ */
+void ST77xx_Flush(void) {
+#if ST77xx_USE_FRAMEBUFFER
+    uint32_t mask, run;
+    int tx0, tx1, ty, ty1, i;
+
+    for (ty = 0; ty < ST77xx_FB_TILES_Y; ty++) {
+        while (st77xx_fb_dirty[ty] != 0) {
+            /* 找到这一行中第一段连续的改动块 */
+            mask = st77xx_fb_dirty[ty];
+            for (tx0 = 0; !(mask & (1U << tx0)); tx0++) {
+            }
+            for (tx1 = tx0; tx1 + 1 < ST77xx_FB_TILES_X &&
+                            (mask & (1U << (tx1 + 1)));
+                 tx1++) {
+            }
+            run = (0xFFFFFFFFU >> (31 - tx1)) & (0xFFFFFFFFU << tx0);
+
+            /* 下面的行中同一段正好是一段完整的改动块时一起发送 */
+            for (ty1 = ty; ty1 + 1 < ST77xx_FB_TILES_Y; ty1++) {
+                mask = st77xx_fb_dirty[ty1 + 1];
+                if ((mask & run) != run ||
+                    (tx0 > 0 && (mask & (1U << (tx0 - 1)))) ||
+                    (tx1 + 1 < ST77xx_FB_TILES_X &&
+                     (mask & (1U << (tx1 + 1))))) {
+                    break;
+                }
+            }
+
+            /* 第一行块和最后一行块只发送改动过的像素行 */
+            ST77xx_FBSend(tx0, tx1,
+                          ty * ST77xx_FB_TILE + st77xx_fb_dirty_y0[ty],
+                          (ty1 - ty) * ST77xx_FB_TILE +
+                              st77xx_fb_dirty_y1[ty1] -
+                              st77xx_fb_dirty_y0[ty] + 1);
+            for (i = ty; i <= ty1; i++) {
+                st77xx_fb_dirty[i] &= ~run;
+            }
+        }
+    }
+#endif /* ST77xx_USE_FRAMEBUFFER */
+
+    ST77xx_WaitIdle();
+}
+
+/**
+ * @brief 发送一段直线上连续的点
+ * 
+ */
+static void ST77xx_LineRun(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
+                           const uint16_t *buf) {
+    uint32_t total = (uint32_t)(x1 - x0 + 1) * (y1 - y0 + 1);
+    uint32_t count;
+
+    ST77xx_SetAddressWindow(x0, y0, x1, y1);
+    ST77xx_WriteCommand(ST7735_RAMWR);
+    while (total > 0) {
+        count = total < ST77xx_RENDER_BUF_PIXELS ? total
+                                                 : ST77xx_RENDER_BUF_PIXELS;
+        ST77xx_WritePixels((const uint8_t *)buf, count * sizeof(uint16_t));
+        total -= count;
+    }
+}
+
 /**
  * @brief 划线函数
  * 
@@ -292,14 +1052,16 @@ void ST77xx_SetAddressWindow(uint16_t x0, uint16_t y0, uint16_t x1,
  * @param x1 
  * @param y1 
  * @param color 
+ * @note 同一行 (或同一列) 上连续的点合并成一个窗口发送
  */
 void ST77xx_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
                      uint16_t color) {
     uint16_t t;
-    uint8_t buffer[] = {color >> 8, color & 0xFF};
-    ;
+    uint16_t *buffer;
     int xerr = 0, yerr = 0, delta_x, delta_y, distance;
     int incx, incy, uRow, uCol;
+    int rx0, ry0, rx1, ry1; /* 当前连续段的范围 */
+    uint8_t steep;
     delta_x = x1 - x0; //计算坐标增量
     delta_y = y1 - y0;
     uRow = x0; //画线起点坐标
@@ -325,10 +1087,39 @@ void ST77xx_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
     } else {
         distance = delta_y;
     }
+
+#if ST77xx_USE_FRAMEBUFFER
+    st77xx_cmd_t cmd = {.type = ST77xx_CMD_LINE,
+                        .x0 = x0,
+                        .y0 = y0,
+                        .x1 = x1,
+                        .y1 = y1,
+                        .color = color};
+    if (ST77xx_FBDraw(&cmd)) {
+        return;
+    }
+#endif /* ST77xx_USE_FRAMEBUFFER */
+
+    /* 一段最多 distance + 1 个点 */
+    buffer = ST77xx_FillBuffer(color, distance + 1 < ST77xx_RENDER_BUF_PIXELS
+                                          ? distance + 1
+                                          : ST77xx_RENDER_BUF_PIXELS);
+    steep = (delta_x <= delta_y);
+    rx0 = rx1 = uRow;
+    ry0 = ry1 = uCol;
+
     for (t = 0; t < distance + 1; t++) {
-        ST77xx_SetAddressWindow(uRow, uCol, uRow, uCol); //画点
-        ST77xx_WriteCommand(ST7735_RAMWR);
-        ST77xx_WriteData(buffer, sizeof(buffer));
+        if ((steep && uRow != rx0) || (!steep && uCol != ry0)) {
+            /* 换行 (或换列), 发送上一段 */
+            ST77xx_LineRun(rx0, ry0, rx1, ry1, buffer);
+            rx0 = rx1 = uRow;
+            ry0 = ry1 = uCol;
+        }
+        rx0 = uRow < rx0 ? uRow : rx0;
+        rx1 = uRow > rx1 ? uRow : rx1;
+        ry0 = uCol < ry0 ? uCol : ry0;
+        ry1 = uCol > ry1 ? uCol : ry1;
+
         xerr += delta_x;
         yerr += delta_y;
         if (xerr > distance) {
@@ -340,6 +1131,7 @@ void ST77xx_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
             uCol += incy;
         }
     }
+    ST77xx_LineRun(rx0, ry0, rx1, ry1, buffer);
 }
 
 /**
@@ -356,61 +1148,118 @@ void ST77xx_DrawRectangle(uint16_t x, uint16_t y, uint16_t width,
     if ((width + x > lcd_dev.width) || (height + y > lcd_dev.height)) {
         return;
     }
-    static uint8_t buff[ST77xx_MAX_WIDTH * 2];
-    uint16_t i = 0;
+    uint32_t total = (uint32_t)width * height;
+    uint32_t count = total < ST77xx_RENDER_BUF_PIXELS
+                         ? total
+                         : ST77xx_RENDER_BUF_PIXELS;
+    uint16_t *buff;
 
-    for (i = 0; i < width; i++) {
-        buff[i * 2] = color >> 8;
-        buff[i * 2 + 1] = color & 0xFF;
+    if (total == 0) {
+        return;
     }
 
+#if ST77xx_USE_FRAMEBUFFER
+    st77xx_cmd_t cmd = {.type = ST77xx_CMD_RECT,
+                        .x0 = x,
+                        .y0 = y,
+                        .x1 = width,
+                        .y1 = height,
+                        .color = color};
+    if (ST77xx_FBDraw(&cmd)) {
+        return;
+    }
+#endif /* ST77xx_USE_FRAMEBUFFER */
+
+    /* 缓冲区内容相同, 可以反复发送 */
+    buff = ST77xx_FillBuffer(color, count);
+
     ST77xx_SetAddressWindow(x, y, x + width - 1, y + height - 1);
     ST77xx_WriteCommand(ST7735_RAMWR);
     // Write the color data
-    for (i = 0; i < height; i++) {
-        ST77xx_WriteData(buff, sizeof(uint16_t) * width);
+    while (total > 0) {
+        if (count > total) {
+            count = total;
+        }
+        ST77xx_WritePixels((const uint8_t *)buff, count * sizeof(uint16_t));
+        total -= count;
     }
 }
 
 void ST77xx_DrawChar(uint16_t x, uint16_t y, char c, uint16_t color,
                      uint16_t bgColor, const FontDef *font) {
-    uint32_t i, b, j;
-
-    ST77xx_SetAddressWindow(x, y, x + font->width - 1, y + font->height - 1);
-    ST77xx_WriteCommand(ST7735_RAMWR);
+    /* 字符缓冲区要保持到光栅化完成, ST77xx_RenderRegion 返回时已经用完 */
+    char str[2] = {c, '\0'};
+    st77xx_cmd_t cmd = {.type = ST77xx_CMD_STRING,
+                        .x0 = x,
+                        .y0 = y,
+                        .color = color,
+                        .bgColor = bgColor,
+                        .str = str,
+                        .font = font};
+    st77xx_region_t region = {.x = x,
+                              .y = y,
+                              .width = font->width,
+                              .height = font->height,
+                              .bgColor = bgColor,
+                              .cmds = &cmd,
+                              .count = 1};
 
-    for (i = 0; i < font->height; i++) {
-        b = font->data[(font == &Font_Custom ? (c - 46) : (c - 32)) *
-                           font->height +
-                       i];
-        for (j = 0; j < font->width; j++) {
-            if ((b << j) & (font->width > 16 ? 0x80000000 : 0x8000)) {
-                uint8_t data[] = {color >> 8, color & 0xFF};
-                ST77xx_WriteData(data, sizeof(data));
-            } else {
-                uint8_t data[] = {bgColor >> 8, bgColor & 0xFF};
-                ST77xx_WriteData(data, sizeof(data));
-            }
-        }
+#if ST77xx_USE_FRAMEBUFFER
+    if (ST77xx_FBDraw(&cmd)) {
+        return;
     }
+#endif /* ST77xx_USE_FRAMEBUFFER */
+
+    ST77xx_RenderRegion(&region);
 }
 
+/**
+ * @brief 显示字符串
+ * 
+ * @note 每一行字符合并成一个区域, 设置一次窗口
+ */
 void ST77xx_DrawString(uint16_t x, uint16_t y, const char *str, uint16_t color,
                        uint16_t bgColor, const FontDef *font) {
+    st77xx_cmd_t cmd = {.type = ST77xx_CMD_STRING,
+                        .x0 = x,
+                        .y0 = y,
+                        .color = color,
+                        .bgColor = bgColor,
+                        .str = str,
+                        .font = font};
+    st77xx_region_t region = {.height = font->height,
+                              .bgColor = bgColor,
+                              .cmds = &cmd,
+                              .count = 1};
+
+#if ST77xx_USE_FRAMEBUFFER
+    if (ST77xx_FBDraw(&cmd)) {
+        return;
+    }
+#endif /* ST77xx_USE_FRAMEBUFFER */
+
+    region.x = x;
+    region.y = y;
+    region.width = 0;
     while (*str) {
         if (x + font->width > lcd_dev.width) {
+            ST77xx_RenderRegion(&region);
             x = 0;
             y += font->height;
+            region.x = x;
+            region.y = y;
+            region.width = 0;
         }
 
         if (y + font->height > lcd_dev.height) {
             break;
         }
 
-        ST77xx_DrawChar(x, y, *str, color, bgColor, font);
+        region.width += font->width;
         x += font->width;
         str++;
     }
+    ST77xx_RenderRegion(&region);
 }
 
 void ST77xx_FillScreen(uint16_t color) {
@@ -419,9 +1268,23 @@ void ST77xx_FillScreen(uint16_t color) {
 
 void ST77xx_DrawImage(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
                       const uint8_t *image) {
+#if ST77xx_USE_FRAMEBUFFER
+    st77xx_cmd_t cmd = {.type = ST77xx_CMD_IMAGE,
+                        .x0 = x,
+                        .y0 = y,
+                        .x1 = width,
+                        .y1 = height,
+                        .image = image};
+    if (ST77xx_FBDraw(&cmd)) {
+        return;
+    }
+#endif /* ST77xx_USE_FRAMEBUFFER */
+
     ST77xx_SetAddressWindow(x, y, x + width - 1, y + height - 1);
 
     ST77xx_WriteCommand(ST7735_RAMWR);
 
-    ST77xx_WriteData((uint8_t *)image, sizeof(uint16_t) * width * height);
+    ST77xx_WritePixels(image, sizeof(uint16_t) * width * height);
+    /* 图片可能在 RAM 中, 返回前等待发送完成 */
+    ST77xx_WaitIdle();
 }
@@ -65,6 +65,36 @@ extern const FontDef Font_Custom;
 
 #define ST7735_INVERSE     0 /*!< Color Inverse: 0=NO, 1=YES */
 
+/*************************************************************************************************/
+/* 渲染设置 */
+
+#ifndef ST77xx_USE_DMA
+#define ST77xx_USE_DMA           0    /*!< 像素数据是否使用 SPI DMA 发送, SPI 没有配置 TX DMA 时仍阻塞发送 */
+#endif /* ST77xx_USE_DMA */
+#define ST77xx_RENDER_BUF_PIXELS 2048 /*!< 每个行缓冲区的像素数 (共两个), 不小于 ST77xx_MAX_WIDTH */
+#define ST77xx_RENDER_MAX_CMDS   32   /*!< 一个渲染区域最多记录的绘制命令数 */
+
+/*************************************************************************************************/
+/* 帧缓冲区设置
+ *
+ * 帧缓冲区只在同一帧内多次重画同一片区域时 (如零散的小矩形、逐点画线、
+ * 先清除再重画) 才划算, 改动的块合并后只发送一次. 每个区域一帧只画一次时,
+ * 按块对齐会多发送块内没有改动的像素, 还要多一次拷贝, 反而更慢.
+ * test/st77xx_fb_test.c 的结果 (40 MHz SPI): 波形界面每帧 14.3k 字节,
+ * 1 个窗口, 9 次 SPI 调用, 直接发送为 14.8k 字节, 111 个窗口, 668 次调用;
+ * 4 个数字字段每帧 12.3k 字节 / 2.46ms, 直接发送为 8.0k 字节 / 1.59ms.
+ * 后一种情况应关闭帧缓冲区, 用渲染区域
+ * (ST77xx_RenderBegin ... ST77xx_RenderEnd) 一次画完. */
+
+#ifndef ST77xx_USE_FRAMEBUFFER
+#define ST77xx_USE_FRAMEBUFFER 0   /*!< 是否使用分块帧缓冲区, 绘制函数只写缓冲区, 调用 ST77xx_Flush 时发送改动的块 */
+#endif /* ST77xx_USE_FRAMEBUFFER */
+#define ST77xx_FB_TILE         16  /*!< 块的边长 (像素) */
+#define ST77xx_FB_X            0   /*!< 帧缓冲区覆盖的区域, 超出该区域的绘制直接发送到屏幕 */
+#define ST77xx_FB_Y            0
+#define ST77xx_FB_WIDTH        240 /*!< ST77xx_FB_TILE 的整数倍, 最多 32 块, 占用 RAM 为 宽 x 高 x 2 字节 */
+#define ST77xx_FB_HEIGHT       128 /*!< ST77xx_FB_TILE 的整数倍 */
+
 /*************************************************************************************************/
 /* 颜色定义 */
 
@@ -146,7 +176,22 @@ void ST77xx_DrawRectangle(uint16_t x, uint16_t y, uint16_t width,
 void ST77xx_DrawString(uint16_t x, uint16_t y, const char *str, uint16_t color,
                        uint16_t bgColor, const FontDef *font);
 void ST77xx_FillScreen(uint16_t color);
+void ST77xx_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
+                     uint16_t color);
 void ST77xx_DrawImage(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
                       const uint8_t *image);
+void ST77xx_WaitIdle(void);
+void ST77xx_Flush(void);
+
+void ST77xx_RenderBegin(uint16_t x, uint16_t y, uint16_t width,
+                        uint16_t height, uint16_t bgColor);
+void ST77xx_RenderRectangle(uint16_t x, uint16_t y, uint16_t width,
+                            uint16_t height, uint16_t color);
+void ST77xx_RenderLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
+                       uint16_t color);
+void ST77xx_RenderString(uint16_t x, uint16_t y, const char *str,
+                         uint16_t color, uint16_t bgColor,
+                         const FontDef *font);
+void ST77xx_RenderEnd(void);
 
 #endif /* _ST77xx_H_ */
\ No newline at end of file
@@ -0,0 +1,16 @@
+/**
+ * @file    core_delay.h
+ * @brief   主机测试用的延时替身. st77xx.c 按 `../core/core_delay.h` 包含,
+ *          从 `-Itest/stub` 查找时即为本文件.
+ */
+
+#ifndef __CORE_DELAY_H
+#define __CORE_DELAY_H
+
+#include <stdint.h>
+
+static inline void delay_ms(uint32_t ms) {
+    (void)ms;
+}
+
+#endif /* __CORE_DELAY_H */
@@ -0,0 +1,342 @@
+/**
+ * @file    st77xx_fb_test.c
+ * @brief   分块帧缓冲区的主机测试, 屏幕由 st77xx_mock.c 模拟
+ *
+ * 在 `Display/st77xx` 下编译运行, 使用与不使用 DMA 各一次:
+ *
+ *   for d in 0 1; do \
+ *       gcc -std=gnu11 -g -O1 -Wall -Wextra -fsanitize=address,undefined \
+ *           -Itest/stub -Itest -I. -DST77xx_USE_DMA=$d \
+ *           -DST77xx_USE_FRAMEBUFFER=1 test/st77xx_fb_test.c \
+ *           test/st77xx_mock.c test/st77xx_ref.c st77xx.c \
+ *           -o st77xx_fb_test && ./st77xx_fb_test; \
+ *   done
+ *
+ * 检查项:
+ *  - 四个显示方向下随机绘制, 图形完全在帧缓冲区内, 部分重叠或在帧缓冲区外:
+ *    每次绘制后帧缓冲区以外的像素已经与参考绘制相同,
+ *    `ST77xx_Flush` 后整个屏幕与参考绘制相同
+ *  - `ST77xx_Flush` 之后没有新的绘制时再次调用不发送任何数据
+ *  - 部分重叠的图形直接发送到屏幕后, 重叠部分不再由 `ST77xx_Flush` 重复发送
+ *
+ * 最后比较几种界面每帧的总线字节数, 窗口数, SPI 调用次数和 40 MHz SPI 上的
+ * 传输时间, 同一界面分别画在帧缓冲区内和帧缓冲区下方 (直接发送):
+ *  - 波形: 清除绘图区后逐段画 30 段折线和 20 个 4x4 标记;
+ *  - 字段: 4 个字段每帧各重画一次.
+ */
+
+#include "st77xx.h"
+#include "st77xx_mock.h"
+#include "st77xx_ref.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+#if !ST77xx_USE_FRAMEBUFFER
+#error "build with -DST77xx_USE_FRAMEBUFFER=1"
+#endif /* ST77xx_USE_FRAMEBUFFER */
+
+#define TEST_OPS     4000
+#define TEST_POWERON 0x5AA5
+#define TEST_SPI_MHZ 40
+#define BENCH_FRAMES 200
+/* 直接发送时界面画在帧缓冲区下方 */
+#define BENCH_DIRECT_Y (ST77xx_FB_Y + ST77xx_FB_HEIGHT)
+
+static uint32_t test_rand_state = 1;
+
+static uint32_t test_rand(void) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return test_rand_state >> 8;
+}
+
+static uint16_t test_rand_range(uint16_t lo, uint16_t hi) {
+    return (uint16_t)(lo + test_rand() % (uint32_t)(hi - lo + 1));
+}
+
+static uint8_t test_image[2 * 40 * 40];
+static char test_str[8][40];
+
+static void test_init(uint8_t dir) {
+    static uint8_t dummy_dma;
+
+    spi1_handle.hdmatx = (DMA_HandleTypeDef *)&dummy_dma;
+    mock_panel_reset(TEST_POWERON);
+    ST77xx_Init(dir, ST7789);
+    ref_reset(TEST_POWERON);
+    ref_rect(0, 0, lcd_dev.width, lcd_dev.height, ST77xx_WHITE);
+    CHECK(ref_compare() == 0);
+    CHECK(mock_stats.errors == 0);
+}
+
+/**
+ * @brief 帧缓冲区以外的像素与参考绘制比较
+ */
+static void test_compare_outside(void) {
+    ST77xx_WaitIdle();
+    for (int y = 0; y < lcd_dev.height; ++y) {
+        for (int x = 0; x < lcd_dev.width; ++x) {
+            if (x >= ST77xx_FB_X && x < ST77xx_FB_X + ST77xx_FB_WIDTH &&
+                y >= ST77xx_FB_Y && y < ST77xx_FB_Y + ST77xx_FB_HEIGHT) {
+                continue;
+            }
+            CHECK(mock_panel[y][x] == ref_screen[y][x]);
+        }
+    }
+}
+
+/**
+ * @brief 随机坐标, 一半落在帧缓冲区附近
+ */
+static void test_rand_point(uint16_t *x, uint16_t *y) {
+    if (test_rand() % 2) {
+        *x = test_rand_range(0, ST77xx_FB_X + ST77xx_FB_WIDTH - 1);
+        *y = test_rand_range(0, ST77xx_FB_Y + ST77xx_FB_HEIGHT - 1);
+    } else {
+        *x = test_rand_range(0, lcd_dev.width - 1);
+        *y = test_rand_range(0, lcd_dev.height - 1);
+    }
+}
+
+static void test_rand_string(char *str) {
+    uint32_t len = 1 + test_rand() % 20;
+
+    for (uint32_t i = 0; i < len; ++i) {
+        str[i] = (char)test_rand_range(32, 126);
+    }
+    str[len] = '\0';
+}
+
+static void test_draw_random(void) {
+    const FontDef *font = (test_rand() % 2) ? &Font_7x10 : &Font_11x18;
+    uint16_t color = (uint16_t)test_rand();
+    uint16_t bg = (uint16_t)test_rand();
+    uint16_t x, y, x1, y1, w, h;
+
+    test_rand_point(&x, &y);
+    test_rand_point(&x1, &y1);
+    w = test_rand_range(1, lcd_dev.width - x);
+    h = test_rand_range(1, lcd_dev.height - y);
+    /* 多数图形较小 */
+    if (test_rand() % 4) {
+        w = w > 24 ? test_rand_range(1, 24) : w;
+        h = h > 24 ? test_rand_range(1, 24) : h;
+    }
+
+    switch (test_rand() % 12) {
+        case 0:
+        case 1:
+        case 2:
+            ST77xx_DrawRectangle(x, y, w, h, color);
+            ref_rect(x, y, w, h, color);
+            break;
+
+        case 3:
+        case 4:
+        case 5:
+            ST77xx_DrawLine(x, y, x1, y1, color);
+            ref_line(x, y, x1, y1, color);
+            break;
+
+        case 6:
+        case 7:
+            test_rand_string(test_str[0]);
+            ST77xx_DrawString(x, y, test_str[0], color, bg, font);
+            ref_string(x, y, test_str[0], color, bg, font);
+            memset(test_str[0], '#', sizeof(test_str[0]));
+            break;
+
+        case 8:
+            w = w > 40 ? 40 : w;
+            h = h > 40 ? 40 : h;
+            for (uint32_t i = 0; i < sizeof(test_image); ++i) {
+                test_image[i] = (uint8_t)test_rand();
+            }
+            ST77xx_DrawImage(x, y, w, h, test_image);
+            ref_image(x, y, w, h, test_image);
+            memset(test_image, 0, sizeof(test_image));
+            break;
+
+        default: {
+            uint32_t n = test_rand() % 6;
+
+            ST77xx_RenderBegin(x, y, w, h, bg);
+            ref_clip(x, y, w, h);
+            ref_rect(x, y, w, h, bg);
+            for (uint32_t i = 0; i < n; ++i) {
+                test_rand_point(&x1, &y1);
+                color = (uint16_t)test_rand();
+                if (test_rand() % 2) {
+                    ST77xx_RenderRectangle(x1, y1, 12, 8, color);
+                    ref_rect(x1, y1, 12, 8, color);
+                } else {
+                    test_rand_string(test_str[i]);
+                    ST77xx_RenderString(x1, y1, test_str[i], color, bg,
+                                        font);
+                    ref_string(x1, y1, test_str[i], color, bg, font);
+                }
+            }
+            ST77xx_RenderEnd();
+            ref_clip_screen();
+            memset(test_str, '#', sizeof(test_str));
+            break;
+        }
+    }
+}
+
+static void test_random(void) {
+    uint32_t flushes = 0;
+
+    for (uint8_t dir = 0; dir < 4; ++dir) {
+        test_init(dir);
+
+        for (uint32_t op = 0; op < TEST_OPS / 4; ++op) {
+            test_draw_random();
+            test_compare_outside();
+
+            if (test_rand() % 8 == 0) {
+                ST77xx_Flush();
+                CHECK(ref_compare() == 0);
+                CHECK(mock_stats.errors == 0);
+                flushes++;
+
+                /* 没有新的改动时不发送 */
+                memset(&mock_stats, 0, sizeof(mock_stats));
+                ST77xx_Flush();
+                CHECK(mock_bus_bytes() == 0);
+            }
+        }
+        ST77xx_Flush();
+        CHECK(ref_compare() == 0);
+        CHECK(mock_stats.errors == 0);
+    }
+
+    printf("random: %u ops, %u flushes, panel matches\n", TEST_OPS, flushes);
+}
+
+/**
+ * @brief 部分重叠的图形只直接发送一次
+ */
+static void test_overlap(void) {
+    uint32_t screen;
+
+    test_init(0);
+    screen = (uint32_t)lcd_dev.width * lcd_dev.height * 2;
+
+    memset(&mock_stats, 0, sizeof(mock_stats));
+    ST77xx_FillScreen(ST77xx_BLUE);
+    ref_rect(0, 0, lcd_dev.width, lcd_dev.height, ST77xx_BLUE);
+    ST77xx_Flush();
+    CHECK(ref_compare() == 0);
+    CHECK(mock_stats.windows == 1 && mock_stats.pixel_bytes == screen);
+
+    /* 跨过帧缓冲区下边界的矩形 */
+    memset(&mock_stats, 0, sizeof(mock_stats));
+    ST77xx_DrawRectangle(0, ST77xx_FB_HEIGHT - 8, 32, 16, ST77xx_RED);
+    ref_rect(0, ST77xx_FB_HEIGHT - 8, 32, 16, ST77xx_RED);
+    ST77xx_Flush();
+    CHECK(ref_compare() == 0);
+    CHECK(mock_stats.windows == 1 && mock_stats.pixel_bytes == 32 * 16 * 2);
+
+    printf("overlap: drawn directly, not flushed again\n");
+}
+
+/*****************************************************************************
+ * 每帧的总线开销
+ */
+
+static void bench_scope(uint32_t frame, uint16_t y0) {
+    uint16_t px = 0, py = y0 + 32;
+
+    ST77xx_DrawRectangle(8, y0, 96, 64, ST77xx_BLACK);
+    ref_rect(8, y0, 96, 64, ST77xx_BLACK);
+    for (uint16_t i = 0; i <= 30; ++i) {
+        uint16_t x = 8 + i * 3;
+        uint16_t y = y0 + 32 + (uint16_t)((i * 7 + frame * 5) % 29) - 14;
+
+        if (i > 0) {
+            ST77xx_DrawLine(px, py, x, y, ST77xx_GREEN);
+            ref_line(px, py, x, y, ST77xx_GREEN);
+        }
+        px = x;
+        py = y;
+    }
+    for (uint16_t i = 0; i < 20; ++i) {
+        uint16_t x = 8 + (i * 13 + frame) % 92;
+        uint16_t y = y0 + (i * 17 + frame * 3) % 60;
+
+        ST77xx_DrawRectangle(x, y, 4, 4, ST77xx_YELLOW);
+        ref_rect(x, y, 4, 4, ST77xx_YELLOW);
+    }
+}
+
+static void bench_fields(uint32_t frame, uint16_t y0) {
+    char str[16];
+
+    for (uint16_t i = 0; i < 4; ++i) {
+        uint16_t x = 120 + (i % 2) * 60;
+        uint16_t y = y0 + 4 + (i / 2) * 30;
+
+        snprintf(str, sizeof(str), "%5u",
+                 (unsigned)((frame * (i + 3)) % 100000));
+        ST77xx_DrawString(x, y, str, ST77xx_WHITE, ST77xx_BLACK, &Font_11x18);
+        ref_string(x, y, str, ST77xx_WHITE, ST77xx_BLACK, &Font_11x18);
+    }
+}
+
+static void test_bench(void) {
+    static const char *const names[] = {"scope", "fields", "scope + fields"};
+
+    for (uint32_t ui = 0; ui < 3; ++ui) {
+        for (uint32_t fb = 0; fb < 2; ++fb) {
+            uint16_t y0 = fb ? ST77xx_FB_Y : BENCH_DIRECT_Y;
+
+            test_init(0);
+            memset(&mock_stats, 0, sizeof(mock_stats));
+            for (uint32_t frame = 0; frame < BENCH_FRAMES; ++frame) {
+                if (ui != 1) {
+                    bench_scope(frame, y0);
+                }
+                if (ui != 0) {
+                    bench_fields(frame, y0);
+                }
+                ST77xx_Flush();
+            }
+            CHECK(ref_compare() == 0);
+            CHECK(mock_stats.errors == 0);
+
+            printf("bench %-14s %-11s: %7.1f bytes, %5.1f windows, "
+                   "%6.1f spi calls, %5.3f ms per frame\n",
+                   names[ui], fb ? "framebuffer" : "direct",
+                   (double)mock_bus_bytes() / BENCH_FRAMES,
+                   (double)mock_stats.windows / BENCH_FRAMES,
+                   (double)(mock_stats.transfers + mock_stats.dma_transfers) /
+                       BENCH_FRAMES,
+                   mock_bus_bytes() * 8.0 / TEST_SPI_MHZ / 1000 /
+                       BENCH_FRAMES);
+        }
+    }
+}
+
+int main(void) {
+    printf("ST77xx_USE_DMA: %d, frame buffer %dx%d at (%d, %d)\n",
+           ST77xx_USE_DMA, ST77xx_FB_WIDTH, ST77xx_FB_HEIGHT, ST77xx_FB_X,
+           ST77xx_FB_Y);
+
+    test_random();
+    test_overlap();
+    test_bench();
+
+    printf("all passed\n");
+    return 0;
+}
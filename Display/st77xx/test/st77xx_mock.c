@@ -0,0 +1,233 @@
+/**
+ * @file    st77xx_mock.c
+ * @brief   主机测试用的 ST77xx 屏幕模型
+ */
+
+#include "st77xx_mock.h"
+
+#include "stm32g4xx_ll_gpio.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+uint16_t mock_panel[MOCK_PANEL_SIZE][MOCK_PANEL_SIZE];
+mock_stats_t mock_stats;
+
+GPIO_TypeDef stub_gpioe;
+SPI_HandleTypeDef spi1_handle;
+
+/* 当前命令与已收到的参数 */
+static uint8_t mock_cmd;
+static uint8_t mock_param[4];
+static uint32_t mock_param_num;
+
+/* 窗口与写入位置 */
+static uint16_t mock_xs, mock_xe, mock_ys, mock_ye;
+static uint16_t mock_x, mock_y;
+static uint8_t mock_pixel_hi;
+static bool mock_pixel_half;
+
+static bool mock_cs = true;
+static bool mock_dc = true;
+
+/* 进行中的 DMA 传输 */
+static bool mock_dma_pending;
+static const uint8_t *mock_dma_data;
+static uint16_t mock_dma_size;
+static uint32_t mock_dma_every;
+static uint32_t mock_dma_count;
+
+/**
+ * @brief 清空统计, 屏幕显存填充为 fill
+ */
+void mock_panel_reset(uint16_t fill) {
+    for (uint32_t y = 0; y < MOCK_PANEL_SIZE; ++y) {
+        for (uint32_t x = 0; x < MOCK_PANEL_SIZE; ++x) {
+            mock_panel[y][x] = fill;
+        }
+    }
+    memset(&mock_stats, 0, sizeof(mock_stats));
+    mock_cmd = 0;
+    mock_param_num = 0;
+    mock_pixel_half = false;
+    spi1_handle.State = HAL_SPI_STATE_READY;
+}
+
+/**
+ * @brief 之后每 every 次 DMA 请求中的一次返回 HAL_ERROR, 为 0 时不失败
+ */
+void mock_dma_reject(uint32_t every) {
+    mock_dma_every = every;
+    mock_dma_count = 0;
+}
+
+/**
+ * @brief 总线上的总字节数
+ */
+uint32_t mock_bus_bytes(void) {
+    return mock_stats.commands + mock_stats.param_bytes +
+           mock_stats.pixel_bytes;
+}
+
+static void mock_command(uint8_t cmd) {
+    mock_stats.commands++;
+    if (mock_pixel_half) {
+        mock_stats.errors++;
+        mock_pixel_half = false;
+    }
+
+    mock_cmd = cmd;
+    mock_param_num = 0;
+    if (cmd == ST7735_RAMWR) {
+        mock_x = mock_xs;
+        mock_y = mock_ys;
+        if (mock_xe < mock_xs || mock_ye < mock_ys ||
+            mock_xe >= MOCK_PANEL_SIZE || mock_ye >= MOCK_PANEL_SIZE) {
+            mock_stats.errors++;
+        }
+    }
+}
+
+static void mock_pixel(uint16_t color) {
+    if (mock_y > mock_ye || mock_x >= MOCK_PANEL_SIZE ||
+        mock_y >= MOCK_PANEL_SIZE) {
+        mock_stats.errors++;
+        return;
+    }
+
+    mock_panel[mock_y][mock_x] = color;
+    if (mock_x++ == mock_xe) {
+        mock_x = mock_xs;
+        mock_y++;
+    }
+}
+
+static void mock_data(uint8_t data) {
+    if (mock_cmd != ST7735_RAMWR) {
+        mock_stats.param_bytes++;
+        if (mock_param_num < sizeof(mock_param)) {
+            mock_param[mock_param_num] = data;
+        }
+        if (++mock_param_num == sizeof(mock_param)) {
+            uint16_t start = (uint16_t)(mock_param[0] << 8 | mock_param[1]);
+            uint16_t end = (uint16_t)(mock_param[2] << 8 | mock_param[3]);
+
+            if (mock_cmd == ST7735_CASET) {
+                mock_xs = start;
+                mock_xe = end;
+                mock_stats.windows++;
+            } else if (mock_cmd == ST7735_RASET) {
+                mock_ys = start;
+                mock_ye = end;
+            }
+        }
+        return;
+    }
+
+    mock_stats.pixel_bytes++;
+    if (!mock_pixel_half) {
+        mock_pixel_hi = data;
+        mock_pixel_half = true;
+    } else {
+        mock_pixel((uint16_t)(mock_pixel_hi << 8 | data));
+        mock_pixel_half = false;
+    }
+}
+
+static void mock_receive(const uint8_t *data, uint16_t size) {
+    for (uint16_t i = 0; i < size; ++i) {
+        if (mock_dc) {
+            mock_data(data[i]);
+        } else {
+            mock_command(data[i]);
+        }
+    }
+}
+
+/**
+ * @brief 完成进行中的 DMA 传输, 此时才读取数据
+ */
+static void mock_dma_complete(void) {
+    if (!mock_dma_pending) {
+        return;
+    }
+
+    mock_dma_pending = false;
+    mock_receive(mock_dma_data, mock_dma_size);
+    spi1_handle.State = HAL_SPI_STATE_READY;
+}
+
+ErrorStatus LL_GPIO_Init(GPIO_TypeDef *GPIOx,
+                         LL_GPIO_InitTypeDef *GPIO_InitStruct) {
+    (void)GPIOx;
+    (void)GPIO_InitStruct;
+    return SUCCESS;
+}
+
+static void mock_gpio_write(GPIO_TypeDef *GPIOx, uint32_t PinMask,
+                            bool level) {
+    if (GPIOx != GPIOE) {
+        return;
+    }
+
+    if (PinMask & ST77xx_CS_Pin) {
+        mock_cs = level;
+    }
+    if (PinMask & ST77xx_DC_Pin) {
+        if (mock_dma_pending && mock_dc != level) {
+            mock_stats.errors++;
+        }
+        mock_dc = level;
+    }
+}
+
+void LL_GPIO_SetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask) {
+    mock_gpio_write(GPIOx, PinMask, true);
+}
+
+void LL_GPIO_ResetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask) {
+    mock_gpio_write(GPIOx, PinMask, false);
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData,
+                                   uint16_t Size, uint32_t Timeout) {
+    (void)Timeout;
+
+    if (hspi != &spi1_handle || mock_cs || mock_dma_pending) {
+        mock_stats.errors++;
+        return HAL_BUSY;
+    }
+
+    mock_stats.transfers++;
+    mock_receive(pData, Size);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData,
+                                       uint16_t Size) {
+    if (hspi != &spi1_handle || hspi->hdmatx == NULL || mock_cs ||
+        mock_dma_pending) {
+        mock_stats.errors++;
+        return HAL_BUSY;
+    }
+
+    if (mock_dma_every != 0 && ++mock_dma_count % mock_dma_every == 0) {
+        mock_stats.dma_rejected++;
+        return HAL_ERROR;
+    }
+
+    mock_stats.dma_transfers++;
+    mock_dma_pending = true;
+    mock_dma_data = pData;
+    mock_dma_size = Size;
+    hspi->State = HAL_SPI_STATE_BUSY_TX;
+    return HAL_OK;
+}
+
+HAL_SPI_StateTypeDef HAL_SPI_GetState(SPI_HandleTypeDef *hspi) {
+    HAL_SPI_StateTypeDef state = hspi->State;
+
+    /* 查询一次后传输完成 */
+    mock_dma_complete();
+    return state;
+}
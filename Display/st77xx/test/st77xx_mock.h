@@ -0,0 +1,51 @@
+/**
+ * @file    st77xx_mock.h
+ * @brief   主机测试用的 ST77xx 屏幕模型
+ *
+ *****************************************************************************
+ * 代替板级的 LL GPIO 与 SPI, 与 st77xx.c 一起编译. 解析命令:
+ *  - CASET / RASET 各带 4 字节参数, 设置窗口的列和行范围;
+ *  - RAMWR 之后的数据每 2 字节 (高字节在前) 为一个像素, 从窗口左上角
+ *    开始按行写入, 超出窗口, 窗口超出显存或者像素不完整记入 `errors`;
+ *  - 其他命令的参数只计数.
+ * CS 为低时传输, DC 为低是命令, 为高是数据; CS 为高时传输记入 `errors`.
+ *
+ * DMA: `spi1_handle.hdmatx` 为 NULL 时调用 `HAL_SPI_Transmit_DMA` 记入
+ * `errors` (HAL 会访问空指针). 启动的传输只记下缓冲区, 到
+ * `HAL_SPI_GetState` 查询时才读取数据, 与 DMA 在函数返回后读取数据相同;
+ * 传输完成前再发起传输或改变 DC 电平记入 `errors`. `mock_dma_reject`
+ * 让之后每 n 次 DMA 请求中的一次返回 `HAL_ERROR`, 模拟启动失败.
+ *****************************************************************************
+ */
+
+#ifndef __ST77XX_MOCK_H
+#define __ST77XX_MOCK_H
+
+#include "st77xx.h"
+
+/* 模拟显存的边长, 按逻辑坐标存放, 不区分显示方向 */
+#define MOCK_PANEL_SIZE ST77xx_MAX_WIDTH
+
+/**
+ * @brief 总线传输统计
+ */
+typedef struct {
+    uint32_t commands;      /*!< 命令字节数 */
+    uint32_t param_bytes;   /*!< 命令参数字节数 */
+    uint32_t pixel_bytes;   /*!< 像素字节数 */
+    uint32_t windows;       /*!< 设置窗口 (CASET) 次数 */
+    uint32_t transfers;     /*!< 阻塞传输次数 */
+    uint32_t dma_transfers; /*!< DMA 传输次数 */
+    uint32_t dma_rejected;  /*!< 启动失败的 DMA 请求数 */
+    uint32_t errors;        /*!< 时序或地址错误 */
+} mock_stats_t;
+
+/* 屏幕显存, [y][x], 颜色为 RGB565 */
+extern uint16_t mock_panel[MOCK_PANEL_SIZE][MOCK_PANEL_SIZE];
+extern mock_stats_t mock_stats;
+
+void mock_panel_reset(uint16_t fill);
+void mock_dma_reject(uint32_t every);
+uint32_t mock_bus_bytes(void);
+
+#endif /* __ST77XX_MOCK_H */
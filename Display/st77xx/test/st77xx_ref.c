@@ -0,0 +1,123 @@
+/**
+ * @file    st77xx_ref.c
+ * @brief   主机测试用的逐像素参考绘制
+ */
+
+#include "st77xx_ref.h"
+
+uint16_t ref_screen[MOCK_PANEL_SIZE][MOCK_PANEL_SIZE];
+
+/* 裁剪区域 [x0, x1) x [y0, y1) */
+static int ref_x0, ref_y0, ref_x1, ref_y1;
+
+void ref_reset(uint16_t fill) {
+    for (uint32_t y = 0; y < MOCK_PANEL_SIZE; ++y) {
+        for (uint32_t x = 0; x < MOCK_PANEL_SIZE; ++x) {
+            ref_screen[y][x] = fill;
+        }
+    }
+    ref_clip_screen();
+}
+
+void ref_clip(uint16_t x, uint16_t y, uint16_t width, uint16_t height) {
+    ref_x0 = x;
+    ref_y0 = y;
+    ref_x1 = x + width;
+    ref_y1 = y + height;
+}
+
+void ref_clip_screen(void) {
+    ref_clip(0, 0, lcd_dev.width, lcd_dev.height);
+}
+
+static void ref_point(int x, int y, uint16_t color) {
+    if (x >= ref_x0 && x < ref_x1 && y >= ref_y0 && y < ref_y1) {
+        ref_screen[y][x] = color;
+    }
+}
+
+void ref_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+              uint16_t color) {
+    for (int i = y; i < y + height; ++i) {
+        for (int j = x; j < x + width; ++j) {
+            ref_point(j, i, color);
+        }
+    }
+}
+
+void ref_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
+              uint16_t color) {
+    int delta_x = x1 - x0, delta_y = y1 - y0;
+    int incx = delta_x > 0 ? 1 : (delta_x == 0 ? 0 : -1);
+    int incy = delta_y > 0 ? 1 : (delta_y == 0 ? 0 : -1);
+    int xerr = 0, yerr = 0, x = x0, y = y0, distance;
+
+    delta_x = delta_x < 0 ? -delta_x : delta_x;
+    delta_y = delta_y < 0 ? -delta_y : delta_y;
+    distance = delta_x > delta_y ? delta_x : delta_y;
+
+    for (int t = 0; t <= distance; ++t) {
+        ref_point(x, y, color);
+        xerr += delta_x;
+        yerr += delta_y;
+        if (xerr > distance) {
+            xerr -= distance;
+            x += incx;
+        }
+        if (yerr > distance) {
+            yerr -= distance;
+            y += incy;
+        }
+    }
+}
+
+void ref_string(uint16_t x, uint16_t y, const char *str, uint16_t color,
+                uint16_t bgColor, const FontDef *font) {
+    uint32_t mask = font->width > 16 ? 0x80000000U : 0x8000U;
+
+    for (; *str; ++str) {
+        if (x + font->width > lcd_dev.width) {
+            x = 0;
+            y += font->height;
+        }
+        if (y + font->height > lcd_dev.height) {
+            break;
+        }
+
+        for (int i = 0; i < font->height; ++i) {
+            uint32_t b = font->data[(*str - 32) * font->height + i];
+
+            for (int j = 0; j < font->width; ++j) {
+                ref_point(x + j, y + i, (b << j) & mask ? color : bgColor);
+            }
+        }
+        x += font->width;
+    }
+}
+
+void ref_image(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+               const uint8_t *image) {
+    for (int i = 0; i < height; ++i) {
+        for (int j = 0; j < width; ++j) {
+            const uint8_t *p = &image[(i * width + j) * 2];
+
+            ref_point(x + j, y + i, (uint16_t)(p[0] << 8 | p[1]));
+        }
+    }
+}
+
+/**
+ * @brief 比较屏幕模型与参考结果
+ *
+ * @return 不同的像素数
+ */
+uint32_t ref_compare(void) {
+    uint32_t diff = 0;
+
+    for (uint32_t y = 0; y < MOCK_PANEL_SIZE; ++y) {
+        for (uint32_t x = 0; x < MOCK_PANEL_SIZE; ++x) {
+            diff += mock_panel[y][x] != ref_screen[y][x];
+        }
+    }
+    return diff;
+}
@@ -0,0 +1,33 @@
+/**
+ * @file    st77xx_ref.h
+ * @brief   主机测试用的逐像素参考绘制, 与 st77xx.c 画出的像素相同
+ *
+ *****************************************************************************
+ * 画到 `ref_screen` 中, 只画裁剪区域内的点. 直线的取点方式, 字符串的换行
+ * 方式与驱动相同, 屏幕宽高取 `lcd_dev`. 测试在驱动绘制后把 `ref_screen`
+ * 与屏幕模型逐像素比较.
+ *****************************************************************************
+ */
+
+#ifndef __ST77XX_REF_H
+#define __ST77XX_REF_H
+
+#include "st77xx_mock.h"
+
+extern lcd_dev_t lcd_dev;
+extern uint16_t ref_screen[MOCK_PANEL_SIZE][MOCK_PANEL_SIZE];
+
+void ref_reset(uint16_t fill);
+void ref_clip(uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+void ref_clip_screen(void);
+void ref_rect(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+              uint16_t color);
+void ref_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
+              uint16_t color);
+void ref_string(uint16_t x, uint16_t y, const char *str, uint16_t color,
+                uint16_t bgColor, const FontDef *font);
+void ref_image(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+               const uint8_t *image);
+uint32_t ref_compare(void);
+
+#endif /* __ST77XX_REF_H */
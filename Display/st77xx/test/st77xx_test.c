@@ -0,0 +1,350 @@
+/**
+ * @file    st77xx_test.c
+ * @brief   像素数据发送的主机测试, 屏幕由 st77xx_mock.c 模拟
+ *
+ * 在 `Display/st77xx` 下编译运行, 使用与不使用 DMA 各一次:
+ *
+ *   for d in 0 1; do \
+ *       gcc -std=gnu11 -g -O1 -fsanitize=address,undefined -Itest/stub \
+ *           -Itest -I. -DST77xx_USE_DMA=$d test/st77xx_test.c \
+ *           test/st77xx_mock.c test/st77xx_ref.c st77xx.c \
+ *           -o st77xx_test && ./st77xx_test; \
+ *   done
+ *
+ * 检查项:
+ *  - SPI 配置了 TX DMA, 没有配置 TX DMA (`hdmatx` 为 NULL), DMA 每 3 次
+ *    启动失败一次时, 随机绘制矩形, 直线, 字符串, 图片和渲染区域后,
+ *    屏幕与逐像素的参考绘制相同
+ *  - 没有配置 TX DMA 时不调用 `HAL_SPI_Transmit_DMA`, 启动失败的数据
+ *    改为阻塞发送, 不丢失
+ *  - DMA 传输完成前不再发起传输, 不改变 DC 电平, 不修改正在发送的缓冲区
+ *    (屏幕模型在传输完成时才读取数据)
+ *  - 全屏填充, 字符串, 直线和渲染区域的命令数, 窗口数和像素字节数
+ *
+ * 最后给出各绘制函数的命令数和总线字节数, 以及 40 MHz SPI 上的传输时间.
+ */
+
+#include "st77xx.h"
+#include "st77xx_mock.h"
+#include "st77xx_ref.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+#define TEST_OPS     2000
+#define TEST_COMPARE 25
+/* 上电时显存的内容 */
+#define TEST_POWERON 0x5AA5
+/* SPI 时钟 (MHz) */
+#define TEST_SPI_MHZ 40
+
+static uint32_t test_rand_state = 1;
+
+static uint32_t test_rand(void) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return test_rand_state >> 8;
+}
+
+static uint16_t test_rand_range(uint16_t lo, uint16_t hi) {
+    return (uint16_t)(lo + test_rand() % (uint32_t)(hi - lo + 1));
+}
+
+static uint8_t test_image[2 * 48 * 48];
+/* 渲染区域中每条命令一个字符串, ST77xx_RenderEnd 时才读取 */
+static char test_str[8][40];
+
+static void test_set_dma(bool handle, uint32_t reject) {
+    static uint8_t dummy_dma;
+
+    spi1_handle.hdmatx = handle ? (DMA_HandleTypeDef *)&dummy_dma : NULL;
+    mock_dma_reject(reject);
+}
+
+/**
+ * @brief 初始化屏幕, 参考结果为初始化时填充的白色
+ */
+static void test_init(uint8_t dir, ic_type_t ic) {
+    mock_panel_reset(TEST_POWERON);
+    ST77xx_Init(dir, ic);
+    ref_reset(TEST_POWERON);
+    ref_rect(0, 0, lcd_dev.width, lcd_dev.height, ST77xx_WHITE);
+    CHECK(ref_compare() == 0);
+}
+
+static const FontDef *test_font(void) {
+    return (test_rand() % 2) ? &Font_7x10 : &Font_11x18;
+}
+
+static void test_rand_string(char *str) {
+    uint32_t len = 1 + test_rand() % 30;
+
+    for (uint32_t i = 0; i < len; ++i) {
+        str[i] = (char)test_rand_range(32, 126);
+    }
+    str[len] = '\0';
+}
+
+/**
+ * @brief 在渲染区域中随机记录一条绘制命令
+ */
+static void test_render_random(char *str) {
+    uint16_t color = (uint16_t)test_rand();
+    uint16_t x = test_rand_range(0, lcd_dev.width - 1);
+    uint16_t y = test_rand_range(0, lcd_dev.height - 1);
+
+    switch (test_rand() % 3) {
+        case 0: {
+            uint16_t w = test_rand_range(1, lcd_dev.width - x);
+            uint16_t h = test_rand_range(1, lcd_dev.height - y);
+
+            ST77xx_RenderRectangle(x, y, w, h, color);
+            ref_rect(x, y, w, h, color);
+            break;
+        }
+
+        case 1: {
+            uint16_t x1 = test_rand_range(0, lcd_dev.width - 1);
+            uint16_t y1 = test_rand_range(0, lcd_dev.height - 1);
+
+            ST77xx_RenderLine(x, y, x1, y1, color);
+            ref_line(x, y, x1, y1, color);
+            break;
+        }
+
+        default: {
+            const FontDef *font = test_font();
+            uint16_t bg = (uint16_t)test_rand();
+
+            test_rand_string(str);
+            ST77xx_RenderString(x, y, str, color, bg, font);
+            ref_string(x, y, str, color, bg, font);
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 随机绘制一次, 之后修改传入的缓冲区, 检查驱动返回后不再读取
+ */
+static void test_draw_random(void) {
+    uint16_t color = (uint16_t)test_rand();
+    uint16_t x = test_rand_range(0, lcd_dev.width - 1);
+    uint16_t y = test_rand_range(0, lcd_dev.height - 1);
+
+    switch (test_rand() % 16) {
+        case 0:
+        case 1:
+        case 2: {
+            /* 可能超出屏幕, 驱动不画 */
+            uint16_t w = test_rand_range(0, lcd_dev.width / 2);
+            uint16_t h = test_rand_range(0, lcd_dev.height / 2);
+
+            ST77xx_DrawRectangle(x, y, w, h, color);
+            if (x + w <= lcd_dev.width && y + h <= lcd_dev.height) {
+                ref_rect(x, y, w, h, color);
+            }
+            break;
+        }
+
+        case 3:
+        case 4:
+        case 5: {
+            uint16_t x1 = test_rand_range(0, lcd_dev.width - 1);
+            uint16_t y1 = test_rand_range(0, lcd_dev.height - 1);
+
+            if (test_rand() % 2) {
+                /* 水平或竖直线 */
+                (test_rand() % 2) ? (x1 = x) : (y1 = y);
+            }
+            ST77xx_DrawLine(x, y, x1, y1, color);
+            ref_line(x, y, x1, y1, color);
+            break;
+        }
+
+        case 6:
+        case 7:
+        case 8: {
+            const FontDef *font = test_font();
+            uint16_t bg = (uint16_t)test_rand();
+
+            test_rand_string(test_str[0]);
+            ST77xx_DrawString(x, y, test_str[0], color, bg, font);
+            ref_string(x, y, test_str[0], color, bg, font);
+            memset(test_str[0], '#', sizeof(test_str[0]));
+            break;
+        }
+
+        case 9:
+        case 10: {
+            uint16_t w = test_rand_range(1, 48);
+            uint16_t h = test_rand_range(1, 48);
+
+            x = x + w > lcd_dev.width ? lcd_dev.width - w : x;
+            y = y + h > lcd_dev.height ? lcd_dev.height - h : y;
+            for (uint32_t i = 0; i < sizeof(test_image); ++i) {
+                test_image[i] = (uint8_t)test_rand();
+            }
+            ST77xx_DrawImage(x, y, w, h, test_image);
+            ref_image(x, y, w, h, test_image);
+            memset(test_image, 0, sizeof(test_image));
+            break;
+        }
+
+        case 11:
+        case 12:
+        case 13:
+        case 14: {
+            uint16_t w = test_rand_range(1, lcd_dev.width - x);
+            uint16_t h = test_rand_range(1, lcd_dev.height - y);
+            uint16_t bg = (uint16_t)test_rand();
+            uint32_t n = test_rand() % 8;
+
+            ST77xx_RenderBegin(x, y, w, h, bg);
+            ref_clip(x, y, w, h);
+            ref_rect(x, y, w, h, bg);
+            for (uint32_t i = 0; i < n; ++i) {
+                test_render_random(test_str[i]);
+            }
+            ST77xx_RenderEnd();
+            ref_clip_screen();
+            memset(test_str, '#', sizeof(test_str));
+            break;
+        }
+
+        default:
+            ST77xx_FillScreen(color);
+            ref_rect(0, 0, lcd_dev.width, lcd_dev.height, color);
+            break;
+    }
+}
+
+static void test_random(void) {
+    static const struct {
+        const char *name;
+        bool handle;
+        uint32_t reject;
+    } modes[] = {
+        {"tx dma", true, 0},
+        {"no tx dma", false, 0},
+        {"dma rejected 1/3", true, 3},
+    };
+
+    for (uint32_t m = 0; m < sizeof(modes) / sizeof(modes[0]); ++m) {
+        uint32_t blocking = 0, dma = 0, rejected = 0;
+
+        for (uint8_t dir = 0; dir < 4; ++dir) {
+            test_set_dma(modes[m].handle, modes[m].reject);
+            test_init(dir, (dir % 2) ? ST7735 : ST7789);
+
+            for (uint32_t op = 1; op <= TEST_OPS / 4; ++op) {
+                test_draw_random();
+                if (op % TEST_COMPARE == 0) {
+                    ST77xx_Flush();
+                    CHECK(ref_compare() == 0);
+                }
+            }
+            ST77xx_Flush();
+            CHECK(ref_compare() == 0);
+            CHECK(mock_stats.errors == 0);
+            blocking += mock_stats.transfers;
+            dma += mock_stats.dma_transfers;
+            rejected += mock_stats.dma_rejected;
+        }
+
+#if ST77xx_USE_DMA
+        CHECK((dma > 0) == modes[m].handle);
+        CHECK((rejected > 0) == (modes[m].reject > 0));
+#else
+        CHECK(dma == 0 && rejected == 0);
+#endif /* ST77xx_USE_DMA */
+
+        printf("random, %-16s: %u ops, %u blocking / %u dma transfers, "
+               "%u dma rejected, panel matches\n",
+               modes[m].name, TEST_OPS, blocking, dma, rejected);
+    }
+}
+
+/*****************************************************************************
+ * 命令与字节数
+ */
+
+/**
+ * @brief 清空统计, 执行一次绘制后打印命令数和总线字节数
+ */
+#define TEST_COUNT(name, stmt)                                                 \
+    do {                                                                       \
+        memset(&mock_stats, 0, sizeof(mock_stats));                            \
+        stmt;                                                                  \
+        ST77xx_Flush();                                                        \
+        CHECK(mock_stats.errors == 0);                                         \
+        printf("count %-20s: %3u cmds, %2u windows, %6u pixel bytes, "         \
+               "%6u bus bytes, %3u/%3u spi/dma calls, %7.1f us\n",             \
+               name, mock_stats.commands, mock_stats.windows,                  \
+               mock_stats.pixel_bytes, mock_bus_bytes(),                       \
+               mock_stats.transfers, mock_stats.dma_transfers,                 \
+               mock_bus_bytes() * 8.0 / TEST_SPI_MHZ);                         \
+    } while (0)
+
+static void test_hud(void) {
+    ST77xx_RenderBegin(0, 0, 240, 40, ST77xx_BLACK);
+    ST77xx_RenderRectangle(0, 38, 240, 2, ST77xx_BLUE);
+    ST77xx_RenderString(4, 4, "SPEED 1234", ST77xx_WHITE, ST77xx_BLACK,
+                        &Font_11x18);
+    ST77xx_RenderString(140, 8, "T 42C", ST77xx_YELLOW, ST77xx_BLACK,
+                        &Font_7x10);
+    ST77xx_RenderLine(0, 24, 239, 24, ST77xx_RED);
+    ST77xx_RenderEnd();
+}
+
+static void test_count(void) {
+    uint32_t screen;
+
+    test_set_dma(true, 0);
+    test_init(0, ST7789);
+    screen = (uint32_t)lcd_dev.width * lcd_dev.height * 2;
+
+    TEST_COUNT("fill screen", ST77xx_FillScreen(ST77xx_BLUE));
+    /* 一个窗口: CASET, RASET, RAMWR */
+    CHECK(mock_stats.commands == 3 && mock_stats.windows == 1);
+    CHECK(mock_stats.pixel_bytes == screen);
+
+    TEST_COUNT("string 20 x 11x18",
+               ST77xx_DrawString(0, 100, "0123456789ABCDEFGHIJ",
+                                 ST77xx_WHITE, ST77xx_BLACK, &Font_11x18));
+    CHECK(mock_stats.windows == 1);
+    CHECK(mock_stats.pixel_bytes == 20 * 11 * 18 * 2);
+
+    TEST_COUNT("horizontal line",
+               ST77xx_DrawLine(0, 200, 239, 200, ST77xx_RED));
+    /* 取点方式与原来的逐点画线相同, 不画终点 */
+    CHECK(mock_stats.windows == 1 && mock_stats.pixel_bytes == 239 * 2);
+
+    TEST_COUNT("diagonal line", ST77xx_DrawLine(0, 0, 239, 339, ST77xx_RED));
+
+    TEST_COUNT("rectangle 100x50",
+               ST77xx_DrawRectangle(10, 10, 100, 50, ST77xx_GREEN));
+    CHECK(mock_stats.windows == 1 && mock_stats.pixel_bytes == 100 * 50 * 2);
+
+    TEST_COUNT("render hud 240x40", test_hud());
+    CHECK(mock_stats.windows == 1 && mock_stats.pixel_bytes == 240 * 40 * 2);
+}
+
+int main(void) {
+    printf("ST77xx_USE_DMA: %d\n", ST77xx_USE_DMA);
+
+    test_random();
+    test_count();
+
+    printf("all passed\n");
+    return 0;
+}
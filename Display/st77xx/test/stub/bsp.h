@@ -0,0 +1,52 @@
+/**
+ * @file    bsp.h
+ * @brief   主机测试用的板级支持替身, 只包含 st77xx 用到的部分.
+ *          SPI 与 GPIO 由 `test/st77xx_mock.c` 中的屏幕模型实现.
+ */
+
+#ifndef __BSP_H
+#define __BSP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+    HAL_OK = 0x00U,
+    HAL_ERROR = 0x01U,
+    HAL_BUSY = 0x02U,
+    HAL_TIMEOUT = 0x03U
+} HAL_StatusTypeDef;
+
+typedef enum {
+    HAL_SPI_STATE_RESET = 0x00U,
+    HAL_SPI_STATE_READY = 0x01U,
+    HAL_SPI_STATE_BUSY = 0x02U,
+    HAL_SPI_STATE_BUSY_TX = 0x03U,
+    HAL_SPI_STATE_BUSY_RX = 0x04U,
+    HAL_SPI_STATE_BUSY_TX_RX = 0x05U,
+    HAL_SPI_STATE_ERROR = 0x06U,
+    HAL_SPI_STATE_ABORT = 0x07U
+} HAL_SPI_StateTypeDef;
+
+#define HAL_MAX_DELAY 0xFFFFFFFFU
+
+typedef struct DMA_HandleTypeDef DMA_HandleTypeDef;
+
+typedef struct {
+    DMA_HandleTypeDef *hdmatx;
+    volatile HAL_SPI_StateTypeDef State;
+} SPI_HandleTypeDef;
+
+extern SPI_HandleTypeDef spi1_handle;
+
+#define __HAL_RCC_GPIOE_CLK_ENABLE()                                           \
+    do {                                                                       \
+    } while (0)
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData,
+                                   uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *pData,
+                                       uint16_t Size);
+HAL_SPI_StateTypeDef HAL_SPI_GetState(SPI_HandleTypeDef *hspi);
+
+#endif /* __BSP_H */
@@ -0,0 +1,47 @@
+/**
+ * @file    stm32g4xx_ll_gpio.h
+ * @brief   主机测试用的 LL GPIO 替身, 引脚电平由 `test/st77xx_mock.c` 记录.
+ */
+
+#ifndef __STM32G4xx_LL_GPIO_H
+#define __STM32G4xx_LL_GPIO_H
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef enum {
+    SUCCESS = 0U,
+    ERROR = !SUCCESS
+} ErrorStatus;
+
+typedef struct {
+    uint32_t Pin;
+    uint32_t Mode;
+    uint32_t Speed;
+    uint32_t OutputType;
+    uint32_t Pull;
+    uint32_t Alternate;
+} LL_GPIO_InitTypeDef;
+
+extern GPIO_TypeDef stub_gpioe;
+#define GPIOE (&stub_gpioe)
+
+#define LL_GPIO_PIN_0                0x00000001U
+#define LL_GPIO_PIN_1                0x00000002U
+#define LL_GPIO_PIN_2                0x00000004U
+#define LL_GPIO_PIN_3                0x00000008U
+
+#define LL_GPIO_MODE_OUTPUT          0x00000001U
+#define LL_GPIO_SPEED_FREQ_VERY_HIGH 0x00000003U
+#define LL_GPIO_OUTPUT_PUSHPULL      0x00000000U
+#define LL_GPIO_PULL_UP              0x00000001U
+
+ErrorStatus LL_GPIO_Init(GPIO_TypeDef *GPIOx,
+                         LL_GPIO_InitTypeDef *GPIO_InitStruct);
+void LL_GPIO_SetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask);
+void LL_GPIO_ResetOutputPin(GPIO_TypeDef *GPIOx, uint32_t PinMask);
+
+#endif /* __STM32G4xx_LL_GPIO_H */
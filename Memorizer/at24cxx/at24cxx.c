@@ -2,7 +2,7 @@
  * @file    at24cxx.c
  * @author  Deadline039
  * @brief   AT24Cxx 系列芯片驱动
- * @version 1.1
+ * @version 1.2
  * @date    2024-09-03
  *****************************************************************************
  * A0 A1 A2 引脚电平, 用于定义地址.
@@ -21,78 +21,184 @@
  * Date         Version     Author      Notes
  * 2024-09-03   1.0         Deadline039 第一次发布
  * 2025-01-26   1.1         Deadline039 支持多设备
+ * 2026-10-16   1.2         agent       按页写入, 按块连续读取, 写周期超时,
+ *                                      DMA/中断异步传输
  */
 
 #include "at24cxx.h"
 
 #include <string.h>
 
+#if AT24CXX_USE_DMA
+static at24cxx_handle_t *at24cxx_dma_list[AT24CXX_DMA_MAX_DEVICE];
+#endif /* AT24CXX_USE_DMA */
+
 /**
- * @brief AT24CXX I2C 读取一字节
+ * @brief 获取型号的页大小
+ *
+ * @param model 型号
+ * @return 页大小 (byte)
+ */
+static uint8_t at24cxx_get_page_size(at24cxx_model_t model) {
+    switch (model) {
+        case AT24C01:
+        case AT24C02:
+            return 8;
+
+        case AT24C04:
+        case AT24C08:
+        case AT24C16:
+            return 16;
+
+        case AT24C32:
+        case AT24C64:
+            return 32;
+
+        default:
+            return 64;
+    }
+}
+
+/**
+ * @brief 计算 I2C 器件地址和片内地址
+ *
+ * @param at24cxx 句柄
+ * @param addr 存储地址
+ * @param[out] dev_address 器件地址
+ * @param[out] mem_address 片内地址
+ * @param[out] address_size 片内地址长度
+ * @return 从该地址开始一次传输最多可以访问的长度
+ * @note AT24C16 及以下型号的高位地址在器件地址中, 每 256 字节是一个块,
+ *       连续读写不能跨块.
+ */
+static uint32_t at24cxx_get_address(at24cxx_handle_t *at24cxx, uint16_t addr,
+                                    uint16_t *dev_address,
+                                    uint16_t *mem_address,
+                                    uint16_t *address_size) {
+    if (at24cxx->model > (uint16_t)AT24C16) {
+        *dev_address = at24cxx->address;
+        *mem_address = addr;
+        *address_size = I2C_MEMADD_SIZE_16BIT;
+        return (uint32_t)at24cxx->model + 1 - addr;
+    }
+
+    *dev_address = at24cxx->address + ((addr / 256) << 1);
+    *mem_address = addr % 256;
+    *address_size = I2C_MEMADD_SIZE_8BIT;
+    return 256 - addr % 256;
+}
+
+/**
+ * @brief 计算一次页写入的长度
+ *
+ * @param at24cxx 句柄
+ * @param addr 写入地址
+ * @param len 剩余长度
+ * @return 不越过页边界的长度
+ */
+static inline uint16_t at24cxx_page_chunk(at24cxx_handle_t *at24cxx,
+                                          uint16_t addr, uint16_t len) {
+    uint16_t chunk = at24cxx->page_size - addr % at24cxx->page_size;
+    return (len < chunk) ? len : chunk;
+}
+
+/**
+ * @brief 应答查询, 等待写周期结束
+ *
+ * @param at24cxx 句柄
+ * @param dev_address 器件地址
+ * @return 操作状态
+ * @note 写周期内芯片不应答器件地址, 应答后即可进行下一次操作.
+ */
+static at24cxx_result_t at24cxx_wait_ready(at24cxx_handle_t *at24cxx,
+                                           uint16_t dev_address) {
+    uint32_t start_tick = HAL_GetTick();
+
+    while (HAL_I2C_IsDeviceReady(at24cxx->hi2c, dev_address, 1, 1) != HAL_OK) {
+        if (HAL_GetTick() - start_tick > AT24CXX_WRITE_TIMEOUT) {
+            return AT24CXX_ERROR;
+        }
+    }
+
+    return AT24CXX_OK;
+}
+
+/**
+ * @brief AT24CXX I2C 连续读取
  *
  * @param at24cxx 句柄
  * @param addr 地址
- * @return 读到的字节
+ * @param[out] buf 缓冲区
+ * @param len 读取长度
+ * @return 操作状态
+ * @note 每个块只需要一次传输.
  */
-static uint8_t at24cxx_i2c_read_byte(at24cxx_handle_t *at24cxx, uint16_t addr) {
+static at24cxx_result_t at24cxx_i2c_read(at24cxx_handle_t *at24cxx,
+                                         uint16_t addr, uint8_t *buf,
+                                         uint16_t len) {
     uint16_t dev_address;
     uint16_t mem_address;
     uint16_t address_size;
-    uint8_t byte;
+    uint32_t chunk;
 
-    if (at24cxx->model > (uint16_t)AT24C16) {
-        dev_address = at24cxx->address + ((addr / 65536) << 1);
-        mem_address = addr % 65536;
-        address_size = I2C_MEMADD_SIZE_16BIT;
-    } else {
-        dev_address = at24cxx->address + ((addr / 256) << 1);
-        mem_address = addr % 256;
-        address_size = I2C_MEMADD_SIZE_8BIT;
-    }
+    while (len > 0) {
+        chunk = at24cxx_get_address(at24cxx, addr, &dev_address, &mem_address,
+                                    &address_size);
+        if (chunk > len) {
+            chunk = len;
+        }
 
-    HAL_I2C_Mem_Read(at24cxx->hi2c, dev_address, mem_address, address_size,
-                     &byte, 1, 1000);
+        if (HAL_I2C_Mem_Read(at24cxx->hi2c, dev_address, mem_address,
+                             address_size, buf, (uint16_t)chunk,
+                             1000) != HAL_OK) {
+            return AT24CXX_ERROR;
+        }
 
-    return byte;
+        addr += chunk;
+        buf += chunk;
+        len -= chunk;
+    }
+
+    return AT24CXX_OK;
 }
 
 /**
- * @brief AT24CXX I2C 写入一字节
+ * @brief AT24CXX I2C 页写入
  *
  * @param at24cxx 句柄
  * @param addr 地址
- * @param byte 要写入的字节
+ * @param buf 要写入的数据
+ * @param len 写入长度
  * @return 操作状态
+ * @note 按页拆分, 每页一次传输, 之后应答查询等待写周期结束.
  */
-static at24cxx_result_t at24cxx_i2c_write_byte(at24cxx_handle_t *at24cxx,
-                                               uint16_t addr,
-                                               const uint8_t byte) {
+static at24cxx_result_t at24cxx_i2c_write(at24cxx_handle_t *at24cxx,
+                                          uint16_t addr, const uint8_t *buf,
+                                          uint16_t len) {
     uint16_t dev_address;
     uint16_t mem_address;
     uint16_t address_size;
+    uint16_t chunk;
 
-    if (at24cxx->model > (uint16_t)AT24C16) {
-        dev_address = at24cxx->address + ((addr / 65536) << 1);
-        mem_address = addr % 65536;
-        address_size = I2C_MEMADD_SIZE_16BIT;
-    } else {
-        dev_address = at24cxx->address + ((addr / 256) << 1);
-        mem_address = addr % 256;
-        address_size = I2C_MEMADD_SIZE_8BIT;
-    }
+    while (len > 0) {
+        chunk = at24cxx_page_chunk(at24cxx, addr, len);
+        at24cxx_get_address(at24cxx, addr, &dev_address, &mem_address,
+                            &address_size);
 
-    if (HAL_I2C_Mem_Write(at24cxx->hi2c, dev_address, mem_address, address_size,
-                          (uint8_t *)&byte, 1, 1000) != HAL_OK) {
-        return AT24CXX_ERROR;
-    }
+        if (HAL_I2C_Mem_Write(at24cxx->hi2c, dev_address, mem_address,
+                              address_size, (uint8_t *)buf, chunk,
+                              1000) != HAL_OK) {
+            return AT24CXX_ERROR;
+        }
 
-    /* Wait for the end of the transfer */
-    while (HAL_I2C_GetState(at24cxx->hi2c) != HAL_I2C_STATE_READY)
-        ;
-    /* Check if the Devices is ready for a new operation */
-    while (HAL_I2C_IsDeviceReady(at24cxx->hi2c, dev_address, 0xF, 0xF) !=
-           HAL_OK)
-        ;
+        if (at24cxx_wait_ready(at24cxx, dev_address) != AT24CXX_OK) {
+            return AT24CXX_ERROR;
+        }
+
+        addr += chunk;
+        buf += chunk;
+        len -= chunk;
+    }
 
     return AT24CXX_OK;
 }
@@ -121,6 +227,27 @@ at24cxx_result_t at24cxx_init(at24cxx_handle_t *at24cxx,
     at24cxx->model = model;
     at24cxx->address = 0xA0;
     at24cxx->address |= address << 1;
+    if (model <= AT24C16) {
+        /* 高位地址 a8 ~ a10 占用的引脚位无效, 清零以免与块地址相加时进位 */
+        at24cxx->address &= (uint8_t)~(((uint16_t)model >> 8) << 1);
+    }
+    at24cxx->page_size = at24cxx_get_page_size(model);
+
+#if AT24CXX_USE_DMA
+    at24cxx->state = AT24CXX_IDLE;
+    at24cxx->callback = NULL;
+
+    for (uint32_t i = 0; i < AT24CXX_DMA_MAX_DEVICE; ++i) {
+        if (at24cxx_dma_list[i] == at24cxx) {
+            break;
+        }
+
+        if (at24cxx_dma_list[i] == NULL) {
+            at24cxx_dma_list[i] = at24cxx;
+            break;
+        }
+    }
+#endif /* AT24CXX_USE_DMA */
 
     return AT24CXX_OK;
 }
@@ -136,6 +263,14 @@ at24cxx_result_t at24cxx_deinit(at24cxx_handle_t *at24cxx) {
         return AT24CXX_ERROR;
     }
 
+#if AT24CXX_USE_DMA
+    for (uint32_t i = 0; i < AT24CXX_DMA_MAX_DEVICE; ++i) {
+        if (at24cxx_dma_list[i] == at24cxx) {
+            at24cxx_dma_list[i] = NULL;
+        }
+    }
+#endif /* AT24CXX_USE_DMA */
+
     memset(at24cxx, 0, sizeof(at24cxx_handle_t));
 
     return AT24CXX_OK;
@@ -149,11 +284,14 @@ at24cxx_result_t at24cxx_deinit(at24cxx_handle_t *at24cxx) {
  * @return 读到的字节
  */
 uint8_t at24cxx_read_byte(at24cxx_handle_t *at24cxx, uint16_t address) {
+    uint8_t byte = 0;
+
     if (at24cxx == NULL) {
         return 0;
     }
 
-    return at24cxx_i2c_read_byte(at24cxx, address);
+    at24cxx_i2c_read(at24cxx, address, &byte, 1);
+    return byte;
 }
 
 /**
@@ -170,7 +308,7 @@ at24cxx_result_t at24cxx_write_byte(at24cxx_handle_t *at24cxx, uint16_t address,
         return AT24CXX_ERROR;
     }
 
-    return at24cxx_i2c_write_byte(at24cxx, address, byte);
+    return at24cxx_i2c_write(at24cxx, address, &byte, 1);
 }
 
 /**
@@ -192,11 +330,7 @@ at24cxx_result_t at24cxx_read(at24cxx_handle_t *at24cxx, uint16_t address,
         return AT24CXX_ERROR;
     }
 
-    for (uint32_t i = 0; i < data_len; ++i) {
-        data_buf[i] = at24cxx_i2c_read_byte(at24cxx, address + i);
-    }
-
-    return AT24CXX_OK;
+    return at24cxx_i2c_read(at24cxx, address, data_buf, data_len);
 }
 
 /**
@@ -207,6 +341,7 @@ at24cxx_result_t at24cxx_read(at24cxx_handle_t *at24cxx, uint16_t address,
  * @param data_buf 数据缓冲区
  * @param data_len 要写入的长度
  * @return 是否写入成功
+ * @note 按页写入, 每页等待一个写周期 (最大 5 ms).
  */
 at24cxx_result_t at24cxx_write(at24cxx_handle_t *at24cxx, uint16_t address,
                                const uint8_t *data_buf, uint16_t data_len) {
@@ -218,11 +353,283 @@ at24cxx_result_t at24cxx_write(at24cxx_handle_t *at24cxx, uint16_t address,
         return AT24CXX_ERROR;
     }
 
-    for (uint32_t i = 0; i < data_len; ++i) {
-        if (at24cxx_i2c_write_byte(at24cxx, address + i, data_buf[i]) !=
-            AT24CXX_OK) {
-            return AT24CXX_ERROR;
-        }
+    return at24cxx_i2c_write(at24cxx, address, data_buf, data_len);
+}
+
+#if AT24CXX_USE_DMA
+
+/**
+ * @brief 结束异步传输
+ *
+ * @param at24cxx 句柄
+ * @param result 传输结果
+ */
+static void at24cxx_async_finish(at24cxx_handle_t *at24cxx,
+                                 at24cxx_result_t result) {
+    at24cxx->state = AT24CXX_IDLE;
+
+    if (at24cxx->callback != NULL) {
+        at24cxx->callback(at24cxx, result);
+    }
+}
+
+/**
+ * @brief 发起下一段异步读取
+ *
+ * @param at24cxx 句柄
+ * @return 操作状态
+ * @note I2C 配置了 DMA 时使用 DMA, 否则使用中断.
+ */
+static at24cxx_result_t at24cxx_async_read_next(at24cxx_handle_t *at24cxx) {
+    uint16_t dev_address;
+    uint16_t mem_address;
+    uint16_t address_size;
+    uint32_t chunk;
+    HAL_StatusTypeDef res;
+
+    chunk = at24cxx_get_address(at24cxx, at24cxx->mem_address, &dev_address,
+                                &mem_address, &address_size);
+    if (chunk > at24cxx->remain) {
+        chunk = at24cxx->remain;
+    }
+    at24cxx->chunk = (uint16_t)chunk;
+
+    if (at24cxx->hi2c->hdmarx != NULL) {
+        res = HAL_I2C_Mem_Read_DMA(at24cxx->hi2c, dev_address, mem_address,
+                                   address_size, at24cxx->buf, at24cxx->chunk);
+    } else {
+        res = HAL_I2C_Mem_Read_IT(at24cxx->hi2c, dev_address, mem_address,
+                                  address_size, at24cxx->buf, at24cxx->chunk);
+    }
+
+    return (res == HAL_OK) ? AT24CXX_OK : AT24CXX_ERROR;
+}
+
+/**
+ * @brief 发起下一页异步写入
+ *
+ * @param at24cxx 句柄
+ * @return 操作状态
+ */
+static at24cxx_result_t at24cxx_async_write_next(at24cxx_handle_t *at24cxx) {
+    uint16_t dev_address;
+    uint16_t mem_address;
+    uint16_t address_size;
+    HAL_StatusTypeDef res;
+
+    at24cxx->chunk =
+        at24cxx_page_chunk(at24cxx, at24cxx->mem_address, at24cxx->remain);
+    at24cxx_get_address(at24cxx, at24cxx->mem_address, &dev_address,
+                        &mem_address, &address_size);
+
+    at24cxx->state = AT24CXX_WRITING;
+    if (at24cxx->hi2c->hdmatx != NULL) {
+        res = HAL_I2C_Mem_Write_DMA(at24cxx->hi2c, dev_address, mem_address,
+                                    address_size, at24cxx->buf,
+                                    at24cxx->chunk);
+    } else {
+        res = HAL_I2C_Mem_Write_IT(at24cxx->hi2c, dev_address, mem_address,
+                                   address_size, at24cxx->buf, at24cxx->chunk);
     }
+
+    return (res == HAL_OK) ? AT24CXX_OK : AT24CXX_ERROR;
+}
+
+/**
+ * @brief AT24CXX 异步读取数据
+ *
+ * @param at24cxx 句柄
+ * @param address 地址
+ * @param[out] data_buf 数据缓冲区, 完成之前不能修改
+ * @param data_len 要读取的长度
+ * @param callback 完成回调, 可以为 NULL
+ * @return 是否成功发起读取
+ */
+at24cxx_result_t at24cxx_read_dma(at24cxx_handle_t *at24cxx, uint16_t address,
+                                  uint8_t *data_buf, uint16_t data_len,
+                                  at24cxx_callback_t callback) {
+    if (at24cxx == NULL || data_buf == NULL || data_len == 0) {
+        return AT24CXX_ERROR;
+    }
+
+    if (at24cxx->state != AT24CXX_IDLE) {
+        return AT24CXX_ERROR;
+    }
+
+    at24cxx->buf = data_buf;
+    at24cxx->mem_address = address;
+    at24cxx->remain = data_len;
+    at24cxx->callback = callback;
+    at24cxx->state = AT24CXX_READING;
+
+    if (at24cxx_async_read_next(at24cxx) != AT24CXX_OK) {
+        at24cxx->state = AT24CXX_IDLE;
+        return AT24CXX_ERROR;
+    }
+
     return AT24CXX_OK;
 }
+
+/**
+ * @brief AT24CXX 异步写入数据
+ *
+ * @param at24cxx 句柄
+ * @param address 地址
+ * @param data_buf 数据缓冲区, 完成之前不能修改
+ * @param data_len 要写入的长度
+ * @param callback 完成回调, 可以为 NULL
+ * @return 是否成功发起写入
+ * @note 每页发送完成后需要周期调用 `at24cxx_poll` 查询写周期是否结束.
+ */
+at24cxx_result_t at24cxx_write_dma(at24cxx_handle_t *at24cxx, uint16_t address,
+                                   const uint8_t *data_buf, uint16_t data_len,
+                                   at24cxx_callback_t callback) {
+    if (at24cxx == NULL || data_buf == NULL || data_len == 0) {
+        return AT24CXX_ERROR;
+    }
+
+    if (at24cxx->state != AT24CXX_IDLE) {
+        return AT24CXX_ERROR;
+    }
+
+    at24cxx->buf = (uint8_t *)data_buf;
+    at24cxx->mem_address = address;
+    at24cxx->remain = data_len;
+    at24cxx->callback = callback;
+
+    if (at24cxx_async_write_next(at24cxx) != AT24CXX_OK) {
+        at24cxx->state = AT24CXX_IDLE;
+        return AT24CXX_ERROR;
+    }
+
+    return AT24CXX_OK;
+}
+
+/**
+ * @brief 异步传输是否正在进行
+ *
+ * @param at24cxx 句柄
+ * @return 是否正在进行
+ */
+bool at24cxx_is_busy(at24cxx_handle_t *at24cxx) {
+    if (at24cxx == NULL) {
+        return false;
+    }
+
+    return at24cxx->state != AT24CXX_IDLE;
+}
+
+/**
+ * @brief 推进异步写入
+ *
+ * @param at24cxx 句柄
+ * @note 在定时器或任务中周期调用 (例如 1 ms). 写周期内每次只做一次应答查询,
+ *       芯片应答后发送下一页, 全部写完后调用回调.
+ */
+void at24cxx_poll(at24cxx_handle_t *at24cxx) {
+    uint16_t dev_address;
+    uint16_t mem_address;
+    uint16_t address_size;
+
+    if (at24cxx == NULL || at24cxx->state != AT24CXX_WRITE_WAIT) {
+        return;
+    }
+
+    at24cxx_get_address(at24cxx, at24cxx->mem_address - at24cxx->chunk,
+                        &dev_address, &mem_address, &address_size);
+    if (HAL_I2C_IsDeviceReady(at24cxx->hi2c, dev_address, 1, 1) != HAL_OK) {
+        if (HAL_GetTick() - at24cxx->start_tick > AT24CXX_WRITE_TIMEOUT) {
+            at24cxx_async_finish(at24cxx, AT24CXX_ERROR);
+        }
+        return;
+    }
+
+    if (at24cxx->remain == 0) {
+        at24cxx_async_finish(at24cxx, AT24CXX_OK);
+        return;
+    }
+
+    if (at24cxx_async_write_next(at24cxx) != AT24CXX_OK) {
+        at24cxx_async_finish(at24cxx, AT24CXX_ERROR);
+    }
+}
+
+/**
+ * @brief 查找 I2C 上正在进行异步传输的芯片
+ *
+ * @param hi2c I2C 句柄
+ * @param state 传输状态
+ * @return 芯片句柄, 没有时返回 NULL
+ */
+static at24cxx_handle_t *at24cxx_dma_find(I2C_HandleTypeDef *hi2c,
+                                          at24cxx_state_t state) {
+    for (uint32_t i = 0; i < AT24CXX_DMA_MAX_DEVICE; ++i) {
+        if (at24cxx_dma_list[i] != NULL && at24cxx_dma_list[i]->hi2c == hi2c &&
+            at24cxx_dma_list[i]->state == state) {
+            return at24cxx_dma_list[i];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief I2C 发送完成, 一页数据已经发出, 开始写周期
+ *
+ * @param hi2c I2C 句柄
+ */
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    at24cxx_handle_t *at24cxx = at24cxx_dma_find(hi2c, AT24CXX_WRITING);
+
+    if (at24cxx == NULL) {
+        return;
+    }
+
+    at24cxx->buf += at24cxx->chunk;
+    at24cxx->mem_address += at24cxx->chunk;
+    at24cxx->remain -= at24cxx->chunk;
+    at24cxx->start_tick = HAL_GetTick();
+    at24cxx->state = AT24CXX_WRITE_WAIT;
+}
+
+/**
+ * @brief I2C 接收完成, 读取下一块或者结束
+ *
+ * @param hi2c I2C 句柄
+ */
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c) {
+    at24cxx_handle_t *at24cxx = at24cxx_dma_find(hi2c, AT24CXX_READING);
+
+    if (at24cxx == NULL) {
+        return;
+    }
+
+    at24cxx->buf += at24cxx->chunk;
+    at24cxx->mem_address += at24cxx->chunk;
+    at24cxx->remain -= at24cxx->chunk;
+
+    if (at24cxx->remain == 0) {
+        at24cxx_async_finish(at24cxx, AT24CXX_OK);
+    } else if (at24cxx_async_read_next(at24cxx) != AT24CXX_OK) {
+        at24cxx_async_finish(at24cxx, AT24CXX_ERROR);
+    }
+}
+
+/**
+ * @brief I2C 传输出错
+ *
+ * @param hi2c I2C 句柄
+ */
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c) {
+    at24cxx_handle_t *at24cxx = at24cxx_dma_find(hi2c, AT24CXX_READING);
+
+    if (at24cxx == NULL) {
+        at24cxx = at24cxx_dma_find(hi2c, AT24CXX_WRITING);
+    }
+
+    if (at24cxx != NULL) {
+        at24cxx_async_finish(at24cxx, AT24CXX_ERROR);
+    }
+}
+
+#endif /* AT24CXX_USE_DMA */
@@ -2,7 +2,7 @@
  * @file    at24cxx.h
  * @author  Deadline039
  * @brief   AT24Cxx 系列芯片驱动
- * @version 1.1
+ * @version 1.2
  * @date    2024-09-03
  *****************************************************************************
  * A0 A1 A2 引脚电平, 用于定义地址.
@@ -21,6 +21,8 @@
  * Date         Version     Author      Notes
  * 2024-09-03   1.0         Deadline039 第一次发布
  * 2025-01-26   1.1         Deadline039 支持多设备
+ * 2026-10-16   1.2         agent       按页写入, 按块连续读取, 写周期超时,
+ *                                      DMA/中断异步传输
  */
 
 #ifndef __AT24CXX_H
@@ -28,6 +30,26 @@
 
 #include <CSP_Config.h>
 
+#include <stdbool.h>
+
+/* 写周期超时 (ms), 芯片手册写周期最大 5 ms */
+#define AT24CXX_WRITE_TIMEOUT    10
+
+/**
+ * 是否使用 DMA/中断 传输
+ * 打开后本文件实现 HAL_I2C_MemTxCpltCallback, HAL_I2C_MemRxCpltCallback 和
+ * HAL_I2C_ErrorCallback, 与其他使用这些回调的模块 (例如 OLED_RTOS)
+ * 一起使用时需要合并回调函数.
+ */
+#ifndef AT24CXX_USE_DMA
+#define AT24CXX_USE_DMA          0
+#endif /* AT24CXX_USE_DMA */
+
+#if AT24CXX_USE_DMA
+/* 同时进行异步传输的最大芯片数 */
+#define AT24CXX_DMA_MAX_DEVICE   2
+#endif /* AT24CXX_USE_DMA */
+
 /**
  * @brief AT24CXX 型号定义, 值为最大容量 (byte)
  */
@@ -65,13 +87,47 @@ typedef enum {
     AT24CXX_ERROR /*!< 操作出错 */
 } at24cxx_result_t;
 
+#if AT24CXX_USE_DMA
+
+/**
+ * @brief 异步传输状态
+ */
+typedef enum {
+    AT24CXX_IDLE,       /*!< 空闲 */
+    AT24CXX_READING,    /*!< 正在读取 */
+    AT24CXX_WRITING,    /*!< 正在发送一页数据 */
+    AT24CXX_WRITE_WAIT  /*!< 等待芯片写周期结束 */
+} at24cxx_state_t;
+
+struct at24cxx_handle_s;
+
+/**
+ * @brief 异步传输完成回调, 读完成时在中断中调用, 写完成时在
+ *        `at24cxx_poll` 的上下文中调用
+ */
+typedef void (*at24cxx_callback_t)(struct at24cxx_handle_s *at24cxx,
+                                   at24cxx_result_t result);
+
+#endif /* AT24CXX_USE_DMA */
+
 /**
  * @brief AT24CXX 句柄定义
  */
-typedef struct {
+typedef struct at24cxx_handle_s {
     I2C_HandleTypeDef *hi2c; /*!< I2C 句柄定义 */
     at24cxx_model_t model;   /*!< 型号 (值为容量) */
     uint8_t address;         /*!< I2C 器件地址 */
+    uint8_t page_size;       /*!< 页大小 (byte) */
+
+#if AT24CXX_USE_DMA
+    volatile at24cxx_state_t state; /*!< 异步传输状态 */
+    uint8_t *buf;                   /*!< 异步传输缓冲区 */
+    uint16_t mem_address;           /*!< 下一次传输的地址 */
+    uint16_t remain;                /*!< 剩余长度 */
+    uint16_t chunk;                 /*!< 当前传输长度 */
+    uint32_t start_tick;            /*!< 写周期开始的时刻 */
+    at24cxx_callback_t callback;    /*!< 完成回调 */
+#endif                              /* AT24CXX_USE_DMA */
 } at24cxx_handle_t;
 
 at24cxx_result_t at24cxx_init(at24cxx_handle_t *at24cxx,
@@ -88,4 +144,15 @@ at24cxx_result_t at24cxx_read(at24cxx_handle_t *at24cxx, uint16_t address,
 at24cxx_result_t at24cxx_write(at24cxx_handle_t *at24cxx, uint16_t address,
                                const uint8_t *data_buf, uint16_t data_len);
 
+#if AT24CXX_USE_DMA
+at24cxx_result_t at24cxx_read_dma(at24cxx_handle_t *at24cxx, uint16_t address,
+                                  uint8_t *data_buf, uint16_t data_len,
+                                  at24cxx_callback_t callback);
+at24cxx_result_t at24cxx_write_dma(at24cxx_handle_t *at24cxx, uint16_t address,
+                                   const uint8_t *data_buf, uint16_t data_len,
+                                   at24cxx_callback_t callback);
+bool at24cxx_is_busy(at24cxx_handle_t *at24cxx);
+void at24cxx_poll(at24cxx_handle_t *at24cxx);
+#endif /* AT24CXX_USE_DMA */
+
 #endif /* __AT24CXX_H */
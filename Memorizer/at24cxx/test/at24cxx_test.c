@@ -0,0 +1,687 @@
+/**
+ * @file    at24cxx_test.c
+ * @brief   at24cxx 主机测试, I2C 总线上接 EEPROM 模型
+ *
+ * 在 `Memorizer/at24cxx` 下编译运行, 分别测试关闭和打开异步传输:
+ *
+ *   for d in 0 1; do \
+ *       gcc -std=gnu11 -g -O1 -fsanitize=address,undefined -Itest/stub -I. \
+ *           -DAT24CXX_USE_DMA=$d test/at24cxx_test.c at24cxx.c \
+ *           -o at24cxx_test && ./at24cxx_test; done
+ *
+ * EEPROM 模型按芯片手册:
+ *  - 器件地址中 A2 A1 A0 引脚位与块地址位 a8 ~ a10 的划分随型号不同;
+ *  - 页写入超过页边界时回到页首 (roll-over), 覆盖本页开头的数据;
+ *  - 写周期 (5 ms) 内不应答器件地址;
+ *  - 连续读取在容量末尾回到 0.
+ * 总线按 400 kHz 计时, 每字节 (含应答) 22.5 us.
+ *
+ * 检查项:
+ *  - AT24C01 ~ AT24C256 每种型号随机写入和读取, 地址和长度跨页, 跨块,
+ *    读写结果与影子数组相同; 页写入没有发生 roll-over, 写周期内没有写入;
+ *    写入的传输次数等于涉及的页数, 读取的传输次数等于涉及的块数;
+ *    同一总线上引脚地址不同的另一片芯片内容不变
+ *  - 写周期一直不结束时写入在 `AT24CXX_WRITE_TIMEOUT` 后返回错误
+ *  - 打开异步传输时, DMA 和中断方式的读写结果同上, 完成回调只调用一次
+ *
+ * 最后给出 256 字节按页写入与逐字节写入的总线时间.
+ */
+
+#include "at24cxx.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+/* 400 kHz 下一个字节加应答的时间 (ns) */
+#define BUS_BYTE_NS   22500U
+/* 写周期 (ns) */
+#define EEPROM_TWR_NS 5000000U
+#define TEST_OPS      1500
+#define TEST_MAX_LEN  300
+
+/*****************************************************************************
+ * EEPROM 模型
+ */
+
+/**
+ * @brief 总线上的一片芯片
+ */
+typedef struct {
+    at24cxx_model_t model;
+    uint8_t pins;            /*!< A2 A1 A0 引脚电平 */
+    uint8_t page_size;
+    uint8_t mem[AT24C256 + 1];
+    uint64_t busy_until;     /*!< 写周期结束的时刻 (ns) */
+    uint32_t twr_ns;         /*!< 写周期 */
+} eeprom_t;
+
+/**
+ * @brief 统计信息
+ */
+typedef struct {
+    uint32_t writes;      /*!< 写入的传输次数 */
+    uint32_t reads;       /*!< 读取的传输次数 */
+    uint32_t probes;      /*!< 应答查询次数 */
+    uint32_t rollover;    /*!< 超过页边界的页写入 */
+    uint32_t nack_write;  /*!< 写周期内的写入 */
+    uint32_t bad_address; /*!< 地址长度错误, 超出容量或没有芯片应答 */
+    uint32_t bus_busy;    /*!< 异步传输进行中又发起传输 */
+} eeprom_stats_t;
+
+/**
+ * @brief 进行中的异步传输
+ */
+typedef struct {
+    bool active;
+    bool write;
+    uint16_t dev_address;
+    uint16_t mem_address;
+    uint16_t address_size;
+    uint8_t *data;
+    uint16_t len;
+    uint64_t done_at;
+} bus_pending_t;
+
+static eeprom_t eeprom[2];
+static uint32_t eeprom_num;
+static eeprom_stats_t eeprom_stats;
+static uint64_t bus_now;
+static bus_pending_t bus_pending;
+static uint32_t bus_dma_used, bus_it_used;
+
+uint32_t HAL_GetTick(void) {
+    return (uint32_t)(bus_now / 1000000U);
+}
+
+/**
+ * @brief 器件地址中作为引脚地址的位
+ */
+static uint8_t eeprom_pin_mask(at24cxx_model_t model) {
+    switch (model) {
+        case AT24C04:
+            return 0x6;
+        case AT24C08:
+            return 0x4;
+        case AT24C16:
+            return 0x0;
+        default:
+            return 0x7;
+    }
+}
+
+/**
+ * @brief 按器件地址查找应答的芯片
+ *
+ * @param[out] base 器件地址中块地址位给出的高位地址
+ */
+static eeprom_t *eeprom_find(uint16_t dev_address, uint32_t *base) {
+    uint8_t sel = (dev_address >> 1) & 0x7;
+
+    if ((dev_address & 0xF1) != 0xA0) {
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < eeprom_num; ++i) {
+        eeprom_t *chip = &eeprom[i];
+        uint8_t mask = eeprom_pin_mask(chip->model);
+
+        if ((sel & mask) != (chip->pins & mask)) {
+            continue;
+        }
+        *base = (chip->model <= AT24C16) ? (uint32_t)(sel & ~mask) << 8 : 0;
+        return chip;
+    }
+
+    return NULL;
+}
+
+static bool eeprom_busy(const eeprom_t *chip) {
+    return bus_now < chip->busy_until;
+}
+
+/**
+ * @brief 检查片内地址, 返回完整地址
+ */
+static uint32_t eeprom_address(const eeprom_t *chip, uint32_t base,
+                               uint16_t mem_address, uint16_t address_size) {
+    uint32_t expect_size = (chip->model > AT24C16) ? I2C_MEMADD_SIZE_16BIT
+                                                   : I2C_MEMADD_SIZE_8BIT;
+    uint32_t address = base + mem_address;
+
+    if (address_size != expect_size || address > (uint32_t)chip->model) {
+        eeprom_stats.bad_address++;
+    }
+    return address & chip->model;
+}
+
+static uint32_t eeprom_address_bytes(uint16_t address_size) {
+    return (address_size == I2C_MEMADD_SIZE_16BIT) ? 2 : 1;
+}
+
+/**
+ * @brief 页写入, 超过页边界时回到页首
+ */
+static HAL_StatusTypeDef eeprom_write(uint16_t dev_address,
+                                      uint16_t mem_address,
+                                      uint16_t address_size,
+                                      const uint8_t *data, uint16_t len) {
+    uint32_t base, address, page, offset;
+    eeprom_t *chip = eeprom_find(dev_address, &base);
+
+    if (chip == NULL) {
+        eeprom_stats.bad_address++;
+        return HAL_ERROR;
+    }
+    if (eeprom_busy(chip)) {
+        eeprom_stats.nack_write++;
+        return HAL_ERROR;
+    }
+
+    address = eeprom_address(chip, base, mem_address, address_size);
+    page = address - address % chip->page_size;
+    offset = address % chip->page_size;
+    if (offset + len > chip->page_size) {
+        eeprom_stats.rollover++;
+    }
+
+    for (uint32_t i = 0; i < len; ++i) {
+        chip->mem[page + (offset + i) % chip->page_size] = data[i];
+    }
+    chip->busy_until = bus_now + chip->twr_ns;
+    eeprom_stats.writes++;
+    return HAL_OK;
+}
+
+/**
+ * @brief 连续读取, 在容量末尾回到 0
+ */
+static HAL_StatusTypeDef eeprom_read(uint16_t dev_address,
+                                     uint16_t mem_address,
+                                     uint16_t address_size, uint8_t *data,
+                                     uint16_t len) {
+    uint32_t base, address;
+    eeprom_t *chip = eeprom_find(dev_address, &base);
+
+    if (chip == NULL) {
+        eeprom_stats.bad_address++;
+        return HAL_ERROR;
+    }
+    if (eeprom_busy(chip)) {
+        return HAL_ERROR;
+    }
+
+    address = eeprom_address(chip, base, mem_address, address_size);
+    for (uint32_t i = 0; i < len; ++i) {
+        data[i] = chip->mem[(address + i) & chip->model];
+    }
+    eeprom_stats.reads++;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c,
+                                    uint16_t DevAddress, uint16_t MemAddress,
+                                    uint16_t MemAddSize, uint8_t *pData,
+                                    uint16_t Size, uint32_t Timeout) {
+    (void)hi2c;
+    (void)Timeout;
+
+    if (bus_pending.active) {
+        eeprom_stats.bus_busy++;
+        return HAL_BUSY;
+    }
+    bus_now += (1 + eeprom_address_bytes(MemAddSize) + Size) * BUS_BYTE_NS;
+    return eeprom_write(DevAddress, MemAddress, MemAddSize, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress,
+                                   uint16_t MemAddress, uint16_t MemAddSize,
+                                   uint8_t *pData, uint16_t Size,
+                                   uint32_t Timeout) {
+    (void)hi2c;
+    (void)Timeout;
+
+    if (bus_pending.active) {
+        eeprom_stats.bus_busy++;
+        return HAL_BUSY;
+    }
+    bus_now += (2 + eeprom_address_bytes(MemAddSize) + Size) * BUS_BYTE_NS;
+    return eeprom_read(DevAddress, MemAddress, MemAddSize, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c,
+                                        uint16_t DevAddress, uint32_t Trials,
+                                        uint32_t Timeout) {
+    uint32_t base;
+    eeprom_t *chip;
+
+    (void)hi2c;
+    (void)Trials;
+    (void)Timeout;
+
+    if (bus_pending.active) {
+        eeprom_stats.bus_busy++;
+        return HAL_BUSY;
+    }
+    bus_now += BUS_BYTE_NS;
+    eeprom_stats.probes++;
+
+    chip = eeprom_find(DevAddress, &base);
+    return (chip != NULL && !eeprom_busy(chip)) ? HAL_OK : HAL_ERROR;
+}
+
+/**
+ * @brief 发起异步传输, 由 `bus_run` 在传输时间后完成
+ */
+static HAL_StatusTypeDef bus_start(bool write, uint16_t dev_address,
+                                   uint16_t mem_address, uint16_t address_size,
+                                   uint8_t *data, uint16_t len) {
+    if (bus_pending.active) {
+        eeprom_stats.bus_busy++;
+        return HAL_BUSY;
+    }
+
+    bus_pending.active = true;
+    bus_pending.write = write;
+    bus_pending.dev_address = dev_address;
+    bus_pending.mem_address = mem_address;
+    bus_pending.address_size = address_size;
+    bus_pending.data = data;
+    bus_pending.len = len;
+    bus_pending.done_at =
+        bus_now +
+        ((write ? 1 : 2) + eeprom_address_bytes(address_size) + len) *
+            BUS_BYTE_NS;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef *hi2c,
+                                        uint16_t DevAddress,
+                                        uint16_t MemAddress,
+                                        uint16_t MemAddSize, uint8_t *pData,
+                                        uint16_t Size) {
+    CHECK(hi2c->hdmatx != NULL);
+    bus_dma_used++;
+    return bus_start(true, DevAddress, MemAddress, MemAddSize, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_DMA(I2C_HandleTypeDef *hi2c,
+                                       uint16_t DevAddress, uint16_t MemAddress,
+                                       uint16_t MemAddSize, uint8_t *pData,
+                                       uint16_t Size) {
+    CHECK(hi2c->hdmarx != NULL);
+    bus_dma_used++;
+    return bus_start(false, DevAddress, MemAddress, MemAddSize, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef *hi2c,
+                                       uint16_t DevAddress, uint16_t MemAddress,
+                                       uint16_t MemAddSize, uint8_t *pData,
+                                       uint16_t Size) {
+    (void)hi2c;
+    bus_it_used++;
+    return bus_start(true, DevAddress, MemAddress, MemAddSize, pData, Size);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Read_IT(I2C_HandleTypeDef *hi2c,
+                                      uint16_t DevAddress, uint16_t MemAddress,
+                                      uint16_t MemAddSize, uint8_t *pData,
+                                      uint16_t Size) {
+    (void)hi2c;
+    bus_it_used++;
+    return bus_start(false, DevAddress, MemAddress, MemAddSize, pData, Size);
+}
+
+#if AT24CXX_USE_DMA
+
+/**
+ * @brief 时间前进, 期间完成的异步传输调用 HAL 回调
+ */
+static void bus_run(I2C_HandleTypeDef *hi2c, uint64_t ns) {
+    uint64_t end = bus_now + ns;
+
+    while (bus_pending.active && bus_pending.done_at <= end) {
+        HAL_StatusTypeDef res;
+
+        bus_now = bus_pending.done_at;
+        bus_pending.active = false;
+        if (bus_pending.write) {
+            res = eeprom_write(bus_pending.dev_address, bus_pending.mem_address,
+                               bus_pending.address_size, bus_pending.data,
+                               bus_pending.len);
+        } else {
+            res = eeprom_read(bus_pending.dev_address, bus_pending.mem_address,
+                              bus_pending.address_size, bus_pending.data,
+                              bus_pending.len);
+        }
+
+        /* 回调中可能发起下一次传输 */
+        if (res != HAL_OK) {
+            HAL_I2C_ErrorCallback(hi2c);
+        } else if (bus_pending.write) {
+            HAL_I2C_MemTxCpltCallback(hi2c);
+        } else {
+            HAL_I2C_MemRxCpltCallback(hi2c);
+        }
+    }
+    bus_now = end;
+}
+
+#endif /* AT24CXX_USE_DMA */
+
+/*****************************************************************************
+ * 测试
+ */
+
+static I2C_HandleTypeDef test_hi2c;
+static at24cxx_handle_t test_at24cxx;
+static uint8_t test_shadow[AT24C256 + 1];
+
+static const at24cxx_model_t test_models[] = {
+    AT24C01, AT24C02, AT24C04, AT24C08, AT24C16,
+    AT24C32, AT24C64, AT24C128, AT24C256};
+
+static const char *const test_model_names[] = {
+    "AT24C01", "AT24C02", "AT24C04", "AT24C08", "AT24C16",
+    "AT24C32", "AT24C64", "AT24C128", "AT24C256"};
+
+static uint32_t test_rand_state = 1;
+
+static uint32_t test_rand(void) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return test_rand_state >> 8;
+}
+
+static uint8_t test_page_size(at24cxx_model_t model) {
+    if (model <= AT24C02) {
+        return 8;
+    }
+    if (model <= AT24C16) {
+        return 16;
+    }
+    return (model <= AT24C64) ? 32 : 64;
+}
+
+/**
+ * @brief 总线上接一片被测芯片, 引脚地址有空余时再接一片
+ */
+static void test_setup(at24cxx_model_t model, uint8_t pins) {
+    uint8_t mask = eeprom_pin_mask(model);
+
+    memset(eeprom, 0, sizeof(eeprom));
+    memset(&eeprom_stats, 0, sizeof(eeprom_stats));
+    memset(&bus_pending, 0, sizeof(bus_pending));
+
+    eeprom_num = (mask != 0) ? 2 : 1;
+    for (uint32_t i = 0; i < eeprom_num; ++i) {
+        eeprom[i].model = model;
+        eeprom[i].page_size = test_page_size(model);
+        eeprom[i].twr_ns = EEPROM_TWR_NS;
+        memset(eeprom[i].mem, 0xFF, sizeof(eeprom[i].mem));
+    }
+    eeprom[0].pins = pins & mask;
+    /* 另一片: 翻转最高的引脚地址位 */
+    eeprom[1].pins = (pins ^ (mask & ~(mask >> 1))) & mask;
+
+    memset(test_shadow, 0xFF, sizeof(test_shadow));
+    CHECK(at24cxx_init(&test_at24cxx, &test_hi2c, model,
+                       (at24cxx_address_t)pins) == AT24CXX_OK);
+}
+
+/**
+ * @brief 随机地址和长度, 不超出容量
+ */
+static void test_random_range(at24cxx_model_t model, uint16_t *address,
+                              uint16_t *len) {
+    uint32_t cap = (uint32_t)model + 1;
+    uint32_t max_len;
+
+    *address = (uint16_t)(test_rand() % cap);
+    max_len = cap - *address;
+    if (max_len > TEST_MAX_LEN) {
+        max_len = TEST_MAX_LEN;
+    }
+    *len = (uint16_t)(1 + test_rand() % max_len);
+}
+
+/**
+ * @brief 长度为 len 的数据涉及的单元数
+ */
+static uint32_t test_units(uint32_t address, uint32_t len, uint32_t unit) {
+    return (address + len - 1) / unit - address / unit + 1;
+}
+
+static void test_check_chips(at24cxx_model_t model) {
+    CHECK(memcmp(eeprom[0].mem, test_shadow, (size_t)model + 1) == 0);
+    if (eeprom_num > 1) {
+        for (uint32_t i = 0; i <= (uint32_t)model; ++i) {
+            CHECK(eeprom[1].mem[i] == 0xFF);
+        }
+    }
+    CHECK(eeprom_stats.rollover == 0);
+    CHECK(eeprom_stats.nack_write == 0);
+    CHECK(eeprom_stats.bad_address == 0);
+    CHECK(eeprom_stats.bus_busy == 0);
+}
+
+static void test_sync(void) {
+    static uint8_t buf[TEST_MAX_LEN];
+
+    for (uint32_t m = 0; m < sizeof(test_models) / sizeof(test_models[0]);
+         ++m) {
+        at24cxx_model_t model = test_models[m];
+        uint8_t page_size = test_page_size(model);
+        uint32_t block = (model <= AT24C16) ? 256 : (uint32_t)model + 1;
+
+        test_setup(model, AT24CXX_ADDRESS_A010);
+
+        for (uint32_t op = 0; op < TEST_OPS; ++op) {
+            uint16_t address, len;
+            uint32_t before;
+
+            test_random_range(model, &address, &len);
+
+            if (test_rand() % 2) {
+                for (uint32_t i = 0; i < len; ++i) {
+                    buf[i] = (uint8_t)test_rand();
+                }
+                memcpy(&test_shadow[address], buf, len);
+
+                before = eeprom_stats.writes;
+                if (len == 1) {
+                    CHECK(at24cxx_write_byte(&test_at24cxx, address, buf[0]) ==
+                          AT24CXX_OK);
+                } else {
+                    CHECK(at24cxx_write(&test_at24cxx, address, buf, len) ==
+                          AT24CXX_OK);
+                }
+                CHECK(eeprom_stats.writes - before ==
+                      test_units(address, len, page_size));
+            } else {
+                before = eeprom_stats.reads;
+                if (len == 1) {
+                    buf[0] = at24cxx_read_byte(&test_at24cxx, address);
+                } else {
+                    CHECK(at24cxx_read(&test_at24cxx, address, buf, len) ==
+                          AT24CXX_OK);
+                }
+                CHECK(memcmp(buf, &test_shadow[address], len) == 0);
+                CHECK(eeprom_stats.reads - before ==
+                      test_units(address, len, block));
+            }
+        }
+
+        test_check_chips(model);
+        printf("sync %-8s: %u writes, %u reads, %u ack probes\n",
+               test_model_names[m], eeprom_stats.writes, eeprom_stats.reads,
+               eeprom_stats.probes);
+    }
+}
+
+static void test_timeout(void) {
+    uint8_t buf[4] = {1, 2, 3, 4};
+    uint32_t start;
+
+    test_setup(AT24C02, AT24CXX_ADDRESS_A000);
+    eeprom[0].twr_ns = 1000000000U;
+
+    start = HAL_GetTick();
+    CHECK(at24cxx_write(&test_at24cxx, 0, buf, sizeof(buf)) == AT24CXX_ERROR);
+    CHECK(HAL_GetTick() - start >= AT24CXX_WRITE_TIMEOUT);
+    CHECK(HAL_GetTick() - start <= AT24CXX_WRITE_TIMEOUT + 2);
+
+    printf("timeout: write failed after %u ms\n", HAL_GetTick() - start);
+}
+
+static void test_bench(void) {
+    static uint8_t buf[256];
+    uint64_t start, page_ns, byte_ns;
+
+    for (uint32_t m = 0; m < sizeof(test_models) / sizeof(test_models[0]);
+         ++m) {
+        at24cxx_model_t model = test_models[m];
+        uint32_t len = ((uint32_t)model + 1 < sizeof(buf))
+                           ? (uint32_t)model + 1
+                           : sizeof(buf);
+
+        test_setup(model, AT24CXX_ADDRESS_A000);
+        start = bus_now;
+        CHECK(at24cxx_write(&test_at24cxx, 0, buf, (uint16_t)len) ==
+              AT24CXX_OK);
+        /* 等最后一页的写周期结束 */
+        while (HAL_I2C_IsDeviceReady(&test_hi2c, 0xA0, 1, 1) != HAL_OK) {
+        }
+        page_ns = bus_now - start;
+
+        start = bus_now;
+        for (uint32_t i = 0; i < len; ++i) {
+            CHECK(at24cxx_write_byte(&test_at24cxx, (uint16_t)i, buf[i]) ==
+                  AT24CXX_OK);
+        }
+        while (HAL_I2C_IsDeviceReady(&test_hi2c, 0xA0, 1, 1) != HAL_OK) {
+        }
+        byte_ns = bus_now - start;
+
+        printf("bench %-8s %3u bytes: page write %7.1f ms, "
+               "byte write %7.1f ms\n",
+               test_model_names[m], len, page_ns / 1e6, byte_ns / 1e6);
+    }
+}
+
+#if AT24CXX_USE_DMA
+
+static uint32_t test_done_count;
+static at24cxx_result_t test_done_result;
+
+static void test_callback(at24cxx_handle_t *at24cxx, at24cxx_result_t result) {
+    CHECK(at24cxx == &test_at24cxx);
+    test_done_count++;
+    test_done_result = result;
+}
+
+/**
+ * @brief 每 1 ms 调用一次 `at24cxx_poll`, 直到完成
+ */
+static at24cxx_result_t test_wait(void) {
+    while (test_done_count == 0) {
+        bus_run(&test_hi2c, 1000000U);
+        at24cxx_poll(&test_at24cxx);
+    }
+    CHECK(test_done_count == 1);
+    CHECK(!at24cxx_is_busy(&test_at24cxx));
+    test_done_count = 0;
+    return test_done_result;
+}
+
+static void test_async(bool use_dma) {
+    static DMA_HandleTypeDef *dummy_dma = (DMA_HandleTypeDef *)&test_hi2c;
+    static uint8_t buf[TEST_MAX_LEN];
+
+    test_hi2c.hdmatx = use_dma ? dummy_dma : NULL;
+    test_hi2c.hdmarx = use_dma ? dummy_dma : NULL;
+    bus_dma_used = 0;
+    bus_it_used = 0;
+
+    for (uint32_t m = 0; m < sizeof(test_models) / sizeof(test_models[0]);
+         ++m) {
+        at24cxx_model_t model = test_models[m];
+        uint8_t page_size = test_page_size(model);
+        uint32_t block = (model <= AT24C16) ? 256 : (uint32_t)model + 1;
+
+        test_setup(model, AT24CXX_ADDRESS_A001);
+
+        for (uint32_t op = 0; op < TEST_OPS / 4; ++op) {
+            uint16_t address, len;
+            uint32_t before;
+
+            test_random_range(model, &address, &len);
+
+            if (test_rand() % 2) {
+                for (uint32_t i = 0; i < len; ++i) {
+                    buf[i] = (uint8_t)test_rand();
+                }
+                memcpy(&test_shadow[address], buf, len);
+
+                before = eeprom_stats.writes;
+                CHECK(at24cxx_write_dma(&test_at24cxx, address, buf, len,
+                                        test_callback) == AT24CXX_OK);
+                /* 进行中再次发起返回错误 */
+                CHECK(at24cxx_read_dma(&test_at24cxx, 0, buf, 1,
+                                       test_callback) == AT24CXX_ERROR);
+                CHECK(test_wait() == AT24CXX_OK);
+                CHECK(eeprom_stats.writes - before ==
+                      test_units(address, len, page_size));
+            } else {
+                memset(buf, 0, len);
+                before = eeprom_stats.reads;
+                CHECK(at24cxx_read_dma(&test_at24cxx, address, buf, len,
+                                       test_callback) == AT24CXX_OK);
+                CHECK(test_wait() == AT24CXX_OK);
+                CHECK(memcmp(buf, &test_shadow[address], len) == 0);
+                CHECK(eeprom_stats.reads - before ==
+                      test_units(address, len, block));
+            }
+        }
+
+        test_check_chips(model);
+    }
+
+    CHECK(use_dma ? (bus_it_used == 0 && bus_dma_used > 0)
+                  : (bus_dma_used == 0 && bus_it_used > 0));
+
+    /* 写周期一直不结束 */
+    test_setup(AT24C02, AT24CXX_ADDRESS_A000);
+    eeprom[0].twr_ns = 1000000000U;
+    CHECK(at24cxx_write_dma(&test_at24cxx, 0, buf, 20, test_callback) ==
+          AT24CXX_OK);
+    CHECK(test_wait() == AT24CXX_ERROR);
+    CHECK(eeprom_stats.writes == 1);
+
+    printf("async %s: all models ok, write cycle timeout reported\n",
+           use_dma ? "DMA" : "IT");
+}
+
+#endif /* AT24CXX_USE_DMA */
+
+int main(void) {
+    printf("AT24CXX_USE_DMA: %d\n", AT24CXX_USE_DMA);
+
+    test_sync();
+    test_timeout();
+#if AT24CXX_USE_DMA
+    test_async(true);
+    test_async(false);
+#endif /* AT24CXX_USE_DMA */
+    test_bench();
+
+    printf("all passed\n");
+    return 0;
+}
@@ -0,0 +1,21 @@
+/**
+ * @file    CSP_Config.h
+ * @brief   主机测试用的板级支持替身, 只包含 w25qxx 各模块用到的部分.
+ *          芯片操作与时基由 `test/w25qxx_mock.c` 实现, PRIMASK 由测试实现.
+ */
+
+#ifndef __CSP_CONFIG_H
+#define __CSP_CONFIG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct QSPI_HandleTypeDef QSPI_HandleTypeDef;
+
+uint32_t HAL_GetTick(void);
+
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t primask);
+void __disable_irq(void);
+
+#endif /* __CSP_CONFIG_H */
@@ -0,0 +1,438 @@
+/**
+ * @file    w25qxx_async_test.c
+ * @brief   异步操作队列的主机测试, 芯片由 w25qxx_mock.c 模拟, 包括编程和
+ *          擦除的执行时间与暂停/继续.
+ *
+ * 在 `Memorizer/w25qxx` 下编译运行, 分别测试打开和关闭擦除暂停:
+ *
+ *   gcc -std=gnu11 -g -O1 -fsanitize=address,undefined -Itest/stub -Itest \
+ *       -I. test/w25qxx_async_test.c test/w25qxx_mock.c w25qxx_async.c \
+ *       -o w25qxx_async_test && ./w25qxx_async_test
+ *   gcc -std=gnu11 -g -O1 -fsanitize=address,undefined -Itest/stub -Itest \
+ *       -I. -DW25QXX_ASYNC_USE_SUSPEND=0 test/w25qxx_async_test.c \
+ *       test/w25qxx_mock.c w25qxx_async.c -o w25qxx_async_test && \
+ *       ./w25qxx_async_test
+ *
+ * 检查项:
+ *  - 随机的读, 编程 (跨页) 和擦除操作, 每个读操作得到的数据与按提交顺序
+ *    执行的结果相同; 编程和擦除按提交顺序完成; 芯片忙时没有发出命令,
+ *    暂停期间没有读正在擦除的扇区
+ *  - 擦除期间提交其他扇区的读操作, 暂停擦除后读完再继续, 暂停的时间不计入
+ *    擦除超时, 擦除的实际执行时间不变
+ *  - 暂停命令一直不生效时擦除以超时结束, 之后先继续擦除, 等 BUSY 清除后
+ *    再执行队列中的操作
+ *  - 擦除超时后芯片仍在擦除, BUSY 清除前不发出新的命令
+ *  - 队列满和参数错误返回 `W25QXX_ERROR`
+ *
+ * 最后给出擦除期间读操作从提交到完成的时间.
+ */
+
+#include "w25qxx_async.h"
+#include "w25qxx_mock.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+/* 随机操作使用的扇区数 */
+#define TEST_SECTORS   4
+#define TEST_OPS       3000
+#define TEST_MAX_LEN   600
+
+static w25qxx_handle_t test_chip;
+static w25qxx_async_t test_async;
+
+/*****************************************************************************
+ * 替身
+ */
+
+static uint32_t stub_primask;
+
+uint32_t __get_PRIMASK(void) {
+    return stub_primask;
+}
+
+void __disable_irq(void) {
+    stub_primask = 1;
+}
+
+void __set_PRIMASK(uint32_t primask) {
+    stub_primask = primask;
+}
+
+/*****************************************************************************
+ * 操作池与模型
+ */
+
+/**
+ * @brief 测试中的一个操作
+ */
+typedef struct {
+    w25qxx_op_t op;
+    bool used;
+    uint32_t seq;         /*!< 提交序号 */
+    uint32_t submit_tick; /*!< 提交时刻 */
+    uint32_t done_tick;   /*!< 完成时刻 */
+    uint8_t buf[TEST_MAX_LEN];
+    uint8_t expect[TEST_MAX_LEN]; /*!< 读操作应得的数据 */
+} test_op_t;
+
+static test_op_t test_pool[W25QXX_ASYNC_QUEUE_LENGTH];
+/* 按提交顺序执行的芯片内容 */
+static uint8_t test_model[TEST_SECTORS * MOCK_SECTOR_SIZE];
+static uint32_t test_seq;
+/* 最后完成的编程或擦除的序号 */
+static uint32_t test_last_write;
+static bool test_write_done;
+
+static uint32_t test_rand_state = 1;
+
+static uint32_t test_rand(void) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return test_rand_state >> 8;
+}
+
+static void test_callback(w25qxx_op_t *op, w25qxx_result_t result) {
+    test_op_t *t = (test_op_t *)op->user_data;
+
+    CHECK(&t->op == op);
+    CHECK(result == op->result);
+    t->done_tick = HAL_GetTick();
+
+    if (op->type != W25QXX_OP_READ) {
+        /* 编程和擦除按提交顺序完成 */
+        CHECK(!test_write_done || t->seq > test_last_write);
+        test_last_write = t->seq;
+        test_write_done = true;
+    }
+}
+
+/**
+ * @brief 提交操作, 同时在模型上按顺序执行
+ */
+static void test_submit(test_op_t *t, w25qxx_op_type_t type, uint32_t address,
+                        uint32_t len) {
+    memset(&t->op, 0, sizeof(t->op));
+    t->op.type = type;
+    t->op.address = address;
+    t->op.buf = t->buf;
+    t->op.len = len;
+    t->op.callback = test_callback;
+    t->op.user_data = t;
+    t->seq = test_seq++;
+    t->submit_tick = HAL_GetTick();
+    t->used = true;
+
+    switch (type) {
+        case W25QXX_OP_READ: {
+            memcpy(t->expect, &test_model[address], len);
+        } break;
+
+        case W25QXX_OP_PROGRAM: {
+            for (uint32_t i = 0; i < len; ++i) {
+                t->buf[i] = (uint8_t)test_rand();
+                test_model[address + i] &= t->buf[i];
+            }
+        } break;
+
+        default: {
+            memset(&test_model[address * MOCK_SECTOR_SIZE], 0xFF,
+                   MOCK_SECTOR_SIZE);
+        } break;
+    }
+
+    CHECK(w25qxx_async_submit(&test_async, &t->op) == W25QXX_OK);
+}
+
+/**
+ * @brief 空闲的操作
+ */
+static test_op_t *test_free_op(void) {
+    for (uint32_t i = 0; i < W25QXX_ASYNC_QUEUE_LENGTH; ++i) {
+        if (!test_pool[i].used) {
+            return &test_pool[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 回收已完成的操作, 检查读到的数据
+ */
+static void test_collect(void) {
+    for (uint32_t i = 0; i < W25QXX_ASYNC_QUEUE_LENGTH; ++i) {
+        test_op_t *t = &test_pool[i];
+
+        if (!t->used || !t->op.done) {
+            continue;
+        }
+        CHECK(t->op.result == W25QXX_OK);
+        if (t->op.type == W25QXX_OP_READ) {
+            CHECK(memcmp(t->buf, t->expect, t->op.len) == 0);
+        }
+        t->used = false;
+    }
+}
+
+/**
+ * @brief 运行 1 ms: 轮询 1 ~ 3 次后时间前进
+ */
+static void test_run_ms(void) {
+    uint32_t polls = 1 + test_rand() % 3;
+
+    for (uint32_t i = 0; i < polls; ++i) {
+        w25qxx_async_poll(&test_async);
+    }
+    mock_tick_inc();
+}
+
+static void test_reset(void) {
+    mock_flash_reset();
+    memset(test_model, 0xFF, sizeof(test_model));
+    memset(test_pool, 0, sizeof(test_pool));
+    test_write_done = false;
+    CHECK(w25qxx_async_init(&test_async, &test_chip) == W25QXX_OK);
+}
+
+/*****************************************************************************
+ * 随机操作
+ */
+
+static void test_random(void) {
+    uint32_t submitted = 0;
+    uint32_t reads = 0, programs = 0, erases = 0;
+
+    test_reset();
+    mock_timing.erase_ms = 20;
+
+    while (submitted < TEST_OPS || test_async.count > 0) {
+        test_op_t *t;
+
+        /* 随机提交 0 ~ 2 个操作 */
+        for (uint32_t n = test_rand() % 3; n > 0 && submitted < TEST_OPS;
+             --n) {
+            uint32_t r = test_rand() % 100;
+            uint32_t len = 1 + test_rand() % TEST_MAX_LEN;
+            uint32_t address =
+                test_rand() % (TEST_SECTORS * MOCK_SECTOR_SIZE - len);
+
+            test_collect();
+            t = test_free_op();
+            if (t == NULL) {
+                break;
+            }
+
+            if (r < 55) {
+                test_submit(t, W25QXX_OP_READ, address, len);
+                reads++;
+            } else if (r < 90) {
+                test_submit(t, W25QXX_OP_PROGRAM, address, len);
+                programs++;
+            } else {
+                test_submit(t, W25QXX_OP_ERASE, test_rand() % TEST_SECTORS, 0);
+                erases++;
+            }
+            submitted++;
+        }
+
+        test_run_ms();
+        test_collect();
+    }
+
+    CHECK(memcmp(mock_flash, test_model, sizeof(test_model)) == 0);
+    CHECK(mock_stats.busy_access == 0);
+
+    printf("random: %u reads, %u programs, %u erases in order, "
+           "%u suspends\n",
+           reads, programs, erases, mock_stats.suspends);
+}
+
+/*****************************************************************************
+ * 擦除期间的读操作
+ */
+
+static void test_read_during_erase(void) {
+    test_op_t *erase, *read;
+    uint32_t latency_sum = 0, latency_max = 0, reads = 0;
+    uint32_t start;
+
+    test_reset();
+    mock_timing.erase_ms = 300;
+
+    erase = test_free_op();
+    test_submit(erase, W25QXX_OP_ERASE, 1, 0);
+    start = HAL_GetTick();
+
+    /* 擦除期间每 10 ms 读一次其他扇区 */
+    while (!erase->op.done) {
+        if (HAL_GetTick() % 10 == 5 && (read = test_free_op()) != NULL) {
+            test_submit(read, W25QXX_OP_READ, 2 * MOCK_SECTOR_SIZE + 100, 64);
+        }
+        test_run_ms();
+
+        for (uint32_t i = 0; i < W25QXX_ASYNC_QUEUE_LENGTH; ++i) {
+            test_op_t *t = &test_pool[i];
+            if (t->used && t->op.done && t->op.type == W25QXX_OP_READ) {
+                uint32_t latency = t->done_tick - t->submit_tick;
+                latency_sum += latency;
+                latency_max = latency > latency_max ? latency : latency_max;
+                reads++;
+            }
+        }
+        test_collect();
+    }
+    test_collect();
+    CHECK(erase->op.result == W25QXX_OK || !erase->used);
+    CHECK(mock_stats.busy_access == 0);
+    CHECK(mock_stats.busy_ms == 300);
+
+#if W25QXX_ASYNC_USE_SUSPEND
+    CHECK(reads > 0 && latency_max <= 2);
+    CHECK(mock_stats.suspends == test_async.suspend_cnt);
+    CHECK(mock_stats.suspends == mock_stats.resumes);
+#endif /* W25QXX_ASYNC_USE_SUSPEND */
+
+    /* 擦除完成后剩下的读操作 */
+    while (test_async.count > 0) {
+        test_run_ms();
+    }
+    for (uint32_t i = 0; i < W25QXX_ASYNC_QUEUE_LENGTH; ++i) {
+        test_op_t *t = &test_pool[i];
+        if (t->used && t->op.type == W25QXX_OP_READ) {
+            uint32_t latency = t->done_tick - t->submit_tick;
+            latency_sum += latency;
+            latency_max = latency > latency_max ? latency : latency_max;
+            reads++;
+        }
+    }
+    test_collect();
+
+    printf("read during erase: %u reads, latency avg %.1f ms, max %u ms, "
+           "erase took %u ms with %u suspends\n",
+           reads, (double)latency_sum / reads, latency_max,
+           erase->done_tick - start, mock_stats.suspends);
+}
+
+/*****************************************************************************
+ * 超时
+ */
+
+/**
+ * @brief 暂停命令一直不生效, 擦除按超时处理
+ */
+static void test_suspend_stuck(void) {
+#if W25QXX_ASYNC_USE_SUSPEND
+    test_op_t *erase, *read, *program;
+
+    test_reset();
+    mock_timing.erase_ms = 100;
+    mock_timing.suspend_ms = 50;
+
+    erase = test_free_op();
+    test_submit(erase, W25QXX_OP_ERASE, 0, 0);
+    test_run_ms();
+    read = test_free_op();
+    test_submit(read, W25QXX_OP_READ, 3 * MOCK_SECTOR_SIZE, 16);
+    program = test_free_op();
+    test_submit(program, W25QXX_OP_PROGRAM, 2 * MOCK_SECTOR_SIZE, 16);
+
+    while (!erase->op.done) {
+        test_run_ms();
+    }
+    CHECK(erase->op.result == W25QXX_TIMEOUT);
+    CHECK(test_async.wait_idle);
+    erase->used = false;
+
+    while (test_async.count > 0) {
+        test_run_ms();
+    }
+    test_collect();
+    CHECK(mock_stats.busy_access == 0);
+    CHECK(mock_stats.erases == 1 && mock_stats.suspends == 1 &&
+          mock_stats.resumes == 1);
+    CHECK(memcmp(mock_flash, test_model, sizeof(test_model)) == 0);
+
+    printf("suspend stuck: erase timed out, queue continued after resume\n");
+#endif /* W25QXX_ASYNC_USE_SUSPEND */
+}
+
+/**
+ * @brief 擦除超过 `W25QXX_ASYNC_ERASE_TIMEOUT`, 芯片仍在擦除
+ */
+static void test_erase_timeout(void) {
+    test_op_t *erase, *program;
+    uint32_t start;
+
+    test_reset();
+    mock_timing.erase_ms = W25QXX_ASYNC_ERASE_TIMEOUT + 200;
+
+    erase = test_free_op();
+    test_submit(erase, W25QXX_OP_ERASE, 0, 0);
+    program = test_free_op();
+    test_submit(program, W25QXX_OP_PROGRAM, 100, 300);
+    start = HAL_GetTick();
+
+    while (!erase->op.done) {
+        test_run_ms();
+    }
+    CHECK(erase->op.result == W25QXX_TIMEOUT);
+    CHECK(HAL_GetTick() - start >= W25QXX_ASYNC_ERASE_TIMEOUT);
+    erase->used = false;
+
+    while (test_async.count > 0) {
+        test_run_ms();
+    }
+    test_collect();
+    CHECK(program->done_tick - start >= W25QXX_ASYNC_ERASE_TIMEOUT + 200);
+    CHECK(mock_stats.busy_access == 0);
+    CHECK(memcmp(mock_flash, test_model, sizeof(test_model)) == 0);
+
+    printf("erase timeout: next op waited for BUSY to clear\n");
+}
+
+static void test_args(void) {
+    static w25qxx_op_t op[W25QXX_ASYNC_QUEUE_LENGTH + 1];
+    uint8_t buf[4];
+
+    test_reset();
+    CHECK(w25qxx_async_init(NULL, &test_chip) == W25QXX_ERROR);
+    CHECK(w25qxx_async_submit(&test_async, NULL) == W25QXX_ERROR);
+
+    op[0].type = W25QXX_OP_READ;
+    CHECK(w25qxx_async_submit(&test_async, &op[0]) == W25QXX_ERROR);
+    op[0].buf = buf;
+    CHECK(w25qxx_async_submit(&test_async, &op[0]) == W25QXX_ERROR);
+
+    for (uint32_t i = 0; i < W25QXX_ASYNC_QUEUE_LENGTH + 1; ++i) {
+        op[i].type = W25QXX_OP_READ;
+        op[i].buf = buf;
+        op[i].len = sizeof(buf);
+        CHECK(w25qxx_async_submit(&test_async, &op[i]) ==
+              (i < W25QXX_ASYNC_QUEUE_LENGTH ? W25QXX_OK : W25QXX_ERROR));
+    }
+    CHECK(w25qxx_async_poll(&test_async) == 0);
+    CHECK(stub_primask == 0);
+
+    printf("args: ok\n");
+}
+
+int main(void) {
+    printf("suspend: %d\n", W25QXX_ASYNC_USE_SUSPEND);
+
+    test_random();
+    test_read_during_erase();
+    test_suspend_stuck();
+    test_erase_timeout();
+    test_args();
+
+    printf("all passed\n");
+    return 0;
+}
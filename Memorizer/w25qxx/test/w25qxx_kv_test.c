@@ -0,0 +1,493 @@
+/**
+ * @file    w25qxx_kv_test.c
+ * @brief   键值存储的主机测试, 芯片由内存中的替身 (w25qxx_mock.c) 模拟,
+ *          在每一步编程或擦除处注入掉电.
+ *
+ * 在 `Memorizer/w25qxx` 下编译运行:
+ *
+ *   gcc -std=gnu11 -g -O1 -fsanitize=address,undefined -Itest/stub -Itest \
+ *       -I. -I../../Utils test/w25qxx_kv_test.c test/w25qxx_mock.c \
+ *       w25qxx_kv.c ../../Utils/crc/crc.c -o w25qxx_kv_test
+ *   ./w25qxx_kv_test
+ *
+ * 检查项:
+ *  - 写入, 读取, 覆盖, 删除和重新挂载后的内容与模型相同; 键数量和值长度
+ *    超出限制时返回错误, 已有的键仍然可以更新
+ *  - 活动扇区日志末尾之后不是空白时, 挂载后不在该扇区继续写入
+ *  - 大量写入时后台回收和前台回收的结果正确, 擦除次数均衡, 给出写放大
+ *  - 掉电: 在随机操作序列的每一步 (前 1000 步逐步, 之后每 37 步) 掉电,
+ *    重新上电挂载后, 掉电时正在写入的键为旧值或新值, 其他键不变;
+ *    随后在恢复挂载的过程中再次掉电, 结果相同; 恢复后继续写入并再次挂载,
+ *    内容仍与模型相同
+ *  - 存储区之外的扇区不被修改, 不会在非空白处编程
+ */
+
+#include "w25qxx_kv.h"
+#include "w25qxx_mock.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+/* 存储区位置 */
+#define TEST_FIRST_SECTOR 2
+#define TEST_SECTOR_NUM   8
+/* 随机操作使用的键数量 */
+#define TEST_KEYS         24
+/* 掉电测试的操作数 */
+#define TEST_OPS          300
+
+static w25qxx_handle_t test_chip;
+
+/**
+ * @brief 模型中的值
+ */
+typedef struct {
+    bool exist;
+    uint16_t len;
+    uint8_t data[W25QXX_KV_MAX_VALUE];
+} test_value_t;
+
+static test_value_t test_model[TEST_KEYS];
+
+static uint32_t test_rand_state = 1;
+
+static uint32_t test_rand(void) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return test_rand_state >> 8;
+}
+
+/**
+ * @brief 随机操作
+ */
+typedef enum {
+    TEST_OP_SET,
+    TEST_OP_DELETE,
+    TEST_OP_GC
+} test_op_type_t;
+
+typedef struct {
+    test_op_type_t type;
+    uint16_t key;
+    uint16_t len;
+    uint32_t seed; /*!< 值的内容 */
+} test_op_t;
+
+static test_op_t test_ops[TEST_OPS];
+
+/**
+ * @brief 由种子生成值的内容
+ */
+static void test_fill_value(test_value_t *value, uint16_t len, uint32_t seed) {
+    value->exist = true;
+    value->len = len;
+    for (uint16_t i = 0; i < len; ++i) {
+        seed = seed * 1103515245U + 12345U;
+        value->data[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+/**
+ * @brief 生成随机操作序列: 70% 写入, 15% 删除, 15% 后台回收
+ */
+static void test_make_ops(void) {
+    for (uint32_t i = 0; i < TEST_OPS; ++i) {
+        uint32_t r = test_rand() % 100;
+
+        test_ops[i].type = (r < 70)   ? TEST_OP_SET
+                           : (r < 85) ? TEST_OP_DELETE
+                                      : TEST_OP_GC;
+        test_ops[i].key = (uint16_t)(test_rand() % TEST_KEYS);
+        /* 多数为短值, 偶尔为最大长度 */
+        test_ops[i].len = (test_rand() % 8 == 0)
+                              ? W25QXX_KV_MAX_VALUE
+                              : (uint16_t)(test_rand() % 64);
+        test_ops[i].seed = test_rand();
+    }
+}
+
+/**
+ * @brief 操作完成后模型中该键的值
+ *
+ * @param op 操作
+ * @param[out] value 值
+ * @return 操作涉及的键, 回收为 -1
+ */
+static int test_op_result(const test_op_t *op, test_value_t *value) {
+    switch (op->type) {
+        case TEST_OP_SET: {
+            test_fill_value(value, op->len, op->seed);
+        } break;
+
+        case TEST_OP_DELETE: {
+            value->exist = false;
+            value->len = 0;
+        } break;
+
+        default: {
+            return -1;
+        }
+    }
+
+    return op->key;
+}
+
+/**
+ * @brief 执行一个操作, 成功时更新模型
+ */
+static w25qxx_result_t test_run_op(w25qxx_kv_t *kv, const test_op_t *op) {
+    static test_value_t value;
+    w25qxx_result_t res;
+    int key = test_op_result(op, &value);
+
+    switch (op->type) {
+        case TEST_OP_SET: {
+            res = w25qxx_kv_set(kv, op->key, value.data, op->len);
+        } break;
+
+        case TEST_OP_DELETE: {
+            res = w25qxx_kv_delete(kv, op->key);
+        } break;
+
+        default: {
+            res = w25qxx_kv_gc_step(kv);
+        } break;
+    }
+
+    if (res == W25QXX_OK && key >= 0) {
+        test_model[key] = value;
+    }
+    return res;
+}
+
+/**
+ * @brief 一个键的内容是否与值相同
+ */
+static bool test_same(w25qxx_kv_t *kv, uint16_t key,
+                      const test_value_t *value) {
+    static uint8_t buf[W25QXX_KV_MAX_VALUE];
+    uint16_t len = 0xFFFF;
+
+    if (w25qxx_kv_get(kv, key, buf, sizeof(buf), &len) != W25QXX_OK) {
+        return !value->exist;
+    }
+
+    return value->exist && len == value->len &&
+           memcmp(buf, value->data, len) == 0;
+}
+
+/**
+ * @brief 检查全部键与模型相同
+ *
+ * @param kv 存储区句柄
+ * @param torn_key 掉电时正在写入的键, 可以是旧值或新值; -1 表示没有
+ * @param torn_value 掉电时写入的新值
+ */
+static void test_verify(w25qxx_kv_t *kv, int torn_key,
+                        const test_value_t *torn_value) {
+    for (int key = 0; key < TEST_KEYS; ++key) {
+        if (key == torn_key && test_same(kv, (uint16_t)key, torn_value)) {
+            test_model[key] = *torn_value;
+            continue;
+        }
+        CHECK(test_same(kv, (uint16_t)key, &test_model[key]));
+    }
+}
+
+/**
+ * @brief 存储区之外的扇区保持空白, 且没有在非空白处编程
+ */
+static void test_check_flash(void) {
+    for (uint32_t i = 0; i < MOCK_FLASH_SIZE; ++i) {
+        uint32_t sector = i / MOCK_SECTOR_SIZE;
+        if (sector < TEST_FIRST_SECTOR ||
+            sector >= TEST_FIRST_SECTOR + TEST_SECTOR_NUM) {
+            CHECK(mock_flash[i] == 0xFF);
+        }
+    }
+    CHECK(mock_stats.overwrite == 0);
+}
+
+/*****************************************************************************
+ * 基本功能
+ */
+
+static void test_basic(void) {
+    static w25qxx_kv_t kv;
+    static test_value_t value;
+    uint8_t buf[8];
+    uint16_t len;
+
+    mock_flash_reset();
+    memset(test_model, 0, sizeof(test_model));
+
+    CHECK(w25qxx_kv_mount(&kv, &test_chip, TEST_FIRST_SECTOR, 2) ==
+          W25QXX_ERROR);
+    CHECK(w25qxx_kv_mount(&kv, &test_chip, TEST_FIRST_SECTOR,
+                          TEST_SECTOR_NUM) == W25QXX_OK);
+    CHECK(mock_stats.erases == TEST_SECTOR_NUM);
+
+    /* 写入, 覆盖, 删除 */
+    test_fill_value(&value, 5, 1);
+    CHECK(w25qxx_kv_set(&kv, 1, value.data, 5) == W25QXX_OK);
+    test_model[1] = value;
+    test_fill_value(&value, 0, 2);
+    CHECK(w25qxx_kv_set(&kv, 2, NULL, 0) == W25QXX_OK);
+    test_model[2] = value;
+    test_fill_value(&value, 200, 3);
+    CHECK(w25qxx_kv_set(&kv, 1, value.data, 200) == W25QXX_OK);
+    test_model[1] = value;
+    CHECK(w25qxx_kv_set(&kv, 3, value.data, 7) == W25QXX_OK);
+    CHECK(w25qxx_kv_delete(&kv, 3) == W25QXX_OK);
+    CHECK(w25qxx_kv_delete(&kv, 3) == W25QXX_OK);
+    CHECK(w25qxx_kv_delete(&kv, 4) == W25QXX_OK);
+    test_verify(&kv, -1, NULL);
+
+    /* 读取长度截断 */
+    CHECK(w25qxx_kv_get(&kv, 1, buf, sizeof(buf), &len) == W25QXX_OK);
+    CHECK(len == 200 && memcmp(buf, value.data, sizeof(buf)) == 0);
+    CHECK(w25qxx_kv_get(&kv, 3, buf, sizeof(buf), &len) == W25QXX_ERROR);
+
+    /* 参数 */
+    CHECK(w25qxx_kv_set(&kv, 0xFFFF, buf, 1) == W25QXX_ERROR);
+    CHECK(w25qxx_kv_set(&kv, 5, value.data, W25QXX_KV_MAX_VALUE + 1) ==
+          W25QXX_ERROR);
+    CHECK(w25qxx_kv_set(&kv, 5, NULL, 1) == W25QXX_ERROR);
+
+    /* 重新挂载 */
+    memset(&kv, 0, sizeof(kv));
+    CHECK(w25qxx_kv_mount(&kv, &test_chip, TEST_FIRST_SECTOR,
+                          TEST_SECTOR_NUM) == W25QXX_OK);
+    test_verify(&kv, -1, NULL);
+
+    /* 键数量: 删除标记也占用索引 */
+    for (uint16_t key = 100; kv.index_num < W25QXX_KV_MAX_KEYS; ++key) {
+        CHECK(w25qxx_kv_set(&kv, key, &key, sizeof(key)) == W25QXX_OK);
+    }
+    CHECK(w25qxx_kv_set(&kv, 1000, buf, 1) == W25QXX_ERROR);
+    CHECK(w25qxx_kv_set(&kv, 1, buf, 1) == W25QXX_OK);
+    test_fill_value(&test_model[1], 1, 0);
+    memcpy(test_model[1].data, buf, 1);
+    memset(&kv, 0, sizeof(kv));
+    CHECK(w25qxx_kv_mount(&kv, &test_chip, TEST_FIRST_SECTOR,
+                          TEST_SECTOR_NUM) == W25QXX_OK);
+    CHECK(kv.index_num == W25QXX_KV_MAX_KEYS);
+    test_verify(&kv, -1, NULL);
+
+    test_check_flash();
+    printf("basic: ok\n");
+}
+
+/**
+ * @brief 活动扇区日志末尾之后不是空白 (掉电时记录头仍为 0xFF, 数据只写了
+ *        一部分), 挂载后不能在这里继续编程
+ */
+static void test_torn_tail(void) {
+    static w25qxx_kv_t kv;
+    static test_value_t value;
+    uint32_t tail;
+
+    mock_flash_reset();
+    memset(test_model, 0, sizeof(test_model));
+    CHECK(w25qxx_kv_mount(&kv, &test_chip, TEST_FIRST_SECTOR,
+                          TEST_SECTOR_NUM) == W25QXX_OK);
+    test_fill_value(&value, 20, 7);
+    CHECK(w25qxx_kv_set(&kv, 1, value.data, 20) == W25QXX_OK);
+    test_model[1] = value;
+
+    tail = (TEST_FIRST_SECTOR + kv.active) * MOCK_SECTOR_SIZE +
+           kv.used[kv.active];
+    mock_flash[tail + 12] = 0x5A;
+
+    memset(&kv, 0, sizeof(kv));
+    CHECK(w25qxx_kv_mount(&kv, &test_chip, TEST_FIRST_SECTOR,
+                          TEST_SECTOR_NUM) == W25QXX_OK);
+    for (uint16_t key = 2; key < 6; ++key) {
+        test_fill_value(&value, 30, key);
+        CHECK(w25qxx_kv_set(&kv, key, value.data, 30) == W25QXX_OK);
+        test_model[key] = value;
+    }
+    test_verify(&kv, -1, NULL);
+
+    memset(&kv, 0, sizeof(kv));
+    CHECK(w25qxx_kv_mount(&kv, &test_chip, TEST_FIRST_SECTOR,
+                          TEST_SECTOR_NUM) == W25QXX_OK);
+    test_verify(&kv, -1, NULL);
+    test_check_flash();
+
+    printf("torn tail: ok\n");
+}
+
+/*****************************************************************************
+ * 回收与磨损均衡
+ */
+
+static void test_wear(void) {
+    static w25qxx_kv_t kv;
+    static test_value_t value;
+    uint32_t min_erase = UINT32_MAX, max_erase = 0;
+    uint32_t user_bytes;
+
+    mock_flash_reset();
+    memset(test_model, 0, sizeof(test_model));
+    CHECK(w25qxx_kv_mount(&kv, &test_chip, TEST_FIRST_SECTOR,
+                          TEST_SECTOR_NUM) == W25QXX_OK);
+
+    /* 一半的键写入一次后不再修改 (冷数据), 另一半反复写入 */
+    for (uint16_t key = 0; key < TEST_KEYS; ++key) {
+        test_fill_value(&value, 200, key);
+        CHECK(w25qxx_kv_set(&kv, key, value.data, 200) == W25QXX_OK);
+        test_model[key] = value;
+    }
+    for (uint32_t i = 0; i < 20000; ++i) {
+        uint16_t key = (uint16_t)(test_rand() % (TEST_KEYS / 2));
+        uint16_t len = (uint16_t)(test_rand() % 120);
+
+        test_fill_value(&value, len, test_rand());
+        CHECK(w25qxx_kv_set(&kv, key, value.data, len) == W25QXX_OK);
+        test_model[key] = value;
+        if (i % 8 == 0) {
+            CHECK(w25qxx_kv_gc_step(&kv) == W25QXX_OK);
+        }
+    }
+    test_verify(&kv, -1, NULL);
+    user_bytes = kv.stats.user_bytes;
+
+    memset(&kv, 0, sizeof(kv));
+    CHECK(w25qxx_kv_mount(&kv, &test_chip, TEST_FIRST_SECTOR,
+                          TEST_SECTOR_NUM) == W25QXX_OK);
+    test_verify(&kv, -1, NULL);
+    test_check_flash();
+
+    for (uint32_t i = TEST_FIRST_SECTOR;
+         i < TEST_FIRST_SECTOR + TEST_SECTOR_NUM; ++i) {
+        if (mock_stats.sector_erases[i] < min_erase) {
+            min_erase = mock_stats.sector_erases[i];
+        }
+        if (mock_stats.sector_erases[i] > max_erase) {
+            max_erase = mock_stats.sector_erases[i];
+        }
+    }
+    CHECK(max_erase - min_erase <= W25QXX_KV_WEAR_DELTA + 2);
+
+    printf("wear: %u erases, per sector %u..%u, write amplification %.2f\n",
+           mock_stats.erases, min_erase, max_erase,
+           (double)mock_stats.program_bytes / user_bytes);
+}
+
+/*****************************************************************************
+ * 掉电
+ */
+
+static uint8_t test_image[MOCK_FLASH_SIZE];
+static test_value_t test_image_model[TEST_KEYS];
+
+/**
+ * @brief 重新上电并挂载, 挂载过程中可以再次掉电
+ *
+ * @param kv 存储区句柄
+ * @param cut 挂载时第几步掉电, 0 表示不掉电
+ */
+static void test_remount(w25qxx_kv_t *kv, uint32_t cut) {
+    mock_power_on();
+    mock_power_cut_at(cut);
+    memset(kv, 0, sizeof(w25qxx_kv_t));
+    if (w25qxx_kv_mount(kv, &test_chip, TEST_FIRST_SECTOR, TEST_SECTOR_NUM) ==
+        W25QXX_OK) {
+        mock_power_cut_at(0);
+        return;
+    }
+
+    CHECK(mock_power_is_cut());
+    mock_power_on();
+    memset(kv, 0, sizeof(w25qxx_kv_t));
+    CHECK(w25qxx_kv_mount(kv, &test_chip, TEST_FIRST_SECTOR,
+                          TEST_SECTOR_NUM) == W25QXX_OK);
+}
+
+static void test_power_cut(void) {
+    static w25qxx_kv_t kv;
+    static test_value_t torn_value;
+    uint32_t cases = 0, mount_cut = 0;
+    uint32_t cut = 1;
+
+    /* 初始内容: 写满两个扇区左右, 保存芯片内容和模型 */
+    mock_flash_reset();
+    memset(test_model, 0, sizeof(test_model));
+    CHECK(w25qxx_kv_mount(&kv, &test_chip, TEST_FIRST_SECTOR,
+                          TEST_SECTOR_NUM) == W25QXX_OK);
+    test_make_ops();
+    for (uint32_t i = 0; i < TEST_OPS / 4; ++i) {
+        CHECK(test_run_op(&kv, &test_ops[i]) == W25QXX_OK);
+    }
+    memcpy(test_image, mock_flash, sizeof(test_image));
+    memcpy(test_image_model, test_model, sizeof(test_model));
+    test_make_ops();
+
+    for (;;) {
+        int torn_key = -1;
+        uint32_t op;
+
+        memcpy(mock_flash, test_image, sizeof(mock_flash));
+        memcpy(test_model, test_image_model, sizeof(test_model));
+        mock_power_on();
+        mock_stats.overwrite = 0;
+        memset(&kv, 0, sizeof(kv));
+        CHECK(w25qxx_kv_mount(&kv, &test_chip, TEST_FIRST_SECTOR,
+                              TEST_SECTOR_NUM) == W25QXX_OK);
+
+        mock_power_cut_at(cut);
+        for (op = 0; op < TEST_OPS; ++op) {
+            if (test_run_op(&kv, &test_ops[op]) != W25QXX_OK) {
+                break;
+            }
+        }
+        if (op == TEST_OPS) {
+            /* 操作序列完成前没有掉电, 已经覆盖了所有步 */
+            break;
+        }
+        CHECK(mock_power_is_cut());
+        torn_key = test_op_result(&test_ops[op], &torn_value);
+
+        /* 每 3 次在恢复挂载中再掉电一次 */
+        if (cases % 3 == 2) {
+            test_remount(&kv, 1 + test_rand() % 64);
+            mount_cut++;
+        } else {
+            test_remount(&kv, 0);
+        }
+        test_verify(&kv, torn_key, &torn_value);
+
+        /* 恢复后继续写入 */
+        for (uint32_t i = op + 1; i < op + 40 && i < TEST_OPS; ++i) {
+            CHECK(test_run_op(&kv, &test_ops[i]) == W25QXX_OK);
+        }
+        test_remount(&kv, 0);
+        test_verify(&kv, -1, NULL);
+        test_check_flash();
+
+        cases++;
+        cut += (cut < 1000) ? 1 : 37;
+    }
+
+    printf("power cut: %u cases, %u also cut during the recovery mount\n",
+           cases, mount_cut);
+}
+
+int main(void) {
+    test_basic();
+    test_torn_tail();
+    test_wear();
+    test_power_cut();
+
+    printf("all passed\n");
+    return 0;
+}
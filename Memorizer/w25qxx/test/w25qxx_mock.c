@@ -0,0 +1,313 @@
+/**
+ * @file    w25qxx_mock.c
+ * @brief   主机测试用的 W25QXX 替身, 芯片内容保存在内存中
+ */
+
+#include "w25qxx_mock.h"
+
+#include <string.h>
+
+uint8_t mock_flash[MOCK_FLASH_SIZE];
+mock_stats_t mock_stats;
+mock_timing_t mock_timing;
+
+/* 掉电的步数, 0 表示不掉电 */
+static uint32_t mock_cut_step;
+static bool mock_cut;
+/* 掉电时部分编程/擦除的位 */
+static uint32_t mock_rand_state = 1;
+
+/**
+ * @brief 芯片内正在执行的编程或擦除
+ */
+typedef enum {
+    MOCK_IDLE,
+    MOCK_PROGRAM,
+    MOCK_ERASE
+} mock_busy_t;
+
+static uint32_t mock_tick;
+static mock_busy_t mock_busy;
+static uint32_t mock_remain;   /* 剩余的执行时间 (ms) */
+static uint32_t mock_address;  /* 编程的字节地址或擦除的扇区 */
+static uint8_t mock_page[MOCK_PAGE_SIZE];
+static uint16_t mock_page_len;
+static bool mock_suspend_req;  /* 已收到暂停命令, 还未生效 */
+static uint32_t mock_suspend_at;
+static bool mock_suspended;
+
+static uint8_t mock_rand(void) {
+    mock_rand_state = mock_rand_state * 1103515245U + 12345U;
+    return (uint8_t)(mock_rand_state >> 16);
+}
+
+/**
+ * @brief 执行一步, 到达掉电的步数时返回 false
+ */
+static bool mock_step(void) {
+    mock_stats.steps++;
+    if (mock_cut_step != 0 && mock_stats.steps >= mock_cut_step) {
+        mock_cut = true;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 芯片忙时收到命令, 真实芯片会忽略该命令
+ */
+static bool mock_check_busy(void) {
+    if (mock_busy != MOCK_IDLE && !mock_suspended) {
+        mock_stats.busy_access++;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 编程数据
+ */
+static w25qxx_result_t mock_do_program(uint32_t address, const uint8_t *buf,
+                                       uint32_t len) {
+    for (uint32_t i = 0; i < len; ++i) {
+        uint8_t *cell = &mock_flash[address + i];
+
+        if (!mock_step()) {
+            /* 一页内的数据同时编程, 掉电时这一页的每个字节都只编程了部分位 */
+            uint32_t end = (address + i) / MOCK_PAGE_SIZE * MOCK_PAGE_SIZE +
+                           MOCK_PAGE_SIZE;
+            uint32_t page = (address + i) / MOCK_PAGE_SIZE * MOCK_PAGE_SIZE;
+
+            for (uint32_t j = (page > address) ? page - address : 0;
+                 j < len && address + j < end; ++j) {
+                mock_flash[address + j] &= buf[j] | mock_rand();
+            }
+            return W25QXX_ERROR;
+        }
+
+        if ((*cell & buf[i]) != buf[i]) {
+            mock_stats.overwrite++;
+        }
+        *cell &= buf[i];
+        mock_stats.program_bytes++;
+    }
+
+    return W25QXX_OK;
+}
+
+/**
+ * @brief 擦除扇区
+ */
+static w25qxx_result_t mock_do_erase(uint32_t sector) {
+    uint8_t *data = &mock_flash[sector * MOCK_SECTOR_SIZE];
+
+    if (!mock_step()) {
+        /* 只擦除了部分位 */
+        for (uint32_t i = 0; i < MOCK_SECTOR_SIZE; ++i) {
+            data[i] |= mock_rand();
+        }
+        return W25QXX_ERROR;
+    }
+
+    memset(data, 0xFF, MOCK_SECTOR_SIZE);
+    mock_stats.erases++;
+    mock_stats.sector_erases[sector]++;
+    return W25QXX_OK;
+}
+
+/**
+ * @brief 芯片全部擦除, 清除统计信息, 掉电设置和执行状态
+ */
+void mock_flash_reset(void) {
+    memset(mock_flash, 0xFF, sizeof(mock_flash));
+    memset(&mock_stats, 0, sizeof(mock_stats));
+    mock_cut_step = 0;
+    mock_cut = false;
+
+    mock_timing.program_ms = 1;
+    mock_timing.erase_ms = 50;
+    mock_timing.suspend_ms = 0;
+    mock_busy = MOCK_IDLE;
+    mock_suspend_req = false;
+    mock_suspended = false;
+}
+
+/**
+ * @brief 设置掉电的步数
+ *
+ * @param step 从现在起第几步掉电, 0 表示不掉电
+ */
+void mock_power_cut_at(uint32_t step) {
+    mock_cut_step = (step == 0) ? 0 : mock_stats.steps + step;
+}
+
+/**
+ * @brief 重新上电, 芯片内容保持不变
+ */
+void mock_power_on(void) {
+    mock_cut_step = 0;
+    mock_cut = false;
+}
+
+/**
+ * @brief 是否已经掉电
+ */
+bool mock_power_is_cut(void) {
+    return mock_cut;
+}
+
+/**
+ * @brief 时间前进 1 ms
+ * @note 暂停命令在收到后 `suspend_ms` 生效, 暂停期间编程和擦除不推进.
+ */
+void mock_tick_inc(void) {
+    mock_tick++;
+
+    if (mock_suspend_req &&
+        mock_tick - mock_suspend_at >= mock_timing.suspend_ms) {
+        mock_suspend_req = false;
+        mock_suspended = true;
+        mock_stats.suspends++;
+    }
+
+    if (mock_busy == MOCK_IDLE || mock_suspended) {
+        return;
+    }
+
+    mock_stats.busy_ms++;
+    if (--mock_remain != 0) {
+        return;
+    }
+
+    if (mock_busy == MOCK_PROGRAM) {
+        mock_do_program(mock_address, mock_page, mock_page_len);
+    } else {
+        mock_do_erase(mock_address);
+    }
+    mock_busy = MOCK_IDLE;
+    mock_suspend_req = false;
+}
+
+uint32_t HAL_GetTick(void) {
+    return mock_tick;
+}
+
+w25qxx_result_t w25qxx_read(w25qxx_handle_t *w25qxx, uint32_t address,
+                            uint8_t *buf, uint32_t len) {
+    if (w25qxx == NULL || mock_cut || address > MOCK_FLASH_SIZE ||
+        len > MOCK_FLASH_SIZE - address) {
+        return W25QXX_ERROR;
+    }
+
+    if (mock_check_busy()) {
+        return W25QXX_ERROR;
+    }
+    if (mock_suspended && mock_busy == MOCK_ERASE &&
+        address < (mock_address + 1) * MOCK_SECTOR_SIZE &&
+        mock_address * MOCK_SECTOR_SIZE < address + len) {
+        /* 暂停期间读正在擦除的扇区, 数据不确定 */
+        mock_stats.busy_access++;
+    }
+
+    memcpy(buf, &mock_flash[address], len);
+    return W25QXX_OK;
+}
+
+w25qxx_result_t w25qxx_program(w25qxx_handle_t *w25qxx, uint32_t address,
+                               const uint8_t *buf, uint32_t len) {
+    if (w25qxx == NULL || mock_cut || address > MOCK_FLASH_SIZE ||
+        len > MOCK_FLASH_SIZE - address) {
+        return W25QXX_ERROR;
+    }
+
+    if (mock_busy != MOCK_IDLE) {
+        mock_stats.busy_access++;
+        return W25QXX_ERROR;
+    }
+
+    return mock_do_program(address, buf, len);
+}
+
+w25qxx_result_t w25qxx_erase(w25qxx_handle_t *w25qxx, uint32_t address) {
+    if (w25qxx == NULL || mock_cut || address >= MOCK_SECTOR_NUM) {
+        return W25QXX_ERROR;
+    }
+
+    if (mock_busy != MOCK_IDLE) {
+        mock_stats.busy_access++;
+        return W25QXX_ERROR;
+    }
+
+    return mock_do_erase(address);
+}
+
+w25qxx_result_t w25qxx_program_page_start(w25qxx_handle_t *w25qxx,
+                                          uint32_t address, const uint8_t *buf,
+                                          uint16_t len) {
+    if (w25qxx == NULL || mock_cut || len == 0 || len > MOCK_PAGE_SIZE ||
+        address / MOCK_PAGE_SIZE != (address + len - 1U) / MOCK_PAGE_SIZE ||
+        address + len > MOCK_FLASH_SIZE) {
+        return W25QXX_ERROR;
+    }
+
+    if (mock_busy != MOCK_IDLE) {
+        mock_stats.busy_access++;
+        return W25QXX_ERROR;
+    }
+
+    mock_busy = MOCK_PROGRAM;
+    mock_remain = mock_timing.program_ms;
+    mock_address = address;
+    memcpy(mock_page, buf, len);
+    mock_page_len = len;
+    return W25QXX_OK;
+}
+
+w25qxx_result_t w25qxx_erase_start(w25qxx_handle_t *w25qxx, uint32_t address) {
+    if (w25qxx == NULL || mock_cut || address >= MOCK_SECTOR_NUM) {
+        return W25QXX_ERROR;
+    }
+
+    if (mock_busy != MOCK_IDLE) {
+        mock_stats.busy_access++;
+        return W25QXX_ERROR;
+    }
+
+    mock_busy = MOCK_ERASE;
+    mock_remain = mock_timing.erase_ms;
+    mock_address = address;
+    return W25QXX_OK;
+}
+
+w25qxx_result_t w25qxx_suspend(w25qxx_handle_t *w25qxx) {
+    if (w25qxx == NULL || mock_cut) {
+        return W25QXX_ERROR;
+    }
+
+    /* 空闲或已暂停时命令无效 */
+    if (mock_busy != MOCK_IDLE && !mock_suspended && !mock_suspend_req) {
+        mock_suspend_req = true;
+        mock_suspend_at = mock_tick;
+    }
+    return W25QXX_OK;
+}
+
+w25qxx_result_t w25qxx_resume(w25qxx_handle_t *w25qxx) {
+    if (w25qxx == NULL || mock_cut) {
+        return W25QXX_ERROR;
+    }
+
+    if (mock_suspended) {
+        mock_suspended = false;
+        mock_stats.resumes++;
+    }
+    return W25QXX_OK;
+}
+
+bool w25qxx_is_busy(w25qxx_handle_t *w25qxx) {
+    return w25qxx != NULL && mock_busy != MOCK_IDLE && !mock_suspended;
+}
+
+bool w25qxx_is_suspended(w25qxx_handle_t *w25qxx) {
+    return w25qxx != NULL && mock_suspended;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file    w25qxx_mock.h
+ * @brief   主机测试用的 W25QXX 替身, 芯片内容保存在内存中
+ *
+ *****************************************************************************
+ * 代替 w25qxx.c 与测试一起编译, 实现 w25qxx.h 中存储模块用到的函数:
+ *  - 编程只能把 1 改写为 0 (与原内容按位与), 在非空白处把 0 改写为 1 的
+ *    字节数记入 `overwrite`;
+ *  - 擦除把整个扇区置为 0xFF.
+ *
+ * 时间: `HAL_GetTick` 返回模拟的时刻, 由测试调用 `mock_tick_inc` 推进.
+ * 同步的 `w25qxx_program` 与 `w25qxx_erase` 立即完成; 异步的
+ * `w25qxx_program_page_start` 与 `w25qxx_erase_start` 在 `mock_timing`
+ * 给出的时间后完成, 完成前 BUSY 为 1. 暂停命令在 `suspend_ms` 后生效,
+ * 暂停期间 BUSY 为 0, 编程和擦除不推进. 芯片忙时收到命令, 或者暂停期间
+ * 读正在擦除的扇区, 记入 `busy_access`.
+ *
+ * 掉电注入: 每编程一个字节或擦除一个扇区算一步, `mock_power_cut_at(n)`
+ * 在第 n 步掉电:
+ *  - 编程到一半时, 芯片按页并行编程, 当前页中本次写入的每个字节都只有
+ *    部分位被编程, 之前的页已完成, 之后的页不变;
+ *  - 擦除到一半时, 扇区中每个字节的部分位变为 1.
+ * 掉电后所有操作返回 `W25QXX_ERROR`, 直到调用 `mock_power_on` 模拟重新上电.
+ *****************************************************************************
+ */
+
+#ifndef __W25QXX_MOCK_H
+#define __W25QXX_MOCK_H
+
+#include "w25qxx.h"
+
+/* 模拟芯片的扇区数 */
+#define MOCK_SECTOR_NUM  16
+#define MOCK_SECTOR_SIZE 4096
+#define MOCK_PAGE_SIZE   256
+#define MOCK_FLASH_SIZE  (MOCK_SECTOR_NUM * MOCK_SECTOR_SIZE)
+
+/**
+ * @brief 统计信息
+ */
+typedef struct {
+    uint32_t steps;         /*!< 已执行的步数 */
+    uint32_t program_bytes; /*!< 编程的字节数 */
+    uint32_t erases;        /*!< 擦除次数 */
+    uint32_t overwrite;     /*!< 需要把 0 改写为 1 的编程字节数 */
+    uint32_t busy_access;   /*!< 芯片忙时收到的命令数 */
+    uint32_t busy_ms;       /*!< 编程和擦除实际执行的时间 */
+    uint32_t suspends;      /*!< 生效的暂停次数 */
+    uint32_t resumes;       /*!< 继续次数 */
+    uint32_t sector_erases[MOCK_SECTOR_NUM]; /*!< 每个扇区的擦除次数 */
+} mock_stats_t;
+
+/**
+ * @brief 异步操作的执行时间 (ms)
+ */
+typedef struct {
+    uint32_t program_ms; /*!< 页编程 */
+    uint32_t erase_ms;   /*!< 扇区擦除 */
+    uint32_t suspend_ms; /*!< 暂停命令生效 */
+} mock_timing_t;
+
+extern uint8_t mock_flash[MOCK_FLASH_SIZE];
+extern mock_stats_t mock_stats;
+extern mock_timing_t mock_timing;
+
+void mock_flash_reset(void);
+void mock_power_cut_at(uint32_t step);
+void mock_power_on(void);
+bool mock_power_is_cut(void);
+void mock_tick_inc(void);
+
+#endif /* __W25QXX_MOCK_H */
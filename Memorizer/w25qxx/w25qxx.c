@@ -34,6 +34,8 @@
 #define W25QXX_ENABLE_4BYTE_ADDR        0xb7
 #define W25QXX_RELEASE_POWER_DOWN       0xab
 #define W25QXX_POWER_DOWN               0xb9
+#define W25QXX_SUSPEND                  0x75
+#define W25QXX_RESUME                   0x7a
 
 #define W25QXX_SECTOR_ERASE_4B          0x21
 #define W25QXX_PAGE_PROGRAM_QUAD_INP_4B 0x34
@@ -486,6 +488,42 @@ w25qxx_result_t w25qxx_write_enable(w25qxx_handle_t *w25qxx) {
     return ret;
 }
 
+/**
+ * @brief 发送只有指令, 没有地址和数据的命令
+ *
+ * @param w25qxx W25QXX 句柄
+ * @param cmd 指令
+ * @return 操作状态
+ */
+static w25qxx_result_t w25qxx_send_single_cmd(w25qxx_handle_t *w25qxx,
+                                              uint8_t cmd) {
+    w25qxx_result_t ret = W25QXX_ERROR;
+
+    if (w25qxx == NULL) {
+        return W25QXX_ERROR;
+    }
+
+    if (w25qxx->use_qspi) {
+#if W25QXX_USE_QSPI
+        if (w25qxx->enable_qspi) {
+            ret = qspi_send_cmd(cmd, 0,
+                                (0 << 6) | (0 << 4) | (0 << 2) | (3 << 0), 0);
+        } else {
+            ret = qspi_send_cmd(cmd, 0,
+                                (0 << 6) | (0 << 4) | (0 << 2) | (1 << 0), 0);
+        }
+#endif /* W25QXX_USE_QSPI */
+    } else {
+#if W25QXX_USE_SPI
+        cs_on(w25qxx);
+        ret = w25qxx_spi_transmit(w25qxx, &cmd, 1);
+        cs_off(w25qxx);
+#endif /* W25QXX_USE_SPI */
+    }
+
+    return ret;
+}
+
 /**
  * @brief 等待 W25QXX 就绪
  *
@@ -556,30 +594,45 @@ w25qxx_result_t w25qxx_read(w25qxx_handle_t *w25qxx, uint32_t address,
 }
 
 /**
- * @brief 在指定地址开始写入最大 256 字节的数据
+ * @brief 查询 W25QXX 是否正在编程或擦除
+ *
+ * @param w25qxx W25QXX 句柄
+ * @return 是否忙
+ */
+bool w25qxx_is_busy(w25qxx_handle_t *w25qxx) {
+    if (w25qxx == NULL) {
+        return false;
+    }
+
+    return (w25qxx_get_status(w25qxx, W25QXX_READ_REGISTER_1) & 0x01) != 0;
+}
+
+/**
+ * @brief 发出页编程命令, 不等待编程完成
  *
  * @param w25qxx W25QXX 句柄
+ * @param address 写入的地址
  * @param buf 数据缓冲区
- * @param addr 写入的地址
  * @param len 要写入的长度 (最大 256), 不应该超过该页的剩余字节数!
  * @return 操作状态
+ * @note 调用前芯片必须空闲, 之后用 `w25qxx_is_busy` 查询是否完成
  */
-static w25qxx_result_t w25qxx_write_page(w25qxx_handle_t *w25qxx,
-                                         const uint8_t *buf, uint32_t addr,
-                                         uint16_t len) {
+w25qxx_result_t w25qxx_program_page_start(w25qxx_handle_t *w25qxx,
+                                          uint32_t address, const uint8_t *buf,
+                                          uint16_t len) {
     uint8_t cmd = W25QXX_PAGE_PROGRAM;
 
-    if (w25qxx_write_enable(w25qxx) != W25QXX_OK) {
+    if (w25qxx == NULL || len > 256) {
         return W25QXX_ERROR;
     }
 
-    if (len > 256) {
+    if (w25qxx_write_enable(w25qxx) != W25QXX_OK) {
         return W25QXX_ERROR;
     }
 
     if (w25qxx->use_qspi) {
 #if W25QXX_USE_QSPI
-        if (qspi_send_cmd(W25QXX_PAGE_PROGRAM, addr,
+        if (qspi_send_cmd(W25QXX_PAGE_PROGRAM, address,
                           (3 << 6) | (3 << 4) | (3 << 2) | (3 << 0), 0)) {
             return W25QXX_ERROR;
         }
@@ -593,9 +646,10 @@ static w25qxx_result_t w25qxx_write_page(w25qxx_handle_t *w25qxx,
         cs_on(w25qxx);
 
         w25qxx_spi_transmit(w25qxx, &cmd, 1);
-        w25qxx_send_addr(w25qxx, addr);
+        w25qxx_send_addr(w25qxx, address);
 
         if (w25qxx_spi_transmit(w25qxx, buf, len) != W25QXX_OK) {
+            cs_off(w25qxx);
             return W25QXX_ERROR;
         }
 
@@ -603,6 +657,25 @@ static w25qxx_result_t w25qxx_write_page(w25qxx_handle_t *w25qxx,
 #endif /* W25QXX_USE_SPI */
     }
 
+    return W25QXX_OK;
+}
+
+/**
+ * @brief 在指定地址开始写入最大 256 字节的数据
+ *
+ * @param w25qxx W25QXX 句柄
+ * @param buf 数据缓冲区
+ * @param addr 写入的地址
+ * @param len 要写入的长度 (最大 256), 不应该超过该页的剩余字节数!
+ * @return 操作状态
+ */
+static w25qxx_result_t w25qxx_write_page(w25qxx_handle_t *w25qxx,
+                                         const uint8_t *buf, uint32_t addr,
+                                         uint16_t len) {
+    if (w25qxx_program_page_start(w25qxx, addr, buf, len) != W25QXX_OK) {
+        return W25QXX_ERROR;
+    }
+
     if (w25qxx_wait_for_ready(w25qxx, 1000) != W25QXX_OK) {
         return W25QXX_TIMEOUT;
     }
@@ -665,6 +738,38 @@ static w25qxx_result_t w25qxx_write_no_check(w25qxx_handle_t *w25qxx,
     return W25QXX_OK;
 }
 
+/**
+ * @brief 直接编程 W25QXX, 不擦除
+ *
+ * @param w25qxx W25QXX 句柄
+ * @param address 地址
+ * @param buf 写入的数据
+ * @param len 写入长度
+ * @return 操作结果
+ * @note 写入区域必须是已擦除的 (0xFF), 或者只把 1 改写为 0.
+ *       用于日志式存储等自行管理擦除的场合, 避免整扇区读改写.
+ */
+w25qxx_result_t w25qxx_program(w25qxx_handle_t *w25qxx, uint32_t address,
+                               const uint8_t *buf, uint32_t len) {
+    uint16_t chunk;
+
+    if (w25qxx == NULL) {
+        return W25QXX_ERROR;
+    }
+
+    while (len > 0) {
+        chunk = (len > 4096) ? 4096 : (uint16_t)len;
+        if (w25qxx_write_no_check(w25qxx, buf, address, chunk) != W25QXX_OK) {
+            return W25QXX_ERROR;
+        }
+        buf += chunk;
+        address += chunk;
+        len -= chunk;
+    }
+
+    return W25QXX_OK;
+}
+
 /**
  * @brief 写入 W25QXX
  *
@@ -756,14 +861,15 @@ w25qxx_result_t w25qxx_write(w25qxx_handle_t *w25qxx, uint32_t address,
 }
 
 /**
- * @brief 擦除 W25QXX 扇区
+ * @brief 发出扇区擦除命令, 不等待擦除完成
  *
  * @param w25qxx W25QXX 句柄
  * @param address 擦除的扇区地址, 根据实际容量设置
  * @return 操作结果
- * @note 注意是扇区地址, 不是字节地址! 擦除一个扇区至少 150 ms
+ * @note 注意是扇区地址, 不是字节地址! 调用前芯片必须空闲,
+ *       之后用 `w25qxx_is_busy` 查询是否完成
  */
-w25qxx_result_t w25qxx_erase(w25qxx_handle_t *w25qxx, uint32_t address) {
+w25qxx_result_t w25qxx_erase_start(w25qxx_handle_t *w25qxx, uint32_t address) {
     uint8_t cmd = W25QXX_SECTOR_ERASE;
 
     if (w25qxx == NULL) {
@@ -775,10 +881,6 @@ w25qxx_result_t w25qxx_erase(w25qxx_handle_t *w25qxx, uint32_t address) {
         return W25QXX_ERROR;
     }
 
-    if (w25qxx_wait_for_ready(w25qxx, 1000) != W25QXX_OK) {
-        return W25QXX_TIMEOUT;
-    }
-
     if (w25qxx->use_qspi) {
 #if W25QXX_USE_QSPI
         if (qspi_send_cmd(cmd, address,
@@ -795,6 +897,30 @@ w25qxx_result_t w25qxx_erase(w25qxx_handle_t *w25qxx, uint32_t address) {
 #endif /* W25QXX_USE_SPI */
     }
 
+    return W25QXX_OK;
+}
+
+/**
+ * @brief 擦除 W25QXX 扇区
+ *
+ * @param w25qxx W25QXX 句柄
+ * @param address 擦除的扇区地址, 根据实际容量设置
+ * @return 操作结果
+ * @note 注意是扇区地址, 不是字节地址! 擦除一个扇区至少 150 ms
+ */
+w25qxx_result_t w25qxx_erase(w25qxx_handle_t *w25qxx, uint32_t address) {
+    if (w25qxx == NULL) {
+        return W25QXX_ERROR;
+    }
+
+    if (w25qxx_wait_for_ready(w25qxx, 1000) != W25QXX_OK) {
+        return W25QXX_TIMEOUT;
+    }
+
+    if (w25qxx_erase_start(w25qxx, address) != W25QXX_OK) {
+        return W25QXX_ERROR;
+    }
+
     if (w25qxx_wait_for_ready(w25qxx, 1000) != W25QXX_OK) {
         return W25QXX_TIMEOUT;
     }
@@ -802,6 +928,46 @@ w25qxx_result_t w25qxx_erase(w25qxx_handle_t *w25qxx, uint32_t address) {
     return W25QXX_OK;
 }
 
+/**
+ * @brief 暂停正在进行的擦除或编程
+ *
+ * @param w25qxx W25QXX 句柄
+ * @return 操作结果
+ * @note 暂停后可以读取其他扇区, 之后必须调用 `w25qxx_resume` 继续.
+ *       发出命令后约 20 us 才真正暂停, 用 `w25qxx_is_suspended` 确认.
+ */
+w25qxx_result_t w25qxx_suspend(w25qxx_handle_t *w25qxx) {
+    return w25qxx_send_single_cmd(w25qxx, W25QXX_SUSPEND);
+}
+
+/**
+ * @brief 继续被暂停的擦除或编程
+ *
+ * @param w25qxx W25QXX 句柄
+ * @return 操作结果
+ */
+w25qxx_result_t w25qxx_resume(w25qxx_handle_t *w25qxx) {
+    return w25qxx_send_single_cmd(w25qxx, W25QXX_RESUME);
+}
+
+/**
+ * @brief 查询擦除或编程是否已经暂停
+ *
+ * @param w25qxx W25QXX 句柄
+ * @return 是否已暂停 (状态寄存器 2 的 SUS 位置位并且不忙)
+ */
+bool w25qxx_is_suspended(w25qxx_handle_t *w25qxx) {
+    if (w25qxx == NULL) {
+        return false;
+    }
+
+    if (w25qxx_is_busy(w25qxx)) {
+        return false;
+    }
+
+    return (w25qxx_get_status(w25qxx, W25QXX_READ_REGISTER_2) & 0x80) != 0;
+}
+
 /**
  * @brief W25QXX 全片擦除
  *
@@ -77,16 +77,28 @@ w25qxx_result_t w25qxx_init(w25qxx_handle_t *w25qxx, bool use_qspi);
 w25qxx_result_t w25qxx_deinit(w25qxx_handle_t *w25qxx);
 uint32_t w25qxx_read_id(w25qxx_handle_t *w25qxx);
 uint8_t w25qxx_get_status(w25qxx_handle_t *w25qxx, uint8_t reg);
-uint8_t w25qxx_set_status(w25qxx_handle_t *w25qxx, uint8_t reg, uint8_t status);
+w25qxx_result_t w25qxx_set_status(w25qxx_handle_t *w25qxx, uint8_t reg,
+                                  uint8_t status);
 w25qxx_result_t w25qxx_write_enable(w25qxx_handle_t *w25qxx);
+bool w25qxx_is_busy(w25qxx_handle_t *w25qxx);
 
 w25qxx_result_t w25qxx_read(w25qxx_handle_t *w25qxx, uint32_t address,
                             uint8_t *buf, uint32_t len);
 w25qxx_result_t w25qxx_write(w25qxx_handle_t *w25qxx, uint32_t address,
                              const uint8_t *buf, uint32_t len);
+w25qxx_result_t w25qxx_program(w25qxx_handle_t *w25qxx, uint32_t address,
+                               const uint8_t *buf, uint32_t len);
 w25qxx_result_t w25qxx_erase(w25qxx_handle_t *w25qxx, uint32_t address);
 w25qxx_result_t w25qxx_chip_erase(w25qxx_handle_t *w25qxx);
 
+w25qxx_result_t w25qxx_program_page_start(w25qxx_handle_t *w25qxx,
+                                          uint32_t address, const uint8_t *buf,
+                                          uint16_t len);
+w25qxx_result_t w25qxx_erase_start(w25qxx_handle_t *w25qxx, uint32_t address);
+w25qxx_result_t w25qxx_suspend(w25qxx_handle_t *w25qxx);
+w25qxx_result_t w25qxx_resume(w25qxx_handle_t *w25qxx);
+bool w25qxx_is_suspended(w25qxx_handle_t *w25qxx);
+
 w25qxx_result_t w25qxx_power_down(w25qxx_handle_t *w25qxx);
 w25qxx_result_t w25qxx_release_power_down(w25qxx_handle_t *w25qxx);
 
@@ -0,0 +1,418 @@
+/**
+ * @file    w25qxx_async.c
+ * @brief   W25QXX 异步操作队列
+ */
+
+#include "w25qxx_async.h"
+
+#include <string.h>
+
+#define ASYNC_ENTER_CRITICAL()                                                 \
+    uint32_t primask = __get_PRIMASK();                                        \
+    __disable_irq()
+#define ASYNC_EXIT_CRITICAL() __set_PRIMASK(primask)
+
+/* 等待暂停生效的时间 (ms), 芯片手册为 20 us */
+#define ASYNC_SUSPEND_TIMEOUT 2
+
+#if W25QXX_ASYNC_USE_RTOS
+void w25qxx_async_task(void *args);
+#endif /* W25QXX_ASYNC_USE_RTOS */
+
+#if W25QXX_ASYNC_USE_SUSPEND
+
+/**
+ * @brief 判断两个地址区间是否重叠
+ *
+ * @param a 区间 a 起始地址
+ * @param a_len 区间 a 长度
+ * @param b 区间 b 起始地址
+ * @param b_len 区间 b 长度
+ * @return 是否重叠
+ */
+static inline bool async_overlap(uint32_t a, uint32_t a_len, uint32_t b,
+                                 uint32_t b_len) {
+    return (a < b + b_len) && (b < a + a_len);
+}
+
+/**
+ * @brief 操作涉及的字节地址范围
+ *
+ * @param op 操作
+ * @param[out] len 范围长度
+ * @return 起始字节地址
+ */
+static uint32_t async_op_range(const w25qxx_op_t *op, uint32_t *len) {
+    if (op->type == W25QXX_OP_ERASE) {
+        *len = 4096;
+        return op->address * 4096;
+    }
+
+    *len = op->len;
+    return op->address;
+}
+
+#endif /* W25QXX_ASYNC_USE_SUSPEND */
+
+/**
+ * @brief 把操作移出队列并通知完成
+ *
+ * @param async 异步队列句柄
+ * @param index 操作在队列中的位置
+ * @param result 操作结果
+ */
+static void async_finish(w25qxx_async_t *async, uint8_t index,
+                         w25qxx_result_t result) {
+    w25qxx_op_t *op = async->queue[index];
+
+    ASYNC_ENTER_CRITICAL();
+    memmove(&async->queue[index], &async->queue[index + 1],
+            (async->count - index - 1) * sizeof(w25qxx_op_t *));
+    async->count--;
+    ASYNC_EXIT_CRITICAL();
+
+    if (index == 0) {
+        async->busy = false;
+        async->offset = 0;
+    }
+
+    op->result = result;
+    op->done = true;
+
+    if (op->callback != NULL) {
+        op->callback(op, result);
+    }
+
+#if W25QXX_ASYNC_USE_RTOS
+    if (op->task != NULL) {
+        xTaskNotify(op->task, (uint32_t)result, eSetValueWithOverwrite);
+    }
+#endif /* W25QXX_ASYNC_USE_RTOS */
+}
+
+/**
+ * @brief 发出队首编程操作的下一页
+ *
+ * @param async 异步队列句柄
+ * @param op 编程操作
+ * @return 操作结果
+ */
+static w25qxx_result_t async_program_next(w25qxx_async_t *async,
+                                          w25qxx_op_t *op) {
+    uint32_t address = op->address + async->offset;
+    uint32_t chunk = 256 - address % 256;
+
+    if (chunk > op->len - async->offset) {
+        chunk = op->len - async->offset;
+    }
+
+    if (w25qxx_program_page_start(async->w25qxx, address,
+                                  op->buf + async->offset,
+                                  (uint16_t)chunk) != W25QXX_OK) {
+        return W25QXX_ERROR;
+    }
+
+    async->offset += chunk;
+    async->busy = true;
+    async->start_tick = HAL_GetTick();
+    return W25QXX_OK;
+}
+
+#if W25QXX_ASYNC_USE_SUSPEND
+
+/**
+ * @brief 查找擦除期间可以提前执行的读操作
+ *
+ * @param async 异步队列句柄
+ * @param count 队列中的操作数
+ * @return 读操作在队列中的位置, 0 表示没有
+ * @note 读操作不能与正在擦除的扇区重叠, 也不能与排在它前面的写操作重叠,
+ *       否则会读到旧数据.
+ */
+static uint8_t async_find_read(w25qxx_async_t *async, uint8_t count) {
+    uint32_t read_addr, read_len;
+    uint32_t addr, len;
+    uint8_t i, j;
+
+    for (i = 1; i < count; ++i) {
+        if (async->queue[i]->type != W25QXX_OP_READ) {
+            continue;
+        }
+
+        read_addr = async_op_range(async->queue[i], &read_len);
+        for (j = 0; j < i; ++j) {
+            if (async->queue[j]->type == W25QXX_OP_READ) {
+                continue;
+            }
+            addr = async_op_range(async->queue[j], &len);
+            if (async_overlap(read_addr, read_len, addr, len)) {
+                break;
+            }
+        }
+
+        if (j == i) {
+            return i;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 有可以提前的读操作时发出暂停擦除命令, 不等待暂停生效
+ *
+ * @param async 异步队列句柄
+ */
+static void async_suspend_erase(w25qxx_async_t *async) {
+    if (async_find_read(async, async->count) == 0) {
+        return;
+    }
+
+    if (w25qxx_suspend(async->w25qxx) != W25QXX_OK) {
+        return;
+    }
+
+    async->suspending = true;
+    async->suspend_tick = HAL_GetTick();
+}
+
+/**
+ * @brief 继续擦除, 暂停的时间不计入擦除超时
+ *
+ * @param async 异步队列句柄
+ */
+static void async_resume_erase(w25qxx_async_t *async) {
+    w25qxx_resume(async->w25qxx);
+    async->suspending = false;
+    async->start_tick += HAL_GetTick() - async->suspend_tick;
+}
+
+/**
+ * @brief 暂停生效后执行可以提前的读操作, 然后继续擦除
+ *
+ * @param async 异步队列句柄
+ * @return 擦除是否仍在进行 (暂停中, 已继续或超时)
+ * @retval - true:  下次轮询再查询状态
+ * @retval - false: 擦除在暂停生效前已经完成
+ * @note 每次轮询最多暂停一次, 保证擦除有时间推进.
+ */
+static bool async_read_during_erase(w25qxx_async_t *async) {
+    uint8_t index;
+    w25qxx_op_t *op;
+
+    if (!w25qxx_is_suspended(async->w25qxx)) {
+        if (!w25qxx_is_busy(async->w25qxx)) {
+            /* 擦除已经在暂停前完成 */
+            async->suspending = false;
+            return false;
+        }
+
+        if (HAL_GetTick() - async->suspend_tick > ASYNC_SUSPEND_TIMEOUT) {
+            /* 暂停一直没有生效, 按擦除超时处理 */
+            async->suspending = false;
+            async_finish(async, 0, W25QXX_TIMEOUT);
+            async->wait_idle = true;
+        }
+        return true;
+    }
+    async->suspend_cnt++;
+
+    while ((index = async_find_read(async, async->count)) != 0) {
+        op = async->queue[index];
+        async_finish(async, index,
+                     w25qxx_read(async->w25qxx, op->address, op->buf, op->len));
+    }
+
+    async_resume_erase(async);
+    return true;
+}
+
+#endif /* W25QXX_ASYNC_USE_SUSPEND */
+
+/**
+ * @brief 初始化异步队列
+ *
+ * @param async 异步队列句柄
+ * @param w25qxx 已经初始化的芯片句柄
+ * @return 操作结果
+ */
+w25qxx_result_t w25qxx_async_init(w25qxx_async_t *async,
+                                  w25qxx_handle_t *w25qxx) {
+    if (async == NULL || w25qxx == NULL) {
+        return W25QXX_ERROR;
+    }
+
+    memset(async, 0, sizeof(w25qxx_async_t));
+    async->w25qxx = w25qxx;
+
+#if W25QXX_ASYNC_USE_RTOS
+    if (xTaskCreate(w25qxx_async_task, W25QXX_ASYNC_TASK_NAME,
+                    W25QXX_ASYNC_TASK_STK_SIZE, async,
+                    W25QXX_ASYNC_TASK_PRIORITY, NULL) != pdPASS) {
+        return W25QXX_ERROR;
+    }
+#endif /* W25QXX_ASYNC_USE_RTOS */
+
+    return W25QXX_OK;
+}
+
+/**
+ * @brief 提交异步操作
+ *
+ * @param async 异步队列句柄
+ * @param op 操作, 需要填写类型, 地址, 缓冲区, 长度和回调
+ * @return 操作结果
+ * @retval - `W25QXX_OK`:    已加入队列
+ * @retval - `W25QXX_ERROR`: 参数错误或队列已满
+ * @note 可以在任务或中断中调用, 不会访问芯片.
+ */
+w25qxx_result_t w25qxx_async_submit(w25qxx_async_t *async, w25qxx_op_t *op) {
+    w25qxx_result_t ret = W25QXX_ERROR;
+
+    if (async == NULL || op == NULL) {
+        return W25QXX_ERROR;
+    }
+
+    if (op->type != W25QXX_OP_ERASE && (op->buf == NULL || op->len == 0)) {
+        return W25QXX_ERROR;
+    }
+
+    op->done = false;
+    op->result = W25QXX_OK;
+
+    ASYNC_ENTER_CRITICAL();
+    if (async->count < W25QXX_ASYNC_QUEUE_LENGTH) {
+        async->queue[async->count++] = op;
+        ret = W25QXX_OK;
+    }
+    ASYNC_EXIT_CRITICAL();
+
+    return ret;
+}
+
+/**
+ * @brief 推进异步队列
+ *
+ * @param async 异步队列句柄
+ * @return 队列中还未完成的操作数
+ * @note 芯片忙时只查询一次状态就返回. 读操作和编程的每一页只占用总线
+ *       传输的时间, 擦除期间的读操作见 `W25QXX_ASYNC_USE_SUSPEND`.
+ */
+uint8_t w25qxx_async_poll(w25qxx_async_t *async) {
+    w25qxx_op_t *op;
+    w25qxx_result_t res;
+    uint32_t timeout;
+
+    if (async == NULL) {
+        return 0;
+    }
+
+    if (async->wait_idle) {
+        /* 芯片忙时发出的命令会被忽略, 等待超时的操作执行完.
+           暂停命令迟迟生效时 BUSY 也为 0, 需要先继续擦除 */
+        if (w25qxx_is_suspended(async->w25qxx)) {
+            w25qxx_resume(async->w25qxx);
+            return async->count;
+        }
+        if (w25qxx_is_busy(async->w25qxx)) {
+            return async->count;
+        }
+        async->wait_idle = false;
+    }
+
+    while (async->count > 0) {
+        op = async->queue[0];
+
+        if (async->busy) {
+#if W25QXX_ASYNC_USE_SUSPEND
+            /* 暂停期间 BUSY 为 0, 先处理暂停 */
+            if (async->suspending && async_read_during_erase(async)) {
+                break;
+            }
+#endif /* W25QXX_ASYNC_USE_SUSPEND */
+
+            if (w25qxx_is_busy(async->w25qxx)) {
+                timeout = (op->type == W25QXX_OP_ERASE)
+                              ? W25QXX_ASYNC_ERASE_TIMEOUT
+                              : W25QXX_ASYNC_PROGRAM_TIMEOUT;
+                if (HAL_GetTick() - async->start_tick > timeout) {
+                    async_finish(async, 0, W25QXX_TIMEOUT);
+                    async->wait_idle = true;
+                    break;
+                }
+
+#if W25QXX_ASYNC_USE_SUSPEND
+                if (op->type == W25QXX_OP_ERASE) {
+                    async_suspend_erase(async);
+                }
+#endif /* W25QXX_ASYNC_USE_SUSPEND */
+                break;
+            }
+
+            async->busy = false;
+            if (op->type == W25QXX_OP_PROGRAM && async->offset < op->len) {
+                if (async_program_next(async, op) != W25QXX_OK) {
+                    async_finish(async, 0, W25QXX_ERROR);
+                    continue;
+                }
+                break;
+            }
+
+            async_finish(async, 0, W25QXX_OK);
+            continue;
+        }
+
+        switch (op->type) {
+            case W25QXX_OP_READ: {
+                res = w25qxx_read(async->w25qxx, op->address, op->buf, op->len);
+                async_finish(async, 0, res);
+            } break;
+
+            case W25QXX_OP_PROGRAM: {
+                res = async_program_next(async, op);
+                if (res != W25QXX_OK) {
+                    async_finish(async, 0, res);
+                }
+            } break;
+
+            case W25QXX_OP_ERASE: {
+                res = w25qxx_erase_start(async->w25qxx, op->address);
+                if (res != W25QXX_OK) {
+                    async_finish(async, 0, res);
+                } else {
+                    async->busy = true;
+                    async->start_tick = HAL_GetTick();
+                }
+            } break;
+
+            default: {
+                async_finish(async, 0, W25QXX_ERROR);
+            } break;
+        }
+
+        if (async->busy) {
+            /* 刚发出编程或擦除, 下次轮询再查询状态 */
+            break;
+        }
+    }
+
+    return async->count;
+}
+
+#if W25QXX_ASYNC_USE_RTOS
+
+/**
+ * @brief 异步队列轮询任务
+ *
+ * @param args 异步队列句柄
+ */
+void w25qxx_async_task(void *args) {
+    w25qxx_async_t *async = (w25qxx_async_t *)args;
+
+    while (1) {
+        w25qxx_async_poll(async);
+        vTaskDelay(W25QXX_ASYNC_POLL_PERIOD);
+    }
+}
+
+#endif /* W25QXX_ASYNC_USE_RTOS */
@@ -0,0 +1,122 @@
+/**
+ * @file    w25qxx_async.h
+ * @brief   W25QXX 异步操作队列
+ *
+ *****************************************************************************
+ * 读, 编程, 擦除操作放入队列后立即返回, 由 `w25qxx_async_poll` 推进:
+ *  - 每次轮询只查询一次 BUSY 位, 不会在芯片忙时自旋等待;
+ *  - 编程按页发出, 每页完成后再发下一页;
+ *  - 擦除期间, 如果队列里有不涉及该扇区的读操作, 先暂停擦除, 读完再继续.
+ *    发出暂停后不等待, 下次轮询时芯片已暂停才执行读操作, 暂停期间不计入
+ *    擦除超时;
+ *  - 编程或擦除超时后, 操作以 `W25QXX_TIMEOUT` 结束, 但芯片可能仍在执行,
+ *    BUSY 清除之前不会发出新的命令, 队列中的其他操作继续等待.
+ * 操作完成后调用回调函数, 使用 FreeRTOS 时还可以通知等待的任务.
+ *
+ * `w25qxx_async_poll` 可以在定时器中断或低优先级任务中周期调用,
+ * 打开 `W25QXX_ASYNC_USE_RTOS` 时会自动创建轮询任务.
+ * 使用异步队列时, 不要再直接调用同一芯片的同步读写函数.
+ *****************************************************************************
+ */
+
+#ifndef __W25QXX_ASYNC_H
+#define __W25QXX_ASYNC_H
+
+#include "w25qxx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* 队列长度 */
+#define W25QXX_ASYNC_QUEUE_LENGTH    8
+/* 擦除期间是否暂停擦除, 优先完成其他扇区的读操作 */
+#ifndef W25QXX_ASYNC_USE_SUSPEND
+#define W25QXX_ASYNC_USE_SUSPEND     1
+#endif /* W25QXX_ASYNC_USE_SUSPEND */
+/* 擦除超时 (ms), 不包括暂停的时间 */
+#define W25QXX_ASYNC_ERASE_TIMEOUT   1000
+/* 页编程超时 (ms) */
+#define W25QXX_ASYNC_PROGRAM_TIMEOUT 10
+
+/* 是否使用 FreeRTOS */
+#define W25QXX_ASYNC_USE_RTOS        0
+
+#if W25QXX_ASYNC_USE_RTOS
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* 轮询任务名称 */
+#define W25QXX_ASYNC_TASK_NAME     "w25qxx"
+/* 轮询任务优先级 */
+#define W25QXX_ASYNC_TASK_PRIORITY 2
+/* 轮询任务栈大小 */
+#define W25QXX_ASYNC_TASK_STK_SIZE 256
+/* 轮询周期 (ms) */
+#define W25QXX_ASYNC_POLL_PERIOD   1
+#endif /* W25QXX_ASYNC_USE_RTOS */
+
+/**
+ * @brief 操作类型
+ */
+typedef enum {
+    W25QXX_OP_READ,    /*!< 读 */
+    W25QXX_OP_PROGRAM, /*!< 编程 (不擦除, 区域必须已擦除) */
+    W25QXX_OP_ERASE    /*!< 扇区擦除 */
+} w25qxx_op_type_t;
+
+typedef struct w25qxx_op_s w25qxx_op_t;
+
+/**
+ * @brief 操作完成回调, 在轮询的上下文中调用
+ */
+typedef void (*w25qxx_op_callback_t)(w25qxx_op_t *op, w25qxx_result_t result);
+
+/**
+ * @brief 异步操作, 由调用者分配, 完成之前不能释放或修改
+ */
+struct w25qxx_op_s {
+    w25qxx_op_type_t type; /*!< 操作类型 */
+    uint32_t address;      /*!< 读和编程为字节地址, 擦除为扇区地址 */
+    uint8_t *buf;          /*!< 数据缓冲区, 擦除时不使用 */
+    uint32_t len;          /*!< 数据长度, 擦除时不使用 */
+
+    w25qxx_op_callback_t callback; /*!< 完成回调, 可以为 NULL */
+    void *user_data;               /*!< 用户数据 */
+#if W25QXX_ASYNC_USE_RTOS
+    TaskHandle_t task; /*!< 完成时通知的任务 (通知值为结果), 可以为 NULL */
+#endif                 /* W25QXX_ASYNC_USE_RTOS */
+
+    volatile bool done;     /*!< 是否已完成 */
+    w25qxx_result_t result; /*!< 操作结果 */
+};
+
+/**
+ * @brief 异步队列句柄
+ */
+typedef struct {
+    w25qxx_handle_t *w25qxx; /*!< 芯片句柄 */
+
+    w25qxx_op_t *queue[W25QXX_ASYNC_QUEUE_LENGTH]; /*!< 按提交顺序排列 */
+    volatile uint8_t count;                        /*!< 队列中的操作数 */
+
+    bool busy;           /*!< 队首的编程或擦除正在芯片内执行 */
+    bool wait_idle;      /*!< 超时的操作仍在芯片内执行, 等待 BUSY 清除 */
+    uint32_t offset;     /*!< 队首编程已发出的长度 */
+    uint32_t start_tick; /*!< 当前页编程或擦除开始的时刻 */
+
+    bool suspending;       /*!< 已发出暂停擦除命令, 等待暂停生效 */
+    uint32_t suspend_tick; /*!< 发出暂停命令的时刻 */
+    uint32_t suspend_cnt;  /*!< 为读操作暂停擦除的次数 */
+} w25qxx_async_t;
+
+w25qxx_result_t w25qxx_async_init(w25qxx_async_t *async,
+                                  w25qxx_handle_t *w25qxx);
+w25qxx_result_t w25qxx_async_submit(w25qxx_async_t *async, w25qxx_op_t *op);
+uint8_t w25qxx_async_poll(w25qxx_async_t *async);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __W25QXX_ASYNC_H */
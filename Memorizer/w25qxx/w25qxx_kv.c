@@ -0,0 +1,777 @@
+/**
+ * @file    w25qxx_kv.c
+ * @brief   基于 W25QXX 的日志结构键值存储
+ */
+
+#include "w25qxx_kv.h"
+
+#include "crc/crc.h"
+
+#include <string.h>
+
+#define KV_MAGIC          0x3153564BU /* "KVS1" */
+#define KV_HEADER_SIZE    16          /* 扇区头长度 */
+#define KV_RECORD_SIZE    8           /* 记录头长度 */
+#define KV_DATA_SIZE      (W25QXX_SECTOR_SIZE - KV_HEADER_SIZE)
+
+#define KV_COMMITTED      0x00 /* 记录已提交 */
+#define KV_FLAG_NORMAL    0xFF /* 普通记录 */
+#define KV_FLAG_TOMBSTONE 0xFE /* 删除标记 */
+#define KV_TOMBSTONE_LEN  0xFFFF
+#define KV_INVALID        0xFFFF
+
+#define KV_ALIGN(x)       (((x) + 3U) & ~3U)
+
+/**
+ * @brief 扇区状态
+ */
+enum {
+    KV_SECTOR_FREE = 0, /*!< 已擦除, 写入了扇区头 */
+    KV_SECTOR_USED,     /*!< 已打开, 包含记录 */
+    KV_SECTOR_DIRTY     /*!< 内容无效, 需要擦除 */
+};
+
+/**
+ * @brief 扇区内地址转换为芯片地址
+ *
+ * @param kv 存储区句柄
+ * @param sector 扇区 (相对存储区)
+ * @param offset 扇区内偏移
+ * @return 芯片地址
+ */
+static inline uint32_t kv_addr(w25qxx_kv_t *kv, uint16_t sector,
+                               uint32_t offset) {
+    return (kv->first_sector + sector) * W25QXX_SECTOR_SIZE + offset;
+}
+
+/**
+ * @brief 记录在 Flash 中占用的长度
+ *
+ * @param len 值长度, 删除标记为 `KV_TOMBSTONE_LEN`
+ * @return 记录长度 (4 字节对齐)
+ */
+static inline uint16_t kv_record_size(uint16_t len) {
+    if (len == KV_TOMBSTONE_LEN) {
+        return KV_RECORD_SIZE;
+    }
+
+    return (uint16_t)KV_ALIGN(KV_RECORD_SIZE + len);
+}
+
+/**
+ * @brief 记录 CRC, 覆盖标志, 键, 长度和数据
+ *
+ * @param record 记录头和数据
+ * @param len 数据长度
+ * @return CRC 值
+ */
+static uint16_t kv_record_crc(const uint8_t *record, uint16_t len) {
+    uint16_t crc = crc_ccitt_update(CRC_CCITT_INIT, &record[1], 5);
+    return crc_ccitt_update(crc, &record[KV_RECORD_SIZE], len);
+}
+
+/**
+ * @brief 查找索引项
+ *
+ * @param kv 存储区句柄
+ * @param key 键
+ * @param[out] pos 找到时为索引位置, 否则为插入位置
+ * @return 是否找到
+ */
+static bool kv_index_find(w25qxx_kv_t *kv, uint16_t key, uint16_t *pos) {
+    uint16_t low = 0, high = kv->index_num;
+
+    while (low < high) {
+        uint16_t mid = (low + high) / 2;
+        if (kv->index[mid].key < key) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    *pos = low;
+    return (low < kv->index_num) && (kv->index[low].key == key);
+}
+
+/**
+ * @brief 更新索引项, 并维护扇区有效数据长度
+ *
+ * @param kv 存储区句柄
+ * @param key 键
+ * @param sector 记录所在扇区
+ * @param offset 记录偏移
+ * @param len 值长度
+ * @return 操作结果
+ */
+static w25qxx_result_t kv_index_put(w25qxx_kv_t *kv, uint16_t key,
+                                    uint16_t sector, uint16_t offset,
+                                    uint16_t len) {
+    w25qxx_kv_index_t *entry;
+    uint16_t pos;
+
+    if (kv_index_find(kv, key, &pos)) {
+        entry = &kv->index[pos];
+        kv->live[entry->sector] -= kv_record_size(entry->len);
+    } else {
+        if (kv->index_num >= W25QXX_KV_MAX_KEYS) {
+            return W25QXX_ERROR;
+        }
+        memmove(&kv->index[pos + 1], &kv->index[pos],
+                (kv->index_num - pos) * sizeof(w25qxx_kv_index_t));
+        kv->index_num++;
+        entry = &kv->index[pos];
+        entry->key = key;
+    }
+
+    entry->sector = sector;
+    entry->offset = offset;
+    entry->len = len;
+    kv->live[sector] += kv_record_size(len);
+
+    return W25QXX_OK;
+}
+
+/**
+ * @brief 删除索引项
+ *
+ * @param kv 存储区句柄
+ * @param pos 索引位置
+ */
+static void kv_index_remove(w25qxx_kv_t *kv, uint16_t pos) {
+    w25qxx_kv_index_t *entry = &kv->index[pos];
+
+    kv->live[entry->sector] -= kv_record_size(entry->len);
+    kv->index_num--;
+    memmove(entry, entry + 1,
+            (kv->index_num - pos) * sizeof(w25qxx_kv_index_t));
+}
+
+/**
+ * @brief 擦除扇区并写入扇区头
+ *
+ * @param kv 存储区句柄
+ * @param sector 扇区
+ * @return 操作结果
+ */
+static w25qxx_result_t kv_erase_sector(w25qxx_kv_t *kv, uint16_t sector) {
+    uint32_t header[2];
+
+    if (w25qxx_erase(kv->w25qxx, kv->first_sector + sector) != W25QXX_OK) {
+        return W25QXX_ERROR;
+    }
+    kv->erase_cnt[sector]++;
+    kv->stats.erases++;
+
+    /* 序号留空, 打开扇区时再写入 */
+    header[0] = KV_MAGIC;
+    header[1] = kv->erase_cnt[sector];
+    if (w25qxx_program(kv->w25qxx, kv_addr(kv, sector, 0),
+                       (const uint8_t *)header, sizeof(header)) != W25QXX_OK) {
+        kv->state[sector] = KV_SECTOR_DIRTY;
+        return W25QXX_ERROR;
+    }
+
+    if (kv->state[sector] != KV_SECTOR_FREE) {
+        kv->free_num++;
+    }
+    kv->state[sector] = KV_SECTOR_FREE;
+    kv->used[sector] = KV_HEADER_SIZE;
+    kv->live[sector] = 0;
+
+    return W25QXX_OK;
+}
+
+/**
+ * @brief 打开擦除次数最少的空闲扇区作为活动扇区
+ *
+ * @param kv 存储区句柄
+ * @return 操作结果
+ */
+static w25qxx_result_t kv_open_sector(w25qxx_kv_t *kv) {
+    uint16_t sector = KV_INVALID;
+    uint32_t seq[2];
+    uint16_t i;
+
+    for (i = 0; i < kv->sector_num; ++i) {
+        if (kv->state[i] == KV_SECTOR_FREE &&
+            (sector == KV_INVALID ||
+             kv->erase_cnt[i] < kv->erase_cnt[sector])) {
+            sector = i;
+        }
+    }
+
+    if (sector == KV_INVALID) {
+        return W25QXX_ERROR;
+    }
+
+    seq[0] = kv->next_seq;
+    seq[1] = ~kv->next_seq;
+    if (w25qxx_program(kv->w25qxx, kv_addr(kv, sector, 8),
+                       (const uint8_t *)seq, sizeof(seq)) != W25QXX_OK) {
+        return W25QXX_ERROR;
+    }
+
+    kv->state[sector] = KV_SECTOR_USED;
+    kv->seq[sector] = kv->next_seq++;
+    kv->free_num--;
+    kv->active = sector;
+
+    return W25QXX_OK;
+}
+
+/**
+ * @brief 在活动扇区末尾追加一条记录并更新索引
+ *
+ * @param kv 存储区句柄
+ * @param key 键
+ * @param value 值, 可以指向 kv->buf 中的数据区
+ * @param len 值长度, 删除标记为 `KV_TOMBSTONE_LEN`
+ * @return 操作结果, 新键超出 `W25QXX_KV_MAX_KEYS` 时返回 `W25QXX_ERROR`
+ * @note 先写入记录头和数据, 再写提交标志, 掉电时不会留下半条有效记录
+ */
+static w25qxx_result_t kv_append(w25qxx_kv_t *kv, uint16_t key,
+                                 const void *value, uint16_t len) {
+    uint16_t size = kv_record_size(len);
+    uint16_t data_len = (len == KV_TOMBSTONE_LEN) ? 0 : len;
+    uint8_t *record = kv->buf;
+    uint16_t offset;
+    uint8_t commit = KV_COMMITTED;
+    uint16_t crc;
+    uint16_t pos;
+
+    /* 索引放不下的记录不能写入, 否则重新挂载时会多出一个键 */
+    if (kv->index_num >= W25QXX_KV_MAX_KEYS && !kv_index_find(kv, key, &pos)) {
+        return W25QXX_ERROR;
+    }
+
+    if (kv->used[kv->active] + size > W25QXX_SECTOR_SIZE) {
+        if (kv_open_sector(kv) != W25QXX_OK) {
+            return W25QXX_ERROR;
+        }
+    }
+    offset = kv->used[kv->active];
+
+    record[0] = 0xFF;
+    record[1] = (len == KV_TOMBSTONE_LEN) ? KV_FLAG_TOMBSTONE : KV_FLAG_NORMAL;
+    record[2] = (uint8_t)key;
+    record[3] = (uint8_t)(key >> 8);
+    record[4] = (uint8_t)data_len;
+    record[5] = (uint8_t)(data_len >> 8);
+    if (data_len != 0 && value != &record[KV_RECORD_SIZE]) {
+        memcpy(&record[KV_RECORD_SIZE], value, data_len);
+    }
+    crc = kv_record_crc(record, data_len);
+    record[6] = (uint8_t)crc;
+    record[7] = (uint8_t)(crc >> 8);
+
+    /* 无论成功与否, 这段空间都不能再用了 */
+    kv->used[kv->active] += size;
+
+    if (w25qxx_program(kv->w25qxx, kv_addr(kv, kv->active, offset), record,
+                       KV_RECORD_SIZE + data_len) != W25QXX_OK) {
+        return W25QXX_ERROR;
+    }
+    if (w25qxx_program(kv->w25qxx, kv_addr(kv, kv->active, offset), &commit,
+                       1) != W25QXX_OK) {
+        return W25QXX_ERROR;
+    }
+    kv->stats.flash_bytes += size;
+
+    return kv_index_put(kv, key, kv->active, offset, len);
+}
+
+/**
+ * @brief 选择回收的扇区
+ *
+ * @param kv 存储区句柄
+ * @return 扇区, 没有可回收的扇区时为 `KV_INVALID`
+ * @note 擦除次数相差超过 `W25QXX_KV_WEAR_DELTA` 时选择擦除次数最少的扇区,
+ *       否则选择有效数据最少的扇区
+ */
+static uint16_t kv_gc_pick(w25qxx_kv_t *kv) {
+    uint16_t victim = KV_INVALID, coldest = KV_INVALID;
+    uint32_t max_erase = 0;
+    uint16_t i;
+
+    for (i = 0; i < kv->sector_num; ++i) {
+        if (kv->erase_cnt[i] > max_erase) {
+            max_erase = kv->erase_cnt[i];
+        }
+
+        if (kv->state[i] != KV_SECTOR_USED || i == kv->active) {
+            continue;
+        }
+
+        if (victim == KV_INVALID || kv->live[i] < kv->live[victim] ||
+            (kv->live[i] == kv->live[victim] &&
+             kv->erase_cnt[i] < kv->erase_cnt[victim])) {
+            victim = i;
+        }
+        if (coldest == KV_INVALID ||
+            kv->erase_cnt[i] < kv->erase_cnt[coldest]) {
+            coldest = i;
+        }
+    }
+
+    if (coldest != KV_INVALID &&
+        max_erase - kv->erase_cnt[coldest] > W25QXX_KV_WEAR_DELTA) {
+        return coldest;
+    }
+
+    return victim;
+}
+
+/**
+ * @brief 回收扇区: 搬移有效记录后擦除
+ *
+ * @param kv 存储区句柄
+ * @param victim 回收的扇区
+ * @return 操作结果
+ * @note 删除标记只有在扇区是最旧的扇区时才丢弃, 否则更旧扇区中的
+ *       记录会在掉电重启后重新生效
+ */
+static w25qxx_result_t kv_gc_sector(w25qxx_kv_t *kv, uint16_t victim) {
+    w25qxx_kv_index_t *entry;
+    bool oldest = true;
+    uint16_t i;
+
+    for (i = 0; i < kv->sector_num; ++i) {
+        if (kv->state[i] == KV_SECTOR_USED && kv->seq[i] < kv->seq[victim]) {
+            oldest = false;
+            break;
+        }
+    }
+
+    for (i = 0; i < kv->index_num; ++i) {
+        entry = &kv->index[i];
+        if (entry->sector != victim) {
+            continue;
+        }
+
+        if (entry->len == KV_TOMBSTONE_LEN) {
+            if (oldest) {
+                kv_index_remove(kv, i--);
+                continue;
+            }
+        } else if (w25qxx_read(kv->w25qxx,
+                               kv_addr(kv, victim,
+                                       entry->offset + KV_RECORD_SIZE),
+                               &kv->buf[KV_RECORD_SIZE],
+                               entry->len) != W25QXX_OK) {
+            return W25QXX_ERROR;
+        }
+
+        if (kv_append(kv, entry->key, &kv->buf[KV_RECORD_SIZE], entry->len) !=
+            W25QXX_OK) {
+            return W25QXX_ERROR;
+        }
+        kv->stats.gc_copies++;
+    }
+
+    return kv_erase_sector(kv, victim);
+}
+
+/**
+ * @brief 保证活动扇区能写入 size 字节的记录
+ *
+ * @param kv 存储区句柄
+ * @param size 记录长度
+ * @return 操作结果
+ * @note 需要打开新扇区时, 至少保留一个空闲扇区给回收使用
+ */
+static w25qxx_result_t kv_reserve(w25qxx_kv_t *kv, uint16_t size) {
+    uint16_t victim;
+    uint16_t i;
+
+    if (kv->used[kv->active] + size <= W25QXX_SECTOR_SIZE) {
+        return W25QXX_OK;
+    }
+
+    for (i = 0; i < kv->sector_num && kv->free_num < 2; ++i) {
+        victim = kv_gc_pick(kv);
+        if (victim == KV_INVALID || kv->live[victim] >= KV_DATA_SIZE - size) {
+            break;
+        }
+        if (kv_gc_sector(kv, victim) != W25QXX_OK) {
+            return W25QXX_ERROR;
+        }
+        if (kv->used[kv->active] + size <= W25QXX_SECTOR_SIZE) {
+            return W25QXX_OK;
+        }
+    }
+
+    return (kv->free_num >= 2) ? W25QXX_OK : W25QXX_ERROR;
+}
+
+/**
+ * @brief 扫描扇区中的记录, 重建索引
+ *
+ * @param kv 存储区句柄
+ * @param sector 扇区
+ * @return 操作结果, 键的数量超出 `W25QXX_KV_MAX_KEYS` 时返回 `W25QXX_ERROR`
+ */
+static w25qxx_result_t kv_scan_sector(w25qxx_kv_t *kv, uint16_t sector) {
+    uint8_t *record = kv->buf;
+    uint16_t offset = KV_HEADER_SIZE;
+    uint16_t key, len, size, crc;
+    uint8_t i;
+
+    while (offset + KV_RECORD_SIZE <= W25QXX_SECTOR_SIZE) {
+        if (w25qxx_read(kv->w25qxx, kv_addr(kv, sector, offset), record,
+                        KV_RECORD_SIZE) != W25QXX_OK) {
+            return W25QXX_ERROR;
+        }
+
+        for (i = 0; i < KV_RECORD_SIZE && record[i] == 0xFF; ++i) {
+        }
+        if (i == KV_RECORD_SIZE) {
+            /* 日志末尾 */
+            break;
+        }
+
+        key = record[2] | (record[3] << 8);
+        len = record[4] | (record[5] << 8);
+        crc = record[6] | (record[7] << 8);
+        size = kv_record_size(len);
+        if (len > W25QXX_KV_MAX_VALUE ||
+            offset + size > W25QXX_SECTOR_SIZE) {
+            /* 记录头损坏, 扇区剩余部分不再使用 */
+            offset = W25QXX_SECTOR_SIZE;
+            break;
+        }
+
+        if (record[0] == KV_COMMITTED &&
+            w25qxx_read(kv->w25qxx,
+                        kv_addr(kv, sector, offset + KV_RECORD_SIZE),
+                        &record[KV_RECORD_SIZE], len) == W25QXX_OK &&
+            kv_record_crc(record, len) == crc) {
+            if (record[1] == KV_FLAG_TOMBSTONE) {
+                len = KV_TOMBSTONE_LEN;
+            }
+            if (kv_index_put(kv, key, sector, offset, len) != W25QXX_OK) {
+                return W25QXX_ERROR;
+            }
+        }
+
+        offset += size;
+    }
+
+    kv->used[sector] = offset;
+    return W25QXX_OK;
+}
+
+/**
+ * @brief 检查扇区已写入部分之后是否全部为 0xFF
+ *
+ * @param kv 存储区句柄
+ * @param sector 扇区
+ * @param[out] blank 是否全部为 0xFF
+ * @return 操作结果
+ */
+static w25qxx_result_t kv_check_blank(w25qxx_kv_t *kv, uint16_t sector,
+                                      bool *blank) {
+    uint32_t offset = kv->used[sector];
+    uint32_t len, i;
+
+    *blank = true;
+    while (offset < W25QXX_SECTOR_SIZE) {
+        len = W25QXX_SECTOR_SIZE - offset;
+        if (len > sizeof(kv->buf)) {
+            len = sizeof(kv->buf);
+        }
+        if (w25qxx_read(kv->w25qxx, kv_addr(kv, sector, offset), kv->buf,
+                        len) != W25QXX_OK) {
+            return W25QXX_ERROR;
+        }
+        for (i = 0; i < len; ++i) {
+            if (kv->buf[i] != 0xFF) {
+                *blank = false;
+                return W25QXX_OK;
+            }
+        }
+        offset += len;
+    }
+
+    return W25QXX_OK;
+}
+
+/**
+ * @brief 挂载存储区, 扫描所有扇区重建索引
+ *
+ * @param kv 存储区句柄
+ * @param w25qxx 已初始化的芯片句柄
+ * @param first_sector 存储区第一个扇区
+ * @param sector_num 存储区扇区数 (至少 3 个)
+ * @return 操作结果, 存储区中的键超出 `W25QXX_KV_MAX_KEYS` 时返回
+ *         `W25QXX_ERROR`
+ * @note 未格式化或内容无效的扇区会被擦除, 第一次挂载可能较慢.
+ *       活动扇区日志末尾之后不全为 0xFF 时 (掉电时记录只写了一部分),
+ *       该扇区不再追加, 改为打开新的扇区.
+ */
+w25qxx_result_t w25qxx_kv_mount(w25qxx_kv_t *kv, w25qxx_handle_t *w25qxx,
+                                uint32_t first_sector, uint16_t sector_num) {
+    uint32_t header[4];
+    uint32_t max_erase = 0;
+    uint32_t scanned = 0;
+    uint16_t sector, i;
+    bool blank;
+
+    if (kv == NULL || w25qxx == NULL || sector_num < 3 ||
+        sector_num > W25QXX_KV_MAX_SECTORS) {
+        return W25QXX_ERROR;
+    }
+
+    memset(kv, 0, sizeof(w25qxx_kv_t));
+    kv->w25qxx = w25qxx;
+    kv->first_sector = first_sector;
+    kv->sector_num = sector_num;
+    kv->active = KV_INVALID;
+
+    for (i = 0; i < sector_num; ++i) {
+        if (w25qxx_read(w25qxx, kv_addr(kv, i, 0), (uint8_t *)header,
+                        sizeof(header)) != W25QXX_OK) {
+            return W25QXX_ERROR;
+        }
+
+        kv->used[i] = KV_HEADER_SIZE;
+        if (header[0] != KV_MAGIC) {
+            /* 未格式化, 或者擦除后没来得及写扇区头 */
+            kv->state[i] = KV_SECTOR_DIRTY;
+            continue;
+        }
+
+        kv->erase_cnt[i] = header[1];
+        if (header[1] > max_erase) {
+            max_erase = header[1];
+        }
+
+        if (header[2] == 0xFFFFFFFFU && header[3] == 0xFFFFFFFFU) {
+            kv->state[i] = KV_SECTOR_FREE;
+            kv->free_num++;
+        } else if (header[2] == ~header[3]) {
+            kv->state[i] = KV_SECTOR_USED;
+            kv->seq[i] = header[2];
+            if (header[2] >= kv->next_seq) {
+                kv->next_seq = header[2] + 1;
+            }
+        } else {
+            kv->state[i] = KV_SECTOR_DIRTY;
+        }
+    }
+
+    /* 按序号从旧到新扫描, 新记录覆盖旧记录 */
+    for (;;) {
+        sector = KV_INVALID;
+        for (i = 0; i < sector_num; ++i) {
+            if (kv->state[i] == KV_SECTOR_USED && !(scanned & (1UL << i)) &&
+                (sector == KV_INVALID || kv->seq[i] < kv->seq[sector])) {
+                sector = i;
+            }
+        }
+        if (sector == KV_INVALID) {
+            break;
+        }
+
+        scanned |= 1UL << sector;
+        if (kv_scan_sector(kv, sector) != W25QXX_OK) {
+            return W25QXX_ERROR;
+        }
+        if (kv->active == KV_INVALID ||
+            kv->seq[sector] > kv->seq[kv->active]) {
+            kv->active = sector;
+        }
+    }
+
+    for (i = 0; i < sector_num; ++i) {
+        if (kv->state[i] == KV_SECTOR_DIRTY) {
+            /* 擦除次数未知的扇区按当前最大值计 */
+            if (kv->erase_cnt[i] < max_erase) {
+                kv->erase_cnt[i] = max_erase;
+            }
+            if (kv_erase_sector(kv, i) != W25QXX_OK) {
+                return W25QXX_ERROR;
+            }
+        }
+    }
+
+    if (kv->active == KV_INVALID) {
+        return kv_open_sector(kv);
+    }
+
+    if (kv_check_blank(kv, kv->active, &blank) != W25QXX_OK) {
+        return W25QXX_ERROR;
+    }
+    if (!blank) {
+        /* 在非空白处编程会损坏数据, 封存该扇区 */
+        kv->used[kv->active] = W25QXX_SECTOR_SIZE;
+        if (kv->free_num != 0) {
+            return kv_open_sector(kv);
+        }
+        /* 没有空闲扇区时, 下次写入由 `kv_reserve` 回收后再打开 */
+    }
+
+    return W25QXX_OK;
+}
+
+/**
+ * @brief 格式化存储区, 擦除全部扇区
+ *
+ * @param kv 已挂载的存储区句柄
+ * @return 操作结果
+ */
+w25qxx_result_t w25qxx_kv_format(w25qxx_kv_t *kv) {
+    uint16_t i;
+
+    if (kv == NULL || kv->w25qxx == NULL) {
+        return W25QXX_ERROR;
+    }
+
+    kv->index_num = 0;
+    for (i = 0; i < kv->sector_num; ++i) {
+        if (kv->state[i] == KV_SECTOR_FREE && kv->used[i] == KV_HEADER_SIZE) {
+            continue;
+        }
+        if (kv_erase_sector(kv, i) != W25QXX_OK) {
+            return W25QXX_ERROR;
+        }
+    }
+
+    return kv_open_sector(kv);
+}
+
+/**
+ * @brief 写入键值
+ *
+ * @param kv 存储区句柄
+ * @param key 键 (0xFFFF 保留)
+ * @param value 值
+ * @param len 值长度, 不超过 `W25QXX_KV_MAX_VALUE`
+ * @return 操作结果
+ * @note 一般只需要编程一条记录; 活动扇区写满且空闲扇区不足时才会在前台回收
+ */
+w25qxx_result_t w25qxx_kv_set(w25qxx_kv_t *kv, uint16_t key, const void *value,
+                              uint16_t len) {
+    if (kv == NULL || key == KV_INVALID || len > W25QXX_KV_MAX_VALUE ||
+        (value == NULL && len != 0)) {
+        return W25QXX_ERROR;
+    }
+
+    if (kv_reserve(kv, kv_record_size(len)) != W25QXX_OK) {
+        return W25QXX_ERROR;
+    }
+
+    kv->stats.user_bytes += len;
+    return kv_append(kv, key, value, len);
+}
+
+/**
+ * @brief 读取键值
+ *
+ * @param kv 存储区句柄
+ * @param key 键
+ * @param[out] value 值缓冲区
+ * @param size 缓冲区大小, 值超出的部分不读取
+ * @param[out] len 值的实际长度, 可以为 NULL
+ * @return 操作结果, 键不存在时返回 `W25QXX_ERROR`
+ */
+w25qxx_result_t w25qxx_kv_get(w25qxx_kv_t *kv, uint16_t key, void *value,
+                              uint16_t size, uint16_t *len) {
+    w25qxx_kv_index_t *entry;
+    uint16_t pos;
+
+    if (kv == NULL || !kv_index_find(kv, key, &pos)) {
+        return W25QXX_ERROR;
+    }
+
+    entry = &kv->index[pos];
+    if (entry->len == KV_TOMBSTONE_LEN) {
+        return W25QXX_ERROR;
+    }
+
+    if (len != NULL) {
+        *len = entry->len;
+    }
+    if (size > entry->len) {
+        size = entry->len;
+    }
+    if (size == 0) {
+        return W25QXX_OK;
+    }
+
+    return w25qxx_read(kv->w25qxx,
+                       kv_addr(kv, entry->sector,
+                               entry->offset + KV_RECORD_SIZE),
+                       (uint8_t *)value, size);
+}
+
+/**
+ * @brief 删除键值
+ *
+ * @param kv 存储区句柄
+ * @param key 键
+ * @return 操作结果, 键不存在时也返回 `W25QXX_OK`
+ */
+w25qxx_result_t w25qxx_kv_delete(w25qxx_kv_t *kv, uint16_t key) {
+    uint16_t pos;
+
+    if (kv == NULL) {
+        return W25QXX_ERROR;
+    }
+
+    if (!kv_index_find(kv, key, &pos) ||
+        kv->index[pos].len == KV_TOMBSTONE_LEN) {
+        return W25QXX_OK;
+    }
+
+    if (kv_reserve(kv, KV_RECORD_SIZE) != W25QXX_OK) {
+        return W25QXX_ERROR;
+    }
+
+    return kv_append(kv, key, NULL, KV_TOMBSTONE_LEN);
+}
+
+/**
+ * @brief 后台回收, 每次最多回收一个扇区
+ *
+ * @param kv 存储区句柄
+ * @return 操作结果
+ * @note 在低优先级任务中周期调用. 优先擦除没有有效数据的扇区, 空闲扇区少于
+ *       `W25QXX_KV_GC_FREE_SECTORS` 或擦除次数相差过大时回收一个扇区.
+ */
+w25qxx_result_t w25qxx_kv_gc_step(w25qxx_kv_t *kv) {
+    uint32_t max_erase = 0;
+    uint16_t coldest = KV_INVALID;
+    uint16_t i;
+
+    if (kv == NULL || kv->w25qxx == NULL) {
+        return W25QXX_ERROR;
+    }
+
+    for (i = 0; i < kv->sector_num; ++i) {
+        if (kv->erase_cnt[i] > max_erase) {
+            max_erase = kv->erase_cnt[i];
+        }
+        if (kv->state[i] != KV_SECTOR_USED || i == kv->active) {
+            continue;
+        }
+        if (kv->live[i] == 0) {
+            return kv_gc_sector(kv, i);
+        }
+        if (coldest == KV_INVALID ||
+            kv->erase_cnt[i] < kv->erase_cnt[coldest]) {
+            coldest = i;
+        }
+    }
+
+    if (coldest == KV_INVALID || kv->free_num == 0) {
+        return W25QXX_OK;
+    }
+
+    if (kv->free_num < W25QXX_KV_GC_FREE_SECTORS ||
+        max_erase - kv->erase_cnt[coldest] > W25QXX_KV_WEAR_DELTA) {
+        return kv_gc_sector(kv, kv_gc_pick(kv));
+    }
+
+    return W25QXX_OK;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file    w25qxx_kv.h
+ * @brief   基于 W25QXX 的日志结构键值存储
+ *
+ *****************************************************************************
+ * 存储区由若干连续扇区组成, 数据只追加写入当前活动扇区, 不做读改写:
+ *  - 扇区头: 魔数, 擦除次数, 扇区序号 (序号及其反码, 打开扇区时写入)
+ *  - 记录:   提交标志, 标志, 键, 长度, CRC, 数据 (4 字节对齐)
+ * 记录先写入头和数据, 再把提交标志由 0xFF 改写为 0x00, 掉电时未提交或
+ * CRC 错误的记录在挂载时被忽略. 同一个键以序号最大扇区中最后的记录为准.
+ *
+ * 空闲扇区不足时回收有效数据最少的扇区 (把有效记录搬到活动扇区后擦除),
+ * 擦除次数相差过大时优先回收擦除次数最少的扇区, 把冷数据搬走, 实现磨损均衡.
+ * 回收可以在后台任务中调用 `w25qxx_kv_gc_step` 完成, 写入时一般只有编程操作.
+ *
+ * 同一个存储区的函数不可重入, 多任务使用时需要调用者加锁.
+ *****************************************************************************
+ */
+
+#ifndef __W25QXX_KV_H
+#define __W25QXX_KV_H
+
+#include "w25qxx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* 扇区大小 */
+#define W25QXX_SECTOR_SIZE        4096
+/* 存储区最多扇区数 */
+#define W25QXX_KV_MAX_SECTORS     32
+/* 最多键数量 (包括删除标记) */
+#define W25QXX_KV_MAX_KEYS        64
+/* 单个值的最大长度 (byte) */
+#define W25QXX_KV_MAX_VALUE       256
+/* 空闲扇区少于该值时后台回收 */
+#define W25QXX_KV_GC_FREE_SECTORS 2
+/* 擦除次数相差超过该值时搬移冷数据 */
+#define W25QXX_KV_WEAR_DELTA      64
+
+/**
+ * @brief 内存索引项
+ */
+typedef struct {
+    uint16_t key;    /*!< 键 */
+    uint16_t sector; /*!< 记录所在扇区 (相对存储区) */
+    uint16_t offset; /*!< 记录在扇区内的偏移 */
+    uint16_t len;    /*!< 值长度, 删除标记为 0xFFFF */
+} w25qxx_kv_index_t;
+
+/**
+ * @brief 统计信息, 写放大 = flash_bytes / user_bytes
+ */
+typedef struct {
+    uint32_t user_bytes;  /*!< 用户写入的数据量 */
+    uint32_t flash_bytes; /*!< 实际编程的数据量 (含记录头和回收搬移) */
+    uint32_t gc_copies;   /*!< 回收时搬移的记录数 */
+    uint32_t erases;      /*!< 擦除次数 */
+} w25qxx_kv_stats_t;
+
+/**
+ * @brief 键值存储句柄
+ */
+typedef struct {
+    w25qxx_handle_t *w25qxx; /*!< 芯片句柄 */
+    uint32_t first_sector;   /*!< 存储区第一个扇区 */
+    uint16_t sector_num;     /*!< 存储区扇区数 */
+
+    uint16_t active;    /*!< 活动扇区 */
+    uint32_t next_seq;  /*!< 下一个打开扇区的序号 */
+    uint16_t free_num;  /*!< 空闲扇区数 */
+    uint16_t index_num; /*!< 索引项数量 */
+
+    uint8_t state[W25QXX_KV_MAX_SECTORS];     /*!< 扇区状态 */
+    uint32_t seq[W25QXX_KV_MAX_SECTORS];       /*!< 扇区序号 */
+    uint32_t erase_cnt[W25QXX_KV_MAX_SECTORS]; /*!< 扇区擦除次数 */
+    uint16_t used[W25QXX_KV_MAX_SECTORS];      /*!< 扇区已写入长度 */
+    uint16_t live[W25QXX_KV_MAX_SECTORS];      /*!< 扇区有效记录长度 */
+
+    w25qxx_kv_index_t index[W25QXX_KV_MAX_KEYS]; /*!< 按键排序的索引 */
+    uint8_t buf[8 + W25QXX_KV_MAX_VALUE];        /*!< 记录缓冲区 */
+
+    w25qxx_kv_stats_t stats; /*!< 统计信息 */
+} w25qxx_kv_t;
+
+w25qxx_result_t w25qxx_kv_mount(w25qxx_kv_t *kv, w25qxx_handle_t *w25qxx,
+                                uint32_t first_sector, uint16_t sector_num);
+w25qxx_result_t w25qxx_kv_format(w25qxx_kv_t *kv);
+w25qxx_result_t w25qxx_kv_set(w25qxx_kv_t *kv, uint16_t key, const void *value,
+                              uint16_t len);
+w25qxx_result_t w25qxx_kv_get(w25qxx_kv_t *kv, uint16_t key, void *value,
+                              uint16_t size, uint16_t *len);
+w25qxx_result_t w25qxx_kv_delete(w25qxx_kv_t *kv, uint16_t key);
+w25qxx_result_t w25qxx_kv_gc_step(w25qxx_kv_t *kv);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __W25QXX_KV_H */
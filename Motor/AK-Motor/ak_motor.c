@@ -71,6 +71,9 @@ static const float ak_mit_param_limit[7][2] = {
     {50.0f, 65.0f}, {45.0f, 15.0f}, {50.0f, 25.0f}, {76.0f, 12.0f},
     {50.0f, 18.0f}, {8.0f, 144.0f}, {37.5f, 32.0f}};
 
+/* 各型号 MIT 帧编解码参数, 在 ak_motor_init 中按型号计算 */
+static mit_codec_t ak_mit_codec[AK_MODEL_RESERVE];
+
 /**
  * @}
  */
@@ -96,20 +99,9 @@ static void ak_can_callback(void *can_ptr, can_rx_header_t *can_rx_header,
 
     } else if (can_rx_header->id_type == CAN_ID_STD) {
         /* 标准帧，运控模式 */
-        uint16_t pos_int = (recv_msg[1] << 8) | recv_msg[2];
-        uint16_t spd_int = (recv_msg[3] << 4) | (recv_msg[4] >> 4);
-        uint16_t torq_int = ((recv_msg[4] & 0xF) << 8) | recv_msg[5];
-
-        ak_target->pos = uint_to_float(pos_int, -AK_MIT_POSITION_LIMIT,
-                                       AK_MIT_POSITION_LIMIT, 16);
-        ak_target->spd = uint_to_float(
-            spd_int,
-            -ak_mit_param_limit[ak_target->model][MIT_SPEED_LIMIT_INDEX],
-            ak_mit_param_limit[ak_target->model][MIT_SPEED_LIMIT_INDEX], 12);
-        ak_target->current_troq = uint_to_float(
-            torq_int,
-            -ak_mit_param_limit[ak_target->model][MIT_TORQUE_LIMMIT_INDEX],
-            ak_mit_param_limit[ak_target->model][MIT_TORQUE_LIMMIT_INDEX], 12);
+        mit_unpack_feedback(&ak_mit_codec[ak_target->model], &recv_msg[1],
+                            &ak_target->pos, &ak_target->spd,
+                            &ak_target->current_troq);
     }
 
     ak_target->motor_temperature = recv_msg[6];
@@ -155,6 +147,11 @@ uint8_t ak_motor_init(ak_motor_handle_t *motor, uint32_t id, ak_model_t model,
         return 3;
     }
 
+    mit_codec_init(&ak_mit_codec[model], AK_MIT_POSITION_LIMIT,
+                   ak_mit_param_limit[model][MIT_SPEED_LIMIT_INDEX],
+                   AK_MIT_KP_LIMIT, AK_MIT_KD_LIMIT,
+                   ak_mit_param_limit[model][MIT_TORQUE_LIMMIT_INDEX]);
+
     if (can_list_add_new_node(can_select, (void *)motor, id, 0xFF, id_type,
                               ak_can_callback) != 0) {
         return 2;
@@ -428,30 +425,9 @@ void ak_mit_send_data(ak_motor_handle_t *motor, float pos, float spd, float kp,
     if (motor == NULL) {
         return;
     }
-    /* 转换成整数 */
-    int16_t pos_int =
-        float_to_uint(pos, -AK_MIT_POSITION_LIMIT, AK_MIT_POSITION_LIMIT, 16);
-    int16_t spd_int = float_to_uint(
-        spd, -ak_mit_param_limit[motor->model][MIT_SPEED_LIMIT_INDEX],
-        ak_mit_param_limit[motor->model][MIT_SPEED_LIMIT_INDEX], 12);
-    int16_t kp_int = float_to_uint(kp, 0, AK_MIT_KP_LIMIT, 12);
-    int16_t kd_int = float_to_uint(kd, 0, AK_MIT_KD_LIMIT, 12);
-    int16_t torque_int = float_to_uint(
-        torque, -ak_mit_param_limit[motor->model][MIT_TORQUE_LIMMIT_INDEX],
-        ak_mit_param_limit[motor->model][MIT_TORQUE_LIMMIT_INDEX], 12);
-
-    /* 填充缓冲区 */
+    /* 转换成整数并填充缓冲区 */
     uint8_t data[8];
-    data[0] = pos_int >> 8;   /* 位置高 8 位 */
-    data[1] = pos_int & 0xFF; /* 位置低 8 位 */
-    data[2] = spd_int >> 4;   /* 速度高 8 位 */
-    data[3] =
-        ((spd_int & 0xF) << 4) | (kp_int >> 8); /* 速度低 4 位，kp 高 4 位 */
-    data[4] = kp_int & 0xFF;                    /* kp 低 8 位 */
-    data[5] = kd_int >> 4;                      /* kd 高 8 位 */
-    data[6] =
-        ((kd_int & 0xF) << 4) | (torque_int >> 8); /* kp 低 4 位，扭矩高 4 位 */
-    data[7] = torque_int & 0xFF;                   /* 扭矩低 8 位 */
+    mit_pack_cmd(&ak_mit_codec[motor->model], data, pos, spd, kp, kd, torque);
     can_send_message(motor->can_select, CAN_ID_STD, motor->id, 8, data);
 }
 
@@ -10,6 +10,60 @@
 
 #include "can_list/can_list.h"
 
+#include <string.h>
+
+#if (DJI_MOTOR_USE_TX_STAGE == 1)
+
+/**
+ * @brief 发送分组, 按标识符命名
+ */
+typedef enum {
+#if (DJI_MOTOR_USE_M3508_2006 == 1)
+    DJI_TX_0x200, /*!< M3508/2006 0x201 ~ 0x204 */
+#endif            /* DJI_MOTOR_USE_M3508_2006 == 1 */
+    DJI_TX_0x1FF, /*!< M3508/2006 0x205 ~ 0x208, GM6020 电压 0x205 ~ 0x208 */
+#if (DJI_MOTOR_USE_GM6020 == 1)
+    DJI_TX_0x2FF, /*!< GM6020 电压 0x209 ~ 0x20B */
+    DJI_TX_0x1FE, /*!< GM6020 电流 0x205 ~ 0x208 */
+    DJI_TX_0x2FE, /*!< GM6020 电流 0x209 ~ 0x20B */
+#endif            /* DJI_MOTOR_USE_GM6020 == 1 */
+    DJI_TX_GROUP_NUMBER
+} dji_tx_group_t;
+
+/* 各发送分组对应的标识符 */
+static const uint16_t dji_tx_identify[DJI_TX_GROUP_NUMBER] = {
+#if (DJI_MOTOR_USE_M3508_2006 == 1)
+    0x200,
+#endif /* DJI_MOTOR_USE_M3508_2006 == 1 */
+    0x1FF,
+#if (DJI_MOTOR_USE_GM6020 == 1)
+    0x2FF,
+    0x1FE,
+    0x2FE,
+#endif /* DJI_MOTOR_USE_GM6020 == 1 */
+};
+
+/**
+ * @brief 一个 CAN 的发送暂存
+ * @note 提交与发送可以在不同任务或中断中进行, 暂存的读写都在临界区内。
+ */
+typedef struct {
+    int16_t value[DJI_TX_GROUP_NUMBER][4]; /*!< 各电机设定值 */
+    uint8_t dirty[DJI_TX_GROUP_NUMBER];    /*!< 分组是否需要发送 */
+    uint32_t pending_posts;                /*!< 上次发送后提交的次数 */
+    dji_motor_tx_stats_t stats;            /*!< 统计 */
+} dji_tx_stage_t;
+
+static dji_tx_stage_t dji_tx_stage[CAN_LIST_MAX_CAN_NUMBER];
+
+/* 暂存在任务中提交, 在任务或定时器中断中发送 */
+#define DJI_TX_ENTER_CRITICAL()                                                \
+    uint32_t primask = __get_PRIMASK();                                        \
+    __disable_irq()
+#define DJI_TX_EXIT_CRITICAL() __set_PRIMASK(primask)
+
+#endif /* DJI_MOTOR_USE_TX_STAGE == 1 */
+
 /**
  * @brief CAN 收到消息中断回调
  *
@@ -133,6 +187,7 @@ uint8_t dji_motor_init(dji_motor_handle_t *motor, dji_motor_model_t motor_model,
     }
 
     motor->motor_model = motor_model;
+    motor->motor_id = can_id;
     motor->got_offset = false;
     motor->can_select = can_select;
     if (can_list_add_new_node(can_select, (void *)motor, can_id, 0x7FF,
@@ -272,3 +327,193 @@ void dji_gm6020_current_control(can_selected_t can_select,
 }
 
 #endif /* DJI_MOTOR_USE_GM6020 == 1 */
+
+#if (DJI_MOTOR_USE_TX_STAGE == 1)
+
+/**
+ * @brief 将设定值写入发送暂存
+ *
+ * @param motor 电机结构体指针
+ * @param group 发送分组
+ * @param index 电机在帧中的位置 (0 ~ 3)
+ * @param value 设定值
+ */
+static void dji_tx_stage_write(dji_motor_handle_t *motor, dji_tx_group_t group,
+                               uint32_t index, int16_t value) {
+    dji_tx_stage_t *stage = &dji_tx_stage[motor->can_select];
+
+    motor->set_value = value;
+
+    DJI_TX_ENTER_CRITICAL();
+    stage->value[group][index] = value;
+    stage->dirty[group] = 1;
+    ++stage->pending_posts;
+    ++stage->stats.posts;
+    DJI_TX_EXIT_CRITICAL();
+}
+
+/**
+ * @brief 提交电机设定值，在 `dji_motor_flush` 时发送
+ *
+ * @param motor 电机结构体指针
+ * @param value 设定值. M3508/2006 为电流，GM6020 为电压
+ * @return 提交状态:
+ * @retval - 0: 成功
+ * @retval - 1: `motor`为空或 CAN 不合法
+ * @retval - 2: 电机型号与 ID 不匹配
+ */
+uint8_t dji_motor_post(dji_motor_handle_t *motor, int16_t value) {
+    if (motor == NULL || motor->can_select >= CAN_LIST_MAX_CAN_NUMBER) {
+        return 1;
+    }
+
+    uint32_t id = motor->motor_id;
+
+    switch (motor->motor_model) {
+#if (DJI_MOTOR_USE_M3508_2006 == 1)
+        case DJI_M3508:
+        case DJI_M2006: {
+            if (id >= 0x201 && id <= 0x204) {
+                dji_tx_stage_write(motor, DJI_TX_0x200, id - 0x201,
+                                   value);
+            } else if (id >= 0x205 && id <= 0x208) {
+                dji_tx_stage_write(motor, DJI_TX_0x1FF, id - 0x205,
+                                   value);
+            } else {
+                return 2;
+            }
+        } break;
+#endif /* DJI_MOTOR_USE_M3508_2006 == 1 */
+
+#if (DJI_MOTOR_USE_GM6020 == 1)
+        case DJI_GM6020: {
+            if (id >= 0x205 && id <= 0x208) {
+                dji_tx_stage_write(motor, DJI_TX_0x1FF, id - 0x205,
+                                   value);
+            } else if (id >= 0x209 && id <= 0x20B) {
+                dji_tx_stage_write(motor, DJI_TX_0x2FF, id - 0x209,
+                                   value);
+            } else {
+                return 2;
+            }
+        } break;
+#endif /* DJI_MOTOR_USE_GM6020 == 1 */
+
+        default: {
+            return 2;
+        }
+    }
+
+    return 0;
+}
+
+#if (DJI_MOTOR_USE_GM6020 == 1)
+
+/**
+ * @brief 提交 GM6020 电流设定值，在 `dji_motor_flush` 时发送
+ *
+ * @param motor 电机结构体指针
+ * @param current 电流
+ * @return 提交状态:
+ * @retval - 0: 成功
+ * @retval - 1: `motor`为空或 CAN 不合法
+ * @retval - 2: 电机型号与 ID 不匹配
+ */
+uint8_t dji_gm6020_post_current(dji_motor_handle_t *motor, int16_t current) {
+    if (motor == NULL || motor->can_select >= CAN_LIST_MAX_CAN_NUMBER) {
+        return 1;
+    }
+
+    uint32_t id = motor->motor_id;
+
+    if (motor->motor_model != DJI_GM6020) {
+        return 2;
+    }
+
+    if (id >= 0x205 && id <= 0x208) {
+        dji_tx_stage_write(motor, DJI_TX_0x1FE, id - 0x205, current);
+    } else if (id >= 0x209 && id <= 0x20B) {
+        dji_tx_stage_write(motor, DJI_TX_0x2FE, id - 0x209, current);
+    } else {
+        return 2;
+    }
+
+    return 0;
+}
+
+#endif /* DJI_MOTOR_USE_GM6020 == 1 */
+
+/**
+ * @brief 发送暂存中有更新的分组，每个标识符最多发送一帧. 每个控制周期调用一次
+ *
+ * @param can_select 选择那个 CAN 发送
+ * @return 本次发送的帧数
+ */
+uint8_t dji_motor_flush(can_selected_t can_select) {
+    if (can_select >= CAN_LIST_MAX_CAN_NUMBER) {
+        return 0;
+    }
+
+    dji_tx_stage_t *stage = &dji_tx_stage[can_select];
+    int16_t value[DJI_TX_GROUP_NUMBER][4];
+    uint8_t dirty[DJI_TX_GROUP_NUMBER];
+    uint8_t send_msg[8];
+    uint8_t sent = 0;
+    uint32_t posts;
+
+    /* 在同一个临界区内取出所有分组和提交次数, 发送时提交的值和次数都算在
+     * 下个周期, 统计与发送的帧对应 */
+    {
+        DJI_TX_ENTER_CRITICAL();
+        memcpy(value, stage->value, sizeof(value));
+        memcpy(dirty, stage->dirty, sizeof(dirty));
+        memset(stage->dirty, 0, sizeof(stage->dirty));
+        posts = stage->pending_posts;
+        stage->pending_posts = 0;
+        DJI_TX_EXIT_CRITICAL();
+    }
+
+    for (uint32_t group = 0; group < DJI_TX_GROUP_NUMBER; ++group) {
+        if (dirty[group] == 0) {
+            continue;
+        }
+
+        for (uint32_t i = 0; i < 4; ++i) {
+            send_msg[i * 2] = (value[group][i] >> 8) & 0xFF;
+            send_msg[i * 2 + 1] = value[group][i] & 0xFF;
+        }
+
+        can_send_message(can_select, CAN_ID_STD, dji_tx_identify[group], 8,
+                         send_msg);
+        ++sent;
+    }
+
+    DJI_TX_ENTER_CRITICAL();
+    if (posts > sent) {
+        stage->stats.frames_saved += posts - sent;
+    }
+    stage->stats.frames_sent += sent;
+    stage->stats.bits_sent += sent * DJI_MOTOR_TX_FRAME_BITS;
+    DJI_TX_EXIT_CRITICAL();
+
+    return sent;
+}
+
+/**
+ * @brief 获取发送暂存统计
+ *
+ * @param can_select 选择哪个 CAN
+ * @param[out] stats 统计
+ */
+void dji_motor_get_tx_stats(can_selected_t can_select,
+                            dji_motor_tx_stats_t *stats) {
+    if (can_select >= CAN_LIST_MAX_CAN_NUMBER || stats == NULL) {
+        return;
+    }
+
+    DJI_TX_ENTER_CRITICAL();
+    *stats = dji_tx_stage[can_select].stats;
+    DJI_TX_EXIT_CRITICAL();
+}
+
+#endif /* DJI_MOTOR_USE_TX_STAGE == 1 */
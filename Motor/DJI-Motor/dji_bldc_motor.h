@@ -49,6 +49,20 @@ extern "C" {
 
 #endif /* DJI_MOTOR_USE_GM6020 == 1 */
 
+/**
+ * 是否使用发送暂存
+ *
+ * 启用后，每个电机可以通过 `dji_motor_post` 单独提交自己的设定值，
+ * 设定值被暂存在对应 CAN 的发送缓冲中。控制周期结束时调用一次
+ * `dji_motor_flush`，每个标识符最多发送一帧，没有更新的标识符不会发送。
+ */
+#define DJI_MOTOR_USE_TX_STAGE 1
+
+#if (DJI_MOTOR_USE_TX_STAGE == 1)
+/* 一帧标准帧 (8 字节数据) 在最坏位填充情况下的位数, 用于统计总线负载 */
+#define DJI_MOTOR_TX_FRAME_BITS 135
+#endif /* DJI_MOTOR_USE_TX_STAGE == 1 */
+
 /**
  * @brief 电机型号
  */
@@ -131,6 +145,18 @@ typedef struct {
     can_selected_t can_select;     /*!< 选择 CAN 通信 */
 } dji_motor_handle_t;
 
+#if (DJI_MOTOR_USE_TX_STAGE == 1)
+/**
+ * @brief 发送暂存统计
+ */
+typedef struct {
+    uint32_t posts;        /*!< 提交设定值的次数 */
+    uint32_t frames_sent;  /*!< 实际发送的帧数 */
+    uint32_t frames_saved; /*!< 合并后节省的帧数 */
+    uint32_t bits_sent;    /*!< 发送的总位数 (按最坏位填充估算) */
+} dji_motor_tx_stats_t;
+#endif /* DJI_MOTOR_USE_TX_STAGE == 1 */
+
 uint8_t dji_motor_init(dji_motor_handle_t *motor, dji_motor_model_t motor_model,
                        dji_can_id_t can_id, can_selected_t can_select);
 uint8_t dji_motor_deinit(dji_motor_handle_t *motor);
@@ -152,6 +178,16 @@ void dji_gm6020_current_control(can_selected_t can_select,
                                 int16_t current4);
 #endif /* DJI_MOTOR_USE_GM6020 == 1 */
 
+#if (DJI_MOTOR_USE_TX_STAGE == 1)
+uint8_t dji_motor_post(dji_motor_handle_t *motor, int16_t value);
+#if (DJI_MOTOR_USE_GM6020 == 1)
+uint8_t dji_gm6020_post_current(dji_motor_handle_t *motor, int16_t current);
+#endif /* DJI_MOTOR_USE_GM6020 == 1 */
+uint8_t dji_motor_flush(can_selected_t can_select);
+void dji_motor_get_tx_stats(can_selected_t can_select,
+                            dji_motor_tx_stats_t *stats);
+#endif /* DJI_MOTOR_USE_TX_STAGE == 1 */
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,435 @@
+/**
+ * @file    dji_motor_test.c
+ * @brief   发送暂存的主机测试. CAN 发送由测试记录, 检查合并后的帧与逐个
+ *          标识符调用原来的发送函数得到的帧相同; 再模拟定时器中断在
+ *          `dji_motor_flush` 的每一条指令处提交设定值, 检查临界区.
+ *
+ * 在 `Motor/DJI-Motor` 下编译运行:
+ *
+ *   gcc -std=gnu11 -g -O2 -Itest/stub -I. -I.. test/dji_motor_test.c \
+ *       dji_bldc_motor.c -o dji_motor_test
+ *   ./dji_motor_test
+ *
+ * 检查项:
+ *  - 每次 flush 每个有更新的标识符只发送一帧, 数据为各电机最后一次提交的
+ *    值, 没有更新的标识符和其它 CAN 的电机不发送
+ *  - 帧的内容与 `dji_motor_set_current` 等函数发送的相同
+ *  - 统计的提交次数、发送帧数和节省的帧数正确
+ *  - 中断 (SIGUSR1) 在 flush 的任意指令处提交同一帧中两个电机的设定值,
+ *    发送的帧不会只包含其中一个, 提交也不会丢失 (Linux, 用 ptrace 单步)
+ */
+
+#include "dji_bldc_motor.h"
+#include "can_list/can_list.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ptrace.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+/* 随机测试的控制周期数 */
+#define TEST_CYCLES 100000
+
+/*****************************************************************************
+ * 替身
+ */
+
+/* 发送的帧 */
+typedef struct {
+    can_selected_t can_select;
+    uint32_t id;
+    uint8_t data[8];
+} test_frame_t;
+
+static test_frame_t test_frame[64];
+static volatile uint32_t test_frame_num;
+
+uint32_t HAL_GetTick(void) {
+    return 0;
+}
+
+uint8_t can_send_message(can_selected_t can_select, uint32_t id_type,
+                         uint32_t can_id, uint8_t len, uint8_t *msg) {
+    CHECK(id_type == CAN_ID_STD && len == 8);
+    CHECK(test_frame_num < sizeof(test_frame) / sizeof(test_frame[0]));
+
+    test_frame[test_frame_num].can_select = can_select;
+    test_frame[test_frame_num].id = can_id;
+    memcpy(test_frame[test_frame_num].data, msg, 8);
+    ++test_frame_num;
+    return 0;
+}
+
+uint8_t can_list_add_new_node(can_selected_t can_select, void *node_data,
+                              uint32_t id, uint32_t id_mask, uint32_t id_type,
+                              can_callback_t callback) {
+    UNUSED(can_select);
+    UNUSED(node_data);
+    UNUSED(id);
+    UNUSED(id_mask);
+    UNUSED(id_type);
+    UNUSED(callback);
+    return 0;
+}
+
+uint8_t can_list_del_node_by_id(can_selected_t can_select, uint32_t id_type,
+                                uint32_t id) {
+    UNUSED(can_select);
+    UNUSED(id_type);
+    UNUSED(id);
+    return 0;
+}
+
+/* 模拟的 PRIMASK 和被挂起的中断 */
+static volatile uint32_t stub_primask;
+static volatile uint32_t stub_irq_pending;
+static void (*stub_isr)(void);
+
+uint32_t __get_PRIMASK(void) {
+    return stub_primask;
+}
+
+void __disable_irq(void) {
+    stub_primask = 1;
+}
+
+void __set_PRIMASK(uint32_t primask) {
+    stub_primask = primask;
+    if (primask == 0 && stub_irq_pending) {
+        stub_irq_pending = 0;
+        stub_isr();
+    }
+}
+
+/**
+ * @brief 中断到来, 关中断时挂起
+ */
+static void stub_irq_handler(int sig) {
+    UNUSED(sig);
+
+    if (stub_primask) {
+        stub_irq_pending = 1;
+    } else {
+        stub_isr();
+    }
+}
+
+/*****************************************************************************
+ * 合并发送
+ */
+
+static uint32_t test_rand_state = 1;
+
+static uint32_t test_rand(void) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return test_rand_state >> 8;
+}
+
+/* 一个 CAN 上的标识符, 与各电机在帧中的位置 */
+static const uint16_t test_identify[5] = {0x200, 0x1FF, 0x2FF, 0x1FE, 0x2FE};
+
+/**
+ * @brief 测试电机
+ */
+typedef struct {
+    dji_motor_model_t model;
+    dji_can_id_t id;
+    can_selected_t can_select;
+    uint8_t voltage_group;  /* dji_motor_post 写入的标识符 (test_identify) */
+    uint8_t current_group;  /* dji_gm6020_post_current 写入的, 0xFF 为没有 */
+    uint8_t index;          /* 在帧中的位置 */
+    dji_motor_handle_t handle;
+} test_motor_t;
+
+static test_motor_t test_motor[] = {
+    {DJI_M3508, CAN_Motor1_ID, can1_selected, 0, 0xFF, 0},
+    {DJI_M3508, CAN_Motor4_ID, can1_selected, 0, 0xFF, 3},
+    {DJI_M2006, CAN_Motor5_ID, can1_selected, 1, 0xFF, 0},
+    {DJI_GM6020, CAN_GM6020_ID2, can1_selected, 1, 3, 1},
+    {DJI_GM6020, CAN_GM6020_ID6, can1_selected, 2, 4, 1},
+    {DJI_M3508, CAN_Motor2_ID, can2_selected, 0, 0xFF, 1},
+};
+
+#define TEST_MOTOR_NUMBER (sizeof(test_motor) / sizeof(test_motor[0]))
+
+/* 按标识符记录的最后提交值和是否有更新 */
+static int16_t test_value[2][5][4];
+static uint8_t test_dirty[2][5];
+
+/**
+ * @brief 检查一次 flush 发送的帧
+ *
+ * @param can_select 发送的 CAN
+ * @return 应发送的帧数
+ */
+static uint32_t test_check_flush(can_selected_t can_select) {
+    uint32_t expected = 0;
+
+    for (uint32_t g = 0; g < 5; ++g) {
+        uint32_t found = 0;
+
+        for (uint32_t f = 0; f < test_frame_num; ++f) {
+            const test_frame_t *frame = &test_frame[f];
+
+            CHECK(frame->can_select == can_select);
+            if (frame->id != test_identify[g]) {
+                continue;
+            }
+            ++found;
+            for (uint32_t i = 0; i < 4; ++i) {
+                int16_t v = (int16_t)((frame->data[i * 2] << 8) |
+                                      frame->data[i * 2 + 1]);
+                CHECK(v == test_value[can_select][g][i]);
+            }
+        }
+
+        CHECK(found == test_dirty[can_select][g]);
+        expected += test_dirty[can_select][g];
+        test_dirty[can_select][g] = 0;
+    }
+
+    CHECK(test_frame_num == expected);
+    return expected;
+}
+
+/**
+ * @brief 每个周期随机提交若干次 (同一电机可能多次), 然后 flush
+ */
+static void test_coalesce(void) {
+    dji_motor_tx_stats_t stats;
+    uint32_t posts[2] = {0, 0}, sent[2] = {0, 0}, saved[2] = {0, 0};
+
+    for (uint32_t m = 0; m < TEST_MOTOR_NUMBER; ++m) {
+        CHECK(dji_motor_init(&test_motor[m].handle, test_motor[m].model,
+                             test_motor[m].id, test_motor[m].can_select) == 0);
+    }
+
+    for (uint32_t cycle = 0; cycle < TEST_CYCLES; ++cycle) {
+        uint32_t num = test_rand() % 12;
+        uint32_t cycle_posts[2] = {0, 0};
+
+        for (uint32_t k = 0; k < num; ++k) {
+            test_motor_t *m = &test_motor[test_rand() % TEST_MOTOR_NUMBER];
+            int16_t value = (int16_t)test_rand();
+            uint8_t group = m->voltage_group;
+
+            if (m->current_group != 0xFF && (test_rand() & 1)) {
+                group = m->current_group;
+                CHECK(dji_gm6020_post_current(&m->handle, value) == 0);
+            } else {
+                CHECK(dji_motor_post(&m->handle, value) == 0);
+            }
+            CHECK(m->handle.set_value == value);
+
+            test_value[m->can_select][group][m->index] = value;
+            test_dirty[m->can_select][group] = 1;
+            ++cycle_posts[m->can_select];
+        }
+
+        for (uint32_t c = 0; c < 2; ++c) {
+            test_frame_num = 0;
+            uint8_t n = dji_motor_flush((can_selected_t)c);
+            CHECK(n == test_check_flush((can_selected_t)c));
+
+            posts[c] += cycle_posts[c];
+            sent[c] += n;
+            saved[c] += (cycle_posts[c] > n) ? cycle_posts[c] - n : 0;
+        }
+    }
+
+    for (uint32_t c = 0; c < 2; ++c) {
+        dji_motor_get_tx_stats((can_selected_t)c, &stats);
+        CHECK(stats.posts == posts[c]);
+        CHECK(stats.frames_sent == sent[c]);
+        CHECK(stats.frames_saved == saved[c]);
+        CHECK(stats.bits_sent == sent[c] * DJI_MOTOR_TX_FRAME_BITS);
+    }
+
+    printf("coalesce: %u posts on CAN1 sent in %u frames (%u saved)\n",
+           posts[0], sent[0], saved[0]);
+}
+
+/**
+ * @brief 合并的帧与原来的发送函数发送的帧相同
+ */
+static void test_legacy_frame(void) {
+    test_frame_t legacy[4];
+    dji_motor_handle_t m[4];
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        CHECK(dji_motor_init(&m[i], DJI_M3508, (dji_can_id_t)(0x201 + i),
+                             can3_selected) == 0);
+        CHECK(dji_motor_post(&m[i], (int16_t)(-1000 * (int)i + 123)) == 0);
+    }
+    test_frame_num = 0;
+    dji_motor_set_current(can3_selected, DJI_MOTOR_GROUP1, 123, -877, -1877,
+                          -2877);
+    dji_gm6020_voltage_control(can3_selected, DJI_GM6020_VOLTAGE_GROUP2, 1, 2,
+                               3, 4);
+    memcpy(legacy, test_frame, sizeof(test_frame_t) * 2);
+
+    for (uint32_t i = 0; i < 3; ++i) {
+        CHECK(dji_motor_init(&m[i], DJI_GM6020, (dji_can_id_t)(0x209 + i),
+                             can3_selected) == 0);
+        CHECK(dji_motor_post(&m[i], (int16_t)(i + 1)) == 0);
+    }
+    /* 0x2FF 只有 3 个电机, 第 4 个位置为 0 */
+    legacy[1].data[7] = 0;
+    legacy[1].data[6] = 0;
+
+    test_frame_num = 0;
+    CHECK(dji_motor_flush(can3_selected) == 2);
+    CHECK(memcmp(&test_frame[0], &legacy[0], sizeof(test_frame_t)) == 0);
+    CHECK(memcmp(&test_frame[1], &legacy[1], sizeof(test_frame_t)) == 0);
+
+    /* 没有提交时不发送 */
+    test_frame_num = 0;
+    CHECK(dji_motor_flush(can3_selected) == 0);
+    CHECK(test_frame_num == 0);
+
+    /* 型号与 ID 不匹配 */
+    CHECK(dji_motor_init(&m[0], DJI_M3508, CAN_GM6020_ID7, can3_selected) == 0);
+    CHECK(dji_motor_post(&m[0], 1) == 2);
+    CHECK(dji_gm6020_post_current(&m[1], 1) == 0);
+    CHECK(dji_motor_init(&m[1], DJI_M2006, CAN_Motor1_ID, can3_selected) == 0);
+    CHECK(dji_gm6020_post_current(&m[1], 1) == 2);
+    CHECK(dji_motor_post(NULL, 1) == 1);
+    CHECK(dji_motor_flush((can_selected_t)CAN_LIST_MAX_CAN_NUMBER) == 0);
+
+    printf("legacy frame: ok\n");
+}
+
+/*****************************************************************************
+ * 临界区
+ */
+
+static dji_motor_handle_t test_irq_motor[2];
+
+/**
+ * @brief 定时器中断: 同时提交同一帧中两个电机的新设定值
+ */
+static void test_irq_isr(void) {
+    dji_motor_post(&test_irq_motor[0], 300);
+    dji_motor_post(&test_irq_motor[1], 300);
+}
+
+/**
+ * @brief 被跟踪的子进程: 两个电机提交了 200 还没有发送, 中断由父进程在
+ *        flush 的某条指令处注入
+ * @return 进程退出码, 0 表示帧没有被拆开, 新的设定值发送了, 统计没有丢失
+ */
+static int test_irq_child(void) {
+    dji_motor_tx_stats_t before, stats;
+
+    ptrace(PTRACE_TRACEME, 0, NULL, NULL);
+    stub_isr = test_irq_isr;
+    signal(SIGUSR1, stub_irq_handler);
+
+    for (uint32_t i = 0; i < 2; ++i) {
+        dji_motor_init(&test_irq_motor[i], DJI_M3508,
+                       (dji_can_id_t)(CAN_Motor1_ID + i), can1_selected);
+        dji_motor_post(&test_irq_motor[i], 200);
+    }
+    test_frame_num = 0;
+    dji_motor_get_tx_stats(can1_selected, &before);
+
+    raise(SIGSTOP);
+    dji_motor_flush(can1_selected);
+    raise(SIGSTOP);
+    dji_motor_flush(can1_selected);
+
+    for (uint32_t f = 0; f < test_frame_num; ++f) {
+        const uint8_t *d = test_frame[f].data;
+
+        if (test_frame[f].id != DJI_MOTOR_GROUP1 || d[0] != d[2] ||
+            d[1] != d[3]) {
+            return 1;
+        }
+    }
+    if (test_frame_num == 0 ||
+        test_frame[test_frame_num - 1].data[1] != (300 & 0xFF)) {
+        return 2;
+    }
+
+    dji_motor_get_tx_stats(can1_selected, &stats);
+    if (stats.posts - before.posts != 2) {
+        return 3;
+    }
+
+    /* 4 次提交, 每次或者被发送, 或者被合并 */
+    return (stats.frames_sent - before.frames_sent + stats.frames_saved -
+                    before.frames_saved ==
+                4)
+               ? 0
+               : 4;
+}
+
+/**
+ * @brief 用 ptrace 单步执行子进程, 在 flush 的第 n 步注入中断
+ */
+static void test_irq(void) {
+    uint32_t step;
+    int status;
+
+    for (step = 0;; ++step) {
+        pid_t pid = fork();
+        uint8_t done = 0;
+
+        CHECK(pid >= 0);
+        if (pid == 0) {
+            _exit(test_irq_child());
+        }
+
+        /* 第一次 SIGSTOP: 即将调用 dji_motor_flush */
+        CHECK(waitpid(pid, &status, 0) == pid && WIFSTOPPED(status));
+        for (uint32_t i = 0; i < step; ++i) {
+            CHECK(ptrace(PTRACE_SINGLESTEP, pid, NULL, NULL) == 0);
+            CHECK(waitpid(pid, &status, 0) == pid && WIFSTOPPED(status));
+            if (WSTOPSIG(status) == SIGSTOP) {
+                /* 第二次 SIGSTOP: 已经走完 dji_motor_flush */
+                done = 1;
+                break;
+            }
+        }
+        if (done) {
+            kill(pid, SIGKILL);
+            waitpid(pid, &status, 0);
+            break;
+        }
+
+        CHECK(ptrace(PTRACE_CONT, pid, NULL, (void *)(intptr_t)SIGUSR1) == 0);
+        for (;;) {
+            CHECK(waitpid(pid, &status, 0) == pid);
+            if (WIFEXITED(status)) {
+                break;
+            }
+            CHECK(ptrace(PTRACE_CONT, pid, NULL, NULL) == 0);
+        }
+        if (WEXITSTATUS(status) != 0) {
+            printf("irq: check %d failed with interrupt at step %u\n",
+                   WEXITSTATUS(status), step);
+            exit(1);
+        }
+    }
+
+    printf("irq: injected at %u instructions\n", step);
+}
+
+int main(void) {
+    test_coalesce();
+    test_legacy_frame();
+    test_irq();
+    printf("dji_motor: all tests passed\n");
+    return 0;
+}
@@ -24,6 +24,39 @@
 #define DM_REG_CMD_READ   0x33  /*!< 读寄存器, 应答回 MST_ID */
 #define DM_REG_CMD_SAVE   0xAA  /*!< 写 Flash (配合 D[3]=0x01) */
 
+#if DM_REG_USE_ASYNC
+
+/**
+ * @brief 在途请求
+ */
+typedef struct {
+    dm_handle_t *motor;         /*!< 电机, NULL 表示空闲 */
+    uint8_t cmd;                /*!< 功能码 */
+    uint8_t reg_addr;           /*!< 寄存器地址 */
+    uint32_t start_tick;        /*!< 发出时间 */
+    dm_reg_callback_t callback; /*!< 完成回调 */
+    void *user_data;            /*!< 用户数据 */
+    uint8_t draining;           /*!< 已超时, 等待丢弃迟到的应答 */
+} dm_reg_slot_t;
+
+/* 每个 CAN 的在途请求表 */
+static dm_reg_slot_t dm_reg_table[CAN_LIST_MAX_CAN_NUMBER]
+                                 [DM_REG_MAX_INFLIGHT];
+
+/* 正在进行的批量读取 */
+static dm_reg_batch_t *dm_reg_batch_list[DM_REG_MAX_BATCH];
+
+/* 请求表在任务与 CAN 接收中断中都会修改 */
+#define DM_REG_ENTER_CRITICAL()                                                \
+    uint32_t primask = __get_PRIMASK();                                        \
+    __disable_irq()
+#define DM_REG_EXIT_CRITICAL() __set_PRIMASK(primask)
+
+static uint8_t dm_reg_async_complete(dm_handle_t *motor, uint8_t cmd,
+                                     uint8_t reg_addr, uint32_t value);
+
+#endif /* DM_REG_USE_ASYNC */
+
 /**
  * @brief CAN 回调函数
  *
@@ -44,6 +77,21 @@ static void can_callback(void *node_obj, can_rx_header_t *can_rx_header,
         return;
     }
 
+#if DM_REG_USE_ASYNC
+    /* 有异步请求在途时, 只有 D[0..3] 与某笔在途请求一致才当作应答.
+     * 状态帧会改写 `device_id`, 所以用初始化时的 `slave_id` 匹配 */
+    if (motor->reg_inflight != 0U &&
+        can_msg[0] == (uint8_t)(motor->slave_id & 0xFFU) &&
+        can_msg[1] == (uint8_t)((motor->slave_id >> 8) & 0x07U)) {
+        uint32_t value = (uint32_t)can_msg[4] | ((uint32_t)can_msg[5] << 8) |
+                         ((uint32_t)can_msg[6] << 16) |
+                         ((uint32_t)can_msg[7] << 24);
+        if (dm_reg_async_complete(motor, can_msg[2], can_msg[3], value)) {
+            return;
+        }
+    }
+#endif /* DM_REG_USE_ASYNC */
+
     /* 接收应答时 D[2] 当功能码, 否则按状态帧拆 */
     if (motor->reg_read_pending == 1U) {
         uint8_t cmd = can_msg[2];
@@ -62,16 +110,8 @@ static void can_callback(void *node_obj, can_rx_header_t *can_rx_header,
     motor->device_id = can_msg[0] & 0x0F;
     motor->error = (can_msg[0] >> 4) & 0xF;
 
-    int temp;
-
-    temp = (can_msg[1] << 8) | can_msg[2];
-    motor->position =
-        uint_to_float(temp, -motor->pos_limit, motor->pos_limit, 16);
-    temp = (can_msg[3] << 4) | (can_msg[4] >> 4);
-    motor->speed = uint_to_float(temp, -motor->spd_limit, motor->spd_limit, 12);
-    temp = ((can_msg[4] & 0x0F) << 8) | can_msg[5];
-    motor->torque =
-        uint_to_float(temp, -motor->torq_limit, motor->torq_limit, 12);
+    mit_unpack_feedback(&motor->codec, &can_msg[1], &motor->position,
+                        &motor->speed, &motor->torque);
     motor->mos_temperature = (float)can_msg[6];
     motor->motor_temperature = (float)can_msg[7];
 }
@@ -103,12 +143,18 @@ uint8_t dm_motor_init(dm_handle_t *motor, uint32_t master_id,
 
     motor->master_id = master_id;
     motor->device_id = device_id;
+    motor->slave_id = device_id;
     motor->model = model;
     motor->mode = mode;
     motor->pos_limit = pos_limit;
     motor->spd_limit = spd_limit;
     motor->torq_limit = torq_limit;
     motor->can_select = can_select;
+    mit_codec_init(&motor->codec, pos_limit, spd_limit, DM_KP_MAX, DM_KD_MAX,
+                   torq_limit);
+#if DM_REG_USE_ASYNC
+    motor->reg_inflight = 0U;
+#endif /* DM_REG_USE_ASYNC */
 
     if (can_list_add_new_node(can_select, (void *)motor, master_id, 0x7FF,
                               CAN_ID_STD, can_callback) != 0) {
@@ -118,6 +164,71 @@ uint8_t dm_motor_init(dm_handle_t *motor, uint32_t master_id,
     return 0;
 }
 
+#if DM_REG_USE_ASYNC
+
+/**
+ * @brief 电机是否在进行中的批量读取里
+ *
+ * @param motor 电机指针
+ * @return 1 为在
+ */
+static uint8_t dm_reg_batch_has_motor(dm_handle_t *motor) {
+    for (uint32_t i = 0; i < DM_REG_MAX_BATCH; ++i) {
+        dm_reg_batch_t *batch = dm_reg_batch_list[i];
+
+        if (batch == NULL) {
+            continue;
+        }
+
+        for (uint32_t m = 0; m < batch->motor_num; ++m) {
+            if (batch->motors[m] == motor) {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 释放电机的全部在途请求
+ *
+ * @param motor 电机指针
+ * @note 还在等待应答的请求以 `DM_REG_RESULT_CANCELED` 调用回调, 已超时
+ *       等待丢弃迟到应答的直接释放. 释放后槽位不再引用 `motor`.
+ */
+static void dm_reg_async_cancel(dm_handle_t *motor) {
+    dm_reg_slot_t *table = dm_reg_table[motor->can_select];
+    dm_reg_callback_t callback[DM_REG_MAX_INFLIGHT];
+    void *user_data[DM_REG_MAX_INFLIGHT];
+    uint8_t reg_addr[DM_REG_MAX_INFLIGHT];
+    uint32_t num = 0;
+
+    DM_REG_ENTER_CRITICAL();
+    for (uint32_t i = 0; i < DM_REG_MAX_INFLIGHT; ++i) {
+        if (table[i].motor != motor) {
+            continue;
+        }
+
+        if (table[i].draining == 0 && table[i].callback != NULL) {
+            callback[num] = table[i].callback;
+            user_data[num] = table[i].user_data;
+            reg_addr[num] = table[i].reg_addr;
+            ++num;
+        }
+        table[i].motor = NULL;
+    }
+    motor->reg_inflight = 0U;
+    DM_REG_EXIT_CRITICAL();
+
+    for (uint32_t i = 0; i < num; ++i) {
+        callback[i](motor, reg_addr[i], 0, DM_REG_RESULT_CANCELED,
+                    user_data[i]);
+    }
+}
+
+#endif /* DM_REG_USE_ASYNC */
+
 /**
  * @brief 电机反初始化
  *
@@ -126,17 +237,67 @@ uint8_t dm_motor_init(dm_handle_t *motor, uint32_t master_id,
  * @retval - 0: 成功
  * @return - 1: `motor`为空
  * @retval - 2: 移除出错
+ * @retval - 3: 电机在进行中的批量读取里, 等批量读取完成后再反初始化
+ * @note 先摘掉 `can_list` 节点, 之后不会再收到应答, 再取消该电机的全部
+ *       在途请求, 反初始化后 `motor` 可以释放.
  */
 uint8_t dm_motor_deinit(dm_handle_t *motor) {
     if (motor == NULL) {
         return 1;
     }
 
+#if DM_REG_USE_ASYNC
+    if (dm_reg_batch_has_motor(motor)) {
+        return 3;
+    }
+#endif /* DM_REG_USE_ASYNC */
+
     if (can_list_del_node_by_id(motor->can_select, CAN_ID_STD,
                                 motor->master_id) != 0) {
         return 2;
     }
 
+#if DM_REG_USE_ASYNC
+    if (motor->can_select < CAN_LIST_MAX_CAN_NUMBER) {
+        dm_reg_async_cancel(motor);
+    }
+#endif /* DM_REG_USE_ASYNC */
+
+    return 0;
+}
+
+/**
+ * @brief 修改位置, 速度, 扭矩范围, 并重新计算 MIT 帧编解码参数
+ *
+ * @param motor 电机指针
+ * @param pos_limit 位置绝对值范围限制
+ * @param spd_limit 速度绝对值范围限制
+ * @param torq_limit 扭矩绝对值范围限制
+ * @return 修改状态:
+ * @retval - 0: 成功
+ * @retval - 1: `motor`为空
+ * @note 范围需要与上位机设定值一致. 直接改 `pos_limit` 等字段不会更新
+ *       `codec`, 必须通过本函数修改.
+ */
+uint8_t dm_set_limits(dm_handle_t *motor, float pos_limit, float spd_limit,
+                      float torq_limit) {
+    if (motor == NULL) {
+        return 1;
+    }
+
+    mit_codec_t codec;
+    mit_codec_init(&codec, pos_limit, spd_limit, DM_KP_MAX, DM_KD_MAX,
+                   torq_limit);
+
+    /* CAN 回调会用 `codec` 解反馈, 整体替换时关中断 */
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    motor->pos_limit = pos_limit;
+    motor->spd_limit = spd_limit;
+    motor->torq_limit = torq_limit;
+    motor->codec = codec;
+    __set_PRIMASK(primask);
+
     return 0;
 }
 
@@ -300,22 +461,7 @@ void dm_mit_ctrl(dm_handle_t *motor, float position, float speed, float kp,
                  float kd, float torque) {
     uint8_t send_msg[8];
 
-    uint16_t pos_tmp, spd_tmp, kp_tmp, kd_tmp, torq_tmp;
-
-    pos_tmp = float_to_uint(position, -motor->pos_limit, motor->pos_limit, 16);
-    spd_tmp = float_to_uint(speed, -motor->spd_limit, motor->spd_limit, 12);
-    kp_tmp = float_to_uint(kp, DM_KP_MIN, DM_KP_MAX, 12);
-    kd_tmp = float_to_uint(kd, DM_KD_MIN, DM_KD_MAX, 12);
-    torq_tmp = float_to_uint(torque, -motor->torq_limit, motor->torq_limit, 12);
-
-    send_msg[0] = (pos_tmp >> 8);
-    send_msg[1] = pos_tmp;
-    send_msg[2] = (spd_tmp >> 4);
-    send_msg[3] = ((spd_tmp & 0xF) << 4) | (kp_tmp >> 8);
-    send_msg[4] = kp_tmp;
-    send_msg[5] = (kd_tmp >> 4);
-    send_msg[6] = ((kd_tmp & 0xF) << 4) | (torq_tmp >> 8);
-    send_msg[7] = torq_tmp;
+    mit_pack_cmd(&motor->codec, send_msg, position, speed, kp, kd, torque);
 
     can_send_message(motor->can_select, CAN_ID_STD, motor->device_id + MIT_MODE,
                     8, send_msg);
@@ -522,3 +668,336 @@ uint8_t dm_save_param(dm_handle_t *motor) {
 
     return 0;
 }
+
+#if DM_REG_USE_ASYNC
+
+/**
+ * @brief 占用一个在途请求槽并发出请求
+ *
+ * @param motor 电机指针
+ * @param cmd 功能码, 读或写
+ * @param reg_addr 寄存器地址
+ * @param value 写入的值, 读请求忽略
+ * @param callback 完成回调
+ * @param user_data 用户数据
+ * @return 发起状态:
+ * @retval - 0: 已发送
+ * @retval - 1: `motor`为空或 CAN 不合法
+ * @retval - 2: 在途请求表已满
+ * @retval - 3: 该电机的该寄存器已有请求在途, 或超时后仍在等待迟到的应答
+ */
+static uint8_t dm_reg_async_issue(dm_handle_t *motor, uint8_t cmd,
+                                  uint8_t reg_addr, uint32_t value,
+                                  dm_reg_callback_t callback,
+                                  void *user_data) {
+    if (motor == NULL || motor->can_select >= CAN_LIST_MAX_CAN_NUMBER) {
+        return 1;
+    }
+
+    dm_reg_slot_t *table = dm_reg_table[motor->can_select];
+    dm_reg_slot_t *slot = NULL;
+
+    DM_REG_ENTER_CRITICAL();
+    for (uint32_t i = 0; i < DM_REG_MAX_INFLIGHT; ++i) {
+        if (table[i].motor == NULL) {
+            if (slot == NULL) {
+                slot = &table[i];
+            }
+        } else if (table[i].motor == motor && table[i].reg_addr == reg_addr) {
+            DM_REG_EXIT_CRITICAL();
+            return 3;
+        }
+    }
+
+    if (slot == NULL) {
+        DM_REG_EXIT_CRITICAL();
+        return 2;
+    }
+
+    slot->motor = motor;
+    slot->cmd = cmd;
+    slot->reg_addr = reg_addr;
+    slot->start_tick = DM_REG_GET_TICK();
+    slot->callback = callback;
+    slot->user_data = user_data;
+    slot->draining = 0;
+    ++motor->reg_inflight;
+    DM_REG_EXIT_CRITICAL();
+
+    uint8_t send_msg[8];
+    send_msg[0] = (uint8_t)(motor->slave_id & 0xFFU);
+    send_msg[1] = (uint8_t)((motor->slave_id >> 8) & 0x07U);
+    send_msg[2] = cmd;
+    send_msg[3] = reg_addr;
+    send_msg[4] = (uint8_t)(value & 0xFFU);
+    send_msg[5] = (uint8_t)((value >> 8) & 0xFFU);
+    send_msg[6] = (uint8_t)((value >> 16) & 0xFFU);
+    send_msg[7] = (uint8_t)((value >> 24) & 0xFFU);
+
+    can_send_message(motor->can_select, CAN_ID_STD, DM_REG_FRAME_ID,
+                     (cmd == DM_REG_CMD_READ) ? 4 : 8, send_msg);
+
+    return 0;
+}
+
+/**
+ * @brief 应答到达, 释放对应的在途请求并调用回调
+ *
+ * @note 已超时的请求收到的迟到应答只释放槽位, 不调用回调.
+ * @param motor 电机指针
+ * @param cmd 应答功能码
+ * @param reg_addr 应答寄存器地址
+ * @param value 应答数据
+ * @return 是否匹配到在途请求, 1 为匹配
+ */
+static uint8_t dm_reg_async_complete(dm_handle_t *motor, uint8_t cmd,
+                                     uint8_t reg_addr, uint32_t value) {
+    dm_reg_slot_t *table = dm_reg_table[motor->can_select];
+    dm_reg_callback_t callback = NULL;
+    void *user_data = NULL;
+    uint8_t matched = 0;
+
+    DM_REG_ENTER_CRITICAL();
+    for (uint32_t i = 0; i < DM_REG_MAX_INFLIGHT; ++i) {
+        if (table[i].motor == motor && table[i].reg_addr == reg_addr &&
+            table[i].cmd == cmd) {
+            if (table[i].draining == 0) {
+                callback = table[i].callback;
+                user_data = table[i].user_data;
+            }
+            table[i].motor = NULL;
+            --motor->reg_inflight;
+            matched = 1;
+            break;
+        }
+    }
+    DM_REG_EXIT_CRITICAL();
+
+    if (callback != NULL) {
+        callback(motor, reg_addr, value, DM_REG_RESULT_OK, user_data);
+    }
+
+    return matched;
+}
+
+/**
+ * @brief 异步读寄存器, 可以同时对多个电机、多个寄存器发起
+ *
+ * @param motor 电机指针
+ * @param reg_addr 寄存器地址
+ * @param callback 完成回调, 可为 NULL
+ * @param user_data 传给回调的用户数据
+ * @return 发起状态:
+ * @retval - 0: 已发送
+ * @retval - 1: `motor`为空或 CAN 不合法
+ * @retval - 2: 在途请求表已满
+ * @retval - 3: 该电机的该寄存器已有请求在途, 或超时后仍在等待迟到的应答
+ */
+uint8_t dm_reg_read_async(dm_handle_t *motor, uint8_t reg_addr,
+                          dm_reg_callback_t callback, void *user_data) {
+    return dm_reg_async_issue(motor, DM_REG_CMD_READ, reg_addr, 0, callback,
+                              user_data);
+}
+
+/**
+ * @brief 异步写寄存器 (0x55 → RAM), 写之前同样需要先失能
+ *
+ * @param motor 电机指针
+ * @param reg_addr 寄存器地址
+ * @param value uint32 数据 (float 调用方先用 memcpy 转)
+ * @param callback 完成回调, 可为 NULL
+ * @param user_data 传给回调的用户数据
+ * @return 发起状态, 同 `dm_reg_read_async`
+ */
+uint8_t dm_reg_write_async(dm_handle_t *motor, uint8_t reg_addr,
+                           uint32_t value, dm_reg_callback_t callback,
+                           void *user_data) {
+    return dm_reg_async_issue(motor, DM_REG_CMD_WRITE, reg_addr, value,
+                              callback, user_data);
+}
+
+/**
+ * @brief 批量读取中单个请求的完成回调
+ *
+ * @param motor 电机指针
+ * @param reg_addr 寄存器地址
+ * @param value 应答数据
+ * @param result 结果
+ * @param user_data 结果在批量读取中的下标, 高位为批量读取在列表中的位置
+ */
+static void dm_reg_batch_callback(dm_handle_t *motor, uint8_t reg_addr,
+                                  uint32_t value, dm_reg_result_t result,
+                                  void *user_data) {
+    UNUSED(motor);
+    UNUSED(reg_addr);
+
+    uintptr_t tag = (uintptr_t)user_data;
+    dm_reg_batch_t *batch = dm_reg_batch_list[tag >> 24];
+    uint32_t index = tag & 0xFFFFFFU;
+
+    if (batch == NULL) {
+        return;
+    }
+
+    batch->values[index] = value;
+    if (batch->result != NULL) {
+        batch->result[index] = result;
+    }
+
+    if (result == DM_REG_RESULT_OK) {
+        ++batch->finished;
+    } else {
+        ++batch->failed;
+    }
+}
+
+/**
+ * @brief 按窗口发出批量读取中尚未发出的请求
+ *
+ * @param batch 批量读取
+ * @param list_index 批量读取在列表中的位置
+ * @note 按寄存器优先的顺序发送, 相邻请求属于不同电机.
+ */
+static void dm_reg_batch_issue(dm_reg_batch_t *batch, uint32_t list_index) {
+    uint32_t total = batch->motor_num * batch->reg_num;
+
+    while (batch->issued < total) {
+        uint32_t motor_index = batch->issued % batch->motor_num;
+        uint32_t reg_index = batch->issued / batch->motor_num;
+        uint32_t index = motor_index * batch->reg_num + reg_index;
+        uintptr_t tag = ((uintptr_t)list_index << 24) | index;
+
+        uint8_t ret = dm_reg_read_async(batch->motors[motor_index],
+                                        batch->regs[reg_index],
+                                        dm_reg_batch_callback, (void *)tag);
+
+        if (ret == 1) {
+            /* 电机无效, 直接记为失败 */
+            if (batch->result != NULL) {
+                batch->result[index] = DM_REG_RESULT_TIMEOUT;
+            }
+            ++batch->failed;
+        } else if (ret != 0) {
+            /* 窗口已满, 下次 dm_reg_poll 再发 */
+            break;
+        }
+
+        ++batch->issued;
+    }
+}
+
+/**
+ * @brief 开始批量读取, 之后由 `dm_reg_poll` 推进
+ *
+ * @param batch 批量读取, 需要填好电机、寄存器与结果数组
+ * @return 开始状态:
+ * @retval - 0: 成功
+ * @retval - 1: 参数错误
+ * @retval - 2: 同时进行的批量读取过多
+ */
+uint8_t dm_reg_batch_start(dm_reg_batch_t *batch) {
+    if (batch == NULL || batch->motors == NULL || batch->regs == NULL ||
+        batch->values == NULL || batch->motor_num == 0 ||
+        batch->reg_num == 0 ||
+        batch->motor_num * batch->reg_num > 0xFFFFFFU) {
+        return 1;
+    }
+
+    uint32_t list_index;
+    for (list_index = 0; list_index < DM_REG_MAX_BATCH; ++list_index) {
+        if (dm_reg_batch_list[list_index] == NULL) {
+            break;
+        }
+    }
+
+    if (list_index == DM_REG_MAX_BATCH) {
+        return 2;
+    }
+
+    uint32_t total = batch->motor_num * batch->reg_num;
+
+    for (uint32_t i = 0; i < total; ++i) {
+        batch->values[i] = 0;
+        if (batch->result != NULL) {
+            batch->result[i] = DM_REG_RESULT_PENDING;
+        }
+    }
+
+    batch->issued = 0;
+    batch->finished = 0;
+    batch->failed = 0;
+    batch->start_tick = DM_REG_GET_TICK();
+    batch->finish_tick = batch->start_tick;
+
+    dm_reg_batch_list[list_index] = batch;
+    dm_reg_batch_issue(batch, list_index);
+
+    return 0;
+}
+
+/**
+ * @brief 检查超时并推进批量读取, 在任务中周期调用 (建议 1ms)
+ */
+void dm_reg_poll(void) {
+    uint32_t now = DM_REG_GET_TICK();
+
+    for (uint32_t can = 0; can < CAN_LIST_MAX_CAN_NUMBER; ++can) {
+        for (uint32_t i = 0; i < DM_REG_MAX_INFLIGHT; ++i) {
+            dm_reg_slot_t *slot = &dm_reg_table[can][i];
+            dm_handle_t *motor;
+            uint8_t reg_addr;
+            dm_reg_callback_t callback;
+            void *user_data;
+
+            DM_REG_ENTER_CRITICAL();
+            motor = slot->motor;
+            if (motor == NULL ||
+                (now - slot->start_tick) < DM_REG_TIMEOUT_MS) {
+                DM_REG_EXIT_CRITICAL();
+                continue;
+            }
+
+            if (slot->draining) {
+                /* 迟到的应答不会再来了, 释放槽位 */
+                slot->motor = NULL;
+                --motor->reg_inflight;
+                DM_REG_EXIT_CRITICAL();
+                continue;
+            }
+
+            /* 超时后继续占用槽位, 丢弃这段时间内迟到的应答 */
+            reg_addr = slot->reg_addr;
+            callback = slot->callback;
+            user_data = slot->user_data;
+            slot->draining = 1;
+            slot->start_tick = now;
+            DM_REG_EXIT_CRITICAL();
+
+            if (callback != NULL) {
+                callback(motor, reg_addr, 0, DM_REG_RESULT_TIMEOUT,
+                         user_data);
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < DM_REG_MAX_BATCH; ++i) {
+        dm_reg_batch_t *batch = dm_reg_batch_list[i];
+
+        if (batch == NULL) {
+            continue;
+        }
+
+        dm_reg_batch_issue(batch, i);
+
+        if (batch->finished + batch->failed ==
+            batch->motor_num * batch->reg_num) {
+            batch->finish_tick = DM_REG_GET_TICK();
+            dm_reg_batch_list[i] = NULL;
+            if (batch->done_callback != NULL) {
+                batch->done_callback(batch);
+            }
+        }
+    }
+}
+
+#endif /* DM_REG_USE_ASYNC */
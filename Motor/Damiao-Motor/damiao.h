@@ -21,6 +21,8 @@ extern "C" {
 
 #include <cubemx.h>
 
+#include "buffer_append/buffer_append.h"
+
 /**
  * @brief 电机型号
  */
@@ -37,11 +39,29 @@ typedef enum {
     DM_G6220
 } dm_model_t;
 
-#define DM_KP_MIN 0.0f
 #define DM_KP_MAX 500.0f
-#define DM_KD_MIN 0.0f
 #define DM_KD_MAX 5.0f
 
+/**
+ * 是否使用异步寄存器事务
+ *
+ * 启用后每个 CAN 有一张在途请求表, 以 (电机, 寄存器地址) 为键, 同一条总线上
+ * 可以同时有多笔读写请求在途, 应答到达时调用完成回调, 超时由
+ * `dm_reg_poll` 检查. 批量读取多个电机的多个寄存器时按窗口流水发送.
+ *
+ * 应答中没有请求序号, 超时的请求回调后继续占用槽位, 再等待
+ * `DM_REG_TIMEOUT_MS`. 期间迟到的应答被丢弃, 同一电机同一寄存器的新请求
+ * 返回 3 (已在途), 这样迟到的应答不会被当作新请求的应答.
+ */
+#define DM_REG_USE_ASYNC 1
+
+#if DM_REG_USE_ASYNC
+#define DM_REG_MAX_INFLIGHT 8             /* 每个 CAN 的最大在途请求数 */
+#define DM_REG_MAX_BATCH    2             /* 同时进行的批量读取数量 */
+#define DM_REG_TIMEOUT_MS   20            /* 应答超时时间 */
+#define DM_REG_GET_TICK()   HAL_GetTick() /* 毫秒时基 */
+#endif /* DM_REG_USE_ASYNC */
+
 /**
  * @brief 故障信息
  */
@@ -73,6 +93,8 @@ typedef enum {
 typedef struct {
     uint32_t master_id;        /*!< 反馈主机 ID */
     uint32_t device_id;        /*!< 控制设备 ID */
+    uint32_t slave_id;         /*!< 初始化时的设备 ID, 反馈不会改写,
+                                    用于寄存器请求与应答匹配 */
     can_selected_t can_select; /*!< 选择 CAN 通信 */
     dm_model_t model;          /*!< 型号 */
     dm_mode_t mode;            /*!< 当前模式 */
@@ -89,18 +111,79 @@ typedef struct {
     float pos_limit;  /*!< 位置绝对值范围 */
     float spd_limit;  /*!< 速度绝对值范围 */
     float torq_limit; /*!< 扭矩绝对值范围 */
+    mit_codec_t codec; /*!< 按上面范围预先计算的 MIT 帧编解码参数,
+                            范围只能通过 `dm_set_limits` 修改 */
 
     /* 寄存器读/写/存参 应答缓存 (can_callback 收到 MST_ID 帧时写入) */
     volatile uint8_t  reg_read_addr;    /*!< 应答里的 RID (0x33/0x55); 存参完成时是 0x01 */
     volatile uint32_t reg_read_value;   /*!< 应答里的 uint32 (LE 已解出); 存参时是 0 */
     volatile uint8_t  reg_read_pending; /*!< 1=请求已发但应答未到; 0=空闲或已到达 */
+#if DM_REG_USE_ASYNC
+    volatile uint8_t  reg_inflight;     /*!< 该电机的异步在途请求数 */
+#endif /* DM_REG_USE_ASYNC */
 } dm_handle_t;
 
+#if DM_REG_USE_ASYNC
+
+/**
+ * @brief 异步寄存器事务结果
+ */
+typedef enum {
+    DM_REG_RESULT_OK = 0x00U, /*!< 收到应答 */
+    DM_REG_RESULT_TIMEOUT,    /*!< 超时未收到应答 */
+    DM_REG_RESULT_PENDING,    /*!< 未完成 (仅批量读取结果中使用) */
+    DM_REG_RESULT_CANCELED    /*!< 电机已反初始化, 请求被取消 */
+} dm_reg_result_t;
+
+/**
+ * @brief 异步寄存器事务完成回调
+ *
+ * @param motor 电机指针
+ * @param reg_addr 寄存器地址
+ * @param value 应答中的数据, 超时为 0
+ * @param result 结果
+ * @param user_data 发起请求时传入的用户数据
+ * @note 收到应答时在 CAN 接收回调中调用, 超时在 `dm_reg_poll` 中调用,
+ *       取消在 `dm_motor_deinit` 中调用.
+ */
+typedef void (*dm_reg_callback_t)(dm_handle_t * /* motor */,
+                                  uint8_t /* reg_addr */, uint32_t /* value */,
+                                  dm_reg_result_t /* result */,
+                                  void * /* user_data */);
+
+/**
+ * @brief 批量读取: 读取 `motors` 中每个电机的 `regs` 中每个寄存器
+ */
+typedef struct dm_reg_batch {
+    dm_handle_t **motors; /*!< 电机数组 */
+    uint32_t motor_num;   /*!< 电机数量 */
+    const uint8_t *regs;  /*!< 寄存器地址数组 */
+    uint32_t reg_num;     /*!< 寄存器数量 */
+
+    uint32_t *values;        /*!< 结果, 大小为 motor_num * reg_num,
+                                  values[motor * reg_num + reg] */
+    dm_reg_result_t *result; /*!< 每个请求的结果, 大小同 values, 可为 NULL */
+
+    /* 完成回调, 在 `dm_reg_poll` 中调用, 可为 NULL */
+    void (*done_callback)(struct dm_reg_batch * /* batch */);
+
+    /* 以下由驱动维护 */
+    volatile uint32_t issued;   /*!< 已发出的请求数 */
+    volatile uint32_t finished; /*!< 已收到应答的请求数 */
+    volatile uint32_t failed;   /*!< 超时或被取消的请求数 */
+    uint32_t start_tick;        /*!< 开始时间 */
+    uint32_t finish_tick;       /*!< 完成时间, 与 start_tick 之差即总耗时 */
+} dm_reg_batch_t;
+
+#endif /* DM_REG_USE_ASYNC */
+
 uint8_t dm_motor_init(dm_handle_t *motor, uint32_t master_id,
                       uint32_t device_id, dm_mode_t mode, dm_model_t model,
                       float pos_limit, float spd_limit, float torq_limit,
                       can_selected_t can_select);
 uint8_t dm_motor_deinit(dm_handle_t *motor);
+uint8_t dm_set_limits(dm_handle_t *motor, float pos_limit, float spd_limit,
+                      float torq_limit);
 void dm_motor_enable(dm_handle_t *motor);
 void dm_motor_disable(dm_handle_t *motor);
 void dm_save_zero(dm_handle_t *motor);
@@ -119,6 +202,16 @@ uint8_t dm_write_register(dm_handle_t *motor, uint8_t reg_addr, uint32_t value);
 uint8_t dm_read_register(dm_handle_t *motor, uint8_t reg_addr);
 uint8_t dm_save_param(dm_handle_t *motor);
 
+#if DM_REG_USE_ASYNC
+uint8_t dm_reg_read_async(dm_handle_t *motor, uint8_t reg_addr,
+                          dm_reg_callback_t callback, void *user_data);
+uint8_t dm_reg_write_async(dm_handle_t *motor, uint8_t reg_addr,
+                           uint32_t value, dm_reg_callback_t callback,
+                           void *user_data);
+uint8_t dm_reg_batch_start(dm_reg_batch_t *batch);
+void dm_reg_poll(void);
+#endif /* DM_REG_USE_ASYNC */
+
 
 /**
  * @brief 可读写寄存器地址 (RW)
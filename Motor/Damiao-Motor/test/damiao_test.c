@@ -0,0 +1,502 @@
+/**
+ * @file    damiao_test.c
+ * @brief   异步寄存器事务的主机测试. CAN 发送与 can_list 由测试替身实现,
+ *          模拟的电调按任意顺序应答请求.
+ *
+ * 在 `Motor/Damiao-Motor` 下编译运行:
+ *
+ *   gcc -std=gnu11 -g -O1 -fsanitize=address,undefined -Itest/stub -I. \
+ *       -I.. -I../../Utils test/damiao_test.c damiao.c \
+ *       ../../Utils/buffer_append/buffer_append.c -lm -o damiao_test
+ *   ./damiao_test
+ *
+ * 检查项:
+ *  - 同一条总线上多个电机、多个寄存器的请求流水发出, 应答乱序到达时
+ *    回调的值与请求对应, 表满和重复请求返回 2 和 3
+ *  - 批量读取按窗口发送, 相邻请求属于不同电机, 结果完整
+ *  - 超时回调后槽位继续占用, 迟到的应答被丢弃
+ *  - `dm_motor_deinit` 取消该电机的在途请求并释放槽位, 释放电机后
+ *    `dm_reg_poll` 不再访问它 (AddressSanitizer 检查); 在批量读取中的电机
+ *    不能反初始化
+ */
+
+#include "damiao.h"
+#include "can_list/can_list.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+/*****************************************************************************
+ * 替身
+ */
+
+static uint32_t test_tick;
+
+uint32_t HAL_GetTick(void) {
+    return test_tick;
+}
+
+static uint32_t stub_primask;
+
+uint32_t __get_PRIMASK(void) {
+    return stub_primask;
+}
+
+void __disable_irq(void) {
+    stub_primask = 1;
+}
+
+void __set_PRIMASK(uint32_t primask) {
+    stub_primask = primask;
+}
+
+/* 发往 0x7FF 的寄存器请求 */
+typedef struct {
+    can_selected_t can_select;
+    uint8_t len;
+    uint8_t data[8];
+} test_request_t;
+
+static test_request_t test_request[64];
+static uint32_t test_request_num;
+
+uint8_t can_send_message(can_selected_t can_select, uint32_t id_type,
+                         uint32_t can_id, uint8_t len, uint8_t *msg) {
+    CHECK(id_type == CAN_ID_STD && can_id == 0x7FF);
+    CHECK(test_request_num < sizeof(test_request) / sizeof(test_request[0]));
+    CHECK(stub_primask == 0);
+
+    test_request[test_request_num].can_select = can_select;
+    test_request[test_request_num].len = len;
+    memcpy(test_request[test_request_num].data, msg, len);
+    ++test_request_num;
+    return 0;
+}
+
+/* can_list 上注册的反馈节点 */
+typedef struct {
+    uint8_t used;
+    can_selected_t can_select;
+    uint32_t id;
+    void *node;
+    can_callback_t callback;
+} test_node_t;
+
+static test_node_t test_node[8];
+
+uint8_t can_list_add_new_node(can_selected_t can_select, void *node_data,
+                              uint32_t id, uint32_t id_mask, uint32_t id_type,
+                              can_callback_t callback) {
+    CHECK(id_mask == 0x7FF && id_type == CAN_ID_STD);
+
+    for (uint32_t i = 0; i < sizeof(test_node) / sizeof(test_node[0]); ++i) {
+        if (!test_node[i].used) {
+            test_node[i].used = 1;
+            test_node[i].can_select = can_select;
+            test_node[i].id = id;
+            test_node[i].node = node_data;
+            test_node[i].callback = callback;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+uint8_t can_list_del_node_by_id(can_selected_t can_select, uint32_t id_type,
+                                uint32_t id) {
+    UNUSED(id_type);
+
+    for (uint32_t i = 0; i < sizeof(test_node) / sizeof(test_node[0]); ++i) {
+        if (test_node[i].used && test_node[i].can_select == can_select &&
+            test_node[i].id == id) {
+            test_node[i].used = 0;
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/*****************************************************************************
+ * 模拟的电调
+ */
+
+/**
+ * @brief 寄存器的值, 由电机 ID 和寄存器地址决定
+ */
+static uint32_t test_reg_value(uint32_t slave_id, uint8_t reg_addr) {
+    return 0xA5000000U | (slave_id << 8) | reg_addr;
+}
+
+/**
+ * @brief 从 master_id 发回一帧, 节点已摘掉时丢弃
+ */
+static void test_receive(can_selected_t can_select, uint32_t master_id,
+                         const uint8_t *data) {
+    can_rx_header_t header = {master_id, CAN_ID_STD, 0, 8, test_tick};
+    uint8_t msg[8];
+
+    memcpy(msg, data, 8);
+    for (uint32_t i = 0; i < sizeof(test_node) / sizeof(test_node[0]); ++i) {
+        if (test_node[i].used && test_node[i].can_select == can_select &&
+            test_node[i].id == master_id) {
+            test_node[i].callback(test_node[i].node, &header, msg);
+        }
+    }
+}
+
+/**
+ * @brief 应答第 n 个请求, 读返回 `test_reg_value`, 写原样返回
+ */
+static void test_reply(uint32_t n) {
+    const test_request_t *req = &test_request[n];
+    uint32_t slave_id = req->data[0] | ((uint32_t)req->data[1] << 8);
+    uint32_t value = test_reg_value(slave_id, req->data[3]);
+    uint8_t msg[8] = {req->data[0], req->data[1], req->data[2], req->data[3]};
+
+    if (req->len == 8) {
+        memcpy(&msg[4], &req->data[4], 4);
+    } else {
+        msg[4] = (uint8_t)value;
+        msg[5] = (uint8_t)(value >> 8);
+        msg[6] = (uint8_t)(value >> 16);
+        msg[7] = (uint8_t)(value >> 24);
+    }
+
+    /* 反馈 ID 为电机 ID + 0x10 */
+    test_receive(req->can_select, slave_id + 0x10, msg);
+}
+
+static uint32_t test_rand_state = 1;
+
+static uint32_t test_rand(void) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return test_rand_state >> 8;
+}
+
+/**
+ * @brief 以随机顺序应答 [first, test_request_num) 的请求
+ */
+static void test_reply_shuffled(uint32_t first) {
+    uint32_t order[64];
+    uint32_t num = test_request_num - first;
+
+    for (uint32_t i = 0; i < num; ++i) {
+        order[i] = first + i;
+    }
+    for (uint32_t i = num; i > 1; --i) {
+        uint32_t j = test_rand() % i;
+        uint32_t t = order[i - 1];
+        order[i - 1] = order[j];
+        order[j] = t;
+    }
+    for (uint32_t i = 0; i < num; ++i) {
+        test_reply(order[i]);
+    }
+}
+
+/*****************************************************************************
+ * 回调记录
+ */
+
+typedef struct {
+    dm_handle_t *motor;
+    uint8_t reg_addr;
+    uint32_t value;
+    dm_reg_result_t result;
+    void *user_data;
+} test_result_t;
+
+static test_result_t test_result[64];
+static uint32_t test_result_num;
+
+static void test_callback(dm_handle_t *motor, uint8_t reg_addr,
+                          uint32_t value, dm_reg_result_t result,
+                          void *user_data) {
+    CHECK(test_result_num < sizeof(test_result) / sizeof(test_result[0]));
+    CHECK(stub_primask == 0);
+
+    test_result[test_result_num].motor = motor;
+    test_result[test_result_num].reg_addr = reg_addr;
+    test_result[test_result_num].value = value;
+    test_result[test_result_num].result = result;
+    test_result[test_result_num].user_data = user_data;
+    ++test_result_num;
+}
+
+/**
+ * @brief 初始化电机, 电机 ID 为 `slave_id`, 反馈 ID 为 `slave_id + 0x10`
+ */
+static void test_motor_init(dm_handle_t *motor, uint32_t slave_id,
+                            can_selected_t can_select) {
+    memset(motor, 0, sizeof(dm_handle_t));
+    CHECK(dm_motor_init(motor, slave_id + 0x10, slave_id, DM_MODE_MIT,
+                        DM_J4310, 12.5f, 30.0f, 10.0f, can_select) == 0);
+}
+
+/**
+ * @brief 超过两倍超时, 所有槽位都会被释放
+ */
+static void test_drain_all(void) {
+    test_tick += DM_REG_TIMEOUT_MS;
+    dm_reg_poll();
+    test_tick += DM_REG_TIMEOUT_MS;
+    dm_reg_poll();
+}
+
+/*****************************************************************************
+ * 测试
+ */
+
+static dm_handle_t test_motor[4];
+
+/**
+ * @brief 一条总线上流水发出读写请求, 乱序应答
+ */
+static void test_pipeline(void) {
+    static const uint8_t regs[2] = {DM_REG_PMAX, DM_REG_VMAX};
+
+    for (uint32_t m = 0; m < 4; ++m) {
+        test_motor_init(&test_motor[m], 1 + m, can1_selected);
+    }
+
+    for (uint32_t round = 0; round < 100; ++round) {
+        test_request_num = 0;
+        test_result_num = 0;
+
+        for (uint32_t m = 0; m < 4; ++m) {
+            for (uint32_t r = 0; r < 2; ++r) {
+                void *tag = (void *)(uintptr_t)(m * 2 + r);
+                uint8_t ret;
+
+                if ((round + m) & 1) {
+                    ret = dm_reg_write_async(&test_motor[m], regs[r],
+                                             round * 8 + m * 2 + r,
+                                             test_callback, tag);
+                } else {
+                    ret = dm_reg_read_async(&test_motor[m], regs[r],
+                                            test_callback, tag);
+                }
+                CHECK(ret == 0);
+            }
+            CHECK(test_motor[m].reg_inflight == 2);
+        }
+
+        /* 表满, 重复请求 */
+        CHECK(dm_reg_read_async(&test_motor[0], DM_REG_TMAX, test_callback,
+                                NULL) == 2);
+        CHECK(dm_reg_read_async(&test_motor[0], DM_REG_PMAX, test_callback,
+                                NULL) == 3);
+        CHECK(test_request_num == 8);
+        CHECK(test_result_num == 0);
+
+        test_reply_shuffled(0);
+
+        CHECK(test_result_num == 8);
+        for (uint32_t i = 0; i < 8; ++i) {
+            const test_result_t *res = &test_result[i];
+            uint32_t m = (uint32_t)(uintptr_t)res->user_data / 2;
+            uint32_t r = (uint32_t)(uintptr_t)res->user_data % 2;
+
+            CHECK(res->motor == &test_motor[m]);
+            CHECK(res->reg_addr == regs[r]);
+            CHECK(res->result == DM_REG_RESULT_OK);
+            if ((round + m) & 1) {
+                CHECK(res->value == round * 8 + m * 2 + r);
+            } else {
+                CHECK(res->value == test_reg_value(1 + m, regs[r]));
+            }
+        }
+        for (uint32_t m = 0; m < 4; ++m) {
+            CHECK(test_motor[m].reg_inflight == 0);
+        }
+    }
+
+    printf("pipeline: ok\n");
+}
+
+static uint32_t test_batch_done;
+
+static void test_batch_done_callback(dm_reg_batch_t *batch) {
+    UNUSED(batch);
+    ++test_batch_done;
+}
+
+/**
+ * @brief 批量读取 4 个电机的 3 个寄存器, 超过在途窗口
+ */
+static void test_batch(void) {
+    static dm_handle_t *motors[4] = {&test_motor[0], &test_motor[1],
+                                     &test_motor[2], &test_motor[3]};
+    static const uint8_t regs[3] = {DM_REG_PMAX, DM_REG_VMAX, DM_REG_TMAX};
+    uint32_t values[12];
+    dm_reg_result_t result[12];
+    dm_reg_batch_t batch = {
+        .motors = motors,
+        .motor_num = 4,
+        .regs = regs,
+        .reg_num = 3,
+        .values = values,
+        .result = result,
+        .done_callback = test_batch_done_callback,
+    };
+    uint32_t served = 0;
+
+    test_request_num = 0;
+    test_batch_done = 0;
+    CHECK(dm_reg_batch_start(&batch) == 0);
+    CHECK(test_request_num == DM_REG_MAX_INFLIGHT);
+
+    /* 批量读取中的电机不能反初始化 */
+    CHECK(dm_motor_deinit(&test_motor[2]) == 3);
+
+    while (test_batch_done == 0) {
+        uint32_t last = test_request_num;
+
+        CHECK(last > served);
+        test_reply_shuffled(served);
+        served = last;
+        ++test_tick;
+        dm_reg_poll();
+    }
+
+    CHECK(test_request_num == 12);
+    for (uint32_t i = 1; i < test_request_num; ++i) {
+        CHECK(test_request[i].data[0] != test_request[i - 1].data[0]);
+    }
+    for (uint32_t m = 0; m < 4; ++m) {
+        for (uint32_t r = 0; r < 3; ++r) {
+            CHECK(result[m * 3 + r] == DM_REG_RESULT_OK);
+            CHECK(values[m * 3 + r] == test_reg_value(1 + m, regs[r]));
+        }
+    }
+    CHECK(batch.finished == 12 && batch.failed == 0);
+    CHECK(test_batch_done == 1);
+
+    printf("batch: ok\n");
+}
+
+/**
+ * @brief 超时后迟到的应答被丢弃, 不会当作新请求的应答
+ */
+static void test_timeout(void) {
+    test_request_num = 0;
+    test_result_num = 0;
+
+    CHECK(dm_reg_read_async(&test_motor[0], DM_REG_KT_VALUE, test_callback,
+                            NULL) == 0);
+    test_tick += DM_REG_TIMEOUT_MS - 1;
+    dm_reg_poll();
+    CHECK(test_result_num == 0);
+    ++test_tick;
+    dm_reg_poll();
+    CHECK(test_result_num == 1);
+    CHECK(test_result[0].result == DM_REG_RESULT_TIMEOUT);
+    CHECK(test_result[0].value == 0);
+
+    CHECK(dm_reg_read_async(&test_motor[0], DM_REG_KT_VALUE, test_callback,
+                            NULL) == 3);
+    test_reply(0);
+    CHECK(test_result_num == 1);
+    CHECK(test_motor[0].reg_inflight == 0);
+
+    CHECK(dm_reg_read_async(&test_motor[0], DM_REG_KT_VALUE, test_callback,
+                            NULL) == 0);
+    test_reply(1);
+    CHECK(test_result_num == 2);
+    CHECK(test_result[1].result == DM_REG_RESULT_OK);
+
+    printf("timeout: ok\n");
+}
+
+/**
+ * @brief 反初始化取消在途请求, 释放的电机不再被引用
+ */
+static void test_deinit(void) {
+    dm_handle_t *motor = malloc(sizeof(dm_handle_t));
+    uint32_t canceled = 0;
+
+    CHECK(motor != NULL);
+    test_motor_init(motor, 0x20, can1_selected);
+    test_request_num = 0;
+    test_result_num = 0;
+
+    /* 第一个请求超时, 槽位等待迟到的应答 */
+    CHECK(dm_reg_read_async(motor, DM_REG_ACC, test_callback, NULL) == 0);
+    test_tick += DM_REG_TIMEOUT_MS;
+    dm_reg_poll();
+    CHECK(test_result_num == 1);
+
+    CHECK(dm_reg_read_async(motor, DM_REG_DEC, test_callback, NULL) == 0);
+    CHECK(dm_reg_write_async(motor, DM_REG_MAX_SPD, 1, test_callback, NULL) ==
+          0);
+    CHECK(dm_reg_read_async(motor, DM_REG_MST_ID, NULL, NULL) == 0);
+    CHECK(dm_reg_read_async(&test_motor[1], DM_REG_ACC, test_callback,
+                            NULL) == 0);
+    CHECK(motor->reg_inflight == 4);
+
+    test_result_num = 0;
+    CHECK(dm_motor_deinit(motor) == 0);
+
+    /* 没有超时且有回调的两个请求被取消 */
+    for (uint32_t i = 0; i < test_result_num; ++i) {
+        CHECK(test_result[i].motor == motor);
+        CHECK(test_result[i].result == DM_REG_RESULT_CANCELED);
+        CHECK(test_result[i].reg_addr == DM_REG_DEC ||
+              test_result[i].reg_addr == DM_REG_MAX_SPD);
+        ++canceled;
+    }
+    CHECK(canceled == 2);
+    CHECK(motor->reg_inflight == 0);
+    free(motor);
+
+    /* 节点已摘掉, 迟到的应答不会到达 */
+    for (uint32_t i = 0; i < 4; ++i) {
+        test_reply(i);
+    }
+    CHECK(test_result_num == 2);
+
+    /* 4 个槽位都已释放, 其余 7 个可以再用 */
+    for (uint32_t i = 0; i < DM_REG_MAX_INFLIGHT - 1; ++i) {
+        CHECK(dm_reg_read_async(&test_motor[2], (uint8_t)(0x30 + i),
+                                test_callback, NULL) == 0);
+    }
+    CHECK(dm_reg_read_async(&test_motor[3], DM_REG_ACC, test_callback,
+                            NULL) == 2);
+
+    /* 轮询超时不会访问已释放的电机 */
+    test_result_num = 0;
+    test_drain_all();
+    CHECK(test_result_num == DM_REG_MAX_INFLIGHT);
+    for (uint32_t i = 0; i < test_result_num; ++i) {
+        CHECK(test_result[i].result == DM_REG_RESULT_TIMEOUT);
+        CHECK(test_result[i].motor != motor);
+    }
+    CHECK(test_motor[1].reg_inflight == 0);
+    CHECK(test_motor[2].reg_inflight == 0);
+
+    /* 摘节点失败时不取消 */
+    CHECK(dm_motor_deinit(&test_motor[0]) == 0);
+    CHECK(dm_motor_deinit(&test_motor[0]) == 2);
+    CHECK(dm_motor_deinit(NULL) == 1);
+
+    printf("deinit: ok\n");
+}
+
+int main(void) {
+    test_pipeline();
+    test_batch();
+    test_timeout();
+    test_deinit();
+
+    printf("all passed\n");
+    return 0;
+}
@@ -0,0 +1,33 @@
+/**
+ * @file    CSP_Config.h
+ * @brief   主机测试用的板级支持替身, 只包含 damiao.c 和 can_list.h 用到的
+ *          部分. CAN 发送、时基和 PRIMASK 由测试实现.
+ */
+
+#ifndef __CSP_CONFIG_H
+#define __CSP_CONFIG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define UNUSED(x) ((void)(x))
+
+typedef enum {
+    can1_selected = 0U,
+    can2_selected,
+    can3_selected
+} can_selected_t;
+
+#define CAN_ID_STD 0x00000000U
+#define CAN_ID_EXT 0x00000004U
+
+uint32_t HAL_GetTick(void);
+
+uint8_t can_send_message(can_selected_t can_select, uint32_t id_type,
+                         uint32_t can_id, uint8_t len, uint8_t *msg);
+
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t primask);
+void __disable_irq(void);
+
+#endif /* __CSP_CONFIG_H */
@@ -0,0 +1,11 @@
+/**
+ * @file    cubemx.h
+ * @brief   主机测试用的替身, 板级定义见 CSP_Config.h.
+ */
+
+#ifndef __CUBEMX_H
+#define __CUBEMX_H
+
+#include <CSP_Config.h>
+
+#endif /* __CUBEMX_H */
@@ -8,7 +8,12 @@
 
 #include "can_list/can_list.h"
 
+#if CAN_LIST_USE_STATIC_POOL
+#include "mem_pool/mem_pool.h"
+#endif /* CAN_LIST_USE_STATIC_POOL */
+
 #include <stdlib.h>
+#include <string.h>
 
 #define STD_ID_TABLE 0
 #define EXT_ID_TABLE 1
@@ -18,10 +23,54 @@
 #include "semphr.h"
 #include "task.h"
 
-static QueueHandle_t can_list_queue_handle;
 static TaskHandle_t can_list_task_handle;
 void can_list_polling_task(void *args);
 
+/* Increased before and after the polling task dispatches a frame, odd while
+ * it may hold an index or a node. */
+static volatile uint32_t can_list_dispatch_seq;
+
+#if CAN_LIST_USE_FRAME_RING
+
+#if CAN_LIST_USE_FDCAN
+typedef FDCAN_HandleTypeDef can_list_handle_t;
+#define CAN_LIST_FRAME_DATA_SIZE 64
+#define CAN_LIST_STD_ID_TYPE     FDCAN_STANDARD_ID
+#else /* CAN_LIST_USE_FDCAN */
+typedef CAN_HandleTypeDef can_list_handle_t;
+#define CAN_LIST_FRAME_DATA_SIZE 8
+#define CAN_LIST_STD_ID_TYPE     CAN_ID_STD
+#endif /* CAN_LIST_USE_FDCAN */
+
+#if (CAN_LIST_RING_LENGTH & (CAN_LIST_RING_LENGTH - 1)) != 0
+#error "CAN_LIST_RING_LENGTH must be power of 2."
+#endif /* (CAN_LIST_RING_LENGTH & (CAN_LIST_RING_LENGTH - 1)) != 0 */
+
+/**
+ * @brief Received frame in the ring.
+ */
+typedef struct {
+    can_rx_header_t header;                 /*!< Header passed to callback. */
+    uint8_t can_received;                   /*!< The CAN which received.    */
+    uint8_t data[CAN_LIST_FRAME_DATA_SIZE]; /*!< Message data.              */
+} can_frame_t;
+
+/**
+ * @brief Frame ring. The ISR is the only producer (moves `tail`), the polling
+ *        task is the only consumer (moves `head`).
+ */
+static struct {
+    volatile uint32_t head;                   /*!< Consumer index. */
+    volatile uint32_t tail;                   /*!< Producer index. */
+    can_frame_t frame[CAN_LIST_RING_LENGTH];  /*!< Frame storage.  */
+} can_list_ring;
+
+static can_list_ring_stats_t can_list_ring_stats;
+
+#else /* CAN_LIST_USE_FRAME_RING */
+
+static QueueHandle_t can_list_queue_handle;
+
 /**
  * @brief Queue message data type.
  */
@@ -36,6 +85,8 @@ typedef struct {
 
 static queue_msg_t send_msg_from_isr;
 
+#endif /* CAN_LIST_USE_FRAME_RING */
+
 #endif /* CAN_LIST_USE_RTOS */
 
 /*****************************************************************************
@@ -54,12 +105,45 @@ typedef struct can_node {
     struct can_node *next;   /*!< Next CAN list node.           */
 } can_node_t;
 
+#if CAN_LIST_USE_INDEX
+
+/**
+ * @brief Nodes which have the same ID mask.
+ */
+typedef struct {
+    uint32_t mask;      /*!< ID mask of this group.                        */
+    uint32_t shift;     /*!< Hash shift, `32 - log2(slot number)`.         */
+    uint32_t max_probe; /*!< The longest probe sequence in this group.     */
+    can_node_t **slot;  /*!< Open-addressed slots, `NULL` means empty.     */
+} mask_group_t;
+
+/**
+ * @brief Dispatch index of one ID table, rebuilt when nodes change.
+ */
+typedef struct {
+    uint32_t lut_base;  /*!< The lowest ID in the lookup table.            */
+    uint32_t lut_span;  /*!< ID number covered by the lookup table.        */
+    uint8_t *lut;       /*!< `lut_node` index + 1, 0 means not exist.      */
+    can_node_t **lut_node; /*!< Nodes referenced by the lookup table.      */
+    uint32_t group_num;    /*!< Valid mask group number.                   */
+    mask_group_t group[CAN_LIST_INDEX_MAX_GROUPS]; /*!< Mask groups.       */
+} can_index_t;
+
+#endif /* CAN_LIST_USE_INDEX */
+
 /**
  * @brief CAN hash table.
  */
 typedef struct {
     can_node_t **table; /*!< Node pointer array of table. */
     uint32_t len;       /*!< Table size.                  */
+#if CAN_LIST_USE_INDEX
+    can_index_t *index; /*!< Dispatch index of table.     */
+#if CAN_LIST_USE_STATIC_POOL
+    uintptr_t *index_buf[2]; /*!< Index memory, used in turn. */
+    uint32_t index_buf_size; /*!< Bytes of each index buffer.  */
+#endif                       /* CAN_LIST_USE_STATIC_POOL */
+#endif                  /* CAN_LIST_USE_INDEX */
 } hash_table_t;
 
 /**
@@ -72,6 +156,288 @@ typedef struct {
 /* The CAN instance, each CAN has an independent table. */
 can_table_t *can_table[CAN_LIST_MAX_CAN_NUMBER];
 
+#if CAN_LIST_USE_STATIC_POOL
+
+static can_table_t can_table_pool[CAN_LIST_MAX_CAN_NUMBER];
+static can_node_t *can_bucket_pool[CAN_LIST_POOL_BUCKET_NUMBER];
+static can_node_t can_node_pool[CAN_LIST_POOL_NODE_NUMBER];
+
+static mem_stack_t can_bucket_stack = MEM_STACK_INIT(can_bucket_pool);
+static mem_pool_t can_node_mem_pool = MEM_POOL_INIT(can_node_pool);
+
+#if CAN_LIST_USE_INDEX
+/**
+ * Words of the largest index of one table: the header, and at most
+ * `4 * node + 2 * group` pointers. The lookup table nodes are not more than
+ * the nodes, each group has the power of 2 slots not less than twice its
+ * nodes, i.e. less than `4 * count` or 2.
+ */
+#define CAN_LIST_POOL_INDEX_WORDS                                              \
+    ((sizeof(can_index_t) + sizeof(uintptr_t) - 1) / sizeof(uintptr_t) +      \
+     4 * CAN_LIST_POOL_NODE_NUMBER + 2 * CAN_LIST_INDEX_MAX_GROUPS)
+/* Standard ID table adds the lookup table, one byte per ID. */
+#define CAN_LIST_POOL_STD_INDEX_WORDS                                          \
+    (CAN_LIST_POOL_INDEX_WORDS +                                               \
+     (CAN_LIST_INDEX_MAX_STD_SPAN + sizeof(uintptr_t) - 1) / sizeof(uintptr_t))
+
+static uintptr_t can_std_index_pool[CAN_LIST_MAX_CAN_NUMBER][2]
+                                   [CAN_LIST_POOL_STD_INDEX_WORDS];
+static uintptr_t can_ext_index_pool[CAN_LIST_MAX_CAN_NUMBER][2]
+                                   [CAN_LIST_POOL_INDEX_WORDS];
+#endif /* CAN_LIST_USE_INDEX */
+
+#endif /* CAN_LIST_USE_STATIC_POOL */
+
+#if CAN_LIST_USE_INDEX
+static can_list_index_stats_t can_index_stats;
+#endif /* CAN_LIST_USE_INDEX */
+
+/**
+ * @}
+ */
+
+/*****************************************************************************
+ * @defgroup Memory management.
+ * @{
+ */
+
+/**
+ * @brief Allocate a CAN table.
+ *
+ * @param can_select Specific which CAN the table belongs to.
+ * @return The table, `NULL` if failed.
+ */
+static can_table_t *can_list_table_alloc(can_selected_t can_select) {
+#if CAN_LIST_USE_STATIC_POOL
+    can_table_t *table = &can_table_pool[can_select];
+    memset(table, 0, sizeof(can_table_t));
+#if CAN_LIST_USE_INDEX
+    hash_table_t *std_table = &table->id_table[STD_ID_TABLE];
+    hash_table_t *ext_table = &table->id_table[EXT_ID_TABLE];
+
+    std_table->index_buf[0] = can_std_index_pool[can_select][0];
+    std_table->index_buf[1] = can_std_index_pool[can_select][1];
+    std_table->index_buf_size = sizeof(can_std_index_pool[0][0]);
+    ext_table->index_buf[0] = can_ext_index_pool[can_select][0];
+    ext_table->index_buf[1] = can_ext_index_pool[can_select][1];
+    ext_table->index_buf_size = sizeof(can_ext_index_pool[0][0]);
+#endif /* CAN_LIST_USE_INDEX */
+    return table;
+#else  /* CAN_LIST_USE_STATIC_POOL */
+    UNUSED(can_select);
+    return (can_table_t *)CAN_LIST_CALLOC(1, sizeof(can_table_t));
+#endif /* CAN_LIST_USE_STATIC_POOL */
+}
+
+/**
+ * @brief Free a CAN table.
+ *
+ * @param table The table to free.
+ */
+static void can_list_table_free(can_table_t *table) {
+#if CAN_LIST_USE_STATIC_POOL
+    UNUSED(table);
+#else  /* CAN_LIST_USE_STATIC_POOL */
+    CAN_LIST_FREE(table);
+#endif /* CAN_LIST_USE_STATIC_POOL */
+}
+
+/**
+ * @brief Allocate zeroed hash buckets.
+ *
+ * @param len Bucket number.
+ * @return The buckets, `NULL` if failed.
+ */
+static can_node_t **can_list_bucket_alloc(uint32_t len) {
+#if CAN_LIST_USE_STATIC_POOL
+    if (len > CAN_LIST_POOL_BUCKET_NUMBER) {
+        return NULL;
+    }
+
+    can_node_t **bucket = (can_node_t **)mem_stack_alloc(
+        &can_bucket_stack, len * sizeof(can_node_t *));
+    if (bucket != NULL) {
+        memset(bucket, 0, len * sizeof(can_node_t *));
+    }
+    return bucket;
+#else  /* CAN_LIST_USE_STATIC_POOL */
+    return (can_node_t **)CAN_LIST_CALLOC(len, sizeof(can_node_t *));
+#endif /* CAN_LIST_USE_STATIC_POOL */
+}
+
+/**
+ * @brief Free hash buckets.
+ *
+ * @param bucket The buckets to free.
+ * @param len Bucket number.
+ * @note The bucket pool is a stack, only the last allocation can be returned.
+ */
+static void can_list_bucket_free(can_node_t **bucket, uint32_t len) {
+#if CAN_LIST_USE_STATIC_POOL
+    mem_stack_free(&can_bucket_stack, bucket, len * sizeof(can_node_t *));
+#else  /* CAN_LIST_USE_STATIC_POOL */
+    UNUSED(len);
+    CAN_LIST_FREE(bucket);
+#endif /* CAN_LIST_USE_STATIC_POOL */
+}
+
+/**
+ * @brief Allocate a node.
+ *
+ * @return The node, `NULL` if failed.
+ */
+static can_node_t *can_list_node_alloc(void) {
+#if CAN_LIST_USE_STATIC_POOL
+    return (can_node_t *)mem_pool_alloc(&can_node_mem_pool);
+#else  /* CAN_LIST_USE_STATIC_POOL */
+    return (can_node_t *)CAN_LIST_MALLOC(sizeof(can_node_t));
+#endif /* CAN_LIST_USE_STATIC_POOL */
+}
+
+/**
+ * @brief Free a node.
+ *
+ * @param node The node to free.
+ */
+static void can_list_node_free(can_node_t *node) {
+#if CAN_LIST_USE_STATIC_POOL
+    mem_pool_free(&can_node_mem_pool, node);
+#else  /* CAN_LIST_USE_STATIC_POOL */
+    CAN_LIST_FREE(node);
+#endif /* CAN_LIST_USE_STATIC_POOL */
+}
+
+#if CAN_LIST_USE_INDEX
+
+/**
+ * @brief Allocate zeroed dispatch index memory.
+ *
+ * @param table The table which the index belongs to.
+ * @param size Bytes to allocate.
+ * @return The memory, `NULL` if failed.
+ * @note In static pool mode, the buffer not used by current index is returned.
+ */
+static void *can_list_index_alloc(const hash_table_t *table, size_t size) {
+#if CAN_LIST_USE_STATIC_POOL
+    if (size > table->index_buf_size) {
+        return NULL;
+    }
+
+    uintptr_t *buf = table->index_buf[0];
+    if ((void *)table->index == (void *)buf) {
+        buf = table->index_buf[1];
+    }
+    memset(buf, 0, size);
+    return buf;
+#else  /* CAN_LIST_USE_STATIC_POOL */
+    UNUSED(table);
+    return CAN_LIST_CALLOC(1, size);
+#endif /* CAN_LIST_USE_STATIC_POOL */
+}
+
+/**
+ * @brief Free dispatch index memory.
+ *
+ * @param index The index to free.
+ */
+static void can_list_index_free(void *index) {
+#if CAN_LIST_USE_STATIC_POOL
+    UNUSED(index);
+#else  /* CAN_LIST_USE_STATIC_POOL */
+    CAN_LIST_FREE(index);
+#endif /* CAN_LIST_USE_STATIC_POOL */
+}
+
+/**
+ * @brief Get the statistics of the dispatch index.
+ *
+ * @param[out] stats The statistics.
+ */
+void can_list_get_index_stats(can_list_index_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+
+    *stats = can_index_stats;
+    stats->scanning = 0;
+
+    for (uint32_t i = 0; i < CAN_LIST_MAX_CAN_NUMBER; ++i) {
+        if (can_table[i] == NULL) {
+            continue;
+        }
+
+        for (uint32_t j = 0; j < 2; ++j) {
+            const hash_table_t *table = &can_table[i]->id_table[j];
+            if (table->index != NULL) {
+                continue;
+            }
+
+            /* The index of an empty table is not built yet. */
+            for (uint32_t k = 0; k < table->len; ++k) {
+                if (table->table[k] != NULL) {
+                    ++stats->scanning;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+#endif /* CAN_LIST_USE_INDEX */
+
+/**
+ * @brief Wait until the dispatcher no longer holds any index or node which
+ *        was unlinked before this call, then they can be freed.
+ *
+ * @note In RTOS mode, if the polling task is dispatching a frame, wait until
+ *       it finishes. Without RTOS the dispatcher is the CAN RX interrupt, it
+ *       has always returned when the thread runs.
+ */
+static void can_list_dispatch_sync(void) {
+#if CAN_LIST_USE_RTOS
+    /* Called from a callback, the polling task holds only the node of the
+     * running callback, which is not accessed after the callback returns. */
+    if ((can_list_task_handle == NULL) ||
+        (xTaskGetCurrentTaskHandle() == can_list_task_handle)) {
+        return;
+    }
+
+    /* The new index and list must be visible before the sequence is read. */
+    __DMB();
+    uint32_t seq = can_list_dispatch_seq;
+
+    if ((seq & 1) == 0) {
+        return;
+    }
+
+    while (can_list_dispatch_seq == seq) {
+        vTaskDelay(1);
+    }
+#endif /* CAN_LIST_USE_RTOS */
+}
+
+#if CAN_LIST_USE_STATIC_POOL
+
+/**
+ * @brief Get the usage of the static pool.
+ *
+ * @param[out] stats The pool usage.
+ */
+void can_list_get_pool_stats(can_list_pool_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+
+    stats->node_total = can_node_mem_pool.total;
+    stats->node_used = can_node_mem_pool.used;
+    stats->node_peak = can_node_mem_pool.peak;
+    stats->node_failed = can_node_mem_pool.failed;
+    stats->bucket_total = CAN_LIST_POOL_BUCKET_NUMBER;
+    stats->bucket_used = can_bucket_stack.used / sizeof(can_node_t *);
+}
+
+#endif /* CAN_LIST_USE_STATIC_POOL */
+
 /**
  * @}
  */
@@ -99,6 +465,243 @@ static can_node_t *can_list_find_node_by_id(const hash_table_t *table,
     return node;
 }
 
+#if CAN_LIST_USE_INDEX
+
+/**
+ * @brief Hash the masked ID into the slot index of mask group.
+ *
+ * @param key The masked ID.
+ * @param shift The shift of the group.
+ * @return Slot index.
+ */
+static inline uint32_t can_list_index_hash(uint32_t key, uint32_t shift) {
+    /* Fibonacci hashing, `shift` is never 32. */
+    return (key * 0x9E3779B1U) >> shift;
+}
+
+/**
+ * @brief Find the node which matches the received ID in the index.
+ *
+ * @param index The dispatch index.
+ * @param id The received ID.
+ * @return The node found, `NULL` if not found.
+ * @note The cost is bounded by the group number and the max probe length.
+ */
+static inline can_node_t *can_list_index_lookup(const can_index_t *index,
+                                                uint32_t id) {
+    if ((id - index->lut_base) < index->lut_span) {
+        uint8_t pos = index->lut[id - index->lut_base];
+        if (pos != 0) {
+            return index->lut_node[pos - 1];
+        }
+    }
+
+    for (uint32_t i = 0; i < index->group_num; ++i) {
+        const mask_group_t *group = &index->group[i];
+        uint32_t key = id & group->mask;
+        uint32_t slot_mask = 0xFFFFFFFFU >> group->shift;
+        uint32_t pos = can_list_index_hash(key, group->shift);
+
+        for (uint32_t probe = 0; probe <= group->max_probe; ++probe) {
+            can_node_t *node = group->slot[pos];
+            if (node == NULL) {
+                break;
+            }
+            if (node->id == key) {
+                return node;
+            }
+            pos = (pos + 1) & slot_mask;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Build the dispatch index of a table.
+ *
+ * @param table The table to build.
+ * @param id_type `STD_ID_TABLE` or `EXT_ID_TABLE`.
+ * @return The index built, `NULL` if failed, the reason is recorded in
+ *         `can_index_stats.last_error`.
+ * @note The index, the lookup table and all the slots are placed in one memory
+ *       block, so it can be replaced and freed at once.
+ */
+static can_index_t *can_list_index_build(const hash_table_t *table,
+                                         uint32_t id_type) {
+    uint32_t lut_min = 0xFFFFFFFFU, lut_max = 0, lut_num = 0;
+    uint32_t group_mask[CAN_LIST_INDEX_MAX_GROUPS];
+    uint32_t group_count[CAN_LIST_INDEX_MAX_GROUPS] = {0};
+    uint32_t group_slots[CAN_LIST_INDEX_MAX_GROUPS];
+    uint32_t group_num = 0;
+    uint32_t i;
+    can_node_t *node;
+
+    /* Pass 1: classify the nodes and count the memory needed. */
+    for (i = 0; i < table->len; ++i) {
+        for (node = table->table[i]; node != NULL; node = node->next) {
+            if ((id_type == STD_ID_TABLE) && ((node->id_mask & 0x7FF) == 0x7FF)
+                && (node->id <= 0x7FF) && (lut_num < 0xFF)) {
+                lut_min = (node->id < lut_min) ? node->id : lut_min;
+                lut_max = (node->id > lut_max) ? node->id : lut_max;
+                ++lut_num;
+                continue;
+            }
+
+            uint32_t g;
+            for (g = 0; g < group_num; ++g) {
+                if (group_mask[g] == node->id_mask) {
+                    break;
+                }
+            }
+            if (g == group_num) {
+                if (group_num == CAN_LIST_INDEX_MAX_GROUPS) {
+                    can_index_stats.last_error = CAN_LIST_INDEX_ERR_GROUPS;
+                    return NULL;
+                }
+                group_mask[group_num++] = node->id_mask;
+            }
+            ++group_count[g];
+        }
+    }
+
+    if (lut_num != 0 && (lut_max - lut_min + 1) > CAN_LIST_INDEX_MAX_STD_SPAN) {
+        can_index_stats.last_error = CAN_LIST_INDEX_ERR_SPAN;
+        return NULL;
+    }
+
+    uint32_t lut_span = (lut_num != 0) ? (lut_max - lut_min + 1) : 0;
+    size_t size = sizeof(can_index_t) + lut_num * sizeof(can_node_t *);
+
+    for (i = 0; i < group_num; ++i) {
+        /* Keep the load factor not greater than 0.5. */
+        group_slots[i] = 2;
+        while (group_slots[i] < group_count[i] * 2) {
+            group_slots[i] <<= 1;
+        }
+        size += group_slots[i] * sizeof(can_node_t *);
+    }
+    size += lut_span;
+
+    can_index_t *index = (can_index_t *)can_list_index_alloc(table, size);
+    if (index == NULL) {
+        can_index_stats.last_error = CAN_LIST_INDEX_ERR_MEMORY;
+        return NULL;
+    }
+
+    /* Pass 2: layout the memory block, pointer arrays first. */
+    can_node_t **ptr = (can_node_t **)(index + 1);
+    index->lut_node = ptr;
+    ptr += lut_num;
+    for (i = 0; i < group_num; ++i) {
+        uint32_t bits = 0;
+        while ((1U << bits) < group_slots[i]) {
+            ++bits;
+        }
+        index->group[i].mask = group_mask[i];
+        index->group[i].shift = 32 - bits;
+        index->group[i].slot = ptr;
+        ptr += group_slots[i];
+    }
+    index->group_num = group_num;
+    index->lut = (uint8_t *)ptr;
+    index->lut_base = (lut_num != 0) ? lut_min : 0;
+    index->lut_span = lut_span;
+
+    /* Pass 3: fill the lookup table and the mask groups. */
+    uint32_t lut_pos = 0;
+    for (i = 0; i < table->len; ++i) {
+        for (node = table->table[i]; node != NULL; node = node->next) {
+            if ((id_type == STD_ID_TABLE) && ((node->id_mask & 0x7FF) == 0x7FF)
+                && (node->id <= 0x7FF) && (lut_pos < lut_num)) {
+                index->lut_node[lut_pos++] = node;
+                index->lut[node->id - index->lut_base] = (uint8_t)lut_pos;
+                continue;
+            }
+
+            mask_group_t *group = index->group;
+            while (group->mask != node->id_mask) {
+                ++group;
+            }
+
+            uint32_t slot_mask = 0xFFFFFFFFU >> group->shift;
+            uint32_t pos = can_list_index_hash(node->id, group->shift);
+            uint32_t probe = 0;
+            while (group->slot[pos] != NULL) {
+                pos = (pos + 1) & slot_mask;
+                ++probe;
+            }
+            group->slot[pos] = node;
+            if (probe > group->max_probe) {
+                group->max_probe = probe;
+            }
+        }
+    }
+
+    return index;
+}
+
+/**
+ * @brief Rebuild and replace the dispatch index of a table.
+ *
+ * @param table The table to rebuild.
+ * @param id_type `STD_ID_TABLE` or `EXT_ID_TABLE`.
+ * @return The replaced index, free it by `can_list_index_free()` after
+ *         `can_list_dispatch_sync()`.
+ * @note If the index can not be built, the messages will be dispatched by
+ *       scanning the table, and the failure is counted.
+ */
+static can_index_t *can_list_index_update(hash_table_t *table,
+                                          uint32_t id_type) {
+    can_index_t *old_index = table->index;
+    can_index_t *new_index = can_list_index_build(table, id_type);
+
+    ++can_index_stats.rebuilt;
+    if (new_index == NULL) {
+        ++can_index_stats.failed;
+    }
+
+    /* Single pointer store, the dispatcher sees either the old or the new
+     * index. */
+    table->index = new_index;
+
+    return old_index;
+}
+
+#endif /* CAN_LIST_USE_INDEX */
+
+/**
+ * @brief Find the node which matches the received ID.
+ *
+ * @param table Table to search.
+ * @param id The received ID.
+ * @return The node found, `NULL` if not found.
+ */
+static can_node_t *can_list_match_node(const hash_table_t *table,
+                                       const uint32_t id) {
+#if CAN_LIST_USE_INDEX
+    if (table->index != NULL) {
+        return can_list_index_lookup(table->index, id);
+    }
+#endif /* CAN_LIST_USE_INDEX */
+
+    /* The received ID may contain some data bits, so it is not always in the
+     * same bucket with the node. Scan the whole table. */
+    for (uint32_t i = 0; i < table->len; ++i) {
+        can_node_t *node = table->table[i];
+
+        while ((node != NULL) && (node->id != (id & node->id_mask))) {
+            node = node->next;
+        }
+
+        if (node != NULL) {
+            return node;
+        }
+    }
+
+    return NULL;
+}
+
 /**
  * @brief Create a CAN table to receive and process the CAN message.
  *
@@ -121,31 +724,36 @@ uint8_t can_list_add_can(can_selected_t can_select, uint32_t std_len,
         return 2;
     }
 
-    can_table[can_select] = (can_table_t *)CAN_LIST_MALLOC(sizeof(can_table_t));
-    if (can_table[can_select] == NULL) {
+    can_table_t *new_table = can_list_table_alloc(can_select);
+    if (new_table == NULL) {
         return 3;
     }
 
-    can_table[can_select]->id_table[STD_ID_TABLE].table =
-        (can_node_t **)CAN_LIST_CALLOC(std_len, sizeof(can_node_t *));
-    if (can_table[can_select]->id_table[STD_ID_TABLE].table == NULL) {
-        CAN_LIST_FREE(can_table[can_select]);
-        can_table[can_select] = NULL;
+    new_table->id_table[STD_ID_TABLE].table = can_list_bucket_alloc(std_len);
+    if (new_table->id_table[STD_ID_TABLE].table == NULL) {
+        can_list_table_free(new_table);
         return 3;
     }
-    can_table[can_select]->id_table[STD_ID_TABLE].len = std_len;
+    new_table->id_table[STD_ID_TABLE].len = std_len;
 
-    can_table[can_select]->id_table[EXT_ID_TABLE].table =
-        (can_node_t **)CAN_LIST_CALLOC(ext_len, sizeof(can_node_t *));
-    if (can_table[can_select]->id_table[EXT_ID_TABLE].table == NULL) {
-        CAN_LIST_FREE(can_table[can_select]->id_table[STD_ID_TABLE].table);
-        CAN_LIST_FREE(can_table[can_select]);
-        can_table[can_select] = NULL;
+    new_table->id_table[EXT_ID_TABLE].table = can_list_bucket_alloc(ext_len);
+    if (new_table->id_table[EXT_ID_TABLE].table == NULL) {
+        can_list_bucket_free(new_table->id_table[STD_ID_TABLE].table, std_len);
+        can_list_table_free(new_table);
         return 3;
     }
-    can_table[can_select]->id_table[EXT_ID_TABLE].len = ext_len;
+    new_table->id_table[EXT_ID_TABLE].len = ext_len;
+
+    can_table[can_select] = new_table;
 
 #if CAN_LIST_USE_RTOS
+#if CAN_LIST_USE_FRAME_RING
+    if (can_list_task_handle == NULL) {
+        xTaskCreate(can_list_polling_task, CAN_LIST_TASK_NAME,
+                    CAN_LSIT_TASK_STK_SIZE, NULL, CAN_LIST_TASK_PRIORITY,
+                    &can_list_task_handle);
+    }
+#else  /* CAN_LIST_USE_FRAME_RING */
     if (can_list_queue_handle == NULL) {
         can_list_queue_handle =
             xQueueCreate(CAN_LIST_QUEUE_LENGTH, sizeof(queue_msg_t));
@@ -153,6 +761,7 @@ uint8_t can_list_add_can(can_selected_t can_select, uint32_t std_len,
                     CAN_LSIT_TASK_STK_SIZE, NULL, CAN_LIST_TASK_PRIORITY,
                     &can_list_task_handle);
     }
+#endif /* CAN_LIST_USE_FRAME_RING */
 #endif /* CAN_LIST_USE_RTOS */
 
     return 0;
@@ -205,7 +814,7 @@ uint8_t can_list_add_new_node(can_selected_t can_select, void *node_data,
         return 4;
     }
 
-    can_node_t *new_node = (can_node_t *)CAN_LIST_MALLOC(sizeof(can_node_t));
+    can_node_t *new_node = can_list_node_alloc();
     if (new_node == NULL) {
         return 5;
     }
@@ -221,6 +830,14 @@ uint8_t can_list_add_new_node(can_selected_t can_select, void *node_data,
     new_node->next = *table_head;
     *table_head = new_node;
 
+#if CAN_LIST_USE_INDEX
+    can_index_t *old_index = can_list_index_update(table, id_type);
+    if (old_index != NULL) {
+        can_list_dispatch_sync();
+        can_list_index_free(old_index);
+    }
+#endif /* CAN_LIST_USE_INDEX */
+
     return 0;
 }
 
@@ -277,7 +894,21 @@ uint8_t can_list_del_node_by_id(can_selected_t can_select, uint32_t id_type,
 
     previous_node->next = current_node->next;
 
-    CAN_LIST_FREE(current_node);
+#if CAN_LIST_USE_INDEX
+    /* Drop the reference from the index before the node is freed. */
+    can_index_t *old_index = can_list_index_update(table, id_type);
+#endif /* CAN_LIST_USE_INDEX */
+
+    /* The dispatcher may still be walking the old index or the list. */
+    can_list_dispatch_sync();
+
+#if CAN_LIST_USE_INDEX
+    if (old_index != NULL) {
+        can_list_index_free(old_index);
+    }
+#endif /* CAN_LIST_USE_INDEX */
+
+    can_list_node_free(current_node);
 
     return 0;
 }
@@ -338,6 +969,222 @@ uint8_t can_list_change_callback(can_selected_t can_select, uint32_t id_type,
 
 #if CAN_LIST_USE_RTOS
 
+#if CAN_LIST_USE_FRAME_RING
+
+/**
+ * @brief Get which CAN the handle belongs to.
+ *
+ * @param hcan The handle of CAN.
+ * @return The CAN selected, `CAN_LIST_MAX_CAN_NUMBER` if not found.
+ */
+static uint8_t can_list_get_can_received(can_list_handle_t *hcan) {
+    switch ((uintptr_t)(hcan->Instance)) {
+#if CAN_LIST_USE_FDCAN
+#if FDCAN1_ENABLE
+        case FDCAN1_BASE: {
+            return can1_selected;
+        }
+#endif /* FDCAN1_ENABLE */
+
+#if FDCAN2_ENABLE
+        case FDCAN2_BASE: {
+            return can2_selected;
+        }
+#endif /* FDCAN2_ENABLE */
+
+#if FDCAN3_ENABLE
+        case FDCAN3_BASE: {
+            return can3_selected;
+        }
+#endif /* FDCAN3_ENABLE */
+#else /* CAN_LIST_USE_FDCAN */
+#if CAN1_ENABLE
+        case CAN1_BASE: {
+            return can1_selected;
+        }
+#endif /* CAN1_ENABLE */
+
+#if CAN2_ENABLE
+        case CAN2_BASE: {
+            return can2_selected;
+        }
+#endif /* CAN2_ENABLE */
+
+#if CAN3_ENABLE
+        case CAN3_BASE: {
+            return can3_selected;
+        }
+#endif /* CAN3_ENABLE */
+#endif /* CAN_LIST_USE_FDCAN */
+
+        default:
+            return CAN_LIST_MAX_CAN_NUMBER;
+    }
+}
+
+/**
+ * @brief Read all pending frames of the FIFO into the ring. Called in ISR.
+ *
+ * @param hcan The handle of CAN.
+ * @param rx_fifo Specific which FIFO will read.
+ * @note The FIFO is always drained, the frames which can not be pushed are
+ *       dropped and counted as overrun.
+ */
+static void can_list_ring_drain(can_list_handle_t *hcan, uint32_t rx_fifo) {
+    /* Frames that can not be stored are read here. */
+    static can_frame_t discard_frame;
+#if CAN_LIST_USE_FDCAN
+    FDCAN_RxHeaderTypeDef rx_header;
+#else  /* CAN_LIST_USE_FDCAN */
+    CAN_RxHeaderTypeDef rx_header;
+#endif /* CAN_LIST_USE_FDCAN */
+
+    uint8_t can_received = can_list_get_can_received(hcan);
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    uint32_t pushed = 0;
+
+    UBaseType_t saved_status = taskENTER_CRITICAL_FROM_ISR();
+
+    uint32_t tail = can_list_ring.tail;
+
+#if CAN_LIST_USE_FDCAN
+    while (HAL_FDCAN_GetRxFifoFillLevel(hcan, rx_fifo) != 0) {
+#else  /* CAN_LIST_USE_FDCAN */
+    while (HAL_CAN_GetRxFifoFillLevel(hcan, rx_fifo) != 0) {
+#endif /* CAN_LIST_USE_FDCAN */
+        uint32_t used = tail - can_list_ring.head;
+        can_frame_t *frame = &discard_frame;
+
+        if ((can_received < CAN_LIST_MAX_CAN_NUMBER) &&
+            (used < CAN_LIST_RING_LENGTH)) {
+            frame = &can_list_ring.frame[tail & (CAN_LIST_RING_LENGTH - 1)];
+        }
+
+#if CAN_LIST_USE_FDCAN
+        if (HAL_FDCAN_GetRxMessage(hcan, rx_fifo, &rx_header, frame->data) !=
+            HAL_OK) {
+            break;
+        }
+#else  /* CAN_LIST_USE_FDCAN */
+        if (HAL_CAN_GetRxMessage(hcan, rx_fifo, &rx_header, frame->data) !=
+            HAL_OK) {
+            break;
+        }
+#endif /* CAN_LIST_USE_FDCAN */
+
+        if (frame == &discard_frame) {
+            if (can_received < CAN_LIST_MAX_CAN_NUMBER) {
+                ++can_list_ring_stats.overrun;
+            }
+            continue;
+        }
+
+#if CAN_LIST_USE_FDCAN
+        frame->header.id = rx_header.Identifier;
+        frame->header.id_type = rx_header.IdType;
+        frame->header.frame_type = rx_header.RxFrameType;
+        frame->header.data_length = rx_header.DataLength;
+#else  /* CAN_LIST_USE_FDCAN */
+        frame->header.id =
+            (rx_header.IDE == CAN_ID_STD) ? rx_header.StdId : rx_header.ExtId;
+        frame->header.id_type = rx_header.IDE;
+        frame->header.frame_type = rx_header.RTR;
+        frame->header.data_length = rx_header.DLC;
+#endif /* CAN_LIST_USE_FDCAN */
+        frame->header.timestamp = CAN_LIST_TIMESTAMP();
+        frame->can_received = can_received;
+
+        ++tail;
+        ++pushed;
+        if (used + 1 > can_list_ring_stats.high_watermark) {
+            can_list_ring_stats.high_watermark = used + 1;
+        }
+    }
+
+    can_list_ring_stats.received += pushed;
+
+    /* The frames must be visible before the new tail. */
+    __DMB();
+    can_list_ring.tail = tail;
+
+    taskEXIT_CRITICAL_FROM_ISR(saved_status);
+
+    if ((pushed != 0) && (can_list_task_handle != NULL)) {
+        vTaskNotifyGiveFromISR(can_list_task_handle,
+                               &higher_priority_task_woken);
+        portYIELD_FROM_ISR(higher_priority_task_woken);
+    }
+}
+
+/**
+ * @brief Get the statistics of the frame ring.
+ *
+ * @param[out] stats The statistics.
+ */
+void can_list_get_ring_stats(can_list_ring_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    *stats = can_list_ring_stats;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief CAN list polling task. Dispatch all the frames in the ring after
+ *        notified by the ISR.
+ *
+ * @param args Start arguments.
+ */
+void can_list_polling_task(void *args) {
+    UNUSED(args);
+
+    uint32_t head = can_list_ring.head;
+    can_frame_t *frame;
+    hash_table_t *table;
+    can_node_t *node;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        while (head != can_list_ring.tail) {
+            /* Read the frame after the tail. */
+            __DMB();
+            frame = &can_list_ring.frame[head & (CAN_LIST_RING_LENGTH - 1)];
+
+            ++can_list_dispatch_seq;
+            /* Mark the dispatching before the index is read. */
+            __DMB();
+
+            if (can_table[frame->can_received] != NULL) {
+                if (frame->header.id_type == CAN_LIST_STD_ID_TYPE) {
+                    table =
+                        &can_table[frame->can_received]->id_table[STD_ID_TABLE];
+                } else {
+                    table =
+                        &can_table[frame->can_received]->id_table[EXT_ID_TABLE];
+                }
+
+                node = can_list_match_node(table, frame->header.id);
+
+                if (node != NULL && node->callback != NULL) {
+                    node->callback(node->can_data, &frame->header, frame->data);
+                }
+            }
+
+            __DMB();
+            ++can_list_dispatch_seq;
+
+            /* Release the slot after the frame is consumed. */
+            __DMB();
+            can_list_ring.head = ++head;
+        }
+    }
+}
+
+#else /* CAN_LIST_USE_FRAME_RING */
+
 /**
  * @brief CAN list polling task.
  *
@@ -408,13 +1255,15 @@ void can_list_polling_task(void *args) {
         }
         id = rx_header.Identifier;
 
-        node = table->table[id % table->len];
+        ++can_list_dispatch_seq;
+        /* Mark the dispatching before the index is read. */
+        __DMB();
 
-        while ((node != NULL) && (node->id) != (id & node->id_mask)) {
-            node = node->next;
-        }
+        node = can_list_match_node(table, id);
 
         if (node == NULL || node->callback == NULL) {
+            __DMB();
+            ++can_list_dispatch_seq;
             continue;
         }
 
@@ -468,13 +1317,15 @@ void can_list_polling_task(void *args) {
             id = rx_header.ExtId;
         }
 
-        node = table->table[id % table->len];
+        ++can_list_dispatch_seq;
+        /* Mark the dispatching before the index is read. */
+        __DMB();
 
-        while ((node != NULL) && (node->id) != (id & node->id_mask)) {
-            node = node->next;
-        }
+        node = can_list_match_node(table, id);
 
         if (node == NULL || node->callback == NULL) {
+            __DMB();
+            ++can_list_dispatch_seq;
             continue;
         }
 
@@ -485,11 +1336,17 @@ void can_list_polling_task(void *args) {
 #endif /* CAN_LIST_USE_FDCAN */
 
         call_rx_header.id = id;
+        call_rx_header.timestamp = CAN_LIST_TIMESTAMP();
 
         node->callback(node->can_data, &call_rx_header, rx_data);
+
+        __DMB();
+        ++can_list_dispatch_seq;
     }
 }
 
+#endif /* CAN_LIST_USE_FRAME_RING */
+
 #else /* CAN_LIST_USE_RTOS */
 
 #if CAN_LIST_USE_FDCAN
@@ -610,17 +1467,14 @@ static void can_message_process(CAN_HandleTypeDef *hcan, uint32_t rx_fifo) {
     }
 #endif /* CAN_LIST_USE_FDCAN */
 
-    can_node_t *node = table->table[id % table->len];
-
-    while ((node != NULL) && (node->id) != (id & node->id_mask)) {
-        node = node->next;
-    }
+    can_node_t *node = can_list_match_node(table, id);
 
     if (node == NULL || node->callback == NULL) {
         return;
     }
 
     call_rx_header.id = id;
+    call_rx_header.timestamp = CAN_LIST_TIMESTAMP();
 
 #if CAN_LIST_USE_FDCAN
     call_rx_header.id_type = rx_header.IdType;
@@ -663,6 +1517,9 @@ void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan,
     }
 
 #if CAN_LIST_USE_RTOS
+#if CAN_LIST_USE_FRAME_RING
+    can_list_ring_drain(hfdcan, FDCAN_RX_FIFO0);
+#else  /* CAN_LIST_USE_FRAME_RING */
     if (can_list_queue_handle == NULL) {
         return;
     }
@@ -670,6 +1527,7 @@ void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan,
     send_msg_from_isr.hcan = hfdcan;
     send_msg_from_isr.rx_fifo = FDCAN_RX_FIFO0;
     xQueueSendFromISR(can_list_queue_handle, &send_msg_from_isr, NULL);
+#endif /* CAN_LIST_USE_FRAME_RING */
 #else  /* CAN_LIST_USE_RTOS */
     can_message_process(hfdcan, FDCAN_RX_FIFO0);
 #endif /* CAN_LIST_USE_RTOS */
@@ -689,6 +1547,9 @@ void HAL_FDCAN_RxFifo1Callback(FDCAN_HandleTypeDef *hfdcan,
     }
 
 #if CAN_LIST_USE_RTOS
+#if CAN_LIST_USE_FRAME_RING
+    can_list_ring_drain(hfdcan, FDCAN_RX_FIFO1);
+#else  /* CAN_LIST_USE_FRAME_RING */
     if (can_list_queue_handle == NULL) {
         return;
     }
@@ -696,6 +1557,7 @@ void HAL_FDCAN_RxFifo1Callback(FDCAN_HandleTypeDef *hfdcan,
     send_msg_from_isr.hcan = hfdcan;
     send_msg_from_isr.rx_fifo = FDCAN_RX_FIFO1;
     xQueueSendFromISR(can_list_queue_handle, &send_msg_from_isr, NULL);
+#endif /* CAN_LIST_USE_FRAME_RING */
 #else  /* CAN_LIST_USE_RTOS */
     can_message_process(hfdcan, FDCAN_RX_FIFO1);
 #endif /* CAN_LIST_USE_RTOS */
@@ -709,6 +1571,9 @@ void HAL_FDCAN_RxFifo1Callback(FDCAN_HandleTypeDef *hfdcan,
  */
 void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan) {
 #if CAN_LIST_USE_RTOS
+#if CAN_LIST_USE_FRAME_RING
+    can_list_ring_drain(hcan, CAN_RX_FIFO0);
+#else  /* CAN_LIST_USE_FRAME_RING */
     if (can_list_queue_handle == NULL) {
         return;
     }
@@ -717,6 +1582,7 @@ void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan) {
     send_msg_from_isr.rx_fifo = CAN_RX_FIFO0;
     xQueueSendFromISR(can_list_queue_handle, &send_msg_from_isr, NULL);
     HAL_CAN_DeactivateNotification(hcan, CAN_IT_RX_FIFO0_MSG_PENDING);
+#endif /* CAN_LIST_USE_FRAME_RING */
 #else  /* CAN_LIST_USE_RTOS */
     can_message_process(hcan, CAN_RX_FIFO0);
 #endif /* CAN_LIST_USE_RTOS */
@@ -729,6 +1595,9 @@ void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan) {
  */
 void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan) {
 #if CAN_LIST_USE_RTOS
+#if CAN_LIST_USE_FRAME_RING
+    can_list_ring_drain(hcan, CAN_RX_FIFO1);
+#else  /* CAN_LIST_USE_FRAME_RING */
     if (can_list_queue_handle == NULL) {
         return;
     }
@@ -737,6 +1606,7 @@ void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan) {
     send_msg_from_isr.rx_fifo = CAN_RX_FIFO1;
     xQueueSendFromISR(can_list_queue_handle, &send_msg_from_isr, NULL);
     HAL_CAN_DeactivateNotification(hcan, CAN_IT_RX_FIFO1_MSG_PENDING);
+#endif /* CAN_LIST_USE_FRAME_RING */
 #else  /* CAN_LIST_USE_RTOS */
     can_message_process(hcan, CAN_RX_FIFO1);
 #endif /* CAN_LIST_USE_RTOS */
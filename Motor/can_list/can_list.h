@@ -26,6 +26,71 @@ extern "C" {
 #define CAN_LIST_CALLOC(x, p)   calloc(x, p)
 #define CAN_LIST_FREE(p)        free(p)
 
+/**
+ * When enabled, the tables and nodes are allocated from compile-time sized
+ * static pools instead of `CAN_LIST_MALLOC`. Node allocation and free are O(1)
+ * through a free list (`Utils/mem_pool`), the startup time no longer depends
+ * on the heap.
+ *
+ * The dispatch index memory is sized from `CAN_LIST_POOL_NODE_NUMBER` and the
+ * index limits, so it is enough for any node layout. Each ID table has two
+ * buffers. A buffer holds the index header and up to
+ * `4 * CAN_LIST_POOL_NODE_NUMBER + 2 * CAN_LIST_INDEX_MAX_GROUPS` pointers,
+ * the standard ID buffers add `CAN_LIST_INDEX_MAX_STD_SPAN` bytes of lookup
+ * table. With the default configuration on Cortex-M this is about 20KB for 3
+ * CANs, reduce `CAN_LIST_INDEX_MAX_STD_SPAN` to the ID range actually used
+ * (e.g. 0x40 for DJI motors) to save memory.
+ */
+#ifndef CAN_LIST_USE_STATIC_POOL
+#define CAN_LIST_USE_STATIC_POOL 0
+#endif /* CAN_LIST_USE_STATIC_POOL */
+
+#if CAN_LIST_USE_STATIC_POOL
+/* Total node number of all CANs. */
+#define CAN_LIST_POOL_NODE_NUMBER   32
+/* Total hash bucket number of all CANs (sum of `std_len` and `ext_len`). */
+#define CAN_LIST_POOL_BUCKET_NUMBER 32
+#endif /* CAN_LIST_USE_STATIC_POOL */
+
+/**
+ * When enabled, a dispatch index is rebuilt every time a node is added or
+ * deleted. Received messages are looked up through the index instead of
+ * walking the hash list, so the lookup cost is bounded and does not depend on
+ * the node count:
+ *
+ * - Standard ID nodes with full mask (0x7FF) are placed in a compact lookup
+ *   table covering [min ID, max ID], one byte per ID.
+ * - Other nodes are grouped by their ID mask, each group is an open-addressed
+ *   hash table with a recorded maximum probe length.
+ *
+ * When disabled (or the index can not be built), the messages are dispatched
+ * by scanning the whole hash table. Build failures are counted, see
+ * `can_list_get_index_stats()`.
+ *
+ * The replaced index and the deleted node are freed only after the dispatcher
+ * has left them. In RTOS mode `can_list_add_new_node()` and
+ * `can_list_del_node_by_id()` wait (`vTaskDelay(1)`) until the polling task
+ * finishes the frame it is dispatching, so they must be called from a task.
+ * Without RTOS they must not be called from an interrupt which can preempt the
+ * CAN RX interrupt.
+ */
+#define CAN_LIST_USE_INDEX 1
+
+#if CAN_LIST_USE_INDEX
+/* Maximum number of different ID masks of one ID type on one CAN. */
+#define CAN_LIST_INDEX_MAX_GROUPS   4
+/* Maximum ID span of the standard ID lookup table. */
+#define CAN_LIST_INDEX_MAX_STD_SPAN   0x800
+
+#if (CAN_LIST_INDEX_MAX_STD_SPAN < 1) || (CAN_LIST_INDEX_MAX_STD_SPAN > 0x800)
+#error "CAN_LIST_INDEX_MAX_STD_SPAN must be in [1, 0x800]."
+#endif /* CAN_LIST_INDEX_MAX_STD_SPAN */
+
+#if CAN_LIST_INDEX_MAX_GROUPS < 1
+#error "CAN_LIST_INDEX_MAX_GROUPS must be at least 1."
+#endif /* CAN_LIST_INDEX_MAX_GROUPS */
+#endif /* CAN_LIST_USE_INDEX */
+
 /**
  * When disabled, the message is processed in the interrupt.
  *
@@ -36,15 +101,45 @@ extern "C" {
  * Attention: Only support FreeRTOS. You should modify the code if you want use
  * other RTOS.
  */
+#ifndef CAN_LIST_USE_RTOS
 #define CAN_LIST_USE_RTOS       0
+#endif /* CAN_LIST_USE_RTOS */
 
 #if CAN_LIST_USE_RTOS
 #define CAN_LIST_TASK_NAME     "Can list"
 #define CAN_LIST_TASK_PRIORITY 2
 #define CAN_LSIT_TASK_STK_SIZE 256
 #define CAN_LIST_QUEUE_LENGTH  5
+
+/**
+ * When enabled, the interrupt reads every pending frame of the FIFO into a
+ * statically allocated single-producer/single-consumer ring, then notifies the
+ * processing thread. The thread dispatches all the frames in the ring at once.
+ * The notification of bxCAN will not be deactivated, so the hardware FIFO will
+ * not overrun while the thread is busy.
+ *
+ * When disabled (default), only the handle and FIFO are sent to a FreeRTOS
+ * queue, the thread reads one frame each time.
+ *
+ * Attention: All the CAN RX interrupts should be managed by FreeRTOS, the
+ * frames are pushed inside `taskENTER_CRITICAL_FROM_ISR()`. The ring takes
+ * `CAN_LIST_RING_LENGTH` frames of RAM (about 1KB for bxCAN, 2.8KB for FDCAN
+ * with the default length).
+ */
+#ifndef CAN_LIST_USE_FRAME_RING
+#define CAN_LIST_USE_FRAME_RING 0
+#endif /* CAN_LIST_USE_FRAME_RING */
+
+#if CAN_LIST_USE_FRAME_RING
+/* Frame number of the ring, must be power of 2. */
+#define CAN_LIST_RING_LENGTH 32
+#endif /* CAN_LIST_USE_FRAME_RING */
+
 #endif /* CAN_LIST_USE_RTOS */
 
+/* Timestamp of the received message, passed to callback in the rx header. */
+#define CAN_LIST_TIMESTAMP() HAL_GetTick()
+
 /**
  * @brief Message header type. Compatibility with FDCAN.
  */
@@ -53,8 +148,52 @@ typedef struct {
     uint32_t id_type;    /*!< ID type, `CAN_ID_STD` or `CAN_ID_EXT`.          */
     uint32_t frame_type; /*!< Frame type, `CAN_RTR_DATA` or `CAN_RTR_REMOTE`. */
     uint8_t data_length; /*!< Message Data length.                            */
+    uint32_t timestamp;  /*!< Receive time, see `CAN_LIST_TIMESTAMP()`.       */
 } can_rx_header_t;
 
+#if CAN_LIST_USE_STATIC_POOL
+/**
+ * @brief Usage of the static pool.
+ */
+typedef struct {
+    uint32_t node_total;   /*!< Node number of the pool.                 */
+    uint32_t node_used;    /*!< Nodes in use.                            */
+    uint32_t node_peak;    /*!< The most nodes in use at the same time.  */
+    uint32_t node_failed;  /*!< Allocations failed since pool exhausted. */
+    uint32_t bucket_total; /*!< Bucket number of the pool.               */
+    uint32_t bucket_used;  /*!< Buckets in use.                          */
+} can_list_pool_stats_t;
+#endif /* CAN_LIST_USE_STATIC_POOL */
+
+#if CAN_LIST_USE_INDEX
+/* Reason of the last index build failure. */
+#define CAN_LIST_INDEX_ERR_NONE   0 /* No failure.                            */
+#define CAN_LIST_INDEX_ERR_GROUPS 1 /* More than `CAN_LIST_INDEX_MAX_GROUPS`. */
+#define CAN_LIST_INDEX_ERR_SPAN   2 /* Over `CAN_LIST_INDEX_MAX_STD_SPAN`.    */
+#define CAN_LIST_INDEX_ERR_MEMORY 3 /* Memory allocated failed.               */
+
+/**
+ * @brief Statistics of the dispatch index.
+ */
+typedef struct {
+    uint32_t rebuilt;    /*!< Index rebuilds, one per node added or deleted.  */
+    uint32_t failed;     /*!< Rebuilds failed, see `last_error`.              */
+    uint32_t scanning;   /*!< ID tables dispatched by scanning at present.    */
+    uint32_t last_error; /*!< Reason of last failure, `CAN_LIST_INDEX_ERR_*`. */
+} can_list_index_stats_t;
+#endif /* CAN_LIST_USE_INDEX */
+
+#if CAN_LIST_USE_RTOS && CAN_LIST_USE_FRAME_RING
+/**
+ * @brief Statistics of the frame ring.
+ */
+typedef struct {
+    uint32_t received;       /*!< Frames pushed into the ring.              */
+    uint32_t overrun;        /*!< Frames dropped because the ring is full.  */
+    uint32_t high_watermark; /*!< The most frames waiting in the ring.      */
+} can_list_ring_stats_t;
+#endif /* CAN_LIST_USE_RTOS && CAN_LIST_USE_FRAME_RING */
+
 /**
  * @brief CAN callback function pointer.
  *
@@ -77,6 +216,18 @@ uint8_t can_list_del_node_by_id(can_selected_t can_select, uint32_t id_type,
 uint8_t can_list_change_callback(can_selected_t can_select, uint32_t id_type,
                                  uint32_t id, can_callback_t new_callback);
 
+#if CAN_LIST_USE_INDEX
+void can_list_get_index_stats(can_list_index_stats_t *stats);
+#endif /* CAN_LIST_USE_INDEX */
+
+#if CAN_LIST_USE_STATIC_POOL
+void can_list_get_pool_stats(can_list_pool_stats_t *stats);
+#endif /* CAN_LIST_USE_STATIC_POOL */
+
+#if CAN_LIST_USE_RTOS && CAN_LIST_USE_FRAME_RING
+void can_list_get_ring_stats(can_list_ring_stats_t *stats);
+#endif /* CAN_LIST_USE_RTOS && CAN_LIST_USE_FRAME_RING */
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,960 @@
+/**
+ * @file    can_list_test.c
+ * @brief   Host tests of can_list. The CAN FIFO and FreeRTOS are replaced by
+ *          the stubs in `test/stub`, the RTOS tasks are pthreads.
+ *
+ * Build and run in `Motor/can_list`:
+ *
+ *   gcc -std=gnu11 -g -O1 -fsanitize=address,undefined -pthread \
+ *       -Itest/stub -I.. -I../../Utils test/can_list_test.c can_list.c \
+ *       ../../Utils/mem_pool/mem_pool.c -o can_list_test
+ *   ./can_list_test
+ *
+ * The dispatch benchmark runs in the default mode, build it with `-O2` and
+ * without the sanitizers for meaningful numbers.
+ *
+ * Add to the command line to test the other modes:
+ *  - `-DCAN_LIST_USE_RTOS=1 -DCAN_LIST_USE_FRAME_RING=1`: the frame ring is
+ *    filled while the polling task is held in a callback, the frames over the
+ *    ring length must be dropped and counted, the others dispatched in order.
+ *    Then frames are dispatched by the polling task while the main thread adds
+ *    and deletes nodes. AddressSanitizer reports if an index or a node is
+ *    freed while the polling task still uses it.
+ *  - `-DCAN_LIST_USE_STATIC_POOL=1`: static pool mode, also tests the pool
+ *    usage statistics under node churn and the index memory of the worst node
+ *    layouts.
+ */
+
+#define _GNU_SOURCE
+
+#include "can_list/can_list.h"
+
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#if CAN_LIST_USE_RTOS
+#include "task.h"
+
+#if !CAN_LIST_USE_FRAME_RING
+#error "The RTOS tests need CAN_LIST_USE_FRAME_RING=1."
+#endif /* !CAN_LIST_USE_FRAME_RING */
+#endif /* CAN_LIST_USE_RTOS */
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+/*****************************************************************************
+ * @defgroup Stubs.
+ * @{
+ */
+
+static CAN_HandleTypeDef hcan1 = {.Instance = (void *)CAN1_BASE};
+/* A CAN which is not enabled in `CSP_Config.h`. */
+static CAN_HandleTypeDef hcan_unknown = {.Instance = (void *)0x40006800UL};
+
+/* Frames waiting in the CAN FIFO, only accessed by the "interrupt". */
+static struct {
+    CAN_RxHeaderTypeDef header;
+    uint8_t data[8];
+} fifo_frame[64];
+static uint32_t fifo_num, fifo_pos;
+
+uint32_t HAL_GetTick(void) {
+    return 0;
+}
+
+uint32_t HAL_CAN_GetRxFifoFillLevel(CAN_HandleTypeDef *hcan, uint32_t fifo) {
+    UNUSED(hcan);
+    UNUSED(fifo);
+    return fifo_num - fifo_pos;
+}
+
+HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef *hcan, uint32_t fifo,
+                                       CAN_RxHeaderTypeDef *header,
+                                       uint8_t *data) {
+    UNUSED(hcan);
+    UNUSED(fifo);
+
+    if (fifo_pos == fifo_num) {
+        return HAL_ERROR;
+    }
+
+    *header = fifo_frame[fifo_pos].header;
+    memcpy(data, fifo_frame[fifo_pos].data, 8);
+    ++fifo_pos;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef *hcan,
+                                               uint32_t it) {
+    UNUSED(hcan);
+    UNUSED(it);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_CAN_DeactivateNotification(CAN_HandleTypeDef *hcan,
+                                                 uint32_t it) {
+    UNUSED(hcan);
+    UNUSED(it);
+    return HAL_OK;
+}
+
+#if CAN_LIST_USE_RTOS
+
+static pthread_mutex_t stub_critical = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+void stub_critical_enter(void) {
+    pthread_mutex_lock(&stub_critical);
+}
+
+void stub_critical_exit(void) {
+    pthread_mutex_unlock(&stub_critical);
+}
+
+struct stub_task {
+    pthread_t thread;
+    TaskFunction_t code;
+    void *params;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t notify;
+};
+
+static __thread TaskHandle_t stub_current;
+/* The polling task, the only task created by can_list. */
+static TaskHandle_t stub_task;
+
+static void *stub_task_entry(void *arg) {
+    TaskHandle_t task = (TaskHandle_t)arg;
+    stub_current = task;
+    task->code(task->params);
+    return NULL;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char *name,
+                       uint32_t stack_depth, void *params,
+                       UBaseType_t priority, TaskHandle_t *handle) {
+    UNUSED(name);
+    UNUSED(stack_depth);
+    UNUSED(priority);
+
+    TaskHandle_t task = (TaskHandle_t)calloc(1, sizeof(struct stub_task));
+    task->code = code;
+    task->params = params;
+    pthread_mutex_init(&task->lock, NULL);
+    pthread_cond_init(&task->cond, NULL);
+    *handle = task;
+    stub_task = task;
+    pthread_create(&task->thread, NULL, stub_task_entry, task);
+    return pdPASS;
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return stub_current;
+}
+
+void vTaskDelay(TickType_t ticks) {
+    usleep(ticks * 50);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks) {
+    TaskHandle_t task = stub_current;
+    uint32_t value;
+
+    UNUSED(ticks);
+    pthread_mutex_lock(&task->lock);
+    while (task->notify == 0) {
+        pthread_cond_wait(&task->cond, &task->lock);
+    }
+    value = task->notify;
+    task->notify = clear ? 0 : value - 1;
+    pthread_mutex_unlock(&task->lock);
+    return value;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken) {
+    UNUSED(woken);
+    pthread_mutex_lock(&task->lock);
+    ++task->notify;
+    pthread_cond_signal(&task->cond);
+    pthread_mutex_unlock(&task->lock);
+}
+
+#endif /* CAN_LIST_USE_RTOS */
+
+/**
+ * @}
+ */
+
+/*****************************************************************************
+ * @defgroup Test nodes.
+ * @{
+ */
+
+typedef struct {
+    uint32_t id;
+    uint32_t mask;
+    uint32_t id_type;
+    volatile uint32_t live;
+    volatile uint32_t hits;
+} test_node_t;
+
+#define TEST_NODE_NUMBER 24
+
+static test_node_t test_node[TEST_NODE_NUMBER];
+static volatile uint32_t test_dispatched;
+static volatile uint32_t test_error;
+/* The node of the last callback, for single thread tests. */
+static test_node_t *test_last;
+
+static uint32_t test_rand_state = 1;
+
+static uint32_t test_rand(void) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return test_rand_state >> 8;
+}
+
+static void test_callback(void *node_obj, can_rx_header_t *can_rx_header,
+                          uint8_t *can_msg) {
+    test_node_t *node = (test_node_t *)node_obj;
+    UNUSED(can_msg);
+
+    /* A deleted node must not be called after `can_list_del_node_by_id`
+     * returned, and the received ID must match the node. */
+    if (!node->live || (can_rx_header->id & node->mask) != node->id ||
+        can_rx_header->id_type != node->id_type) {
+        ++test_error;
+    }
+
+    ++node->hits;
+    ++test_dispatched;
+    test_last = node;
+}
+
+/**
+ * @brief Assign the ID and mask of the test nodes: standard ID nodes with
+ *        full mask (lookup table), standard ID nodes with partial mask and
+ *        extended ID nodes with three masks.
+ */
+static void test_node_init(void) {
+    for (uint32_t i = 0; i < TEST_NODE_NUMBER; ++i) {
+        test_node_t *node = &test_node[i];
+        memset(node, 0, sizeof(test_node_t));
+
+        switch (i % 4) {
+            case 0:
+                node->id = 0x100 + i * 3;
+                node->mask = 0x7FF;
+                node->id_type = CAN_ID_STD;
+                break;
+            case 1:
+                node->id = 0x400 + (i << 4);
+                node->mask = 0x7F0;
+                node->id_type = CAN_ID_STD;
+                break;
+            case 2:
+                node->id = 0x10000000 + i;
+                node->mask = 0x1FFFFFFF;
+                node->id_type = CAN_ID_EXT;
+                break;
+            default:
+                node->id = 0x00200000 + (i << 8);
+                node->mask = (i & 4) ? 0x1FFFFF00 : 0x1FFFFFF0;
+                node->id &= node->mask;
+                node->id_type = CAN_ID_EXT;
+                break;
+        }
+    }
+}
+
+static uint8_t test_node_add(test_node_t *node) {
+    node->live = 1;
+    uint8_t res = can_list_add_new_node(can1_selected, node, node->id,
+                                        node->mask, node->id_type,
+                                        test_callback);
+    if (res != 0) {
+        node->live = 0;
+    }
+    return res;
+}
+
+static uint8_t test_node_del(test_node_t *node) {
+    uint8_t res = can_list_del_node_by_id(can1_selected, node->id_type,
+                                          node->id);
+    if (res == 0) {
+        node->live = 0;
+    }
+    return res;
+}
+
+/**
+ * @brief Pick a received ID, most of them hit a test node.
+ */
+static void test_pick_id(uint32_t *id, uint32_t *id_type) {
+    uint32_t r = test_rand();
+    test_node_t *node = &test_node[r % TEST_NODE_NUMBER];
+
+    *id_type = node->id_type;
+    if ((r >> 8) % 8 == 0) {
+        *id = test_rand() & ((node->id_type == CAN_ID_STD) ? 0x7FF : 0x1FFFFFFF);
+    } else {
+        *id = node->id | (test_rand() & ~node->mask &
+                          ((node->id_type == CAN_ID_STD) ? 0x7FF : 0x1FFFFFFF));
+    }
+}
+
+/**
+ * @brief Put frames into the FIFO of a CAN and raise the "interrupt".
+ */
+static void test_receive_can(CAN_HandleTypeDef *hcan, const uint32_t *id,
+                             const uint32_t *id_type, uint32_t num) {
+    CHECK(num <= sizeof(fifo_frame) / sizeof(fifo_frame[0]));
+    for (uint32_t i = 0; i < num; ++i) {
+        CAN_RxHeaderTypeDef *header = &fifo_frame[i].header;
+        memset(header, 0, sizeof(CAN_RxHeaderTypeDef));
+        header->IDE = id_type[i];
+        header->StdId = id[i];
+        header->ExtId = id[i];
+        header->DLC = 8;
+    }
+    fifo_pos = 0;
+    fifo_num = num;
+    HAL_CAN_RxFifo0MsgPendingCallback(hcan);
+}
+
+/**
+ * @brief Put frames into the FIFO of CAN1 and raise the "interrupt".
+ */
+static void test_receive(const uint32_t *id, const uint32_t *id_type,
+                         uint32_t num) {
+    test_receive_can(&hcan1, id, id_type, num);
+}
+
+#if !CAN_LIST_USE_RTOS
+
+/**
+ * @brief The nodes which should receive the ID.
+ */
+static uint32_t test_expected(uint32_t id, uint32_t id_type) {
+    uint32_t num = 0;
+
+    for (uint32_t i = 0; i < TEST_NODE_NUMBER; ++i) {
+        const test_node_t *node = &test_node[i];
+        if (node->live && node->id_type == id_type &&
+            (id & node->mask) == node->id) {
+            ++num;
+        }
+    }
+
+    return num;
+}
+
+#endif /* !CAN_LIST_USE_RTOS */
+
+/**
+ * @}
+ */
+
+#if !CAN_LIST_USE_RTOS
+
+/**
+ * @brief Nodes are added and deleted at random, every received ID must be
+ *        dispatched to a matched node, or not dispatched if none matches.
+ */
+static void test_dispatch(void) {
+    uint32_t id, id_type;
+
+    test_node_init();
+
+    for (uint32_t round = 0; round < 20000; ++round) {
+        if (round % 16 == 0) {
+            test_node_t *node = &test_node[test_rand() % TEST_NODE_NUMBER];
+            if (node->live) {
+                CHECK(test_node_del(node) == 0);
+            } else {
+                CHECK(test_node_add(node) == 0);
+            }
+        }
+
+        test_pick_id(&id, &id_type);
+        test_last = NULL;
+        test_receive(&id, &id_type, 1);
+
+        if (test_expected(id, id_type) == 0) {
+            CHECK(test_last == NULL);
+        } else {
+            CHECK(test_last != NULL);
+        }
+        CHECK(test_error == 0);
+    }
+
+    for (uint32_t i = 0; i < TEST_NODE_NUMBER; ++i) {
+        if (test_node[i].live) {
+            CHECK(test_node_del(&test_node[i]) == 0);
+        }
+    }
+
+#if CAN_LIST_USE_INDEX
+    can_list_index_stats_t stats;
+    can_list_get_index_stats(&stats);
+    CHECK(stats.failed == 0);
+    CHECK(stats.scanning == 0);
+    printf("dispatch: %u frames dispatched, %u index rebuilds\n",
+           test_dispatched, stats.rebuilt);
+#else  /* CAN_LIST_USE_INDEX */
+    printf("dispatch: %u frames dispatched\n", test_dispatched);
+#endif /* CAN_LIST_USE_INDEX */
+}
+
+#if CAN_LIST_USE_INDEX
+
+/**
+ * @brief A fifth ID mask on the extended table can not be indexed. The failure
+ *        is counted, the table is scanned until the mask is deleted.
+ */
+static void test_index_fallback(void) {
+    static const uint32_t mask[5] = {0x1FFFFFFF, 0x1FFFFFF0, 0x1FFFFF00,
+                                     0x1FFFF000, 0x1FFF0000};
+    static test_node_t node[5];
+    can_list_index_stats_t stats, before;
+    uint32_t id, id_type = CAN_ID_EXT;
+
+    can_list_get_index_stats(&before);
+
+    for (uint32_t i = 0; i < 5; ++i) {
+        node[i].mask = mask[i];
+        node[i].id = (0x01000000U * (i + 1)) & mask[i];
+        node[i].id_type = CAN_ID_EXT;
+        CHECK(test_node_add(&node[i]) == 0);
+    }
+
+    can_list_get_index_stats(&stats);
+    CHECK(stats.failed == before.failed + 1);
+    CHECK(stats.last_error == CAN_LIST_INDEX_ERR_GROUPS);
+    CHECK(stats.scanning == 1);
+
+    /* Still dispatched by scanning. */
+    for (uint32_t i = 0; i < 5; ++i) {
+        id = node[i].id | (~mask[i] & 0x1FFFFFFF & 0x5A5A5A5A);
+        test_last = NULL;
+        test_receive(&id, &id_type, 1);
+        CHECK(test_last == &node[i]);
+    }
+
+    CHECK(test_node_del(&node[4]) == 0);
+    can_list_get_index_stats(&stats);
+    CHECK(stats.scanning == 0);
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        CHECK(test_node_del(&node[i]) == 0);
+    }
+    CHECK(test_error == 0);
+    printf("index fallback: ok\n");
+}
+
+/* Frames dispatched for each benchmark. */
+#define BENCH_FRAMES 2000000
+
+#if CAN_LIST_USE_STATIC_POOL
+/* The 5 mask group nodes also come from the pool. */
+#define BENCH_MAX_NODES (CAN_LIST_POOL_NODE_NUMBER - 5)
+#else /* CAN_LIST_USE_STATIC_POOL */
+#define BENCH_MAX_NODES 64
+#endif /* CAN_LIST_USE_STATIC_POOL */
+
+static double test_now(void) {
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Time of dispatching frames to the full mask standard ID nodes.
+ *
+ * @param node The nodes which may be received.
+ * @param node_num Number of the nodes.
+ * @return Time per frame (ns), including the HAL stubs.
+ */
+static double test_bench_run(test_node_t *node, uint32_t node_num) {
+    static uint32_t id[1024];
+    uint32_t id_type = CAN_ID_STD;
+    uint32_t dispatched = test_dispatched;
+    double t;
+
+    for (uint32_t i = 0; i < 1024; ++i) {
+        id[i] = node[test_rand() % node_num].id;
+    }
+
+    t = test_now();
+    for (uint32_t i = 0; i < BENCH_FRAMES; ++i) {
+        test_receive(&id[i & 1023], &id_type, 1);
+    }
+    t = test_now() - t;
+
+    CHECK(test_dispatched - dispatched == BENCH_FRAMES);
+    return t * 1e9 / BENCH_FRAMES;
+}
+
+/**
+ * @brief Dispatch time of the index against scanning the table. The standard
+ *        ID table holds the full mask nodes and 4 mask groups, which can be
+ *        indexed. A 5th mask group makes the index fail, then the same table
+ *        (one node more) is scanned.
+ */
+static void test_bench_dispatch(void) {
+    static const uint32_t sizes[] = {4, 16, BENCH_MAX_NODES};
+    static const uint32_t mask[5] = {0x7F0, 0x7E0, 0x7C0, 0x780, 0x700};
+    static const uint32_t group_id[5] = {0x400, 0x440, 0x480, 0x500, 0x600};
+    static test_node_t node[BENCH_MAX_NODES];
+    static test_node_t group[5];
+    can_list_index_stats_t stats;
+    double t_index, t_scan;
+
+    for (uint32_t g = 0; g < 5; ++g) {
+        group[g].id = group_id[g];
+        group[g].mask = mask[g];
+        group[g].id_type = CAN_ID_STD;
+    }
+
+    for (uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        for (uint32_t i = 0; i < sizes[s]; ++i) {
+            node[i].id = 0x100 + i * 3;
+            node[i].mask = 0x7FF;
+            node[i].id_type = CAN_ID_STD;
+            CHECK(test_node_add(&node[i]) == 0);
+        }
+        for (uint32_t g = 0; g < 4; ++g) {
+            CHECK(test_node_add(&group[g]) == 0);
+        }
+
+        can_list_get_index_stats(&stats);
+        CHECK(stats.scanning == 0);
+        t_index = test_bench_run(node, sizes[s]);
+
+        CHECK(test_node_add(&group[4]) == 0);
+        can_list_get_index_stats(&stats);
+        CHECK(stats.scanning == 1);
+        t_scan = test_bench_run(node, sizes[s]);
+
+        for (uint32_t i = 0; i < sizes[s]; ++i) {
+            CHECK(test_node_del(&node[i]) == 0);
+        }
+        for (uint32_t g = 0; g < 5; ++g) {
+            CHECK(test_node_del(&group[g]) == 0);
+        }
+
+        printf("bench %2u nodes: index %6.1f ns/frame, scan %6.1f ns/frame\n",
+               sizes[s] + 4, t_index, t_scan);
+    }
+
+    CHECK(test_error == 0);
+}
+
+#endif /* CAN_LIST_USE_INDEX */
+
+#if CAN_LIST_USE_STATIC_POOL
+
+/**
+ * @brief Nodes are added and deleted at random, with more candidates than the
+ *        pool. The statistics must follow the nodes in use.
+ */
+static void test_pool_churn(void) {
+    static test_node_t node[CAN_LIST_POOL_NODE_NUMBER + 8];
+    const uint32_t node_num = sizeof(node) / sizeof(node[0]);
+    can_list_pool_stats_t stats;
+    uint32_t live = 0, peak = 0, failed = 0, id, id_type = CAN_ID_STD;
+
+    can_list_get_pool_stats(&stats);
+    CHECK(stats.node_total == CAN_LIST_POOL_NODE_NUMBER);
+    CHECK(stats.node_used == 0);
+    CHECK(stats.bucket_total == CAN_LIST_POOL_BUCKET_NUMBER);
+    CHECK(stats.bucket_used == 7 + 5);
+    peak = stats.node_peak;
+
+    /* Not enough buckets, the standard ID buckets are returned. */
+    CHECK(can_list_add_can(can2_selected, CAN_LIST_POOL_BUCKET_NUMBER, 1) == 3);
+    CHECK(can_list_add_can(can2_selected, 10, CAN_LIST_POOL_BUCKET_NUMBER) ==
+          3);
+    can_list_get_pool_stats(&stats);
+    CHECK(stats.bucket_used == 7 + 5);
+
+    for (uint32_t i = 0; i < node_num; ++i) {
+        node[i].id = 0x600 + i * 5;
+        node[i].mask = 0x7FF;
+        node[i].id_type = CAN_ID_STD;
+        node[i].live = 0;
+    }
+
+    for (uint32_t round = 0; round < 100000; ++round) {
+        test_node_t *n = &node[test_rand() % node_num];
+
+        /* Add twice as often as delete to keep the pool nearly full. */
+        if (n->live) {
+            if (test_rand() % 2 != 0) {
+                continue;
+            }
+            CHECK(test_node_del(n) == 0);
+            --live;
+        } else if (live == CAN_LIST_POOL_NODE_NUMBER) {
+            CHECK(test_node_add(n) == 5);
+            ++failed;
+        } else {
+            CHECK(test_node_add(n) == 0);
+            ++live;
+        }
+        peak = (live > peak) ? live : peak;
+
+        can_list_get_pool_stats(&stats);
+        CHECK(stats.node_used == live);
+        CHECK(stats.node_peak == peak);
+        CHECK(stats.node_failed == failed);
+
+        if (round % 8 == 0) {
+            n = &node[test_rand() % node_num];
+            id = n->id;
+            test_last = NULL;
+            test_receive(&id, &id_type, 1);
+            CHECK(test_last == (n->live ? n : NULL));
+        }
+    }
+
+    for (uint32_t i = 0; i < node_num; ++i) {
+        if (node[i].live) {
+            CHECK(test_node_del(&node[i]) == 0);
+        }
+    }
+    can_list_get_pool_stats(&stats);
+    CHECK(stats.node_used == 0);
+    CHECK(stats.node_peak == CAN_LIST_POOL_NODE_NUMBER);
+    CHECK(failed != 0);
+    CHECK(test_error == 0);
+    printf("pool churn: %u allocations failed as expected, peak %u/%u\n",
+           stats.node_failed, stats.node_peak, stats.node_total);
+}
+
+#if CAN_LIST_USE_INDEX
+
+/**
+ * @brief Fill one table with all the nodes of the pool in the layouts that
+ *        need the most index memory, the index must always be built.
+ */
+static void test_pool_index_worst_case(void) {
+    static test_node_t node[CAN_LIST_POOL_NODE_NUMBER];
+    static const uint32_t std_mask[4] = {0x7F8, 0x7F0, 0x7E0, 0x7C0};
+    static const uint32_t ext_mask[4] = {0x1FFFFFF8, 0x1FFFFFF0, 0x1FFFFFE0,
+                                         0x1FFFFFC0};
+    can_list_index_stats_t before, stats;
+
+    can_list_get_index_stats(&before);
+
+    for (uint32_t layout = 0; layout < 3; ++layout) {
+        for (uint32_t i = 0; i < CAN_LIST_POOL_NODE_NUMBER; ++i) {
+            /* Groups of 2^n + 1 nodes, whose slots are nearly 4 times. */
+            uint32_t g = (i < 27) ? i / 9 : 3;
+
+            if (layout == 0) {
+                /* Lookup table of the maximum span. */
+                node[i].id = (i == 0) ? 0 : (CAN_LIST_INDEX_MAX_STD_SPAN - i);
+                node[i].mask = 0x7FF;
+                node[i].id_type = CAN_ID_STD;
+            } else if (layout == 1) {
+                node[i].mask = std_mask[g];
+                node[i].id = (i << 6) & std_mask[g];
+                node[i].id_type = CAN_ID_STD;
+            } else {
+                node[i].mask = ext_mask[g];
+                node[i].id = (i << 6) & ext_mask[g];
+                node[i].id_type = CAN_ID_EXT;
+            }
+            CHECK(test_node_add(&node[i]) == 0);
+        }
+
+        can_list_get_index_stats(&stats);
+        CHECK(stats.failed == before.failed);
+        CHECK(stats.scanning == 0);
+
+        for (uint32_t i = 0; i < CAN_LIST_POOL_NODE_NUMBER; ++i) {
+            CHECK(test_node_del(&node[i]) == 0);
+        }
+    }
+
+    printf("pool index worst case: ok\n");
+}
+
+#endif /* CAN_LIST_USE_INDEX */
+
+#endif /* CAN_LIST_USE_STATIC_POOL */
+
+#else /* !CAN_LIST_USE_RTOS */
+
+#define TEST_CONCURRENT_SECONDS 3
+
+/* Set by the gate callback, then it waits for `test_gate_open`. */
+static volatile uint32_t test_gate_entered;
+static volatile uint32_t test_gate_open;
+/* IDs received by the ring test node, in dispatch order. */
+static uint32_t test_ring_id[CAN_LIST_RING_LENGTH * 4];
+static volatile uint32_t test_ring_num;
+
+/**
+ * @brief Hold the polling task inside the callback until the gate is opened.
+ */
+static void test_gate_callback(void *node_obj, can_rx_header_t *can_rx_header,
+                               uint8_t *can_msg) {
+    UNUSED(node_obj);
+    UNUSED(can_rx_header);
+    UNUSED(can_msg);
+
+    test_gate_entered = 1;
+    while (!test_gate_open) {
+        usleep(100);
+    }
+}
+
+static void test_ring_callback(void *node_obj, can_rx_header_t *can_rx_header,
+                               uint8_t *can_msg) {
+    UNUSED(node_obj);
+    UNUSED(can_msg);
+
+    if (test_ring_num < sizeof(test_ring_id) / sizeof(test_ring_id[0])) {
+        test_ring_id[test_ring_num] = can_rx_header->id;
+    }
+    ++test_ring_num;
+}
+
+/**
+ * @brief Wait until the polling task has dispatched `num` frames to the ring
+ *        test node.
+ */
+static void test_ring_wait(uint32_t num) {
+    for (uint32_t i = 0; i < 10000 && test_ring_num < num; ++i) {
+        usleep(100);
+    }
+    CHECK(test_ring_num == num);
+}
+
+/**
+ * @brief Overflow and wrap around of the frame ring. The polling task is held
+ *        by the gate callback while it still owns one slot, so one burst can
+ *        fill the ring. The FIFO must always be drained, the frames over the
+ *        ring length dropped and counted, the others dispatched in order.
+ */
+static void test_ring(void) {
+    const uint32_t burst = CAN_LIST_RING_LENGTH + 8;
+    uint32_t id[64], id_type[64];
+    can_list_ring_stats_t before, stats;
+
+    CHECK(burst <= 64);
+    CHECK(can_list_add_new_node(can1_selected, NULL, 0x7F0, 0x7FF, CAN_ID_STD,
+                                test_gate_callback) == 0);
+    CHECK(can_list_add_new_node(can1_selected, NULL, 0x600, 0x7C0, CAN_ID_STD,
+                                test_ring_callback) == 0);
+    can_list_get_ring_stats(&before);
+
+    for (uint32_t i = 0; i < 64; ++i) {
+        id[i] = 0x600 + i;
+        id_type[i] = CAN_ID_STD;
+    }
+
+    /* Hold the polling task on the first slot. */
+    id[0] = 0x7F0;
+    test_receive(id, id_type, 1);
+    for (uint32_t i = 0; i < 10000 && !test_gate_entered; ++i) {
+        usleep(100);
+    }
+    CHECK(test_gate_entered);
+
+    /* One burst: the free slots are filled, the rest dropped. */
+    for (uint32_t i = 0; i < burst; ++i) {
+        id[i] = 0x600 + i;
+    }
+    test_receive(id, id_type, burst);
+    CHECK(fifo_pos == fifo_num);
+
+    /* A CAN without table: drained, neither pushed nor counted. */
+    test_receive_can(&hcan_unknown, id, id_type, 8);
+    CHECK(fifo_pos == fifo_num);
+
+    can_list_get_ring_stats(&stats);
+    CHECK(stats.received - before.received == CAN_LIST_RING_LENGTH);
+    CHECK(stats.overrun - before.overrun == burst - (CAN_LIST_RING_LENGTH - 1));
+    CHECK(stats.high_watermark == CAN_LIST_RING_LENGTH);
+    CHECK(test_ring_num == 0);
+
+    test_gate_open = 1;
+    test_ring_wait(CAN_LIST_RING_LENGTH - 1);
+    for (uint32_t i = 0; i < CAN_LIST_RING_LENGTH - 1; ++i) {
+        CHECK(test_ring_id[i] == 0x600 + i);
+    }
+
+    /* Bursts within the free slots, across the end of the ring. */
+    test_ring_num = 0;
+    for (uint32_t b = 0; b < 3; ++b) {
+        for (uint32_t i = 0; i < 20; ++i) {
+            id[i] = 0x600 + b * 20 + i;
+        }
+        test_receive(id, id_type, 20);
+        test_ring_wait((b + 1) * 20);
+    }
+    for (uint32_t i = 0; i < 60; ++i) {
+        CHECK(test_ring_id[i] == 0x600 + i);
+    }
+
+    can_list_get_ring_stats(&stats);
+    CHECK(stats.overrun - before.overrun == burst - (CAN_LIST_RING_LENGTH - 1));
+    CHECK(stats.received - before.received == CAN_LIST_RING_LENGTH + 60);
+
+    CHECK(can_list_del_node_by_id(can1_selected, CAN_ID_STD, 0x7F0) == 0);
+    CHECK(can_list_del_node_by_id(can1_selected, CAN_ID_STD, 0x600) == 0);
+    printf("ring: %u of %u frames dropped while the task was held, "
+           "high watermark %u\n",
+           stats.overrun - before.overrun, burst, stats.high_watermark);
+}
+
+static volatile uint32_t test_stop;
+static volatile uint32_t test_received;
+
+/**
+ * @brief Hold the polling task for a while at any point, as if a higher
+ *        priority task or interrupt was running.
+ */
+static void test_preempt_handler(int sig) {
+    struct timespec start, now;
+    UNUSED(sig);
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &now);
+    } while ((now.tv_sec - start.tv_sec) * 1000000000L +
+                 (now.tv_nsec - start.tv_nsec) <
+             20000);
+}
+
+/**
+ * @brief The "CAN RX interrupt", keeps receiving frames and preempts the
+ *        polling task now and then.
+ */
+static void *test_isr_thread(void *arg) {
+    uint32_t id[3], id_type[3];
+    UNUSED(arg);
+
+    while (!test_stop) {
+        uint32_t num = 1 + test_rand() % 3;
+        for (uint32_t i = 0; i < num; ++i) {
+            test_pick_id(&id[i], &id_type[i]);
+        }
+        test_receive(id, id_type, num);
+        test_received += num;
+
+        if (test_rand() % 4 == 0) {
+            pthread_kill(stub_task->thread, SIGUSR1);
+            usleep(1);
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief The polling task dispatches while the main thread adds and deletes
+ *        nodes. A replaced index or a deleted node must not be used after
+ *        `can_list_add_new_node()` or `can_list_del_node_by_id()` returns.
+ */
+static void test_concurrent(void) {
+    static test_node_t extra[2] = {
+        {.id = 0x03000000, .mask = 0x1FFF0000, .id_type = CAN_ID_EXT},
+        {.id = 0x04000000, .mask = 0x1FF00000, .id_type = CAN_ID_EXT}};
+    pthread_t isr;
+    uint32_t changes = 0;
+    can_list_ring_stats_t before, ring;
+    can_list_index_stats_t stats;
+
+    test_node_init();
+    can_list_get_ring_stats(&before);
+    signal(SIGUSR1, test_preempt_handler);
+    pthread_create(&isr, NULL, test_isr_thread, NULL);
+
+    time_t end = time(NULL) + TEST_CONCURRENT_SECONDS;
+    while (time(NULL) < end) {
+        test_node_t *node = &test_node[rand() % TEST_NODE_NUMBER];
+        if (node->live) {
+            CHECK(test_node_del(node) == 0);
+        } else {
+            CHECK(test_node_add(node) == 0);
+        }
+
+        /* Two more masks on the extended table, it is scanned meanwhile. */
+        if (++changes % 1000 == 0) {
+            for (uint32_t i = 0; i < 2; ++i) {
+                if (extra[i].live) {
+                    CHECK(test_node_del(&extra[i]) == 0);
+                } else {
+                    CHECK(test_node_add(&extra[i]) == 0);
+                }
+            }
+        }
+
+        usleep(10);
+    }
+
+    test_stop = 1;
+    pthread_join(isr, NULL);
+
+    /* Wait for the ring to be drained. */
+    uint32_t dispatched;
+    do {
+        dispatched = test_dispatched;
+        usleep(100000);
+    } while (dispatched != test_dispatched);
+    can_list_get_ring_stats(&ring);
+    ring.received -= before.received;
+    ring.overrun -= before.overrun;
+
+    can_list_get_index_stats(&stats);
+    printf("concurrent: %u frames received, %u in ring, %u overrun, "
+           "%u dispatched, %u node changes, %u index rebuilds (%u failed)\n",
+           test_received, ring.received, ring.overrun, test_dispatched,
+           changes, stats.rebuilt, stats.failed);
+
+    CHECK(test_error == 0);
+    CHECK(ring.received + ring.overrun == test_received);
+    CHECK(test_dispatched > 0);
+    CHECK(stats.failed != 0);
+}
+
+#endif /* !CAN_LIST_USE_RTOS */
+
+int main(void) {
+    CHECK(can_list_add_can(can1_selected, 7, 5) == 0);
+
+#if CAN_LIST_USE_RTOS
+    test_ring();
+    test_concurrent();
+#else  /* CAN_LIST_USE_RTOS */
+    test_dispatch();
+#if CAN_LIST_USE_INDEX
+    test_index_fallback();
+    test_bench_dispatch();
+#endif /* CAN_LIST_USE_INDEX */
+#if CAN_LIST_USE_STATIC_POOL
+    test_pool_churn();
+#if CAN_LIST_USE_INDEX
+    test_pool_index_worst_case();
+#endif /* CAN_LIST_USE_INDEX */
+#endif /* CAN_LIST_USE_STATIC_POOL */
+#endif /* CAN_LIST_USE_RTOS */
+
+    printf("all passed\n");
+    return 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file    CSP_Config.h
+ * @brief   Host stand-in of the board support header for the can_list tests,
+ *          only what can_list uses. The CAN FIFO is implemented by the test.
+ */
+
+#ifndef __CSP_CONFIG_H
+#define __CSP_CONFIG_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define UNUSED(x) ((void)(x))
+#define __DMB()   __sync_synchronize()
+
+typedef enum {
+    HAL_OK = 0,
+    HAL_ERROR
+} HAL_StatusTypeDef;
+
+typedef enum {
+    can1_selected = 0U,
+    can2_selected,
+    can3_selected
+} can_selected_t;
+
+#define CAN1_ENABLE                 1
+#define CAN1_BASE                   0x40006400UL
+
+#define CAN_ID_STD                  0x00000000U
+#define CAN_ID_EXT                  0x00000004U
+#define CAN_RTR_DATA                0x00000000U
+#define CAN_RX_FIFO0                0x00000000U
+#define CAN_RX_FIFO1                0x00000001U
+#define CAN_IT_RX_FIFO0_MSG_PENDING 0x00000002U
+#define CAN_IT_RX_FIFO1_MSG_PENDING 0x00000010U
+
+typedef struct {
+    void *Instance;
+} CAN_HandleTypeDef;
+
+typedef struct {
+    uint32_t StdId;
+    uint32_t ExtId;
+    uint32_t IDE;
+    uint32_t RTR;
+    uint32_t DLC;
+    uint32_t Timestamp;
+    uint32_t FilterMatchIndex;
+} CAN_RxHeaderTypeDef;
+
+uint32_t HAL_GetTick(void);
+uint32_t HAL_CAN_GetRxFifoFillLevel(CAN_HandleTypeDef *hcan, uint32_t fifo);
+HAL_StatusTypeDef HAL_CAN_GetRxMessage(CAN_HandleTypeDef *hcan, uint32_t fifo,
+                                       CAN_RxHeaderTypeDef *header,
+                                       uint8_t *data);
+HAL_StatusTypeDef HAL_CAN_ActivateNotification(CAN_HandleTypeDef *hcan,
+                                               uint32_t it);
+HAL_StatusTypeDef HAL_CAN_DeactivateNotification(CAN_HandleTypeDef *hcan,
+                                                 uint32_t it);
+
+void HAL_CAN_RxFifo0MsgPendingCallback(CAN_HandleTypeDef *hcan);
+void HAL_CAN_RxFifo1MsgPendingCallback(CAN_HandleTypeDef *hcan);
+
+#endif /* __CSP_CONFIG_H */
@@ -0,0 +1,33 @@
+/**
+ * @file    FreeRTOS.h
+ * @brief   Host stand-in of FreeRTOS for the can_list tests. Tasks are
+ *          pthreads, critical sections are one recursive mutex.
+ */
+
+#ifndef __FREERTOS_STUB_H
+#define __FREERTOS_STUB_H
+
+#include <stdint.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef struct stub_task *TaskHandle_t;
+typedef struct stub_queue *QueueHandle_t;
+
+#define pdFALSE       0
+#define pdTRUE        1
+#define pdPASS        1
+#define portMAX_DELAY 0xFFFFFFFFU
+
+#define portYIELD_FROM_ISR(x) ((void)(x))
+
+void stub_critical_enter(void);
+void stub_critical_exit(void);
+
+#define taskENTER_CRITICAL()          stub_critical_enter()
+#define taskEXIT_CRITICAL()           stub_critical_exit()
+#define taskENTER_CRITICAL_FROM_ISR() (stub_critical_enter(), 0)
+#define taskEXIT_CRITICAL_FROM_ISR(x) ((void)(x), stub_critical_exit())
+
+#endif /* __FREERTOS_STUB_H */
@@ -0,0 +1,11 @@
+/**
+ * @file    semphr.h
+ * @brief   Host stand-in of FreeRTOS semaphores for the can_list tests.
+ */
+
+#ifndef __SEMPHR_STUB_H
+#define __SEMPHR_STUB_H
+
+#include "FreeRTOS.h"
+
+#endif /* __SEMPHR_STUB_H */
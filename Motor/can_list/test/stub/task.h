@@ -0,0 +1,21 @@
+/**
+ * @file    task.h
+ * @brief   Host stand-in of FreeRTOS tasks for the can_list tests.
+ */
+
+#ifndef __TASK_STUB_H
+#define __TASK_STUB_H
+
+#include "FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void *);
+
+BaseType_t xTaskCreate(TaskFunction_t code, const char *name,
+                       uint32_t stack_depth, void *params,
+                       UBaseType_t priority, TaskHandle_t *handle);
+TaskHandle_t xTaskGetCurrentTaskHandle(void);
+void vTaskDelay(TickType_t ticks);
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks);
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t *woken);
+
+#endif /* __TASK_STUB_H */
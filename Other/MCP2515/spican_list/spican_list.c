@@ -7,7 +7,13 @@
  */
 
 #include "spican_list/spican_list.h"
+
+#if SPICAN_LIST_USE_STATIC_POOL
+#include "mem_pool/mem_pool.h"
+#endif /* SPICAN_LIST_USE_STATIC_POOL */
+
 #include <stdlib.h>
+#include <string.h>
 
 #define STD_ID_TABLE 0
 #define EXT_ID_TABLE 1
@@ -89,6 +95,142 @@ typedef struct {
 /* The CAN instance, each CAN has an independent table. */
 spican_table_t *spican_table[SPICAN_LIST_MAX_CAN_NUMBER];
 
+#if SPICAN_LIST_USE_STATIC_POOL
+
+static spican_table_t spican_table_pool[SPICAN_LIST_MAX_CAN_NUMBER];
+static spican_node_t *spican_bucket_pool[SPICAN_LIST_POOL_BUCKET_NUMBER];
+static spican_node_t spican_node_pool[SPICAN_LIST_POOL_NODE_NUMBER];
+
+static mem_stack_t spican_bucket_stack = MEM_STACK_INIT(spican_bucket_pool);
+static mem_pool_t spican_node_mem_pool = MEM_POOL_INIT(spican_node_pool);
+
+#endif /* SPICAN_LIST_USE_STATIC_POOL */
+
+/**
+ * @}
+ */
+
+/*****************************************************************************
+ * @defgroup Memory management.
+ * @{
+ */
+
+/**
+ * @brief Allocate a CAN table.
+ *
+ * @param spican_select Specific which CAN the table belongs to.
+ * @return The table, `NULL` if failed.
+ */
+static spican_table_t *spican_list_table_alloc(spican_selected_t spican_select) {
+#if SPICAN_LIST_USE_STATIC_POOL
+    memset(&spican_table_pool[spican_select], 0, sizeof(spican_table_t));
+    return &spican_table_pool[spican_select];
+#else  /* SPICAN_LIST_USE_STATIC_POOL */
+    UNUSED(spican_select);
+    return (spican_table_t *)SPICAN_LIST_MALLOC(sizeof(spican_table_t));
+#endif /* SPICAN_LIST_USE_STATIC_POOL */
+}
+
+/**
+ * @brief Free a CAN table.
+ *
+ * @param table The table to free.
+ */
+static void spican_list_table_free(spican_table_t *table) {
+#if SPICAN_LIST_USE_STATIC_POOL
+    UNUSED(table);
+#else  /* SPICAN_LIST_USE_STATIC_POOL */
+    SPICAN_LIST_FREE(table);
+#endif /* SPICAN_LIST_USE_STATIC_POOL */
+}
+
+/**
+ * @brief Allocate zeroed hash buckets.
+ *
+ * @param len Bucket number.
+ * @return The buckets, `NULL` if failed.
+ */
+static spican_node_t **spican_list_bucket_alloc(uint32_t len) {
+#if SPICAN_LIST_USE_STATIC_POOL
+    if (len > SPICAN_LIST_POOL_BUCKET_NUMBER) {
+        return NULL;
+    }
+
+    spican_node_t **bucket = (spican_node_t **)mem_stack_alloc(
+        &spican_bucket_stack, len * sizeof(spican_node_t *));
+    if (bucket != NULL) {
+        memset(bucket, 0, len * sizeof(spican_node_t *));
+    }
+    return bucket;
+#else  /* SPICAN_LIST_USE_STATIC_POOL */
+    return (spican_node_t **)SPICAN_LIST_CALLOC(len, sizeof(spican_node_t *));
+#endif /* SPICAN_LIST_USE_STATIC_POOL */
+}
+
+/**
+ * @brief Free hash buckets.
+ *
+ * @param bucket The buckets to free.
+ * @param len Bucket number.
+ * @note The bucket pool is a stack, only the last allocation can be returned.
+ */
+static void spican_list_bucket_free(spican_node_t **bucket, uint32_t len) {
+#if SPICAN_LIST_USE_STATIC_POOL
+    mem_stack_free(&spican_bucket_stack, bucket, len * sizeof(spican_node_t *));
+#else  /* SPICAN_LIST_USE_STATIC_POOL */
+    UNUSED(len);
+    SPICAN_LIST_FREE(bucket);
+#endif /* SPICAN_LIST_USE_STATIC_POOL */
+}
+
+/**
+ * @brief Allocate a node.
+ *
+ * @return The node, `NULL` if failed.
+ */
+static spican_node_t *spican_list_node_alloc(void) {
+#if SPICAN_LIST_USE_STATIC_POOL
+    return (spican_node_t *)mem_pool_alloc(&spican_node_mem_pool);
+#else  /* SPICAN_LIST_USE_STATIC_POOL */
+    return (spican_node_t *)SPICAN_LIST_MALLOC(sizeof(spican_node_t));
+#endif /* SPICAN_LIST_USE_STATIC_POOL */
+}
+
+/**
+ * @brief Free a node.
+ *
+ * @param node The node to free.
+ */
+static void spican_list_node_free(spican_node_t *node) {
+#if SPICAN_LIST_USE_STATIC_POOL
+    mem_pool_free(&spican_node_mem_pool, node);
+#else  /* SPICAN_LIST_USE_STATIC_POOL */
+    SPICAN_LIST_FREE(node);
+#endif /* SPICAN_LIST_USE_STATIC_POOL */
+}
+
+#if SPICAN_LIST_USE_STATIC_POOL
+
+/**
+ * @brief Get the usage of the static pool.
+ *
+ * @param[out] stats The pool usage.
+ */
+void spican_list_get_pool_stats(spican_list_pool_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+
+    stats->node_total = spican_node_mem_pool.total;
+    stats->node_used = spican_node_mem_pool.used;
+    stats->node_peak = spican_node_mem_pool.peak;
+    stats->node_failed = spican_node_mem_pool.failed;
+    stats->bucket_total = SPICAN_LIST_POOL_BUCKET_NUMBER;
+    stats->bucket_used = spican_bucket_stack.used / sizeof(spican_node_t *);
+}
+
+#endif /* SPICAN_LIST_USE_STATIC_POOL */
+
 /**
  * @}
  */
@@ -138,29 +280,28 @@ uint8_t spican_list_add_can(spican_selected_t spican_select, uint32_t std_len,
         return 2;
     }
 
-    spican_table[spican_select] = (spican_table_t *)SPICAN_LIST_MALLOC(sizeof(spican_table_t));
-    if (spican_table[spican_select] == NULL) {
+    spican_table_t *new_table = spican_list_table_alloc(spican_select);
+    if (new_table == NULL) {
         return 3;
     }
 
-    spican_table[spican_select]->id_table[STD_ID_TABLE].table =
-        (spican_node_t **)SPICAN_LIST_CALLOC(std_len, sizeof(spican_node_t *));
-    if (spican_table[spican_select]->id_table[STD_ID_TABLE].table == NULL) {
-        SPICAN_LIST_FREE(spican_table[spican_select]);
-        spican_table[spican_select] = NULL;
+    new_table->id_table[STD_ID_TABLE].table = spican_list_bucket_alloc(std_len);
+    if (new_table->id_table[STD_ID_TABLE].table == NULL) {
+        spican_list_table_free(new_table);
         return 3;
     }
-    spican_table[spican_select]->id_table[STD_ID_TABLE].len = std_len;
-
-    spican_table[spican_select]->id_table[EXT_ID_TABLE].table =
-        (spican_node_t **)SPICAN_LIST_CALLOC(ext_len, sizeof(spican_node_t *));
-    if (spican_table[spican_select]->id_table[EXT_ID_TABLE].table == NULL) {
-        SPICAN_LIST_FREE(spican_table[spican_select]->id_table[STD_ID_TABLE].table);
-        SPICAN_LIST_FREE(spican_table[spican_select]);
-        spican_table[spican_select] = NULL;
+    new_table->id_table[STD_ID_TABLE].len = std_len;
+
+    new_table->id_table[EXT_ID_TABLE].table = spican_list_bucket_alloc(ext_len);
+    if (new_table->id_table[EXT_ID_TABLE].table == NULL) {
+        spican_list_bucket_free(new_table->id_table[STD_ID_TABLE].table,
+                                std_len);
+        spican_list_table_free(new_table);
         return 3;
     }
-    spican_table[spican_select]->id_table[EXT_ID_TABLE].len = ext_len;
+    new_table->id_table[EXT_ID_TABLE].len = ext_len;
+
+    spican_table[spican_select] = new_table;
 
 #if SPICAN_LIST_USE_RTOS
     if (spican_list_queue_handle == NULL) {
@@ -224,7 +365,7 @@ uint8_t spican_list_add_new_node(spican_selected_t spican_select, void *node_dat
         return 4;
     }
 
-    spican_node_t *new_node = (spican_node_t *)SPICAN_LIST_MALLOC(sizeof(spican_node_t));
+    spican_node_t *new_node = spican_list_node_alloc();
     if (new_node == NULL) {
         return 5;
     }
@@ -296,7 +437,7 @@ uint8_t spican_list_del_node_by_id(spican_selected_t spican_select, uint32_t id_
 
     previous_node->next = current_node->next;
 
-    SPICAN_LIST_FREE(current_node);
+    spican_list_node_free(current_node);
 
     return 0;
 }
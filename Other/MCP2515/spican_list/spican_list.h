@@ -26,6 +26,20 @@ extern "C" {
 #define SPICAN_LIST_CALLOC(x, p)   calloc(x, p)
 #define SPICAN_LIST_FREE(p)        free(p)
 
+/**
+ * When enabled, the tables and nodes are allocated from compile-time sized
+ * static pools instead of `SPICAN_LIST_MALLOC`. Node allocation and free are
+ * O(1) through a free list (`Utils/mem_pool`).
+ */
+#define SPICAN_LIST_USE_STATIC_POOL 0
+
+#if SPICAN_LIST_USE_STATIC_POOL
+/* Total node number of all CANs. */
+#define SPICAN_LIST_POOL_NODE_NUMBER   32
+/* Total hash bucket number of all CANs (sum of `std_len` and `ext_len`). */
+#define SPICAN_LIST_POOL_BUCKET_NUMBER 32
+#endif /* SPICAN_LIST_USE_STATIC_POOL */
+
 /**
  * When disabled, the message is processed in the interrupt.
  *
@@ -56,6 +70,20 @@ typedef struct {
     uint8_t data_length; /*!< Message Data length.                            */
 } spican_rx_header_t;
 
+#if SPICAN_LIST_USE_STATIC_POOL
+/**
+ * @brief Usage of the static pool.
+ */
+typedef struct {
+    uint32_t node_total;   /*!< Node number of the pool.                 */
+    uint32_t node_used;    /*!< Nodes in use.                            */
+    uint32_t node_peak;    /*!< The most nodes in use at the same time.  */
+    uint32_t node_failed;  /*!< Allocations failed since pool exhausted. */
+    uint32_t bucket_total; /*!< Bucket number of the pool.               */
+    uint32_t bucket_used;  /*!< Buckets in use.                          */
+} spican_list_pool_stats_t;
+#endif /* SPICAN_LIST_USE_STATIC_POOL */
+
 typedef enum {
     spican1_selected = 0U, /*!< Select CAN1 */
     spican2_selected,      /*!< Select CAN2 */
@@ -83,6 +111,9 @@ uint8_t spican_list_del_node_by_id(spican_selected_t spican_select, uint32_t id_
                                 uint32_t id);
 uint8_t spican_list_change_callback(spican_selected_t spican_select, uint32_t id_type,
                                  uint32_t id, spican_callback_t new_callback); 
+#if SPICAN_LIST_USE_STATIC_POOL
+void spican_list_get_pool_stats(spican_list_pool_stats_t *stats);
+#endif /* SPICAN_LIST_USE_STATIC_POOL */
 void mcp2515_process_msg(MCP2515_DevId_t dev_id);                       
 #ifdef __cplusplus
 }
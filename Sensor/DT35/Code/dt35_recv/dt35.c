@@ -7,79 +7,268 @@
  */
 
 #include "dt35.h"
-#include "stdlib.h"
 
 /* 两个DT35的数据 */
 /* [0]为x方向 [1]为y方向 */
 dt35_data_t g_dt35_data[2];
 
+/* 10 的整数次幂, 用于把定点数转换为小数 (均可以被 float 精确表示) */
+static const float dt35_pow10[DT35_MAX_DIGITS + 1] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f};
+
+/**
+ * @brief 更新DT35数据
+ *
+ * @param dt35_ptr DT35数据
+ * @param timestamp 收到该帧的时刻
+ */
+static void dt35_publish(dt35_data_t *dt35_ptr, uint32_t timestamp) {
+    float raw = (float)dt35_ptr->mantissa /
+                dt35_pow10[(dt35_ptr->frac < 0) ? 0 : dt35_ptr->frac];
+
+    if (dt35_ptr->recv_sta & 0x01) {
+        raw = -raw;
+    }
+
+    dt35_ptr->seq++;
+    __DMB();
+    dt35_ptr->dt35_raw = raw;
+    dt35_ptr->distance =
+        (dt35_ptr->Q2_far - dt35_ptr->Q2_near) * (raw - 4) / 16 +
+        dt35_ptr->Q2_near;
+    dt35_ptr->timestamp = timestamp;
+    __DMB();
+    dt35_ptr->seq++;
+}
+
+/**
+ * @brief 解析一个字节
+ *
+ * @param dt35_ptr DT35数据
+ * @param ch 接收到的字节
+ * @param timestamp 收到该字节的时刻
+ * @note 帧格式为 's' + 十进制小数 + 'e', 数字逐位累加为定点数,
+ *       数字过多或出现其他字符时丢弃这一帧.
+ */
+static void dt35_parse_byte(dt35_data_t *dt35_ptr, uint8_t ch,
+                            uint32_t timestamp) {
+    switch (ch) {
+        case 's': {
+            dt35_ptr->recv_sta = 0x80;
+            dt35_ptr->mantissa = 0;
+            dt35_ptr->digits = 0;
+            dt35_ptr->frac = -1;
+        } break;
+
+        case 'e': {
+            /* 数据结束标识符，将定点数转换成小数 */
+            if (dt35_ptr->recv_sta & 0x80) {
+                if (dt35_ptr->digits > 0) {
+                    dt35_publish(dt35_ptr, timestamp);
+                } else {
+                    dt35_ptr->err_cnt++;
+                }
+            }
+            dt35_ptr->recv_sta = 0;
+        } break;
+
+        default: {
+            if ((dt35_ptr->recv_sta & 0x80) == 0) {
+                break;
+            }
+
+            if (ch >= '0' && ch <= '9' && dt35_ptr->digits < DT35_MAX_DIGITS) {
+                dt35_ptr->mantissa = dt35_ptr->mantissa * 10 + (ch - '0');
+                dt35_ptr->digits++;
+                if (dt35_ptr->frac >= 0) {
+                    dt35_ptr->frac++;
+                }
+            } else if (ch == '.' && dt35_ptr->frac < 0) {
+                dt35_ptr->frac = 0;
+            } else if (ch == '-' && dt35_ptr->digits == 0 &&
+                       dt35_ptr->frac < 0 &&
+                       (dt35_ptr->recv_sta & 0x01) == 0) {
+                dt35_ptr->recv_sta |= 0x01;
+            } else {
+                /* 格式错误, 丢弃这一帧 */
+                dt35_ptr->err_cnt++;
+                dt35_ptr->recv_sta = 0;
+            }
+        } break;
+    }
+}
+
 /**
  * @brief DT35串口接收回调
  *
  * @param huart 串口句柄
+ * @param Size 使用 DMA 时为 DMA 在缓冲区中的写入位置, 否则为接收长度
  */
 void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size) {
 
     dt35_data_t *dt35_ptr;
 
-    if (huart->Instance == g_dt35_data[0].uart_handle->Instance) {
+    if (g_dt35_data[0].uart_handle != NULL &&
+        huart->Instance == g_dt35_data[0].uart_handle->Instance) {
         /* 第一个DT35数据 */
         dt35_ptr = &g_dt35_data[0];
-    } else if (huart->Instance == g_dt35_data[1].uart_handle->Instance) {
+    } else if (g_dt35_data[1].uart_handle != NULL &&
+               huart->Instance == g_dt35_data[1].uart_handle->Instance) {
         /* 第2个DT35数据 */
         dt35_ptr = &g_dt35_data[1];
     } else {
         return;
     }
+
+#if DT35_USE_DMA_RECV
+    /* 只记录位置和时间, 在 dt35_process 中解析 */
+    dt35_ptr->event_seq++;
+    __DMB();
+    dt35_ptr->event_tick = DT35_GET_TIMESTAMP();
+    dt35_ptr->write_pos = (Size >= DT35_DMA_BUF_SIZE) ? 0 : Size;
+    __DMB();
+    dt35_ptr->event_seq++;
+#else  /* DT35_USE_DMA_RECV */
+    uint32_t timestamp = DT35_GET_TIMESTAMP();
     for (uint8_t i = 0; i < Size; i++) {
-        switch (dt35_ptr->recv_it_buf[i]) {
-            case 'e': {
-                /* 数据结束标识符，将缓存区中的字符串转换成数字 */
-                dt35_ptr->dt35_raw =
-                    (float32_t)atof((const char *)dt35_ptr->recv_buf);
-                dt35_ptr->distance = (dt35_ptr->Q2_far - dt35_ptr->Q2_near) *
-                                         (dt35_ptr->dt35_raw - 4) / 16 +
-                                     dt35_ptr->Q2_near;
-                dt35_ptr->recv_sta = 0;
-                memset(dt35_ptr->recv_buf, 0, Size);
-            } break;
-
-            case 's': {
-                dt35_ptr->recv_sta |= 0x80;
-            } break;
-
-            default: {
-                if (dt35_ptr->recv_sta != 0) {
-                    dt35_ptr->recv_buf[dt35_ptr->recv_sta & 0x7f] =
-                        dt35_ptr->recv_it_buf[i];
-                    ++dt35_ptr->recv_sta;
-                }
-            } break;
-        }
+        dt35_parse_byte(dt35_ptr, dt35_ptr->recv_it_buf[i], timestamp);
     }
 
     HAL_UARTEx_ReceiveToIdle_IT(huart, dt35_ptr->recv_it_buf, 14);
+#endif /* DT35_USE_DMA_RECV */
 }
 
+#if DT35_USE_DMA_RECV
+
 /**
- * @brief DT35注册串口
+ * @brief 解析 DMA 缓冲区中新收到的数据
  *
- * @param huart_1 第一个DT35串口
- * @param huart_2 第二个DT35串口
+ * @note 在任务或主循环中调用, 两次调用之间收到的数据不能超过
+ *       `DT35_DMA_BUF_SIZE`, 否则会被 DMA 覆盖.
+ */
+void dt35_process(void) {
+    dt35_data_t *dt35_ptr;
+    uint16_t pos, head;
+    uint32_t seq, timestamp;
+
+    for (uint8_t i = 0; i < 2; i++) {
+        dt35_ptr = &g_dt35_data[i];
+        if (dt35_ptr->uart_handle == NULL) {
+            continue;
+        }
+
+        /* 读取期间接收中断到来时重新读取, 保证位置和时间属于同一次事件 */
+        do {
+            seq = dt35_ptr->event_seq;
+            __DMB();
+            head = dt35_ptr->write_pos;
+            timestamp = dt35_ptr->event_tick;
+            __DMB();
+        } while ((seq & 1) || seq != dt35_ptr->event_seq);
+
+        for (pos = dt35_ptr->read_pos; pos != head;) {
+            dt35_parse_byte(dt35_ptr, dt35_ptr->dma_buf[pos], timestamp);
+            if (++pos >= DT35_DMA_BUF_SIZE) {
+                pos = 0;
+            }
+        }
+        dt35_ptr->read_pos = pos;
+    }
+}
+
+#endif /* DT35_USE_DMA_RECV */
+
+/**
+ * @brief 读取DT35距离
+ *
+ * @param index 0: 第一个DT35; 1: 第二个DT35
+ * @param[out] distance 距离
+ * @param[out] timestamp 收到该数据的时刻, 可以为 NULL
+ * @return 收到的帧数, 0 表示还没有收到数据
+ * @note 读取期间数据被更新时重新读取, 保证距离和时间属于同一帧.
  */
-void dt35_register_uart(UART_HandleTypeDef *huart_1,
-                        UART_HandleTypeDef *huart_2) {
-    g_dt35_data[0].uart_handle = huart_1;
-    g_dt35_data[0].Q2_near = 140; /* 需要自行标定 */
-    g_dt35_data[0].Q2_far = 2050; /* 需要自行标定 */
+uint32_t dt35_read(uint8_t index, float *distance, uint32_t *timestamp) {
+    dt35_data_t *dt35_ptr;
+    uint32_t seq, tick;
+    float value;
 
-    HAL_UARTEx_ReceiveToIdle_IT(g_dt35_data[0].uart_handle,
-                                g_dt35_data[0].recv_it_buf, 14);
+    if (index >= 2 || distance == NULL) {
+        return 0;
+    }
+
+    dt35_ptr = &g_dt35_data[index];
+    do {
+        seq = dt35_ptr->seq;
+        __DMB();
+        value = dt35_ptr->distance;
+        tick = dt35_ptr->timestamp;
+        __DMB();
+    } while ((seq & 1) || seq != dt35_ptr->seq);
+
+    *distance = value;
+    if (timestamp != NULL) {
+        *timestamp = tick;
+    }
 
-    g_dt35_data[1].uart_handle = huart_1;
-    g_dt35_data[1].Q2_near = 140; /* 需要自行标定 */
-    g_dt35_data[1].Q2_far = 2050; /* 需要自行标定 */
+    return seq >> 1;
+}
+
+/**
+ * @brief 开始接收一个DT35的数据
+ *
+ * @param dt35_ptr DT35数据
+ * @param huart 串口句柄, 为 NULL 时不接收
+ * @return 0: 成功; 1: 失败
+ */
+static uint8_t dt35_start(dt35_data_t *dt35_ptr, UART_HandleTypeDef *huart) {
+    dt35_ptr->uart_handle = NULL;
+    if (huart == NULL) {
+        return 0;
+    }
+
+#if DT35_USE_DMA_RECV
+    if (huart->hdmarx == NULL || huart->hdmarx->Init.Mode != DMA_CIRCULAR) {
+        return 1;
+    }
+#endif /* DT35_USE_DMA_RECV */
+
+    dt35_ptr->uart_handle = huart;
+    dt35_ptr->Q2_near = 140; /* 需要自行标定 */
+    dt35_ptr->Q2_far = 2050; /* 需要自行标定 */
+    dt35_ptr->recv_sta = 0;
+
+#if DT35_USE_DMA_RECV
+    dt35_ptr->read_pos = 0;
+    dt35_ptr->write_pos = 0;
+    if (HAL_UARTEx_ReceiveToIdle_DMA(huart, dt35_ptr->dma_buf,
+                                     DT35_DMA_BUF_SIZE) != HAL_OK) {
+        dt35_ptr->uart_handle = NULL;
+        return 1;
+    }
+#else  /* DT35_USE_DMA_RECV */
+    if (HAL_UARTEx_ReceiveToIdle_IT(huart, dt35_ptr->recv_it_buf, 14) !=
+        HAL_OK) {
+        dt35_ptr->uart_handle = NULL;
+        return 1;
+    }
+#endif /* DT35_USE_DMA_RECV */
+
+    return 0;
+}
+
+/**
+ * @brief DT35注册串口
+ *
+ * @param huart_1 第一个DT35串口
+ * @param huart_2 第二个DT35串口, 只用一个DT35时可以为 NULL
+ * @return 0: 成功; 1: 有串口无法开始接收 (使用 DMA 接收时没有配置循环模式的
+ *         接收 DMA, 或者串口正忙), 该 DT35 不会更新
+ */
+uint8_t dt35_register_uart(UART_HandleTypeDef *huart_1,
+                           UART_HandleTypeDef *huart_2) {
+    uint8_t res = 0;
 
-    HAL_UARTEx_ReceiveToIdle_IT(g_dt35_data[1].uart_handle,
-                                g_dt35_data[1].recv_it_buf, 14);
+    res |= dt35_start(&g_dt35_data[0], huart_1);
+    res |= dt35_start(&g_dt35_data[1], huart_2);
+    return res;
 }
@@ -11,17 +11,49 @@
 
 #include "bsp.h"
 
+/* 是否使用 DMA 环形缓冲区 + 空闲中断接收, 默认关闭, 与原来一样在中断中解析.
+   打开时:
+   - 串口需要配置循环模式的接收 DMA, 否则 `dt35_register_uart` 返回失败
+   - 中断中只记录接收位置, 解析在 `dt35_process` 中进行, 调用者需要在任务或
+     主循环中周期调用 `dt35_process`, 否则数据不会更新 */
+#ifndef DT35_USE_DMA_RECV
+#define DT35_USE_DMA_RECV 0
+#endif /* DT35_USE_DMA_RECV */
+/* 每个 DT35 的 DMA 环形缓冲区大小 (byte) */
+#define DT35_DMA_BUF_SIZE 128
+/* 一帧数据中最多的数字个数 */
+#define DT35_MAX_DIGITS   9
+
+/* 接收时间戳, 默认为 ms, 可以换成更高精度的计时器 */
+#define DT35_GET_TIMESTAMP() HAL_GetTick()
+
 /**
  * @brief DT35数据
  */
 typedef struct {
-    float dt35_raw; /*!< DT35原始数据，Q_2的电流值4mA~20mA */
-    float distance; /*!< DT35计算后得到的距离值 */
+    float dt35_raw;        /*!< DT35原始数据，Q_2的电流值4mA~20mA */
+    float distance;        /*!< DT35计算后得到的距离值 */
+    uint32_t timestamp;    /*!< 收到该数据的时刻 */
+    volatile uint32_t seq; /*!< 更新序号, 奇数表示正在更新 */
 
     UART_HandleTypeDef *uart_handle; /*!< 串口接收句柄 */
-    uint8_t recv_it_buf[14];         /*!< 串口中断接收buf */
-    uint8_t recv_buf[12];            /*!< 串口数据缓冲区  */
-    uint16_t recv_sta;               /*!< 标志位, bit7置1开始接收 */
+#if DT35_USE_DMA_RECV
+    uint8_t dma_buf[DT35_DMA_BUF_SIZE]; /*!< DMA 环形缓冲区 */
+    volatile uint16_t write_pos;        /*!< DMA 写入位置, 中断中更新 */
+    volatile uint32_t event_tick;       /*!< 最近一次接收事件的时刻 */
+    volatile uint32_t event_seq; /*!< 接收事件序号, 奇数表示中断正在更新 */
+    uint16_t read_pos;                  /*!< 解析位置 */
+#else  /* DT35_USE_DMA_RECV */
+    uint8_t recv_it_buf[14]; /*!< 串口中断接收buf */
+#endif /* DT35_USE_DMA_RECV */
+
+    /* 解析状态 */
+    int32_t mantissa; /*!< 已解析的数字 (不含小数点) */
+    uint8_t digits;   /*!< 已解析的数字个数 */
+    int8_t frac;      /*!< 小数位数, -1 表示还没有小数点 */
+    uint8_t recv_sta; /*!< 标志位, bit7置1开始接收, bit0 负数 */
+    uint32_t err_cnt; /*!< 格式错误的帧数 */
+
     float Q2_near; /*!< Q2设置的近点距离，范围30~Q2_far，单位mm*/
     float Q2_far;  /*!< Q2设置的远点距离，范围Q2_near~10000，单位mm*/
 
@@ -29,7 +61,12 @@ typedef struct {
 
 extern dt35_data_t g_dt35_data[2];
 
-void dt35_register_uart(UART_HandleTypeDef *huart_1,
-                        UART_HandleTypeDef *huart_2);
+uint8_t dt35_register_uart(UART_HandleTypeDef *huart_1,
+                           UART_HandleTypeDef *huart_2);
+uint32_t dt35_read(uint8_t index, float *distance, uint32_t *timestamp);
+
+#if DT35_USE_DMA_RECV
+void dt35_process(void);
+#endif /* DT35_USE_DMA_RECV */
 
 #endif /* __DT35_H */
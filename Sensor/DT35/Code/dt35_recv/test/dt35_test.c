@@ -0,0 +1,413 @@
+/**
+ * @file    dt35_test.c
+ * @brief   dt35 主机测试. 把 DT35 的 "s...e" 文本帧按随机分段写入两个串口的
+ *          DMA 环形缓冲区并回放接收事件, 检查解析结果; 然后比较定点数解析和
+ *          原来的 atof 每帧的耗时. 两者都经过同样的环形缓冲区和接收事件,
+ *          另外给出只写入缓冲区不解析的耗时, 相减得到解析本身的耗时.
+ *
+ * 在 `Sensor/DT35/Code/dt35_recv` 下编译运行:
+ *
+ *   gcc -std=gnu11 -g -O2 -DDT35_USE_DMA_RECV=1 -Itest/stub -I. \
+ *       test/dt35_test.c dt35.c -o dt35_test
+ *   ./dt35_test
+ *
+ * 检查项:
+ *  - 没有配置循环模式接收 DMA 的串口注册失败
+ *  - 两路数据互不干扰, 夹杂的错误字节只丢弃所在的帧, 其余帧的原始值和距离
+ *    与 strtof 的结果完全相同
+ *  - 接收事件用 SIGUSR1 模拟, 用 ptrace 单步执行, 依次在 dt35_process 的
+ *    每一条指令处注入, 每帧的时间戳必须是写入该帧之后那次事件的时刻 (Linux)
+ */
+
+#include "dt35.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/ptrace.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+/* 回放帧数 (每路) */
+#define TEST_FRAMES     200000
+/* 耗时测试的帧数和重复次数 */
+#define BENCH_FRAMES    100000
+#define BENCH_REPEAT    20
+
+volatile uint32_t test_tick;
+
+static DMA_HandleTypeDef test_dma = {{DMA_CIRCULAR}};
+static UART_HandleTypeDef test_uart[2] = {{1, &test_dma}, {2, &test_dma}};
+static uint8_t *test_dma_buf[2];
+static uint16_t test_wp[2];
+
+int HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *buf,
+                                 uint16_t size) {
+    (void)size;
+    test_dma_buf[huart->Instance - 1] = buf;
+    return HAL_OK;
+}
+
+int HAL_UARTEx_ReceiveToIdle_IT(UART_HandleTypeDef *huart, uint8_t *buf,
+                                uint16_t size) {
+    (void)huart;
+    (void)buf;
+    (void)size;
+    return HAL_OK;
+}
+
+static uint32_t test_rand(uint32_t *state) {
+    *state = *state * 1103515245U + 12345U;
+    return *state >> 16;
+}
+
+static double test_now(void) {
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief 模拟 DMA 写入一个字节, 写到缓冲区末尾时产生全满事件
+ */
+static void test_dma_put(uint8_t ch, uint8_t byte) {
+    test_dma_buf[ch][test_wp[ch]++] = byte;
+    if (test_wp[ch] == DT35_DMA_BUF_SIZE) {
+        HAL_UARTEx_RxEventCallback(&test_uart[ch], DT35_DMA_BUF_SIZE);
+        test_wp[ch] = 0;
+    }
+}
+
+/**
+ * @brief 没有循环模式接收 DMA 时注册失败
+ */
+static void test_register(void) {
+    DMA_HandleTypeDef normal = {{0}};
+    UART_HandleTypeDef no_dma = {1, NULL};
+    UART_HandleTypeDef not_circular = {1, &normal};
+
+    CHECK(dt35_register_uart(&no_dma, NULL) == 1);
+    CHECK(g_dt35_data[0].uart_handle == NULL);
+    CHECK(dt35_register_uart(&test_uart[0], &not_circular) == 1);
+    CHECK(g_dt35_data[1].uart_handle == NULL);
+    CHECK(dt35_register_uart(&test_uart[0], &test_uart[1]) == 0);
+}
+
+/**
+ * @brief 两路交替回放, 每帧前随机插入错误字节, 帧内随机产生空闲事件,
+ *        随机调用 dt35_process
+ */
+static void test_replay(void) {
+    uint32_t rand_state = 5;
+    uint32_t err[2] = {0, 0};
+    char frame[40];
+
+    test_wp[0] = test_wp[1] = 0;
+    memset(g_dt35_data, 0, sizeof(g_dt35_data));
+    CHECK(dt35_register_uart(&test_uart[0], &test_uart[1]) == 0);
+
+    for (uint32_t f = 0; f < TEST_FRAMES; ++f) {
+        for (uint8_t ch = 0; ch < 2; ++ch) {
+            uint32_t q = test_rand(&rand_state) % 160000;
+            uint32_t seq = g_dt35_data[ch].seq;
+            uint8_t garbage = 0;
+            int n = 0;
+            float raw, distance;
+            uint32_t timestamp;
+
+            /* 帧前插入一段以 's' 开头的错误数据, 计一次格式错误 */
+            if (test_rand(&rand_state) % 8 == 0) {
+                frame[n++] = 's';
+                frame[n++] = "x.-9"[test_rand(&rand_state) % 4];
+                frame[n++] = 'x';
+                garbage = 1;
+            }
+            n += sprintf(frame + n, "s%s%u.%04ue",
+                         test_rand(&rand_state) % 16 == 0 ? "-" : "",
+                         4 + q / 10000, q % 10000);
+
+            test_tick = f;
+            for (int i = 0; i < n; ++i) {
+                test_dma_put(ch, (uint8_t)frame[i]);
+                if (test_rand(&rand_state) % 7 == 0) {
+                    HAL_UARTEx_RxEventCallback(&test_uart[ch], test_wp[ch]);
+                    if (test_rand(&rand_state) % 3 == 0) {
+                        dt35_process();
+                    }
+                }
+            }
+            HAL_UARTEx_RxEventCallback(&test_uart[ch], test_wp[ch]);
+            dt35_process();
+
+            CHECK(g_dt35_data[ch].seq == seq + 2);
+            CHECK(dt35_read(ch, &distance, &timestamp) == seq / 2 + 1);
+            raw = strtof(strrchr(frame, 's') + 1, NULL);
+            CHECK(g_dt35_data[ch].dt35_raw == raw);
+            CHECK(distance == (g_dt35_data[ch].Q2_far - g_dt35_data[ch].Q2_near) *
+                                      (raw - 4) / 16 +
+                                  g_dt35_data[ch].Q2_near);
+            CHECK(timestamp == f);
+            err[ch] += garbage;
+        }
+    }
+
+    CHECK(g_dt35_data[0].err_cnt == err[0]);
+    CHECK(g_dt35_data[1].err_cnt == err[1]);
+    printf("replay: %u frames per channel, %u/%u bad frames dropped\n",
+           TEST_FRAMES, err[0], err[1]);
+}
+
+/**
+ * @brief 模拟 DMA 写入一帧, 数值为帧号, 不产生事件
+ */
+static void test_put_frame(uint32_t f) {
+    char frame[16];
+    int n = sprintf(frame, "s%u.0e", f);
+
+    for (int i = 0; i < n; ++i) {
+        test_dma_put(0, (uint8_t)frame[i]);
+    }
+}
+
+/**
+ * @brief 模拟接收事件中断, 此时第 3 帧已写入
+ */
+static void test_rx_irq(int sig) {
+    (void)sig;
+    test_tick = 3;
+    HAL_UARTEx_RxEventCallback(&test_uart[0], test_wp[0]);
+}
+
+/**
+ * @brief 被跟踪的子进程: 第 2 帧的事件已记录但还没有解析, 第 3 帧已写入,
+ *        它的事件 (SIGUSR1) 由父进程在 dt35_process 的某条指令处注入
+ * @return 进程退出码, 0 表示最后解析的一帧的时间戳正确
+ */
+static int test_event_child(void) {
+    ptrace(PTRACE_TRACEME, 0, NULL, NULL);
+    signal(SIGUSR1, test_rx_irq);
+
+    test_wp[0] = 0;
+    memset(g_dt35_data, 0, sizeof(g_dt35_data));
+    dt35_register_uart(&test_uart[0], NULL);
+
+    for (uint32_t f = 1; f <= 2; ++f) {
+        test_put_frame(f);
+        test_tick = f;
+        HAL_UARTEx_RxEventCallback(&test_uart[0], test_wp[0]);
+        if (f == 1) {
+            dt35_process();
+        }
+    }
+    test_put_frame(3);
+
+    raise(SIGSTOP);
+    dt35_process();
+    raise(SIGSTOP);
+
+    /* 解析到第几帧取决于事件在哪里到来, 但时间戳必须属于同一次事件 */
+    return g_dt35_data[0].timestamp == (uint32_t)g_dt35_data[0].dt35_raw ? 0
+                                                                         : 1;
+}
+
+/**
+ * @brief 接收事件在 dt35_process 的每一条指令处到来时, 读到的位置和时间
+ *        都属于同一次事件. 用 ptrace 单步执行子进程, 在第 n 步注入事件.
+ */
+static void test_event_irq(void) {
+    uint32_t step;
+    int status;
+
+    for (step = 0;; ++step) {
+        pid_t pid = fork();
+        uint8_t done = 0;
+
+        CHECK(pid >= 0);
+        if (pid == 0) {
+            _exit(test_event_child());
+        }
+
+        /* 第一次 SIGSTOP: 即将调用 dt35_process */
+        CHECK(waitpid(pid, &status, 0) == pid && WIFSTOPPED(status));
+        for (uint32_t i = 0; i < step; ++i) {
+            CHECK(ptrace(PTRACE_SINGLESTEP, pid, NULL, NULL) == 0);
+            CHECK(waitpid(pid, &status, 0) == pid && WIFSTOPPED(status));
+            if (WSTOPSIG(status) == SIGSTOP) {
+                /* 第二次 SIGSTOP: 已经走完 dt35_process */
+                done = 1;
+                break;
+            }
+        }
+        if (done) {
+            kill(pid, SIGKILL);
+            waitpid(pid, &status, 0);
+            break;
+        }
+
+        CHECK(ptrace(PTRACE_CONT, pid, NULL, (void *)(intptr_t)SIGUSR1) == 0);
+        for (;;) {
+            CHECK(waitpid(pid, &status, 0) == pid);
+            if (WIFEXITED(status)) {
+                break;
+            }
+            CHECK(ptrace(PTRACE_CONT, pid, NULL, NULL) == 0);
+        }
+        if (WEXITSTATUS(status) != 0) {
+            printf("event irq: wrong timestamp with event at step %u\n", step);
+            exit(1);
+        }
+    }
+
+    printf("event irq: injected at %u instructions\n", step);
+}
+
+/*****************************************************************************
+ * 耗时比较. 三种做法都把每帧写入同一个环形缓冲区并产生接收事件, 只有解析不同,
+ * 只写入不解析的耗时作为共同的开销
+ */
+
+enum { BENCH_FEED, BENCH_ATOF, BENCH_FIXED };
+
+/* 原来 dt35.c 的解析: 字符存入缓冲区, 收到 'e' 时 atof */
+static struct {
+    uint8_t recv_sta;
+    char recv_buf[16];
+    float dt35_raw;
+    float distance;
+} bench_old;
+
+static void bench_old_parse_byte(uint8_t ch) {
+    switch (ch) {
+        case 'e': {
+            bench_old.dt35_raw = (float)atof(bench_old.recv_buf);
+            bench_old.distance =
+                (2050 - 140) * (bench_old.dt35_raw - 4) / 16 + 140;
+            bench_old.recv_sta = 0;
+            memset(bench_old.recv_buf, 0, sizeof(bench_old.recv_buf));
+        } break;
+
+        case 's': {
+            bench_old.recv_sta |= 0x80;
+        } break;
+
+        default: {
+            if (bench_old.recv_sta != 0 &&
+                (bench_old.recv_sta & 0x7f) < sizeof(bench_old.recv_buf) - 1) {
+                bench_old.recv_buf[bench_old.recv_sta & 0x7f] = (char)ch;
+                ++bench_old.recv_sta;
+            }
+        } break;
+    }
+}
+
+/**
+ * @brief 按一种做法处理全部帧 `BENCH_REPEAT` 次
+ *
+ * @return 耗时 (s)
+ */
+static double bench_run(const char (*frames)[16], uint8_t mode) {
+    volatile float sink = 0;
+    uint16_t pos = test_wp[0];
+    double t = test_now();
+
+    for (uint32_t r = 0; r < BENCH_REPEAT; ++r) {
+        for (uint32_t i = 0; i < BENCH_FRAMES; ++i) {
+            for (const char *p = frames[i]; *p != '\0'; ++p) {
+                test_dma_put(0, (uint8_t)*p);
+            }
+            HAL_UARTEx_RxEventCallback(&test_uart[0], test_wp[0]);
+
+            if (mode == BENCH_FIXED) {
+                dt35_process();
+                sink += g_dt35_data[0].dt35_raw;
+                continue;
+            }
+            if (mode == BENCH_ATOF) {
+                for (; pos != test_wp[0];
+                     pos = (pos + 1) % DT35_DMA_BUF_SIZE) {
+                    bench_old_parse_byte(test_dma_buf[0][pos]);
+                }
+                sink += bench_old.dt35_raw;
+            } else {
+                uint32_t sum = 0;
+
+                for (; pos != test_wp[0];
+                     pos = (pos + 1) % DT35_DMA_BUF_SIZE) {
+                    sum += test_dma_buf[0][pos];
+                }
+                sink += (float)sum;
+            }
+        }
+    }
+    t = test_now() - t;
+
+    /* 写入位置不变, 下一种做法从这里继续 */
+    g_dt35_data[0].read_pos = test_wp[0];
+    (void)sink;
+    return t;
+}
+
+/**
+ * @brief 每帧耗时: 原来的 atof 与定点数解析, 各取 5 轮中最快的一轮
+ */
+static void test_bench(void) {
+    static char frames[BENCH_FRAMES][16];
+    static const char *const names[] = {"ring feed only", "atof (original)",
+                                         "fixed-point"};
+    uint32_t rand_state = 11;
+    double best[3] = {1e9, 1e9, 1e9};
+    double n = (double)BENCH_FRAMES * BENCH_REPEAT;
+    uint32_t seq;
+
+    test_wp[0] = test_wp[1] = 0;
+    memset(g_dt35_data, 0, sizeof(g_dt35_data));
+    CHECK(dt35_register_uart(&test_uart[0], NULL) == 0);
+
+    for (uint32_t i = 0; i < BENCH_FRAMES; ++i) {
+        uint32_t q = test_rand(&rand_state) % 160000;
+
+        sprintf(frames[i], "s%u.%04ue", 4 + q / 10000, q % 10000);
+    }
+
+    for (uint32_t round = 0; round < 5; ++round) {
+        for (uint8_t mode = BENCH_FEED; mode <= BENCH_FIXED; ++mode) {
+            double t;
+
+            seq = g_dt35_data[0].seq;
+            t = bench_run((const char(*)[16])frames, mode);
+            best[mode] = (t < best[mode]) ? t : best[mode];
+        }
+        CHECK(g_dt35_data[0].seq == seq + 2 * BENCH_FRAMES * BENCH_REPEAT);
+        CHECK(bench_old.dt35_raw == strtof(frames[BENCH_FRAMES - 1] + 1, NULL));
+        CHECK(g_dt35_data[0].dt35_raw == bench_old.dt35_raw);
+    }
+
+    for (uint8_t mode = BENCH_FEED; mode <= BENCH_FIXED; ++mode) {
+        printf("bench %-15s: %5.1f ns/frame", names[mode],
+               best[mode] * 1e9 / n);
+        if (mode != BENCH_FEED) {
+            printf(", parse only %5.1f ns/frame",
+                   (best[mode] - best[BENCH_FEED]) * 1e9 / n);
+        }
+        printf("\n");
+    }
+}
+
+int main(void) {
+    test_register();
+    test_replay();
+    test_event_irq();
+    test_bench();
+    printf("dt35: all tests passed\n");
+    return 0;
+}
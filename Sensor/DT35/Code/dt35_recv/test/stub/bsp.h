@@ -0,0 +1,43 @@
+/**
+ * @file    bsp.h
+ * @brief   主机测试用的 HAL 替身, 只包含 dt35.c 用到的部分
+ */
+
+#ifndef __BSP_H
+#define __BSP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#define HAL_OK       0
+#define DMA_CIRCULAR 0x20U
+
+typedef struct {
+    struct {
+        uint32_t Mode;
+    } Init;
+} DMA_HandleTypeDef;
+
+typedef struct {
+    int Instance;
+    DMA_HandleTypeDef *hdmarx;
+} UART_HandleTypeDef;
+
+extern volatile uint32_t test_tick;
+
+static inline uint32_t HAL_GetTick(void) {
+    return test_tick;
+}
+
+/* 测试中的 "中断" 是同一线程里的信号处理函数, 与单核 MCU 一样只需要阻止编译器
+ * 重排. 用 mfence 会在主机上给每帧多算几十 ns, 与目标上的 DMB 不符 */
+#define __DMB() __asm__ volatile("" ::: "memory")
+
+int HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *buf,
+                                 uint16_t size);
+int HAL_UARTEx_ReceiveToIdle_IT(UART_HandleTypeDef *huart, uint8_t *buf,
+                                uint16_t size);
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size);
+
+#endif /* __BSP_H */
@@ -31,6 +31,8 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "ads8864.h"
+#include "adc_filter.h"
+#include "telemetry.h"
 #include "arm_math.h"
 #include "can_bsp.h"
 #include "oled.h"
@@ -74,6 +76,10 @@ uint32_t v_codex = 0;
 float GF = 16.0f/62474.0f;
 
 uint16_t RGB = 180;
+
+#if (ADS8864_SAMPLE_MODE == ADS8864_MODE_DMA)
+static adc_filter_t adc_filter;
+#endif
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -84,7 +90,33 @@ void SystemClock_Config(void);
 
 /* Private user code ---------------------------------------------------------*/
 /* USER CODE BEGIN 0 */
+#if (ADS8864_SAMPLE_MODE == ADS8864_MODE_DMA)
+/* DMAÿһ, ж˲ */
+void ADS8864_BlockCallback(const uint16_t *block, uint16_t len)
+{
+	adc_filter_process(&adc_filter, block, len);
+}
+#endif
+
+/* ˲ֵQ2 (mA) */
+static float Calc_Q2(void)
+{
+#if (ADS8864_SAMPLE_MODE == ADS8864_MODE_DMA)
+	/* ˲DMAж, ֻȡ */
+	return 4 + GF*(adc_filter_read(&adc_filter, NULL) - v_code1);
+#else
+	return 4 + GF*(adc_mean[0] - v_code1);
+#endif
+}
 
+#if (TELEMETRY_FORMAT == TELEMETRY_FORMAT_BINARY)
+/* TIM6жаTELEMETRY_RATE, ֡DMA */
+void telemetry_timer_callback(void)
+{
+	Q_2 = Calc_Q2();
+	telemetry_send_value(Q_2);
+}
+#endif
 /* USER CODE END 0 */
 void getNum(int n,uint8_t laser_data[])
 {
@@ -154,8 +186,14 @@ int main(void)
   MX_TIM15_Init();
   /* USER CODE BEGIN 2 */
 	
+#if (ADS8864_SAMPLE_MODE == ADS8864_MODE_DMA)
+	adc_filter_init(&adc_filter);
+#endif
 	ads8864_Init();
 	LL_mDelay(20);
+#if (TELEMETRY_FORMAT == TELEMETRY_FORMAT_BINARY)
+	telemetry_init();
+#endif
 	
   /* USER CODE END 2 */
   /* Infinite loop */
@@ -168,11 +206,14 @@ int main(void)
     /* USER CODE BEGIN 3 */
 	
 /**************˲*******************/
+#if (ADS8864_SAMPLE_MODE == ADS8864_MODE_EXTI)
 		Mean_filter();
+#endif
 
+#if (TELEMETRY_FORMAT == TELEMETRY_FORMAT_ASCII)
 /**************Calc**********************/
 		
-		Q_2 = 4 + GF*(adc_mean[0] - v_code1);
+		Q_2 = Calc_Q2();
 		
 		
 		uint8_t len = getFloatNum(Q_2 , TxData, 4);
@@ -185,6 +226,7 @@ int main(void)
 
 /**************UART**********************/		
 		HAL_Delay(20);
+#endif
   }
   /* USER CODE END 3 */
 }
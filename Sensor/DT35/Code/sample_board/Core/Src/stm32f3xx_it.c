@@ -24,6 +24,7 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "ads8864.h"
+#include "telemetry.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -253,5 +254,31 @@ void USART3_IRQHandler(void)
 }
 
 /* USER CODE BEGIN 1 */
+#if (ADS8864_SAMPLE_MODE == ADS8864_MODE_DMA)
+/**
+  * @brief This function handles DMA1 channel4 global interrupt (SPI2_RX).
+  */
+void DMA1_Channel4_IRQHandler(void)
+{
+	ADS8864_DMA_IRQ();
+}
+#endif
 
+#if (TELEMETRY_FORMAT == TELEMETRY_FORMAT_BINARY)
+/**
+  * @brief This function handles DMA1 channel2 global interrupt (USART3_TX).
+  */
+void DMA1_Channel2_IRQHandler(void)
+{
+	telemetry_dma_irq();
+}
+
+/**
+  * @brief This function handles TIM6 global interrupt.
+  */
+void TIM6_DAC_IRQHandler(void)
+{
+	telemetry_tim_irq();
+}
+#endif
 /* USER CODE END 1 */
@@ -0,0 +1,160 @@
+/**
+ * @file    adc_filter.c
+ * @brief   ADS8864 数据流式抽取滤波
+ */
+
+#include "adc_filter.h"
+
+#include <string.h>
+
+/* CIC 增益为 2^(阶数 * log2(抽取倍数)), 左移到 Q31 */
+#define ADC_FILTER_CIC_SHIFT (15 - ADC_FILTER_CIC_ORDER * ADC_FILTER_DECIM_LOG2)
+
+#if (ADC_FILTER_STAGE2 == ADC_FILTER_STAGE2_IIR)
+
+/* IIR 系数 (Q31) */
+#define ADC_FILTER_IIR_COEFF ((int32_t)(ADC_FILTER_IIR_ALPHA * 2147483648.0))
+
+#elif (ADC_FILTER_STAGE2 == ADC_FILTER_STAGE2_FIR)
+
+/**
+ * @brief FIR 系数 (Q31), 线性相位, 系数和为 1.0
+ * @note 默认为汉明窗低通, 截止频率为抽取后采样率的 0.1 倍
+ */
+static const int32_t adc_filter_fir_coeffs[ADC_FILTER_FIR_TAPS] = {
+    -7713034,  -8728228,  0,         45635524,  144507465,
+    279001514, 398104306, 445868554, 398104306, 279001514,
+    144507465, 45635524,  0,         -8728228,  -7713034};
+
+#endif /* ADC_FILTER_STAGE2 */
+
+/**
+ * @brief 初始化滤波器
+ *
+ * @param filter 滤波器
+ */
+void adc_filter_init(adc_filter_t *filter) {
+    memset(filter, 0, sizeof(adc_filter_t));
+}
+
+/**
+ * @brief 第二级滤波
+ *
+ * @param filter 滤波器
+ * @param x CIC 输出 (Q31)
+ * @return 滤波结果 (Q31)
+ */
+static inline int32_t adc_filter_stage2(adc_filter_t *filter, int32_t x) {
+#if (ADC_FILTER_STAGE2 == ADC_FILTER_STAGE2_IIR)
+    if (filter->iir_init == 0) {
+        filter->iir_init = 1;
+        filter->iir_y = x;
+    }
+    /* 数据均为非负数, 差值不会溢出 */
+    filter->iir_y +=
+        (int32_t)(((int64_t)(x - filter->iir_y) * ADC_FILTER_IIR_COEFF) >> 31);
+    return filter->iir_y;
+#elif (ADC_FILTER_STAGE2 == ADC_FILTER_STAGE2_FIR)
+    int64_t acc = 0;
+    uint16_t pos, i;
+
+    if (++filter->fir_pos >= ADC_FILTER_FIR_TAPS) {
+        filter->fir_pos = 0;
+    }
+    filter->fir_hist[filter->fir_pos] = x;
+
+    pos = filter->fir_pos;
+    for (i = 0; i < ADC_FILTER_FIR_TAPS; ++i) {
+        acc += (int64_t)filter->fir_hist[pos] * adc_filter_fir_coeffs[i];
+        pos = (pos == 0) ? ADC_FILTER_FIR_TAPS - 1 : pos - 1;
+    }
+    acc >>= 31;
+
+    /* 系数有负数, 接近满量程的阶跃会过冲, 超出 Q31 的范围时饱和 */
+    if (acc > INT32_MAX) {
+        return INT32_MAX;
+    }
+    if (acc < INT32_MIN) {
+        return INT32_MIN;
+    }
+    return (int32_t)acc;
+#else  /* ADC_FILTER_STAGE2 */
+    (void)filter;
+    return x;
+#endif /* ADC_FILTER_STAGE2 */
+}
+
+/**
+ * @brief 处理一块采样数据
+ *
+ * @param filter 滤波器
+ * @param data 采样码值
+ * @param len 采样数, 不要求是抽取倍数的整数倍
+ * @note 可以直接在 DMA 块完成回调中调用. 每个采样为 CIC 阶数次加法,
+ *       每个抽取输出再做一次梳状器和第二级滤波.
+ */
+void adc_filter_process(adc_filter_t *filter, const uint16_t *data,
+                        uint32_t len) {
+    uint32_t v, t;
+    int32_t y;
+    uint32_t i, k;
+
+    for (i = 0; i < len; ++i) {
+        v = data[i];
+        for (k = 0; k < ADC_FILTER_CIC_ORDER; ++k) {
+            filter->integ[k] += v;
+            v = filter->integ[k];
+        }
+
+        if (++filter->decim_cnt < ADC_FILTER_DECIMATION) {
+            continue;
+        }
+        filter->decim_cnt = 0;
+
+        for (k = 0; k < ADC_FILTER_CIC_ORDER; ++k) {
+            t = v;
+            v -= filter->comb[k];
+            filter->comb[k] = t;
+        }
+
+        y = adc_filter_stage2(filter, (int32_t)(v << ADC_FILTER_CIC_SHIFT));
+
+        if (++filter->out_cnt >= ADC_FILTER_OUTPUT_DIV) {
+            filter->out_cnt = 0;
+            filter->output = y;
+            filter->output_seq++;
+        }
+    }
+}
+
+/**
+ * @brief 读取滤波结果
+ *
+ * @param filter 滤波器
+ * @param[out] seq 输出次数, 可以为 NULL
+ * @return 码值
+ */
+float adc_filter_read(adc_filter_t *filter, uint32_t *seq) {
+    if (seq != NULL) {
+        *seq = filter->output_seq;
+    }
+    return (float)filter->output * (1.0f / 32768.0f);
+}
+
+/**
+ * @brief 滤波器的群延时
+ *
+ * @return 群延时 (输入采样个数), IIR 为直流处的值, 不包括输出分频的保持时间
+ */
+float adc_filter_group_delay(void) {
+    float delay = ADC_FILTER_CIC_ORDER * (ADC_FILTER_DECIMATION - 1) / 2.0f;
+
+#if (ADC_FILTER_STAGE2 == ADC_FILTER_STAGE2_IIR)
+    delay += (1.0f - (float)ADC_FILTER_IIR_ALPHA) /
+             (float)ADC_FILTER_IIR_ALPHA * ADC_FILTER_DECIMATION;
+#elif (ADC_FILTER_STAGE2 == ADC_FILTER_STAGE2_FIR)
+    delay += (ADC_FILTER_FIR_TAPS - 1) / 2.0f * ADC_FILTER_DECIMATION;
+#endif /* ADC_FILTER_STAGE2 */
+
+    return delay;
+}
@@ -0,0 +1,79 @@
+/**
+ * @file    adc_filter.h
+ * @brief   ADS8864 数据流式抽取滤波
+ *
+ *****************************************************************************
+ * 每个 DMA 块到达时增量处理, 每个采样的计算量固定, 不再对整个缓冲区求平均:
+ *  - CIC 抽取: `ADC_FILTER_CIC_ORDER` 阶, 抽取 2^`ADC_FILTER_DECIM_LOG2` 倍,
+ *    1 阶即为平均值抽取 (boxcar)
+ *  - 第二级 (可选): 一阶 IIR 低通或 FIR, 工作在抽取后的采样率
+ *  - 输出分频: 每 `ADC_FILTER_OUTPUT_DIV` 个第二级结果更新一次输出
+ *
+ * 数据为 Q31 格式, 16 位采样码值左移 15 位, 即 1.0 对应码值 65536.
+ * 通带增益为 1, `adc_filter_read` 返回码值.
+ *****************************************************************************
+ */
+
+#ifndef __ADC_FILTER_H
+#define __ADC_FILTER_H
+
+#include <stdint.h>
+
+/* CIC 阶数, 1 为平均值抽取 */
+#define ADC_FILTER_CIC_ORDER  3
+/* 抽取倍数的对数, 抽取 2^n 倍 */
+#define ADC_FILTER_DECIM_LOG2 5
+
+/* 第二级滤波 */
+#define ADC_FILTER_STAGE2_NONE 0 /* 不使用 */
+#define ADC_FILTER_STAGE2_IIR  1 /* 一阶 IIR 低通 */
+#define ADC_FILTER_STAGE2_FIR  2 /* FIR, 系数见 adc_filter.c */
+#ifndef ADC_FILTER_STAGE2
+#define ADC_FILTER_STAGE2 ADC_FILTER_STAGE2_IIR
+#endif /* ADC_FILTER_STAGE2 */
+
+/* IIR 系数 a, y += a * (x - y), -3dB 频率约为 a / 2pi 倍抽取后采样率 */
+#define ADC_FILTER_IIR_ALPHA 0.05
+/* FIR 阶数 (系数个数) */
+#define ADC_FILTER_FIR_TAPS  15
+
+/* 输出分频 */
+#ifndef ADC_FILTER_OUTPUT_DIV
+#define ADC_FILTER_OUTPUT_DIV 40
+#endif /* ADC_FILTER_OUTPUT_DIV */
+
+#if (ADC_FILTER_CIC_ORDER * ADC_FILTER_DECIM_LOG2 > 15)
+#error "CIC gain does not fit in 32 bits."
+#endif
+
+/* 抽取倍数 */
+#define ADC_FILTER_DECIMATION (1UL << ADC_FILTER_DECIM_LOG2)
+
+/**
+ * @brief 滤波器状态
+ */
+typedef struct {
+    uint32_t integ[ADC_FILTER_CIC_ORDER]; /*!< 积分器, 按模 2^32 溢出 */
+    uint32_t comb[ADC_FILTER_CIC_ORDER];  /*!< 梳状器上一次的输入 */
+    uint32_t decim_cnt;                   /*!< 抽取计数 */
+
+#if (ADC_FILTER_STAGE2 == ADC_FILTER_STAGE2_IIR)
+    int32_t iir_y;    /*!< IIR 输出 */
+    uint8_t iir_init; /*!< IIR 是否已用第一个数据初始化 */
+#elif (ADC_FILTER_STAGE2 == ADC_FILTER_STAGE2_FIR)
+    int32_t fir_hist[ADC_FILTER_FIR_TAPS]; /*!< FIR 历史数据 */
+    uint16_t fir_pos;                      /*!< 最新数据的位置 */
+#endif /* ADC_FILTER_STAGE2 */
+
+    uint32_t out_cnt;             /*!< 输出分频计数 */
+    volatile int32_t output;      /*!< 输出 (Q31) */
+    volatile uint32_t output_seq; /*!< 输出次数 */
+} adc_filter_t;
+
+void adc_filter_init(adc_filter_t *filter);
+void adc_filter_process(adc_filter_t *filter, const uint16_t *data,
+                        uint32_t len);
+float adc_filter_read(adc_filter_t *filter, uint32_t *seq);
+float adc_filter_group_delay(void);
+
+#endif /* __ADC_FILTER_H */
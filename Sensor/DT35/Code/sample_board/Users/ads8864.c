@@ -2,6 +2,7 @@
 #include "arm_math.h"
 #include "gpio.h"
 #include "tim.h"
+#include "stm32f3xx_ll_spi.h"
 
 int adc_rawdata[ADC_SAMPLE_SIZE] = {0};
 uint8_t adc_data[BUFFER_SIZE] = {0};
@@ -26,6 +27,15 @@ static void Convst_Reset(void)
 }
 
 
+#if (ADS8864_SAMPLE_MODE == ADS8864_MODE_DMA)
+/* ƹһ, DMAѭд, ȫʱһ */
+static uint16_t adc_dma_buf[2][ADS8864_DMA_BLOCK];
+/* дSPI2->DRԲ16ʱ, DINGPIOָߵƽ, ݲӰȡ */
+static const uint16_t adc_dma_dummy = 0xFFFF;
+/* ɵĿ */
+volatile uint32_t adc_block_count;
+#endif
+
 void Mean_filter(void)
 {
 	arm_mean_q31(adc_rawdata,ADC_SAMPLE_SIZE,&adc_mean[0]);
@@ -70,6 +80,132 @@ void ADS8864_ReadValue(void)
 
 }
 
+#if (ADS8864_SAMPLE_MODE == ADS8864_MODE_DMA)
+
+/**
+  * @brief  һɻص, DMAже
+  * @param  block  (16λԭ)
+  * @param  len 
+  * @note   , ļʵ, һд֮ǰ뷵
+  * @retval none
+  */
+__weak void ADS8864_BlockCallback(const uint16_t *block, uint16_t len)
+{
+	UNUSED(block);
+	UNUSED(len);
+}
+
+/**
+  * @brief  һ, adc_rawdata
+  * @param  block 
+  * @retval none
+  */
+static void ADS8864_BlockDone(const uint16_t *block)
+{
+	for (uint16_t i = 0; i < ADS8864_DMA_BLOCK; i++)
+	{
+		adc_rawdata[adc_counter] = block[i];
+		adc_counter++;
+		if (adc_counter == ADC_SAMPLE_SIZE)
+		{
+			adc_counter = 0;
+		}
+	}
+	adc_block_count++;
+
+	ADS8864_BlockCallback(block, ADS8864_DMA_BLOCK);
+}
+
+/**
+  * @brief  SPI2DMAжϴ
+  * @note   ˺stm32f3xx_it.cļе
+  *         void DMA1_Channel4_IRQHandler(void)
+  * @retval none
+  */
+void ADS8864_DMA_IRQ(void)
+{
+	if (LL_DMA_IsActiveFlag_HT4(DMA1))
+	{
+		LL_DMA_ClearFlag_HT4(DMA1);
+		ADS8864_BlockDone(adc_dma_buf[0]);
+	}
+	if (LL_DMA_IsActiveFlag_TC4(DMA1))
+	{
+		LL_DMA_ClearFlag_TC4(DMA1);
+		ADS8864_BlockDone(adc_dma_buf[1]);
+	}
+	if (LL_DMA_IsActiveFlag_TE4(DMA1))
+	{
+		LL_DMA_ClearFlag_TE4(DMA1);
+	}
+}
+
+/**
+  * @brief  ʱDMA
+  * @note   TIM15ÿCH2CONVST, ȲСתʱ,
+  *         תж; CONVSTͺCH1Ƚ¼DMA1ͨ5,
+  *         SPI2->DRдһ, 16ʱӶ;
+  *         SPI2DMA1ͨ4, ѽѭдƹһ.
+  *         ̲ҪCPU, ֻÿʱһж.
+  * @retval none
+  */
+static void ADS8864_DMA_Init(void)
+{
+	/* ʹתж */
+	LL_EXTI_DisableIT_0_31(LL_EXTI_LINE_2);
+	LL_TIM_DisableCounter(TIM15);
+
+	/* SPI2: ȫ˫, 16λ, ÿյһһDMA */
+	LL_SPI_Disable(SPI2);
+	LL_SPI_SetTransferDirection(SPI2, LL_SPI_FULL_DUPLEX);
+	LL_SPI_SetDataWidth(SPI2, LL_SPI_DATAWIDTH_16BIT);
+	LL_SPI_SetRxFIFOThreshold(SPI2, LL_SPI_RX_FIFO_TH_HALF);
+	LL_SPI_EnableDMAReq_RX(SPI2);
+	LL_SPI_Enable(SPI2);
+
+	/* DMA1ͨ4 (SPI2_RX): SPI2->DR -> ƹһ */
+	LL_DMA_DisableChannel(DMA1, LL_DMA_CHANNEL_4);
+	LL_DMA_ConfigTransfer(DMA1, LL_DMA_CHANNEL_4,
+	                      LL_DMA_DIRECTION_PERIPH_TO_MEMORY | LL_DMA_PRIORITY_VERYHIGH |
+	                      LL_DMA_MODE_CIRCULAR | LL_DMA_PERIPH_NOINCREMENT |
+	                      LL_DMA_MEMORY_INCREMENT | LL_DMA_PDATAALIGN_HALFWORD |
+	                      LL_DMA_MDATAALIGN_HALFWORD);
+	LL_DMA_ConfigAddresses(DMA1, LL_DMA_CHANNEL_4, LL_SPI_DMA_GetRegAddr(SPI2),
+	                       (uint32_t)(uintptr_t)adc_dma_buf, LL_DMA_DIRECTION_PERIPH_TO_MEMORY);
+	LL_DMA_SetDataLength(DMA1, LL_DMA_CHANNEL_4, 2 * ADS8864_DMA_BLOCK);
+	LL_DMA_EnableIT_HT(DMA1, LL_DMA_CHANNEL_4);
+	LL_DMA_EnableIT_TC(DMA1, LL_DMA_CHANNEL_4);
+	LL_DMA_EnableIT_TE(DMA1, LL_DMA_CHANNEL_4);
+	LL_DMA_EnableChannel(DMA1, LL_DMA_CHANNEL_4);
+
+	/* DMA1ͨ5 (TIM15_CH1): Ƚ¼ʱдSPI2->DR, ʼȡ */
+	LL_DMA_DisableChannel(DMA1, LL_DMA_CHANNEL_5);
+	LL_DMA_ConfigTransfer(DMA1, LL_DMA_CHANNEL_5,
+	                      LL_DMA_DIRECTION_MEMORY_TO_PERIPH | LL_DMA_PRIORITY_HIGH |
+	                      LL_DMA_MODE_CIRCULAR | LL_DMA_PERIPH_NOINCREMENT |
+	                      LL_DMA_MEMORY_NOINCREMENT | LL_DMA_PDATAALIGN_HALFWORD |
+	                      LL_DMA_MDATAALIGN_HALFWORD);
+	LL_DMA_ConfigAddresses(DMA1, LL_DMA_CHANNEL_5, (uint32_t)(uintptr_t)&adc_dma_dummy,
+	                       LL_SPI_DMA_GetRegAddr(SPI2), LL_DMA_DIRECTION_MEMORY_TO_PERIPH);
+	LL_DMA_SetDataLength(DMA1, LL_DMA_CHANNEL_5, 1);
+	LL_DMA_EnableChannel(DMA1, LL_DMA_CHANNEL_5);
+
+	NVIC_SetPriority(DMA1_Channel4_IRQn, 0);
+	NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+
+	/* TIM15: CH2CONVST, CH1, ֻDMA */
+	LL_TIM_SetAutoReload(TIM15, ADS8864_SAMPLE_PERIOD - 1);
+	LL_TIM_OC_SetCompareCH2(TIM15, ADS8864_CONVST_PULSE);
+	LL_TIM_OC_SetMode(TIM15, LL_TIM_CHANNEL_CH1, LL_TIM_OCMODE_FROZEN);
+	LL_TIM_OC_SetCompareCH1(TIM15, ADS8864_CONVST_PULSE + ADS8864_READ_DELAY);
+	LL_TIM_EnableDMAReq_CC1(TIM15);
+	LL_TIM_SetCounter(TIM15, 0);
+	LL_TIM_GenerateEvent_UPDATE(TIM15);
+	LL_TIM_EnableCounter(TIM15);
+}
+
+#endif
+
 /**
   * @brief  ADS8864ʼ
   * @note   SPIƬѡź695ns
@@ -81,7 +217,11 @@ void ads8864_Init(void)
 	//TIM15 ƵΪ400KHz2.5us
 	//CounterֵΪ179ƬѡźΪ694.44ns
 	// 66.6KHz
+#if (ADS8864_SAMPLE_MODE == ADS8864_MODE_DMA)
+	ADS8864_DMA_Init();
+#else
 	Convst_Set(50);
+#endif
 	
 	//ʱ20ms
 	LL_mDelay(20);
@@ -10,6 +10,22 @@
 #define ADS8864_SPI_Port hspi2
 extern SPI_HandleTypeDef ADS8864_SPI_Port;
 
+/* ʽ */
+#define ADS8864_MODE_EXTI	0	/* תжжȡ, ÿһж */
+#define ADS8864_MODE_DMA	1	/* ʱCONVSTSPI DMAȡ, ÿһж */
+#define ADS8864_SAMPLE_MODE	ADS8864_MODE_DMA
+
+/* DMAʽʱ, λΪTIM15 (72MHz) */
+#define ADS8864_SAMPLE_PERIOD	1080	/* , 66.67KHz */
+#define ADS8864_CONVST_PULSE	112		/* CONVSTߵƽʱ, Сתʱ */
+#define ADS8864_READ_DELAY		4		/* CONVSTͺ󵽿ʼȡʱ */
+#define ADS8864_SPI_TICKS		128		/* ȡ16λʱ (SPI2 9MHz) */
+/* ÿĲ, DMAΪ */
+#define ADS8864_DMA_BLOCK		ADC_SAMPLE_SIZE
+
+#if (ADS8864_CONVST_PULSE + ADS8864_READ_DELAY + ADS8864_SPI_TICKS >= ADS8864_SAMPLE_PERIOD)
+#error "ADS8864_SAMPLE_PERIOD is too short."
+#endif
 
 void Mean_filter(void);
 void ADS8864_IRQ(void);
@@ -17,5 +33,12 @@ void ADS8864_IRQ(void);
 void ADS8864_ReadValue(void);
 void ads8864_Init(void);
 
+#if (ADS8864_SAMPLE_MODE == ADS8864_MODE_DMA)
+extern volatile uint32_t adc_block_count;
+
+void ADS8864_DMA_IRQ(void);
+void ADS8864_BlockCallback(const uint16_t *block, uint16_t len);
+#endif
+
 
 #endif
@@ -0,0 +1,185 @@
+/**
+ * @file    msg_frame.c
+ * @author  agent
+ * @brief   消息协议组帧
+ * @version 1.0
+ * @date    2026-10-16
+ */
+
+#include "msg_frame.h"
+
+#include <string.h>
+
+#if MSG_ENABLE_CRC8
+#include "crc/crc.h"
+#endif /* MSG_ENABLE_CRC8 */
+
+#ifdef MSG_ESC
+/**
+ * @brief 转义并复制数据, 不需要转义的连续数据整段复制
+ *
+ * @param[out] dst 目标地址
+ * @param src 数据
+ * @param len 数据长度
+ * @return 复制后目标的末尾
+ */
+static uint8_t *message_escape(uint8_t *dst, const uint8_t *src, uint32_t len) {
+    const uint8_t *end = src + len;
+    const uint8_t *run = src;
+
+    for (; src < end; ++src) {
+        if ((*src == MSG_EOF) || (*src == MSG_ESC)) {
+            memcpy(dst, run, src - run);
+            dst += src - run;
+            *dst++ = MSG_ESC;
+            /* 被转义的字节随下一段一起复制 */
+            run = src;
+        }
+    }
+
+    memcpy(dst, run, end - run);
+    return dst + (end - run);
+}
+
+/**
+ * @brief 统计需要转义的字节数
+ *
+ * @param data 数据
+ * @param len 数据长度
+ * @return 需要转义的字节数
+ */
+static uint32_t message_escape_count(const uint8_t *data, uint32_t len) {
+    uint32_t count = 0;
+
+    for (uint32_t i = 0; i < len; ++i) {
+        if ((data[i] == MSG_EOF) || (data[i] == MSG_ESC)) {
+            ++count;
+        }
+    }
+
+    return count;
+}
+#endif /* MSG_ESC */
+
+/**
+ * @brief 计算组帧后的准确长度 (包括转义)
+ *
+ * @param msg_id 数据含义
+ * @param data_type 数据类型
+ * @param seg 数据段
+ * @param seg_num 数据段个数
+ * @return 帧长度
+ */
+uint32_t message_frame_size(msg_id_t msg_id, msg_type_t data_type,
+                            const msg_segment_t *seg, uint32_t seg_num) {
+    uint32_t size = MSG_FRAME_OVERHEAD;
+    uint32_t data_len = 0;
+
+    for (uint32_t i = 0; i < seg_num; ++i) {
+        data_len += seg[i].len;
+#ifdef MSG_ESC
+        size += message_escape_count((const uint8_t *)seg[i].data, seg[i].len);
+#endif /* MSG_ESC */
+    }
+    size += data_len;
+
+    (void)msg_id;
+    (void)data_type;
+
+#ifdef MSG_ESC
+    /* 标识不需要转义, 只有长度可能需要 */
+    if ((data_len == MSG_EOF) || (data_len == MSG_ESC)) {
+        ++size;
+    }
+#endif /* MSG_ESC */
+
+    return size;
+}
+
+/**
+ * @brief 组帧到调用者提供的缓冲区, 不分配内存
+ *
+ * @param msg_id 数据含义
+ * @param data_type 数据类型, 不超过 0x0E
+ * @param seg 数据段, 按顺序组成数据区
+ * @param seg_num 数据段个数
+ * @param[out] buf 帧缓冲区, 可以直接是 DMA 发送缓冲区
+ * @param buf_size 缓冲区大小
+ * @return 帧长度, 0 表示参数错误或缓冲区放不下
+ * @note 缓冲区不小于`MSG_FRAME_MAX_SIZE(数据长度)`时一定放得下, 否则会先计算
+ *       准确长度再判断.
+ */
+uint32_t message_encode(msg_id_t msg_id, msg_type_t data_type,
+                        const msg_segment_t *seg, uint32_t seg_num,
+                        uint8_t *buf, uint32_t buf_size) {
+    uint32_t data_len = 0;
+    uint8_t *p = buf;
+
+    if (buf == NULL || seg == NULL || msg_id >= MSG_ID_RESERVE_LEN ||
+        data_type > 0x0E) {
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < seg_num; ++i) {
+        if (seg[i].data == NULL && seg[i].len != 0) {
+            return 0;
+        }
+        data_len += seg[i].len;
+    }
+
+    if (data_len == 0 || data_len > MSG_MAX_DATA_LEN) {
+        return 0;
+    }
+
+    if (MSG_FRAME_MAX_SIZE(data_len) > buf_size) {
+        if (message_frame_size(msg_id, data_type, seg, seg_num) > buf_size) {
+            return 0;
+        }
+    }
+
+#if MSG_ENABLE_CRC8
+    /* CRC8 校验结果, 逐段累加 */
+    uint8_t crc8_value = CRC8_INIT;
+#endif /* MSG_ENABLE_CRC8 */
+
+    /* 第一个字节, 高四位标记 ID, 低四位标记数据类型 (不超过 0x0E, 不需要转义)
+     * 第二个字节, 标记数据长度 */
+    *p++ = (uint8_t)(msg_id << 4) | data_type;
+#ifdef MSG_ESC
+    /* 长度可能等于结束符或转义标识, 与数据一样转义, 接收时会去掉转义 */
+    if ((data_len == MSG_EOF) || (data_len == MSG_ESC)) {
+        *p++ = MSG_ESC;
+    }
+#endif /* MSG_ESC */
+    *p++ = (uint8_t)data_len;
+
+    /* 复制数据到字节流 */
+    for (uint32_t i = 0; i < seg_num; ++i) {
+        if (seg[i].len == 0) {
+            continue;
+        }
+
+#if MSG_ENABLE_CRC8
+        crc8_value = crc8_update(crc8_value, (const uint8_t *)seg[i].data,
+                                 seg[i].len);
+#endif /* MSG_ENABLE_CRC8 */
+
+#ifdef MSG_ESC
+        p = message_escape(p, (const uint8_t *)seg[i].data, seg[i].len);
+#else  /* MSG_ESC */
+        memcpy(p, seg[i].data, seg[i].len);
+        p += seg[i].len;
+#endif /* MSG_ESC */
+    }
+
+#if MSG_ENABLE_CRC8
+    /* 添加 CRC8 帧校验数据, 拆成两个字节, 每个字节小于 0x10, 这样可以避免转义 */
+    *p++ = (crc8_value >> 4) & 0x0F;
+    *p++ = crc8_value & 0x0F;
+#endif /* MSG_ENABLE_CRC8 */
+
+    /* 最后一个字节, 标记数据末尾 */
+    *p++ = MSG_EOF;
+
+    return (uint32_t)(p - buf);
+}
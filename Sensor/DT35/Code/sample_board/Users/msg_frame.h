@@ -0,0 +1,95 @@
+/**
+ * @file    msg_frame.h
+ * @author  agent
+ * @brief   消息协议的帧格式和组帧
+ * @version 1.0
+ * @date    2026-10-16
+ *
+ *****************************************************************************
+ * 帧格式:
+ *   | (ID << 4) | 类型 | 长度 | 数据区 | (CRC8 高四位 | CRC8 低四位) | MSG_EOF |
+ * 长度和数据区中等于`MSG_EOF`或`MSG_ESC`的字节前插入`MSG_ESC`.
+ *
+ * 组帧不分配内存, 也不依赖串口, 可以直接组帧到 DMA 发送缓冲区.
+ * `msg_protocol`的收发也使用这里的定义.
+ *****************************************************************************
+ */
+
+#ifndef __MSG_FRAME_H
+#define __MSG_FRAME_H
+
+#include <stdint.h>
+
+/* 帧结束标志 (End Of Frame), 注意需要避开数据头标识和长度 */
+#define MSG_EOF               0x7F
+/* 转义标识 (Escape), 注意需要避开头标识和长度 */
+#define MSG_ESC               0x8F
+/* 启用 CRC8 */
+#define MSG_ENABLE_CRC8       0
+
+/* 帧的固定开销: 1 byte 标识, 1 byte 长度, 1 byte 结束符 (2 byte CRC8) */
+#if MSG_ENABLE_CRC8
+#define MSG_FRAME_OVERHEAD 5
+#else  /* MSG_ENABLE_CRC8 */
+#define MSG_FRAME_OVERHEAD 3
+#endif /* MSG_ENABLE_CRC8 */
+
+/* 数据长度为 len 时帧的最大长度 (长度和数据全部需要转义). 标识的低四位
+ * (数据类型) 不超过 0x0E, 不会等于结束符或转义标识, 不需要转义 */
+#ifdef MSG_ESC
+#define MSG_FRAME_MAX_SIZE(len) (MSG_FRAME_OVERHEAD + 1 + 2 * (len))
+#else  /* MSG_ESC */
+#define MSG_FRAME_MAX_SIZE(len) (MSG_FRAME_OVERHEAD + (len))
+#endif /* MSG_ESC */
+
+/* 单帧最大数据长度. 接收端在队列中用一个字节记录去掉转义后的帧长度加 1,
+ * 即 数据长度 + MSG_FRAME_OVERHEAD + 1, 不能超过 0xFF */
+#define MSG_MAX_DATA_LEN (0xFF - MSG_FRAME_OVERHEAD - 1)
+
+/**
+ * @brief 数据含义
+ */
+typedef enum {
+    MSG_ID_1, /*!< demo 1, TX2->RX3 */
+    MSG_ID_2, /*!< demo 2, TX3->RX4 */
+    MSG_ID_3, /*!< demo 3, TX4->RX5 */
+    MSG_ID_4, /*!< demo 4, TX5->RX2 */
+
+    MSG_ID_RESERVE_LEN /*!< 保留位, 用于定义数据长度 */
+} msg_id_t;
+
+/**
+ * @brief 数据类型
+ */
+typedef enum {
+    MSG_DATA_UINT8 = 0x00U,
+    MSG_DATA_INT8,
+    MSG_DATA_UINT16,
+    MSG_DATA_INT16,
+    MSG_DATA_INT32,
+    MSG_DATA_UINT32,
+    MSG_DATA_INT64,
+    MSG_DATA_UINT64,
+    MSG_DATA_FP32,
+    MSG_DATA_FP64,
+    MSG_DATA_STRING,
+    MSG_DATA_CUSTOM, /*!< 自定义数据类型 */
+    /*!< 可以在下面加自定义的数据类型, 不超过 0x0E */
+
+} msg_type_t;
+
+/**
+ * @brief 组帧用的数据段, 多段按顺序拼成一帧的数据区
+ */
+typedef struct {
+    const void *data; /*!< 数据 */
+    uint32_t len;     /*!< 长度 */
+} msg_segment_t;
+
+uint32_t message_frame_size(msg_id_t msg_id, msg_type_t data_type,
+                            const msg_segment_t *seg, uint32_t seg_num);
+uint32_t message_encode(msg_id_t msg_id, msg_type_t data_type,
+                        const msg_segment_t *seg, uint32_t seg_num,
+                        uint8_t *buf, uint32_t buf_size);
+
+#endif /* __MSG_FRAME_H */
@@ -11,10 +11,6 @@
 #include <string.h>
 #include <stdbool.h>
 
-#if MSG_ENABLE_CRC8
-#include "crc/crc.h"
-#endif /* MSG_ENABLE_CRC8 */
-
 #if MSG_ENABLE_RTOS
 #include "FreeRTOS.h"
 #include "semphr.h"
@@ -93,7 +89,7 @@ static msg_fifo_t *msg_fifo_init(uint32_t fifo_size);
  *
  * @param msg_id 数据含义
  * @param huart 发送串口句柄
- * @param buf_size 缓冲区大小
+ * @param buf_size 缓冲区大小, 不小于`MSG_FRAME_MAX_SIZE(最大数据长度)`
  */
 void message_register_send_uart(msg_id_t msg_id, UART_HandleTypeDef *huart,
                                 uint32_t buf_size) {
@@ -195,6 +191,7 @@ void message_register_polling_uart(msg_id_t msg_id, UART_HandleTypeDef *huart,
  * @param data_type 数据类型
  * @param data 数据内容
  * @param data_len 发送长度
+ * @note 组帧到注册时分配的发送缓冲区, 放不下的帧会被丢弃.
  */
 void message_send_data(msg_id_t msg_id, msg_type_t data_type, uint8_t *data,
                        uint32_t data_len) {
@@ -216,82 +213,28 @@ void message_send_data(msg_id_t msg_id, msg_type_t data_type, uint8_t *data,
         return;
     }
 
+    msg_segment_t seg = {data, data_len};
+    uint32_t frame_len;
+
 #if MSG_ENABLE_RTOS
     xSemaphoreTake(msg->send_buf_semp, portMAX_DELAY);
 #endif /* MSG_ENABLE_RTOS */
 
-    if (msg->send_buf_len <= data_len + 5) {
-        /* 不够, 扩容当前数据长度的 2 倍 */
-        uint8_t *new_buf = (uint8_t *)MSG_REALLOC(msg->send_buf, data_len * 2);
-        if (new_buf == NULL) {
-            return;
-        }
-
-        msg->send_buf = new_buf;
-        msg->send_buf_len = data_len * 2;
-    } else if ((data_len + 3) * 3 <= msg->send_buf_len) {
-        /* 长度小于 1/3, 缩容到原来的 1/2 */
-        uint8_t *new_buf =
-            (uint8_t *)MSG_REALLOC(msg->send_buf, msg->send_buf_len / 2);
-        if (new_buf == NULL) {
-            return;
-        }
-
-        msg->send_buf = new_buf;
-        msg->send_buf_len = msg->send_buf_len / 2;
-    }
-
-    uint8_t *send_buf = (uint8_t *)msg->send_buf;
-    uint32_t buf_idx = 0;
-
-#if MSG_ENABLE_CRC8
-    /* CRC8 校验结果 */
-    uint8_t crc8_value = calc_crc8(data, data_len);
-#endif /* MSG_ENABLE_CRC8 */
-
-    /* 第一个字节, 高四位标记 ID, 低四位标记数据类型 */
-    send_buf[buf_idx] = (uint8_t)(msg_id << 4) | data_type;
-    ++buf_idx;
-    /* 第二个字节, 标记数据长度 */
-    send_buf[buf_idx] = (uint8_t)data_len;
-    ++buf_idx;
-
-    /* 复制数据到字节流 */
-    for (uint32_t data_idx = 0; data_idx < data_len; ++data_idx) {
-#ifdef MSG_ESC
-        if ((data[data_idx] == MSG_EOF) || (data[data_idx] == MSG_ESC)) {
-            /* 转义 */
-            send_buf[buf_idx] = MSG_ESC;
-            ++buf_idx;
+    frame_len = message_encode(msg_id, data_type, &seg, 1, msg->send_buf,
+                               msg->send_buf_len);
+    if (frame_len != 0) {
+        if (msg->send_uart->hdmatx != NULL) {
+            uart_dmatx_write(msg->send_uart, msg->send_buf, frame_len);
+            uart_dmatx_send(msg->send_uart);
+        } else {
+            HAL_UART_Transmit(msg->send_uart, msg->send_buf, frame_len,
+                              0xFFFF);
         }
-#endif /* MSG_ESC */
-
-        send_buf[buf_idx] = data[data_idx];
-        ++buf_idx;
-    }
-
-#if MSG_ENABLE_CRC8
-    /* 添加 CRC8 帧校验数据, 拆成两个字节, 每个字节小于 0x10, 这样可以避免转义 */
-    send_buf[buf_idx] = (crc8_value >> 4) & 0x0F;
-    ++buf_idx;
-    send_buf[buf_idx] = (crc8_value & 0x0F);
-    ++buf_idx;
-#endif /* MSG_ENABLE_CRC8 */
-
-    /* 最后一个字节, 标记数据末尾 */
-    send_buf[buf_idx] = MSG_EOF;
-    ++buf_idx;
-
-    if (msg->send_uart->hdmatx != NULL) {
-        uart_dmatx_write(msg->send_uart, send_buf, buf_idx);
-        uart_dmatx_send(msg->send_uart);
-    } else {
-        HAL_UART_Transmit(msg->send_uart, send_buf, buf_idx, 0xFFFF);
-    }
 
 #if MSG_ENABLE_STATISTICS
-    ++msg->send_count;
+        ++msg->send_count;
 #endif /* MSG_ENABLE_STATISTICS */
+    }
 
 #if MSG_ENABLE_RTOS
     xSemaphoreGive(msg->send_buf_semp);
@@ -549,6 +492,7 @@ static msg_fifo_t *msg_fifo_init(uint32_t fifo_size) {
     fifo->mask = fifo_size - 1;
     fifo->head = 0;
     fifo->tail = 0;
+    fifo->frame_len = 0;
     fifo->new_frame = true;
 
     return fifo;
@@ -17,6 +17,12 @@
  *      (##) `message_send_data`函数需要指定消息 ID (`msg_id_t`), 消息数据
  *           类型 (`msg_type_t), `data`(数据指针, 也就是要发送的数据), 
  *           以及`data_len`, 数据长度
+ *      (##) 发送缓冲区在注册时分配, 发送时不再分配内存. 缓冲区大小至少为
+ *           `MSG_FRAME_MAX_SIZE(最大数据长度)`, 放不下的帧会被丢弃
+ *      (##) 如果要自己管理缓冲区 (例如直接组帧到 DMA 缓冲区), 调用
+ *           `msg_frame.h`中的`message_encode`. 数据可以分成多段
+ *           (`msg_segment_t`), 例如结构体头和数据数组, 不需要先拼接到一起.
+ *           `msg_frame.c`不依赖串口, 只组帧时可以单独使用
  * (#) 接收
  *      (##) 调用`message_register_polling_uart`添加消息 ID 对应的轮询串口
  *      (##) 调用`message_register_recv_callback`注册接收回调函数, 当收到消息
@@ -41,60 +47,21 @@
 #ifndef __MSG_PROTOCOL_H
 #define __MSG_PROTOCOL_H
 
+#include "msg_frame.h"
 #include "stm32f3xx_hal.h"
 #include <stdint.h>
 #include <stdlib.h>
 
-/* 帧结束标志 (End Of Frame), 注意需要避开数据头标识和长度 */
-#define MSG_EOF               0x7F
-/* 转义标识 (Escape), 注意需要避开头标识和长度 */
-#define MSG_ESC               0x8F
-/* 启用 CRC8 */
-#define MSG_ENABLE_CRC8       0
-
 /* 线程安全处理, 启用后会使用互斥信号量来保护发送缓冲区, 仅支持 FreeRTOS. */
 #define MSG_ENABLE_RTOS       0
 
 /* 始能统计, 启用后统计接收成功错误计数, 队列最大深度等信息 */
 #define MSG_ENABLE_STATISTICS 0
 
-/* 内存分配相关 */
+/* 内存分配相关, 仅在注册时使用 */
 #define MSG_MALLOC(x)         malloc(x)
-#define MSG_REALLOC(p, x)     realloc(p, x)
 #define MSG_FREE(p)           free(p)
 
-/**
- * @brief 数据含义
- */
-typedef enum {
-    MSG_ID_1, /*!< demo 1, TX2->RX3 */
-    MSG_ID_2, /*!< demo 2, TX3->RX4 */
-    MSG_ID_3, /*!< demo 3, TX4->RX5 */
-    MSG_ID_4, /*!< demo 4, TX5->RX2 */
-
-    MSG_ID_RESERVE_LEN /*!< 保留位, 用于定义数据长度 */
-} msg_id_t;
-
-/**
- * @brief 数据类型
- */
-typedef enum {
-    MSG_DATA_UINT8 = 0x00U,
-    MSG_DATA_INT8,
-    MSG_DATA_UINT16,
-    MSG_DATA_INT16,
-    MSG_DATA_INT32,
-    MSG_DATA_UINT32,
-    MSG_DATA_INT64,
-    MSG_DATA_UINT64,
-    MSG_DATA_FP32,
-    MSG_DATA_FP64,
-    MSG_DATA_STRING,
-    MSG_DATA_CUSTOM, /*!< 自定义数据类型 */
-    /*!< 可以在下面加自定义的数据类型 */
-
-} msg_type_t;
-
 /**
  * @brief 回调函数指针定义
  *
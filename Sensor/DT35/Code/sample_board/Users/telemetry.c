@@ -0,0 +1,178 @@
+/**
+ * @file    telemetry.c
+ * @brief   测量结果输出
+ */
+
+#include "telemetry.h"
+
+#include "stm32f3xx_ll_usart.h"
+
+#include <string.h>
+
+/* 一帧最大长度 */
+#define TELEMETRY_FRAME_SIZE MSG_FRAME_MAX_SIZE(TELEMETRY_MAX_DATA)
+
+/* 定时器计数频率 */
+#define TELEMETRY_TIM_CLOCK 1000000
+
+static uint8_t telemetry_buf[2][TELEMETRY_FRAME_SIZE];
+/* DMA 正在发送的缓冲区, 没有在发送时为 -1 */
+static volatile int8_t telemetry_tx_idx = -1;
+/* 等待发送的帧长度, 帧在 `telemetry_tx_idx` 之外的缓冲区中 */
+static volatile uint8_t telemetry_pending_len;
+/* 帧序号 */
+static uint16_t telemetry_seq;
+
+/* 被覆盖而没有发送的帧数 */
+volatile uint32_t telemetry_drop;
+
+/**
+ * @brief 用 DMA 发送一块缓冲区
+ *
+ * @param idx 缓冲区
+ * @param len 长度
+ */
+static void telemetry_start(int8_t idx, uint8_t len) {
+    telemetry_tx_idx = idx;
+    LL_DMA_DisableChannel(DMA1, TELEMETRY_DMA_CHANNEL);
+    LL_DMA_SetMemoryAddress(DMA1, TELEMETRY_DMA_CHANNEL,
+                            (uint32_t)(uintptr_t)telemetry_buf[idx]);
+    LL_DMA_SetDataLength(DMA1, TELEMETRY_DMA_CHANNEL, len);
+    LL_DMA_EnableChannel(DMA1, TELEMETRY_DMA_CHANNEL);
+}
+
+/**
+ * @brief 初始化 DMA 发送和定时器
+ *
+ * @note 串口由 CubeMX 生成的代码初始化, 这里只打开 DMA 请求.
+ */
+void telemetry_init(void) {
+    telemetry_tx_idx = -1;
+    telemetry_pending_len = 0;
+
+    LL_DMA_DisableChannel(DMA1, TELEMETRY_DMA_CHANNEL);
+    LL_DMA_ConfigTransfer(
+        DMA1, TELEMETRY_DMA_CHANNEL,
+        LL_DMA_DIRECTION_MEMORY_TO_PERIPH | LL_DMA_PRIORITY_LOW |
+            LL_DMA_MODE_NORMAL | LL_DMA_PERIPH_NOINCREMENT |
+            LL_DMA_MEMORY_INCREMENT | LL_DMA_PDATAALIGN_BYTE |
+            LL_DMA_MDATAALIGN_BYTE);
+    LL_DMA_SetPeriphAddress(DMA1, TELEMETRY_DMA_CHANNEL,
+                            LL_USART_DMA_GetRegAddr(
+                                TELEMETRY_USART, LL_USART_DMA_REG_DATA_TRANSMIT));
+    LL_DMA_EnableIT_TC(DMA1, TELEMETRY_DMA_CHANNEL);
+    LL_USART_EnableDMAReq_TX(TELEMETRY_USART);
+
+    NVIC_SetPriority(TELEMETRY_DMA_IRQn, TELEMETRY_IRQ_PRIORITY);
+    NVIC_EnableIRQ(TELEMETRY_DMA_IRQn);
+
+    /* APB1 二分频时定时器时钟倍频, 仍与系统时钟相同 */
+    TELEMETRY_TIM_CLK_ENABLE();
+    LL_TIM_SetPrescaler(TELEMETRY_TIM,
+                        SystemCoreClock / TELEMETRY_TIM_CLOCK - 1);
+    LL_TIM_SetAutoReload(TELEMETRY_TIM,
+                         TELEMETRY_TIM_CLOCK / TELEMETRY_RATE - 1);
+    LL_TIM_GenerateEvent_UPDATE(TELEMETRY_TIM);
+    LL_TIM_ClearFlag_UPDATE(TELEMETRY_TIM);
+    LL_TIM_EnableIT_UPDATE(TELEMETRY_TIM);
+
+    NVIC_SetPriority(TELEMETRY_TIM_IRQn, TELEMETRY_IRQ_PRIORITY);
+    NVIC_EnableIRQ(TELEMETRY_TIM_IRQn);
+
+    LL_TIM_EnableCounter(TELEMETRY_TIM);
+}
+
+/**
+ * @brief 组帧并发送, 不等待
+ *
+ * @param data_type 数据类型
+ * @param data 数据
+ * @param data_len 数据长度, 不超过 `TELEMETRY_MAX_DATA`
+ * @return 发送结果
+ * @retval - 0: 已开始发送或等待发送
+ * @retval - 1: 参数错误
+ * @note 只能在与 DMA 中断同优先级的中断中调用 (即 `telemetry_timer_callback`),
+ *       否则可能与发送完成中断同时修改缓冲区.
+ */
+uint8_t telemetry_send(msg_type_t data_type, const uint8_t *data,
+                       uint8_t data_len) {
+    msg_segment_t seg = {data, data_len};
+    int8_t idx;
+    uint8_t len;
+
+    if (data == NULL || data_len == 0 || data_len > TELEMETRY_MAX_DATA) {
+        return 1;
+    }
+
+    idx = telemetry_tx_idx < 0 ? 0 : telemetry_tx_idx ^ 1;
+    len = (uint8_t)message_encode(TELEMETRY_MSG_ID, data_type, &seg, 1,
+                                  telemetry_buf[idx], TELEMETRY_FRAME_SIZE);
+    if (len == 0) {
+        return 1;
+    }
+
+    if (telemetry_tx_idx < 0) {
+        telemetry_start(0, len);
+        return 0;
+    }
+
+    if (telemetry_pending_len != 0) {
+        ++telemetry_drop;
+    }
+    telemetry_pending_len = len;
+    return 0;
+}
+
+/**
+ * @brief 发送一个测量值
+ *
+ * @param value 测量值
+ * @return 发送结果, 见 `telemetry_send`
+ */
+uint8_t telemetry_send_value(float value) {
+    uint8_t data[6];
+
+    data[0] = (uint8_t)telemetry_seq;
+    data[1] = (uint8_t)(telemetry_seq >> 8);
+    memcpy(&data[2], &value, sizeof(float));
+    ++telemetry_seq;
+
+    return telemetry_send(MSG_DATA_CUSTOM, data, sizeof(data));
+}
+
+/**
+ * @brief 定时输出回调, 在定时器中断中调用
+ */
+__weak void telemetry_timer_callback(void) {
+}
+
+/**
+ * @brief 定时器中断处理
+ */
+void telemetry_tim_irq(void) {
+    if (LL_TIM_IsActiveFlag_UPDATE(TELEMETRY_TIM)) {
+        LL_TIM_ClearFlag_UPDATE(TELEMETRY_TIM);
+        telemetry_timer_callback();
+    }
+}
+
+/**
+ * @brief DMA 发送完成中断处理, 有等待的帧时接着发送
+ */
+void telemetry_dma_irq(void) {
+    uint8_t len;
+
+    if (!TELEMETRY_DMA_IS_TC()) {
+        return;
+    }
+    TELEMETRY_DMA_CLEAR_TC();
+
+    len = telemetry_pending_len;
+    if (len == 0) {
+        telemetry_tx_idx = -1;
+        return;
+    }
+
+    telemetry_pending_len = 0;
+    telemetry_start(telemetry_tx_idx ^ 1, len);
+}
@@ -0,0 +1,75 @@
+/**
+ * @file    telemetry.h
+ * @brief   测量结果输出
+ *
+ *****************************************************************************
+ * 两种输出格式:
+ *  - ASCII:  主循环中用 `getFloatNum` 格式化为 "s4.0000e", 阻塞发送,
+ *            每次发送后延时 20ms, 与原来的上位机兼容
+ *  - BINARY: `msg_protocol` 帧, TIM6 按 `TELEMETRY_RATE` 定时调用
+ *            `telemetry_timer_callback`, 帧由 DMA 发送, 不占用主循环
+ *
+ * BINARY 帧格式 (未启用 CRC8, 由 `msg_frame` 组帧, 数据区转义):
+ *   | (MSG_ID << 4) | 类型 | 长度 | 数据区 | MSG_EOF |
+ * `telemetry_send_value` 的数据区为 6 字节, 小端:
+ *   | 帧序号 (uint16) | 测量值 (float) |
+ * 上位机可根据帧序号判断丢帧.
+ *
+ * 发送缓冲区为两块, 一块由 DMA 发送时另一块写入下一帧. 两块都被占用时
+ * 新的一帧覆盖还没发送的那一帧, 并计入 `telemetry_drop`.
+ *****************************************************************************
+ */
+
+#ifndef __TELEMETRY_H
+#define __TELEMETRY_H
+
+#include "main.h"
+#include "msg_frame.h"
+
+/* 输出格式. 主控的 `dt35_recv` 只解析 ASCII 帧, 默认使用 ASCII;
+ * 使用 BINARY 时接收端需要按 `msg_protocol` 解帧, 可以参考
+ * `test/telemetry_test.c` 中的解码器 */
+#define TELEMETRY_FORMAT_ASCII  0 /* 文本, 主循环阻塞发送 */
+#define TELEMETRY_FORMAT_BINARY 1 /* msg_protocol 帧, 定时器触发 DMA 发送 */
+#ifndef TELEMETRY_FORMAT
+#define TELEMETRY_FORMAT TELEMETRY_FORMAT_ASCII
+#endif /* TELEMETRY_FORMAT */
+
+/* 输出频率 (Hz). 115200 波特率下一帧一般为 9 字节 (0.78ms), 全部转义时
+ * 15 字节, 超过约 1200Hz 时会丢帧 */
+#define TELEMETRY_RATE 500
+
+/* 发送串口. USART1_TX 只能使用 DMA1 通道 4, 与 ADS8864 的 SPI2_RX 冲突,
+ * 所以使用 USART3 (PB10) 和 DMA1 通道 2 */
+#define TELEMETRY_USART          USART3
+#define TELEMETRY_DMA_CHANNEL    LL_DMA_CHANNEL_2
+#define TELEMETRY_DMA_IRQn       DMA1_Channel2_IRQn
+#define TELEMETRY_DMA_IS_TC()    LL_DMA_IsActiveFlag_TC2(DMA1)
+#define TELEMETRY_DMA_CLEAR_TC() LL_DMA_ClearFlag_TC2(DMA1)
+
+/* 定时器, 时钟为 72MHz */
+#define TELEMETRY_TIM      TIM6
+#define TELEMETRY_TIM_IRQn TIM6_DAC_IRQn
+#define TELEMETRY_TIM_CLK_ENABLE()                                             \
+    LL_APB1_GRP1_EnableClock(LL_APB1_GRP1_PERIPH_TIM6)
+
+/* 中断优先级, 两个中断必须相同, 低于 ADS8864 的 DMA 中断 */
+#define TELEMETRY_IRQ_PRIORITY 2
+
+/* 帧的消息 ID */
+#define TELEMETRY_MSG_ID MSG_ID_1
+/* 单帧最大数据长度 */
+#define TELEMETRY_MAX_DATA 16
+
+extern volatile uint32_t telemetry_drop;
+
+void telemetry_init(void);
+uint8_t telemetry_send(msg_type_t data_type, const uint8_t *data,
+                       uint8_t data_len);
+uint8_t telemetry_send_value(float value);
+
+void telemetry_timer_callback(void);
+void telemetry_tim_irq(void);
+void telemetry_dma_irq(void);
+
+#endif /* __TELEMETRY_H */
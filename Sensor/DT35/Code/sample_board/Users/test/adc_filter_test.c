@@ -0,0 +1,280 @@
+/**
+ * @file    adc_filter_test.c
+ * @brief   adc_filter 主机测试. 输入不同频率的正弦波, 测量第二级输出的幅度
+ *          (高于抽取后奈奎斯特频率的混叠到低频后测量), 与 CIC 和第二级的
+ *          理论频率响应比较; 输入满量程方波检查输出不溢出; 最后测量每个采样的
+ *          处理耗时.
+ *
+ * 在 `Sensor/DT35/Code/sample_board/Users` 下编译运行, 第二级滤波由
+ * `ADC_FILTER_STAGE2` 选择, 需要关闭输出分频才能看到每个抽取输出:
+ *
+ *   for s in 0 1 2; do
+ *     gcc -std=gnu11 -g -O2 -DADC_FILTER_STAGE2=$s -DADC_FILTER_OUTPUT_DIV=1 \
+ *         -I. test/adc_filter_test.c adc_filter.c -lm -o adc_filter_test &&
+ *     ./adc_filter_test
+ *   done
+ *
+ * 检查项:
+ *  - 直流输入的输出等于输入码值
+ *  - 各频率的幅度响应与理论值相差不超过 0.05 dB, 理论值低于 -80 dB 时
+ *    测量值也低于 -80 dB
+ *  - 0 和 65535 之间的方波输入时输出不会溢出翻转
+ */
+
+#include "adc_filter.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+#if (ADC_FILTER_OUTPUT_DIV != 1)
+#error "Build with -DADC_FILTER_OUTPUT_DIV=1."
+#endif
+
+/* 输入采样率 (Hz), 与 ADS8864 的 DMA 采样相同 */
+#define TEST_FS      66666.7
+/* 正弦波的直流偏置和幅度 (码值) */
+#define TEST_OFFSET  32768.0
+#define TEST_AMPL    30000.0
+/* 每个频率丢弃的建立时间和测量的抽取输出数 */
+#define TEST_SETTLE  256
+#define TEST_OUTPUTS 4096
+/* 耗时测试的采样数 */
+#define BENCH_SAMPLES 20000000U
+
+#if (ADC_FILTER_STAGE2 == ADC_FILTER_STAGE2_FIR)
+/* 与 adc_filter.c 中的 FIR 系数相同 */
+static const int32_t test_fir[ADC_FILTER_FIR_TAPS] = {
+    -7713034,  -8728228,  0,         45635524,  144507465,
+    279001514, 398104306, 445868554, 398104306, 279001514,
+    144507465, 45635524,  0,         -8728228,  -7713034};
+#endif /* ADC_FILTER_STAGE2 */
+
+static const char *const test_stage2_name[] = {"none", "iir", "fir"};
+
+/**
+ * @brief 理论幅度响应 (dB)
+ *
+ * @param f 输入频率, 输入采样率的倍数
+ */
+static double test_theory_db(double f) {
+    const double r = ADC_FILTER_DECIMATION;
+    /* 第二级工作在抽取后的采样率 */
+    const double w = 2 * M_PI * f * r;
+    double gain = pow(fabs(sin(M_PI * f * r) / (r * sin(M_PI * f))),
+                      ADC_FILTER_CIC_ORDER);
+
+#if (ADC_FILTER_STAGE2 == ADC_FILTER_STAGE2_IIR)
+    const double a = ADC_FILTER_IIR_ALPHA;
+
+    gain *= a / sqrt(1 - 2 * (1 - a) * cos(w) + (1 - a) * (1 - a));
+#elif (ADC_FILTER_STAGE2 == ADC_FILTER_STAGE2_FIR)
+    double re = 0, im = 0;
+
+    for (int k = 0; k < ADC_FILTER_FIR_TAPS; ++k) {
+        re += test_fir[k] / 2147483648.0 * cos(w * k);
+        im -= test_fir[k] / 2147483648.0 * sin(w * k);
+    }
+    gain *= sqrt(re * re + im * im);
+#else  /* ADC_FILTER_STAGE2 */
+    (void)w;
+#endif /* ADC_FILTER_STAGE2 */
+
+    return 20 * log10(gain);
+}
+
+/**
+ * @brief 处理一个抽取周期的输入, 返回输出
+ */
+static float test_step(adc_filter_t *filter, const uint16_t *block) {
+    uint32_t seq0, seq1;
+    float y;
+
+    adc_filter_read(filter, &seq0);
+    adc_filter_process(filter, block, ADC_FILTER_DECIMATION);
+    y = adc_filter_read(filter, &seq1);
+    CHECK(seq1 == seq0 + 1);
+
+    return y;
+}
+
+/**
+ * @brief 直流输入
+ */
+static void test_dc(void) {
+    static const uint16_t codes[] = {0, 1, 12345, 32768, 65534, 65535};
+    uint16_t block[ADC_FILTER_DECIMATION];
+    adc_filter_t filter;
+
+    for (uint32_t c = 0; c < sizeof(codes) / sizeof(codes[0]); ++c) {
+        float y = 0;
+
+        for (uint32_t i = 0; i < ADC_FILTER_DECIMATION; ++i) {
+            block[i] = codes[c];
+        }
+        adc_filter_init(&filter);
+        for (uint32_t n = 0; n < 2000; ++n) {
+            y = test_step(&filter, block);
+        }
+        CHECK(fabsf(y - codes[c]) < 0.01f);
+    }
+}
+
+/**
+ * @brief 测量一个频率的幅度响应
+ *
+ * @param f 输入频率, 输入采样率的倍数
+ * @return 幅度响应 (dB)
+ */
+static double test_response(double f) {
+    uint16_t block[ADC_FILTER_DECIMATION];
+    double fa, re = 0, im = 0, mean = 0;
+    static float y[TEST_OUTPUTS];
+    adc_filter_t filter;
+    uint64_t n = 0;
+
+    /* 抽取后混叠到的频率, 抽取后采样率的倍数 */
+    fa = f * ADC_FILTER_DECIMATION;
+    fa -= floor(fa + 0.5);
+
+    adc_filter_init(&filter);
+    for (uint32_t k = 0; k < TEST_SETTLE + TEST_OUTPUTS; ++k) {
+        for (uint32_t i = 0; i < ADC_FILTER_DECIMATION; ++i, ++n) {
+            block[i] = (uint16_t)lrint(TEST_OFFSET +
+                                       TEST_AMPL * sin(2 * M_PI * f * n));
+        }
+        float out = test_step(&filter, block);
+        if (k >= TEST_SETTLE) {
+            y[k - TEST_SETTLE] = out;
+            mean += out;
+        }
+    }
+
+    /* 去掉直流后在混叠频率上做 DFT, 汉宁窗抑制频谱泄漏 */
+    mean /= TEST_OUTPUTS;
+    for (uint32_t k = 0; k < TEST_OUTPUTS; ++k) {
+        double win = 1 - cos(2 * M_PI * k / TEST_OUTPUTS);
+
+        re += (y[k] - mean) * win * cos(2 * M_PI * fa * k);
+        im += (y[k] - mean) * win * sin(2 * M_PI * fa * k);
+    }
+
+    return 20 * log10(2 * sqrt(re * re + im * im) / TEST_OUTPUTS / TEST_AMPL);
+}
+
+static void test_freq(void) {
+    /* 输入频率, 抽取后采样率的倍数. 0.5 以上混叠到低频, 整数倍附近
+       是 CIC 的零点. 不能混叠到 0.5, 那里的幅度与相位有关 */
+    static const double freqs[] = {0.002, 0.01, 0.03, 0.05, 0.1,  0.15,
+                                   0.2,   0.3,  0.45, 0.62, 0.81, 0.97,
+                                   1.03,  1.45, 1.98, 2.03, 4.1,  7.7,
+                                   11.3,  15.4};
+
+    printf("%6s %10s %9s %9s\n", "f/fd", "Hz", "measured", "theory");
+    for (uint32_t i = 0; i < sizeof(freqs) / sizeof(freqs[0]); ++i) {
+        double f = freqs[i] / ADC_FILTER_DECIMATION;
+        double db = test_response(f), theory = test_theory_db(f);
+
+        printf("%6.3f %10.1f %7.2f dB %6.2f dB\n", freqs[i], f * TEST_FS, db,
+               theory);
+        if (theory > -80) {
+            CHECK(fabs(db - theory) < 0.05);
+        } else {
+            CHECK(db < -80);
+        }
+    }
+}
+
+/**
+ * @brief 0 和 65535 之间的方波, 每半个周期 n 个抽取输出
+ */
+static void test_full_scale(void) {
+    uint16_t block[ADC_FILTER_DECIMATION];
+    float lo = 0, hi = 0;
+    adc_filter_t filter;
+
+    for (uint32_t half = 1; half <= 40; ++half) {
+        adc_filter_init(&filter);
+        for (uint32_t k = 0; k < 40 * half; ++k) {
+            uint16_t code = ((k / half) & 1) ? 0 : 65535;
+
+            for (uint32_t i = 0; i < ADC_FILTER_DECIMATION; ++i) {
+                block[i] = code;
+            }
+            float y = test_step(&filter, block);
+            lo = (y < lo) ? y : lo;
+            hi = (y > hi) ? y : hi;
+        }
+    }
+    /* FIR 的负系数使阶跃响应有约 1.4% 的过冲 */
+    CHECK(lo > -0.02f * 65536 && hi <= 65536);
+    printf("full scale square: output %.1f .. %.1f\n", lo, hi);
+}
+
+static void test_bench(void) {
+    static uint16_t data[4096];
+    adc_filter_t filter;
+    double best = 0;
+    uint32_t seq;
+    float sink = 0;
+
+    for (uint32_t i = 0; i < 4096; ++i) {
+        data[i] = (uint16_t)(32768 + 30000 * sin(i * 0.01));
+    }
+
+    for (int round = 0; round < 5; ++round) {
+        struct timespec t0, t1;
+        double ns;
+
+        adc_filter_init(&filter);
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (uint32_t n = 0; n < BENCH_SAMPLES; n += 32) {
+            adc_filter_process(&filter, &data[n & 4095], 32);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        sink += adc_filter_read(&filter, &seq);
+
+        ns = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) /
+             BENCH_SAMPLES;
+        if (round == 0 || ns < best) {
+            best = ns;
+        }
+    }
+
+    /* 每个输入采样 CIC 阶数次加法, 每个抽取输出 CIC 阶数次减法和第二级 */
+    printf("bench: %.2f ns/sample on host (%.3f%% of one core at %.1f kHz); "
+           "per sample %d integrator adds, per output %d comb subs",
+           best, best * TEST_FS / 1e7, TEST_FS / 1000, ADC_FILTER_CIC_ORDER,
+           ADC_FILTER_CIC_ORDER);
+#if (ADC_FILTER_STAGE2 == ADC_FILTER_STAGE2_IIR)
+    printf(" + 1 multiply\n");
+#elif (ADC_FILTER_STAGE2 == ADC_FILTER_STAGE2_FIR)
+    printf(" + %d multiply-accumulates\n", ADC_FILTER_FIR_TAPS);
+#else  /* ADC_FILTER_STAGE2 */
+    printf("\n");
+#endif /* ADC_FILTER_STAGE2 */
+    CHECK(sink == sink);
+}
+
+int main(void) {
+    printf("stage2 %s, CIC order %d, decimation %lu\n",
+           test_stage2_name[ADC_FILTER_STAGE2], ADC_FILTER_CIC_ORDER,
+           (unsigned long)ADC_FILTER_DECIMATION);
+
+    test_dc();
+    test_freq();
+    test_full_scale();
+    test_bench();
+
+    printf("adc_filter: all tests passed\n");
+    return 0;
+}
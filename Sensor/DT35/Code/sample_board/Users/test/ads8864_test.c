@@ -0,0 +1,363 @@
+/**
+ * @file    ads8864_test.c
+ * @brief   ads8864 DMA 采样的主机测试. 按 `ADS8864_DMA_Init` 写入的配置模拟
+ *          TIM15, SPI2 和 DMA1 通道 4/5: 每个定时器周期开始时 CONVST 拉高并
+ *          采样, CH1 比较事件让通道 5 写 SPI2->DR, 16 个时钟后通道 4 把结果
+ *          写入乒乓缓冲区, 半满和全满时按随机的中断延迟调用 `ADS8864_DMA_IRQ`.
+ *          最后统计采样率, 中断次数和 CPU 占用, 与转换完成中断方式比较.
+ *
+ * 在 `Sensor/DT35/Code/sample_board/Users` 下编译运行:
+ *
+ *   gcc -std=gnu11 -g -O2 -Itest/stub -I. test/ads8864_test.c ads8864.c \
+ *       -o ads8864_test
+ *   ./ads8864_test
+ *
+ * 检查项:
+ *  - CONVST 高电平不短于最大转换时间, 读取在 CONVST 拉低之后开始, 在下一次
+ *    CONVST 之前结束, 采集时间不短于数据手册的最小值
+ *  - SPI2 为 16 位全双工, DMA 通道的方向, 地址, 位宽, 循环模式和中断正确
+ *  - 中断延迟小于一块的时间时, 每块回调收到的数据与按顺序输入的采样完全相同,
+ *    两块交替, `adc_rawdata` 与回调的数据相同, 不丢块也不重复
+ */
+
+#include "ads8864.h"
+#include "stm32f3xx_ll_spi.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+/* TIM15 和 CPU 的时钟 (Hz) */
+#define TEST_TIM_HZ   72000000U
+/* ADS8864 数据手册: 转换时间最大 1300 ns, 采集时间最少 1200 ns */
+#define TEST_TCONV_NS 1300U
+#define TEST_TACQ_NS  1200U
+/* 模拟的采样数, 约 3 s */
+#define TEST_SAMPLES  200000U
+/* 中断耗时测试的块数 */
+#define BENCH_BLOCKS  2000000U
+
+test_dma_ch_t test_dma[8];
+TIM_TypeDef test_tim6;
+TIM_TypeDef test_tim15;
+SPI_TypeDef test_spi2;
+int test_nvic_en[64];
+uint32_t test_exti_it = LL_EXTI_LINE_2;
+uint32_t test_exti_falling = LL_EXTI_LINE_2;
+uint32_t test_exti_flag;
+SPI_HandleTypeDef hspi2;
+
+extern int adc_rawdata[ADC_SAMPLE_SIZE];
+extern uint16_t adc_counter;
+
+int HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *data, uint16_t size,
+                    uint32_t timeout) {
+    (void)hspi;
+    (void)data;
+    (void)size;
+    (void)timeout;
+    return HAL_OK;
+}
+
+static uint32_t test_seed = 1;
+
+static uint32_t test_rand(void) {
+    test_seed = test_seed * 1103515245U + 12345U;
+    return test_seed >> 8;
+}
+
+/**
+ * @brief 第 k 次采样的转换结果
+ */
+static uint16_t test_input(uint32_t k) {
+    return (uint16_t)(k * 40503U + 12345U);
+}
+
+static double test_ns(uint64_t ticks) {
+    return (double)ticks * 1e9 / TEST_TIM_HZ;
+}
+
+/* 当前时刻 (TIM15 计数) */
+static uint64_t test_now;
+/* 各通道剩余的传输数 (CNDTR) */
+static uint32_t test_remain[8];
+/* 等待执行的 DMA 中断和执行时刻 */
+static int test_isr_pending;
+static uint64_t test_isr_due;
+/* 中断延迟的上限 (TIM15 计数), 0 为没有延迟 */
+static uint32_t test_isr_delay;
+/* 回调中期望的下一个采样序号, 上一块的地址, 收到的块数 */
+static uint32_t test_next;
+static const uint16_t *test_last_block;
+static uint32_t test_blocks;
+static int test_bench;
+
+void ADS8864_BlockCallback(const uint16_t *block, uint16_t len) {
+    if (test_bench) {
+        return;
+    }
+
+    CHECK(len == ADS8864_DMA_BLOCK);
+    CHECK(block != test_last_block);
+    for (uint16_t i = 0; i < len; ++i) {
+        CHECK(block[i] == test_input(test_next + i));
+        CHECK(adc_rawdata[(adc_counter + ADC_SAMPLE_SIZE - len + i) %
+                          ADC_SAMPLE_SIZE] == block[i]);
+    }
+    test_last_block = block;
+    test_next += len;
+    test_blocks++;
+}
+
+/**
+ * @brief 执行到期的 DMA 中断
+ *
+ * @param t 当前时刻
+ */
+static void test_run_isr(uint64_t t) {
+    if (!test_isr_pending || test_isr_due > t) {
+        return;
+    }
+
+    test_isr_pending = 0;
+    ADS8864_DMA_IRQ();
+    CHECK(!test_dma[4].ht && !test_dma[4].tc && !test_dma[4].te);
+}
+
+/**
+ * @brief DMA 通道响应一次请求
+ *
+ * @param ch 通道
+ * @return 本次传输的内存地址, 通道没有使能或已经传输完成时为 NULL
+ */
+static uint16_t *test_dma_transfer(uint32_t ch) {
+    test_dma_ch_t *dma = &test_dma[ch];
+    uint32_t idx = 0;
+
+    if (!dma->en || test_remain[ch] == 0) {
+        return NULL;
+    }
+    if (dma->config & LL_DMA_MEMORY_INCREMENT) {
+        idx = dma->len - test_remain[ch];
+    }
+
+    test_remain[ch]--;
+    if (test_remain[ch] == dma->len / 2) {
+        dma->ht = 1;
+    }
+    if (test_remain[ch] == 0) {
+        dma->tc = 1;
+        if (dma->config & LL_DMA_MODE_CIRCULAR) {
+            test_remain[ch] = dma->len;
+        }
+    }
+
+    if (ch == 4 && test_nvic_en[DMA1_Channel4_IRQn] &&
+        ((dma->ht && (dma->it & TEST_DMA_IT_HT)) ||
+         (dma->tc && (dma->it & TEST_DMA_IT_TC))) &&
+        !test_isr_pending) {
+        test_isr_pending = 1;
+        test_isr_due = test_now;
+        if (test_isr_delay != 0) {
+            test_isr_due += test_rand() % test_isr_delay;
+        }
+    }
+
+    return (uint16_t *)test_dma_ptr(dma->mem) + idx;
+}
+
+/**
+ * @brief 检查初始化写入的配置和时序
+ */
+static void test_config(void) {
+    const uint32_t dir_mask = LL_DMA_DIRECTION_MEMORY_TO_PERIPH;
+    const uint32_t size_mask = LL_DMA_PDATAALIGN_WORD |
+                               LL_DMA_PDATAALIGN_HALFWORD |
+                               LL_DMA_MDATAALIGN_WORD |
+                               LL_DMA_MDATAALIGN_HALFWORD;
+    const uint32_t inc_mask = LL_DMA_PERIPH_INCREMENT | LL_DMA_MEMORY_INCREMENT;
+    const uint32_t prio_mask = LL_DMA_PRIORITY_VERYHIGH;
+    const uint32_t halfword =
+        LL_DMA_PDATAALIGN_HALFWORD | LL_DMA_MDATAALIGN_HALFWORD;
+    const uint32_t spi_dr = LL_SPI_DMA_GetRegAddr(SPI2);
+    uint32_t period = TIM15->ARR + 1;
+
+    /* 不再使用转换完成中断 */
+    CHECK((test_exti_it & LL_EXTI_LINE_2) == 0);
+
+    /* CH2 为 PWM1 模式 (CubeMX 配置), 计数值小于 CCR2 时 CONVST 为高 */
+    CHECK(TIM15->en && TIM15->cc1_dma);
+    CHECK(TIM15->oc1_mode == LL_TIM_OCMODE_FROZEN);
+    CHECK(test_ns(TIM15->CCR2) >= TEST_TCONV_NS);
+    CHECK(TIM15->CCR1 > TIM15->CCR2);
+    CHECK(TIM15->CCR1 + ADS8864_SPI_TICKS < period);
+    CHECK(test_ns(period) - TEST_TCONV_NS >= TEST_TACQ_NS);
+
+    CHECK(SPI2->en && SPI2->rx_dma);
+    CHECK(SPI2->dir == LL_SPI_FULL_DUPLEX);
+    CHECK(SPI2->width == LL_SPI_DATAWIDTH_16BIT);
+    CHECK(SPI2->rx_fifo_th == LL_SPI_RX_FIFO_TH_HALF);
+
+    /* 通道 4: SPI2->DR -> 两块的乒乓缓冲区, 半满和全满中断 */
+    CHECK(test_dma[4].en);
+    CHECK((test_dma[4].config & dir_mask) == LL_DMA_DIRECTION_PERIPH_TO_MEMORY);
+    CHECK((test_dma[4].config & size_mask) == halfword);
+    CHECK((test_dma[4].config & inc_mask) == LL_DMA_MEMORY_INCREMENT);
+    CHECK(test_dma[4].config & LL_DMA_MODE_CIRCULAR);
+    CHECK(test_dma[4].periph == spi_dr);
+    CHECK(test_dma[4].len == 2 * ADS8864_DMA_BLOCK);
+    CHECK((test_dma[4].it & (TEST_DMA_IT_HT | TEST_DMA_IT_TC)) ==
+          (TEST_DMA_IT_HT | TEST_DMA_IT_TC));
+    CHECK(test_nvic_en[DMA1_Channel4_IRQn]);
+
+    /* 通道 5: 每个周期向 SPI2->DR 写一个数据 */
+    CHECK(test_dma[5].en);
+    CHECK((test_dma[5].config & dir_mask) == LL_DMA_DIRECTION_MEMORY_TO_PERIPH);
+    CHECK((test_dma[5].config & size_mask) == halfword);
+    CHECK((test_dma[5].config & inc_mask) == 0);
+    CHECK(test_dma[5].config & LL_DMA_MODE_CIRCULAR);
+    CHECK(test_dma[5].periph == spi_dr);
+    CHECK(test_dma[5].len >= 1);
+
+    /* 读出的结果不能被下一次写 DR 挤掉 */
+    CHECK((test_dma[4].config & prio_mask) >= (test_dma[5].config & prio_mask));
+}
+
+/**
+ * @brief 模拟一个定时器周期
+ *
+ * @param k 采样序号
+ */
+static void test_period(uint32_t k) {
+    const uint64_t t0 = test_now;
+    const uint64_t t_read = t0 + TIM15->CCR1;
+    const uint64_t t_done = t_read + ADS8864_SPI_TICKS;
+    uint16_t *p;
+
+    /* CONVST 上升沿采样, CCR2 之后拉低, 转换结果可以读出 */
+    test_now = t_read;
+    test_run_isr(test_now);
+    p = test_dma_transfer(5);
+    CHECK(p != NULL);
+    SPI2->DR = *p;
+
+    /* 16 个时钟后收到结果, 请求通道 4 */
+    test_now = t_done;
+    test_run_isr(test_now);
+    SPI2->DR = test_input(k);
+    p = test_dma_transfer(4);
+    CHECK(p != NULL);
+    *p = SPI2->DR;
+
+    test_now = t0 + TIM15->ARR + 1;
+}
+
+/**
+ * @brief 连续采样
+ *
+ * @param delay 中断延迟的上限 (TIM15 计数)
+ */
+static void test_run(uint32_t delay) {
+    ads8864_Init();
+    test_config();
+    for (uint32_t ch = 0; ch < 8; ++ch) {
+        test_remain[ch] = test_dma[ch].len;
+    }
+
+    test_isr_delay = delay;
+    test_isr_pending = 0;
+    test_now = 0;
+    test_next = 0;
+    test_blocks = 0;
+    test_last_block = NULL;
+    adc_block_count = 0;
+
+    for (uint32_t k = 0; k < TEST_SAMPLES; ++k) {
+        test_period(k);
+    }
+    test_run_isr(UINT64_MAX);
+
+    CHECK(test_blocks == TEST_SAMPLES / ADS8864_DMA_BLOCK);
+    CHECK(adc_block_count == test_blocks);
+    CHECK(test_next == test_blocks * ADS8864_DMA_BLOCK);
+}
+
+/**
+ * @brief 每块中断的主机耗时 (ns)
+ */
+static double test_bench_isr(void) {
+    double best = 0;
+
+    test_bench = 1;
+    for (int round = 0; round < 5; ++round) {
+        struct timespec t0, t1;
+        double ns;
+
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        for (uint32_t i = 0; i < BENCH_BLOCKS; ++i) {
+            if (i & 1) {
+                test_dma[4].tc = 1;
+            } else {
+                test_dma[4].ht = 1;
+            }
+            ADS8864_DMA_IRQ();
+        }
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+
+        ns = ((t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec)) /
+             BENCH_BLOCKS;
+        if (round == 0 || ns < best) {
+            best = ns;
+        }
+    }
+    test_bench = 0;
+
+    return best;
+}
+
+int main(void) {
+    const uint32_t period = ADS8864_SAMPLE_PERIOD;
+    const uint32_t block = ADS8864_DMA_BLOCK * period;
+    const double rate = (double)TEST_TIM_HZ / period;
+    double isr_ns;
+
+    test_run(0);
+    printf("timing: period %u ticks = %.2f us (%.1f Hz), CONVST high %.2f us "
+           "(tconv max %.2f us), read %.2f..%.2f us, acquisition %.2f us "
+           "(min %.2f us)\n",
+           (unsigned)period, test_ns(period) / 1000, rate,
+           test_ns(TIM15->CCR2) / 1000, TEST_TCONV_NS / 1000.0,
+           test_ns(TIM15->CCR1) / 1000,
+           test_ns(TIM15->CCR1 + ADS8864_SPI_TICKS) / 1000,
+           (test_ns(period) - TEST_TCONV_NS) / 1000, TEST_TACQ_NS / 1000.0);
+    printf("no isr delay: %u samples, %u blocks\n", (unsigned)TEST_SAMPLES,
+           (unsigned)test_blocks);
+
+    /* 回调必须在 DMA 写回同一块之前返回, 留一个采样的余量 */
+    test_run(block - period);
+    printf("isr delay up to %.1f us (block %.1f us): %u blocks\n",
+           test_ns(block - period) / 1000, test_ns(block) / 1000,
+           (unsigned)test_blocks);
+
+    isr_ns = test_bench_isr();
+
+    /* 转换完成中断方式每个采样进一次中断, 在中断中阻塞等待 SPI 读完
+       16 位, 只算等待的时间就至少是 ADS8864_SPI_TICKS 个周期 */
+    printf("exti mode: %.1f interrupts/s, SPI wait >= %u cycles/sample, "
+           ">= %.1f%% CPU\n",
+           rate, (unsigned)ADS8864_SPI_TICKS,
+           100.0 * ADS8864_SPI_TICKS / period);
+    printf("dma mode:  %.1f interrupts/s, host %.1f ns per block interrupt\n",
+           rate / ADS8864_DMA_BLOCK, isr_ns);
+
+    printf("ads8864: all tests passed\n");
+    return 0;
+}
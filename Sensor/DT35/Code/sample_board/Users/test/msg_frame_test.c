@@ -0,0 +1,317 @@
+/**
+ * @file    msg_frame_test.c
+ * @brief   msg_frame 主机测试. 随机数据 (偏向结束符和转义字节) 分成随机的
+ *          数据段组帧, 检查长度计算, 再经过 `msg_protocol` 的接收端
+ *          (串口按随机长度分段读到) 解帧, 检查回调收到的数据; 然后测试组帧
+ *          的吞吐量.
+ *
+ * 在 `Sensor/DT35/Code/sample_board/Users` 下编译运行:
+ *
+ *   gcc -std=gnu11 -g -O2 -Itest/stub -I. test/msg_frame_test.c msg_frame.c \
+ *       msg_protocol.c -o msg_frame_test
+ *   ./msg_frame_test
+ *
+ * 检查项:
+ *  - 帧长度等于 `message_frame_size`, 不超过 `MSG_FRAME_MAX_SIZE`, 且
+ *    数据全部需要转义时正好等于 `MSG_FRAME_MAX_SIZE`
+ *  - 缓冲区正好放得下时成功, 少一个字节时返回 0 且不越界 (配合
+ *    -fsanitize=address)
+ *  - 数据分段与否组出的帧相同
+ *  - 长度不超过 `MSG_MAX_DATA_LEN` 的帧都能被接收端完整解出
+ */
+
+#include "msg_protocol.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+/* 随机测试的帧数 */
+#define TEST_FRAMES      200000
+/* 接收端的串口缓冲区和队列大小 */
+#define TEST_RECV_BUF    256
+#define TEST_RECV_FIFO   1024
+/* 吞吐量测试的数据量 (byte) */
+#define BENCH_BYTES      (256U * 1024 * 1024)
+
+uint32_t SystemCoreClock = 72000000;
+
+static uint32_t test_rand_state = 1;
+
+static uint32_t test_rand(void) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return test_rand_state >> 16;
+}
+
+/* 模拟的串口线路: 发送端写入, 接收端按随机长度读出 */
+static uint8_t test_wire[4096];
+static uint32_t test_wire_len;
+static uint32_t test_wire_pos;
+
+int HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size,
+                      uint32_t timeout) {
+    (void)huart;
+    (void)timeout;
+    CHECK(test_wire_len + size <= sizeof(test_wire));
+    memcpy(&test_wire[test_wire_len], data, size);
+    test_wire_len += size;
+    return 0;
+}
+
+uint32_t uart_dmatx_write(UART_HandleTypeDef *huart, const void *data,
+                          uint32_t len) {
+    return (uint32_t)HAL_UART_Transmit(huart, (uint8_t *)data, (uint16_t)len, 0);
+}
+
+uint32_t uart_dmatx_send(UART_HandleTypeDef *huart) {
+    (void)huart;
+    return 0;
+}
+
+uint32_t uart_dmarx_read(UART_HandleTypeDef *huart, void *buf, uint32_t len) {
+    uint32_t n = test_wire_len - test_wire_pos;
+
+    (void)huart;
+    if (n > len) {
+        n = len;
+    }
+    if (n > 1) {
+        n = test_rand() % n + 1;
+    }
+    memcpy(buf, &test_wire[test_wire_pos], n);
+    test_wire_pos += n;
+    return n;
+}
+
+/* 接收回调收到的数据 */
+static uint8_t test_recv_data[MSG_MAX_DATA_LEN];
+static uint32_t test_recv_len;
+static uint8_t test_recv_id_type;
+static uint32_t test_recv_count;
+
+static void test_recv_callback(uint32_t msg_length, uint8_t msg_id_type,
+                               uint8_t *msg_data) {
+    CHECK(msg_length <= MSG_MAX_DATA_LEN);
+    memcpy(test_recv_data, msg_data, msg_length);
+    test_recv_len = msg_length;
+    test_recv_id_type = msg_id_type;
+    test_recv_count++;
+}
+
+/**
+ * @brief 随机数据, 约一半是结束符或转义字节
+ */
+static void test_fill(uint8_t *data, uint32_t len) {
+    for (uint32_t i = 0; i < len; ++i) {
+        uint32_t r = test_rand();
+
+        data[i] = (r & 1) ? ((r & 2) ? MSG_EOF : MSG_ESC) : (uint8_t)(r >> 8);
+    }
+}
+
+/**
+ * @brief 参数和缓冲区大小的边界
+ */
+static void test_limits(void) {
+    static uint8_t data[MSG_MAX_DATA_LEN + 1];
+    static uint8_t buf[MSG_FRAME_MAX_SIZE(MSG_MAX_DATA_LEN + 1)];
+    msg_segment_t seg = {data, 0};
+    uint32_t size, len;
+    uint8_t *exact;
+
+    memset(data, MSG_ESC, sizeof(data));
+
+    /* 数据全部需要转义, 长度为 0x7F 时长度字节也需要转义 */
+    seg.len = MSG_EOF;
+    CHECK(message_encode(MSG_ID_1, MSG_DATA_CUSTOM, &seg, 1, buf,
+                         sizeof(buf)) == MSG_FRAME_MAX_SIZE(MSG_EOF));
+    CHECK(message_frame_size(MSG_ID_1, MSG_DATA_CUSTOM, &seg, 1) ==
+          MSG_FRAME_MAX_SIZE(MSG_EOF));
+
+    seg.len = MSG_MAX_DATA_LEN;
+    CHECK(message_encode(MSG_ID_1, MSG_DATA_CUSTOM, &seg, 1, buf,
+                         sizeof(buf)) != 0);
+    seg.len = MSG_MAX_DATA_LEN + 1;
+    CHECK(message_encode(MSG_ID_1, MSG_DATA_CUSTOM, &seg, 1, buf,
+                         sizeof(buf)) == 0);
+    seg.len = 0;
+    CHECK(message_encode(MSG_ID_1, MSG_DATA_CUSTOM, &seg, 1, buf,
+                         sizeof(buf)) == 0);
+    seg.len = 1;
+    CHECK(message_encode(MSG_ID_RESERVE_LEN, MSG_DATA_CUSTOM, &seg, 1, buf,
+                         sizeof(buf)) == 0);
+    CHECK(message_encode(MSG_ID_1, (msg_type_t)0x0F, &seg, 1, buf,
+                         sizeof(buf)) == 0);
+
+    /* 缓冲区正好放得下 / 少一个字节, 放在堆上让越界写被 ASan 发现 */
+    for (uint32_t i = 0; i < 1000; ++i) {
+        seg.len = test_rand() % MSG_MAX_DATA_LEN + 1;
+        test_fill(data, seg.len);
+        size = message_frame_size(MSG_ID_2, MSG_DATA_UINT8, &seg, 1);
+
+        exact = malloc(size);
+        CHECK(exact != NULL);
+        len = message_encode(MSG_ID_2, MSG_DATA_UINT8, &seg, 1, exact, size);
+        CHECK(len == size);
+        free(exact);
+
+        exact = malloc(size - 1);
+        CHECK(exact != NULL);
+        CHECK(message_encode(MSG_ID_2, MSG_DATA_UINT8, &seg, 1, exact,
+                             size - 1) == 0);
+        free(exact);
+    }
+    printf("limits: ok\n");
+}
+
+/**
+ * @brief 随机组帧, 经过接收端解帧
+ */
+static void test_round_trip(void) {
+    static uint8_t data[MSG_MAX_DATA_LEN];
+    static uint8_t whole[MSG_FRAME_MAX_SIZE(MSG_MAX_DATA_LEN)];
+    static uint8_t split[MSG_FRAME_MAX_SIZE(MSG_MAX_DATA_LEN)];
+    UART_HandleTypeDef uart = {1, &uart};
+    msg_segment_t seg[4];
+    uint64_t bytes = 0;
+
+    message_register_send_uart(MSG_ID_3, &uart,
+                               MSG_FRAME_MAX_SIZE(MSG_MAX_DATA_LEN));
+    message_register_polling_uart(MSG_ID_3, &uart, TEST_RECV_BUF,
+                                  TEST_RECV_FIFO);
+    message_register_recv_callback(MSG_ID_3, test_recv_callback);
+
+    for (uint32_t f = 0; f < TEST_FRAMES; ++f) {
+        /* 长度偏向两端 */
+        uint32_t len = (f % 4 == 0) ? MSG_MAX_DATA_LEN - test_rand() % 8
+                                    : test_rand() % MSG_MAX_DATA_LEN + 1;
+        msg_type_t type = (msg_type_t)(test_rand() % 0x0F);
+        uint32_t seg_num = test_rand() % 4 + 1;
+        uint32_t whole_len, split_len, pos = 0;
+        msg_segment_t one = {data, len};
+
+        test_fill(data, len);
+
+        /* 随机切成若干段, 可以有空段 */
+        for (uint32_t i = 0; i < seg_num; ++i) {
+            uint32_t n = (i == seg_num - 1) ? len - pos
+                                            : test_rand() % (len - pos + 1);
+
+            seg[i].data = &data[pos];
+            seg[i].len = n;
+            pos += n;
+        }
+
+        whole_len = message_encode(MSG_ID_3, type, &one, 1, whole,
+                                   sizeof(whole));
+        split_len = message_encode(MSG_ID_3, type, seg, seg_num, split,
+                                   sizeof(split));
+        CHECK(whole_len != 0 && whole_len == split_len);
+        CHECK(memcmp(whole, split, whole_len) == 0);
+        CHECK(whole_len == message_frame_size(MSG_ID_3, type, seg, seg_num));
+        CHECK(whole_len <= MSG_FRAME_MAX_SIZE(len));
+
+        /* 经过发送接口和接收端 */
+        test_wire_len = test_wire_pos = 0;
+        test_recv_count = 0;
+        message_send_data(MSG_ID_3, type, data, len);
+        CHECK(test_wire_len == whole_len);
+        CHECK(memcmp(test_wire, whole, whole_len) == 0);
+        while (test_wire_pos < test_wire_len) {
+            message_polling_data();
+        }
+        message_polling_data();
+
+        CHECK(test_recv_count == 1);
+        CHECK(test_recv_id_type == (uint8_t)((MSG_ID_3 << 4) | type));
+        CHECK(test_recv_len == len);
+        CHECK(memcmp(test_recv_data, data, len) == 0);
+        bytes += len;
+    }
+    printf("round trip: %u frames, %llu bytes\n", TEST_FRAMES,
+           (unsigned long long)bytes);
+}
+
+static double test_now(void) {
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief 逐字节组帧, 与原来 telemetry.c 中的做法相同, 作为对比
+ */
+static uint32_t test_encode_bytewise(uint8_t *buf, uint8_t id_type,
+                                     const uint8_t *data, uint8_t data_len) {
+    uint32_t len = 0;
+
+    buf[len++] = id_type;
+    buf[len++] = data_len;
+    for (uint8_t i = 0; i < data_len; ++i) {
+        if (data[i] == MSG_EOF || data[i] == MSG_ESC) {
+            buf[len++] = MSG_ESC;
+        }
+        buf[len++] = data[i];
+    }
+    buf[len++] = MSG_EOF;
+    return len;
+}
+
+/**
+ * @brief 组帧吞吐量, 数据为随机字节 (约 1/128 需要转义)
+ *
+ * @param len 每帧数据长度
+ */
+static void test_bench(uint32_t len) {
+    static uint8_t data[MSG_MAX_DATA_LEN];
+    static uint8_t buf[MSG_FRAME_MAX_SIZE(MSG_MAX_DATA_LEN)];
+    uint32_t frames = BENCH_BYTES / len;
+    msg_segment_t seg = {data, len};
+    volatile uint32_t sink = 0;
+    double t, t_bytewise, t_encode;
+
+    for (uint32_t i = 0; i < len; ++i) {
+        data[i] = (uint8_t)test_rand();
+    }
+
+    t = test_now();
+    for (uint32_t i = 0; i < frames; ++i) {
+        data[0] = (uint8_t)i;
+        sink += test_encode_bytewise(buf, MSG_DATA_CUSTOM, data, (uint8_t)len);
+    }
+    t_bytewise = test_now() - t;
+
+    t = test_now();
+    for (uint32_t i = 0; i < frames; ++i) {
+        data[0] = (uint8_t)i;
+        sink += message_encode(MSG_ID_1, MSG_DATA_CUSTOM, &seg, 1, buf,
+                               sizeof(buf));
+    }
+    t_encode = test_now() - t;
+
+    printf("bench %3u byte: bytewise %7.1f MB/s %6.1f ns/frame, "
+           "message_encode %7.1f MB/s %6.1f ns/frame\n",
+           len, BENCH_BYTES / t_bytewise / 1e6, t_bytewise * 1e9 / frames,
+           BENCH_BYTES / t_encode / 1e6, t_encode * 1e9 / frames);
+    (void)sink;
+}
+
+int main(void) {
+    test_limits();
+    test_round_trip();
+    test_bench(6);
+    test_bench(64);
+    test_bench(MSG_MAX_DATA_LEN);
+    printf("msg_frame: all tests passed\n");
+    return 0;
+}
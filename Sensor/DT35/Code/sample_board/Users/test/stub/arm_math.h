@@ -0,0 +1,22 @@
+/**
+ * @file    arm_math.h
+ * @brief   主机测试用的 CMSIS-DSP 替身, 只包含用到的函数
+ */
+
+#ifndef __ARM_MATH_H
+#define __ARM_MATH_H
+
+#include <stdint.h>
+
+typedef int32_t q31_t;
+
+static inline void arm_mean_q31(const q31_t *src, uint32_t len, q31_t *result) {
+    int64_t sum = 0;
+
+    for (uint32_t i = 0; i < len; ++i) {
+        sum += src[i];
+    }
+    *result = (q31_t)(sum / (int64_t)len);
+}
+
+#endif /* __ARM_MATH_H */
@@ -0,0 +1,11 @@
+/**
+ * @file    gpio.h
+ * @brief   主机测试用的 gpio.h 替身, 引脚在 main.h 替身中定义
+ */
+
+#ifndef __GPIO_H
+#define __GPIO_H
+
+#include "main.h"
+
+#endif /* __GPIO_H */
@@ -0,0 +1,161 @@
+/**
+ * @file    main.h
+ * @brief   主机测试用的 main.h 替身. DMA, 定时器, SPI 和 EXTI 的寄存器操作
+ *          改为读写测试中的变量, 由测试按时间模拟外设
+ */
+
+#ifndef __MAIN_H
+#define __MAIN_H
+
+#include "stm32f3xx_hal.h"
+
+/* 模拟的 DMA 通道, 下标为通道号 */
+typedef struct {
+    uint32_t config; /* LL_DMA_ConfigTransfer 的参数 */
+    uint32_t periph; /* 外设地址 */
+    uint32_t mem;    /* 内存地址 */
+    uint32_t len;    /* 数据长度 */
+    uint32_t it;     /* 打开的中断, TEST_DMA_IT_* */
+    int en;
+    int ht, tc, te; /* 半传输, 传输完成, 传输错误标志 */
+} test_dma_ch_t;
+
+#define TEST_DMA_IT_HT 1U
+#define TEST_DMA_IT_TC 2U
+#define TEST_DMA_IT_TE 4U
+
+extern test_dma_ch_t test_dma[8];
+
+/**
+ * @brief 把 DMA 地址寄存器中的 32 位地址还原成主机指针
+ *
+ * @param addr 地址寄存器的值
+ * @return 指针
+ * @note 被测代码把静态变量的地址截断为 32 位, 高 32 位与 `test_dma` 相同,
+ *       因此不需要 -no-pie
+ */
+static inline void *test_dma_ptr(uint32_t addr) {
+    return (void *)(((uintptr_t)test_dma & ~(uintptr_t)0xFFFFFFFFU) | addr);
+}
+
+/* 模拟的定时器, 只有用到的寄存器 */
+typedef struct {
+    uint32_t CNT;
+    uint32_t PSC;
+    uint32_t ARR;
+    uint32_t CCR1;
+    uint32_t CCR2;
+    uint32_t oc1_mode; /* CH1 输出模式 */
+    int cc1_dma;       /* CH1 比较事件请求 DMA */
+    int en;
+} TIM_TypeDef;
+
+extern TIM_TypeDef test_tim6;
+extern TIM_TypeDef test_tim15;
+
+/* NVIC, 下标为中断号 */
+extern int test_nvic_en[64];
+
+/* EXTI: 打开的中断, 下降沿触发, 中断标志 */
+extern uint32_t test_exti_it;
+extern uint32_t test_exti_falling;
+extern uint32_t test_exti_flag;
+
+#define DMA1               0
+#define USART3             0
+#define TIM6               (&test_tim6)
+#define TIM15              (&test_tim15)
+#define LL_DMA_CHANNEL_2   2
+#define LL_DMA_CHANNEL_4   4
+#define LL_DMA_CHANNEL_5   5
+#define DMA1_Channel2_IRQn 12
+#define DMA1_Channel4_IRQn 14
+#define TIM6_DAC_IRQn      54
+
+#define LL_DMA_DIRECTION_PERIPH_TO_MEMORY 0x00000000U
+#define LL_DMA_DIRECTION_MEMORY_TO_PERIPH 0x00000010U
+#define LL_DMA_MODE_NORMAL                0x00000000U
+#define LL_DMA_MODE_CIRCULAR              0x00000020U
+#define LL_DMA_PERIPH_NOINCREMENT         0x00000000U
+#define LL_DMA_PERIPH_INCREMENT           0x00000040U
+#define LL_DMA_MEMORY_NOINCREMENT         0x00000000U
+#define LL_DMA_MEMORY_INCREMENT           0x00000080U
+#define LL_DMA_PDATAALIGN_BYTE            0x00000000U
+#define LL_DMA_PDATAALIGN_HALFWORD        0x00000100U
+#define LL_DMA_PDATAALIGN_WORD            0x00000200U
+#define LL_DMA_MDATAALIGN_BYTE            0x00000000U
+#define LL_DMA_MDATAALIGN_HALFWORD        0x00000400U
+#define LL_DMA_MDATAALIGN_WORD            0x00000800U
+#define LL_DMA_PRIORITY_LOW               0x00000000U
+#define LL_DMA_PRIORITY_MEDIUM            0x00001000U
+#define LL_DMA_PRIORITY_HIGH              0x00002000U
+#define LL_DMA_PRIORITY_VERYHIGH          0x00003000U
+
+#define LL_DMA_DisableChannel(dma, ch) (test_dma[ch].en = 0)
+#define LL_DMA_EnableChannel(dma, ch)  (test_dma[ch].en = 1)
+#define LL_DMA_SetMemoryAddress(dma, ch, addr) (test_dma[ch].mem = (addr))
+#define LL_DMA_SetPeriphAddress(dma, ch, addr) (test_dma[ch].periph = (addr))
+#define LL_DMA_SetDataLength(dma, ch, n)       (test_dma[ch].len = (n))
+#define LL_DMA_ConfigTransfer(dma, ch, cfg)    (test_dma[ch].config = (cfg))
+#define LL_DMA_ConfigAddresses(dma, ch, src, dst, dir)                         \
+    do {                                                                       \
+        if ((dir) == LL_DMA_DIRECTION_MEMORY_TO_PERIPH) {                      \
+            test_dma[ch].mem = (src);                                          \
+            test_dma[ch].periph = (dst);                                       \
+        } else {                                                               \
+            test_dma[ch].periph = (src);                                       \
+            test_dma[ch].mem = (dst);                                          \
+        }                                                                      \
+    } while (0)
+#define LL_DMA_EnableIT_HT(dma, ch) (test_dma[ch].it |= TEST_DMA_IT_HT)
+#define LL_DMA_EnableIT_TC(dma, ch) (test_dma[ch].it |= TEST_DMA_IT_TC)
+#define LL_DMA_EnableIT_TE(dma, ch) (test_dma[ch].it |= TEST_DMA_IT_TE)
+#define LL_DMA_IsActiveFlag_TC2(dma) (test_dma[2].tc)
+#define LL_DMA_ClearFlag_TC2(dma)    (test_dma[2].tc = 0)
+#define LL_DMA_IsActiveFlag_HT4(dma) (test_dma[4].ht)
+#define LL_DMA_ClearFlag_HT4(dma)    (test_dma[4].ht = 0)
+#define LL_DMA_IsActiveFlag_TC4(dma) (test_dma[4].tc)
+#define LL_DMA_ClearFlag_TC4(dma)    (test_dma[4].tc = 0)
+#define LL_DMA_IsActiveFlag_TE4(dma) (test_dma[4].te)
+#define LL_DMA_ClearFlag_TE4(dma)    (test_dma[4].te = 0)
+#define LL_USART_EnableDMAReq_TX(usart)     ((void)0)
+#define LL_USART_DMA_GetRegAddr(usart, reg) 0
+
+#define NVIC_SetPriority(irq, prio) ((void)(prio))
+#define NVIC_EnableIRQ(irq)         (test_nvic_en[irq] = 1)
+
+#define LL_APB1_GRP1_EnableClock(periph)  ((void)0)
+#define LL_TIM_CHANNEL_CH1                0x00000001U
+#define LL_TIM_CHANNEL_CH2                0x00000010U
+#define LL_TIM_OCMODE_FROZEN              0x00000000U
+#define LL_TIM_SetPrescaler(tim, psc)     ((tim)->PSC = (psc))
+#define LL_TIM_SetAutoReload(tim, arr)    ((tim)->ARR = (arr))
+#define LL_TIM_SetCounter(tim, cnt)       ((tim)->CNT = (cnt))
+#define LL_TIM_OC_SetCompareCH1(tim, ccr) ((tim)->CCR1 = (ccr))
+#define LL_TIM_OC_SetCompareCH2(tim, ccr) ((tim)->CCR2 = (ccr))
+#define LL_TIM_OC_SetMode(tim, ch, mode)                                       \
+    ((ch) == LL_TIM_CHANNEL_CH1 ? (void)((tim)->oc1_mode = (mode)) : (void)0)
+#define LL_TIM_EnableDMAReq_CC1(tim)     ((tim)->cc1_dma = 1)
+#define LL_TIM_GenerateEvent_UPDATE(tim) ((tim)->CNT = 0)
+#define LL_TIM_ClearFlag_UPDATE(tim)     ((void)0)
+#define LL_TIM_EnableIT_UPDATE(tim)      ((void)0)
+#define LL_TIM_EnableCounter(tim)        ((tim)->en = 1)
+#define LL_TIM_DisableCounter(tim)       ((tim)->en = 0)
+#define LL_TIM_IsActiveFlag_UPDATE(tim)  1
+
+#define LL_EXTI_LINE_2                        0x00000004U
+#define LL_EXTI_IsActiveFlag_0_31(line)       ((test_exti_flag & (line)) != 0)
+#define LL_EXTI_ClearFlag_0_31(line)          (test_exti_flag &= ~(line))
+#define LL_EXTI_EnableIT_0_31(line)           (test_exti_it |= (line))
+#define LL_EXTI_DisableIT_0_31(line)          (test_exti_it &= ~(line))
+#define LL_EXTI_EnableFallingTrig_0_31(line)  (test_exti_falling |= (line))
+#define LL_EXTI_DisableFallingTrig_0_31(line) (test_exti_falling &= ~(line))
+
+#define GPIOB                              0
+#define DIN_Pin                            0x00001000U
+#define DIN_GPIO_Port                      GPIOB
+#define LL_GPIO_SetOutputPin(port, pin)    ((void)(pin))
+
+#define LL_mDelay(ms) ((void)(ms))
+
+#endif /* __MAIN_H */
@@ -0,0 +1,20 @@
+/**
+ * @file    spi.h
+ * @brief   主机测试用的 spi.h 替身
+ */
+
+#ifndef __SPI_H
+#define __SPI_H
+
+#include "main.h"
+
+typedef struct {
+    int Instance;
+} SPI_HandleTypeDef;
+
+extern SPI_HandleTypeDef hspi2;
+
+int HAL_SPI_Receive(SPI_HandleTypeDef *hspi, uint8_t *data, uint16_t size,
+                    uint32_t timeout);
+
+#endif /* __SPI_H */
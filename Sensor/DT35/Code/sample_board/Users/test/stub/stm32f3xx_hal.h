@@ -0,0 +1,35 @@
+/**
+ * @file    stm32f3xx_hal.h
+ * @brief   主机测试用的 HAL 替身, 只包含 Users 下被测代码用到的部分
+ */
+
+#ifndef __STM32F3xx_HAL_H
+#define __STM32F3xx_HAL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define __weak __attribute__((weak))
+#define UNUSED(x) ((void)(x))
+#define WRITE_REG(reg, val) ((reg) = (val))
+
+#define HAL_OK 0
+#define RESET  0
+
+typedef struct {
+    int Instance;
+    void *hdmatx;
+} UART_HandleTypeDef;
+
+extern uint32_t SystemCoreClock;
+
+int HAL_UART_Transmit(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size,
+                      uint32_t timeout);
+
+/* 串口 DMA 收发, 原工程中由串口驱动提供 */
+uint32_t uart_dmatx_write(UART_HandleTypeDef *huart, const void *data,
+                          uint32_t len);
+uint32_t uart_dmatx_send(UART_HandleTypeDef *huart);
+uint32_t uart_dmarx_read(UART_HandleTypeDef *huart, void *buf, uint32_t len);
+
+#endif /* __STM32F3xx_HAL_H */
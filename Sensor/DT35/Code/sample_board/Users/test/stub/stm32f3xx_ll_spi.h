@@ -0,0 +1,39 @@
+/**
+ * @file    stm32f3xx_ll_spi.h
+ * @brief   主机测试用的 LL SPI 替身, 寄存器操作改为读写 `test_spi2`
+ */
+
+#ifndef __STM32F3xx_LL_SPI_H
+#define __STM32F3xx_LL_SPI_H
+
+#include "main.h"
+
+/* 模拟的 SPI, 只有用到的配置 */
+typedef struct {
+    uint16_t DR;
+    uint32_t dir;
+    uint32_t width;
+    uint32_t rx_fifo_th;
+    int rx_dma; /* 收到数据时请求 DMA */
+    int en;
+} SPI_TypeDef;
+
+extern SPI_TypeDef test_spi2;
+
+#define SPI2 (&test_spi2)
+
+#define LL_SPI_FULL_DUPLEX        0x00000000U
+#define LL_SPI_DATAWIDTH_8BIT     0x00000700U
+#define LL_SPI_DATAWIDTH_16BIT    0x00000F00U
+#define LL_SPI_RX_FIFO_TH_HALF    0x00000000U
+#define LL_SPI_RX_FIFO_TH_QUARTER 0x00001000U
+
+#define LL_SPI_Disable(spi)                   ((spi)->en = 0)
+#define LL_SPI_Enable(spi)                    ((spi)->en = 1)
+#define LL_SPI_SetTransferDirection(spi, d)   ((spi)->dir = (d))
+#define LL_SPI_SetDataWidth(spi, w)           ((spi)->width = (w))
+#define LL_SPI_SetRxFIFOThreshold(spi, th)    ((spi)->rx_fifo_th = (th))
+#define LL_SPI_EnableDMAReq_RX(spi)           ((spi)->rx_dma = 1)
+#define LL_SPI_DMA_GetRegAddr(spi)            ((uint32_t)(uintptr_t)&(spi)->DR)
+
+#endif /* __STM32F3xx_LL_SPI_H */
@@ -0,0 +1,4 @@
+/**
+ * @file    stm32f3xx_ll_usart.h
+ * @brief   主机测试用的替身, 用到的宏在 main.h 替身中定义
+ */
@@ -0,0 +1,11 @@
+/**
+ * @file    tim.h
+ * @brief   主机测试用的 tim.h 替身, 定时器在 main.h 替身中模拟
+ */
+
+#ifndef __TIM_H
+#define __TIM_H
+
+#include "main.h"
+
+#endif /* __TIM_H */
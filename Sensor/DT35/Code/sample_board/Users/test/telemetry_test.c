@@ -0,0 +1,244 @@
+/**
+ * @file    telemetry_test.c
+ * @brief   telemetry 主机测试. 包含 BINARY 帧的解码器 (与 `msg_protocol`
+ *          的接收端相同: 去掉转义字节, 遇到未转义的结束符结束一帧), 模拟
+ *          定时器和 115200 波特率的串口逐字节发送, 测试不同输出频率下的
+ *          丢帧情况, 并比较 ASCII 和 BINARY 每次输出的组帧耗时.
+ *
+ * 在 `Sensor/DT35/Code/sample_board/Users` 下编译运行:
+ *
+ *   gcc -std=gnu11 -g -O2 -Itest/stub -I. test/telemetry_test.c \
+ *       telemetry.c msg_frame.c -o telemetry_test
+ *   ./telemetry_test
+ *
+ * 检查项:
+ *  - 任意 float (包括含有结束符和转义字节的) 组帧后能解码出相同的值
+ *  - 串口带宽足够时不丢帧; 超出带宽时帧序号的缺口与 `telemetry_drop` 相同
+ */
+
+#include "telemetry.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+/* 串口波特率, 8N1 每字节 10 位 */
+#define TEST_BAUD      115200
+/* 每个频率模拟的时长 (s) */
+#define TEST_SECONDS   5
+/* 组帧耗时测试的次数 */
+#define BENCH_OUTPUTS  2000000
+
+uint32_t SystemCoreClock = 72000000;
+
+test_dma_ch_t test_dma[8];
+TIM_TypeDef test_tim6;
+TIM_TypeDef test_tim15;
+int test_nvic_en[64];
+
+/* 串口发送 DMA 通道 */
+#define TEST_TX     test_dma[2]
+#define TEST_TX_BUF ((const uint8_t *)test_dma_ptr(TEST_TX.mem))
+
+/**
+ * @brief 解码器状态
+ */
+static struct {
+    uint8_t frame[64]; /* 去掉转义后的一帧 */
+    uint8_t len;
+    uint8_t escape;
+    uint32_t ok;   /* 正确的帧数 */
+    uint32_t bad;  /* 格式错误的帧数 */
+    uint32_t lost; /* 帧序号的缺口 */
+    int32_t last_seq;
+    float value;
+} test_dec;
+
+static void test_decode_reset(void) {
+    memset(&test_dec, 0, sizeof(test_dec));
+    test_dec.last_seq = -1;
+}
+
+/**
+ * @brief 解码一个字节
+ */
+static void test_decode_byte(uint8_t byte) {
+    if (byte == MSG_ESC && !test_dec.escape) {
+        test_dec.escape = 1;
+        return;
+    }
+
+    if (test_dec.len < sizeof(test_dec.frame)) {
+        test_dec.frame[test_dec.len++] = byte;
+    }
+    if (test_dec.escape) {
+        test_dec.escape = 0;
+        return;
+    }
+    if (byte != MSG_EOF) {
+        return;
+    }
+
+    /* | 标识 | 长度 | 帧序号 (uint16) | 测量值 (float) | 结束符 | */
+    if (test_dec.len == 9 &&
+        test_dec.frame[0] == ((TELEMETRY_MSG_ID << 4) | MSG_DATA_CUSTOM) &&
+        test_dec.frame[1] == 6) {
+        int32_t seq = test_dec.frame[2] | (test_dec.frame[3] << 8);
+
+        memcpy(&test_dec.value, &test_dec.frame[4], sizeof(float));
+        if (test_dec.last_seq >= 0) {
+            test_dec.lost += (uint16_t)(seq - test_dec.last_seq - 1);
+        }
+        test_dec.last_seq = seq;
+        test_dec.ok++;
+    } else {
+        test_dec.bad++;
+    }
+    test_dec.len = 0;
+}
+
+/**
+ * @brief 组帧后立即解码, 值必须完全相同
+ */
+static void test_round_trip(void) {
+    for (uint32_t k = 0; k < 200000; ++k) {
+        uint32_t bits = k * 2654435761U;
+        float value;
+
+        /* 前 256 个值的每个字节都是结束符或转义字节 */
+        if (k < 256) {
+            bits = 0x7F8F7F8FU ^ (k * 0x01010101U);
+        }
+        memcpy(&value, &bits, sizeof(float));
+
+        telemetry_init();
+        test_decode_reset();
+        CHECK(telemetry_send_value(value) == 0);
+        CHECK(TEST_TX.en && TEST_TX.len <= 15);
+        for (uint32_t i = 0; i < TEST_TX.len; ++i) {
+            test_decode_byte(TEST_TX_BUF[i]);
+        }
+        CHECK(test_dec.ok == 1 && test_dec.bad == 0);
+        CHECK(memcmp(&test_dec.value, &value, sizeof(float)) == 0);
+
+        TEST_TX.tc = 1;
+        telemetry_dma_irq();
+    }
+    printf("round trip: 200000 values\n");
+}
+
+static float test_value;
+
+void telemetry_timer_callback(void) {
+    telemetry_send_value(test_value);
+}
+
+/**
+ * @brief 以 1us 为步长模拟定时器中断和串口发送
+ *
+ * @param rate 输出频率 (Hz)
+ */
+static void test_rate(uint32_t rate) {
+    const uint32_t byte_us = 10 * 1000000 / TEST_BAUD + 1;
+    uint32_t next_tim = 0, next_byte = 0, pos = 0;
+
+    test_decode_reset();
+    telemetry_drop = 0;
+    telemetry_init();
+
+    for (uint32_t t = 0; t < TEST_SECONDS * 1000000; ++t) {
+        if (t >= next_tim) {
+            next_tim = (uint32_t)((uint64_t)(t / (1000000 / rate) + 1) *
+                                  (1000000 / rate));
+            test_value = 4.0f + 16.0f * t / (TEST_SECONDS * 1000000);
+            telemetry_tim_irq();
+        }
+
+        if (TEST_TX.en && t >= next_byte) {
+            test_decode_byte(TEST_TX_BUF[pos++]);
+            next_byte = t + byte_us;
+            if (pos == TEST_TX.len) {
+                pos = 0;
+                TEST_TX.en = 0;
+                TEST_TX.tc = 1;
+                telemetry_dma_irq();
+            }
+        }
+    }
+
+    CHECK(test_dec.bad == 0);
+    CHECK(test_dec.lost == telemetry_drop);
+    printf("rate %4u Hz: %7.1f frames/s decoded, %u dropped\n", rate,
+           (double)test_dec.ok / TEST_SECONDS, (unsigned)telemetry_drop);
+}
+
+/**
+ * @brief 原来 ASCII 输出的格式化, 与 main.c 中的 getFloatNum 相同
+ */
+static uint8_t test_ascii_format(float n, uint8_t tx_data[],
+                                 int decimal_places) {
+    char buf[10];
+    uint8_t len;
+
+    snprintf(buf, sizeof(buf), "%.*f", decimal_places, n);
+    len = (uint8_t)strlen(buf);
+    tx_data[0] = 's';
+    memcpy(&tx_data[1], buf, len);
+    tx_data[len + 1] = 'e';
+    return len + 2;
+}
+
+static double test_now(void) {
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief 每次输出的组帧耗时
+ */
+static void test_bench(void) {
+    volatile uint8_t sink;
+    uint8_t tx[16];
+    double t, t_ascii, t_binary;
+
+    t = test_now();
+    for (uint32_t i = 0; i < BENCH_OUTPUTS; ++i) {
+        sink = test_ascii_format(4.0f + i * 1e-6f, tx, 4);
+    }
+    t_ascii = test_now() - t;
+
+    /* DMA 一直在发送, 每次都写入等待发送的缓冲区 */
+    telemetry_init();
+    t = test_now();
+    for (uint32_t i = 0; i < BENCH_OUTPUTS; ++i) {
+        telemetry_send_value(4.0f + i * 1e-6f);
+    }
+    t_binary = test_now() - t;
+
+    printf("bench: ascii %.1f ns/output, binary %.1f ns/output\n",
+           t_ascii * 1e9 / BENCH_OUTPUTS, t_binary * 1e9 / BENCH_OUTPUTS);
+    (void)sink;
+}
+
+int main(void) {
+    static const uint32_t rates[] = {50, 500, 1000, 1200, 1500};
+
+    test_round_trip();
+    for (uint32_t i = 0; i < sizeof(rates) / sizeof(rates[0]); ++i) {
+        test_rate(rates[i]);
+    }
+    test_bench();
+    printf("telemetry: all tests passed\n");
+    return 0;
+}
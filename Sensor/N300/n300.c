@@ -7,40 +7,175 @@
  */
 
 #include "n300.h"
-#include "crc/crc.h"
 #include "my_math/my_math.h"
 
+#include <string.h>
+
+/* 帧头, 帧尾 */
+#define N300_HEAD       0xFC
+#define N300_TAIL       0xFD
+/* 帧头长度: 帧头, 类型, 长度, 序号, CRC8, CRC16 */
+#define N300_HEADER_LEN 7
+/* AHRS 数据长度 */
+#define N300_AHRS_LEN   (sizeof(struct n300_frame) - N300_HEADER_LEN - 1)
+
+/* CRC-8/MAXIM 数据表, 用于帧头校验 */
+static const uint8_t n300_crc8_table[256] = {
+    0x00, 0x5E, 0xBC, 0xE2, 0x61, 0x3F, 0xDD, 0x83, 0xC2, 0x9C, 0x7E, 0x20,
+    0xA3, 0xFD, 0x1F, 0x41, 0x9D, 0xC3, 0x21, 0x7F, 0xFC, 0xA2, 0x40, 0x1E,
+    0x5F, 0x01, 0xE3, 0xBD, 0x3E, 0x60, 0x82, 0xDC, 0x23, 0x7D, 0x9F, 0xC1,
+    0x42, 0x1C, 0xFE, 0xA0, 0xE1, 0xBF, 0x5D, 0x03, 0x80, 0xDE, 0x3C, 0x62,
+    0xBE, 0xE0, 0x02, 0x5C, 0xDF, 0x81, 0x63, 0x3D, 0x7C, 0x22, 0xC0, 0x9E,
+    0x1D, 0x43, 0xA1, 0xFF, 0x46, 0x18, 0xFA, 0xA4, 0x27, 0x79, 0x9B, 0xC5,
+    0x84, 0xDA, 0x38, 0x66, 0xE5, 0xBB, 0x59, 0x07, 0xDB, 0x85, 0x67, 0x39,
+    0xBA, 0xE4, 0x06, 0x58, 0x19, 0x47, 0xA5, 0xFB, 0x78, 0x26, 0xC4, 0x9A,
+    0x65, 0x3B, 0xD9, 0x87, 0x04, 0x5A, 0xB8, 0xE6, 0xA7, 0xF9, 0x1B, 0x45,
+    0xC6, 0x98, 0x7A, 0x24, 0xF8, 0xA6, 0x44, 0x1A, 0x99, 0xC7, 0x25, 0x7B,
+    0x3A, 0x64, 0x86, 0xD8, 0x5B, 0x05, 0xE7, 0xB9, 0x8C, 0xD2, 0x30, 0x6E,
+    0xED, 0xB3, 0x51, 0x0F, 0x4E, 0x10, 0xF2, 0xAC, 0x2F, 0x71, 0x93, 0xCD,
+    0x11, 0x4F, 0xAD, 0xF3, 0x70, 0x2E, 0xCC, 0x92, 0xD3, 0x8D, 0x6F, 0x31,
+    0xB2, 0xEC, 0x0E, 0x50, 0xAF, 0xF1, 0x13, 0x4D, 0xCE, 0x90, 0x72, 0x2C,
+    0x6D, 0x33, 0xD1, 0x8F, 0x0C, 0x52, 0xB0, 0xEE, 0x32, 0x6C, 0x8E, 0xD0,
+    0x53, 0x0D, 0xEF, 0xB1, 0xF0, 0xAE, 0x4C, 0x12, 0x91, 0xCF, 0x2D, 0x73,
+    0xCA, 0x94, 0x76, 0x28, 0xAB, 0xF5, 0x17, 0x49, 0x08, 0x56, 0xB4, 0xEA,
+    0x69, 0x37, 0xD5, 0x8B, 0x57, 0x09, 0xEB, 0xB5, 0x36, 0x68, 0x8A, 0xD4,
+    0x95, 0xCB, 0x29, 0x77, 0xF4, 0xAA, 0x48, 0x16, 0xE9, 0xB7, 0x55, 0x0B,
+    0x88, 0xD6, 0x34, 0x6A, 0x2B, 0x75, 0x97, 0xC9, 0x4A, 0x14, 0xF6, 0xA8,
+    0x74, 0x2A, 0xC8, 0x96, 0x15, 0x4B, 0xA9, 0xF7, 0xB6, 0xE8, 0x0A, 0x54,
+    0xD7, 0x89, 0x6B, 0x35
+};
+
+/* CRC-16/XMODEM 数据表, 用于数据校验 */
+static const uint16_t n300_crc16_table[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
+};
+
+/**
+ * @brief 帧头 CRC8 校验
+ *
+ * @param crc 上次的 CRC 值, 第一次传入 0
+ * @param data 数据
+ * @param len 长度
+ * @return CRC8 校验值
+ */
+static uint8_t n300_crc8(uint8_t crc, const uint8_t *data, uint32_t len) {
+    while (len--) {
+        crc = n300_crc8_table[crc ^ *data++];
+    }
+    return crc;
+}
+
+/**
+ * @brief 数据 CRC16 校验
+ *
+ * @param crc 上次的 CRC 值, 第一次传入 0
+ * @param data 数据
+ * @param len 长度
+ * @return CRC16 校验值
+ */
+static uint16_t n300_crc16(uint16_t crc, const uint8_t *data, uint32_t len) {
+    while (len--) {
+        crc = n300_crc16_table[((crc >> 8) ^ *data++) & 0xFF] ^
+              (uint16_t)(crc << 8);
+    }
+    return crc;
+}
+
+/**
+ * @brief 获取下一个要写入的缓冲区
+ *
+ * @param n300_handle 句柄
+ * @return 读者当前不会访问的缓冲区
+ */
+static inline n300_data_t *n300_next_slot(n300_handle_t *n300_handle) {
+    return &n300_handle->data[(n300_handle->seq + 1) & 1];
+}
+
+/**
+ * @brief 发布数据
+ *
+ * @param n300_handle 句柄
+ * @param slot 已经写入帧的缓冲区, 由 `n300_next_slot` 获取
+ */
+static void n300_publish(n300_handle_t *n300_handle, n300_data_t *slot) {
+    float yaw_data = RAD2DEG(slot->frame.yaw);
+    if (yaw_data > 180.0f) {
+        yaw_data -= 360;
+    }
+
+    slot->timestamp = N300_GET_TIMESTAMP();
+    slot->yaw = yaw_data;
+    slot->roll = RAD2DEG(slot->frame.roll);
+    slot->pitch = RAD2DEG(slot->frame.pitch);
+
+    n300_handle->yaw = slot->yaw;
+    n300_handle->roll = slot->roll;
+    n300_handle->pitch = slot->pitch;
+
+    /* 数据写完后再更新序号 */
+    __DMB();
+    n300_handle->seq++;
+}
+
 /**
  * @brief 处理n300数据 
  * 
  * @param n300_handle 句柄
  */
 static void n300_get_data(n300_handle_t *n300_handle) {
-    static float yaw_data;
-    if (n300_handle->frame.instruction_type != N300_MSG_AHRS) {
-        n300_handle->recv_len = 0;
+    uint8_t *p = (uint8_t *)&n300_handle->frame;
+    n300_data_t *slot;
+
+    if (n300_handle->frame.instruction_type != N300_MSG_AHRS ||
+        n300_handle->frame.data_len != N300_AHRS_LEN) {
         return;
     }
     /* crc8 帧头校验 */
-    uint8_t *p_crc8 = &n300_handle->frame.head;
-    if (n300_handle->frame.crc8_val == calc_crc8(p_crc8, 4)) {
-        n300_handle->recv_len = 0;
+    if (n300_handle->frame.crc8_val != n300_crc8(0, p, 4)) {
+        n300_handle->err_cnt++;
         return;
     }
     /* crc16 数据帧校验 */
-    uint8_t *p_crc16 = (uint8_t *)&n300_handle->frame.roll_speed;
-    if (n300_handle->frame.crc16_val ==
-        calc_crc16(p_crc16, n300_handle->frame.data_len)) {
-        n300_handle->recv_len = 0;
+    if (((p[5] << 8) | p[6]) !=
+        n300_crc16(0, p + N300_HEADER_LEN, N300_AHRS_LEN)) {
+        n300_handle->err_cnt++;
         return;
     }
-    yaw_data = RAD2DEG(n300_handle->frame.yaw);
-    if (yaw_data > 180.0f) {
-        yaw_data -= 360;
-    }
-    n300_handle->yaw = yaw_data;
-    n300_handle->roll = RAD2DEG(n300_handle->frame.roll);
-    n300_handle->pitch = RAD2DEG(n300_handle->frame.pitch);
+
+    slot = n300_next_slot(n300_handle);
+    slot->frame = n300_handle->frame;
+    n300_publish(n300_handle, slot);
 }
 
 /**
@@ -53,6 +188,14 @@ static void n300_get_data(n300_handle_t *n300_handle) {
 void n300_prase(n300_handle_t *n300_handle, uint8_t *data, uint32_t len) {
     uint8_t *p = (uint8_t *)&n300_handle->frame;
     for (uint32_t i = 0; i < len; ++i) {
+        p[n300_handle->recv_len] = data[i];
+        n300_handle->recv_len++;
+
+        if (n300_handle->frame.head != 0xFC) {
+            /* 不是正确的头就数据清除 */
+            n300_handle->recv_len = 0;
+        }
+
         if (n300_handle->recv_len >= sizeof(n300_handle->frame)) {
             if (n300_handle->frame.tail == 0xFD) {
                 /* 数据处理 */
@@ -60,13 +203,188 @@ void n300_prase(n300_handle_t *n300_handle, uint8_t *data, uint32_t len) {
             }
             n300_handle->recv_len = 0;
         }
+    }
+}
 
-        p[n300_handle->recv_len] = data[i];
-        n300_handle->recv_len++;
+/**
+ * @brief 读取最新数据
+ *
+ * @param n300_handle 句柄
+ * @param[out] data 最新数据
+ * @return 发布次数, 0 表示还没有收到数据
+ * @note 不关中断, 读取期间有新数据发布时重新读取.
+ */
+uint32_t n300_read(n300_handle_t *n300_handle, n300_data_t *data) {
+    uint32_t seq;
 
-        if (n300_handle->frame.head != 0xFC) {
-            /* 不是正确的头就数据清除 */
-            n300_handle->recv_len = 0;
+    do {
+        seq = n300_handle->seq;
+        __DMB();
+        *data = n300_handle->data[seq & 1];
+        __DMB();
+    } while (seq != n300_handle->seq);
+
+    return seq;
+}
+
+#if N300_USE_DMA_RECV
+
+/**
+ * @brief 环形缓冲区位置后移
+ *
+ * @param pos 位置
+ * @param offset 偏移
+ * @return 新位置
+ */
+static inline uint16_t n300_ring_pos(uint16_t pos, uint16_t offset) {
+    pos += offset;
+    if (pos >= N300_DMA_BUF_SIZE) {
+        pos -= N300_DMA_BUF_SIZE;
+    }
+    return pos;
+}
+
+/**
+ * @brief 从环形缓冲区复制数据
+ *
+ * @param n300_handle 句柄
+ * @param pos 起始位置
+ * @param[out] dst 目标地址
+ * @param len 长度
+ */
+static void n300_ring_copy(const n300_handle_t *n300_handle, uint16_t pos,
+                           void *dst, uint16_t len) {
+    uint16_t first = N300_DMA_BUF_SIZE - pos;
+
+    if (first > len) {
+        first = len;
+    }
+    memcpy(dst, &n300_handle->dma_buf[pos], first);
+    memcpy((uint8_t *)dst + first, n300_handle->dma_buf, len - first);
+}
+
+/**
+ * @brief 直接在环形缓冲区上计算 CRC16
+ *
+ * @param n300_handle 句柄
+ * @param pos 起始位置
+ * @param len 长度
+ * @return CRC16 校验值
+ */
+static uint16_t n300_ring_crc16(const n300_handle_t *n300_handle, uint16_t pos,
+                                uint16_t len) {
+    uint16_t first = N300_DMA_BUF_SIZE - pos;
+    uint16_t crc;
+
+    if (first > len) {
+        first = len;
+    }
+    crc = n300_crc16(0, &n300_handle->dma_buf[pos], first);
+    return n300_crc16(crc, n300_handle->dma_buf, len - first);
+}
+
+/**
+ * @brief 开始 DMA 接收
+ *
+ * @param n300_handle 句柄
+ * @param huart 串口句柄, 接收 DMA 需要配置为循环模式
+ * @return 0: 成功; 1: 失败
+ * @note 串口出错后 HAL 会停止接收, 可以在错误回调中再次调用.
+ */
+uint8_t n300_dma_start(n300_handle_t *n300_handle, UART_HandleTypeDef *huart) {
+    if (n300_handle == NULL || huart == NULL || huart->hdmarx == NULL ||
+        huart->hdmarx->Init.Mode != DMA_CIRCULAR) {
+        return 1;
+    }
+
+    n300_handle->huart = huart;
+    n300_handle->read_pos = 0;
+
+    if (HAL_UARTEx_ReceiveToIdle_DMA(huart, n300_handle->dma_buf,
+                                     N300_DMA_BUF_SIZE) != HAL_OK) {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief 串口接收事件处理, 在 `HAL_UARTEx_RxEventCallback` 中调用
+ *
+ * @param n300_handle 句柄
+ * @param huart 串口句柄
+ * @param size DMA 在缓冲区中的写入位置
+ * @note 空闲, 半满, 全满时都会进入. 直接在 DMA 缓冲区上查找帧头并校验,
+ *       只有校验通过的 AHRS 帧会复制一次到发布缓冲区.
+ */
+void n300_rx_event_callback(n300_handle_t *n300_handle,
+                            UART_HandleTypeDef *huart, uint16_t size) {
+    uint8_t header[N300_HEADER_LEN];
+    uint16_t pos, head, avail, len, n;
+    uint8_t *p;
+    n300_data_t *slot;
+
+    if (n300_handle == NULL || huart != n300_handle->huart) {
+        return;
+    }
+
+    head = (size >= N300_DMA_BUF_SIZE) ? 0 : size;
+    pos = n300_handle->read_pos;
+    avail = (head >= pos) ? head - pos : head + N300_DMA_BUF_SIZE - pos;
+
+    while (avail >= N300_HEADER_LEN) {
+        if (n300_handle->dma_buf[pos] != N300_HEAD) {
+            /* 在连续的一段内查找帧头 */
+            n = N300_DMA_BUF_SIZE - pos;
+            if (n > avail) {
+                n = avail;
+            }
+            p = memchr(&n300_handle->dma_buf[pos], N300_HEAD, n);
+            if (p != NULL) {
+                n = (uint16_t)(p - &n300_handle->dma_buf[pos]);
+            }
+            pos = n300_ring_pos(pos, n);
+            avail -= n;
+            continue;
+        }
+
+        n300_ring_copy(n300_handle, pos, header, N300_HEADER_LEN);
+        len = N300_HEADER_LEN + header[2] + 1;
+        if (header[4] != n300_crc8(0, header, 4) ||
+            len > N300_DMA_BUF_SIZE / 2) {
+            /* 数据中的 0xFC, 跳过 */
+            pos = n300_ring_pos(pos, 1);
+            avail--;
+            continue;
+        }
+
+        if (len > avail) {
+            /* 等待剩余数据 */
+            break;
         }
+
+        if (n300_handle->dma_buf[n300_ring_pos(pos, len - 1)] != N300_TAIL ||
+            ((header[5] << 8) | header[6]) !=
+                n300_ring_crc16(n300_handle,
+                                n300_ring_pos(pos, N300_HEADER_LEN),
+                                header[2])) {
+            n300_handle->err_cnt++;
+            pos = n300_ring_pos(pos, 1);
+            avail--;
+            continue;
+        }
+
+        if (header[1] == N300_MSG_AHRS && header[2] == N300_AHRS_LEN) {
+            slot = n300_next_slot(n300_handle);
+            n300_ring_copy(n300_handle, pos, &slot->frame, len);
+            n300_publish(n300_handle, slot);
+        }
+
+        pos = n300_ring_pos(pos, len);
+        avail -= len;
     }
+
+    n300_handle->read_pos = pos;
 }
+
+#endif /* N300_USE_DMA_RECV */
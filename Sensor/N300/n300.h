@@ -12,8 +12,18 @@
 #ifndef __N300_H
 #define __N300_H
 
+#include "bsp.h"
+
 #include <stdint.h>
 
+/* 是否使用 DMA 环形缓冲区 + 空闲中断接收 */
+#define N300_USE_DMA_RECV 1
+/* DMA 环形缓冲区大小 (byte), 至少放得下两帧 (AHRS 帧 56 byte) */
+#define N300_DMA_BUF_SIZE 256
+
+/* 接收时间戳, 默认为 ms, 可以换成更高精度的计时器 */
+#define N300_GET_TIMESTAMP() HAL_GetTick()
+
 typedef enum __attribute((packed)) {
     N300_MSG_IMU = 0x40,
     N300_MSG_AHRS = 0x41,
@@ -27,7 +37,7 @@ struct __attribute((packed)) n300_frame {
     uint8_t data_len;
     uint8_t send_count;
     uint8_t crc8_val;
-    uint16_t crc16_val;
+    uint16_t crc16_val; /* 高字节在前 */
 
     struct __attribute((packed)) {
         float roll_speed;  /* unit: rad/s */
@@ -46,6 +56,18 @@ struct __attribute((packed)) n300_frame {
     uint8_t tail; /* 尾 */
 };
 
+/**
+ * @brief 一次发布的数据
+ */
+typedef struct {
+    struct n300_frame frame; /*!< 校验通过的原始帧 */
+    uint32_t timestamp;      /*!< 接收时刻, 见 `N300_GET_TIMESTAMP` */
+
+    float yaw;   /*!< -180~180 */
+    float pitch; /*!< -180~180 */
+    float roll;  /*!< -180~180 */
+} n300_data_t;
+
 typedef struct {
     struct n300_frame frame; /* 帧格式 */
     uint32_t recv_len;
@@ -53,8 +75,25 @@ typedef struct {
     float yaw;   /* -180~180 */
     float pitch; /* -180~180 */
     float roll;  /* -180~180 */
+
+    n300_data_t data[2];   /*!< 双缓冲, 最新数据为 data[seq & 1] */
+    volatile uint32_t seq; /*!< 发布次数 */
+    uint32_t err_cnt;      /*!< 校验失败次数 */
+
+#if N300_USE_DMA_RECV
+    UART_HandleTypeDef *huart;          /*!< 接收串口 */
+    uint16_t read_pos;                  /*!< 解析位置 */
+    uint8_t dma_buf[N300_DMA_BUF_SIZE]; /*!< DMA 环形缓冲区 */
+#endif /* N300_USE_DMA_RECV */
 } n300_handle_t;
 
 void n300_prase(n300_handle_t *n300_handle, uint8_t *data, uint32_t len);
+uint32_t n300_read(n300_handle_t *n300_handle, n300_data_t *data);
+
+#if N300_USE_DMA_RECV
+uint8_t n300_dma_start(n300_handle_t *n300_handle, UART_HandleTypeDef *huart);
+void n300_rx_event_callback(n300_handle_t *n300_handle,
+                            UART_HandleTypeDef *huart, uint16_t size);
+#endif /* N300_USE_DMA_RECV */
 
 #endif /* __N300_H */
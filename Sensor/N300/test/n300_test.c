@@ -0,0 +1,496 @@
+/**
+ * @file    n300_test.c
+ * @brief   n300 主机测试. 生成 FDILink 帧流 (AHRS 帧, 其他类型的帧, 错误帧,
+ *          截断的帧和噪声), 按随机分段写入 DMA 环形缓冲区并回放接收事件,
+ *          检查发布的数据; 然后比较在环形缓冲区上直接解析和逐字节解析
+ *          每帧的耗时.
+ *
+ * 在 `Sensor/N300` 下编译运行:
+ *
+ *   gcc -std=gnu11 -g -O1 -fsanitize=address,undefined -Itest/stub -I. \
+ *       -I../../Utils test/n300_test.c n300.c -o n300_test && ./n300_test
+ *   gcc -std=gnu11 -O2 -Itest/stub -I. -I../../Utils test/n300_test.c \
+ *       n300.c -o n300_test && ./n300_test
+ *
+ * 检查项:
+ *  - 没有配置循环模式接收 DMA 的串口启动失败
+ *  - 校验表与按位计算的 CRC-8/MAXIM, CRC-16/XMODEM 相同
+ *  - DMA 回放: 每个有效的 AHRS 帧都按顺序发布一次, 内容与发送的帧相同,
+ *    时间戳为解析出该帧的那次事件的时刻, yaw 转换到 -180~180;
+ *    其他类型的帧 (包括长度与 AHRS 帧相同的), 校验错误, 截断的帧和噪声
+ *    都不发布, 跨过缓冲区末尾的帧正确解析
+ *  - 逐字节解析 (`n300_prase`) 对同样的帧按随机分段送入, 结果相同
+ *  - `n300_read` 读到最新一帧
+ */
+
+#include "n300.h"
+#include "my_math/my_math.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+/* 回放的帧 (含错误帧和噪声) 数 */
+#define TEST_ITEMS    60000
+/* 耗时测试: 每轮帧数, 轮数 */
+#define BENCH_FRAMES  1000000
+#define BENCH_ROUNDS  5
+/* 帧长度 */
+#define TEST_FRAME_LEN ((uint16_t)sizeof(struct n300_frame))
+#define TEST_AHRS_LEN  (TEST_FRAME_LEN - 8)
+
+volatile uint32_t test_tick;
+
+static DMA_HandleTypeDef test_dma = {{DMA_CIRCULAR}};
+static UART_HandleTypeDef test_uart = {3, &test_dma};
+static uint8_t *test_dma_buf;
+static uint16_t test_wp;
+
+static n300_handle_t test_n300;
+
+/* 应当发布的帧 */
+static struct n300_frame test_expect[TEST_ITEMS];
+static uint32_t test_expect_num;
+/* 已经检查过的发布次数 */
+static uint32_t test_seen;
+/* 没有检查到内容的帧数 */
+static uint32_t test_unchecked;
+
+static uint32_t test_rand_state = 7;
+
+int HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *buf,
+                                 uint16_t size) {
+    (void)huart;
+    CHECK(size == N300_DMA_BUF_SIZE);
+    test_dma_buf = buf;
+    return HAL_OK;
+}
+
+static uint32_t test_rand(void) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return test_rand_state >> 8;
+}
+
+static float test_randf(float lo, float hi) {
+    return lo + (hi - lo) * (float)(test_rand() % 100000) / 100000.0f;
+}
+
+static double test_now(void) {
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief 按位计算的 CRC-8/MAXIM
+ */
+static uint8_t test_crc8(const uint8_t *data, uint32_t len) {
+    uint8_t crc = 0;
+
+    while (len--) {
+        crc ^= *data++;
+        for (int i = 0; i < 8; ++i) {
+            crc = (crc & 0x01) ? (uint8_t)((crc >> 1) ^ 0x8C) : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief 按位计算的 CRC-16/XMODEM
+ */
+static uint16_t test_crc16(const uint8_t *data, uint32_t len) {
+    uint16_t crc = 0;
+
+    while (len--) {
+        crc ^= (uint16_t)(*data++ << 8);
+        for (int i = 0; i < 8; ++i) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021)
+                                 : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief 生成一帧
+ *
+ * @param[out] out 帧
+ * @param type 类型
+ * @param payload 数据
+ * @param len 数据长度
+ * @return 帧长度
+ */
+static uint16_t test_build(uint8_t *out, uint8_t type, const uint8_t *payload,
+                           uint8_t len) {
+    static uint8_t count;
+    uint16_t crc;
+
+    out[0] = 0xFC;
+    out[1] = type;
+    out[2] = len;
+    out[3] = count++;
+    out[4] = test_crc8(out, 4);
+    crc = test_crc16(payload, len);
+    out[5] = (uint8_t)(crc >> 8);
+    out[6] = (uint8_t)crc;
+    memcpy(&out[7], payload, len);
+    out[7 + len] = 0xFD;
+    return (uint16_t)(len + 8);
+}
+
+/**
+ * @brief 生成一个 AHRS 帧
+ */
+static void test_build_ahrs(struct n300_frame *frame) {
+    struct n300_frame f;
+
+    memset(&f, 0, sizeof(f));
+    f.roll_speed = test_randf(-10, 10);
+    f.pitch_speed = test_randf(-10, 10);
+    f.yaw_speed = test_randf(-10, 10);
+    f.roll = test_randf(-3.14f, 3.14f);
+    f.pitch = test_randf(-1.57f, 1.57f);
+    f.yaw = test_randf(0, 6.28f);
+    f.qw = test_randf(-1, 1);
+    f.qx = test_randf(-1, 1);
+    f.qy = test_randf(-1, 1);
+    f.qz = test_randf(-1, 1);
+    f.timestamp = (int64_t)test_rand() * 1000 + test_rand();
+
+    test_build((uint8_t *)frame, N300_MSG_AHRS, (uint8_t *)&f.roll_speed,
+               TEST_AHRS_LEN);
+}
+
+/**
+ * @brief 检查上次检查之后发布的帧
+ */
+static void test_check_published(void) {
+    uint32_t seq = test_n300.seq;
+    n300_data_t latest;
+
+    /* 噪声碰巧通过帧头校验时要等够它声明的长度才能跳过, 之后一次发布
+     * 多帧, 只有最后两帧还在缓冲区中 */
+    if (seq - test_seen > 2) {
+        test_unchecked += seq - 2 - test_seen;
+        test_seen = seq - 2;
+    }
+    for (; test_seen < seq; ++test_seen) {
+        const n300_data_t *slot = &test_n300.data[(test_seen + 1) & 1];
+        const struct n300_frame *expect = &test_expect[test_seen];
+        float yaw = RAD2DEG(expect->yaw);
+
+        CHECK(test_seen < test_expect_num);
+        CHECK(memcmp(&slot->frame, expect, sizeof(*expect)) == 0);
+        CHECK(slot->timestamp == test_tick);
+        CHECK(slot->yaw == (yaw > 180.0f ? yaw - 360 : yaw));
+        CHECK(slot->yaw >= -180.0f && slot->yaw <= 180.0f);
+        CHECK(slot->pitch == (float)RAD2DEG(expect->pitch));
+    }
+
+    if (seq != 0) {
+        CHECK(n300_read(&test_n300, &latest) == seq);
+        CHECK(memcmp(&latest.frame, &test_expect[seq - 1],
+                     sizeof(latest.frame)) == 0);
+    }
+}
+
+/**
+ * @brief 模拟接收事件
+ */
+static void test_event(uint16_t size) {
+    test_tick++;
+    n300_rx_event_callback(&test_n300, &test_uart, size);
+    test_check_published();
+}
+
+/**
+ * @brief 模拟 DMA 写入一个字节, 半满和全满时产生事件
+ */
+static void test_dma_put(uint8_t byte) {
+    test_dma_buf[test_wp++] = byte;
+    if (test_wp == N300_DMA_BUF_SIZE / 2) {
+        test_event(test_wp);
+    } else if (test_wp == N300_DMA_BUF_SIZE) {
+        test_event(test_wp);
+        test_wp = 0;
+    }
+}
+
+static void test_start(void) {
+    DMA_HandleTypeDef normal = {{0}};
+    UART_HandleTypeDef no_dma = {3, NULL};
+    UART_HandleTypeDef not_circular = {3, &normal};
+
+    memset(&test_n300, 0, sizeof(test_n300));
+    CHECK(n300_dma_start(&test_n300, &no_dma) == 1);
+    CHECK(n300_dma_start(&test_n300, &not_circular) == 1);
+    CHECK(n300_dma_start(NULL, &test_uart) == 1);
+    CHECK(n300_dma_start(&test_n300, &test_uart) == 0);
+    CHECK(test_dma_buf == test_n300.dma_buf);
+    test_wp = 0;
+    test_seen = 0;
+    test_unchecked = 0;
+    test_expect_num = 0;
+}
+
+static void test_crc(void) {
+    static const uint8_t check[] = "123456789";
+
+    /* 标准校验值 */
+    CHECK(test_crc8(check, 9) == 0xA1);
+    CHECK(test_crc16(check, 9) == 0x31C3);
+
+    printf("crc: CRC-8/MAXIM and CRC-16/XMODEM check values\n");
+}
+
+/**
+ * @brief DMA 回放
+ */
+static void test_replay(void) {
+    uint32_t corrupt = 0, other = 0, truncated = 0, noise = 0, events = 0;
+    uint32_t bytes = 0;
+    uint8_t buf[128];
+
+    test_start();
+
+    for (uint32_t item = 0; item < TEST_ITEMS; ++item) {
+        uint32_t kind = test_rand() % 100;
+        uint16_t len;
+
+        if (kind < 60) {
+            /* 有效的 AHRS 帧 */
+            test_build_ahrs(&test_expect[test_expect_num]);
+            memcpy(buf, &test_expect[test_expect_num], TEST_FRAME_LEN);
+            test_expect_num++;
+            len = TEST_FRAME_LEN;
+        } else if (kind < 70) {
+            /* 其他类型, 最后一种与 AHRS 帧长度相同 */
+            static const uint8_t types[] = {N300_MSG_IMU, N300_MSG_INS_GPS,
+                                            N300_MSG_RAW_SENSORS,
+                                            N300_MSG_RAW_SENSORS};
+            static const uint8_t lens[] = {56, 72, 16, TEST_AHRS_LEN};
+            uint8_t k = test_rand() % 4;
+            uint8_t payload[72];
+
+            for (uint8_t i = 0; i < lens[k]; ++i) {
+                payload[i] = (uint8_t)test_rand();
+            }
+            len = test_build(buf, types[k], payload, lens[k]);
+            other++;
+        } else if (kind < 80) {
+            /* 数据或帧尾出错, 计入 err_cnt */
+            struct n300_frame frame;
+            uint16_t pos = 7 + test_rand() % (TEST_AHRS_LEN + 1);
+
+            test_build_ahrs(&frame);
+            memcpy(buf, &frame, TEST_FRAME_LEN);
+            buf[pos] ^= (uint8_t)(1U << (test_rand() % 8));
+            len = TEST_FRAME_LEN;
+            corrupt++;
+        } else if (kind < 88) {
+            /* 截断的帧 */
+            struct n300_frame frame;
+
+            test_build_ahrs(&frame);
+            memcpy(buf, &frame, TEST_FRAME_LEN);
+            len = 1 + test_rand() % (TEST_FRAME_LEN - 1);
+            truncated++;
+        } else {
+            /* 噪声, 夹杂帧头字节 */
+            len = 1 + test_rand() % 24;
+            for (uint16_t i = 0; i < len; ++i) {
+                buf[i] = (test_rand() % 3 == 0) ? 0xFC : (uint8_t)test_rand();
+            }
+            noise++;
+        }
+
+        for (uint16_t i = 0; i < len; ++i) {
+            test_dma_put(buf[i]);
+            if (test_rand() % 40 == 0) {
+                test_event(test_wp);
+                events++;
+            }
+        }
+        bytes += len;
+        /* 大多数帧后总线空闲 */
+        if (test_rand() % 4 != 0) {
+            test_event(test_wp);
+            events++;
+        }
+    }
+    test_event(test_wp);
+
+    CHECK(test_seen == test_expect_num);
+    CHECK(test_unchecked < test_expect_num / 100);
+    /* 错误帧之后重新查找帧头时, 截断的帧也可能计入 */
+    CHECK(test_n300.err_cnt >= corrupt);
+    printf("replay dma: %u bytes, %u ahrs frames published, %u other, "
+           "%u corrupt, %u truncated, %u noise, err_cnt %u, %u idle events, "
+           "%u published late\n",
+           bytes, test_expect_num, other, corrupt, truncated, noise,
+           test_n300.err_cnt, events, test_unchecked);
+}
+
+/**
+ * @brief 逐字节解析, 帧长度都与 AHRS 帧相同
+ */
+static void test_prase(void) {
+    static uint8_t stream[TEST_ITEMS * 64];
+    uint32_t len = 0, corrupt = 0;
+
+    memset(&test_n300, 0, sizeof(test_n300));
+    test_seen = 0;
+    test_unchecked = 0;
+    test_expect_num = 0;
+
+    for (uint32_t item = 0; item < TEST_ITEMS / 4; ++item) {
+        uint32_t kind = test_rand() % 10;
+
+        if (kind < 7) {
+            test_build_ahrs(&test_expect[test_expect_num]);
+            memcpy(&stream[len], &test_expect[test_expect_num++],
+                   TEST_FRAME_LEN);
+        } else if (kind < 8) {
+            uint8_t payload[56];
+
+            for (uint8_t i = 0; i < sizeof(payload); ++i) {
+                payload[i] = (uint8_t)test_rand();
+            }
+            test_build(&stream[len], N300_MSG_IMU, payload, sizeof(payload));
+        } else {
+            struct n300_frame frame;
+
+            test_build_ahrs(&frame);
+            memcpy(&stream[len], &frame, TEST_FRAME_LEN);
+            stream[len + 7 + test_rand() % TEST_AHRS_LEN] ^= 0x10;
+            corrupt++;
+        }
+        len += TEST_FRAME_LEN;
+    }
+
+    for (uint32_t pos = 0; pos < len;) {
+        uint32_t n = 1 + test_rand() % 100;
+
+        n = (n > len - pos) ? len - pos : n;
+        test_tick++;
+        n300_prase(&test_n300, &stream[pos], n);
+        test_check_published();
+        pos += n;
+    }
+
+    CHECK(test_seen == test_expect_num && test_unchecked == 0);
+    CHECK(test_n300.err_cnt == corrupt);
+    printf("replay byte parser: %u ahrs frames published, %u corrupt\n",
+           test_expect_num, corrupt);
+}
+
+/**
+ * @brief 模拟 DMA 写入一帧, 跨过半满和全满位置时产生事件, 最后产生空闲事件
+ *
+ * @return 产生的事件数
+ */
+static uint32_t bench_dma_frame(const uint8_t *frame) {
+    uint16_t first = N300_DMA_BUF_SIZE - test_wp;
+    uint16_t wp = test_wp;
+    uint32_t events = 1;
+
+    if (first > TEST_FRAME_LEN) {
+        first = TEST_FRAME_LEN;
+    }
+    memcpy(&test_dma_buf[wp], frame, first);
+    memcpy(test_dma_buf, frame + first, TEST_FRAME_LEN - first);
+    test_wp = (uint16_t)((wp + TEST_FRAME_LEN) % N300_DMA_BUF_SIZE);
+
+    if (wp < N300_DMA_BUF_SIZE / 2 &&
+        wp + TEST_FRAME_LEN >= N300_DMA_BUF_SIZE / 2) {
+        n300_rx_event_callback(&test_n300, &test_uart, N300_DMA_BUF_SIZE / 2);
+        events++;
+    }
+    if (wp + TEST_FRAME_LEN >= N300_DMA_BUF_SIZE) {
+        n300_rx_event_callback(&test_n300, &test_uart, N300_DMA_BUF_SIZE);
+        events++;
+    }
+    n300_rx_event_callback(&test_n300, &test_uart, test_wp);
+    return events;
+}
+
+/**
+ * @brief 每帧解析耗时
+ *
+ * 两种方式每帧都拷贝一次数据: DMA 方式模拟 DMA 写入环形缓冲区,
+ * 逐字节方式与 demo 中 `uart_dmarx_read` 相同, 拷贝到接收缓冲区.
+ * DMA 方式的事件与硬件相同: 每帧一次空闲, 另有半满和全满;
+ * 逐字节方式每帧调用一次 `n300_prase`, 用串口中断接收时还要每字节进一次中断.
+ */
+static void test_bench(void) {
+    static struct n300_frame frames[32];
+    static uint8_t rx_buf[sizeof(struct n300_frame)];
+    double best_dma = 1e9, best_byte = 1e9;
+    volatile float sink = 0;
+    uint32_t events = 0;
+
+    test_start();
+    for (uint32_t i = 0; i < 32; ++i) {
+        test_build_ahrs(&frames[i]);
+    }
+
+    for (uint32_t round = 0; round < BENCH_ROUNDS; ++round) {
+        double t;
+
+        memset(&test_n300, 0, offsetof(n300_handle_t, huart));
+        test_n300.read_pos = 0;
+        test_wp = 0;
+        events = 0;
+        t = test_now();
+        for (uint32_t i = 0; i < BENCH_FRAMES; ++i) {
+            events += bench_dma_frame((const uint8_t *)&frames[i & 31]);
+            sink += test_n300.yaw;
+        }
+        t = test_now() - t;
+        best_dma = t < best_dma ? t : best_dma;
+        CHECK(test_n300.seq == BENCH_FRAMES);
+        CHECK(test_n300.err_cnt == 0);
+
+        memset(&test_n300, 0, offsetof(n300_handle_t, huart));
+        t = test_now();
+        for (uint32_t i = 0; i < BENCH_FRAMES; ++i) {
+            memcpy(rx_buf, &frames[i & 31], TEST_FRAME_LEN);
+            n300_prase(&test_n300, rx_buf, TEST_FRAME_LEN);
+            sink += test_n300.yaw;
+        }
+        t = test_now() - t;
+        best_byte = t < best_byte ? t : best_byte;
+        CHECK(test_n300.seq == BENCH_FRAMES);
+        CHECK(test_n300.err_cnt == 0);
+    }
+
+    printf("bench: in-place %.1f ns/frame, %.2f events/frame; "
+           "byte parser %.1f ns/frame\n",
+           best_dma * 1e9 / BENCH_FRAMES, (double)events / BENCH_FRAMES,
+           best_byte * 1e9 / BENCH_FRAMES);
+    printf("bench: at 100 Hz, %.0f rx interrupts/s with idle-line DMA, "
+           "%u with byte interrupts\n",
+           100.0 * events / BENCH_FRAMES, 100U * TEST_FRAME_LEN);
+    (void)sink;
+}
+
+int main(void) {
+    test_crc();
+    test_replay();
+    test_prase();
+    test_bench();
+    printf("n300: all tests passed\n");
+    return 0;
+}
@@ -0,0 +1,37 @@
+/**
+ * @file    bsp.h
+ * @brief   主机测试用的 HAL 替身, 只包含 n300.c 用到的部分
+ */
+
+#ifndef __BSP_H
+#define __BSP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define HAL_OK       0
+#define DMA_CIRCULAR 0x20U
+
+typedef struct {
+    struct {
+        uint32_t Mode;
+    } Init;
+} DMA_HandleTypeDef;
+
+typedef struct {
+    int Instance;
+    DMA_HandleTypeDef *hdmarx;
+} UART_HandleTypeDef;
+
+extern volatile uint32_t test_tick;
+
+static inline uint32_t HAL_GetTick(void) {
+    return test_tick;
+}
+
+#define __DMB() __sync_synchronize()
+
+int HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *buf,
+                                 uint16_t size);
+
+#endif /* __BSP_H */
@@ -9,16 +9,154 @@
 
 #include "action_position.h"
 #include "math.h"
+#include "string.h"
+
+/* 帧长度: 0x0D 0x0A, 6 个 float, 0x0A 0x0D */
+#define ACT_POS_FRAME_LEN 28
+
 /* 串口通信句柄 */
 static UART_HandleTypeDef *uart_handle = NULL;
-static uint32_t time = 0;
 /**
  * @brief 全场定位数据
  */
 act_pos_data_t g_position_data;
+/* 更新序号, 奇数表示正在更新 */
+static volatile uint32_t g_position_seq;
 
+#if ACT_POS_USE_DMA_RECV
+/* DMA 环形缓冲区 */
+static uint8_t g_dma_buf[ACT_POS_DMA_BUF_SIZE];
+/* 解析位置 */
+static uint16_t g_read_pos;
+#else  /* ACT_POS_USE_DMA_RECV */
 /* 从串口接收到的字符 */
 static uint8_t g_uart_byte;
+#endif /* ACT_POS_USE_DMA_RECV */
+
+/**
+ * @brief 更新全场定位数据
+ *
+ * @param act_val 一帧中的 6 个数据
+ * @note 更新期间序号为奇数, `act_position_read` 据此保证读到完整的一帧.
+ */
+static void act_position_publish(const float *act_val) {
+    static float last_x, last_y;
+    static uint32_t last_time;
+    uint32_t now = ACT_POS_GET_TIMESTAMP();
+    uint8_t first = (g_position_seq == 0);
+    float dx, dy;
+
+    g_position_seq++;
+    __DMB();
+
+    g_position_data.yaw = act_val[0];
+    g_position_data.roll = act_val[1];
+    g_position_data.pitch = act_val[2];
+    g_position_data.x = -act_val[3];
+    g_position_data.y = -act_val[4];
+    g_position_data.yaw_speed = act_val[5];
+    g_position_data.timestamp = now;
+
+    /* 第一帧没有上一次的位置, 速度为 0, 用它作为起点.
+     * 同一时刻收到多帧时, 等时间变化后再按位移计算速度 */
+    if (first) {
+        g_position_data.v = 0.0f;
+        last_x = g_position_data.x;
+        last_y = g_position_data.y;
+        last_time = now;
+    } else if (now != last_time) {
+        dx = g_position_data.x - last_x;
+        dy = g_position_data.y - last_y;
+        g_position_data.v = sqrtf(dx * dx + dy * dy) / (float)(now - last_time);
+        last_x = g_position_data.x;
+        last_y = g_position_data.y;
+        last_time = now;
+    }
+
+    __DMB();
+    g_position_seq++;
+}
+
+#if ACT_POS_USE_DMA_RECV
+
+/**
+ * @brief 环形缓冲区位置后移
+ *
+ * @param pos 位置
+ * @param offset 偏移
+ * @return 新位置
+ */
+static inline uint16_t ring_pos(uint16_t pos, uint16_t offset) {
+    pos += offset;
+    if (pos >= ACT_POS_DMA_BUF_SIZE) {
+        pos -= ACT_POS_DMA_BUF_SIZE;
+    }
+    return pos;
+}
+
+/**
+ * @brief 串口接收事件回调, 空闲, 半满, 全满时进入
+ *
+ * @param huart 串口句柄
+ * @param size DMA 在缓冲区中的写入位置
+ * @note 直接在 DMA 缓冲区上查找帧头帧尾, 只复制一帧中的 24 字节数据.
+ */
+static void uart_rx_event_callback(UART_HandleTypeDef *huart, uint16_t size) {
+    UNUSED(huart);
+
+    /* 数据接收结构 */
+    union {
+        uint8_t recv_data[24];
+        float act_val[6];
+    } data_buffer;
+    uint16_t pos, head, avail, n, first;
+    uint8_t *p;
+
+    head = (size >= ACT_POS_DMA_BUF_SIZE) ? 0 : size;
+    pos = g_read_pos;
+    avail = (head >= pos) ? head - pos : head + ACT_POS_DMA_BUF_SIZE - pos;
+
+    while (avail >= ACT_POS_FRAME_LEN) {
+        if (g_dma_buf[pos] != 0x0D) {
+            /* 在连续的一段内查找帧头 */
+            n = ACT_POS_DMA_BUF_SIZE - pos;
+            if (n > avail) {
+                n = avail;
+            }
+            p = memchr(&g_dma_buf[pos], 0x0D, n);
+            if (p != NULL) {
+                n = (uint16_t)(p - &g_dma_buf[pos]);
+            }
+            pos = ring_pos(pos, n);
+            avail -= n;
+            continue;
+        }
+
+        if (g_dma_buf[ring_pos(pos, 1)] != 0x0A ||
+            g_dma_buf[ring_pos(pos, 26)] != 0x0A ||
+            g_dma_buf[ring_pos(pos, 27)] != 0x0D) {
+            pos = ring_pos(pos, 1);
+            avail--;
+            continue;
+        }
+
+        n = ring_pos(pos, 2);
+        first = ACT_POS_DMA_BUF_SIZE - n;
+        if (first > 24) {
+            first = 24;
+        }
+        memcpy(data_buffer.recv_data, &g_dma_buf[n], first);
+        memcpy(data_buffer.recv_data + first, g_dma_buf, 24 - first);
+        act_position_publish(data_buffer.act_val);
+
+        pos = ring_pos(pos, ACT_POS_FRAME_LEN);
+        avail -= ACT_POS_FRAME_LEN;
+    }
+
+    g_read_pos = pos;
+}
+
+#else  /* ACT_POS_USE_DMA_RECV */
 
 /**
  * @brief 从串口数据读取字节, 转换成坐标数据
@@ -79,16 +217,7 @@ static void uart_receive_callback(UART_HandleTypeDef *huart) {
 
         case 4: {
             if (g_uart_byte == 0x0D) {
-                g_position_data.yaw = data_buffer.act_val[0];
-                g_position_data.roll = data_buffer.act_val[1];
-                g_position_data.pitch = data_buffer.act_val[2];
-                g_position_data.x = -data_buffer.act_val[3];
-                g_position_data.y = -data_buffer.act_val[4];
-                g_position_data.yaw_speed = data_buffer.act_val[5];
-                g_position_data.v = (sqrt(pow(g_position_data.x, 2) +
-                                          pow(g_position_data.y, 2))) /
-                                    (HAL_GetTick() - time);
-                time = HAL_GetTick();
+                act_position_publish(data_buffer.act_val);
             }
             recv_count = 0;
         } break;
@@ -100,22 +229,248 @@ static void uart_receive_callback(UART_HandleTypeDef *huart) {
     HAL_UART_Receive_IT(huart, &g_uart_byte, 1);
 }
 
+#endif /* ACT_POS_USE_DMA_RECV */
+
+#if ACT_POS_USE_CMD_QUEUE
+
+#define ACT_POS_ENTER_CRITICAL()                                               \
+    uint32_t primask = __get_PRIMASK();                                        \
+    __disable_irq()
+#define ACT_POS_EXIT_CRITICAL() __set_PRIMASK(primask)
+
+/* 命令长度: "ACT" + 类型 + 4 字节数据 */
+#define ACT_POS_CMD_LEN   8
+/* 合并后队列中最多只有清零, X, Y, 航向角各一条 */
+#define ACT_POS_CMD_QUEUE 4
+
+/* 未发送的命令, 按提交顺序排列 */
+static uint8_t g_cmd_queue[ACT_POS_CMD_QUEUE][ACT_POS_CMD_LEN];
+static uint8_t g_cmd_count;
+/* 正在发送的命令 */
+static uint8_t g_cmd_tx_buf[ACT_POS_CMD_LEN];
+static volatile uint8_t g_cmd_busy;
+/* `g_cmd_tx_buf` 中的命令没能开始发送, 下次优先发送 */
+static volatile uint8_t g_cmd_retry;
+/* 上一条命令发送完成的时刻 */
+static volatile uint32_t g_cmd_done_tick;
+
+/**
+ * @brief 命令发送完成回调
+ *
+ * @param huart 串口句柄
+ */
+static void uart_tx_cplt_callback(UART_HandleTypeDef *huart) {
+    UNUSED(huart);
+
+    g_cmd_done_tick = HAL_GetTick();
+    g_cmd_busy = 0;
+}
+
+#endif /* ACT_POS_USE_CMD_QUEUE */
+
 /**
  * @brief 注册串口, 将通过这个串口收发数据
  *
- * @param huart
+ * @param huart 串口句柄. 使用 DMA 接收时需要配置循环模式的接收 DMA
+ * @return 0: 成功; 1: 失败
+ * @note 使用 DMA 接收时, 串口出错后 HAL 会停止接收, 可以再次调用重新开始
  */
-void act_position_register_uart(UART_HandleTypeDef *huart) {
+uint8_t act_position_register_uart(UART_HandleTypeDef *huart) {
     if (huart == NULL) {
-        return;
+        return 1;
+    }
+#if ACT_POS_USE_DMA_RECV
+    if (huart->hdmarx == NULL || huart->hdmarx->Init.Mode != DMA_CIRCULAR) {
+        return 1;
     }
+#endif /* ACT_POS_USE_DMA_RECV */
 
     uart_handle = huart;
+#if ACT_POS_USE_DMA_RECV
+    g_read_pos = 0;
+    HAL_UART_RegisterRxEventCallback(huart, uart_rx_event_callback);
+    HAL_UARTEx_ReceiveToIdle_DMA(huart, g_dma_buf, ACT_POS_DMA_BUF_SIZE);
+#else  /* ACT_POS_USE_DMA_RECV */
     HAL_UART_Receive_IT(huart, &g_uart_byte, 1);
     HAL_UART_RegisterCallback(huart, HAL_UART_RX_COMPLETE_CB_ID,
                               uart_receive_callback);
+#endif /* ACT_POS_USE_DMA_RECV */
+
+#if ACT_POS_USE_CMD_QUEUE
+    HAL_UART_RegisterCallback(huart, HAL_UART_TX_COMPLETE_CB_ID,
+                              uart_tx_cplt_callback);
+#endif /* ACT_POS_USE_CMD_QUEUE */
+
+    return 0;
+}
+
+/**
+ * @brief 读取全场定位数据
+ *
+ * @param[out] data 最新数据
+ * @return 收到的帧数, 0 表示还没有收到数据
+ * @note 不关中断, 读取期间数据被更新时重新读取, 保证各个量属于同一帧.
+ */
+uint32_t act_position_read(act_pos_data_t *data) {
+    uint32_t seq;
+
+    do {
+        seq = g_position_seq;
+        __DMB();
+        *data = g_position_data;
+        __DMB();
+    } while ((seq & 1) || seq != g_position_seq);
+
+    return seq >> 1;
+}
+
+#if ACT_POS_USE_CMD_QUEUE
+
+/**
+ * @brief 提交命令
+ *
+ * @param type 命令类型, 'X', 'Y', 'J' 或 '0'
+ * @param value 数据, 清零时不使用
+ * @note 还没有发送的同类命令直接用新数据覆盖; 清零会覆盖之前所有
+ *       未发送的命令, 之后提交的命令不会与清零之前的命令合并.
+ */
+static void act_position_cmd_submit(uint8_t type, float value) {
+    int8_t i = -1;
+
+    ACT_POS_ENTER_CRITICAL();
+    if (type == '0') {
+        g_cmd_count = 0;
+    } else {
+        for (i = (int8_t)g_cmd_count - 1; i >= 0; --i) {
+            if (g_cmd_queue[i][3] == type || g_cmd_queue[i][3] == '0') {
+                break;
+            }
+        }
+    }
+
+    if (i < 0 || g_cmd_queue[i][3] != type) {
+        i = (int8_t)g_cmd_count++;
+    }
+
+    memcpy(g_cmd_queue[i], "ACT", 3);
+    g_cmd_queue[i][3] = type;
+    if (type == '0') {
+        memset(&g_cmd_queue[i][4], 0, 4);
+    } else {
+        memcpy(&g_cmd_queue[i][4], &value, 4);
+    }
+    ACT_POS_EXIT_CRITICAL();
+
+    act_position_cmd_poll();
+}
+
+/**
+ * @brief 发送队列中的下一条命令
+ *
+ * @note 距上一条命令发送完成超过 `ACT_POS_CMD_INTERVAL` 才会发送,
+ *       需要在定时器中断或任务中周期调用 (例如 1 ms).
+ *       关中断期间只取出命令, 开中断后再启动 DMA.
+ *       串口没有发送 DMA 时在这里阻塞发送.
+ */
+void act_position_cmd_poll(void) {
+    uint8_t start = 0;
+
+    if (uart_handle == NULL) {
+        return;
+    }
+
+    ACT_POS_ENTER_CRITICAL();
+    if (g_cmd_busy == 0 &&
+        HAL_GetTick() - g_cmd_done_tick > ACT_POS_CMD_INTERVAL) {
+        if (g_cmd_retry) {
+            start = 1;
+        } else if (g_cmd_count > 0) {
+            memcpy(g_cmd_tx_buf, g_cmd_queue[0], ACT_POS_CMD_LEN);
+            g_cmd_count--;
+            memmove(g_cmd_queue[0], g_cmd_queue[1],
+                    g_cmd_count * ACT_POS_CMD_LEN);
+            start = 1;
+        }
+
+        /* 占住发送缓冲区, 其他调用者不会再取出命令 */
+        if (start) {
+            g_cmd_busy = 1;
+            g_cmd_retry = 0;
+        }
+    }
+    ACT_POS_EXIT_CRITICAL();
+
+    if (start == 0) {
+        return;
+    }
+
+    if (uart_handle->hdmatx == NULL) {
+        if (HAL_UART_Transmit(uart_handle, g_cmd_tx_buf, ACT_POS_CMD_LEN,
+                              0xFFFF) == HAL_OK) {
+            g_cmd_done_tick = HAL_GetTick();
+            g_cmd_busy = 0;
+            return;
+        }
+    } else if (HAL_UART_Transmit_DMA(uart_handle, g_cmd_tx_buf,
+                                     ACT_POS_CMD_LEN) == HAL_OK) {
+        return;
+    }
+
+    /* 串口正在被其他代码使用, 命令留在发送缓冲区, 下次重试 */
+    g_cmd_retry = 1;
+    g_cmd_busy = 0;
+}
+
+/**
+ * @brief 查询还没有发送完的命令数
+ *
+ * @return 命令数, 包括正在发送和等待重试的命令
+ */
+uint8_t act_position_cmd_pending(void) {
+    return g_cmd_count + g_cmd_busy + g_cmd_retry;
 }
 
+/**
+ * @brief 更新X坐标
+ *
+ * @param new_x 新的x
+ * @note 命令放入队列后立即返回, 由 `act_position_cmd_poll` 按间隔发送
+ */
+void act_position_update_x(float new_x) {
+    act_position_cmd_submit('X', new_x);
+}
+
+/**
+ * @brief 更新Y坐标
+ *
+ * @param new_y 新的y
+ * @note 命令放入队列后立即返回, 由 `act_position_cmd_poll` 按间隔发送
+ */
+void act_position_update_y(float new_y) {
+    act_position_cmd_submit('Y', new_y);
+}
+
+/**
+ * @brief 更新航向角(z轴)
+ *
+ * @param new_yaw 新的航向角
+ * @note 命令放入队列后立即返回, 由 `act_position_cmd_poll` 按间隔发送
+ */
+void act_position_update_yaw(float new_yaw) {
+    act_position_cmd_submit('J', new_yaw);
+}
+
+/**
+ * @brief 清空全场定位数据, 从0开始
+ *
+ * @note 命令放入队列后立即返回, 由 `act_position_cmd_poll` 按间隔发送
+ */
+void act_position_reset_data(void) {
+    act_position_cmd_submit('0', 0.0f);
+}
+
+#else  /* ACT_POS_USE_CMD_QUEUE */
+
 /**
  * @brief 字符串拼接, 构造全场定位的发送数据
  *
@@ -200,3 +555,5 @@ void act_position_reset_data(void) {
     HAL_UART_Transmit(uart_handle, update_data, 8, 0xFFFF);
     HAL_Delay(10);
 }
+
+#endif /* ACT_POS_USE_CMD_QUEUE */
@@ -11,6 +11,28 @@
 
 #include "bsp.h"
 
+/* 是否使用 DMA 环形缓冲区 + 空闲中断接收, 默认关闭, 与原来一样每个字节进一次
+   中断. 打开时串口需要配置循环模式的接收 DMA, 否则
+   `act_position_register_uart` 返回失败 */
+#ifndef ACT_POS_USE_DMA_RECV
+#define ACT_POS_USE_DMA_RECV 0
+#endif /* ACT_POS_USE_DMA_RECV */
+/* DMA 环形缓冲区大小 (byte), 至少放得下两帧 (28 byte) */
+#define ACT_POS_DMA_BUF_SIZE 128
+
+/* 是否使用命令队列, 默认关闭, 与原来一样发送命令后延时 10 ms. 打开时命令放入
+   队列后立即返回, 需要在定时器中断或任务中周期调用 `act_position_cmd_poll`
+   (例如 1 ms) 才会发出. 串口配置了发送 DMA 时用 DMA 发送, 否则在
+   `act_position_cmd_poll` 中阻塞发送一条命令 (8 byte, 115200 波特率约 0.7 ms) */
+#ifndef ACT_POS_USE_CMD_QUEUE
+#define ACT_POS_USE_CMD_QUEUE 0
+#endif /* ACT_POS_USE_CMD_QUEUE */
+/* 两条命令之间的最小间隔 (ms) */
+#define ACT_POS_CMD_INTERVAL  10
+
+/* 接收时间戳, 默认为 ms, 可以换成更高精度的计时器 */
+#define ACT_POS_GET_TIMESTAMP() HAL_GetTick()
+
 typedef struct {
     float x;
     float y;
@@ -18,15 +40,22 @@ typedef struct {
     float pitch;
     float yaw;
     float yaw_speed;
-    float v;
+    float v;            /* 速度, 单位为坐标单位 / 时间戳单位, 第一帧为 0 */
+    uint32_t timestamp; /* 接收时刻, 见 `ACT_POS_GET_TIMESTAMP` */
 } act_pos_data_t;
 
 extern act_pos_data_t g_position_data;
 
-void act_position_register_uart(UART_HandleTypeDef *huart);
+uint8_t act_position_register_uart(UART_HandleTypeDef *huart);
+uint32_t act_position_read(act_pos_data_t *data);
 void act_position_update_x(float new_x);
 void act_position_update_y(float new_y);
 void act_position_update_yaw(float new_yaw);
 void act_position_reset_data(void);
 
+#if ACT_POS_USE_CMD_QUEUE
+void act_position_cmd_poll(void);
+uint8_t act_position_cmd_pending(void);
+#endif /* ACT_POS_USE_CMD_QUEUE */
+
 #endif /* __ACTION_POSITION_H */
@@ -0,0 +1,665 @@
+/**
+ * @file    action_position_test.c
+ * @brief   action_position 主机测试. 按 115200 波特率和 200 Hz 输出频率模拟
+ *          全场定位发出的字节流 (有效帧, 帧前的噪声, 帧尾错误的帧和截断的帧),
+ *          逐字节中断或 DMA 半满/全满/空闲事件回放接收, 检查发布的数据;
+ *          统计每秒的接收中断数和从帧最后一个字节收完到数据发布的延迟.
+ *          然后模拟控制循环更新坐标, 由串口模型记录全场定位收到的命令,
+ *          统计命令间隔和调用者被阻塞的时间.
+ *
+ * 在 `Sensor/action_position` 下编译运行, 逐字节中断和 DMA 接收,
+ * 阻塞发送和命令队列的组合各一次:
+ *
+ *   for d in 0 1; do for q in 0 1; do \
+ *       gcc -std=gnu11 -g -O1 -fsanitize=address,undefined -Itest/stub -I. \
+ *           -DACT_POS_USE_DMA_RECV=$d -DACT_POS_USE_CMD_QUEUE=$q \
+ *           test/action_position_test.c action_position.c -lm \
+ *           -o action_position_test && \
+ *       ./action_position_test; \
+ *   done; done
+ *
+ * 噪声, 数据和改错的帧尾都不含 0x0D, 0x0A, 截断的帧至少有一个数据字节,
+ * 这样字节流只有一种分帧方式 (否则截断的帧与下一帧的帧头可能拼成有效帧).
+ *
+ * 检查项:
+ *  - 使用 DMA 接收时, 没有配置循环模式接收 DMA 的串口注册失败
+ *  - 每个有效帧都按顺序发布一次, 坐标取反, 时间戳为发布时的 tick,
+ *    速度与按同样公式计算的结果相同, 第一帧速度为 0;
+ *    噪声, 帧尾错误和截断的帧都不发布, 跨过缓冲区末尾的帧正确解析.
+ *    逐字节解析时截断的帧会吞掉下一帧, 这样的帧允许丢失
+ *  - 逐字节接收时, 每次中断前都重新开始了接收
+ *  - 命令格式正确, 前一条命令发完到下一条开始不少于 `ACT_POS_CMD_INTERVAL`;
+ *    命令全部发完后全场定位的坐标与调用者最后设置的相同
+ *  - 命令队列: 有发送 DMA 和没有 (阻塞发送) 时都能发出, 串口被占用时重试;
+ *    不在关中断期间启动发送, DMA 发送期间缓冲区不被改写;
+ *    串口空闲且已过命令间隔时, 提交后立即开始发送
+ */
+
+#include "action_position.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+/* 串口 8N1, 每字节 10 位 */
+#define TEST_BAUD    115200U
+#define TEST_BYTE_NS (10ULL * 1000000000ULL / TEST_BAUD)
+/* 全场定位的输出频率 (Hz) */
+#define TEST_RATE    200U
+#define TEST_SLOT_NS (1000000000ULL / TEST_RATE)
+/* 回放时长 (输出周期数) */
+#define TEST_SLOTS   200000U
+
+#define TEST_FRAME_LEN 28
+
+/* 命令测试时长 (ms) */
+#define TEST_CMD_MS 60000U
+
+volatile uint32_t test_tick;
+volatile uint32_t test_primask;
+
+static DMA_HandleTypeDef test_dma_rx = {{DMA_CIRCULAR}};
+static DMA_HandleTypeDef test_dma_tx = {{0}};
+static UART_HandleTypeDef test_uart = {1, &test_dma_rx, &test_dma_tx};
+
+static pUART_CallbackTypeDef test_rx_cplt;
+static pUART_CallbackTypeDef test_tx_cplt;
+static pUART_RxEventCallbackTypeDef test_rx_event;
+static uint8_t *test_rx_buf;
+static uint16_t test_rx_size;
+static bool test_rx_armed;
+
+/* 模拟时间 (ns) */
+static uint64_t test_ns;
+#if ACT_POS_USE_DMA_RECV
+/* DMA 写入位置, 上次事件之后是否收到了新数据 */
+static uint16_t test_wp;
+static bool test_new_data;
+#endif /* ACT_POS_USE_DMA_RECV */
+/* 接收中断次数 */
+static uint32_t test_irq;
+
+HAL_StatusTypeDef HAL_UART_RegisterCallback(UART_HandleTypeDef *huart,
+                                            HAL_UART_CallbackIDTypeDef id,
+                                            pUART_CallbackTypeDef callback) {
+    CHECK(huart == &test_uart);
+    if (id == HAL_UART_RX_COMPLETE_CB_ID) {
+        test_rx_cplt = callback;
+    } else if (id == HAL_UART_TX_COMPLETE_CB_ID) {
+        test_tx_cplt = callback;
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef
+HAL_UART_RegisterRxEventCallback(UART_HandleTypeDef *huart,
+                                 pUART_RxEventCallbackTypeDef callback) {
+    CHECK(huart == &test_uart);
+    test_rx_event = callback;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *buf,
+                                      uint16_t size) {
+    CHECK(huart == &test_uart && size == 1);
+    test_rx_buf = buf;
+    test_rx_armed = true;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart,
+                                               uint8_t *buf, uint16_t size) {
+    CHECK(huart == &test_uart);
+    test_rx_buf = buf;
+    test_rx_size = size;
+    return HAL_OK;
+}
+
+static uint32_t test_rand_state = 1;
+
+static uint32_t test_rand(void) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return test_rand_state >> 8;
+}
+
+/**
+ * @brief 帧头帧尾以外的随机字节
+ */
+static uint8_t test_rand_byte(void) {
+    uint8_t byte = (uint8_t)test_rand();
+
+    return (byte == 0x0D || byte == 0x0A) ? 0x55 : byte;
+}
+
+/**
+ * @brief 随机数据, 各字节都不是 0x0D, 0x0A
+ */
+static float test_rand_value(void) {
+    union {
+        float f;
+        uint8_t b[4];
+    } v;
+    bool ok;
+
+    do {
+        v.f = (float)((int32_t)(test_rand() % 2000001U) - 1000000) / 100.0f;
+        ok = true;
+        for (uint32_t i = 0; i < 4; ++i) {
+            ok = ok && v.b[i] != 0x0D && v.b[i] != 0x0A;
+        }
+    } while (!ok);
+    return v.f;
+}
+
+/*****************************************************************************
+ * 发送的帧
+ */
+
+typedef struct {
+    float val[6];
+    uint64_t end_ns; /* 最后一个字节收完的时刻 */
+    bool may_lose;   /* 紧跟在截断的帧之后, 逐字节解析时可能丢失 */
+} test_frame_t;
+
+/* 已发送还没有发布的有效帧 */
+#define TEST_PENDING 16
+static test_frame_t test_pending[TEST_PENDING];
+static uint32_t test_pending_head, test_pending_tail;
+
+/* 已发布的帧数, 检查过的帧数, 允许丢失而丢失的帧数 */
+static uint32_t test_seen, test_published, test_lost;
+/* 速度的计算模型 */
+static float test_last_x, test_last_y, test_last_v;
+static uint32_t test_last_time;
+/* 是否统计延迟, 延迟统计 (ns) */
+static bool test_measure;
+static uint64_t test_latency_sum, test_latency_max;
+static uint32_t test_latency_cnt;
+
+/**
+ * @brief 按发布时刻更新速度模型
+ */
+static void test_update_velocity(const test_frame_t *frame) {
+    float x = -frame->val[3], y = -frame->val[4];
+
+    if (test_published == 0) {
+        test_last_v = 0.0f;
+        test_last_x = x;
+        test_last_y = y;
+        test_last_time = test_tick;
+    } else if (test_tick != test_last_time) {
+        float dx = x - test_last_x, dy = y - test_last_y;
+
+        test_last_v = sqrtf(dx * dx + dy * dy) / (float)(test_tick - test_last_time);
+        test_last_x = x;
+        test_last_y = y;
+        test_last_time = test_tick;
+    }
+}
+
+/**
+ * @brief 检查是否有新发布的数据, 与等待发布的帧比较
+ *
+ * @note 一次事件发布多帧时只能读到最后一帧, 之前的帧只检查帧数
+ */
+static void test_check_published(void) {
+    act_pos_data_t data;
+    uint32_t n = act_position_read(&data);
+    const test_frame_t *frame = NULL;
+
+    if (n == test_seen) {
+        return;
+    }
+    /* 空闲事件推迟时一次事件最多发布两帧 */
+    CHECK(n - test_seen <= 2);
+
+    for (; test_seen != n; ++test_seen) {
+        for (;;) {
+            CHECK(test_pending_tail != test_pending_head);
+            frame = &test_pending[test_pending_tail % TEST_PENDING];
+            test_pending_tail++;
+            if (test_seen + 1 != n ||
+                memcmp(&data.yaw, &frame->val[0], sizeof(float)) == 0) {
+                break;
+            }
+            CHECK(!ACT_POS_USE_DMA_RECV && frame->may_lose);
+            test_lost++;
+        }
+
+        test_update_velocity(frame);
+        test_published++;
+        if (test_measure) {
+            uint64_t latency = test_ns - frame->end_ns;
+
+            test_latency_sum += latency;
+            test_latency_cnt++;
+            if (latency > test_latency_max) {
+                test_latency_max = latency;
+            }
+        }
+    }
+
+    CHECK(data.yaw == frame->val[0]);
+    CHECK(data.roll == frame->val[1]);
+    CHECK(data.pitch == frame->val[2]);
+    CHECK(data.x == -frame->val[3]);
+    CHECK(data.y == -frame->val[4]);
+    CHECK(data.yaw_speed == frame->val[5]);
+    CHECK(data.timestamp == test_tick);
+    CHECK(data.v == test_last_v);
+}
+
+#if ACT_POS_USE_DMA_RECV
+/**
+ * @brief DMA 接收事件中断
+ */
+static void test_dma_event(uint16_t size) {
+    test_irq++;
+    test_new_data = false;
+    test_rx_event(&test_uart, size);
+    test_check_published();
+}
+#endif /* ACT_POS_USE_DMA_RECV */
+
+/**
+ * @brief 收到一个字节: 逐字节接收时进一次中断,
+ *        DMA 接收时写入缓冲区, 写到一半和末尾时产生事件
+ */
+static void test_put_byte(uint8_t byte) {
+    test_ns += TEST_BYTE_NS;
+    test_tick = (uint32_t)(test_ns / 1000000);
+
+#if ACT_POS_USE_DMA_RECV
+    test_rx_buf[test_wp++] = byte;
+    test_new_data = true;
+    if (test_wp == test_rx_size / 2) {
+        test_dma_event(test_wp);
+    } else if (test_wp == test_rx_size) {
+        test_dma_event(test_wp);
+        test_wp = 0;
+    }
+#else  /* ACT_POS_USE_DMA_RECV */
+    CHECK(test_rx_armed);
+    test_rx_armed = false;
+    *test_rx_buf = byte;
+    test_irq++;
+    test_rx_cplt(&test_uart);
+    test_check_published();
+#endif /* ACT_POS_USE_DMA_RECV */
+}
+
+/**
+ * @brief 一段数据发送完, 线路空闲一个字节的时间后产生空闲事件
+ */
+static void test_line_idle(void) {
+    test_ns += TEST_BYTE_NS;
+    test_tick = (uint32_t)(test_ns / 1000000);
+#if ACT_POS_USE_DMA_RECV
+    if (test_new_data) {
+        test_dma_event(test_wp);
+    }
+#endif /* ACT_POS_USE_DMA_RECV */
+}
+
+static void test_register(void) {
+#if ACT_POS_USE_DMA_RECV
+    DMA_HandleTypeDef normal = {{0}};
+    UART_HandleTypeDef no_dma = {1, NULL, &test_dma_tx};
+    UART_HandleTypeDef not_circular = {1, &normal, &test_dma_tx};
+
+    CHECK(act_position_register_uart(&no_dma) == 1);
+    CHECK(act_position_register_uart(&not_circular) == 1);
+#endif /* ACT_POS_USE_DMA_RECV */
+    CHECK(act_position_register_uart(NULL) == 1);
+    CHECK(act_position_register_uart(&test_uart) == 0);
+#if ACT_POS_USE_DMA_RECV
+    CHECK(test_rx_event != NULL && test_rx_size == ACT_POS_DMA_BUF_SIZE);
+#else  /* ACT_POS_USE_DMA_RECV */
+    CHECK(test_rx_cplt != NULL && test_rx_armed);
+#endif /* ACT_POS_USE_DMA_RECV */
+}
+
+/**
+ * @brief 回放: 每个输出周期开始时发出一段数据, 之后线路空闲到下个周期
+ *
+ * @param slots 输出周期数
+ * @param defer_every 使用 DMA 接收时, 平均每多少个周期有一次空闲事件被更高
+ *                    优先级的中断推迟到下个周期的数据之后, 0 表示不推迟
+ */
+static void test_replay(uint32_t slots, uint32_t defer_every) {
+    static uint64_t start_ns;
+    static bool after_trunc;
+    uint32_t sent = 0, noise = 0, corrupt = 0, truncated = 0, deferred = 0;
+    bool defer = false;
+    uint32_t published = test_published, lost = test_lost, irq = test_irq;
+    uint32_t pending = test_pending_head - test_pending_tail;
+
+    test_measure = (defer_every == 0);
+    test_latency_sum = test_latency_max = test_latency_cnt = 0;
+
+    for (uint32_t slot = 0; slot < slots; ++slot) {
+        uint8_t frame[TEST_FRAME_LEN];
+        float val[6];
+        uint32_t kind = test_rand() % 16;
+        uint32_t len = TEST_FRAME_LEN;
+
+        test_ns = start_ns + slot * TEST_SLOT_NS;
+
+        /* 帧前的噪声 */
+        if (test_rand() % 8 == 0) {
+            for (uint32_t n = 1 + test_rand() % 20; n > 0; --n) {
+                test_put_byte(test_rand_byte());
+                noise++;
+            }
+        }
+
+        for (uint32_t i = 0; i < 6; ++i) {
+            val[i] = test_rand_value();
+        }
+        frame[0] = 0x0D;
+        frame[1] = 0x0A;
+        memcpy(&frame[2], val, sizeof(val));
+        frame[26] = 0x0A;
+        frame[27] = 0x0D;
+
+        if (kind == 0) {
+            /* 帧尾错误 */
+            frame[26 + test_rand() % 2] = test_rand_byte();
+            corrupt++;
+        } else if (kind == 1) {
+            /* 发送中断, 只发出帧头和一部分数据 */
+            len = 3 + test_rand() % (TEST_FRAME_LEN - 4);
+            truncated++;
+        } else {
+            test_frame_t *p = &test_pending[test_pending_head % TEST_PENDING];
+
+            CHECK(test_pending_head - test_pending_tail < TEST_PENDING);
+            memcpy(p->val, val, sizeof(val));
+            p->end_ns = test_ns + TEST_FRAME_LEN * TEST_BYTE_NS;
+            p->may_lose = after_trunc;
+            test_pending_head++;
+            sent++;
+        }
+
+        for (uint32_t i = 0; i < len; ++i) {
+            test_put_byte(frame[i]);
+        }
+        if (ACT_POS_USE_DMA_RECV && defer_every != 0 && !defer &&
+            test_rand() % defer_every == 0) {
+            /* 空闲标志保持, 下个周期的数据收完后再进入回调 */
+            defer = true;
+            deferred++;
+        } else {
+            defer = false;
+            test_line_idle();
+        }
+        after_trunc = (kind == 1);
+    }
+    test_line_idle();
+    start_ns += (uint64_t)slots * TEST_SLOT_NS;
+
+    published = test_published - published;
+    lost = test_lost - lost;
+    irq = test_irq - irq;
+    pending += sent;
+
+    /* 等待发布的只剩最后一帧之前可能丢失的帧 */
+    CHECK(test_pending_head - test_pending_tail <= 1);
+    CHECK(published + lost + (test_pending_head - test_pending_tail) == pending);
+    CHECK(lost <= truncated);
+
+    printf("replay %s: %u frames sent, %u published, %u lost after a "
+           "truncated frame; %u noise bytes, %u corrupt, %u truncated",
+           ACT_POS_USE_DMA_RECV ? "dma" : "byte irq", sent, published, lost,
+           noise, corrupt, truncated);
+    if (defer_every != 0) {
+        printf(", %u idle events deferred\n", deferred);
+        return;
+    }
+    printf("\nreplay %s: %.0f rx interrupts/s at %u Hz, latency mean %.1f us, "
+           "max %.1f us\n",
+           ACT_POS_USE_DMA_RECV ? "dma" : "byte irq",
+           irq / (slots / (double)TEST_RATE), TEST_RATE,
+           test_latency_sum / 1e3 / test_latency_cnt, test_latency_max / 1e3);
+}
+
+/*****************************************************************************
+ * 命令发送
+ */
+
+/* 串口发送的模拟: DMA 发送中的命令和完成时刻 */
+static const uint8_t *test_tx_buf;
+static uint64_t test_tx_start_ns, test_tx_done_ns;
+/* 平均每多少次发送遇到串口正被其他代码使用, 0 表示不会 */
+static uint32_t test_tx_busy_every;
+
+/* 全场定位收到的坐标, 调用者设置的坐标 */
+static float test_dev[3], test_want[3];
+/* 收到的命令数, 上一条命令结束的时刻, 命令之间的最小间隔 */
+static uint32_t test_cmd_cnt;
+static uint64_t test_cmd_end_ns, test_cmd_min_gap;
+
+/**
+ * @brief 全场定位收完一条命令
+ *
+ * @param buf 命令
+ * @param start_ns 开始发送的时刻
+ */
+static void test_device_cmd(const uint8_t *buf, uint64_t start_ns) {
+    static const char types[] = "XYJ";
+    float value;
+
+    CHECK(memcmp(buf, "ACT", 3) == 0);
+    if (test_cmd_cnt > 0) {
+        uint64_t gap = start_ns - test_cmd_end_ns;
+
+        CHECK(gap >= ACT_POS_CMD_INTERVAL * 1000000ULL);
+        if (gap < test_cmd_min_gap) {
+            test_cmd_min_gap = gap;
+        }
+    }
+    test_cmd_end_ns = start_ns + 8 * TEST_BYTE_NS;
+    test_cmd_cnt++;
+
+    memcpy(&value, &buf[4], sizeof(value));
+    if (buf[3] == '0') {
+        CHECK(buf[4] == 0 && buf[5] == 0 && buf[6] == 0 && buf[7] == 0);
+        test_dev[0] = test_dev[1] = test_dev[2] = 0.0f;
+    } else {
+        CHECK(buf[3] != 0 && strchr(types, buf[3]) != NULL);
+        test_dev[strchr(types, buf[3]) - types] = value;
+    }
+}
+
+static void test_set_ns(uint64_t ns) {
+    test_ns = ns;
+    test_tick = (uint32_t)(ns / 1000000);
+}
+
+/**
+ * @brief 时间前进, 期间 DMA 发送完成时进入发送完成回调
+ */
+static void test_advance(uint64_t ns) {
+    uint64_t end = test_ns + ns;
+
+    if (test_tx_buf != NULL && test_tx_done_ns <= end) {
+        test_set_ns(test_tx_done_ns);
+        /* 发送期间缓冲区不能被改写, 收完后再按缓冲区内容解析 */
+        test_device_cmd(test_tx_buf, test_tx_start_ns);
+        test_tx_buf = NULL;
+        test_tx_cplt(&test_uart);
+    }
+    test_set_ns(end);
+}
+
+static bool test_tx_busy(void) {
+    return test_tx_buf != NULL ||
+           (test_tx_busy_every != 0 && test_rand() % test_tx_busy_every == 0);
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart,
+                                    const uint8_t *buf, uint16_t size,
+                                    uint32_t timeout) {
+    CHECK(huart == &test_uart && size == 8 && timeout > 0);
+    CHECK(test_primask == 0);
+    if (test_tx_busy()) {
+        return HAL_BUSY;
+    }
+    test_device_cmd(buf, test_ns);
+    test_advance(size * TEST_BYTE_NS);
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart,
+                                        const uint8_t *buf, uint16_t size) {
+    CHECK(huart == &test_uart && huart->hdmatx != NULL && size == 8);
+    /* 不在关中断期间启动 DMA */
+    CHECK(test_primask == 0);
+    if (test_tx_busy()) {
+        return HAL_BUSY;
+    }
+    test_tx_buf = buf;
+    test_tx_start_ns = test_ns;
+    test_tx_done_ns = test_ns + size * TEST_BYTE_NS;
+    return HAL_OK;
+}
+
+void HAL_Delay(uint32_t delay) {
+    test_advance(delay * 1000000ULL);
+}
+
+/**
+ * @brief 全场定位收到的坐标与调用者设置的相同
+ */
+static bool test_cmd_synced(void) {
+    return memcmp(test_dev, test_want, sizeof(test_dev)) == 0;
+}
+
+/**
+ * @brief 控制循环约每 1 ms 调用一次 `act_position_cmd_poll`, 平均每 50 次
+ *        连续更新 1~4 个坐标, 统计命令间隔, 调用者被阻塞的时间,
+ *        以及从设置坐标到全场定位收到的时间
+ *
+ * @param name 名称
+ * @param hdmatx 串口的发送 DMA
+ * @param busy_every 平均每多少次发送遇到串口被占用, 0 表示不会
+ */
+static void test_cmd(const char *name, DMA_HandleTypeDef *hdmatx,
+                     uint32_t busy_every) {
+    uint32_t calls = 0, cmds = test_cmd_cnt;
+    uint64_t caller_sum = 0, caller_max = 0, dirty_ns = 0;
+    uint64_t sync_sum = 0, sync_max = 0;
+    uint32_t syncs = 0;
+    bool dirty = false;
+
+    test_uart.hdmatx = hdmatx;
+    test_tx_busy_every = busy_every;
+    test_cmd_min_gap = UINT64_MAX;
+    CHECK(act_position_register_uart(&test_uart) == 0);
+
+    for (uint32_t ms = 0; ms < TEST_CMD_MS || dirty; ++ms) {
+        /* 命令在 1 s 内没有发完 */
+        CHECK(ms < TEST_CMD_MS + 1000);
+        /* 调用周期有抖动, 与 tick 的相位不固定 */
+        test_advance(500000 + test_rand() % 1000000);
+#if ACT_POS_USE_CMD_QUEUE
+        act_position_cmd_poll();
+#endif /* ACT_POS_USE_CMD_QUEUE */
+
+        if (ms < TEST_CMD_MS && test_rand() % 50 == 0) {
+            for (uint32_t n = 1 + test_rand() % 4; n > 0; --n) {
+                uint32_t type = test_rand() % 8;
+                float value = test_rand_value();
+                uint64_t start = test_ns, t;
+                uint32_t sent = test_cmd_cnt;
+#if ACT_POS_USE_CMD_QUEUE
+                /* 串口空闲且已过了命令间隔, 命令应当立即开始发送 */
+                bool idle = busy_every == 0 &&
+                            act_position_cmd_pending() == 0 &&
+                            test_ns - test_cmd_end_ns >
+                                (ACT_POS_CMD_INTERVAL + 1) * 1000000ULL;
+#endif /* ACT_POS_USE_CMD_QUEUE */
+
+                if (!dirty) {
+                    dirty = true;
+                    dirty_ns = test_ns;
+                }
+                if (type < 3) {
+                    act_position_update_x(value);
+                    test_want[0] = value;
+                } else if (type < 5) {
+                    act_position_update_y(value);
+                    test_want[1] = value;
+                } else if (type < 7) {
+                    act_position_update_yaw(value);
+                    test_want[2] = value;
+                } else {
+                    act_position_reset_data();
+                    test_want[0] = test_want[1] = test_want[2] = 0.0f;
+                }
+                CHECK(test_primask == 0);
+#if ACT_POS_USE_CMD_QUEUE
+                CHECK(!idle || test_tx_buf != NULL || test_cmd_cnt != sent);
+#else  /* ACT_POS_USE_CMD_QUEUE */
+                CHECK(test_cmd_cnt == sent + 1);
+#endif /* ACT_POS_USE_CMD_QUEUE */
+
+                t = test_ns - start;
+                caller_sum += t;
+                caller_max = (t > caller_max) ? t : caller_max;
+                calls++;
+            }
+        }
+
+#if ACT_POS_USE_CMD_QUEUE
+        if (dirty && act_position_cmd_pending() == 0) {
+#else  /* ACT_POS_USE_CMD_QUEUE */
+        if (dirty) {
+#endif /* ACT_POS_USE_CMD_QUEUE */
+            uint64_t t = test_ns - dirty_ns;
+
+            CHECK(test_cmd_synced());
+            sync_sum += t;
+            sync_max = (t > sync_max) ? t : sync_max;
+            syncs++;
+            dirty = false;
+        }
+    }
+    cmds = test_cmd_cnt - cmds;
+
+    printf("cmd %s: %u calls, %u commands sent, min gap %.2f ms; "
+           "caller blocked mean %.1f us, max %.1f us; synced after mean "
+           "%.1f ms, max %.1f ms\n",
+           name, calls, cmds, test_cmd_min_gap / 1e6, caller_sum / 1e3 / calls,
+           caller_max / 1e3, sync_sum / 1e6 / syncs, sync_max / 1e6);
+}
+
+int main(void) {
+    test_register();
+    test_replay(TEST_SLOTS, 0);
+#if ACT_POS_USE_DMA_RECV
+    test_replay(TEST_SLOTS, 16);
+#endif /* ACT_POS_USE_DMA_RECV */
+
+#if ACT_POS_USE_CMD_QUEUE
+    test_cmd("queue, tx dma", &test_dma_tx, 0);
+    test_cmd("queue, tx dma, uart busy 1/4", &test_dma_tx, 4);
+    test_cmd("queue, no tx dma", NULL, 0);
+    test_cmd("queue, no tx dma, uart busy 1/4", NULL, 4);
+#else  /* ACT_POS_USE_CMD_QUEUE */
+    test_cmd("blocking", &test_dma_tx, 0);
+#endif /* ACT_POS_USE_CMD_QUEUE */
+
+    printf("action_position: all tests passed\n");
+    return 0;
+}
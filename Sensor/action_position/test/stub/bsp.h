@@ -0,0 +1,81 @@
+/**
+ * @file    bsp.h
+ * @brief   主机测试用的 HAL 替身, 只包含 action_position.c 用到的部分
+ */
+
+#ifndef __BSP_H
+#define __BSP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define HAL_OK       0
+#define HAL_BUSY     2
+#define DMA_CIRCULAR 0x20U
+
+#define UNUSED(x) ((void)(x))
+
+typedef int HAL_StatusTypeDef;
+
+typedef struct {
+    struct {
+        uint32_t Mode;
+    } Init;
+} DMA_HandleTypeDef;
+
+typedef struct __UART_HandleTypeDef {
+    int Instance;
+    DMA_HandleTypeDef *hdmarx;
+    DMA_HandleTypeDef *hdmatx;
+} UART_HandleTypeDef;
+
+typedef enum {
+    HAL_UART_TX_COMPLETE_CB_ID,
+    HAL_UART_RX_COMPLETE_CB_ID
+} HAL_UART_CallbackIDTypeDef;
+
+typedef void (*pUART_CallbackTypeDef)(UART_HandleTypeDef *huart);
+typedef void (*pUART_RxEventCallbackTypeDef)(UART_HandleTypeDef *huart,
+                                             uint16_t Pos);
+
+extern volatile uint32_t test_tick;
+/* 1: 中断已关闭 */
+extern volatile uint32_t test_primask;
+
+static inline uint32_t HAL_GetTick(void) {
+    return test_tick;
+}
+
+static inline uint32_t __get_PRIMASK(void) {
+    return test_primask;
+}
+
+static inline void __set_PRIMASK(uint32_t primask) {
+    test_primask = primask;
+}
+
+static inline void __disable_irq(void) {
+    test_primask = 1;
+}
+
+#define __DMB() __sync_synchronize()
+
+void HAL_Delay(uint32_t delay);
+
+HAL_StatusTypeDef HAL_UART_RegisterCallback(UART_HandleTypeDef *huart,
+                                            HAL_UART_CallbackIDTypeDef id,
+                                            pUART_CallbackTypeDef callback);
+HAL_StatusTypeDef
+HAL_UART_RegisterRxEventCallback(UART_HandleTypeDef *huart,
+                                 pUART_RxEventCallbackTypeDef callback);
+HAL_StatusTypeDef HAL_UART_Receive_IT(UART_HandleTypeDef *huart, uint8_t *buf,
+                                      uint16_t size);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart,
+                                               uint8_t *buf, uint16_t size);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart,
+                                    const uint8_t *buf, uint16_t size,
+                                    uint32_t timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart,
+                                        const uint8_t *buf, uint16_t size);
+
+#endif /* __BSP_H */
@@ -34,6 +34,37 @@ typedef struct {
     astar_is_walkable_cb_t is_walkable; /*!< 碰撞检测回调函数 */
 } astar_config_t;
 
+/**
+ * @brief 开放表(二叉小顶堆)元素
+ */
+typedef struct {
+    uint16_t id; /*!< 节点索引 id（0~MAX_NODES-1） */
+    uint16_t f;  /*!< 对应节点的 f 值 */
+} astar_open_node_t;
+
+/**
+ * @brief A* 规划上下文，保存一次规划的全部状态
+ * @note 每个上下文拥有独立的节点数组和开放表，不同上下文可以同时规划。
+ *       节点按代号(generation)惰性初始化：stamp[n] 不等于当前代号的节点
+ *       视为未访问，每次规划只初始化实际访问到的节点。
+ *       全部清零的上下文即为有效的初始状态。
+ */
+typedef struct {
+    const astar_config_t *cfg;                   /*!< 当前环境配置 */
+    uint16_t generation;                         /*!< 当前规划代号 */
+    uint16_t stamp[ASTAR_MAX_NODES];             /*!< 节点初始化时的代号 */
+    uint16_t came_from[ASTAR_MAX_NODES];         /*!< 到达节点 n 的前驱节点 id */
+    uint16_t g_score[ASTAR_MAX_NODES];           /*!< 起点到节点 n 的最小已知代价 */
+    uint8_t closed_set[ASTAR_MAX_NODES];         /*!< 节点完成扩展标志 */
+    int16_t open_pos[ASTAR_MAX_NODES];           /*!< 节点在堆中的位置 */
+    astar_open_node_t open_list[ASTAR_MAX_NODES]; /*!< 开放表（二叉小顶堆） */
+    int open_count;                              /*!< 开放表当前元素个数 */
+} astar_ctx_t;
+
+void astar_ctx_init(astar_ctx_t *ctx);
+int astar_find_path_ctx(astar_ctx_t *ctx, const astar_config_t *config,
+                        int start_row, int start_col, int goal_row,
+                        int goal_col, uint16_t *path_out, int max_len);
 int astar_find_path(const astar_config_t *config, int start_row, int start_col,
                     int goal_row, int goal_col, uint16_t *path_out,
                     int max_len);
@@ -190,27 +190,142 @@ float buffer_get_float32_auto(const uint8_t *buffer, int32_t *index) {
     return ldexpf(sig, e);
 }
 
+/**
+ * @brief Get 2^bits - 1.
+ *
+ * @param bits Bit width, 1 ~ 32.
+ * @return The max value of the bit width.
+ */
+static inline uint32_t bits_mask(uint8_t bits) {
+    return (bits >= 32) ? 0xFFFFFFFFU : ((1U << bits) - 1U);
+}
+
+/**
+ * @brief Converts a float to an unsigned int, given range and number of bits.
+ *        Single precision only, same as `fixed_codec_encode()`. Out of range
+ *        values are saturated. Use a precomputed `fixed_codec_t` in loops to
+ *        save the division.
+ *
+ * @param x The value to encode.
+ * @param x_min The value encoded as 0.
+ * @param x_max The value encoded as 2^bits - 1.
+ * @param bits Bit width, 1 ~ 32.
+ * @return Encoded value.
+ */
 int float_to_uint(float x, float x_min, float x_max, uint8_t bits) {
-    // Converts a float to an unsigned int, given range and number of bits
-    float span = x_max - x_min;
-    float offset = x_min;
-    unsigned int pgg = 0;
-    if (bits == 12) {
-        pgg = (unsigned int)((x - offset) * 4095.0 / span);
-    } else if (bits == 16) {
-        pgg = (unsigned int)((x - offset) * 65535.0 / span);
-    }
-    return pgg;
+    fixed_codec_t codec;
+    fixed_codec_init(&codec, x_min, x_max, bits);
+    return (int)fixed_codec_encode(&codec, x);
 }
 
+/**
+ * @brief Converts an unsigned int to a float, given range and number of bits.
+ *        Single precision only, same as `fixed_codec_decode()`.
+ *
+ * @param x_int The value to decode.
+ * @param x_min The value encoded as 0.
+ * @param x_max The value encoded as 2^bits - 1.
+ * @param bits Bit width, 1 ~ 32.
+ * @return Decoded value.
+ */
 float uint_to_float(int x_int, float x_min, float x_max, uint8_t bits) {
-    float span = x_max - x_min;
-    float offset = x_min;
-    float pgg = 0;
-    if (bits == 12) {
-        pgg = ((float)x_int) * span / 4095.0 + offset;
-    } else if (bits == 16) {
-        pgg = ((float)x_int) * span / 65535.0 + offset;
+    fixed_codec_t codec;
+    fixed_codec_init(&codec, x_min, x_max, bits);
+    return fixed_codec_decode(&codec, (uint32_t)x_int);
+}
+
+/**
+ * @brief Initialize a fixed-width field codec.
+ *
+ * @param codec The codec to initialize.
+ * @param x_min The value encoded as 0.
+ * @param x_max The value encoded as 2^bits - 1.
+ * @param bits Bit width, 1 ~ 32.
+ */
+void fixed_codec_init(fixed_codec_t *codec, float x_min, float x_max,
+                      uint8_t bits) {
+    if (bits == 0) {
+        bits = 1;
+    } else if (bits > 32) {
+        bits = 32;
     }
-    return pgg;
+
+    float span = x_max - x_min;
+
+    codec->mask = bits_mask(bits);
+    codec->max = (float)codec->mask;
+    codec->offset = x_min;
+    codec->scale = (span != 0.0f) ? codec->max / span : 0.0f;
+    codec->inv_scale = span / codec->max;
+}
+
+/**
+ * @brief Initialize the MIT frame codecs. Position, speed and torque are
+ *        symmetric, kp and kd start from 0.
+ *
+ * @param codec The codecs to initialize.
+ * @param pos_limit Position absolute limit.
+ * @param spd_limit Speed absolute limit.
+ * @param kp_max Max kp.
+ * @param kd_max Max kd.
+ * @param torque_limit Torque absolute limit.
+ */
+void mit_codec_init(mit_codec_t *codec, float pos_limit, float spd_limit,
+                    float kp_max, float kd_max, float torque_limit) {
+    fixed_codec_init(&codec->pos, -pos_limit, pos_limit, 16);
+    fixed_codec_init(&codec->spd, -spd_limit, spd_limit, 12);
+    fixed_codec_init(&codec->kp, 0.0f, kp_max, 12);
+    fixed_codec_init(&codec->kd, 0.0f, kd_max, 12);
+    fixed_codec_init(&codec->torque, -torque_limit, torque_limit, 12);
+}
+
+/**
+ * @brief Pack a MIT command frame.
+ *        | pos 16 | spd 12 | kp 12 | kd 12 | torque 12 |, big endian.
+ *
+ * @param codec The codecs.
+ * @param[out] buffer 8 bytes frame.
+ * @param pos Position.
+ * @param spd Speed.
+ * @param kp Kp.
+ * @param kd Kd.
+ * @param torque Torque.
+ */
+void mit_pack_cmd(const mit_codec_t *codec, uint8_t *buffer, float pos,
+                  float spd, float kp, float kd, float torque) {
+    uint32_t pos_int = fixed_codec_encode(&codec->pos, pos);
+    uint32_t spd_int = fixed_codec_encode(&codec->spd, spd);
+    uint32_t kp_int = fixed_codec_encode(&codec->kp, kp);
+    uint32_t kd_int = fixed_codec_encode(&codec->kd, kd);
+    uint32_t torque_int = fixed_codec_encode(&codec->torque, torque);
+
+    buffer[0] = pos_int >> 8;
+    buffer[1] = pos_int;
+    buffer[2] = spd_int >> 4;
+    buffer[3] = ((spd_int & 0xF) << 4) | (kp_int >> 8);
+    buffer[4] = kp_int;
+    buffer[5] = kd_int >> 4;
+    buffer[6] = ((kd_int & 0xF) << 4) | (torque_int >> 8);
+    buffer[7] = torque_int;
+}
+
+/**
+ * @brief Unpack the position, speed and torque of a MIT feedback frame.
+ *        | pos 16 | spd 12 | torque 12 |, big endian.
+ *
+ * @param codec The codecs.
+ * @param buffer 5 bytes data, starting from the position high byte.
+ * @param[out] pos Position.
+ * @param[out] spd Speed.
+ * @param[out] torque Torque.
+ */
+void mit_unpack_feedback(const mit_codec_t *codec, const uint8_t *buffer,
+                         float *pos, float *spd, float *torque) {
+    uint32_t pos_int = ((uint32_t)buffer[0] << 8) | buffer[1];
+    uint32_t spd_int = ((uint32_t)buffer[2] << 4) | (buffer[3] >> 4);
+    uint32_t torque_int = ((uint32_t)(buffer[3] & 0x0F) << 8) | buffer[4];
+
+    *pos = fixed_codec_decode(&codec->pos, pos_int);
+    *spd = fixed_codec_decode(&codec->spd, spd_int);
+    *torque = fixed_codec_decode(&codec->torque, torque_int);
 }
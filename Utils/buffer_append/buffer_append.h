@@ -51,6 +51,72 @@ float buffer_get_float32_auto(const uint8_t *buffer, int32_t *index);
 int float_to_uint(float x, float x_min, float x_max, uint8_t bits);
 float uint_to_float(int x_int, float x_min, float x_max, uint8_t bits);
 
+/**
+ * @brief Fixed-width field codec, maps [x_min, x_max] to [0, 2^bits - 1].
+ *        The scale and offset are calculated once, encode and decode only use
+ *        single precision multiply and add.
+ */
+typedef struct {
+    float offset;    /*!< x_min.                        */
+    float scale;     /*!< (2^bits - 1) / (x_max - x_min). */
+    float inv_scale; /*!< (x_max - x_min) / (2^bits - 1). */
+    float max;       /*!< 2^bits - 1 in float.          */
+    uint32_t mask;   /*!< 2^bits - 1.                   */
+} fixed_codec_t;
+
+/**
+ * @brief Codecs of the MIT frame fields. Position 16 bits, others 12 bits.
+ */
+typedef struct {
+    fixed_codec_t pos;    /*!< Position codec.       */
+    fixed_codec_t spd;    /*!< Speed codec.          */
+    fixed_codec_t kp;     /*!< Kp codec.             */
+    fixed_codec_t kd;     /*!< Kd codec.             */
+    fixed_codec_t torque; /*!< Torque codec.         */
+} mit_codec_t;
+
+void fixed_codec_init(fixed_codec_t *codec, float x_min, float x_max,
+                      uint8_t bits);
+
+/**
+ * @brief Encode a float to unsigned int, saturated to [0, 2^bits - 1].
+ *
+ * @param codec The codec.
+ * @param x The value to encode.
+ * @return Encoded value.
+ */
+static inline uint32_t fixed_codec_encode(const fixed_codec_t *codec,
+                                          float x) {
+    float v = (x - codec->offset) * codec->scale;
+
+    if (v <= 0.0f) {
+        return 0;
+    }
+    if (v >= codec->max) {
+        return codec->mask;
+    }
+    return (uint32_t)v;
+}
+
+/**
+ * @brief Decode an unsigned int to float.
+ *
+ * @param codec The codec.
+ * @param x_int The value to decode.
+ * @return Decoded value.
+ */
+static inline float fixed_codec_decode(const fixed_codec_t *codec,
+                                       uint32_t x_int) {
+    return (float)x_int * codec->inv_scale + codec->offset;
+}
+
+void mit_codec_init(mit_codec_t *codec, float pos_limit, float spd_limit,
+                    float kp_max, float kd_max, float torque_limit);
+void mit_pack_cmd(const mit_codec_t *codec, uint8_t *buffer, float pos,
+                  float spd, float kp, float kd, float torque);
+void mit_unpack_feedback(const mit_codec_t *codec, const uint8_t *buffer,
+                         float *pos, float *spd, float *torque);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
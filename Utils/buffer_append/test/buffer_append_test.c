@@ -0,0 +1,303 @@
+/**
+ * @file    buffer_append_test.c
+ * @brief   Host test of the fixed-width field codec. `float_to_uint` and
+ *          `uint_to_float` are compared with the previous double precision
+ *          implementation, then the time per call is measured.
+ *
+ * Build and run in `Utils/buffer_append`:
+ *
+ *   gcc -std=gnu11 -g -O2 -I. test/buffer_append_test.c buffer_append.c \
+ *       -lm -o buffer_append_test && ./buffer_append_test
+ *
+ * Checks:
+ *  - Encoding differs from the previous functions by at most 1 LSB inside the
+ *    range. The previous functions truncate `(x - x_min) * 4095.0 / span` in
+ *    double, the new ones `(x - x_min) * (4095.0f / span)` in float, so values
+ *    which land within a float rounding error of a step may go either way.
+ *  - Decoding differs by at most a few float ulp.
+ *  - Values outside the range are saturated (the previous functions returned
+ *    wrapped values there).
+ *  - `mit_pack_cmd` and `mit_unpack_feedback` give the same fields as the
+ *    scalar functions.
+ *
+ * On the host the benchmark only shows the call overhead: double arithmetic
+ * is done in hardware there and both functions cost one division, so
+ * `float_to_uint` is a little slower than the previous function because of
+ * the range checks (about 4 ns vs 3.3 ns on x86-64). On a Cortex-M4F the
+ * division is a 14 cycle VDIV.F32, while the previous functions call the
+ * software double subtract, multiply and divide. The precomputed codec
+ * (`mit_pack_cmd`) has no division at all.
+ */
+
+#include "buffer_append.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+/* Random samples of each range. */
+#define TEST_SAMPLES    1000000
+/* Calls of each benchmark loop. */
+#define BENCH_CALLS     10000000
+
+/*****************************************************************************
+ * Previous implementation, not inlined so that it is called like the library
+ * functions.
+ */
+
+__attribute__((noinline)) static int
+legacy_float_to_uint(float x, float x_min, float x_max, uint8_t bits) {
+    float span = x_max - x_min;
+    float offset = x_min;
+    unsigned int pgg = 0;
+    if (bits == 12) {
+        pgg = (unsigned int)((x - offset) * 4095.0 / span);
+    } else if (bits == 16) {
+        pgg = (unsigned int)((x - offset) * 65535.0 / span);
+    }
+    return pgg;
+}
+
+__attribute__((noinline)) static float
+legacy_uint_to_float(int x_int, float x_min, float x_max, uint8_t bits) {
+    float span = x_max - x_min;
+    float offset = x_min;
+    float pgg = 0;
+    if (bits == 12) {
+        pgg = ((float)x_int) * span / 4095.0 + offset;
+    } else if (bits == 16) {
+        pgg = ((float)x_int) * span / 65535.0 + offset;
+    }
+    return pgg;
+}
+
+/*****************************************************************************
+ * Accuracy
+ */
+
+typedef struct {
+    float x_min;
+    float x_max;
+    uint8_t bits;
+} test_range_t;
+
+/* Ranges of the Damiao MIT frame fields. */
+static const test_range_t test_range[] = {
+    {-12.5f, 12.5f, 16}, {-3.141593f, 3.141593f, 16}, {-30.0f, 30.0f, 12},
+    {-45.0f, 45.0f, 12}, {0.0f, 500.0f, 12},          {0.0f, 5.0f, 12},
+    {-10.0f, 10.0f, 12}, {-18.0f, 18.0f, 12},         {-54.0f, 54.0f, 12},
+};
+
+#define TEST_RANGE_NUMBER (sizeof(test_range) / sizeof(test_range[0]))
+
+static uint32_t test_rand_state = 1;
+
+/* [0, 1) */
+static float test_rand(void) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return (float)(test_rand_state >> 8) / (float)(1U << 24);
+}
+
+/**
+ * @brief Compare one range with the previous functions.
+ *
+ * @param range The range.
+ * @param[out] encode_diff Encoded values differing by 1 LSB.
+ * @param[out] encode_total Encoded values compared.
+ * @param[out] decode_ulp Largest decoding difference in float ulp.
+ */
+static void test_accuracy_range(const test_range_t *range,
+                                uint32_t *encode_diff, uint32_t *encode_total,
+                                float *decode_ulp) {
+    uint32_t mask = (1U << range->bits) - 1U;
+    float span = range->x_max - range->x_min;
+
+    /* Random values inside the range, and every decoded step which is the
+       worst case for truncation. */
+    for (uint32_t i = 0; i < TEST_SAMPLES + mask + 1; ++i) {
+        float x;
+
+        if (i < TEST_SAMPLES) {
+            x = range->x_min + test_rand() * span;
+        } else {
+            x = legacy_uint_to_float((int)(i - TEST_SAMPLES), range->x_min,
+                                     range->x_max, range->bits);
+            if (x < range->x_min || x > range->x_max) {
+                continue;
+            }
+        }
+
+        int legacy = legacy_float_to_uint(x, range->x_min, range->x_max,
+                                          range->bits);
+        int now = float_to_uint(x, range->x_min, range->x_max, range->bits);
+
+        CHECK(now >= 0 && (uint32_t)now <= mask);
+        CHECK(abs(now - legacy) <= 1);
+        *encode_diff += (now != legacy);
+        ++*encode_total;
+    }
+
+    for (uint32_t x_int = 0; x_int <= mask; ++x_int) {
+        float legacy = legacy_uint_to_float((int)x_int, range->x_min,
+                                            range->x_max, range->bits);
+        float now = uint_to_float((int)x_int, range->x_min, range->x_max,
+                                  range->bits);
+        float ulp = nextafterf(fmaxf(fabsf(range->x_min),
+                                     fabsf(range->x_max)),
+                               INFINITY) -
+                    fmaxf(fabsf(range->x_min), fabsf(range->x_max));
+        float diff = fabsf(now - legacy) / ulp;
+
+        CHECK(diff <= 2.0f);
+        if (diff > *decode_ulp) {
+            *decode_ulp = diff;
+        }
+
+        /* Round trip stays on the same step. */
+        CHECK(abs(float_to_uint(now, range->x_min, range->x_max,
+                                range->bits) -
+                  (int)x_int) <= 1);
+    }
+
+    /* Saturation. */
+    CHECK(float_to_uint(range->x_min - span, range->x_min, range->x_max,
+                        range->bits) == 0);
+    CHECK(float_to_uint(range->x_max + span, range->x_min, range->x_max,
+                        range->bits) == (int)mask);
+    CHECK(float_to_uint(range->x_min, range->x_min, range->x_max,
+                        range->bits) == 0);
+}
+
+static void test_accuracy(void) {
+    uint32_t encode_diff = 0, encode_total = 0;
+    float decode_ulp = 0.0f;
+
+    for (uint32_t r = 0; r < TEST_RANGE_NUMBER; ++r) {
+        test_accuracy_range(&test_range[r], &encode_diff, &encode_total,
+                            &decode_ulp);
+    }
+
+    printf("accuracy: encode %u of %u values differ by 1 LSB (%.4f%%), "
+           "decode within %.1f ulp\n",
+           encode_diff, encode_total, 100.0 * encode_diff / encode_total,
+           decode_ulp);
+}
+
+/**
+ * @brief The MIT frame codec packs the same fields as the scalar functions.
+ */
+static void test_mit(void) {
+    mit_codec_t codec;
+    uint8_t buffer[8];
+
+    mit_codec_init(&codec, 12.5f, 30.0f, 500.0f, 5.0f, 10.0f);
+
+    for (uint32_t i = 0; i < TEST_SAMPLES; ++i) {
+        float pos = (test_rand() * 2.0f - 1.0f) * 13.0f;
+        float spd = (test_rand() * 2.0f - 1.0f) * 31.0f;
+        float kp = test_rand() * 510.0f;
+        float kd = test_rand() * 5.1f;
+        float torque = (test_rand() * 2.0f - 1.0f) * 11.0f;
+        float pos_out, spd_out, torque_out;
+
+        uint32_t pos_int = (uint32_t)float_to_uint(pos, -12.5f, 12.5f, 16);
+        uint32_t spd_int = (uint32_t)float_to_uint(spd, -30.0f, 30.0f, 12);
+        uint32_t kp_int = (uint32_t)float_to_uint(kp, 0.0f, 500.0f, 12);
+        uint32_t kd_int = (uint32_t)float_to_uint(kd, 0.0f, 5.0f, 12);
+        uint32_t torque_int =
+            (uint32_t)float_to_uint(torque, -10.0f, 10.0f, 12);
+
+        mit_pack_cmd(&codec, buffer, pos, spd, kp, kd, torque);
+        CHECK(((uint32_t)buffer[0] << 8 | buffer[1]) == pos_int);
+        CHECK(((uint32_t)buffer[2] << 4 | buffer[3] >> 4) == spd_int);
+        CHECK(((uint32_t)(buffer[3] & 0x0F) << 8 | buffer[4]) == kp_int);
+        CHECK(((uint32_t)buffer[5] << 4 | buffer[6] >> 4) == kd_int);
+        CHECK(((uint32_t)(buffer[6] & 0x0F) << 8 | buffer[7]) == torque_int);
+
+        /* The feedback frame has the same layout without kp and kd. */
+        buffer[3] = (uint8_t)((spd_int & 0x0F) << 4 | torque_int >> 8);
+        buffer[4] = (uint8_t)torque_int;
+        mit_unpack_feedback(&codec, buffer, &pos_out, &spd_out, &torque_out);
+        CHECK(pos_out == uint_to_float((int)pos_int, -12.5f, 12.5f, 16));
+        CHECK(spd_out == uint_to_float((int)spd_int, -30.0f, 30.0f, 12));
+        CHECK(torque_out ==
+              uint_to_float((int)torque_int, -10.0f, 10.0f, 12));
+    }
+
+    printf("mit frame: ok\n");
+}
+
+/*****************************************************************************
+ * Benchmark
+ */
+
+static float bench_input[1024];
+static volatile uint32_t bench_sink;
+/* The range is read at run time, as the motor limits are. */
+static volatile float bench_limit = 30.0f;
+
+static double test_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void test_bench(void) {
+    fixed_codec_t codec;
+    float limit = bench_limit;
+    uint32_t sum;
+    double start, legacy_ns, scalar_ns, codec_ns;
+
+    for (uint32_t i = 0; i < 1024; ++i) {
+        bench_input[i] = (test_rand() * 2.0f - 1.0f) * 30.0f;
+    }
+    fixed_codec_init(&codec, -limit, limit, 12);
+
+    sum = 0;
+    start = test_now();
+    for (uint32_t i = 0; i < BENCH_CALLS; ++i) {
+        sum += (uint32_t)legacy_float_to_uint(bench_input[i & 1023], -limit,
+                                              limit, 12);
+    }
+    legacy_ns = (test_now() - start) / BENCH_CALLS;
+    bench_sink = sum;
+
+    sum = 0;
+    start = test_now();
+    for (uint32_t i = 0; i < BENCH_CALLS; ++i) {
+        sum += (uint32_t)float_to_uint(bench_input[i & 1023], -limit, limit,
+                                       12);
+    }
+    scalar_ns = (test_now() - start) / BENCH_CALLS;
+    bench_sink = sum;
+
+    sum = 0;
+    start = test_now();
+    for (uint32_t i = 0; i < BENCH_CALLS; ++i) {
+        sum += fixed_codec_encode(&codec, bench_input[i & 1023]);
+    }
+    codec_ns = (test_now() - start) / BENCH_CALLS;
+    bench_sink = sum;
+
+    printf("encode: previous %.2f ns, float_to_uint %.2f ns, "
+           "precomputed codec %.2f ns\n",
+           legacy_ns, scalar_ns, codec_ns);
+}
+
+int main(void) {
+    test_accuracy();
+    test_mit();
+    test_bench();
+
+    printf("all passed\n");
+    return 0;
+}
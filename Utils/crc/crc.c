@@ -1,78 +1,198 @@
 #include "crc.h"
+#include "crc_table.h"
 
-/* CRC 高位字节值表 */
-static const uint8_t crc16_high[] = {
-    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41,
-    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40,
-    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41,
-    0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41,
-    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41,
-    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40,
-    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40,
-    0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40,
-    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41,
-    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40,
-    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41,
-    0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41,
-    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41,
-    0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41,
-    0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41,
-    0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41,
-    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41,
-    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x00, 0xC1, 0x81, 0x40,
-    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41,
-    0x00, 0xC1, 0x81, 0x40, 0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41,
-    0x00, 0xC1, 0x81, 0x40, 0x01, 0xC0, 0x80, 0x41, 0x01, 0xC0, 0x80, 0x41,
-    0x00, 0xC1, 0x81, 0x40};
-
-/* CRC低位字节值表*/
-static const uint8_t crc16_low[] = {
-    0x00, 0xC0, 0xC1, 0x01, 0xC3, 0x03, 0x02, 0xC2, 0xC6, 0x06, 0x07, 0xC7,
-    0x05, 0xC5, 0xC4, 0x04, 0xCC, 0x0C, 0x0D, 0xCD, 0x0F, 0xCF, 0xCE, 0x0E,
-    0x0A, 0xCA, 0xCB, 0x0B, 0xC9, 0x09, 0x08, 0xC8, 0xD8, 0x18, 0x19, 0xD9,
-    0x1B, 0xDB, 0xDA, 0x1A, 0x1E, 0xDE, 0xDF, 0x1F, 0xDD, 0x1D, 0x1C, 0xDC,
-    0x14, 0xD4, 0xD5, 0x15, 0xD7, 0x17, 0x16, 0xD6, 0xD2, 0x12, 0x13, 0xD3,
-    0x11, 0xD1, 0xD0, 0x10, 0xF0, 0x30, 0x31, 0xF1, 0x33, 0xF3, 0xF2, 0x32,
-    0x36, 0xF6, 0xF7, 0x37, 0xF5, 0x35, 0x34, 0xF4, 0x3C, 0xFC, 0xFD, 0x3D,
-    0xFF, 0x3F, 0x3E, 0xFE, 0xFA, 0x3A, 0x3B, 0xFB, 0x39, 0xF9, 0xF8, 0x38,
-    0x28, 0xE8, 0xE9, 0x29, 0xEB, 0x2B, 0x2A, 0xEA, 0xEE, 0x2E, 0x2F, 0xEF,
-    0x2D, 0xED, 0xEC, 0x2C, 0xE4, 0x24, 0x25, 0xE5, 0x27, 0xE7, 0xE6, 0x26,
-    0x22, 0xE2, 0xE3, 0x23, 0xE1, 0x21, 0x20, 0xE0, 0xA0, 0x60, 0x61, 0xA1,
-    0x63, 0xA3, 0xA2, 0x62, 0x66, 0xA6, 0xA7, 0x67, 0xA5, 0x65, 0x64, 0xA4,
-    0x6C, 0xAC, 0xAD, 0x6D, 0xAF, 0x6F, 0x6E, 0xAE, 0xAA, 0x6A, 0x6B, 0xAB,
-    0x69, 0xA9, 0xA8, 0x68, 0x78, 0xB8, 0xB9, 0x79, 0xBB, 0x7B, 0x7A, 0xBA,
-    0xBE, 0x7E, 0x7F, 0xBF, 0x7D, 0xBD, 0xBC, 0x7C, 0xB4, 0x74, 0x75, 0xB5,
-    0x77, 0xB7, 0xB6, 0x76, 0x72, 0xB2, 0xB3, 0x73, 0xB1, 0x71, 0x70, 0xB0,
-    0x50, 0x90, 0x91, 0x51, 0x93, 0x53, 0x52, 0x92, 0x96, 0x56, 0x57, 0x97,
-    0x55, 0x95, 0x94, 0x54, 0x9C, 0x5C, 0x5D, 0x9D, 0x5F, 0x9F, 0x9E, 0x5E,
-    0x5A, 0x9A, 0x9B, 0x5B, 0x99, 0x59, 0x58, 0x98, 0x88, 0x48, 0x49, 0x89,
-    0x4B, 0x8B, 0x8A, 0x4A, 0x4E, 0x8E, 0x8F, 0x4F, 0x8D, 0x4D, 0x4C, 0x8C,
-    0x44, 0x84, 0x85, 0x45, 0x87, 0x47, 0x46, 0x86, 0x82, 0x42, 0x43, 0x83,
-    0x41, 0x81, 0x80, 0x40};
-
-static const uint8_t crc8_table[256] = {
-    0x00, 0x4d, 0x9a, 0xd7, 0x79, 0x34, 0xe3, 0xae, 0xf2, 0xbf, 0x68, 0x25,
-    0x8b, 0xc6, 0x11, 0x5c, 0xa9, 0xe4, 0x33, 0x7e, 0xd0, 0x9d, 0x4a, 0x07,
-    0x5b, 0x16, 0xc1, 0x8c, 0x22, 0x6f, 0xb8, 0xf5, 0x1f, 0x52, 0x85, 0xc8,
-    0x66, 0x2b, 0xfc, 0xb1, 0xed, 0xa0, 0x77, 0x3a, 0x94, 0xd9, 0x0e, 0x43,
-    0xb6, 0xfb, 0x2c, 0x61, 0xcf, 0x82, 0x55, 0x18, 0x44, 0x09, 0xde, 0x93,
-    0x3d, 0x70, 0xa7, 0xea, 0x3e, 0x73, 0xa4, 0xe9, 0x47, 0x0a, 0xdd, 0x90,
-    0xcc, 0x81, 0x56, 0x1b, 0xb5, 0xf8, 0x2f, 0x62, 0x97, 0xda, 0x0d, 0x40,
-    0xee, 0xa3, 0x74, 0x39, 0x65, 0x28, 0xff, 0xb2, 0x1c, 0x51, 0x86, 0xcb,
-    0x21, 0x6c, 0xbb, 0xf6, 0x58, 0x15, 0xc2, 0x8f, 0xd3, 0x9e, 0x49, 0x04,
-    0xaa, 0xe7, 0x30, 0x7d, 0x88, 0xc5, 0x12, 0x5f, 0xf1, 0xbc, 0x6b, 0x26,
-    0x7a, 0x37, 0xe0, 0xad, 0x03, 0x4e, 0x99, 0xd4, 0x7c, 0x31, 0xe6, 0xab,
-    0x05, 0x48, 0x9f, 0xd2, 0x8e, 0xc3, 0x14, 0x59, 0xf7, 0xba, 0x6d, 0x20,
-    0xd5, 0x98, 0x4f, 0x02, 0xac, 0xe1, 0x36, 0x7b, 0x27, 0x6a, 0xbd, 0xf0,
-    0x5e, 0x13, 0xc4, 0x89, 0x63, 0x2e, 0xf9, 0xb4, 0x1a, 0x57, 0x80, 0xcd,
-    0x91, 0xdc, 0x0b, 0x46, 0xe8, 0xa5, 0x72, 0x3f, 0xca, 0x87, 0x50, 0x1d,
-    0xb3, 0xfe, 0x29, 0x64, 0x38, 0x75, 0xa2, 0xef, 0x41, 0x0c, 0xdb, 0x96,
-    0x42, 0x0f, 0xd8, 0x95, 0x3b, 0x76, 0xa1, 0xec, 0xb0, 0xfd, 0x2a, 0x67,
-    0xc9, 0x84, 0x53, 0x1e, 0xeb, 0xa6, 0x71, 0x3c, 0x92, 0xdf, 0x08, 0x45,
-    0x19, 0x54, 0x83, 0xce, 0x60, 0x2d, 0xfa, 0xb7, 0x5d, 0x10, 0xc7, 0x8a,
-    0x24, 0x69, 0xbe, 0xf3, 0xaf, 0xe2, 0x35, 0x78, 0xd6, 0x9b, 0x4c, 0x01,
-    0xf4, 0xb9, 0x6e, 0x23, 0x8d, 0xc0, 0x17, 0x5a, 0x06, 0x4b, 0x9c, 0xd1,
-    0x7f, 0x32, 0xe5, 0xa8};
+#include <string.h>
+
+#if (CRC16_BACKEND == CRC_BACKEND_HW) || (CRC_CCITT_BACKEND == CRC_BACKEND_HW) \
+    || (CRC8_BACKEND == CRC_BACKEND_HW)
+#include <cubemx.h>
+
+#if !defined(CRC_CR_POLYSIZE)
+#error "This CRC unit does not support programmable polynomial."
+#endif /* !defined(CRC_CR_POLYSIZE) */
+
+/* 硬件 CRC 为共享外设, 计算过程不可被打断 */
+#define CRC_HW_ENTER_CRITICAL()                                                \
+    uint32_t primask = __get_PRIMASK();                                        \
+    __disable_irq()
+#define CRC_HW_EXIT_CRITICAL() __set_PRIMASK(primask)
+
+/* 16 位数据按位反转 */
+#define CRC_HW_REVERSE16(x) ((uint16_t)(__RBIT((uint32_t)(x)) >> 16))
+
+/**
+ * @brief 硬件 CRC 计算
+ *
+ * @param poly 多项式 (正序, 不含最高位)
+ * @param cr 控制寄存器配置 (多项式长度, 输入反转)
+ * @param init 初始值 (正序)
+ * @param data 数据
+ * @param len 数据长度
+ * @return 计算结果 (正序)
+ * @note 使用前需要调用 `__HAL_RCC_CRC_CLK_ENABLE()` 使能 CRC 时钟.
+ *       每次调用都会重新配置 CRC 外设, 可以与 HAL 的 CRC 句柄交替使用.
+ */
+static uint32_t crc_hw_calc(uint32_t poly, uint32_t cr, uint32_t init,
+                            const uint8_t *data, uint32_t len) {
+    uint32_t word, result;
+
+    CRC_HW_ENTER_CRITICAL();
+    CRC->POL = poly;
+    CRC->INIT = init;
+    CRC->CR = cr | CRC_CR_RESET;
+
+    /* 按字写入时先处理最高字节, 需要把第一个字节换到最高位 */
+    while (len >= 4) {
+        memcpy(&word, data, 4);
+        CRC->DR = __REV(word);
+        data += 4;
+        len -= 4;
+    }
+    while (len--) {
+        *(volatile uint8_t *)&CRC->DR = *data++;
+    }
+
+    result = CRC->DR;
+    CRC_HW_EXIT_CRITICAL();
+
+    return result;
+}
+#endif /* CRC_BACKEND_HW */
+
+/**
+ * @brief 反射 16 位 CRC 查表计算
+ *
+ * @param table 数据表
+ * @param num 数据表数量, 1: 逐字节; 4: slicing-by-4; 8: slicing-by-8
+ * @param crc 上次的 CRC 值
+ * @param data 数据
+ * @param len 数据长度
+ * @return CRC 值
+ * @note 按字节读取数据, 不要求地址对齐, 也与大小端无关
+ */
+static inline uint16_t crc16_reflect_calc(const uint16_t (*table)[256],
+                                          uint32_t num, uint16_t crc,
+                                          const uint8_t *data, uint32_t len) {
+    if (num >= 8) {
+        while (len >= 8) {
+            crc = table[7][(crc ^ data[0]) & 0xFF] ^
+                  table[6][((crc >> 8) ^ data[1]) & 0xFF] ^
+                  table[5][data[2]] ^ table[4][data[3]] ^
+                  table[3][data[4]] ^ table[2][data[5]] ^
+                  table[1][data[6]] ^ table[0][data[7]];
+            data += 8;
+            len -= 8;
+        }
+    }
+
+    if (num >= 4) {
+        while (len >= 4) {
+            crc = table[3][(crc ^ data[0]) & 0xFF] ^
+                  table[2][((crc >> 8) ^ data[1]) & 0xFF] ^
+                  table[1][data[2]] ^ table[0][data[3]];
+            data += 4;
+            len -= 4;
+        }
+    }
+
+    while (len--) {
+        crc = (crc >> 8) ^ table[0][(crc ^ *data++) & 0xFF];
+    }
+
+    return crc;
+}
+
+/**
+ * @brief 8 位 CRC 查表计算
+ *
+ * @param table 数据表
+ * @param num 数据表数量, 1: 逐字节; 4: slicing-by-4; 8: slicing-by-8
+ * @param crc 上次的 CRC 值
+ * @param data 数据
+ * @param len 数据长度
+ * @return CRC 值
+ */
+static inline uint8_t crc8_calc(const uint8_t (*table)[256], uint32_t num,
+                                uint8_t crc, const uint8_t *data,
+                                uint32_t len) {
+    if (num >= 8) {
+        while (len >= 8) {
+            crc = table[7][crc ^ data[0]] ^ table[6][data[1]] ^
+                  table[5][data[2]] ^ table[4][data[3]] ^
+                  table[3][data[4]] ^ table[2][data[5]] ^
+                  table[1][data[6]] ^ table[0][data[7]];
+            data += 8;
+            len -= 8;
+        }
+    }
+
+    if (num >= 4) {
+        while (len >= 4) {
+            crc = table[3][crc ^ data[0]] ^ table[2][data[1]] ^
+                  table[1][data[2]] ^ table[0][data[3]];
+            data += 4;
+            len -= 4;
+        }
+    }
+
+    while (len--) {
+        crc = table[0][crc ^ *data++];
+    }
+
+    return crc;
+}
+
+/**
+ * @brief CRC-16/MODBUS 增量计算
+ *
+ * @param crc 上次的 CRC 值, 第一次传入 `CRC16_INIT`
+ * @param data 数据
+ * @param len 数据长度
+ * @return CRC 值, 可继续传入下一段数据
+ */
+uint16_t crc16_update(uint16_t crc, const uint8_t *data, uint32_t len) {
+#if (CRC16_BACKEND == CRC_BACKEND_HW)
+    return CRC_HW_REVERSE16(crc_hw_calc(0x8005, CRC_CR_POLYSIZE_0 | CRC_CR_REV_IN_0,
+                                        CRC_HW_REVERSE16(crc), data, len));
+#else  /* CRC16_BACKEND == CRC_BACKEND_HW */
+    return crc16_reflect_calc(crc16_modbus_table, CRC16_TABLE_NUM, crc, data,
+                              len);
+#endif /* CRC16_BACKEND == CRC_BACKEND_HW */
+}
+
+/**
+ * @brief CRC-CCITT (KERMIT) 增量计算
+ *
+ * @param crc 上次的 CRC 值, 第一次传入 `CRC_CCITT_INIT`
+ * @param data 数据
+ * @param len 数据长度
+ * @return CRC 值, 可继续传入下一段数据
+ */
+uint16_t crc_ccitt_update(uint16_t crc, const uint8_t *data, uint32_t len) {
+#if (CRC_CCITT_BACKEND == CRC_BACKEND_HW)
+    return CRC_HW_REVERSE16(crc_hw_calc(0x1021, CRC_CR_POLYSIZE_0 | CRC_CR_REV_IN_0,
+                                        CRC_HW_REVERSE16(crc), data, len));
+#else  /* CRC_CCITT_BACKEND == CRC_BACKEND_HW */
+    return crc16_reflect_calc(crc16_ccitt_table, CRC_CCITT_TABLE_NUM, crc,
+                              data, len);
+#endif /* CRC_CCITT_BACKEND == CRC_BACKEND_HW */
+}
+
+/**
+ * @brief CRC-8 增量计算
+ *
+ * @param crc 上次的 CRC 值, 第一次传入 `CRC8_INIT`
+ * @param data 数据
+ * @param len 数据长度
+ * @return CRC 值, 可继续传入下一段数据
+ */
+uint8_t crc8_update(uint8_t crc, const uint8_t *data, uint32_t len) {
+#if (CRC8_BACKEND == CRC_BACKEND_HW)
+    return (uint8_t)crc_hw_calc(0x4D, CRC_CR_POLYSIZE_1, crc, data, len);
+#else  /* CRC8_BACKEND == CRC_BACKEND_HW */
+    return crc8_calc(crc8_table, CRC8_TABLE_NUM, crc, data, len);
+#endif /* CRC8_BACKEND == CRC_BACKEND_HW */
+}
 
 /**
  * @brief CRC校验(2byte)
@@ -82,15 +202,7 @@ static const uint8_t crc8_table[256] = {
  * @return uint16_t CRC16校验值
  */
 uint16_t calc_crc16(uint8_t *start_byte, uint16_t len) {
-    uint8_t uch_crc_high = 0xFF; /* CRC高字节的初始化 */
-    uint8_t uch_crc_low = 0xFF;  /* CRC低字节的初始化 */
-    uint16_t u_index;            /* CRC查找表的指针 */
-    while (len--) {
-        u_index = uch_crc_low ^ *start_byte++; /* 计算CRC */
-        uch_crc_low = uch_crc_high ^ crc16_high[u_index];
-        uch_crc_high = crc16_low[u_index];
-    }
-    return (uch_crc_high << 8 | uch_crc_low);
+    return crc16_update(CRC16_INIT, start_byte, len);
 }
 
 /**
@@ -101,10 +213,5 @@ uint16_t calc_crc16(uint8_t *start_byte, uint16_t len) {
  * @return CRC8校验值
  */
 uint8_t calc_crc8(uint8_t *p, uint8_t len) {
-    uint8_t crc = 0;
-    uint16_t i;
-    for (i = 0; i < len; i++) {
-        crc = crc8_table[(crc ^ *p++) & 0xff];
-    }
-    return crc;
-}
\ No newline at end of file
+    return crc8_update(CRC8_INIT, p, len);
+}
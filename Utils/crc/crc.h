@@ -3,7 +3,35 @@
 
 #include <stdint.h>
 
+/* CRC 计算方式 */
+#define CRC_BACKEND_BYTEWISE 0 /* 逐字节查表, 每种 CRC 一张表 */
+#define CRC_BACKEND_SLICE4   1 /* slicing-by-4, 每次处理 4 字节, 4 张表 */
+#define CRC_BACKEND_SLICE8   2 /* slicing-by-8, 每次处理 8 字节, 8 张表 */
+#define CRC_BACKEND_HW       3 /* STM32 硬件 CRC (需要支持可编程多项式) */
+
+/* 每种 CRC 使用的计算方式, 可在编译选项中覆盖 */
+#ifndef CRC16_BACKEND
+#define CRC16_BACKEND CRC_BACKEND_SLICE4 /* CRC-16/MODBUS */
+#endif /* CRC16_BACKEND */
+
+#ifndef CRC_CCITT_BACKEND
+#define CRC_CCITT_BACKEND CRC_BACKEND_SLICE4 /* CRC-CCITT (KERMIT) */
+#endif /* CRC_CCITT_BACKEND */
+
+#ifndef CRC8_BACKEND
+#define CRC8_BACKEND CRC_BACKEND_SLICE4 /* CRC-8 (多项式 0x4D) */
+#endif /* CRC8_BACKEND */
+
+/* 初始值, 增量计算时第一次传入 */
+#define CRC16_INIT     0xFFFFU
+#define CRC_CCITT_INIT 0x0000U
+#define CRC8_INIT      0x00U
+
 uint16_t calc_crc16(uint8_t *start_byte, uint16_t len);
 uint8_t calc_crc8(uint8_t *start_byte, uint8_t len);
 
-#endif /* __CRC_H */
\ No newline at end of file
+uint16_t crc16_update(uint16_t crc, const uint8_t *data, uint32_t len);
+uint16_t crc_ccitt_update(uint16_t crc, const uint8_t *data, uint32_t len);
+uint8_t crc8_update(uint8_t crc, const uint8_t *data, uint32_t len);
+
+#endif /* __CRC_H */
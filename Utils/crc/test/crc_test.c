@@ -0,0 +1,220 @@
+/**
+ * @file    crc_test.c
+ * @brief   crc 主机测试: 各查表方式与逐位计算的结果一致, 并比较耗时
+ *
+ * 在 `Utils/crc` 下编译运行, 每种查表方式编译一次 (0: 逐字节, 1: slicing-by-4,
+ * 2: slicing-by-8):
+ *
+ *   for b in 0 1 2; do \
+ *       gcc -std=gnu11 -g -O2 -DCRC16_BACKEND=$b -DCRC_CCITT_BACKEND=$b \
+ *           -DCRC8_BACKEND=$b -I. test/crc_test.c crc.c -o crc_test && \
+ *       ./crc_test; done
+ *
+ * 检查项:
+ *  - 标准校验值: "123456789" 的 CRC-16/MODBUS 为 0x4B37,
+ *    CRC-CCITT (KERMIT) 为 0x2189.
+ *  - 长度 0 ~ 300, 起始地址不对齐的随机数据与逐位计算的结果相同.
+ *  - 数据任意切成两段增量计算, 结果与一次计算相同.
+ *  - `calc_crc16` 与 `calc_crc8` 与增量接口的结果相同.
+ *
+ * 硬件 CRC 的计算方式依赖外设按写入宽度处理数据, 主机上无法模拟, 需要在
+ * 目标板上与查表结果对比.
+ *
+ * 最后给出 8, 64, 1024 字节数据的吞吐量. x86-64 上 1024 字节时 CRC-16
+ * 逐字节约 330 MB/s, slicing-by-4 约 1100 MB/s, slicing-by-8 约 2100 MB/s;
+ * 8 字节时相邻的调用互不依赖, 可以并行执行, 逐字节也有约 1100 MB/s.
+ * Cortex-M 上表在 Flash 中, 取表的等待周期也会影响结果.
+ */
+
+#include "crc.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+#define TEST_MAX_LEN 300
+#define BENCH_BYTES  (16U * 1024U * 1024U)
+
+static const char *const backend_name[] = {"bytewise", "slicing-by-4",
+                                           "slicing-by-8"};
+
+static uint32_t test_rand_state = 1;
+
+static uint8_t test_rand(void) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return (uint8_t)(test_rand_state >> 16);
+}
+
+/*****************************************************************************
+ * 逐位计算
+ */
+
+/**
+ * @brief 反射 16 位 CRC 逐位计算
+ *
+ * @param poly 反射后的多项式
+ */
+static uint16_t ref_crc16_reflect(uint16_t poly, uint16_t crc,
+                                  const uint8_t *data, uint32_t len) {
+    while (len--) {
+        crc ^= *data++;
+        for (int i = 0; i < 8; ++i) {
+            crc = (crc & 1U) ? (uint16_t)((crc >> 1) ^ poly)
+                             : (uint16_t)(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * @brief 8 位 CRC (多项式 0x4D, 不反射) 逐位计算
+ */
+static uint8_t ref_crc8(uint8_t crc, const uint8_t *data, uint32_t len) {
+    while (len--) {
+        crc ^= *data++;
+        for (int i = 0; i < 8; ++i) {
+            crc = (crc & 0x80U) ? (uint8_t)((crc << 1) ^ 0x4DU)
+                                : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/*****************************************************************************
+ * 校验
+ */
+
+static void test_check_value(void) {
+    uint8_t check[] = "123456789";
+
+    CHECK(crc16_update(CRC16_INIT, check, 9) == 0x4B37);
+    CHECK(crc_ccitt_update(CRC_CCITT_INIT, check, 9) == 0x2189);
+    CHECK(calc_crc16(check, 9) == 0x4B37);
+    CHECK(crc8_update(CRC8_INIT, check, 9) == ref_crc8(CRC8_INIT, check, 9));
+
+    printf("check value: ok\n");
+}
+
+static void test_random(void) {
+    /* 多留 8 字节用于不对齐的起始地址 */
+    static uint8_t buffer[TEST_MAX_LEN + 8];
+
+    for (uint32_t round = 0; round < 20; ++round) {
+        for (uint32_t i = 0; i < sizeof(buffer); ++i) {
+            buffer[i] = test_rand();
+        }
+
+        for (uint32_t offset = 0; offset < 8; ++offset) {
+            const uint8_t *data = buffer + offset;
+
+            for (uint32_t len = 0; len <= TEST_MAX_LEN; ++len) {
+                uint16_t crc16 = ref_crc16_reflect(0xA001, CRC16_INIT, data,
+                                                   len);
+                uint16_t ccitt = ref_crc16_reflect(0x8408, CRC_CCITT_INIT,
+                                                   data, len);
+                uint8_t crc8 = ref_crc8(CRC8_INIT, data, len);
+                uint32_t split = len ? test_rand() % (len + 1) : 0;
+
+                CHECK(crc16_update(CRC16_INIT, data, len) == crc16);
+                CHECK(crc_ccitt_update(CRC_CCITT_INIT, data, len) == ccitt);
+                CHECK(crc8_update(CRC8_INIT, data, len) == crc8);
+
+                /* 增量计算 */
+                CHECK(crc16_update(crc16_update(CRC16_INIT, data, split),
+                                   data + split, len - split) == crc16);
+                CHECK(crc_ccitt_update(
+                          crc_ccitt_update(CRC_CCITT_INIT, data, split),
+                          data + split, len - split) == ccitt);
+                CHECK(crc8_update(crc8_update(CRC8_INIT, data, split),
+                                  data + split, len - split) == crc8);
+
+                if (len <= 0xFF) {
+                    CHECK(calc_crc16((uint8_t *)data, (uint16_t)len) == crc16);
+                    CHECK(calc_crc8((uint8_t *)data, (uint8_t)len) == crc8);
+                }
+            }
+        }
+    }
+
+    printf("random: lengths 0..%u at every alignment, same as bitwise\n",
+           TEST_MAX_LEN);
+}
+
+/*****************************************************************************
+ * 耗时
+ */
+
+static double test_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void test_bench(void) {
+    static const uint32_t bench_len[] = {8, 64, 1024};
+    static uint8_t buffer[1024];
+    volatile uint32_t sink = 0;
+
+    for (uint32_t i = 0; i < sizeof(buffer); ++i) {
+        buffer[i] = test_rand();
+    }
+
+    for (uint32_t n = 0; n < sizeof(bench_len) / sizeof(bench_len[0]); ++n) {
+        uint32_t len = bench_len[n];
+        uint32_t calls = BENCH_BYTES / len;
+        double crc16_ns = 1e30, ccitt_ns = 1e30, crc8_ns = 1e30;
+
+        /* 机器有噪声, 取 5 轮中的最小值 */
+        for (int round = 0; round < 5; ++round) {
+            uint32_t sum = 0;
+            double start = test_now();
+            for (uint32_t i = 0; i < calls; ++i) {
+                sum += crc16_update(CRC16_INIT, buffer, len);
+            }
+            double t = test_now() - start;
+            crc16_ns = t < crc16_ns ? t : crc16_ns;
+
+            start = test_now();
+            for (uint32_t i = 0; i < calls; ++i) {
+                sum += crc_ccitt_update(CRC_CCITT_INIT, buffer, len);
+            }
+            t = test_now() - start;
+            ccitt_ns = t < ccitt_ns ? t : ccitt_ns;
+
+            start = test_now();
+            for (uint32_t i = 0; i < calls; ++i) {
+                sum += crc8_update(CRC8_INIT, buffer, len);
+            }
+            t = test_now() - start;
+            crc8_ns = t < crc8_ns ? t : crc8_ns;
+            sink += sum;
+        }
+
+        printf("bench %4u bytes: crc16 %6.0f MB/s, ccitt %6.0f MB/s, "
+               "crc8 %6.0f MB/s\n",
+               len, BENCH_BYTES / crc16_ns * 1e3, BENCH_BYTES / ccitt_ns * 1e3,
+               BENCH_BYTES / crc8_ns * 1e3);
+    }
+}
+
+int main(void) {
+    printf("backend: crc16 %s, ccitt %s, crc8 %s\n",
+           backend_name[CRC16_BACKEND], backend_name[CRC_CCITT_BACKEND],
+           backend_name[CRC8_BACKEND]);
+
+    test_check_value();
+    test_random();
+    test_bench();
+
+    printf("all passed\n");
+    return 0;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file    mem_pool.c
+ * @brief   Static memory pools.
+ * @version 1.0
+ * @date    2026-10-16
+ */
+
+#include "mem_pool.h"
+
+#include <stddef.h>
+
+/**
+ * @brief Allocate a block from the pool.
+ *
+ * @param pool The pool.
+ * @return The block, `NULL` if the pool is exhausted.
+ * @note The blocks in the free list are used first, then the blocks never
+ *       allocated.
+ */
+void *mem_pool_alloc(mem_pool_t *pool) {
+    void *block;
+
+    if (pool->free_list != NULL) {
+        block = pool->free_list;
+        pool->free_list = *(void **)block;
+    } else if (pool->top < pool->total) {
+        block = pool->base + pool->top * pool->block_size;
+        ++pool->top;
+    } else {
+        ++pool->failed;
+        return NULL;
+    }
+
+    if (++pool->used > pool->peak) {
+        pool->peak = pool->used;
+    }
+    return block;
+}
+
+/**
+ * @brief Return a block to the pool.
+ *
+ * @param pool The pool.
+ * @param block The block allocated by `mem_pool_alloc`.
+ */
+void mem_pool_free(mem_pool_t *pool, void *block) {
+    if (block == NULL) {
+        return;
+    }
+
+    *(void **)block = pool->free_list;
+    pool->free_list = block;
+    --pool->used;
+}
+
+/**
+ * @brief Allocate from the stack allocator.
+ *
+ * @param stack The stack allocator.
+ * @param size Bytes, rounded up to the pointer size.
+ * @return The memory allocated, `NULL` if the space left is not enough.
+ */
+void *mem_stack_alloc(mem_stack_t *stack, uint32_t size) {
+    size = (size + sizeof(void *) - 1) & ~(uint32_t)(sizeof(void *) - 1);
+
+    if (size > stack->size - stack->used) {
+        return NULL;
+    }
+
+    void *mem = stack->base + stack->used;
+    stack->used += size;
+    return mem;
+}
+
+/**
+ * @brief Free the memory of the stack allocator.
+ *
+ * @param stack The stack allocator.
+ * @param mem The memory allocated by `mem_stack_alloc`.
+ * @param size Bytes when allocated.
+ * @note Only the last allocation can be freed, otherwise nothing is done.
+ */
+void mem_stack_free(mem_stack_t *stack, void *mem, uint32_t size) {
+    size = (size + sizeof(void *) - 1) & ~(uint32_t)(sizeof(void *) - 1);
+
+    if ((uint8_t *)mem + size == stack->base + stack->used) {
+        stack->used -= size;
+    }
+}
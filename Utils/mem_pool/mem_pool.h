@@ -0,0 +1,70 @@
+/**
+ * @file    mem_pool.h
+ * @brief   Static memory pools.
+ * @version 1.0
+ * @date    2026-10-16
+ *
+ *****************************************************************************
+ * Two allocators, the memory is statically allocated by the caller, the heap
+ * is not used:
+ *  - mem_pool_t:  Fixed size blocks. Freed blocks are linked in a free list,
+ *                 allocation and free are O(1). The free list pointer is
+ *                 stored at the start of a free block, so a block must not be
+ *                 smaller than a pointer.
+ *  - mem_stack_t: Stack allocation of any size, only the last allocation can
+ *                 be freed. For memory allocated at initialization and
+ *                 rarely freed later.
+ * Neither is thread safe, the caller must serialize the access.
+ *****************************************************************************
+ */
+
+#ifndef __MEM_POOL_H
+#define __MEM_POOL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/* Pool of fixed size blocks. */
+typedef struct {
+    void *free_list;     /* Freed blocks, linked by their first pointer. */
+    uint8_t *base;       /* Block storage.                             */
+    uint32_t block_size; /* Block size.                                */
+    uint32_t total;      /* Block number.                              */
+    uint32_t top;        /* First block never allocated.               */
+    uint32_t used;       /* Blocks in use.                             */
+    uint32_t peak;       /* The most blocks in use at the same time.   */
+    uint32_t failed;     /* Allocations failed since pool exhausted.   */
+} mem_pool_t;
+
+/* Stack allocator. */
+typedef struct {
+    uint8_t *base; /* Storage.                 */
+    uint32_t size; /* Storage size in bytes.   */
+    uint32_t used; /* Bytes allocated.         */
+} mem_stack_t;
+
+/* Static initializer of a pool, `array` is an array of the block type. */
+#define MEM_POOL_INIT(array)                                                   \
+    {.free_list = NULL,                                                        \
+     .base = (uint8_t *)(array),                                               \
+     .block_size = sizeof((array)[0]),                                         \
+     .total = sizeof(array) / sizeof((array)[0])}
+
+/* Static initializer of a stack allocator, `array` is an array of any type. */
+#define MEM_STACK_INIT(array)                                                  \
+    {.base = (uint8_t *)(array), .size = sizeof(array), .used = 0}
+
+void *mem_pool_alloc(mem_pool_t *pool);
+void mem_pool_free(mem_pool_t *pool, void *block);
+
+void *mem_stack_alloc(mem_stack_t *stack, uint32_t size);
+void mem_stack_free(mem_stack_t *stack, void *mem, uint32_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MEM_POOL_H */
@@ -10,6 +10,14 @@
 
 #include <math.h>
 
+#if PID_USE_BANK
+#include <stddef.h>
+
+#if PID_BANK_USE_ARM_MATH
+#include "arm_math.h"
+#endif /* PID_BANK_USE_ARM_MATH */
+#endif /* PID_USE_BANK */
+
 /**
  * @brief PID 状态记录
  */
@@ -146,4 +154,209 @@ float pid_calc(pid_t *pid, float target_p, float measure_p) {
     return pid->pos_out;
 
 #endif /* PID_USE_DELTA_PID */
-}
\ No newline at end of file
+}
+
+#if PID_USE_BANK
+
+/**
+ * @brief 限幅, 编译为无分支的 min/max
+ *
+ * @param a 传入的值
+ * @param abs_max 限制值
+ * @return 限幅后的值
+ */
+static inline float bank_limit(float a, float abs_max) {
+    a = a > abs_max ? abs_max : a;
+    return a < -abs_max ? -abs_max : a;
+}
+
+/**
+ * @brief PID 组初始化, 状态和参数清零
+ *
+ * @param bank PID 组句柄
+ * @param num 控制器数量
+ * @param mode PID 模式
+ *  @arg `POSITION_PID`, 位置式 PID;
+ *  @arg `DELTA_PID`, 增量式 PID
+ * @param mem 数组使用的内存, 长度为 `PID_BANK_MEM_SIZE(num)` 个 float
+ * @return 初始化结果
+ * @retval - 0: 成功
+ * @retval - 1: 参数错误
+ */
+uint8_t pid_bank_init(pid_bank_t *bank, uint16_t num, pid_mode_t mode,
+                      float *mem) {
+    uint32_t i;
+
+    if (bank == NULL || mem == NULL || num == 0) {
+        return 1;
+    }
+
+    for (i = 0; i < PID_BANK_MEM_SIZE(num); ++i) {
+        mem[i] = 0.0f;
+    }
+
+    bank->num = num;
+    bank->mode = mode;
+
+    bank->kp = mem;
+    bank->ki = bank->kp + num;
+    bank->kd = bank->ki + num;
+    bank->max_output = bank->kd + num;
+    bank->integral_limit = bank->max_output + num;
+    bank->deadband = bank->integral_limit + num;
+    bank->max_error = bank->deadband + num;
+    bank->err = bank->max_error + num;
+    bank->err_last = bank->err + num;
+    bank->err_llast = bank->err_last + num;
+    bank->iout = bank->err_llast + num;
+    bank->out = bank->iout + num;
+#if PID_BANK_USE_ARM_MATH
+    bank->tmp = bank->out + num;
+#endif /* PID_BANK_USE_ARM_MATH */
+
+    return 0;
+}
+
+/**
+ * @brief 设置 PID 组中一个控制器的参数, 并清除其状态
+ *
+ * @param bank PID 组句柄
+ * @param index 控制器编号
+ * @param maxout_p 输出限幅
+ * @param integral_limit_p 积分限幅
+ * @param deadband_p 死区, PID 计算的最小误差
+ * @param maxerr_p 最大误差
+ * @param kp_p P 参数
+ * @param ki_p I 参数
+ * @param kd_p D 参数
+ */
+void pid_bank_set(pid_bank_t *bank, uint16_t index, float maxout_p,
+                  float integral_limit_p, float deadband_p, float maxerr_p,
+                  float kp_p, float ki_p, float kd_p) {
+    if (index >= bank->num) {
+        return;
+    }
+
+    bank->max_output[index] = maxout_p;
+    bank->integral_limit[index] = integral_limit_p;
+    bank->deadband[index] = deadband_p;
+    bank->max_error[index] = maxerr_p;
+
+    bank->kp[index] = kp_p;
+    bank->ki[index] = ki_p;
+    bank->kd[index] = kd_p;
+
+    bank->err[index] = 0.0f;
+    bank->err_last[index] = 0.0f;
+    bank->err_llast[index] = 0.0f;
+    bank->iout[index] = 0.0f;
+    bank->out[index] = 0.0f;
+}
+
+/**
+ * @brief PID 组中一个控制器的参数调整
+ *
+ * @param bank PID 组句柄
+ * @param index 控制器编号
+ * @param kp_p P 参数
+ * @param ki_p I 参数
+ * @param kd_p D 参数
+ */
+void pid_bank_reset(pid_bank_t *bank, uint16_t index, float kp_p, float ki_p,
+                    float kd_p) {
+    if (index >= bank->num) {
+        return;
+    }
+
+    bank->kp[index] = kp_p;
+    bank->ki[index] = ki_p;
+    bank->kd[index] = kd_p;
+}
+
+/**
+ * @brief PID 组计算, 每个控制器的结果与 `pid_calc` 相同
+ *
+ * @param bank PID 组句柄
+ * @param target_p 目标值数组, 长度为 num
+ * @param measure_p 测量值数组, 长度为 num
+ * @return 输出数组 (即 bank->out), 长度为 num
+ * @note 模式判断在循环外, 循环体内没有分支, 便于编译器展开和向量化
+ */
+const float *pid_bank_calc(pid_bank_t *bank, const float *target_p,
+                           const float *measure_p) {
+    const uint16_t num = bank->num;
+    float *err = bank->err;
+    float *err_last = bank->err_last;
+    float *err_llast = bank->err_llast;
+    float *iout = bank->iout;
+    float *out = bank->out;
+    uint16_t i;
+
+#if PID_BANK_USE_ARM_MATH
+    arm_sub_f32((float32_t *)target_p, (float32_t *)measure_p, err, num);
+#else  /* PID_BANK_USE_ARM_MATH */
+    for (i = 0; i < num; ++i) {
+        err[i] = target_p[i] - measure_p[i];
+    }
+#endif /* PID_BANK_USE_ARM_MATH */
+
+    for (i = 0; i < num; ++i) {
+        float e = bank_limit(err[i], bank->max_error[i]);
+        err[i] = fabsf(e) < bank->deadband[i] ? 0.0f : e;
+    }
+
+    if (bank->mode == POSITION_PID) {
+#if PID_BANK_USE_ARM_MATH
+        float *tmp = bank->tmp;
+
+        /* iout += ki * err */
+        arm_mult_f32(bank->ki, err, tmp, num);
+        arm_add_f32(iout, tmp, iout, num);
+        for (i = 0; i < num; ++i) {
+            iout[i] = bank_limit(iout[i], bank->integral_limit[i]);
+        }
+
+        /* out = (kp * err + iout) + kd * (err - err_last), 加法顺序与
+           `pid_calc` 相同, 结果逐位一致 */
+        arm_mult_f32(bank->kp, err, out, num);
+        arm_add_f32(out, iout, out, num);
+        arm_sub_f32(err, err_last, tmp, num);
+        arm_mult_f32(bank->kd, tmp, tmp, num);
+        arm_add_f32(out, tmp, out, num);
+        for (i = 0; i < num; ++i) {
+            out[i] = bank_limit(out[i], bank->max_output[i]);
+        }
+#else  /* PID_BANK_USE_ARM_MATH */
+        for (i = 0; i < num; ++i) {
+            float pout = bank->kp[i] * err[i];
+            float dout = bank->kd[i] * (err[i] - err_last[i]);
+
+            iout[i] = bank_limit(iout[i] + bank->ki[i] * err[i],
+                                 bank->integral_limit[i]);
+            out[i] = bank_limit(pout + iout[i] + dout, bank->max_output[i]);
+        }
+#endif /* PID_BANK_USE_ARM_MATH */
+    } else {
+        /* 增量式 PID, out 中保存的是上次输出 */
+        for (i = 0; i < num; ++i) {
+            float pout = bank->kp[i] * (err[i] - err_last[i]);
+            float iterm = bank_limit(bank->ki[i] * err[i],
+                                     bank->integral_limit[i]);
+            float dout = bank->kd[i] *
+                         (err[i] - 2 * err_last[i] + err_llast[i]);
+
+            out[i] = bank_limit(out[i] + (pout + iterm + dout),
+                                bank->max_output[i]);
+        }
+    }
+
+    /* 状态转移 */
+    for (i = 0; i < num; ++i) {
+        err_llast[i] = err_last[i];
+        err_last[i] = err[i];
+    }
+
+    return out;
+}
+
+#endif /* PID_USE_BANK */
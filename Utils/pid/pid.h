@@ -1,77 +1,141 @@
-/**
- * @file    pid.h
- * @author  Deadline039
- * @brief   pid 封装
- * @version 1.2
- * @date    2023-10-27
- *
- ******************************************************************************
- *    Date    | Version |   Author    | Version Info
- * -----------+---------+-------------+----------------------------------------
- * 2024-04-04 |   1.0   | Deadline039 | 初版
- * 2024-04-16 |   1.1   | Deadline039 | 添加 ARM 数学库, 用于加速计算
- * 2024-05-03 |   1.2   | Deadline039 | 移除 ARM 数学库, 感觉用处不大
- * 2025-02-26 |   1.3   | Deadline039 | 移除依赖, 添加宏选择使用增量 PID 以减小内存占用
- */
-
-#ifndef __PID_H
-#define __PID_H
-
-#ifdef __cplusplus
-extern "C" {
-#endif /* __cplusplus */
-
-/* 是否使用增量式 PID */
-#define PID_USE_DELTA_PID 1
-
-/**
- * @brief PID 类型, 位置 PID 或者增量 PID
- */
-typedef enum {
-    POSITION_PID = 0x00U,
-    DELTA_PID
-} pid_mode_t;
-
-/**
- * @brief PID 控制句柄
- */
-typedef struct {
-    float kp, ki, kd; /*!< pid 三参数 */
-
-#if PID_USE_DELTA_PID
-    float err[3]; /*!< 差值, 包含本次, 上次, 上上次 */
-#else             /* PID_USE_DELTA_PID */
-    float err[2]; /*!< 差值, 包含本次, 上次 */
-#endif            /* PID_USE_DELTA_PID */
-
-    float iout; /*!< pid 积分结果, 在位置式使用 */
-
-    float max_output;     /*!< 输出限幅 */
-    float integral_limit; /*!< 积分限幅 */
-    float deadband;       /*!< 死区 (绝对值) */
-    float max_error;      /*!< 最大误差 */
-
-    /* 位置模式 */
-    float pos_out;     /*!< 本次输出 */
-
-#if PID_USE_DELTA_PID
-    /* 增量模式 */
-    float delta_u;       /*!< 本次增量值 */
-    float delta_out;     /*!< 本次增量输出 = delta_lastout + delta_u */
-    float delta_lastout; /*!< 上次增量输出 */
-    pid_mode_t pid_mode; /*!< PID 模式 */
-#endif                   /* PID_USE_DELTA_PID */
-
-} pid_t;
-
-void pid_init(pid_t *pid, float maxout_p, float integral_limit_p,
-              float deadband_p, float maxerr_p, pid_mode_t pid_mode_p,
-              float kp_p, float ki_p, float kd_p);
-void pid_reset(pid_t *pid, float kp_p, float ki_p, float kd_p);
-float pid_calc(pid_t *pid, float target_p, float measure_p);
-
-#ifdef __cplusplus
-}
-#endif /* __cplusplus */
-
-#endif /* __PID_H */
+/**
+ * @file    pid.h
+ * @author  Deadline039
+ * @brief   pid 封装
+ * @version 1.2
+ * @date    2023-10-27
+ *
+ ******************************************************************************
+ *    Date    | Version |   Author    | Version Info
+ * -----------+---------+-------------+----------------------------------------
+ * 2024-04-04 |   1.0   | Deadline039 | 初版
+ * 2024-04-16 |   1.1   | Deadline039 | 添加 ARM 数学库, 用于加速计算
+ * 2024-05-03 |   1.2   | Deadline039 | 移除 ARM 数学库, 感觉用处不大
+ * 2025-02-26 |   1.3   | Deadline039 | 移除依赖, 添加宏选择使用增量 PID 以减小内存占用
+ * 2026-10-16 |   1.4   |    agent    | 添加 PID 组, 多个控制器一次计算, 可选 ARM 数学库
+ */
+
+#ifndef __PID_H
+#define __PID_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/* 是否使用增量式 PID */
+#define PID_USE_DELTA_PID 1
+
+/* 是否使用 PID 组 (多个控制器一次计算) */
+#define PID_USE_BANK 1
+
+/* PID 组是否使用 ARM 数学库 (CMSIS-DSP) 的向量函数, 加法顺序与
+   `pid_calc` 相同, 两种实现的结果逐位一致 */
+#ifndef PID_BANK_USE_ARM_MATH
+#define PID_BANK_USE_ARM_MATH 0
+#endif /* PID_BANK_USE_ARM_MATH */
+
+#include <stdint.h>
+
+/**
+ * @brief PID 类型, 位置 PID 或者增量 PID
+ */
+typedef enum {
+    POSITION_PID = 0x00U,
+    DELTA_PID
+} pid_mode_t;
+
+/**
+ * @brief PID 控制句柄
+ */
+typedef struct {
+    float kp, ki, kd; /*!< pid 三参数 */
+
+#if PID_USE_DELTA_PID
+    float err[3]; /*!< 差值, 包含本次, 上次, 上上次 */
+#else             /* PID_USE_DELTA_PID */
+    float err[2]; /*!< 差值, 包含本次, 上次 */
+#endif            /* PID_USE_DELTA_PID */
+
+    float iout; /*!< pid 积分结果, 在位置式使用 */
+
+    float max_output;     /*!< 输出限幅 */
+    float integral_limit; /*!< 积分限幅 */
+    float deadband;       /*!< 死区 (绝对值) */
+    float max_error;      /*!< 最大误差 */
+
+    /* 位置模式 */
+    float pos_out;     /*!< 本次输出 */
+
+#if PID_USE_DELTA_PID
+    /* 增量模式 */
+    float delta_u;       /*!< 本次增量值 */
+    float delta_out;     /*!< 本次增量输出 = delta_lastout + delta_u */
+    float delta_lastout; /*!< 上次增量输出 */
+    pid_mode_t pid_mode; /*!< PID 模式 */
+#endif                   /* PID_USE_DELTA_PID */
+
+} pid_t;
+
+void pid_init(pid_t *pid, float maxout_p, float integral_limit_p,
+              float deadband_p, float maxerr_p, pid_mode_t pid_mode_p,
+              float kp_p, float ki_p, float kd_p);
+void pid_reset(pid_t *pid, float kp_p, float ki_p, float kd_p);
+float pid_calc(pid_t *pid, float target_p, float measure_p);
+
+#if PID_USE_BANK
+
+/**
+ * @brief PID 组句柄, 同一组的控制器使用同一种模式
+ *
+ * @note 数据按数组结构 (SoA) 存放, 每个数组长度为 num, 第 i 个控制器的
+ *       参数为 kp[i], ki[i]...; out 连续存放所有输出, 可直接用于组帧发送
+ */
+typedef struct {
+    uint16_t num;    /*!< 控制器数量 */
+    pid_mode_t mode; /*!< PID 模式 */
+
+    float *kp, *ki, *kd; /*!< pid 三参数 */
+
+    float *max_output;     /*!< 输出限幅 */
+    float *integral_limit; /*!< 积分限幅 */
+    float *deadband;       /*!< 死区 (绝对值) */
+    float *max_error;      /*!< 最大误差 */
+
+    float *err;       /*!< 本次差值 */
+    float *err_last;  /*!< 上次差值 */
+    float *err_llast; /*!< 上上次差值 */
+    float *iout;      /*!< 位置式的积分结果 */
+    float *out;       /*!< 本次输出, 增量式下同时作为上次输出 */
+
+#if PID_BANK_USE_ARM_MATH
+    float *tmp; /*!< 向量计算的临时数组 */
+#endif          /* PID_BANK_USE_ARM_MATH */
+} pid_bank_t;
+
+/**
+ * @brief PID 组需要的内存大小 (float 个数), 例如:
+ *        static float chassis_pid_mem[PID_BANK_MEM_SIZE(4)];
+ */
+#if PID_BANK_USE_ARM_MATH
+#define PID_BANK_MEM_SIZE(num) (13U * (num))
+#else /* PID_BANK_USE_ARM_MATH */
+#define PID_BANK_MEM_SIZE(num) (12U * (num))
+#endif /* PID_BANK_USE_ARM_MATH */
+
+uint8_t pid_bank_init(pid_bank_t *bank, uint16_t num, pid_mode_t mode,
+                      float *mem);
+void pid_bank_set(pid_bank_t *bank, uint16_t index, float maxout_p,
+                  float integral_limit_p, float deadband_p, float maxerr_p,
+                  float kp_p, float ki_p, float kd_p);
+void pid_bank_reset(pid_bank_t *bank, uint16_t index, float kp_p, float ki_p,
+                    float kd_p);
+const float *pid_bank_calc(pid_bank_t *bank, const float *target_p,
+                           const float *measure_p);
+
+#endif /* PID_USE_BANK */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __PID_H */
@@ -0,0 +1,184 @@
+/**
+ * @file    pid_test.c
+ * @brief   pid 主机测试: PID 组的每个输出与逐个调用 `pid_calc` 的结果逐位一致
+ *
+ * 在 `Utils/pid` 下编译运行, 分别测试标量实现和 ARM 数学库实现
+ * (`test/stub/arm_math.h` 为逐元素的替身):
+ *
+ *   gcc -std=gnu11 -g -O2 -ffp-contract=off -I. test/pid_test.c pid.c -lm \
+ *       -o pid_test && ./pid_test
+ *   gcc -std=gnu11 -g -O2 -ffp-contract=off -Itest/stub -I. \
+ *       -DPID_BANK_USE_ARM_MATH=1 test/pid_test.c pid.c -lm \
+ *       -o pid_test && ./pid_test
+ *
+ * 最后比较 PID 组一次计算 N 个控制器与逐个调用 `pid_calc` 的耗时. 用替身
+ * 编译的 ARM 数学库版本的耗时没有意义.
+ *
+ * 目标板上编译器把乘加合并为 FMA 时 `pid_calc` 与 CMSIS-DSP 的结果会有
+ * 舍入差异, 需要逐位一致时编译 pid.c 加 `-ffp-contract=off`.
+ */
+
+/* time.h 中 POSIX 的 pid_t 与 pid.h 重名, 先包含并改名 */
+#define pid_t posix_pid_t
+#include <time.h>
+#undef pid_t
+
+#include "pid.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            return 1;                                                          \
+        }                                                                      \
+    } while (0)
+
+/* 控制器数量, 不是 4 的倍数, 覆盖向量函数的尾部 */
+#define TEST_NUM 7
+/* 计算次数 */
+#define TEST_STEPS 10000
+
+static uint32_t test_rand_state = 1;
+
+/* [-range, range) 的随机数 */
+static float test_rand(float range) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return ((float)(test_rand_state >> 8) / (float)(1U << 24) * 2.0f - 1.0f) *
+           range;
+}
+
+static int test_mode(pid_mode_t mode) {
+    static float mem[PID_BANK_MEM_SIZE(TEST_NUM)];
+    pid_bank_t bank;
+    /* `pid_init` 不清除误差和积分, 与静态变量一样从 0 开始 */
+    static pid_t pid[TEST_NUM];
+    float target[TEST_NUM], measure[TEST_NUM];
+
+    memset(pid, 0, sizeof(pid));
+    CHECK(pid_bank_init(&bank, TEST_NUM, mode, mem) == 0);
+
+    for (uint16_t i = 0; i < TEST_NUM; ++i) {
+        float kp = test_rand(20.0f) + 20.0f;
+        float ki = test_rand(1.0f) + 1.0f;
+        float kd = test_rand(5.0f) + 5.0f;
+        float maxout = 10000.0f + 1000.0f * i;
+        float integral = 3000.0f + 100.0f * i;
+        float deadband = 0.01f * i;
+        float maxerr = 500.0f;
+
+        pid_init(&pid[i], maxout, integral, deadband, maxerr, mode, kp, ki,
+                 kd);
+        pid_bank_set(&bank, i, maxout, integral, deadband, maxerr, kp, ki,
+                     kd);
+    }
+
+    for (uint32_t step = 0; step < TEST_STEPS; ++step) {
+        const float *out;
+
+        for (uint16_t i = 0; i < TEST_NUM; ++i) {
+            target[i] = test_rand(1000.0f);
+            measure[i] = test_rand(1000.0f);
+        }
+
+        out = pid_bank_calc(&bank, target, measure);
+        for (uint16_t i = 0; i < TEST_NUM; ++i) {
+            float expect = pid_calc(&pid[i], target[i], measure[i]);
+            CHECK(memcmp(&out[i], &expect, sizeof(float)) == 0);
+        }
+    }
+
+    return 0;
+}
+
+/* 耗时测试的计算次数 */
+#define BENCH_STEPS 200000
+
+static volatile float bench_sink;
+
+static double test_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+/**
+ * @brief 每次计算 num 个控制器的耗时, PID 组与逐个调用 `pid_calc`
+ */
+static void test_bench(uint16_t num, pid_mode_t mode) {
+    static float mem[PID_BANK_MEM_SIZE(16)];
+    static pid_t pid[16];
+    static float target[16 * 64], measure[16 * 64];
+    pid_bank_t bank;
+    double start, bank_ns, scalar_ns;
+    float sum = 0.0f;
+
+    memset(pid, 0, sizeof(pid));
+    if (pid_bank_init(&bank, num, mode, mem) != 0) {
+        return;
+    }
+    for (uint16_t i = 0; i < num; ++i) {
+        pid_init(&pid[i], 10000.0f, 3000.0f, 0.01f, 500.0f, mode, 20.0f, 1.0f,
+                 5.0f);
+        pid_bank_set(&bank, i, 10000.0f, 3000.0f, 0.01f, 500.0f, 20.0f, 1.0f,
+                     5.0f);
+    }
+    /* 64 组输入轮流使用, 分支不会被完全预测 */
+    for (uint32_t i = 0; i < 16 * 64; ++i) {
+        target[i] = test_rand(1000.0f);
+        measure[i] = test_rand(1000.0f);
+    }
+
+    /* 取 5 次中最快的一次, 减小主机上其它进程的影响 */
+    bank_ns = scalar_ns = 1e30;
+    for (uint32_t round = 0; round < 5; ++round) {
+        double ns;
+
+        start = test_now();
+        for (uint32_t step = 0; step < BENCH_STEPS; ++step) {
+            uint32_t off = (step & 63) * 16;
+            sum += pid_bank_calc(&bank, &target[off], &measure[off])[0];
+        }
+        ns = (test_now() - start) / BENCH_STEPS;
+        bank_ns = ns < bank_ns ? ns : bank_ns;
+
+        start = test_now();
+        for (uint32_t step = 0; step < BENCH_STEPS; ++step) {
+            uint32_t off = (step & 63) * 16;
+            for (uint16_t i = 0; i < num; ++i) {
+                sum += pid_calc(&pid[i], target[off + i], measure[off + i]);
+            }
+        }
+        ns = (test_now() - start) / BENCH_STEPS;
+        scalar_ns = ns < scalar_ns ? ns : scalar_ns;
+    }
+    bench_sink = sum;
+
+    printf("bench %s %2u controllers: bank %.1f ns, pid_calc x %u %.1f ns\n",
+           mode == POSITION_PID ? "position" : "delta", num, bank_ns, num,
+           scalar_ns);
+}
+
+int main(void) {
+    if (test_mode(POSITION_PID) != 0) {
+        return 1;
+    }
+#if PID_USE_DELTA_PID
+    if (test_mode(DELTA_PID) != 0) {
+        return 1;
+    }
+#endif /* PID_USE_DELTA_PID */
+
+    test_bench(8, POSITION_PID);
+    test_bench(16, POSITION_PID);
+#if PID_USE_DELTA_PID
+    test_bench(8, DELTA_PID);
+    test_bench(16, DELTA_PID);
+#endif /* PID_USE_DELTA_PID */
+
+    printf("pid: all tests passed (PID_BANK_USE_ARM_MATH = %d)\n",
+           PID_BANK_USE_ARM_MATH);
+    return 0;
+}
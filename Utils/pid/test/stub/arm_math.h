@@ -0,0 +1,34 @@
+/**
+ * @file    arm_math.h
+ * @brief   主机测试用的 CMSIS-DSP 替身, 只实现 pid 用到的逐元素函数
+ */
+
+#ifndef __ARM_MATH_H
+#define __ARM_MATH_H
+
+#include <stdint.h>
+
+typedef float float32_t;
+
+static inline void arm_add_f32(const float32_t *a, const float32_t *b,
+                               float32_t *dst, uint32_t n) {
+    for (uint32_t i = 0; i < n; ++i) {
+        dst[i] = a[i] + b[i];
+    }
+}
+
+static inline void arm_sub_f32(const float32_t *a, const float32_t *b,
+                               float32_t *dst, uint32_t n) {
+    for (uint32_t i = 0; i < n; ++i) {
+        dst[i] = a[i] - b[i];
+    }
+}
+
+static inline void arm_mult_f32(const float32_t *a, const float32_t *b,
+                                float32_t *dst, uint32_t n) {
+    for (uint32_t i = 0; i < n; ++i) {
+        dst[i] = a[i] * b[i];
+    }
+}
+
+#endif /* __ARM_MATH_H */
@@ -29,6 +29,26 @@ static inline uint32_t pow2gt(uint32_t x) {
     return x + 1;
 }
 
+/* 已写入未读取的长度. DMA 模式下生产者超过消费者一圈以上时可能大于 size */
+static inline uint32_t ring_fifo_used(ring_fifo_t *ring) {
+    return min(ring->tail - ring->head, ring->size);
+}
+
+/* 消费者读取前调用: DMA 模式下生产者不修改 head, 由消费者把 head 移到
+   tail - size, 丢弃已被覆盖的数据并计入 overrun */
+static inline uint32_t ring_fifo_consume_used(ring_fifo_t *ring) {
+    uint32_t tail = ring->tail;
+    uint32_t used = tail - ring->head;
+
+    if (used > ring->size) {
+        ring->overrun += used - ring->size;
+        ring->head = tail - ring->size;
+        used = ring->size;
+    }
+
+    return used;
+}
+
 ring_fifo_t *ring_fifo_init(void *buf, uint32_t size,
                             enum ring_fifo_type type) {
     ring_fifo_t *ring;
@@ -62,6 +82,7 @@ ring_fifo_t *ring_fifo_init(void *buf, uint32_t size,
     }
 
     ring->head = ring->tail = 0;
+    ring->overrun = 0;
     ring->size = size;
     ring->mask = size - 1;
     ring->type = type;
@@ -85,6 +106,8 @@ uint32_t ring_fifo_write(ring_fifo_t *ring, const void *buf, uint32_t len) {
     uint32_t frame_off, skip;
 
     unused = ring->size - (ring->tail - ring->head);
+    /* 读到 head 之后才能覆盖已释放的空间 */
+    RING_FIFO_BARRIER();
     switch (ring->type) {
         case RF_TYPE_FRAME:
             frame_off = sizeof(uint32_t);
@@ -121,6 +144,8 @@ uint32_t ring_fifo_write(ring_fifo_t *ring, const void *buf, uint32_t len) {
     memcpy((uint8_t *)ring->buf + off, buf, l);
     memcpy(ring->buf, (uint8_t *)buf + l, wlen - l);
 
+    /* 数据写完后再更新 tail */
+    RING_FIFO_BARRIER();
     ring->tail += wlen + frame_off;
 
     return wlen;
@@ -132,7 +157,9 @@ uint32_t ring_fifo_read(ring_fifo_t *ring, void *buf, uint32_t len) {
     uint32_t off, l;
     uint32_t frame_off, skip;
 
-    used = ring->tail - ring->head;
+    used = ring_fifo_consume_used(ring);
+    /* 读到 tail 之后才能读取数据 */
+    RING_FIFO_BARRIER();
     switch (ring->type) {
         case RF_TYPE_FRAME:
             frame_off = sizeof(uint32_t);
@@ -168,13 +195,15 @@ uint32_t ring_fifo_read(ring_fifo_t *ring, void *buf, uint32_t len) {
     memcpy(buf, (uint8_t *)ring->buf + off, l);
     memcpy((uint8_t *)buf + l, ring->buf, rlen - l);
 
+    /* 数据读完后再更新 head */
+    RING_FIFO_BARRIER();
     ring->head += rlen + frame_off;
 
     return rlen;
 }
 
 uint32_t ring_fifo_is_full(ring_fifo_t *ring) {
-    return ring->size == (ring->tail - ring->head);
+    return ring->size == ring_fifo_used(ring);
 }
 
 uint32_t ring_fifo_is_empty(ring_fifo_t *ring) {
@@ -182,9 +211,91 @@ uint32_t ring_fifo_is_empty(ring_fifo_t *ring) {
 }
 
 uint32_t ring_fifo_avail(ring_fifo_t *ring) {
-    return ring->size - (ring->tail - ring->head);
+    return ring->size - ring_fifo_used(ring);
 }
 
 uint32_t ring_fifo_count(ring_fifo_t *ring) {
-    return ring->tail - ring->head;
+    return ring_fifo_used(ring);
+}
+
+/* 计算从 pos 开始长度为 len 的内存片段 */
+static inline void ring_fifo_make_span(ring_fifo_t *ring,
+                                       ring_fifo_span_t *span, uint32_t pos,
+                                       uint32_t len) {
+    uint32_t off = pos & ring->mask;
+    uint32_t l = min(len, ring->size - off);
+
+    span->ptr[0] = (uint8_t *)ring->buf + off;
+    span->len[0] = l;
+    span->ptr[1] = ring->buf;
+    span->len[1] = len - l;
+}
+
+uint32_t ring_fifo_write_reserve(ring_fifo_t *ring, ring_fifo_span_t *span,
+                                 uint32_t len) {
+    uint32_t wlen;
+
+    if (RF_TYPE_STREAM != ring->type) {
+        return 0;
+    }
+
+    wlen = min(len, ring->size - (ring->tail - ring->head));
+    /* 读到 head 之后才能覆盖已释放的空间 */
+    RING_FIFO_BARRIER();
+
+    ring_fifo_make_span(ring, span, ring->tail, wlen);
+
+    return wlen;
+}
+
+void ring_fifo_write_commit(ring_fifo_t *ring, uint32_t len) {
+    /* 数据写完后再更新 tail */
+    RING_FIFO_BARRIER();
+    ring->tail += len;
+}
+
+uint32_t ring_fifo_read_peek(ring_fifo_t *ring, ring_fifo_span_t *span) {
+    uint32_t rlen;
+
+    if (RF_TYPE_STREAM != ring->type) {
+        return 0;
+    }
+
+    rlen = ring_fifo_consume_used(ring);
+    /* 读到 tail 之后才能读取数据 */
+    RING_FIFO_BARRIER();
+
+    ring_fifo_make_span(ring, span, ring->head, rlen);
+
+    return rlen;
+}
+
+void ring_fifo_read_release(ring_fifo_t *ring, uint32_t len) {
+    /* 数据读完后再更新 head */
+    RING_FIFO_BARRIER();
+    ring->head += len;
+}
+
+uint32_t ring_fifo_dma_sync(ring_fifo_t *ring, uint32_t dma_pos) {
+    ring_fifo_span_t span;
+    uint32_t tail = ring->tail;
+    uint32_t len = (dma_pos - tail) & ring->mask;
+
+    if (0 == len) {
+        return 0;
+    }
+
+    /* DMA 已写入的数据对 CPU 可见 */
+    ring_fifo_make_span(ring, &span, tail, len);
+    RING_FIFO_DCACHE_INVALIDATE(span.ptr[0], span.len[0]);
+    if (0 != span.len[1]) {
+        RING_FIFO_DCACHE_INVALIDATE(span.ptr[1], span.len[1]);
+    }
+
+    /* head 只由消费者修改. 消费者来不及读取时, 被 DMA 覆盖的数据在下次
+       读取时丢弃, 见 ring_fifo_consume_used */
+    RING_FIFO_BARRIER();
+    ring->tail = tail + len;
+
+    return len;
 }
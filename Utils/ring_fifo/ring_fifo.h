@@ -22,6 +22,22 @@ enum ring_fifo_type {
     RF_TYPE_STREAM
 };
 
+/* 内存屏障, 保证数据与指针的读写顺序 (Cortex-M7 等乱序访存的内核需要) */
+#ifndef RING_FIFO_BARRIER
+#if defined(__CC_ARM)
+#define RING_FIFO_BARRIER() __dmb(0xF)
+#else
+#define RING_FIFO_BARRIER() __sync_synchronize()
+#endif
+#endif /* RING_FIFO_BARRIER */
+
+/* DMA 模式下使新到达的数据对应的 D-Cache 失效, 没有 D-Cache 时为空.
+   Cortex-M7 可定义为 SCB_InvalidateDCache_by_Addr((void *)(addr), (len)),
+   此时缓冲区需要 32 字节对齐, 大小为 32 的倍数 */
+#ifndef RING_FIFO_DCACHE_INVALIDATE
+#define RING_FIFO_DCACHE_INVALIDATE(addr, len) ((void)(addr), (void)(len))
+#endif /* RING_FIFO_DCACHE_INVALIDATE */
+
 /* 环形缓冲区结构 */
 typedef struct {
     volatile uint32_t head; /* 消费者指针 */
@@ -34,8 +50,16 @@ typedef struct {
     uint32_t is_dynamic; /* 是否使用了动态内存 */
 
     enum ring_fifo_type type; /* fifo的类型 */
+
+    uint32_t overrun; /* DMA 模式下被覆盖的字节数, 由消费者读取时统计 */
 } ring_fifo_t;
 
+/* 连续内存片段, 环绕时分为两段 */
+typedef struct {
+    void *ptr[2];    /* 片段起始地址 */
+    uint32_t len[2]; /* 片段长度(byte), 不环绕时 len[1] 为 0 */
+} ring_fifo_span_t;
+
 /**
  * @brief    初始化环形缓冲区
  * @param[in]    buf     缓冲区指针，如果为NULL，则默认使用堆内存进行分配
@@ -107,6 +131,55 @@ uint32_t ring_fifo_avail(ring_fifo_t *ring);
  */
 uint32_t ring_fifo_count(ring_fifo_t *ring);
 
+/**
+ * @brief    预留写入空间(单生产者无锁, 仅 RF_TYPE_STREAM)
+ * @param[in]    ring    环形缓冲区句柄
+ * @param[out]   span    可直接写入的内存片段
+ * @param[in]    len     希望预留的长度(byte)
+ * @retval   执行结果
+ * -         实际预留的长度(byte), 不大于 len
+ * @note     写入数据后调用 ring_fifo_write_commit 提交
+ */
+uint32_t ring_fifo_write_reserve(ring_fifo_t *ring, ring_fifo_span_t *span,
+                                 uint32_t len);
+
+/**
+ * @brief    提交已写入预留空间的数据
+ * @param[in]    ring    环形缓冲区句柄
+ * @param[in]    len     提交的长度(byte), 不大于预留的长度
+ */
+void ring_fifo_write_commit(ring_fifo_t *ring, uint32_t len);
+
+/**
+ * @brief    获取可读数据所在的内存片段, 不拷贝(单消费者无锁, 仅 RF_TYPE_STREAM)
+ * @param[in]    ring    环形缓冲区句柄
+ * @param[out]   span    可读数据的内存片段
+ * @retval   执行结果
+ * -         可读取的长度(byte)
+ * @note     使用完数据后调用 ring_fifo_read_release 释放
+ */
+uint32_t ring_fifo_read_peek(ring_fifo_t *ring, ring_fifo_span_t *span);
+
+/**
+ * @brief    释放已读取的数据
+ * @param[in]    ring    环形缓冲区句柄
+ * @param[in]    len     释放的长度(byte), 不大于可读取的长度
+ */
+void ring_fifo_read_release(ring_fifo_t *ring, uint32_t len);
+
+/**
+ * @brief    DMA 模式: 以循环 DMA 的写位置作为生产者指针
+ * @param[in]    ring    环形缓冲区句柄, buf 为 DMA 目标缓冲区
+ * @param[in]    dma_pos DMA 当前写位置(byte), 一般为 size - NDTR
+ * @retval   执行结果
+ * -         新到达的长度(byte)
+ * @note     在 DMA 半满、全满和空闲中断中调用, 两次调用之间 DMA 写入不能
+ *           超过一圈. 消费者通过 ring_fifo_read_peek/ring_fifo_read 读取.
+ * @note     只修改 tail, 不修改 head. 消费者来不及读取时, 读取函数先把
+ *           head 移到 tail - size, 被覆盖的字节计入 overrun.
+ */
+uint32_t ring_fifo_dma_sync(ring_fifo_t *ring, uint32_t dma_pos);
+
 #ifdef __cplusplus
 }
 #endif
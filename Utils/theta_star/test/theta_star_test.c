@@ -0,0 +1,353 @@
+/**
+ * @file    theta_star_test.c
+ * @brief   Theta* 规划上下文的主机测试, 与改为上下文之前的实现
+ *          (theta_star_ref.c) 对比路径.
+ *
+ * 在 `Utils/theta_star` 下编译运行:
+ *
+ *   gcc -std=gnu11 -g -O1 -fsanitize=address,undefined -I. \
+ *       test/theta_star_test.c theta_star.c -lm -o theta_star_test && \
+ *       ./theta_star_test
+ *
+ * 检查项:
+ *  - 随机地图 (障碍 0% ~ 40%) 与随机起终点下, 返回长度与路径和原实现完全相同,
+ *    包括无路径, 起终点为障碍, 起点等于终点与 max_len 不足的情况.
+ *  - 在第一个上下文的 is_walkable 回调中用第二个上下文规划另一张地图,
+ *    两次规划的结果都与原实现相同.
+ *  - 代号回绕到 0 时节点被重新初始化, 回绕前后的结果与原实现相同.
+ *  - 非法参数返回 0.
+ *
+ * 最后给出两者每次规划的耗时 (用 -O2 且不加 sanitizer 编译才有意义).
+ * 20x25 地图, 障碍 20% 时 x86-64 上两者都约 12.6 us: 上下文版本省掉了每次
+ * 500 个节点的初始化, 但每次访问节点多一次代号比较, 耗时主要在视线检查上.
+ */
+
+#include "theta_star.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* 原实现, 公共函数改名后与新实现链接在一起 */
+#define theta_star_find_path ref_theta_star_find_path
+#include "theta_star_ref.c"
+#undef theta_star_find_path
+
+#define CHECK(cond)                                                            \
+    do {                                                                       \
+        if (!(cond)) {                                                         \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);    \
+            exit(1);                                                           \
+        }                                                                      \
+    } while (0)
+
+#define TEST_ROWS   20
+#define TEST_COLS   25
+/* 每种障碍密度的随机地图数 */
+#define TEST_MAPS   200
+/* 每张地图的随机起终点数 */
+#define TEST_PLANS  20
+#define BENCH_PLANS 20000
+
+/* 主地图, 以及重入测试中回调内规划使用的第二张地图 */
+static uint8_t test_map[TEST_ROWS][TEST_COLS];
+static uint8_t test_map2[TEST_ROWS][TEST_COLS];
+
+static uint32_t test_rand_state = 1;
+
+static uint32_t test_rand(void) {
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return test_rand_state >> 8;
+}
+
+static bool test_walkable(int row, int col) {
+    return test_map[row][col] == 0;
+}
+
+static bool test_walkable2(int row, int col) {
+    return test_map2[row][col] == 0;
+}
+
+static const theta_config_t test_cfg = {TEST_ROWS, TEST_COLS, test_walkable};
+static const theta_config_t test_cfg2 = {TEST_ROWS, TEST_COLS, test_walkable2};
+
+/**
+ * @brief 生成随机地图
+ *
+ * @param map 地图
+ * @param percent 障碍百分比
+ */
+static void test_fill_map(uint8_t map[TEST_ROWS][TEST_COLS], uint32_t percent) {
+    for (int r = 0; r < TEST_ROWS; ++r) {
+        for (int c = 0; c < TEST_COLS; ++c) {
+            map[r][c] = (test_rand() % 100U) < percent;
+        }
+    }
+}
+
+/**
+ * @brief 用同一组参数调用两种实现, 比较结果
+ *
+ * @param ctx 新实现的上下文
+ * @param cfg 环境配置
+ * @param max_len 输出数组长度
+ * @return 路径长度
+ */
+static int test_compare(theta_ctx_t *ctx, const theta_config_t *cfg, int sr,
+                        int sc, int gr, int gc, int max_len) {
+    uint16_t path_ref[THETA_MAX_NODES], path_now[THETA_MAX_NODES];
+    int len_ref, len_now;
+
+    len_ref =
+        ref_theta_star_find_path(cfg, sr, sc, gr, gc, path_ref, max_len);
+    len_now =
+        theta_star_find_path_ctx(ctx, cfg, sr, sc, gr, gc, path_now, max_len);
+
+    CHECK(len_now == len_ref);
+    CHECK(len_now <= max_len);
+    CHECK(memcmp(path_now, path_ref, sizeof(uint16_t) * (size_t)len_now) ==
+          0);
+    return len_now;
+}
+
+static void test_random(void) {
+    static theta_ctx_t ctx;
+    uint32_t found = 0, total = 0;
+
+    theta_ctx_init(&ctx);
+
+    for (uint32_t percent = 0; percent <= 40; percent += 10) {
+        for (uint32_t m = 0; m < TEST_MAPS; ++m) {
+            test_fill_map(test_map, percent);
+
+            for (uint32_t p = 0; p < TEST_PLANS; ++p) {
+                int sr = (int)(test_rand() % TEST_ROWS);
+                int sc = (int)(test_rand() % TEST_COLS);
+                int gr = (int)(test_rand() % TEST_ROWS);
+                int gc = (int)(test_rand() % TEST_COLS);
+                /* 偶尔给一个偏短的输出数组 */
+                int max_len = (p % 8 == 7) ? (int)(test_rand() % 16 + 1)
+                                           : THETA_MAX_NODES;
+
+                found += test_compare(&ctx, &test_cfg, sr, sc, gr, gc,
+                                      max_len) > 0;
+                ++total;
+            }
+        }
+    }
+
+    /* 默认上下文 */
+    test_fill_map(test_map, 20);
+    for (uint32_t p = 0; p < TEST_PLANS; ++p) {
+        uint16_t path_ref[THETA_MAX_NODES], path_now[THETA_MAX_NODES];
+        int sr = (int)(test_rand() % TEST_ROWS);
+        int sc = (int)(test_rand() % TEST_COLS);
+        int gr = (int)(test_rand() % TEST_ROWS);
+        int gc = (int)(test_rand() % TEST_COLS);
+        int len_ref = ref_theta_star_find_path(&test_cfg, sr, sc, gr, gc,
+                                               path_ref, THETA_MAX_NODES);
+        int len_now = theta_star_find_path(&test_cfg, sr, sc, gr, gc, path_now,
+                                           THETA_MAX_NODES);
+
+        CHECK(len_now == len_ref);
+        CHECK(memcmp(path_now, path_ref,
+                     sizeof(uint16_t) * (size_t)len_now) == 0);
+    }
+
+    printf("random: %u plans, %u with a path, same as before\n", total, found);
+}
+
+/*****************************************************************************
+ * 重入
+ */
+
+static theta_ctx_t reenter_ctx;
+static uint32_t reenter_calls;
+static int reenter_sr, reenter_sc, reenter_gr, reenter_gc;
+static int reenter_len;
+static uint16_t reenter_path[THETA_MAX_NODES];
+
+/**
+ * @brief 主地图的回调, 每 7 次调用在第二个上下文中规划第二张地图
+ */
+static bool test_walkable_reenter(int row, int col) {
+    if (++reenter_calls % 7 == 0) {
+        reenter_len = theta_star_find_path_ctx(
+            &reenter_ctx, &test_cfg2, reenter_sr, reenter_sc, reenter_gr,
+            reenter_gc, reenter_path, THETA_MAX_NODES);
+    }
+    return test_map[row][col] == 0;
+}
+
+static void test_reenter(void) {
+    static theta_ctx_t ctx;
+    const theta_config_t cfg = {TEST_ROWS, TEST_COLS, test_walkable_reenter};
+    uint32_t nested = 0;
+
+    theta_ctx_init(&ctx);
+    theta_ctx_init(&reenter_ctx);
+
+    for (uint32_t m = 0; m < TEST_MAPS; ++m) {
+        uint16_t path_ref[THETA_MAX_NODES], path_now[THETA_MAX_NODES];
+        uint16_t path2_ref[THETA_MAX_NODES];
+        int sr = (int)(test_rand() % TEST_ROWS);
+        int sc = (int)(test_rand() % TEST_COLS);
+        int gr = (int)(test_rand() % TEST_ROWS);
+        int gc = (int)(test_rand() % TEST_COLS);
+        int len_ref, len_now, len2_ref;
+
+        test_fill_map(test_map, 25);
+        test_fill_map(test_map2, 25);
+        reenter_sr = (int)(test_rand() % TEST_ROWS);
+        reenter_sc = (int)(test_rand() % TEST_COLS);
+        reenter_gr = (int)(test_rand() % TEST_ROWS);
+        reenter_gc = (int)(test_rand() % TEST_COLS);
+
+        /* 原实现只有一组静态数组, 分开计算两次的结果 */
+        len_ref = ref_theta_star_find_path(&test_cfg, sr, sc, gr, gc,
+                                           path_ref, THETA_MAX_NODES);
+        len2_ref = ref_theta_star_find_path(&test_cfg2, reenter_sr,
+                                            reenter_sc, reenter_gr,
+                                            reenter_gc, path2_ref,
+                                            THETA_MAX_NODES);
+
+        reenter_calls = 0;
+        reenter_len = -1;
+        len_now = theta_star_find_path_ctx(&ctx, &cfg, sr, sc, gr, gc,
+                                           path_now, THETA_MAX_NODES);
+
+        CHECK(len_now == len_ref);
+        CHECK(memcmp(path_now, path_ref,
+                     sizeof(uint16_t) * (size_t)len_now) == 0);
+        if (reenter_len >= 0) {
+            CHECK(reenter_len == len2_ref);
+            CHECK(memcmp(reenter_path, path2_ref,
+                         sizeof(uint16_t) * (size_t)reenter_len) == 0);
+            ++nested;
+        }
+    }
+
+    printf("reenter: %u plans with a nested plan, same as before\n", nested);
+}
+
+/*****************************************************************************
+ * 代号回绕与参数
+ */
+
+static void test_generation(void) {
+    static theta_ctx_t ctx;
+
+    theta_ctx_init(&ctx);
+
+    /* 代号 1: 终点被围住, 搜索会访问并关闭全部可达节点 */
+    memset(test_map, 0, sizeof(test_map));
+    test_map[TEST_ROWS - 2][TEST_COLS - 1] = 1;
+    test_map[TEST_ROWS - 1][TEST_COLS - 2] = 1;
+    test_map[TEST_ROWS - 2][TEST_COLS - 2] = 1;
+    CHECK(test_compare(&ctx, &test_cfg, 0, 0, TEST_ROWS - 1, TEST_COLS - 1,
+                       THETA_MAX_NODES) == 0);
+    CHECK(ctx.generation == 1);
+
+    /* 回绕后代号又从 1 开始, 若不清空 stamp, 这些节点会被当作
+       本次已初始化并已关闭的节点 */
+    ctx.generation = 0xFFFFu;
+    for (uint32_t p = 0; p < 40; ++p) {
+        test_fill_map(test_map, 20);
+        test_compare(&ctx, &test_cfg, (int)(test_rand() % TEST_ROWS),
+                     (int)(test_rand() % TEST_COLS),
+                     (int)(test_rand() % TEST_ROWS),
+                     (int)(test_rand() % TEST_COLS), THETA_MAX_NODES);
+    }
+    CHECK(ctx.generation != 0 && ctx.generation <= 40);
+
+    printf("generation: wraps around, same as before\n");
+}
+
+static void test_args(void) {
+    static theta_ctx_t ctx;
+    uint16_t path[THETA_MAX_NODES];
+    const theta_config_t big = {30, 30, test_walkable};
+    const theta_config_t no_cb = {TEST_ROWS, TEST_COLS, NULL};
+
+    theta_ctx_init(&ctx);
+    memset(test_map, 0, sizeof(test_map));
+
+    CHECK(theta_star_find_path_ctx(NULL, &test_cfg, 0, 0, 1, 1, path, 10) == 0);
+    CHECK(theta_star_find_path_ctx(&ctx, NULL, 0, 0, 1, 1, path, 10) == 0);
+    CHECK(theta_star_find_path_ctx(&ctx, &no_cb, 0, 0, 1, 1, path, 10) == 0);
+    CHECK(theta_star_find_path_ctx(&ctx, &big, 0, 0, 1, 1, path, 10) == 0);
+    CHECK(theta_star_find_path_ctx(&ctx, &test_cfg, 0, 0, 1, 1, NULL, 10) == 0);
+    CHECK(theta_star_find_path_ctx(&ctx, &test_cfg, 0, 0, 1, 1, path, 0) == 0);
+    CHECK(theta_star_find_path_ctx(&ctx, &test_cfg, -1, 0, 1, 1, path, 10) ==
+          0);
+    CHECK(theta_star_find_path_ctx(&ctx, &test_cfg, 0, 0, TEST_ROWS, 1, path,
+                                   10) == 0);
+    CHECK(theta_star_find_path_ctx(&ctx, &test_cfg, 0, 0, 1, 1, path, 10) > 0);
+
+    printf("args: ok\n");
+}
+
+/*****************************************************************************
+ * 耗时
+ */
+
+static double test_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void test_bench(void) {
+    static theta_ctx_t ctx;
+    static uint16_t query[BENCH_PLANS][4];
+    uint16_t path[THETA_MAX_NODES];
+    double ref_ns = 1e30, now_ns = 1e30;
+    volatile int sink = 0;
+
+    theta_ctx_init(&ctx);
+    test_fill_map(test_map, 20);
+    for (uint32_t i = 0; i < BENCH_PLANS; ++i) {
+        query[i][0] = (uint16_t)(test_rand() % TEST_ROWS);
+        query[i][1] = (uint16_t)(test_rand() % TEST_COLS);
+        query[i][2] = (uint16_t)(test_rand() % TEST_ROWS);
+        query[i][3] = (uint16_t)(test_rand() % TEST_COLS);
+    }
+
+    /* 机器有噪声, 取 5 轮中的最小值 */
+    for (int round = 0; round < 5; ++round) {
+        double start = test_now();
+        for (uint32_t i = 0; i < BENCH_PLANS; ++i) {
+            sink += ref_theta_star_find_path(&test_cfg, query[i][0],
+                                             query[i][1], query[i][2],
+                                             query[i][3], path,
+                                             THETA_MAX_NODES);
+        }
+        double t = (test_now() - start) / BENCH_PLANS;
+        ref_ns = t < ref_ns ? t : ref_ns;
+
+        start = test_now();
+        for (uint32_t i = 0; i < BENCH_PLANS; ++i) {
+            sink += theta_star_find_path_ctx(&ctx, &test_cfg, query[i][0],
+                                             query[i][1], query[i][2],
+                                             query[i][3], path,
+                                             THETA_MAX_NODES);
+        }
+        t = (test_now() - start) / BENCH_PLANS;
+        now_ns = t < now_ns ? t : now_ns;
+    }
+
+    printf("bench %dx%d: before %.0f ns, context %.0f ns per plan\n",
+           TEST_ROWS, TEST_COLS, ref_ns, now_ns);
+}
+
+int main(void) {
+    test_random();
+    test_reenter();
+    test_generation();
+    test_args();
+    test_bench();
+
+    printf("all passed\n");
+    return 0;
+}
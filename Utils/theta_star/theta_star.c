@@ -23,34 +23,38 @@
 
 #include "theta_star.h"
 
-typedef struct {
-    uint16_t id;    /* 节点索引 id（0~MAX_NODES-1） */
-    float    f;     /* 对应节点的 f 值，float 以匹配欧氏代价 */
-} OpenNode;
-
-static uint16_t came_from[THETA_MAX_NODES];   /* 到达节点 n 的前驱节点 id */
-static float    g_score[THETA_MAX_NODES];     /* 起点到节点 n 的当前最小已知代价 */
-static float    f_score[THETA_MAX_NODES];     /* f_score[n] = g_score[n] + heuristic(n, goal) */
-static uint8_t  closed_set[THETA_MAX_NODES];  /* 节点 n 已完成扩展的标志 */
-static OpenNode open_list[THETA_MAX_NODES];   /* 开放表（二叉小顶堆） */
-static int16_t  open_pos[THETA_MAX_NODES];    /* 节点在堆中的位置 */
-static int      open_count;             /* 开放表当前元素个数。 */
-
-/* 保存当前环境配置，避免在各静态函数中反复传递 */
-static const theta_config_t *curr_cfg = NULL;
+/* theta_star_find_path 使用的默认上下文 */
+static theta_ctx_t default_ctx;
+
+/**
+ * @brief 首次在本次规划中访问节点时初始化其状态
+ * @note 节点状态只在 stamp 与当前代号不同时重置，每次规划只初始化访问过的节点。
+ * @param ctx 规划上下文
+ * @param id 节点id
+ */
+static inline void node_touch(theta_ctx_t *ctx, uint16_t id) {
+    if (ctx->stamp[id] != ctx->generation) {
+        ctx->stamp[id] = ctx->generation;
+        ctx->came_from[id] = THETA_NODE_INVALID;
+        ctx->g_score[id] = THETA_INF_COST_F;
+        ctx->closed_set[id] = 0;
+        ctx->open_pos[id] = -1;
+    }
+}
 
 /**
  * @brief 启发函数 h(n)：计算到终点的欧氏距离。
  * @note 边代价也是欧氏距离 -> heuristic 满足可采纳性与一致性，
  *       Theta* 收敛到「LOS 最优」的近似最短路径。
+ * @param ctx 规划上下文
  * @param id 当前节点id
  * @param goal_row 终点行坐标
  * @param goal_col 终点列坐标
  * @return 预估的欧氏距离代价
  */
-static float heuristic_euclidean(uint16_t id, int goal_row, int goal_col) {
-    int r = (int)(id / curr_cfg->cols);
-    int c = (int)(id % curr_cfg->cols);
+static float heuristic_euclidean(const theta_ctx_t *ctx, uint16_t id, int goal_row, int goal_col) {
+    int r = (int)(id / ctx->cfg->cols);
+    int c = (int)(id % ctx->cfg->cols);
     float dr = (float)(r - (int)goal_row);
     float dc = (float)(c - (int)goal_col);
     return sqrtf(dr * dr + dc * dc);
@@ -59,112 +63,118 @@ static float heuristic_euclidean(uint16_t id, int goal_row, int goal_col) {
 /**
  * @brief 计算两个相邻节点之间的欧氏边代价
  * @note 用作 8 邻接边代价 / Path-2 跳跃代价。
+ * @param ctx 规划上下文
  * @param a_id 节点A的id
  * @param b_id 节点B的id
  * @return 两点间的欧氏距离
  */
-static float edge_cost(uint16_t a_id, uint16_t b_id) {
-    int dr = (int)(a_id / curr_cfg->cols) - (int)(b_id / curr_cfg->cols);
-    int dc = (int)(a_id % curr_cfg->cols) - (int)(b_id % curr_cfg->cols);
+static float edge_cost(const theta_ctx_t *ctx, uint16_t a_id, uint16_t b_id) {
+    int dr = (int)(a_id / ctx->cfg->cols) - (int)(b_id / ctx->cfg->cols);
+    int dc = (int)(a_id % ctx->cfg->cols) - (int)(b_id % ctx->cfg->cols);
     return sqrtf((float)(dr * dr + dc * dc));
 }
 
 /**
  * @brief 交换开放表(二叉堆)中的两个节点位置
+ * @param ctx 规划上下文
  * @param i 第一个节点的堆索引
  * @param j 第二个节点的堆索引
  */
-static void open_swap(int i, int j) {
-    OpenNode tmp = open_list[i];
-    open_list[i] = open_list[j];
-    open_list[j] = tmp;
-    open_pos[open_list[i].id] = (int16_t)i;
-    open_pos[open_list[j].id] = (int16_t)j;
+static void open_swap(theta_ctx_t *ctx, int i, int j) {
+    theta_open_node_t tmp = ctx->open_list[i];
+    ctx->open_list[i] = ctx->open_list[j];
+    ctx->open_list[j] = tmp;
+    ctx->open_pos[ctx->open_list[i].id] = (int16_t)i;
+    ctx->open_pos[ctx->open_list[j].id] = (int16_t)j;
 }
 
 /**
  * @brief 开放表(二叉小顶堆)向上调整操作
+ * @param ctx 规划上下文
  * @param idx 需要调整的节点索引
  */
-static void open_sift_up(int idx) {
+static void open_sift_up(theta_ctx_t *ctx, int idx) {
     while (idx > 0) {
         int parent = (idx - 1) / 2;
-        if (open_list[parent].f <= open_list[idx].f) {
+        if (ctx->open_list[parent].f <= ctx->open_list[idx].f) {
             break;
         }
-        open_swap(parent, idx);
+        open_swap(ctx, parent, idx);
         idx = parent;
     }
 }
 
 /**
  * @brief 开放表(二叉小顶堆)向下调整操作
+ * @param ctx 规划上下文
  * @param idx 需要调整的节点索引
  */
-static void open_sift_down(int idx) {
+static void open_sift_down(theta_ctx_t *ctx, int idx) {
     for (;;) {
         int left = idx * 2 + 1;
         int right = left + 1;
         int smallest = idx;
 
-        if (left < open_count && open_list[left].f < open_list[smallest].f) {
+        if (left < ctx->open_count && ctx->open_list[left].f < ctx->open_list[smallest].f) {
             smallest = left;
         }
-        if (right < open_count && open_list[right].f < open_list[smallest].f) {
+        if (right < ctx->open_count && ctx->open_list[right].f < ctx->open_list[smallest].f) {
             smallest = right;
         }
         if (smallest == idx) {
             break;
         }
 
-        open_swap(idx, smallest);
+        open_swap(ctx, idx, smallest);
         idx = smallest;
     }
 }
 
 /**
  * @brief 将新节点压入开放表，或更新已有节点的f值
+ * @param ctx 规划上下文
  * @param id 节点id
  * @param f 节点的综合代价f值 (float类型)
  */
-static void open_push_or_update(uint16_t id, float f) {
-    int idx = open_pos[id];
+static void open_push_or_update(theta_ctx_t *ctx, uint16_t id, float f) {
+    int idx = ctx->open_pos[id];
 
     if (idx >= 0) {
-        if (f < open_list[idx].f) {
-            open_list[idx].f = f;
-            open_sift_up(idx);
+        if (f < ctx->open_list[idx].f) {
+            ctx->open_list[idx].f = f;
+            open_sift_up(ctx, idx);
         }
         return;
     }
 
-    if (open_count < THETA_MAX_NODES) {
-        int insert_idx = open_count;
-        open_list[insert_idx].id = id;
-        open_list[insert_idx].f = f;
-        open_pos[id] = (int16_t)insert_idx;
-        open_count++;
-        open_sift_up(insert_idx);
+    if (ctx->open_count < THETA_MAX_NODES) {
+        int insert_idx = ctx->open_count;
+        ctx->open_list[insert_idx].id = id;
+        ctx->open_list[insert_idx].f = f;
+        ctx->open_pos[id] = (int16_t)insert_idx;
+        ctx->open_count++;
+        open_sift_up(ctx, insert_idx);
     }
 }
 
 /**
  * @brief 从开放表中弹出f值最小的节点
+ * @param ctx 规划上下文
  * @return f值最小的节点id，若开放表为空则返回 NODE_INVALID
  */
-static uint16_t open_pop_min(void) {
-    if (open_count <= 0) {
+static uint16_t open_pop_min(theta_ctx_t *ctx) {
+    if (ctx->open_count <= 0) {
         return THETA_NODE_INVALID;
     }
 
-    uint16_t id = open_list[0].id;
-    open_pos[id] = -1;
+    uint16_t id = ctx->open_list[0].id;
+    ctx->open_pos[id] = -1;
 
-    open_count--;
-    if (open_count > 0) {
-        open_list[0] = open_list[open_count];
-        open_pos[open_list[0].id] = 0;
-        open_sift_down(0);
+    ctx->open_count--;
+    if (ctx->open_count > 0) {
+        ctx->open_list[0] = ctx->open_list[ctx->open_count];
+        ctx->open_pos[ctx->open_list[0].id] = 0;
+        open_sift_down(ctx, 0);
     }
 
     return id;
@@ -173,13 +183,14 @@ static uint16_t open_pop_min(void) {
 /**
  * @brief 获取当前节点周围的8个相邻节点
  * @note 含 4 条对角线，禁止对角穿墙（两条正交相邻格至少有一格是障碍则不展开对角邻居）
+ * @param ctx 规划上下文
  * @param id 当前节点id
  * @param neighbors 用于存储合法邻居节点id的数组
  * @return 合法邻居的数量
  */
-static int get_neighbors8(uint16_t id, uint16_t neighbors[8]) {
-    int row = (int)(id / curr_cfg->cols);
-    int col = (int)(id % curr_cfg->cols);
+static int get_neighbors8(const theta_ctx_t *ctx, uint16_t id, uint16_t neighbors[8]) {
+    int row = (int)(id / ctx->cfg->cols);
+    int col = (int)(id % ctx->cfg->cols);
     static const int8_t dr_tab[8] = {-1, -1, -1,  0, 0,  1, 1, 1};
     static const int8_t dc_tab[8] = {-1,  0,  1, -1, 1, -1, 0, 1};
     int count = 0;
@@ -187,19 +198,19 @@ static int get_neighbors8(uint16_t id, uint16_t neighbors[8]) {
     for (int i = 0; i < 8; i++) {
         int nr = row + dr_tab[i];
         int nc = col + dc_tab[i];
-        if (nr < 0 || nr >= curr_cfg->rows || nc < 0 || nc >= curr_cfg->cols || !curr_cfg->is_walkable(nr, nc)) {
+        if (nr < 0 || nr >= ctx->cfg->rows || nc < 0 || nc >= ctx->cfg->cols || !ctx->cfg->is_walkable(nr, nc)) {
             continue;
         }
         /* 对角邻居：要求两条正交方向相邻格都可走，避免从夹角穿墙 */
         if (dr_tab[i] != 0 && dc_tab[i] != 0) {
-            if (!curr_cfg->is_walkable(row + dr_tab[i], col)) {
+            if (!ctx->cfg->is_walkable(row + dr_tab[i], col)) {
                 continue;
             }
-            if (!curr_cfg->is_walkable(row, col + dc_tab[i])) {
+            if (!ctx->cfg->is_walkable(row, col + dc_tab[i])) {
                 continue;
             }
         }
-        neighbors[count++] = (uint16_t)(nr * curr_cfg->cols + nc);
+        neighbors[count++] = (uint16_t)(nr * ctx->cfg->cols + nc);
     }
     return count;
 }
@@ -208,15 +219,16 @@ static int get_neighbors8(uint16_t id, uint16_t neighbors[8]) {
  * @brief Bresenham 视距(Line-of-Sight)检查
  * @note 从 a_id 到 b_id 的整数直线沿途每一格都要可走。
  *       对角步增量发生时，需额外要求两条正交相邻格都可走（与 get_neighbors8 的对角穿墙策略保持一致）。
+ * @param ctx 规划上下文
  * @param a_id 起点节点id
  * @param b_id 终点节点id
  * @return 1 表示存在直线无障碍通道，0 表示路径被障碍阻断
  */
-static int has_line_of_sight(uint16_t a_id, uint16_t b_id) {
-    int r0 = (int)(a_id / curr_cfg->cols);
-    int c0 = (int)(a_id % curr_cfg->cols);
-    int r1 = (int)(b_id / curr_cfg->cols);
-    int c1 = (int)(b_id % curr_cfg->cols);
+static int has_line_of_sight(const theta_ctx_t *ctx, uint16_t a_id, uint16_t b_id) {
+    int r0 = (int)(a_id / ctx->cfg->cols);
+    int c0 = (int)(a_id % ctx->cfg->cols);
+    int r1 = (int)(b_id / ctx->cfg->cols);
+    int c1 = (int)(b_id % ctx->cfg->cols);
 
     int dr = (r1 > r0) ? (r1 - r0) : (r0 - r1);
     int dc = (c1 > c0) ? (c1 - c0) : (c0 - c1);
@@ -227,7 +239,7 @@ static int has_line_of_sight(uint16_t a_id, uint16_t b_id) {
     int c = c0;
 
     for (;;) {
-        if (r < 0 || r >= curr_cfg->rows || c < 0 || c >= curr_cfg->cols || !curr_cfg->is_walkable(r, c)) {
+        if (r < 0 || r >= ctx->cfg->rows || c < 0 || c >= ctx->cfg->cols || !ctx->cfg->is_walkable(r, c)) {
             return 0;
         }
         if (r == r1 && c == c1) {
@@ -242,10 +254,10 @@ static int has_line_of_sight(uint16_t a_id, uint16_t b_id) {
 
         /* 对角增量：前一格的两条正交邻格都要可走，否则视为穿墙阻断 */
         if (step_r && step_c) {
-            if (!curr_cfg->is_walkable(r - sr, c)) {
+            if (!ctx->cfg->is_walkable(r - sr, c)) {
                 return 0;
             }
-            if (!curr_cfg->is_walkable(r, c - sc)) {
+            if (!ctx->cfg->is_walkable(r, c - sc)) {
                 return 0;
             }
         }
@@ -254,25 +266,26 @@ static int has_line_of_sight(uint16_t a_id, uint16_t b_id) {
 
 /**
  * @brief 回溯并生成正向路径
- * @note 从 goal 沿 came_from 反向回溯到 start，再反转得到正向路径。
+ * @note 先从 goal 沿 came_from 回溯求出路径长度，再从路径末尾向前直接写入 path_out。
  *       Theta* 与 A* 在 came_from 链表上语义一致，差异仅在于 came_from 可能跨格指向祖父甚至更远祖先。
+ * @param ctx 规划上下文
  * @param start_id 起点节点id
  * @param goal_id 终点节点id
  * @param path_out 输出的正向路径数组
  * @param max_len 最大允许的路径长度
  * @return 生成的路径长度，若失败则返回0
  */
-static int reconstruct_path(uint16_t start_id, uint16_t goal_id, uint16_t *path_out, int max_len) {
-    uint16_t rev_path[THETA_MAX_NODES];
-    int rev_len = 0;
+static int reconstruct_path(const theta_ctx_t *ctx, uint16_t start_id, uint16_t goal_id,
+                            uint16_t *path_out, int max_len) {
+    int len = 0;
     uint16_t node = goal_id;
 
-    while (node != THETA_NODE_INVALID && rev_len < THETA_MAX_NODES) {
-        rev_path[rev_len++] = node;
+    while (node != THETA_NODE_INVALID && len < THETA_MAX_NODES) {
+        len++;
         if (node == start_id) {
             break;
         }
-        uint16_t prev = came_from[node];
+        uint16_t prev = ctx->came_from[node];
         if (prev == node) {
             /* 起点自指父节点，正常终止条件已在上面命中；防御性 break。 */
             break;
@@ -280,23 +293,34 @@ static int reconstruct_path(uint16_t start_id, uint16_t goal_id, uint16_t *path_
         node = prev;
     }
 
-    if (rev_len == 0 || rev_path[rev_len - 1] != start_id) {
+    if (len == 0 || node != start_id) {
         return 0;
     }
-    if (rev_len > max_len) {
+    if (len > max_len) {
         return 0;
     }
 
-    for (int i = 0; i < rev_len; i++) {
-        path_out[i] = rev_path[rev_len - 1 - i];
+    node = goal_id;
+    for (int i = len - 1; i >= 0; i--) {
+        path_out[i] = node;
+        node = ctx->came_from[node];
     }
 
-    return rev_len;
+    return len;
 }
 
 /**
- * @brief Theta* 寻路主函数
+ * @brief 初始化 Theta* 规划上下文
+ * @param ctx 规划上下文
+ */
+void theta_ctx_init(theta_ctx_t *ctx) {
+    memset(ctx, 0, sizeof(theta_ctx_t));
+}
+
+/**
+ * @brief 使用指定上下文的 Theta* 寻路
  *
+ * @param ctx 规划上下文，同一上下文不能同时用于两次规划
  * @param config Theta*运行环境配置
  * @param start_row 起点行
  * @param start_col 起点列
@@ -314,10 +338,11 @@ static int reconstruct_path(uint16_t start_id, uint16_t goal_id, uint16_t *path_
  *       编号规则: id = row * MAP_COLS + col (从0开始)
  *       返回值: >0 路径长度, 0 无路径或输入非法。
  */
-int theta_star_find_path(const theta_config_t *config, int start_row, int start_col,
-                         int goal_row, int goal_col, uint16_t *path_out, int max_len) {
+int theta_star_find_path_ctx(theta_ctx_t *ctx, const theta_config_t *config,
+                             int start_row, int start_col, int goal_row,
+                             int goal_col, uint16_t *path_out, int max_len) {
     /* 参数合法性检查 */
-    if (path_out == NULL || max_len <= 0 || config == NULL || config->is_walkable == NULL) {
+    if (ctx == NULL || path_out == NULL || max_len <= 0 || config == NULL || config->is_walkable == NULL) {
         return 0;
     }
     if (config->rows * config->cols > THETA_MAX_NODES) {
@@ -328,7 +353,7 @@ int theta_star_find_path(const theta_config_t *config, int start_row, int start_
         return 0;
     }
 
-    curr_cfg = config;
+    ctx->cfg = config;
 
     uint16_t start_id = (uint16_t)(start_row * config->cols + start_col);
     uint16_t goal_id = (uint16_t)(goal_row * config->cols + goal_col);
@@ -343,45 +368,44 @@ int theta_star_find_path(const theta_config_t *config, int start_row, int start_
         return 0;
     }
 
-    /* 每次规划前清空状态数组 */
-    for (int i = 0; i < THETA_MAX_NODES; i++) {
-        came_from[i] = THETA_NODE_INVALID;
-        g_score[i] = THETA_INF_COST_F;
-        f_score[i] = THETA_INF_COST_F;
-        closed_set[i] = 0;
-        open_pos[i] = -1;
+    /* 新的代号使所有节点失效；代号回绕时才需要清空 stamp */
+    ctx->generation++;
+    if (ctx->generation == 0) {
+        memset(ctx->stamp, 0, sizeof(ctx->stamp));
+        ctx->generation = 1;
     }
 
-    open_count = 0;
-    g_score[start_id] = 0.0f;
-    f_score[start_id] = heuristic_euclidean(start_id, goal_row, goal_col);
-    came_from[start_id] = start_id; /* 起点自指父节点，方便 Path-2 LOS 检查统一处理 */
-    open_push_or_update(start_id, f_score[start_id]);
+    ctx->open_count = 0;
+    node_touch(ctx, start_id);
+    ctx->g_score[start_id] = 0.0f;
+    ctx->came_from[start_id] = start_id; /* 起点自指父节点，方便 Path-2 LOS 检查统一处理 */
+    open_push_or_update(ctx, start_id, heuristic_euclidean(ctx, start_id, goal_row, goal_col));
 
     /* Theta* 主循环 */
-    while (open_count > 0) {
-        uint16_t current = open_pop_min();
+    while (ctx->open_count > 0) {
+        uint16_t current = open_pop_min(ctx);
         if (current == THETA_NODE_INVALID) {
             break;
         }
 
         /* 到达终点，回溯路径并返回 */
         if (current == goal_id) {
-            return reconstruct_path(start_id, goal_id, path_out, max_len);
+            return reconstruct_path(ctx, start_id, goal_id, path_out, max_len);
         }
 
-        if (closed_set[current]) {
+        if (ctx->closed_set[current]) {
             continue;
         }
-        closed_set[current] = 1;
+        ctx->closed_set[current] = 1;
 
-        uint16_t parent_c = came_from[current];
+        uint16_t parent_c = ctx->came_from[current];
 
         uint16_t neighbors[8];
-        int nb_count = get_neighbors8(current, neighbors);
+        int nb_count = get_neighbors8(ctx, current, neighbors);
         for (int i = 0; i < nb_count; i++) {
             uint16_t nb = neighbors[i];
-            if (closed_set[nb]) {
+            node_touch(ctx, nb);
+            if (ctx->closed_set[nb]) {
                 continue;
             }
 
@@ -389,20 +413,19 @@ int theta_star_find_path(const theta_config_t *config, int start_row, int start_
             uint16_t tentative_parent;
 
             /* Path-2：parent(current) 与 nb 之间有 LOS 时，直接跳过 current */
-            if (has_line_of_sight(parent_c, nb)) {
-                tentative_g = g_score[parent_c] + edge_cost(parent_c, nb);
+            if (has_line_of_sight(ctx, parent_c, nb)) {
+                tentative_g = ctx->g_score[parent_c] + edge_cost(ctx, parent_c, nb);
                 tentative_parent = parent_c;
             } else {
                 /* Path-1：标准 A* 更新（8 邻接 + 欧氏代价） */
-                tentative_g = g_score[current] + edge_cost(current, nb);
+                tentative_g = ctx->g_score[current] + edge_cost(ctx, current, nb);
                 tentative_parent = current;
             }
 
-            if (tentative_g < g_score[nb]) {
-                came_from[nb] = tentative_parent;
-                g_score[nb] = tentative_g;
-                f_score[nb] = tentative_g + heuristic_euclidean(nb, goal_row, goal_col);
-                open_push_or_update(nb, f_score[nb]);
+            if (tentative_g < ctx->g_score[nb]) {
+                ctx->came_from[nb] = tentative_parent;
+                ctx->g_score[nb] = tentative_g;
+                open_push_or_update(ctx, nb, tentative_g + heuristic_euclidean(ctx, nb, goal_row, goal_col));
             }
         }
     }
@@ -410,6 +433,24 @@ int theta_star_find_path(const theta_config_t *config, int start_row, int start_
     return 0;
 }
 
+/**
+ * @brief Theta* 寻路主函数，使用内部默认上下文（不可重入）
+ *
+ * @param config Theta*运行环境配置
+ * @param start_row 起点行
+ * @param start_col 起点列
+ * @param goal_row 终点行
+ * @param goal_col 终点列
+ * @param path_out 输出路径数组，存储路径上节点的 id 序列
+ * @param max_len 输出路径数组的最大长度
+ * @return >0 路径长度, 0 无路径或输入非法
+ */
+int theta_star_find_path(const theta_config_t *config, int start_row, int start_col,
+                         int goal_row, int goal_col, uint16_t *path_out, int max_len) {
+    return theta_star_find_path_ctx(&default_ctx, config, start_row, start_col,
+                                    goal_row, goal_col, path_out, max_len);
+}
+
 #if 0
 /**
  * @brief 主函数，用于 PC 调试演示
@@ -16,7 +16,7 @@
 #include <stdbool.h>
 
 /* ====== Theta* 算法配置 ====== */
-#define THETA_MAX_NODES    500     /*!< 允许的最大节点数（受限于内部静态数组） */
+#define THETA_MAX_NODES    500     /*!< 允许的最大节点数（受限于上下文中的数组） */
 #define THETA_NODE_INVALID 0xFFFFu /*!< 无效节点 ID */
 #define THETA_INF_COST_F   1.0e9f  /*!< 初始无穷大代价 */
 
@@ -37,6 +37,36 @@ typedef struct {
     theta_is_walkable_cb_t is_walkable;     /*!< 碰撞检测回调函数 */
 } theta_config_t;
 
+/**
+ * @brief 开放表(二叉小顶堆)元素
+ */
+typedef struct {
+    uint16_t id; /*!< 节点索引 id（0~MAX_NODES-1） */
+    float    f;  /*!< 对应节点的 f 值，float 以匹配欧氏代价 */
+} theta_open_node_t;
+
+/**
+ * @brief Theta* 规划上下文，保存一次规划的全部状态
+ * @note 每个上下文拥有独立的节点数组和开放表，不同上下文可以同时规划。
+ *       stamp[n] 不等于当前代号的节点视为未访问，每次规划只初始化访问到的节点。
+ *       全部清零的上下文即为有效的初始状态。
+ */
+typedef struct {
+    const theta_config_t *cfg;                    /*!< 当前环境配置 */
+    uint16_t generation;                          /*!< 当前规划代号 */
+    uint16_t stamp[THETA_MAX_NODES];              /*!< 节点初始化时的代号 */
+    uint16_t came_from[THETA_MAX_NODES];          /*!< 到达节点 n 的前驱节点 id */
+    float    g_score[THETA_MAX_NODES];            /*!< 起点到节点 n 的最小已知代价 */
+    uint8_t  closed_set[THETA_MAX_NODES];         /*!< 节点 n 已完成扩展的标志 */
+    int16_t  open_pos[THETA_MAX_NODES];           /*!< 节点在堆中的位置 */
+    theta_open_node_t open_list[THETA_MAX_NODES]; /*!< 开放表（二叉小顶堆） */
+    int      open_count;                          /*!< 开放表当前元素个数 */
+} theta_ctx_t;
+
+void theta_ctx_init(theta_ctx_t *ctx);
+int theta_star_find_path_ctx(theta_ctx_t *ctx, const theta_config_t *config,
+                             int start_row, int start_col, int goal_row,
+                             int goal_col, uint16_t *path_out, int max_len);
 int theta_star_find_path(const theta_config_t *config, int start_row, int start_col,
                          int goal_row, int goal_col, uint16_t *path_out, int max_len);
 